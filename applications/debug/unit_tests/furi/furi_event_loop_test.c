@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include "../minunit.h"
+
+#define TAG "EventLoopTest"
+
+#define EVENT_LOOP_TEST_COUNT (32)
+#define EVENT_LOOP_TEST_FLAG (1 << 4)
+#define EVENT_LOOP_TEST_TIMER_PERIOD (10)
+#define EVENT_LOOP_TEST_TIMER_COUNT (10)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessageQueue* queue;
+    FuriStreamBuffer* stream_buffer;
+    FuriSemaphore* semaphore;
+
+    uint32_t queue_count;
+    uint32_t queue_order_errors;
+    uint32_t stream_buffer_bytes;
+    uint32_t semaphore_count;
+    uint32_t flags_count;
+
+    uint32_t latency_max;
+    uint64_t latency_total;
+    uint32_t wakeups;
+} EventLoopTestSources;
+
+static void test_furi_event_loop_check_done(EventLoopTestSources* sources) {
+    if(sources->queue_count == EVENT_LOOP_TEST_COUNT &&
+       sources->stream_buffer_bytes == EVENT_LOOP_TEST_COUNT &&
+       sources->semaphore_count == EVENT_LOOP_TEST_COUNT &&
+       sources->flags_count == EVENT_LOOP_TEST_COUNT) {
+        furi_event_loop_stop(sources->event_loop);
+    }
+}
+
+static void test_furi_event_loop_queue_callback(FuriMessageQueue* queue, void* context) {
+    EventLoopTestSources* sources = context;
+    uint32_t timestamp;
+    // Only one message, the loop must call us again for the rest
+    if(furi_message_queue_get(queue, &timestamp, 0) == FuriStatusOk) {
+        uint32_t latency = DWT->CYCCNT - timestamp;
+        sources->latency_total += latency;
+        if(latency > sources->latency_max) sources->latency_max = latency;
+        sources->queue_count++;
+    } else {
+        sources->queue_order_errors++;
+    }
+    test_furi_event_loop_check_done(sources);
+}
+
+static void
+    test_furi_event_loop_stream_buffer_callback(FuriStreamBuffer* stream_buffer, void* context) {
+    EventLoopTestSources* sources = context;
+    uint8_t data[8];
+    sources->stream_buffer_bytes +=
+        furi_stream_buffer_receive(stream_buffer, data, sizeof(data), 0);
+    test_furi_event_loop_check_done(sources);
+}
+
+static void test_furi_event_loop_semaphore_callback(FuriSemaphore* semaphore, void* context) {
+    EventLoopTestSources* sources = context;
+    while(furi_semaphore_acquire(semaphore, 0) == FuriStatusOk) {
+        sources->semaphore_count++;
+    }
+    test_furi_event_loop_check_done(sources);
+}
+
+static void test_furi_event_loop_flags_callback(uint32_t flags, void* context) {
+    EventLoopTestSources* sources = context;
+    if(flags & EVENT_LOOP_TEST_FLAG) sources->flags_count++;
+    test_furi_event_loop_check_done(sources);
+}
+
+static int32_t test_furi_event_loop_sources_thread(void* context) {
+    EventLoopTestSources* sources = context;
+
+    sources->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        sources->event_loop, sources->queue, test_furi_event_loop_queue_callback, sources);
+    furi_event_loop_subscribe_stream_buffer(
+        sources->event_loop,
+        sources->stream_buffer,
+        test_furi_event_loop_stream_buffer_callback,
+        sources);
+    furi_event_loop_subscribe_semaphore(
+        sources->event_loop, sources->semaphore, test_furi_event_loop_semaphore_callback, sources);
+    furi_event_loop_subscribe_thread_flags(
+        sources->event_loop, EVENT_LOOP_TEST_FLAG, test_furi_event_loop_flags_callback, sources);
+
+    furi_event_loop_run(sources->event_loop);
+    sources->wakeups = furi_event_loop_get_wakeup_count(sources->event_loop);
+
+    furi_event_loop_unsubscribe(sources->event_loop, sources->queue);
+    furi_event_loop_unsubscribe(sources->event_loop, sources->stream_buffer);
+    furi_event_loop_unsubscribe(sources->event_loop, sources->semaphore);
+    furi_event_loop_subscribe_thread_flags(sources->event_loop, 0, NULL, NULL);
+    furi_event_loop_free(sources->event_loop);
+
+    return 0;
+}
+
+static void test_furi_event_loop_sources() {
+    EventLoopTestSources sources = {0};
+    sources.queue = furi_message_queue_alloc(4, sizeof(uint32_t));
+    sources.stream_buffer = furi_stream_buffer_alloc(16, 1);
+    sources.semaphore = furi_semaphore_alloc(EVENT_LOOP_TEST_COUNT, 0);
+
+    // Message before subscription must not be lost
+    uint32_t timestamp = DWT->CYCCNT;
+    furi_message_queue_put(sources.queue, &timestamp, 0);
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "EventLoopTest", 1024, test_furi_event_loop_sources_thread, &sources);
+    furi_thread_start(thread);
+    FuriThreadId thread_id = furi_thread_get_id(thread);
+
+    for(uint32_t i = 0; i < EVENT_LOOP_TEST_COUNT; i++) {
+        if(i > 0) {
+            timestamp = DWT->CYCCNT;
+            furi_message_queue_put(sources.queue, &timestamp, FuriWaitForever);
+        }
+        uint8_t byte = i;
+        furi_stream_buffer_send(sources.stream_buffer, &byte, 1, FuriWaitForever);
+        furi_semaphore_release(sources.semaphore);
+        furi_thread_flags_set(thread_id, EVENT_LOOP_TEST_FLAG);
+        // Next round only after this one is handled, so flags are not merged
+        while(__atomic_load_n(&sources.flags_count, __ATOMIC_RELAXED) <= i) {
+            furi_delay_tick(1);
+        }
+    }
+
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    furi_semaphore_free(sources.semaphore);
+    furi_stream_buffer_free(sources.stream_buffer);
+    furi_message_queue_free(sources.queue);
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "Wakeups %lu for %u rounds, queue latency avg %luus, max %luus",
+        sources.wakeups,
+        EVENT_LOOP_TEST_COUNT,
+        (uint32_t)(sources.latency_total / EVENT_LOOP_TEST_COUNT / cycles_per_us),
+        sources.latency_max / cycles_per_us);
+
+    mu_assert_int_eq(EVENT_LOOP_TEST_COUNT, sources.queue_count);
+    mu_assert_int_eq(EVENT_LOOP_TEST_COUNT, sources.stream_buffer_bytes);
+    mu_assert_int_eq(EVENT_LOOP_TEST_COUNT, sources.semaphore_count);
+    mu_assert_int_eq(EVENT_LOOP_TEST_COUNT, sources.flags_count);
+    mu_assert_int_eq(0, sources.queue_order_errors);
+    // Event driven, no polling: a few wakeups per round at most
+    mu_assert(sources.wakeups <= EVENT_LOOP_TEST_COUNT * 5, "too many wakeups");
+}
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimer* periodic;
+    FuriEventLoopTimer* once;
+    uint32_t start;
+    uint32_t ticks[EVENT_LOOP_TEST_TIMER_COUNT];
+    uint32_t count;
+    uint32_t once_tick;
+} EventLoopTestTimers;
+
+static void test_furi_event_loop_periodic_callback(void* context) {
+    EventLoopTestTimers* timers = context;
+    timers->ticks[timers->count++] = furi_get_tick();
+    if(timers->count == EVENT_LOOP_TEST_TIMER_COUNT) {
+        furi_event_loop_timer_stop(timers->periodic);
+        furi_event_loop_stop(timers->event_loop);
+    } else if(timers->count == 2) {
+        // Callback that takes longer than a tick must not shift the period
+        furi_delay_tick(3);
+    }
+}
+
+static void test_furi_event_loop_once_callback(void* context) {
+    EventLoopTestTimers* timers = context;
+    timers->once_tick = furi_get_tick();
+}
+
+static int32_t test_furi_event_loop_timers_thread(void* context) {
+    EventLoopTestTimers* timers = context;
+
+    timers->event_loop = furi_event_loop_alloc();
+    timers->periodic = furi_event_loop_timer_alloc(
+        timers->event_loop,
+        test_furi_event_loop_periodic_callback,
+        FuriEventLoopTimerTypePeriodic,
+        timers);
+    timers->once = furi_event_loop_timer_alloc(
+        timers->event_loop,
+        test_furi_event_loop_once_callback,
+        FuriEventLoopTimerTypeOnce,
+        timers);
+
+    timers->start = furi_get_tick();
+    furi_event_loop_timer_start(timers->periodic, EVENT_LOOP_TEST_TIMER_PERIOD);
+    furi_event_loop_timer_start(timers->once, EVENT_LOOP_TEST_TIMER_PERIOD * 3 + 5);
+
+    furi_event_loop_run(timers->event_loop);
+
+    furi_event_loop_timer_free(timers->once);
+    furi_event_loop_timer_free(timers->periodic);
+    furi_event_loop_free(timers->event_loop);
+
+    return 0;
+}
+
+static void test_furi_event_loop_timers() {
+    EventLoopTestTimers timers = {0};
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        "EventLoopTest", 1024, test_furi_event_loop_timers_thread, &timers);
+    // Above test runner, so nothing delays dispatch
+    furi_thread_set_priority(thread, FuriThreadPriorityHigh);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    // Tick may pass between reading start and starting the timer
+    for(uint32_t i = 0; i < EVENT_LOOP_TEST_TIMER_COUNT; i++) {
+        uint32_t late = timers.ticks[i] - (timers.start + EVENT_LOOP_TEST_TIMER_PERIOD * (i + 1));
+        mu_assert(late <= 1, "periodic timer is not tick accurate");
+    }
+    uint32_t late = timers.once_tick - (timers.start + EVENT_LOOP_TEST_TIMER_PERIOD * 3 + 5);
+    mu_assert(late <= 1, "one-shot timer is not tick accurate");
+}
+
+void test_furi_event_loop() {
+    test_furi_event_loop_sources();
+    test_furi_event_loop_timers();
+}
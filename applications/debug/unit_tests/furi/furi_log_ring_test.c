@@ -0,0 +1,197 @@
+#include <stdio.h>
+#include <string.h>
+#include <furi.h>
+#include <furi_hal.h>
+#include <core/log_ring.h>
+#include "../minunit.h"
+
+#define TAG "LogRingTest"
+
+#define LOG_RING_TEST_PRODUCERS (3)
+#define LOG_RING_TEST_RECORDS (2000)
+
+typedef struct {
+    uint32_t producer;
+    uint32_t sequence;
+} LogRingTestRecord;
+
+typedef struct {
+    FuriLogRing* ring;
+    uint32_t producer;
+} LogRingTestProducer;
+
+static void test_furi_log_ring_order() {
+    FuriLogRing* ring = furi_log_ring_alloc(256);
+    size_t size = 0;
+
+    mu_assert_pointers_eq(furi_log_ring_peek(ring, &size), NULL);
+
+    // Wraps many times, records don't divide ring size
+    for(uint32_t i = 0; i < 100; i++) {
+        bool was_empty = false;
+        uint8_t* data = furi_log_ring_reserve(ring, 21, &was_empty);
+        mu_assert_pointers_not_eq(data, NULL);
+        mu_assert(was_empty, "ring is not empty");
+        memset(data, i, 21);
+
+        // Not visible before commit
+        mu_assert_pointers_eq(furi_log_ring_peek(ring, &size), NULL);
+        furi_log_ring_commit(ring, data);
+
+        const uint8_t* read = furi_log_ring_peek(ring, &size);
+        mu_assert_pointers_not_eq(read, NULL);
+        mu_assert(size >= 21, "record is truncated");
+        mu_assert_int_eq(i & 0xFF, read[0]);
+        mu_assert_int_eq(i & 0xFF, read[20]);
+        furi_log_ring_release(ring);
+    }
+
+    mu_assert_int_eq(0, furi_log_ring_get_dropped(ring));
+    furi_log_ring_free(ring);
+}
+
+static void test_furi_log_ring_overflow() {
+    FuriLogRing* ring = furi_log_ring_alloc(128);
+    size_t size = 0;
+
+    uint32_t pushed = 0;
+    for(uint32_t i = 0; i < 10; i++) {
+        uint32_t* data = furi_log_ring_reserve(ring, sizeof(uint32_t) * 3, NULL);
+        if(data) {
+            data[0] = i;
+            furi_log_ring_commit(ring, data);
+            pushed++;
+        }
+    }
+    // 16 bytes per record
+    mu_assert_int_eq(8, pushed);
+    mu_assert_int_eq(2, furi_log_ring_get_dropped(ring));
+
+    // Too big for ring at all
+    mu_assert_pointers_eq(furi_log_ring_reserve(ring, 100, NULL), NULL);
+    mu_assert_int_eq(3, furi_log_ring_get_dropped(ring));
+
+    for(uint32_t i = 0; i < pushed; i++) {
+        const uint32_t* data = furi_log_ring_peek(ring, &size);
+        mu_assert_pointers_not_eq(data, NULL);
+        mu_assert_int_eq(i, data[0]);
+        furi_log_ring_release(ring);
+    }
+    mu_assert_pointers_eq(furi_log_ring_peek(ring, &size), NULL);
+
+    furi_log_ring_free(ring);
+}
+
+static int32_t test_furi_log_ring_producer(void* context) {
+    LogRingTestProducer* producer = context;
+
+    for(uint32_t i = 0; i < LOG_RING_TEST_RECORDS; i++) {
+        // Different sizes to get padding at the ring end
+        LogRingTestRecord* record = furi_log_ring_reserve(
+            producer->ring, sizeof(LogRingTestRecord) + (i % 5) * 4, NULL);
+        if(record) {
+            record->producer = producer->producer;
+            record->sequence = i;
+            furi_log_ring_commit(producer->ring, record);
+        }
+        if(i % 64 == 0) furi_delay_tick(1);
+    }
+
+    return 0;
+}
+
+static void test_furi_log_ring_concurrent() {
+    FuriLogRing* ring = furi_log_ring_alloc(1024);
+    FuriThread* threads[LOG_RING_TEST_PRODUCERS];
+    LogRingTestProducer producers[LOG_RING_TEST_PRODUCERS];
+    int64_t last[LOG_RING_TEST_PRODUCERS];
+
+    for(uint32_t i = 0; i < LOG_RING_TEST_PRODUCERS; i++) {
+        producers[i].ring = ring;
+        producers[i].producer = i;
+        last[i] = -1;
+        threads[i] =
+            furi_thread_alloc_ex("LogRingTest", 1024, test_furi_log_ring_producer, &producers[i]);
+        furi_thread_start(threads[i]);
+    }
+
+    bool ordered = true;
+    uint32_t received = 0;
+    bool running = true;
+    while(running) {
+        running = false;
+        for(uint32_t i = 0; i < LOG_RING_TEST_PRODUCERS; i++) {
+            running |= furi_thread_get_state(threads[i]) != FuriThreadStateStopped;
+        }
+
+        const LogRingTestRecord* record;
+        size_t size;
+        while((record = furi_log_ring_peek(ring, &size))) {
+            if((record->producer >= LOG_RING_TEST_PRODUCERS) ||
+               (record->sequence <= last[record->producer])) {
+                ordered = false;
+            } else {
+                last[record->producer] = record->sequence;
+            }
+            received++;
+            furi_log_ring_release(ring);
+        }
+        furi_delay_tick(1);
+    }
+
+    for(uint32_t i = 0; i < LOG_RING_TEST_PRODUCERS; i++) {
+        furi_thread_join(threads[i]);
+        furi_thread_free(threads[i]);
+    }
+    uint32_t dropped = furi_log_ring_get_dropped(ring);
+    furi_log_ring_free(ring);
+
+    FURI_LOG_I(TAG, "Received %lu, dropped %lu", received, dropped);
+    mu_assert(ordered, "records of producer are out of order");
+    mu_assert_int_eq(LOG_RING_TEST_PRODUCERS * LOG_RING_TEST_RECORDS, received + dropped);
+}
+
+static FuriString* log_ring_test_output = NULL;
+
+static void test_furi_log_deferred_puts(const char* data) {
+    furi_string_cat_str(log_ring_test_output, data);
+}
+
+static void test_furi_log_deferred() {
+    log_ring_test_output = furi_string_alloc();
+    FuriLogLevel level = furi_log_get_level();
+    furi_log_set_level(FuriLogLevelInfo);
+    furi_log_set_puts(test_furi_log_deferred_puts);
+
+    furi_log_set_deferred(true);
+    char name[] = "stack string";
+    FURI_LOG_I(TAG, "deferred %d %s %lu %5.2f %%", -42, name, 123456789UL, 1.5);
+    // Overwritten before drain, must be copied on push
+    name[0] = 'X';
+    // Too long to be copied, printed right away
+    FURI_LOG_I(TAG, "deferred %s", "string longer than thirty two characters");
+    furi_log_set_deferred(false);
+
+    furi_log_set_puts(furi_hal_console_puts);
+    furi_log_set_level(level);
+
+    bool found = furi_string_search_str(
+                     log_ring_test_output, "deferred -42 stack string 123456789  1.50 %", 0) !=
+                 FURI_STRING_FAILURE;
+    bool found_long = furi_string_search_str(
+                          log_ring_test_output,
+                          "deferred string longer than thirty two characters",
+                          0) != FURI_STRING_FAILURE;
+    furi_string_free(log_ring_test_output);
+    log_ring_test_output = NULL;
+
+    mu_assert(found, "deferred record is not printed");
+    mu_assert(found_long, "long string is truncated");
+}
+
+void test_furi_log_ring() {
+    test_furi_log_ring_order();
+    test_furi_log_ring_overflow();
+    test_furi_log_ring_concurrent();
+    test_furi_log_deferred();
+}
@@ -43,3 +43,139 @@ void test_furi_pubsub() {
     // delete pubsub case
     furi_pubsub_free(test_pubsub);
 }
+
+#define PUBSUB_BENCH_PUBLISHERS (3)
+#define PUBSUB_BENCH_MESSAGES (2000)
+#define PUBSUB_BENCH_SUBSCRIBERS (3)
+#define PUBSUB_QUEUE_SIZE (4)
+
+typedef struct {
+    FuriPubSub* pubsub;
+    uint32_t count;
+    volatile bool unsubscribed;
+    volatile uint32_t late_calls;
+} PubSubBench;
+
+static void test_pubsub_bench_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    PubSubBench* bench = ctx;
+    __atomic_fetch_add(&bench->count, 1, __ATOMIC_RELAXED);
+}
+
+static void test_pubsub_churn_handler(const void* arg, void* ctx) {
+    UNUSED(arg);
+    PubSubBench* bench = ctx;
+    if(bench->unsubscribed) bench->late_calls++;
+}
+
+static int32_t test_pubsub_bench_publisher(void* context) {
+    PubSubBench* bench = context;
+    uint32_t value = 0;
+    for(uint32_t i = 0; i < PUBSUB_BENCH_MESSAGES; i++) {
+        value = i;
+        furi_pubsub_publish(bench->pubsub, &value);
+        if(i % 100 == 0) furi_delay_tick(1);
+    }
+    return 0;
+}
+
+static void test_furi_pubsub_contention() {
+    PubSubBench bench = {.pubsub = furi_pubsub_alloc()};
+    PubSubBench churn = {0};
+    FuriPubSubSubscription* subscriptions[PUBSUB_BENCH_SUBSCRIBERS];
+    FuriThread* publishers[PUBSUB_BENCH_PUBLISHERS];
+
+    for(size_t i = 0; i < PUBSUB_BENCH_SUBSCRIBERS; i++) {
+        subscriptions[i] =
+            furi_pubsub_subscribe(bench.pubsub, test_pubsub_bench_handler, (void*)&bench);
+    }
+
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHERS; i++) {
+        publishers[i] =
+            furi_thread_alloc_ex("PubSubBench", 1024, test_pubsub_bench_publisher, &bench);
+        furi_thread_start(publishers[i]);
+    }
+
+    // Subscribe/unsubscribe while publishers run, callback must not run after unsubscribe
+    uint32_t churn_cycles = 0;
+    bool running = true;
+    while(running) {
+        churn.unsubscribed = false;
+        FuriPubSubSubscription* subscription =
+            furi_pubsub_subscribe(bench.pubsub, test_pubsub_churn_handler, (void*)&churn);
+        furi_delay_tick(1);
+        furi_pubsub_unsubscribe(bench.pubsub, subscription);
+        churn.unsubscribed = true;
+        churn_cycles++;
+
+        running = false;
+        for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHERS; i++) {
+            running |= furi_thread_get_state(publishers[i]) != FuriThreadStateStopped;
+        }
+    }
+
+    for(size_t i = 0; i < PUBSUB_BENCH_PUBLISHERS; i++) {
+        furi_thread_join(publishers[i]);
+        furi_thread_free(publishers[i]);
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+
+    // Publish cost without contention
+    uint32_t value = 0;
+    uint32_t single_start = furi_get_tick();
+    for(uint32_t i = 0; i < PUBSUB_BENCH_MESSAGES * 10; i++) {
+        furi_pubsub_publish(bench.pubsub, &value);
+    }
+    uint32_t single_elapsed = furi_get_tick() - single_start;
+
+    for(size_t i = 0; i < PUBSUB_BENCH_SUBSCRIBERS; i++) {
+        furi_pubsub_unsubscribe(bench.pubsub, subscriptions[i]);
+    }
+    furi_pubsub_free(bench.pubsub);
+
+    FURI_LOG_I(
+        "PubSubTest",
+        "%d publishers: %lums, %lu churn cycles, single publisher: %lu publishes in %lums",
+        PUBSUB_BENCH_PUBLISHERS,
+        elapsed,
+        churn_cycles,
+        (uint32_t)PUBSUB_BENCH_MESSAGES * 10,
+        single_elapsed);
+
+    mu_assert_int_eq(
+        PUBSUB_BENCH_SUBSCRIBERS * (PUBSUB_BENCH_PUBLISHERS + 10) * PUBSUB_BENCH_MESSAGES,
+        bench.count);
+    mu_assert_int_eq(0, churn.late_calls);
+}
+
+static void test_furi_pubsub_queue() {
+    FuriPubSub* pubsub = furi_pubsub_alloc();
+    FuriMessageQueue* queue = furi_message_queue_alloc(PUBSUB_QUEUE_SIZE, sizeof(uint32_t));
+    FuriPubSubSubscription* subscription = furi_pubsub_subscribe_queue(pubsub, queue);
+
+    // Subscriber doesn't read, publisher must not block
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < 100; i++) {
+        furi_pubsub_publish(pubsub, &i);
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+
+    mu_assert_int_eq(100 - PUBSUB_QUEUE_SIZE, furi_pubsub_subscription_get_dropped(subscription));
+    mu_assert(elapsed < 10, "publisher is blocked by queue subscriber");
+
+    uint32_t value = 0;
+    for(uint32_t i = 0; i < PUBSUB_QUEUE_SIZE; i++) {
+        mu_assert_int_eq(FuriStatusOk, furi_message_queue_get(queue, &value, 0));
+        mu_assert_int_eq(i, value);
+    }
+
+    furi_pubsub_unsubscribe(pubsub, subscription);
+    furi_message_queue_free(queue);
+    furi_pubsub_free(pubsub);
+}
+
+void test_furi_pubsub_concurrent() {
+    test_furi_pubsub_contention();
+    test_furi_pubsub_queue();
+}
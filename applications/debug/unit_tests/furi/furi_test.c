@@ -7,9 +7,14 @@
 void test_furi_create_open();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
+void test_furi_pubsub_concurrent();
 
 void test_furi_memmgr();
 
+void test_furi_log_ring();
+
+void test_furi_event_loop();
+
 static int foo = 0;
 
 void test_setup(void) {
@@ -33,12 +38,24 @@ MU_TEST(mu_test_furi_pubsub) {
     test_furi_pubsub();
 }
 
+MU_TEST(mu_test_furi_pubsub_concurrent) {
+    test_furi_pubsub_concurrent();
+}
+
 MU_TEST(mu_test_furi_memmgr) {
     // this test is not accurate, but gives a basic understanding
     // that memory management is working fine
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_log_ring) {
+    test_furi_log_ring();
+}
+
+MU_TEST(mu_test_furi_event_loop) {
+    test_furi_event_loop();
+}
+
 MU_TEST_SUITE(test_suite) {
     MU_SUITE_CONFIGURE(&test_setup, &test_teardown);
 
@@ -47,7 +64,9 @@ MU_TEST_SUITE(test_suite) {
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
+    MU_RUN_TEST(mu_test_furi_pubsub_concurrent);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_log_ring);
 }
 
 int run_minunit_test_furi() {
@@ -0,0 +1,657 @@
+#include "../minunit.h"
+#include <furi.h>
+#include <furi_hal_random.h>
+#include <gui/canvas_i.h>
+#include <gui/gui.h>
+#include <gui/gui_i.h>
+#include <assets_icons.h>
+
+#define TAG "CanvasTest"
+
+#define CANVAS_TEST_BUFFER_SIZE (128 * 64 / 8)
+#define CANVAS_TEST_BITMAP_SIZE (256 * 256 / 8)
+#define CANVAS_TEST_ROUNDS (20000)
+#define CANVAS_TEST_BENCH_FRAMES (200)
+#define CANVAS_TEST_MENU_FRAMES (500)
+
+static const u8x8_display_info_t canvas_test_display_info = {
+    .tile_width = 16,
+    .tile_height = 8,
+    .pixel_width = 128,
+    .pixel_height = 64,
+};
+
+static uint8_t canvas_test_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    if(msg == U8X8_MSG_DISPLAY_SETUP_MEMORY) {
+        u8x8_d_helper_display_setup_memory(u8x8, &canvas_test_display_info);
+        return 1;
+    }
+    return 0;
+}
+
+// Offscreen u8g2 with the same buffer layout as the display
+static void canvas_test_u8g2_setup(u8g2_t* u8g2, uint8_t* buffer) {
+    u8g2_SetupDisplay(u8g2, canvas_test_display_cb, u8x8_cad_empty, u8x8_dummy_cb, u8x8_dummy_cb);
+    u8g2_SetupBuffer(u8g2, buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+}
+
+// Per pixel implementation canvas used before the page buffer blitter
+static void canvas_test_reference_int(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    bool mirror,
+    bool rotation,
+    const uint8_t* bitmap) {
+    u8g2_uint_t blen;
+    blen = w;
+    blen += 7;
+    blen >>= 3;
+
+    if(rotation && !mirror) {
+        x += w + 1;
+    } else if(mirror && !rotation) {
+        y += h - 1;
+    }
+
+    uint8_t color = u8g2->draw_color;
+    uint8_t ncolor = (color == 0 ? 1 : 0);
+    while(h > 0) {
+        const uint8_t* b = bitmap;
+        uint16_t x0 = x;
+        uint16_t y0 = y;
+        uint8_t mask = 1;
+
+        for(uint16_t len = w; len > 0; len--) {
+            if(*b & mask) {
+                u8g2->draw_color = color;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            } else if(u8g2->bitmap_transparency == 0) {
+                u8g2->draw_color = ncolor;
+                u8g2_DrawHVLine(u8g2, x0, y0, 1, 0);
+            }
+
+            if(rotation) {
+                y0++;
+            } else {
+                x0++;
+            }
+
+            mask <<= 1;
+            if(mask == 0) {
+                mask = 1;
+                b++;
+            }
+        }
+
+        u8g2->draw_color = color;
+        bitmap += blen;
+
+        if(mirror) {
+            if(rotation) {
+                x++;
+            } else {
+                y--;
+            }
+        } else {
+            if(rotation) {
+                x--;
+            } else {
+                y++;
+            }
+        }
+        h--;
+    }
+}
+
+static void canvas_test_reference(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+    if(u8g2_IsIntersection(u8g2, x, y, x + w, y + h) == 0) return;
+
+    bool mirror = (rotation == IconRotation180) || (rotation == IconRotation270);
+    bool rotate = (rotation == IconRotation90) || (rotation == IconRotation270);
+    canvas_test_reference_int(u8g2, x, y, w, h, mirror, rotate, bitmap);
+}
+
+typedef struct {
+    u8g2_t reference;
+    u8g2_t blitter;
+    uint8_t* reference_buffer;
+    uint8_t* blitter_buffer;
+    uint8_t* bitmap;
+} CanvasTest;
+
+static CanvasTest* canvas_test_alloc() {
+    CanvasTest* test = malloc(sizeof(CanvasTest));
+    test->reference_buffer = malloc(CANVAS_TEST_BUFFER_SIZE);
+    test->blitter_buffer = malloc(CANVAS_TEST_BUFFER_SIZE);
+    test->bitmap = malloc(CANVAS_TEST_BITMAP_SIZE);
+    canvas_test_u8g2_setup(&test->reference, test->reference_buffer);
+    canvas_test_u8g2_setup(&test->blitter, test->blitter_buffer);
+    return test;
+}
+
+static void canvas_test_free(CanvasTest* test) {
+    free(test->reference_buffer);
+    free(test->blitter_buffer);
+    free(test->bitmap);
+    free(test);
+}
+
+static void canvas_test_configure(
+    CanvasTest* test,
+    const u8g2_cb_t* display_rotation,
+    uint8_t color,
+    bool transparency) {
+    u8g2_t* u8g2[] = {&test->reference, &test->blitter};
+    for(size_t i = 0; i < COUNT_OF(u8g2); i++) {
+        u8g2_SetDisplayRotation(u8g2[i], display_rotation);
+        u8g2_SetMaxClipWindow(u8g2[i]);
+        u8g2_SetDrawColor(u8g2[i], color);
+        u8g2_SetBitmapMode(u8g2[i], transparency);
+    }
+}
+
+MU_TEST(canvas_bitmap_pixel_exact) {
+    CanvasTest* test = canvas_test_alloc();
+
+    for(uint32_t round = 0; round < CANVAS_TEST_ROUNDS; round++) {
+        uint32_t seed = furi_hal_random_get();
+        // Mostly on-screen icons, sometimes huge or wrapping around coordinates
+        bool huge = (seed & 0x7) == 0;
+        uint8_t x = (seed & 0x8) ? furi_hal_random_get() : furi_hal_random_get() % 140;
+        uint8_t y = (seed & 0x10) ? furi_hal_random_get() : furi_hal_random_get() % 80;
+        uint8_t w = huge ? furi_hal_random_get() : furi_hal_random_get() % 70;
+        uint8_t h = huge ? furi_hal_random_get() : furi_hal_random_get() % 70;
+        IconRotation rotation = (seed >> 5) % 4;
+        uint8_t color = (seed >> 7) % 3;
+        bool transparency = (seed >> 9) & 1;
+        const u8g2_cb_t* display_rotation = ((seed >> 10) & 0x7) ? U8G2_R0 : U8G2_R2;
+
+        furi_hal_random_fill_buf(test->reference_buffer, CANVAS_TEST_BUFFER_SIZE);
+        memcpy(test->blitter_buffer, test->reference_buffer, CANVAS_TEST_BUFFER_SIZE);
+        furi_hal_random_fill_buf(test->bitmap, ((w + 7) / 8) * h);
+
+        canvas_test_configure(test, display_rotation, color, transparency);
+        if((seed >> 13) & 1) {
+            uint8_t clip_x = furi_hal_random_get() % 128;
+            uint8_t clip_y = furi_hal_random_get() % 64;
+            u8g2_SetClipWindow(&test->reference, clip_x, clip_y, clip_x + 40, clip_y + 20);
+            u8g2_SetClipWindow(&test->blitter, clip_x, clip_y, clip_x + 40, clip_y + 20);
+        }
+
+        canvas_test_reference(&test->reference, x, y, w, h, test->bitmap, rotation);
+        canvas_draw_u8g2_bitmap(&test->blitter, x, y, w, h, test->bitmap, rotation);
+
+        if(memcmp(test->reference_buffer, test->blitter_buffer, CANVAS_TEST_BUFFER_SIZE) != 0) {
+            FURI_LOG_E(
+                TAG,
+                "x %u y %u w %u h %u rotation %u color %u transparency %u",
+                x,
+                y,
+                w,
+                h,
+                rotation,
+                color,
+                transparency);
+            canvas_test_free(test);
+            mu_fail("bitmap differs from reference");
+        }
+    }
+
+    canvas_test_free(test);
+}
+
+MU_TEST(canvas_bitmap_benchmark) {
+    CanvasTest* test = canvas_test_alloc();
+    furi_hal_random_fill_buf(test->bitmap, CANVAS_TEST_BUFFER_SIZE);
+    canvas_test_configure(test, U8G2_R0, 1, false);
+
+    // Full screen frames, like animations and games draw
+    uint32_t reference_ticks = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_BENCH_FRAMES; i++) {
+        canvas_test_reference(&test->reference, 0, 0, 128, 64, test->bitmap, IconRotation0);
+    }
+    reference_ticks = furi_get_tick() - reference_ticks;
+
+    uint32_t blitter_ticks = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_BENCH_FRAMES; i++) {
+        canvas_draw_u8g2_bitmap(&test->blitter, 0, 0, 128, 64, test->bitmap, IconRotation0);
+    }
+    blitter_ticks = furi_get_tick() - blitter_ticks;
+
+    FURI_LOG_I(
+        TAG,
+        "Full screen bitmap: per pixel %lu fps, blitter %lu fps",
+        CANVAS_TEST_BENCH_FRAMES * 1000 / MAX(reference_ticks, 1UL),
+        CANVAS_TEST_BENCH_FRAMES * 1000 / MAX(blitter_ticks, 1UL));
+
+    mu_assert_mem_eq(test->reference_buffer, test->blitter_buffer, CANVAS_TEST_BUFFER_SIZE);
+    mu_assert(blitter_ticks <= reference_ticks, "blitter is slower than per pixel drawing");
+
+    canvas_test_free(test);
+}
+
+MU_TEST_SUITE(canvas_bitmap) {
+    MU_RUN_TEST(canvas_bitmap_pixel_exact);
+    MU_RUN_TEST(canvas_bitmap_benchmark);
+}
+
+// Ten icon menu, like archive browser draws
+static const Icon* const canvas_test_menu[] = {
+    &I_dir_10px,
+    &I_sub1_10px,
+    &I_Nfc_10px,
+    &I_125_10px,
+    &I_ir_10px,
+    &I_ibutt_10px,
+    &I_badusb_10px,
+    &I_u2f_10px,
+    &I_music_10px,
+    &I_DolphinCommon_56x48,
+};
+
+static void canvas_test_draw_menu(Canvas* canvas, bool cached) {
+    canvas_clear(canvas);
+    for(size_t i = 0; i < COUNT_OF(canvas_test_menu); i++) {
+        const Icon* icon = canvas_test_menu[i];
+        uint8_t x = (i % 5) * 12;
+        uint8_t y = (i / 5) * 12;
+        if(cached) {
+            canvas_draw_icon(canvas, x, y, icon);
+        } else {
+            // What canvas did before decoded icon cache
+            uint8_t* data = NULL;
+            compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &data);
+            canvas_draw_u8g2_bitmap(
+                &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), data, 0);
+        }
+    }
+}
+
+MU_TEST(canvas_icon_cache_exact) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+    size_t buffer_size = canvas_get_buffer_size(canvas);
+    uint8_t* reference = malloc(buffer_size);
+
+    canvas_test_draw_menu(canvas, false);
+    memcpy(reference, canvas_get_buffer(canvas), buffer_size);
+
+    // Cold cache, then warm cache
+    canvas_icon_cache_clear(canvas);
+    bool equal = true;
+    for(size_t i = 0; i < 2; i++) {
+        canvas_test_draw_menu(canvas, true);
+        equal &= memcmp(reference, canvas_get_buffer(canvas), buffer_size) == 0;
+    }
+
+    gui_direct_draw_release(gui);
+    free(reference);
+
+    GuiIconCacheStats stats;
+    gui_get_icon_cache_stats(gui, &stats);
+    furi_record_close(RECORD_GUI);
+
+    mu_assert(equal, "cached icons differ from decoded icons");
+    mu_assert(stats.size <= CANVAS_ICON_CACHE_SIZE + stats.pinned_size, "cache is over budget");
+}
+
+MU_TEST(canvas_icon_cache_benchmark) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+
+    uint32_t reference_ticks = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_MENU_FRAMES; i++) {
+        canvas_test_draw_menu(canvas, false);
+    }
+    reference_ticks = furi_get_tick() - reference_ticks;
+
+    GuiIconCacheStats before;
+    gui_get_icon_cache_stats(gui, &before);
+
+    uint32_t cached_ticks = furi_get_tick();
+    for(size_t i = 0; i < CANVAS_TEST_MENU_FRAMES; i++) {
+        canvas_test_draw_menu(canvas, true);
+    }
+    cached_ticks = furi_get_tick() - cached_ticks;
+
+    GuiIconCacheStats after;
+    gui_get_icon_cache_stats(gui, &after);
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    FURI_LOG_I(
+        TAG,
+        "Menu redraw: decode %luus, cache %luus, cache %u bytes, %lu hits %lu misses",
+        reference_ticks * 1000 / CANVAS_TEST_MENU_FRAMES,
+        cached_ticks * 1000 / CANVAS_TEST_MENU_FRAMES,
+        after.size,
+        after.hits - before.hits,
+        after.misses - before.misses);
+
+    mu_assert(cached_ticks <= reference_ticks, "cached redraw is slower than decoding");
+}
+
+MU_TEST(canvas_icon_cache_pin) {
+    const Icon* icon = &I_DFU_128x50;
+    Gui* gui = furi_record_open(RECORD_GUI);
+
+    GuiIconCacheStats before;
+    gui_get_icon_cache_stats(gui, &before);
+
+    gui_icon_pin(gui, icon);
+    gui_icon_pin(gui, icon);
+    GuiIconCacheStats pinned;
+    gui_get_icon_cache_stats(gui, &pinned);
+
+    // Too big to be cached unless pinned
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+    canvas_draw_icon(canvas, 0, 0, icon);
+    gui_direct_draw_release(gui);
+    GuiIconCacheStats drawn;
+    gui_get_icon_cache_stats(gui, &drawn);
+
+    gui_icon_unpin(gui, icon);
+    GuiIconCacheStats unpinned_once;
+    gui_get_icon_cache_stats(gui, &unpinned_once);
+
+    gui_icon_unpin(gui, icon);
+    GuiIconCacheStats unpinned;
+    gui_get_icon_cache_stats(gui, &unpinned);
+
+    furi_record_close(RECORD_GUI);
+
+    bool compressed = icon_get_data(icon)[0];
+    if(compressed) {
+        mu_assert(pinned.pinned_size > before.pinned_size, "icon is not pinned");
+        mu_assert(drawn.hits > pinned.hits, "pinned icon is decoded again");
+        mu_assert(unpinned_once.pinned_size == pinned.pinned_size, "pins are not counted");
+    }
+    mu_assert_int_eq(before.pinned_size, unpinned.pinned_size);
+    mu_assert(
+        unpinned.size <= CANVAS_ICON_CACHE_SIZE + unpinned.pinned_size, "cache is over budget");
+}
+
+MU_TEST_SUITE(canvas_icon_cache) {
+    MU_RUN_TEST(canvas_icon_cache_exact);
+    MU_RUN_TEST(canvas_icon_cache_benchmark);
+    MU_RUN_TEST(canvas_icon_cache_pin);
+}
+
+MU_TEST(canvas_commit_damage) {
+    Gui* gui = furi_record_open(RECORD_GUI);
+    Canvas* canvas = gui_direct_draw_acquire(gui);
+    size_t buffer_size = canvas_get_buffer_size(canvas);
+
+    canvas_invalidate(canvas);
+    canvas_commit(canvas);
+    uint32_t full_bytes = canvas->committed_bytes;
+    CanvasDamage full = *canvas_get_damage(canvas);
+
+    canvas_commit(canvas);
+    uint32_t same_bytes = canvas->committed_bytes - full_bytes;
+    CanvasDamage same = *canvas_get_damage(canvas);
+
+    // 10x3 box in page 3
+    canvas_draw_box(canvas, 20, 26, 10, 3);
+    canvas_commit(canvas);
+    uint32_t box_bytes = canvas->committed_bytes - full_bytes - same_bytes;
+    CanvasDamage box = *canvas_get_damage(canvas);
+
+    gui_direct_draw_release(gui);
+    furi_record_close(RECORD_GUI);
+
+    mu_assert_int_eq(buffer_size, full_bytes);
+    mu_assert_int_eq(0xFF, full.pages);
+    mu_assert_int_eq(0, same_bytes);
+    mu_assert_int_eq(0, same.pages);
+    // Columns 20-29 are in tiles 2 and 3
+    mu_assert_int_eq(16, box_bytes);
+    mu_assert_int_eq(1 << 3, box.pages);
+    mu_assert_int_eq(20, box.x);
+    mu_assert_int_eq(10, box.width);
+}
+
+#define CANVAS_TEST_MENU_ITEMS (5)
+#define CANVAS_TEST_MENU_ITEM_HEIGHT (12)
+
+typedef struct {
+    Gui* gui;
+    ViewPort* view_port;
+    FuriSemaphore* frame;
+    volatile uint8_t selected;
+    volatile uint8_t drawn;
+    volatile uint8_t committed;
+    volatile uint32_t committed_bytes;
+} CanvasTestMenu;
+
+static void canvas_test_menu_draw_callback(Canvas* canvas, void* context) {
+    CanvasTestMenu* menu = context;
+    menu->drawn = menu->selected;
+    for(uint8_t i = 0; i < CANVAS_TEST_MENU_ITEMS; i++) {
+        uint8_t y = i * CANVAS_TEST_MENU_ITEM_HEIGHT;
+        if(i == menu->drawn) {
+            canvas_draw_box(canvas, 0, y, 128, CANVAS_TEST_MENU_ITEM_HEIGHT);
+            canvas_set_color(canvas, ColorWhite);
+        }
+        canvas_draw_str(canvas, 4, y + 10, "Menu item");
+        canvas_set_color(canvas, ColorBlack);
+    }
+}
+
+static void canvas_test_menu_damage_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    const CanvasDamage* damage,
+    void* context) {
+    UNUSED(data);
+    UNUSED(size);
+    UNUSED(orientation);
+    UNUSED(damage);
+    CanvasTestMenu* menu = context;
+    // Called from GUI thread with GUI locked
+    menu->committed = menu->drawn;
+    menu->committed_bytes = menu->gui->canvas->committed_bytes;
+    furi_semaphore_release(menu->frame);
+}
+
+// Select menu item and count bytes sent to display
+static uint32_t canvas_test_menu_select(CanvasTestMenu* menu, uint8_t selected, bool rect) {
+    uint32_t committed_bytes = menu->committed_bytes;
+    uint8_t previous = menu->selected;
+    menu->selected = selected;
+
+    if(rect) {
+        view_port_update_rect(
+            menu->view_port,
+            0,
+            previous * CANVAS_TEST_MENU_ITEM_HEIGHT,
+            128,
+            CANVAS_TEST_MENU_ITEM_HEIGHT);
+        view_port_update_rect(
+            menu->view_port,
+            0,
+            selected * CANVAS_TEST_MENU_ITEM_HEIGHT,
+            128,
+            CANVAS_TEST_MENU_ITEM_HEIGHT);
+    } else {
+        view_port_update(menu->view_port);
+    }
+
+    // Skip frames drawn before selection
+    do {
+        if(furi_semaphore_acquire(menu->frame, 1000) != FuriStatusOk) return UINT32_MAX;
+    } while(menu->committed != selected);
+
+    return menu->committed_bytes - committed_bytes;
+}
+
+MU_TEST(canvas_gui_damage) {
+    CanvasTestMenu* menu = malloc(sizeof(CanvasTestMenu));
+    menu->gui = furi_record_open(RECORD_GUI);
+    menu->frame = furi_semaphore_alloc(1, 0);
+    menu->view_port = view_port_alloc();
+    view_port_draw_callback_set(menu->view_port, canvas_test_menu_draw_callback, menu);
+
+    gui_add_framebuffer_damage_callback(menu->gui, canvas_test_menu_damage_callback, menu);
+    gui_add_view_port(menu->gui, menu->view_port, GuiLayerFullscreen);
+    uint32_t open_bytes = canvas_test_menu_select(menu, 0, false);
+
+    uint32_t select_bytes = canvas_test_menu_select(menu, 1, false);
+    uint32_t select_rect_bytes = canvas_test_menu_select(menu, 2, true);
+    uint32_t same_bytes = canvas_test_menu_select(menu, 2, false);
+
+    gui_remove_view_port(menu->gui, menu->view_port);
+    gui_remove_framebuffer_damage_callback(menu->gui, canvas_test_menu_damage_callback, menu);
+    view_port_free(menu->view_port);
+    furi_semaphore_free(menu->frame);
+    furi_record_close(RECORD_GUI);
+    free(menu);
+
+    FURI_LOG_I(
+        TAG,
+        "Bytes flushed: open %lu, select %lu, select rect %lu, same %lu",
+        open_bytes,
+        select_bytes,
+        select_rect_bytes,
+        same_bytes);
+
+    // Items 0-1 are rows 0-23, pages 0-2
+    mu_assert_int_eq(3 * 128, select_bytes);
+    // Items 1-2 are rows 12-35, pages 1-4
+    mu_assert_int_eq(4 * 128, select_rect_bytes);
+    mu_assert_int_eq(0, same_bytes);
+}
+
+#define CANVAS_TEST_STATUS_BAR_PAGES (2)
+
+typedef struct {
+    Gui* gui;
+    FuriSemaphore* frame;
+    volatile uint32_t main_drawn;
+    volatile uint32_t status_drawn;
+    uint32_t frame_main_drawn;
+    uint32_t frame_status_drawn;
+    uint8_t buffer[CANVAS_TEST_BUFFER_SIZE];
+} CanvasTestClear;
+
+// Clears whole canvas like most views do
+static void canvas_test_clear_main_draw_callback(Canvas* canvas, void* context) {
+    CanvasTestClear* test = context;
+    test->main_drawn++;
+    canvas_clear(canvas);
+    canvas_draw_box(canvas, 0, canvas_height(canvas) - 16, canvas_width(canvas), 8);
+}
+
+static void canvas_test_clear_status_draw_callback(Canvas* canvas, void* context) {
+    CanvasTestClear* test = context;
+    test->status_drawn++;
+    canvas_draw_box(canvas, 0, 0, canvas_width(canvas), canvas_height(canvas));
+}
+
+static void canvas_test_clear_damage_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    const CanvasDamage* damage,
+    void* context) {
+    UNUSED(orientation);
+    UNUSED(damage);
+    CanvasTestClear* test = context;
+    // Called from GUI thread with GUI locked
+    memcpy(test->buffer, data, MIN(size, sizeof(test->buffer)));
+    test->frame_main_drawn = test->main_drawn;
+    test->frame_status_drawn = test->status_drawn;
+    furi_semaphore_release(test->frame);
+}
+
+// Wait for frame with both ViewPorts drawn at least given times
+static bool canvas_test_clear_wait(CanvasTestClear* test, uint32_t main, uint32_t status) {
+    do {
+        if(furi_semaphore_acquire(test->frame, 1000) != FuriStatusOk) return false;
+    } while(test->frame_main_drawn < main || test->frame_status_drawn < status);
+    return true;
+}
+
+MU_TEST(canvas_gui_damage_clear) {
+    CanvasTestClear* test = malloc(sizeof(CanvasTestClear));
+    memset(test, 0, sizeof(CanvasTestClear));
+    uint8_t* before = malloc(CANVAS_TEST_BUFFER_SIZE);
+    size_t page_size = CANVAS_TEST_BUFFER_SIZE / 8;
+    size_t status_bar_size = CANVAS_TEST_STATUS_BAR_PAGES * page_size;
+    test->gui = furi_record_open(RECORD_GUI);
+    test->frame = furi_semaphore_alloc(1, 0);
+
+    ViewPort* main = view_port_alloc();
+    view_port_draw_callback_set(main, canvas_test_clear_main_draw_callback, test);
+    ViewPort* status = view_port_alloc();
+    view_port_set_width(status, 8);
+    view_port_draw_callback_set(status, canvas_test_clear_status_draw_callback, test);
+
+    gui_add_framebuffer_damage_callback(test->gui, canvas_test_clear_damage_callback, test);
+    gui_add_view_port(test->gui, status, GuiLayerStatusBarLeft);
+
+    // Status bar only redraw over desktop: main area must stay
+    gui_add_view_port(test->gui, main, GuiLayerDesktop);
+    bool desktop_drawn = canvas_test_clear_wait(test, 1, 1);
+    memcpy(before, test->buffer, CANVAS_TEST_BUFFER_SIZE);
+    uint32_t status_drawn_count = test->status_drawn;
+    view_port_update(status);
+    bool status_drawn = canvas_test_clear_wait(test, 0, status_drawn_count + 1);
+    bool desktop_kept = memcmp(
+                            &before[status_bar_size],
+                            &test->buffer[status_bar_size],
+                            CANVAS_TEST_BUFFER_SIZE - status_bar_size) == 0;
+    gui_remove_view_port(test->gui, main);
+
+    // Window redraw: status bar must stay
+    uint32_t main_drawn_count = test->main_drawn;
+    gui_add_view_port(test->gui, main, GuiLayerWindow);
+    bool window_drawn = canvas_test_clear_wait(test, main_drawn_count + 1, 0);
+    memcpy(before, test->buffer, CANVAS_TEST_BUFFER_SIZE);
+    main_drawn_count = test->main_drawn;
+    view_port_update(main);
+    bool window_updated = canvas_test_clear_wait(test, main_drawn_count + 1, 0);
+    bool status_bar_kept = memcmp(before, test->buffer, status_bar_size) == 0;
+    gui_remove_view_port(test->gui, main);
+
+    gui_remove_view_port(test->gui, status);
+    gui_remove_framebuffer_damage_callback(test->gui, canvas_test_clear_damage_callback, test);
+    view_port_free(status);
+    view_port_free(main);
+    furi_semaphore_free(test->frame);
+    furi_record_close(RECORD_GUI);
+    free(before);
+    free(test);
+
+    mu_assert(desktop_drawn && status_drawn, "desktop frame timeout");
+    mu_assert(desktop_kept, "status bar redraw erased desktop view");
+    mu_assert(window_drawn && window_updated, "window frame timeout");
+    mu_assert(status_bar_kept, "window redraw erased status bar");
+}
+
+MU_TEST_SUITE(canvas_damage) {
+    MU_RUN_TEST(canvas_commit_damage);
+    MU_RUN_TEST(canvas_gui_damage);
+    MU_RUN_TEST(canvas_gui_damage_clear);
+}
+
+int run_minunit_test_canvas() {
+    MU_RUN_SUITE(canvas_bitmap);
+    MU_RUN_SUITE(canvas_icon_cache);
+    MU_RUN_SUITE(canvas_damage);
+    return MU_EXIT_CODE;
+}
@@ -21,6 +21,8 @@
 #define NFC_TEST_SIGNAL_SHORT_FILE "nfc_nfca_signal_short.nfc"
 #define NFC_TEST_SIGNAL_LONG_FILE "nfc_nfca_signal_long.nfc"
 #define NFC_TEST_DICT_PATH EXT_PATH("unit_tests/mf_classic_dict.nfc")
+/* 13 bytes per key: dict doesn't fit one scan round trip */
+#define NFC_TEST_DICT_SCAN_KEYS (400)
 #define NFC_TEST_NFC_DEV_PATH EXT_PATH("unit_tests/nfc/nfc_dev_test.nfc")
 
 static const char* nfc_test_file_type = "Flipper NFC test";
@@ -485,6 +487,64 @@ MU_TEST(mf_classic_dict_load_test) {
     furi_record_close(RECORD_STORAGE);
 }
 
+MU_TEST(mf_classic_dict_scan_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage != NULL, "storage != NULL assert failed\r\n");
+
+    // Dict takes several scan round trips, comments and invalid lines are mixed with keys
+    Stream* file_stream = file_stream_alloc(storage);
+    mu_assert(
+        file_stream_open(file_stream, NFC_TEST_DICT_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS),
+        "file_stream_open == true assert failed\r\n");
+    FuriString* temp_str = furi_string_alloc();
+    for(uint32_t i = 0; i < NFC_TEST_DICT_SCAN_KEYS; i++) {
+        if(i % 50 == 0) {
+            // Key length comment
+            stream_write_cstring(file_stream, "#a0a1a2a3a4a\n");
+        }
+        if(i % 30 == 0) {
+            stream_write_cstring(file_stream, "a0a1a2\n");
+        }
+        furi_string_printf(temp_str, "%012lX%s", i, (i % 2) ? "\r\n" : "\n");
+        // Last key without new line ending
+        if(i == NFC_TEST_DICT_SCAN_KEYS - 1) {
+            furi_string_left(temp_str, 12);
+        }
+        mu_assert(
+            stream_write_string(file_stream, temp_str) == furi_string_size(temp_str),
+            "write == true assert failed\r\n");
+    }
+    mu_assert(file_stream_close(file_stream), "file_stream_close == true assert failed\r\n");
+    furi_string_free(temp_str);
+
+    // Loaded twice: before and after new line ending is appended
+    for(size_t load = 0; load < 2; load++) {
+        MfClassicDict* instance = mf_classic_dict_alloc(MfClassicDictTypeUnitTest);
+        mu_assert(instance != NULL, "mf_classic_dict_alloc\r\n");
+        mu_assert(
+            mf_classic_dict_get_total_keys(instance) == NFC_TEST_DICT_SCAN_KEYS,
+            "total_keys == NFC_TEST_DICT_SCAN_KEYS assert failed\r\n");
+
+        // Lookup sees the same keys that were counted
+        uint64_t key = 0;
+        for(uint32_t i = 0; i < NFC_TEST_DICT_SCAN_KEYS; i++) {
+            mu_assert(
+                mf_classic_dict_get_next_key(instance, &key),
+                "get_next_key == true assert failed\r\n");
+            mu_assert(key == i, "invalid key loaded\r\n");
+        }
+        mu_assert(
+            !mf_classic_dict_get_next_key(instance, &key),
+            "get_next_key == false assert failed\r\n");
+        mf_classic_dict_free(instance);
+    }
+
+    mu_assert(
+        storage_simply_remove(storage, NFC_TEST_DICT_PATH), "remove == true assert failed\r\n");
+    stream_free(file_stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST(nfca_file_test) {
     NfcDevice* nfc = nfc_device_alloc();
     mu_assert(nfc != NULL, "nfc_device_data != NULL assert failed\r\n");
@@ -715,6 +775,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(nfc_digital_signal_test);
     MU_RUN_TEST(mf_classic_dict_test);
     MU_RUN_TEST(mf_classic_dict_load_test);
+    MU_RUN_TEST(mf_classic_dict_scan_test);
 
     nfc_test_free();
 }
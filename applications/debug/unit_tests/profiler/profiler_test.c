@@ -0,0 +1,86 @@
+#include <furi.h>
+#include <profiler_aggregate.h>
+
+#include "../minunit.h"
+
+#define THREAD_A ((FuriThreadId)0x20001000)
+#define THREAD_B ((FuriThreadId)0x20002000)
+
+static const ProfilerSample profiler_test_samples[] = {
+    {0x08000104, THREAD_A},
+    {0x08000100, THREAD_A},
+    {0x08000200, THREAD_B},
+    {0x08000100, THREAD_B},
+    {0x08000104, THREAD_A},
+    {0x08000100, THREAD_A},
+    {0x08000300, THREAD_B},
+};
+
+MU_TEST(profiler_aggregate_exact_test) {
+    ProfilerHotspot hotspots[8];
+    size_t count = profiler_aggregate_hotspots(
+        profiler_test_samples, COUNT_OF(profiler_test_samples), NULL, 1, hotspots, 8);
+
+    mu_assert_int_eq(4, count);
+    mu_assert_int_eq(0x08000100, hotspots[0].pc);
+    mu_assert_int_eq(3, hotspots[0].count);
+    mu_assert_int_eq(0x08000104, hotspots[1].pc);
+    mu_assert_int_eq(2, hotspots[1].count);
+    // Same count: ordered by address
+    mu_assert_int_eq(0x08000200, hotspots[2].pc);
+    mu_assert_int_eq(1, hotspots[2].count);
+    mu_assert_int_eq(0x08000300, hotspots[3].pc);
+    mu_assert_int_eq(1, hotspots[3].count);
+}
+
+MU_TEST(profiler_aggregate_granularity_test) {
+    ProfilerHotspot hotspots[8];
+    size_t count = profiler_aggregate_hotspots(
+        profiler_test_samples, COUNT_OF(profiler_test_samples), NULL, 256, hotspots, 8);
+
+    mu_assert_int_eq(3, count);
+    mu_assert_int_eq(0x08000100, hotspots[0].pc);
+    mu_assert_int_eq(5, hotspots[0].count);
+    mu_assert_int_eq(0x08000200, hotspots[1].pc);
+    mu_assert_int_eq(0x08000300, hotspots[2].pc);
+}
+
+MU_TEST(profiler_aggregate_thread_test) {
+    ProfilerHotspot hotspots[8];
+    size_t count = profiler_aggregate_hotspots(
+        profiler_test_samples, COUNT_OF(profiler_test_samples), THREAD_B, 1, hotspots, 8);
+
+    mu_assert_int_eq(3, count);
+    mu_assert_int_eq(0x08000100, hotspots[0].pc);
+    mu_assert_int_eq(1, hotspots[0].count);
+
+    size_t samples_count = COUNT_OF(profiler_test_samples);
+    mu_assert_int_eq(4, profiler_aggregate_count(profiler_test_samples, samples_count, THREAD_A));
+    mu_assert_int_eq(
+        samples_count, profiler_aggregate_count(profiler_test_samples, samples_count, NULL));
+}
+
+MU_TEST(profiler_aggregate_limit_test) {
+    ProfilerHotspot hotspots[2];
+    size_t count = profiler_aggregate_hotspots(
+        profiler_test_samples, COUNT_OF(profiler_test_samples), NULL, 1, hotspots, 2);
+
+    mu_assert_int_eq(2, count);
+    mu_assert_int_eq(0x08000100, hotspots[0].pc);
+    mu_assert_int_eq(0x08000104, hotspots[1].pc);
+
+    count = profiler_aggregate_hotspots(profiler_test_samples, 0, NULL, 1, hotspots, 2);
+    mu_assert_int_eq(0, count);
+}
+
+MU_TEST_SUITE(profiler_suite) {
+    MU_RUN_TEST(profiler_aggregate_exact_test);
+    MU_RUN_TEST(profiler_aggregate_granularity_test);
+    MU_RUN_TEST(profiler_aggregate_thread_test);
+    MU_RUN_TEST(profiler_aggregate_limit_test);
+}
+
+int run_minunit_test_profiler() {
+    MU_RUN_SUITE(profiler_suite);
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,175 @@
+#include "../minunit.h"
+#include <furi.h>
+#include <u8g2.h>
+#include <rpc/rpc_gui_stream.h>
+
+#define TAG "RpcGuiStreamTest"
+
+#define RPC_GUI_STREAM_TEST_FRAME_SIZE (128 * 64 / 8)
+#define RPC_GUI_STREAM_TEST_FPS (30)
+#define RPC_GUI_STREAM_TEST_KEYFRAME_INTERVAL (64)
+#define RPC_GUI_STREAM_TEST_MENU_ITEMS (5)
+
+static const u8x8_display_info_t rpc_gui_stream_test_display_info = {
+    .tile_width = 16,
+    .tile_height = 8,
+    .pixel_width = 128,
+    .pixel_height = 64,
+};
+
+static uint8_t
+    rpc_gui_stream_test_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    if(msg == U8X8_MSG_DISPLAY_SETUP_MEMORY) {
+        u8x8_d_helper_display_setup_memory(u8x8, &rpc_gui_stream_test_display_info);
+        return 1;
+    }
+    return 0;
+}
+
+typedef void (*RpcGuiStreamTestScene)(u8g2_t* u8g2, uint32_t frame);
+
+// Menu with selection moving every 15 frames and a ticking clock
+static void rpc_gui_stream_test_scene_menu(u8g2_t* u8g2, uint32_t frame) {
+    uint8_t selected = (frame / 15) % RPC_GUI_STREAM_TEST_MENU_ITEMS;
+    for(uint8_t i = 0; i < RPC_GUI_STREAM_TEST_MENU_ITEMS; i++) {
+        uint8_t y = 13 + i * 10;
+        u8g2_SetDrawColor(u8g2, 1);
+        if(i == selected) {
+            u8g2_DrawBox(u8g2, 0, y, 120, 10);
+            u8g2_SetDrawColor(u8g2, 0);
+        }
+        u8g2_DrawStr(u8g2, 4, y + 8, "Sub-GHz Read RAW");
+    }
+    u8g2_SetDrawColor(u8g2, 1);
+    char clock[8];
+    snprintf(clock, sizeof(clock), "12:%02lu", (frame / RPC_GUI_STREAM_TEST_FPS) % 60);
+    u8g2_DrawStr(u8g2, 100, 9, clock);
+}
+
+// Scrolling text, like long file names in archive
+static void rpc_gui_stream_test_scene_scroll(u8g2_t* u8g2, uint32_t frame) {
+    u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+    u8g2_DrawStr(u8g2, 4 - (frame % 120), 30, "Very_long_signal_name_recorded_at_433MHz.sub");
+    u8g2_DrawBox(u8g2, 0, 50, (frame * 2) % 128, 6);
+}
+
+// Bouncing sprite over noisy background, worst case for delta frames
+static void rpc_gui_stream_test_scene_animation(u8g2_t* u8g2, uint32_t frame) {
+    for(uint8_t x = 0; x < 128; x += 4) {
+        u8g2_DrawVLine(u8g2, x, (x * 7 + frame) % 32, 32);
+    }
+    uint8_t x = frame % 224;
+    if(x > 112) x = 224 - x;
+    u8g2_DrawDisc(u8g2, x + 8, 32, 8, U8G2_DRAW_ALL);
+}
+
+static const struct {
+    const char* name;
+    RpcGuiStreamTestScene scene;
+    uint32_t frames;
+} rpc_gui_stream_test_sessions[] = {
+    {"menu", rpc_gui_stream_test_scene_menu, 300},
+    {"scroll", rpc_gui_stream_test_scene_scroll, 300},
+    {"animation", rpc_gui_stream_test_scene_animation, 300},
+};
+
+MU_TEST(rpc_gui_stream_session) {
+    u8g2_t* u8g2 = malloc(sizeof(u8g2_t));
+    uint8_t* buffer = malloc(RPC_GUI_STREAM_TEST_FRAME_SIZE);
+    uint8_t* data = malloc(rpc_gui_stream_get_max_size(RPC_GUI_STREAM_TEST_FRAME_SIZE));
+    u8g2_SetupDisplay(
+        u8g2, rpc_gui_stream_test_display_cb, u8x8_cad_empty, u8x8_dummy_cb, u8x8_dummy_cb);
+    u8g2_SetupBuffer(u8g2, buffer, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    u8g2_SetFont(u8g2, u8g2_font_haxrcorp4089_tr);
+
+    bool decoded = true;
+    size_t raw_total = 0;
+    size_t delta_total = 0;
+    for(size_t i = 0; i < COUNT_OF(rpc_gui_stream_test_sessions); i++) {
+        RpcGuiStreamEncoder* encoder = rpc_gui_stream_encoder_alloc(
+            RPC_GUI_STREAM_TEST_FRAME_SIZE, RPC_GUI_STREAM_TEST_KEYFRAME_INTERVAL);
+        RpcGuiStreamDecoder* decoder =
+            rpc_gui_stream_decoder_alloc(RPC_GUI_STREAM_TEST_FRAME_SIZE);
+
+        uint32_t frames = rpc_gui_stream_test_sessions[i].frames;
+        size_t session_size = 0;
+        uint32_t encode_ticks = 0;
+        for(uint32_t frame = 0; frame < frames; frame++) {
+            u8g2_ClearBuffer(u8g2);
+            rpc_gui_stream_test_sessions[i].scene(u8g2, frame);
+
+            uint32_t start = furi_get_tick();
+            size_t size = rpc_gui_stream_encode(encoder, buffer, data);
+            encode_ticks += furi_get_tick() - start;
+            session_size += size;
+
+            const uint8_t* result = rpc_gui_stream_decode(decoder, data, size);
+            if(!result || memcmp(result, buffer, RPC_GUI_STREAM_TEST_FRAME_SIZE) != 0) {
+                decoded = false;
+            }
+        }
+
+        FURI_LOG_I(
+            TAG,
+            "%s: raw %u B/s, delta %u B/s, encode %luus per frame",
+            rpc_gui_stream_test_sessions[i].name,
+            RPC_GUI_STREAM_TEST_FRAME_SIZE * RPC_GUI_STREAM_TEST_FPS,
+            session_size * RPC_GUI_STREAM_TEST_FPS / frames,
+            encode_ticks * 1000 / frames);
+
+        raw_total += RPC_GUI_STREAM_TEST_FRAME_SIZE * frames;
+        delta_total += session_size;
+        rpc_gui_stream_decoder_free(decoder);
+        rpc_gui_stream_encoder_free(encoder);
+    }
+
+    free(data);
+    free(buffer);
+    free(u8g2);
+
+    mu_assert(decoded, "decoded frame differs from source");
+    mu_assert(delta_total * 4 < raw_total, "delta stream is not at least 4 times smaller");
+}
+
+MU_TEST(rpc_gui_stream_sequence) {
+    RpcGuiStreamEncoder* encoder = rpc_gui_stream_encoder_alloc(RPC_GUI_STREAM_TEST_FRAME_SIZE, 8);
+    RpcGuiStreamDecoder* decoder = rpc_gui_stream_decoder_alloc(RPC_GUI_STREAM_TEST_FRAME_SIZE);
+    uint8_t* frame = malloc(RPC_GUI_STREAM_TEST_FRAME_SIZE);
+    uint8_t* data = malloc(rpc_gui_stream_get_max_size(RPC_GUI_STREAM_TEST_FRAME_SIZE));
+
+    size_t size = rpc_gui_stream_encode(encoder, frame, data);
+    bool keyframe_decoded = rpc_gui_stream_decode(decoder, data, size) != NULL;
+
+    // Lost frame, next delta must be rejected until keyframe
+    frame[10] = 0xAA;
+    rpc_gui_stream_encode(encoder, frame, data);
+    frame[20] = 0x55;
+    size = rpc_gui_stream_encode(encoder, frame, data);
+    bool lost_rejected = rpc_gui_stream_decode(decoder, data, size) == NULL;
+
+    rpc_gui_stream_encoder_reset(encoder);
+    size = rpc_gui_stream_encode(encoder, frame, data);
+    const uint8_t* result = rpc_gui_stream_decode(decoder, data, size);
+    bool recovered = result && (memcmp(result, frame, RPC_GUI_STREAM_TEST_FRAME_SIZE) == 0);
+
+    free(data);
+    free(frame);
+    rpc_gui_stream_decoder_free(decoder);
+    rpc_gui_stream_encoder_free(encoder);
+
+    mu_assert(keyframe_decoded, "keyframe is not decoded");
+    mu_assert(lost_rejected, "delta after lost frame is accepted");
+    mu_assert(recovered, "stream is not recovered by keyframe");
+}
+
+MU_TEST_SUITE(rpc_gui_stream) {
+    MU_RUN_TEST(rpc_gui_stream_sequence);
+    MU_RUN_TEST(rpc_gui_stream_session);
+}
+
+int run_minunit_test_rpc_gui_stream() {
+    MU_RUN_SUITE(rpc_gui_stream);
+    return MU_EXIT_CODE;
+}
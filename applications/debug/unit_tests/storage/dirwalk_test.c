@@ -244,6 +244,8 @@ MU_TEST_1(test_dirwalk_filter, Storage* storage) {
     while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
         furi_string_right(path, strlen(EXT_PATH("dirwalk/")));
         mu_check(storage_test_paths_mark(paths, path, file_info_is_dir(&fileinfo)));
+        // FAT keeps modification time of files, date is never 0
+        mu_check(dir_walk_get_mtime(dir_walk) != 0);
     }
 
     dir_walk_free(dir_walk);
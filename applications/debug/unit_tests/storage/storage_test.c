@@ -1,6 +1,10 @@
 #include "../minunit.h"
 #include <furi.h>
 #include <storage/storage.h>
+#include <toolbox/dir_walk.h>
+#include <toolbox/path.h>
+#include <toolbox/tar/tar_archive.h>
+#include <gui/modules/file_browser_worker.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
@@ -625,6 +629,698 @@ MU_TEST(test_md5_calc) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_BATCH_DIR UNIT_TESTS_PATH("batch")
+#define STORAGE_BATCH_FILES_COUNT (16)
+#define STORAGE_BATCH_FILE_DATA "0123456789abcdef"
+
+static void storage_batch_setup() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    storage_simply_mkdir(storage, STORAGE_BATCH_DIR);
+
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < STORAGE_BATCH_FILES_COUNT; i++) {
+        furi_string_printf(path, "%s/%02u.test", STORAGE_BATCH_DIR, (unsigned)i);
+        furi_check(
+            storage_file_create(storage, furi_string_get_cstr(path), STORAGE_BATCH_FILE_DATA));
+    }
+    furi_string_free(path);
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_batch_teardown() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_batch_report(
+    const char* workload,
+    uint32_t single_trips,
+    uint32_t single_ticks,
+    uint32_t batch_trips,
+    uint32_t batch_ticks) {
+    FURI_LOG_I(
+        "StorageTest",
+        "%s: single %lu round trips %lu ms, batch %lu round trips %lu ms",
+        workload,
+        single_trips,
+        single_ticks,
+        batch_trips,
+        batch_ticks);
+}
+
+MU_TEST(storage_batch_stat) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path[STORAGE_BATCH_FILES_COUNT + 1];
+    FileInfo single_info[STORAGE_BATCH_FILES_COUNT + 1];
+    FileInfo batch_info[STORAGE_BATCH_FILES_COUNT + 1];
+    FS_Error single_error[STORAGE_BATCH_FILES_COUNT + 1];
+    StorageBatchOp ops[STORAGE_BATCH_FILES_COUNT + 1];
+
+    for(size_t i = 0; i < COUNT_OF(path); i++) {
+        // Last path does not exist
+        path[i] = furi_string_alloc_printf("%s/%02u.test", STORAGE_BATCH_DIR, (unsigned)i);
+        ops[i] = (StorageBatchOp){
+            .type = StorageBatchOpStat,
+            .path = furi_string_get_cstr(path[i]),
+            .fileinfo = &batch_info[i],
+        };
+    }
+
+    uint32_t trips = storage->processed_messages;
+    uint32_t ticks = furi_get_tick();
+    for(size_t i = 0; i < COUNT_OF(path); i++) {
+        single_error[i] =
+            storage_common_stat(storage, furi_string_get_cstr(path[i]), &single_info[i]);
+    }
+    uint32_t single_ticks = furi_get_tick() - ticks;
+    uint32_t single_trips = storage->processed_messages - trips;
+
+    trips = storage->processed_messages;
+    ticks = furi_get_tick();
+    mu_assert_int_eq(COUNT_OF(ops), storage_batch_execute(storage, ops, COUNT_OF(ops), false));
+    uint32_t batch_ticks = furi_get_tick() - ticks;
+    uint32_t batch_trips = storage->processed_messages - trips;
+
+    for(size_t i = 0; i < COUNT_OF(path); i++) {
+        mu_assert_int_eq(single_error[i], ops[i].error);
+        if(single_error[i] == FSE_OK) {
+            mu_assert_int_eq(single_info[i].size, batch_info[i].size);
+            mu_assert_int_eq(single_info[i].flags, batch_info[i].flags);
+        }
+    }
+    mu_assert_int_eq(FSE_NOT_EXIST, ops[STORAGE_BATCH_FILES_COUNT].error);
+    // Other storage users add their own round trips: only bounds hold
+    mu_check(single_trips >= COUNT_OF(ops));
+    mu_check(batch_trips < COUNT_OF(ops));
+
+    storage_batch_report("stat", single_trips, single_ticks, batch_trips, batch_ticks);
+
+    // Processing stops on first error if requested, results of the rest are untouched
+    ops[1].path = STORAGE_BATCH_DIR "/missing.test";
+    ops[2].error = FSE_INTERNAL;
+    mu_assert_int_eq(2, storage_batch_execute(storage, ops, COUNT_OF(ops), true));
+    mu_assert_int_eq(FSE_OK, ops[0].error);
+    mu_assert_int_eq(FSE_NOT_EXIST, ops[1].error);
+    mu_assert_int_eq(FSE_INTERNAL, ops[2].error);
+
+    for(size_t i = 0; i < COUNT_OF(path); i++) {
+        furi_string_free(path[i]);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    char buffer[sizeof(STORAGE_BATCH_FILE_DATA)] = {0};
+    const size_t data_size = strlen(STORAGE_BATCH_FILE_DATA);
+
+    // open, seek, read and close in one round trip
+    StorageBatchOp ops[] = {
+        {
+            .type = StorageBatchOpFileOpen,
+            .file = file,
+            .path = STORAGE_BATCH_DIR "/00.test",
+            .access_mode = FSAM_READ,
+            .open_mode = FSOM_OPEN_EXISTING,
+        },
+        {
+            .type = StorageBatchOpFileSeek,
+            .file = file,
+            .offset = 4,
+            .from_start = true,
+        },
+        {
+            .type = StorageBatchOpFileRead,
+            .file = file,
+            .buff = buffer,
+            .size = data_size,
+        },
+        {
+            .type = StorageBatchOpFileClose,
+            .file = file,
+        },
+    };
+
+    uint32_t trips = storage->processed_messages;
+    uint32_t ticks = furi_get_tick();
+    mu_assert_int_eq(COUNT_OF(ops), storage_batch_execute(storage, ops, COUNT_OF(ops), true));
+    uint32_t batch_ticks = furi_get_tick() - ticks;
+    uint32_t batch_trips = storage->processed_messages - trips;
+
+    for(size_t i = 0; i < COUNT_OF(ops); i++) {
+        mu_assert_int_eq(FSE_OK, ops[i].error);
+    }
+    mu_assert_int_eq(data_size - 4, ops[2].bytes_read);
+    mu_assert_mem_eq(STORAGE_BATCH_FILE_DATA + 4, buffer, data_size - 4);
+    mu_check(!storage_file_is_open(file));
+
+    trips = storage->processed_messages;
+    ticks = furi_get_tick();
+    mu_check(storage_file_open(file, STORAGE_BATCH_DIR "/00.test", FSAM_READ, FSOM_OPEN_EXISTING));
+    mu_check(storage_file_seek(file, 4, true));
+    mu_assert_int_eq(data_size - 4, storage_file_read(file, buffer, data_size));
+    mu_check(storage_file_close(file));
+    uint32_t single_ticks = furi_get_tick() - ticks;
+    uint32_t single_trips = storage->processed_messages - trips;
+
+    storage_batch_report(
+        "open+seek+read+close", single_trips, single_ticks, batch_trips, batch_ticks);
+    mu_check(batch_trips < COUNT_OF(ops));
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_read_v) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    char head[4] = {0};
+    char body[8] = {0};
+    char tail[8] = {0};
+    const StorageIoVec iov[] = {
+        {.buff = head, .size = sizeof(head)},
+        {.buff = body, .size = sizeof(body)},
+        {.buff = tail, .size = sizeof(tail)},
+    };
+
+    mu_check(storage_file_open(file, STORAGE_BATCH_DIR "/01.test", FSAM_READ, FSOM_OPEN_EXISTING));
+
+    uint32_t trips = storage->processed_messages;
+    // Only 4 bytes left for the last buffer
+    mu_assert_int_eq(
+        strlen(STORAGE_BATCH_FILE_DATA), storage_file_read_v(file, iov, COUNT_OF(iov)));
+    mu_assert_int_eq(1, storage->processed_messages - trips);
+
+    mu_assert_mem_eq(STORAGE_BATCH_FILE_DATA, head, sizeof(head));
+    mu_assert_mem_eq(STORAGE_BATCH_FILE_DATA + 4, body, sizeof(body));
+    mu_assert_mem_eq(STORAGE_BATCH_FILE_DATA + 12, tail, 4);
+
+    mu_check(storage_file_close(file));
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_batch_dir_walk) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FuriString* walk_path[STORAGE_BATCH_FILES_COUNT + 1];
+    uint64_t walk_size[STORAGE_BATCH_FILES_COUNT + 1];
+    FileInfo fileinfo;
+
+    uint32_t trips = storage->processed_messages;
+    uint32_t ticks = furi_get_tick();
+    size_t count = 0;
+    mu_check(dir_walk_open(dir_walk, STORAGE_BATCH_DIR));
+    while(dir_walk_read(dir_walk, path, &fileinfo) == DirWalkOK) {
+        if(count < COUNT_OF(walk_path)) {
+            walk_path[count] = furi_string_alloc_set(path);
+            walk_size[count] = fileinfo.size;
+        }
+        count++;
+    }
+    dir_walk_close(dir_walk);
+    uint32_t batch_ticks = furi_get_tick() - ticks;
+    uint32_t batch_trips = storage->processed_messages - trips;
+
+    mu_assert_int_eq(STORAGE_BATCH_FILES_COUNT, count);
+    // open + close + one read per batch instead of one per entry
+    mu_check(batch_trips < STORAGE_BATCH_FILES_COUNT);
+
+    File* file = storage_file_alloc(storage);
+    char name[256];
+    size_t single_count = 0;
+    bool entries_match = true;
+    trips = storage->processed_messages;
+    ticks = furi_get_tick();
+    mu_check(storage_dir_open(file, STORAGE_BATCH_DIR));
+    while(storage_dir_read(file, &fileinfo, name, sizeof(name))) {
+        // Same entries in the same order, batched read ahead doesn't skip or repeat any
+        furi_string_printf(path, "%s/%s", STORAGE_BATCH_DIR, name);
+        entries_match = entries_match && (single_count < count) &&
+                        furi_string_equal(walk_path[single_count], path) &&
+                        (walk_size[single_count] == fileinfo.size);
+        single_count++;
+    }
+    storage_dir_close(file);
+    uint32_t single_ticks = furi_get_tick() - ticks;
+    uint32_t single_trips = storage->processed_messages - trips;
+    storage_file_free(file);
+
+    for(size_t i = 0; i < count; i++) {
+        furi_string_free(walk_path[i]);
+    }
+    mu_assert_int_eq(count, single_count);
+    mu_check(entries_match);
+    mu_assert_int_eq(strlen(STORAGE_BATCH_FILE_DATA), walk_size[0]);
+
+    storage_batch_report("dir listing", single_trips, single_ticks, batch_trips, batch_ticks);
+
+    furi_string_free(path);
+    dir_walk_free(dir_walk);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_batch) {
+    storage_batch_setup();
+    MU_RUN_TEST(storage_batch_stat);
+    MU_RUN_TEST(storage_batch_file);
+    MU_RUN_TEST(storage_batch_read_v);
+    MU_RUN_TEST(storage_batch_dir_walk);
+    storage_batch_teardown();
+}
+
+#define STORAGE_BROWSER_DIR UNIT_TESTS_PATH("browser")
+#define STORAGE_BROWSER_FILES_COUNT (5000)
+#define STORAGE_BROWSER_WINDOW (50)
+#define STORAGE_BROWSER_TIMEOUT (60000)
+
+typedef struct {
+    FuriSemaphore* folder_sem;
+    FuriSemaphore* load_sem;
+    uint32_t item_cnt;
+    uint32_t loaded_cnt;
+    bool sorted;
+    FuriString* name;
+    FuriString* name_prev;
+} StorageBrowserBench;
+
+static void storage_browser_setup() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BROWSER_DIR);
+    storage_simply_mkdir(storage, STORAGE_BROWSER_DIR);
+
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < STORAGE_BROWSER_FILES_COUNT; i++) {
+        // Shuffle creation order, so directory order is not sorted
+        unsigned index = (i * 7919) % STORAGE_BROWSER_FILES_COUNT;
+        furi_string_printf(path, "%s/%04u.bench", STORAGE_BROWSER_DIR, index);
+        furi_check(
+            storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_NEW));
+        storage_file_close(file);
+    }
+    furi_string_free(path);
+    storage_file_free(file);
+
+    // Listing built in the same second as modification is not cached
+    furi_delay_ms(1100);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_browser_teardown() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_BROWSER_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_browser_folder_callback(
+    void* context,
+    uint32_t item_cnt,
+    int32_t file_idx,
+    bool is_root) {
+    UNUSED(file_idx);
+    UNUSED(is_root);
+    StorageBrowserBench* bench = context;
+    bench->item_cnt = item_cnt;
+    furi_semaphore_release(bench->folder_sem);
+}
+
+static void storage_browser_list_callback(void* context, uint32_t list_load_offset) {
+    UNUSED(list_load_offset);
+    StorageBrowserBench* bench = context;
+    bench->loaded_cnt = 0;
+    bench->sorted = true;
+    furi_string_reset(bench->name_prev);
+}
+
+static void storage_browser_item_callback(
+    void* context,
+    FuriString* item_path,
+    uint32_t idx,
+    bool is_folder,
+    bool is_last) {
+    UNUSED(idx);
+    UNUSED(is_folder);
+    StorageBrowserBench* bench = context;
+    if(is_last) {
+        furi_semaphore_release(bench->load_sem);
+        return;
+    }
+
+    path_extract_filename(item_path, bench->name, false);
+    // Same order as file_browser sorts display names in
+    if(!furi_string_empty(bench->name_prev) &&
+       furi_string_cmpi(bench->name_prev, bench->name) >= 0) {
+        bench->sorted = false;
+    }
+    furi_string_set(bench->name_prev, bench->name);
+    bench->loaded_cnt++;
+}
+
+static void storage_browser_enter(
+    BrowserWorker* browser,
+    StorageBrowserBench* bench,
+    uint32_t* ticks,
+    uint32_t* trips) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc_set(STORAGE_BROWSER_DIR);
+    *trips = storage->processed_messages;
+    *ticks = furi_get_tick();
+    file_browser_worker_folder_enter(browser, path, 0);
+    FuriStatus status = furi_semaphore_acquire(bench->folder_sem, STORAGE_BROWSER_TIMEOUT);
+    *ticks = furi_get_tick() - *ticks;
+    *trips = storage->processed_messages - *trips;
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert_int_eq(FuriStatusOk, status);
+    mu_assert_int_eq(STORAGE_BROWSER_FILES_COUNT, bench->item_cnt);
+}
+
+static void storage_browser_load(
+    BrowserWorker* browser,
+    StorageBrowserBench* bench,
+    uint32_t offset,
+    uint32_t* ticks) {
+    *ticks = furi_get_tick();
+    file_browser_worker_load(browser, offset, STORAGE_BROWSER_WINDOW);
+    FuriStatus status = furi_semaphore_acquire(bench->load_sem, STORAGE_BROWSER_TIMEOUT);
+    *ticks = furi_get_tick() - *ticks;
+
+    mu_assert_int_eq(FuriStatusOk, status);
+    mu_assert_int_eq(STORAGE_BROWSER_WINDOW, bench->loaded_cnt);
+    mu_check(bench->sorted);
+}
+
+MU_TEST(storage_browser_listing) {
+    StorageBrowserBench bench = {
+        .folder_sem = furi_semaphore_alloc(1, 0),
+        .load_sem = furi_semaphore_alloc(1, 0),
+        .name = furi_string_alloc(),
+        .name_prev = furi_string_alloc(),
+    };
+
+    // Start in a small folder, callbacks can't be set before worker starts
+    FuriString* path = furi_string_alloc_set(UNIT_TESTS_PATH(""));
+    BrowserWorker* browser = file_browser_worker_alloc(path, NULL, "*", false, false);
+    furi_delay_ms(500);
+    file_browser_worker_set_callback_context(browser, &bench);
+    file_browser_worker_set_folder_callback(browser, storage_browser_folder_callback);
+    file_browser_worker_set_list_callback(browser, storage_browser_list_callback);
+    file_browser_worker_set_item_callback(browser, storage_browser_item_callback);
+
+    uint32_t cold_ticks, warm_ticks, first_ticks, middle_ticks, last_ticks;
+    uint32_t cold_trips, warm_trips;
+    storage_browser_enter(browser, &bench, &cold_ticks, &cold_trips);
+    storage_browser_load(browser, &bench, 0, &first_ticks);
+    mu_assert_string_eq("0049.bench", furi_string_get_cstr(bench.name_prev));
+    storage_browser_load(browser, &bench, STORAGE_BROWSER_FILES_COUNT / 2, &middle_ticks);
+    storage_browser_load(
+        browser, &bench, STORAGE_BROWSER_FILES_COUNT - STORAGE_BROWSER_WINDOW, &last_ticks);
+    mu_assert_string_eq("4999.bench", furi_string_get_cstr(bench.name_prev));
+    storage_browser_enter(browser, &bench, &warm_ticks, &warm_trips);
+
+    FURI_LOG_I(
+        "StorageTest",
+        "browser %d entries: enter cold %lu warm %lu ms (%lu / %lu round trips), "
+        "window %lu / %lu / %lu ms",
+        STORAGE_BROWSER_FILES_COUNT,
+        cold_ticks,
+        warm_ticks,
+        cold_trips,
+        warm_trips,
+        first_ticks,
+        middle_ticks,
+        last_ticks);
+    // Cold enter reads the whole folder, warm one is served from the listing cache
+    mu_check(cold_trips >= STORAGE_BROWSER_FILES_COUNT / STORAGE_BROWSER_WINDOW);
+    mu_check(warm_trips < STORAGE_BROWSER_FILES_COUNT / STORAGE_BROWSER_WINDOW);
+
+    file_browser_worker_free(browser);
+    furi_string_free(path);
+    furi_string_free(bench.name);
+    furi_string_free(bench.name_prev);
+    furi_semaphore_free(bench.folder_sem);
+    furi_semaphore_free(bench.load_sem);
+}
+
+MU_TEST_SUITE(storage_browser) {
+    storage_browser_setup();
+    MU_RUN_TEST(storage_browser_listing);
+    storage_browser_teardown();
+}
+
+#define STORAGE_TAR_SRC UNIT_TESTS_PATH("tar_src")
+#define STORAGE_TAR_DST UNIT_TESTS_PATH("tar_dst")
+#define STORAGE_TAR_PLAIN UNIT_TESTS_PATH("tar_test.tar")
+#define STORAGE_TAR_COMPRESSED UNIT_TESTS_PATH("tar_test" TAR_HEATSHRINK_EXTENSION)
+#define STORAGE_TAR_SINGLE UNIT_TESTS_PATH("tar_single.bin")
+#define STORAGE_TAR_CHUNK_SIZE (512)
+
+typedef struct {
+    const char* name;
+    size_t size;
+    bool noise;
+} StorageTarTestFile;
+
+static const char* const storage_tar_test_dirs[] = {
+    "a",
+    "a/b",
+    "c",
+};
+
+static const StorageTarTestFile storage_tar_test_files[] = {
+    {.name = "empty.txt", .size = 0, .noise = false},
+    {.name = "small.txt", .size = 100, .noise = false},
+    {.name = "a/settings.txt", .size = 5000, .noise = false},
+    {.name = "a/noise.bin", .size = 3000, .noise = true},
+    {.name = "a/b/large.txt", .size = 40000, .noise = false},
+    {.name = "a/b/block.bin", .size = 4096, .noise = true},
+    {.name = "c/mixed.txt", .size = 12345, .noise = false},
+    {.name = "c/noise.bin", .size = 9000, .noise = true},
+};
+
+// Text resembles saved key files, noise does not compress at all
+static void storage_tar_fill(
+    const StorageTarTestFile* desc,
+    size_t offset,
+    uint8_t* data,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        uint32_t pos = offset + i;
+        if(desc->noise) {
+            uint32_t value = (pos + 1) * 1103515245UL + 12345UL;
+            data[i] = value >> 16;
+        } else {
+            static const char line[] = "Key: 00 11 22 33 44 55 66 77\nFrequency: 433920000\n";
+            data[i] = line[pos % (sizeof(line) - 1)];
+        }
+    }
+}
+
+static bool storage_tar_test_file(
+    Storage* storage,
+    const char* path,
+    const StorageTarTestFile* desc,
+    bool write) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* expected = malloc(STORAGE_TAR_CHUNK_SIZE);
+    uint8_t* actual = malloc(STORAGE_TAR_CHUNK_SIZE);
+
+    bool success = false;
+    do {
+        if(write) {
+            if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        } else {
+            if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+            if(storage_file_size(file) != desc->size) break;
+        }
+
+        size_t offset = 0;
+        while(offset < desc->size) {
+            size_t chunk = MIN(desc->size - offset, (size_t)STORAGE_TAR_CHUNK_SIZE);
+            storage_tar_fill(desc, offset, expected, chunk);
+            if(write) {
+                if(storage_file_write(file, expected, chunk) != chunk) break;
+            } else {
+                if(storage_file_read(file, actual, chunk) != chunk) break;
+                if(memcmp(expected, actual, chunk) != 0) break;
+            }
+            offset += chunk;
+        }
+
+        success = (offset == desc->size);
+    } while(false);
+
+    free(actual);
+    free(expected);
+    storage_file_free(file);
+    return success;
+}
+
+static bool storage_tar_test_tree(Storage* storage, const char* base, bool write) {
+    FuriString* path = furi_string_alloc();
+    bool success = true;
+    for(size_t i = 0; (i < COUNT_OF(storage_tar_test_files)) && success; i++) {
+        path_concat(base, storage_tar_test_files[i].name, path);
+        success = storage_tar_test_file(
+            storage, furi_string_get_cstr(path), &storage_tar_test_files[i], write);
+    }
+    furi_string_free(path);
+    return success;
+}
+
+static void storage_tar_setup() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_TAR_SRC);
+    storage_simply_mkdir(storage, STORAGE_TAR_SRC);
+
+    FuriString* path = furi_string_alloc();
+    for(size_t i = 0; i < COUNT_OF(storage_tar_test_dirs); i++) {
+        path_concat(STORAGE_TAR_SRC, storage_tar_test_dirs[i], path);
+        furi_check(storage_simply_mkdir(storage, furi_string_get_cstr(path)));
+    }
+    furi_string_free(path);
+
+    furi_check(storage_tar_test_tree(storage, STORAGE_TAR_SRC, true));
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_tar_teardown() {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_TAR_SRC);
+    storage_simply_remove_recursive(storage, STORAGE_TAR_DST);
+    storage_simply_remove(storage, STORAGE_TAR_PLAIN);
+    storage_simply_remove(storage, STORAGE_TAR_COMPRESSED);
+    storage_simply_remove(storage, STORAGE_TAR_SINGLE);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static bool storage_tar_pack(Storage* storage, const char* path, uint32_t* ticks) {
+    TarArchive* archive = tar_archive_alloc(storage);
+    uint32_t start = furi_get_tick();
+    bool success =
+        tar_archive_open(archive, path, tar_archive_get_write_mode_for_path(path)) &&
+        tar_archive_add_dir(archive, STORAGE_TAR_SRC, "") && tar_archive_finalize(archive);
+    tar_archive_free(archive);
+    *ticks = furi_get_tick() - start;
+    return success;
+}
+
+static bool storage_tar_unpack(
+    Storage* storage,
+    const char* path,
+    int32_t* entries,
+    uint32_t* ticks) {
+    storage_simply_remove_recursive(storage, STORAGE_TAR_DST);
+    storage_simply_mkdir(storage, STORAGE_TAR_DST);
+
+    TarArchive* archive = tar_archive_alloc(storage);
+    uint32_t start = furi_get_tick();
+    bool success = tar_archive_open(archive, path, TAR_OPEN_MODE_READ);
+    if(success) {
+        *entries = tar_archive_get_entries_count(archive);
+        success = tar_archive_unpack_to(archive, STORAGE_TAR_DST, NULL);
+    }
+    tar_archive_free(archive);
+    *ticks = furi_get_tick() - start;
+    return success;
+}
+
+static uint32_t storage_tar_speed(uint32_t size, uint32_t ticks) {
+    // Bytes per ms is KB/s
+    return size / MAX(ticks, 1UL);
+}
+
+MU_TEST(storage_tar_round_trip) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const char* const archives[] = {STORAGE_TAR_PLAIN, STORAGE_TAR_COMPRESSED};
+    const int32_t entries_expected =
+        COUNT_OF(storage_tar_test_dirs) + COUNT_OF(storage_tar_test_files);
+
+    uint32_t source_size = 0;
+    for(size_t i = 0; i < COUNT_OF(storage_tar_test_files); i++) {
+        source_size += storage_tar_test_files[i].size;
+    }
+
+    uint64_t archive_size[COUNT_OF(archives)];
+    for(size_t i = 0; i < COUNT_OF(archives); i++) {
+        uint32_t pack_ticks = 0;
+        uint32_t unpack_ticks = 0;
+        int32_t entries = 0;
+
+        mu_assert(storage_tar_pack(storage, archives[i], &pack_ticks), "pack failed");
+        FileInfo info;
+        mu_assert_int_eq(FSE_OK, storage_common_stat(storage, archives[i], &info));
+        archive_size[i] = info.size;
+
+        mu_assert(
+            storage_tar_unpack(storage, archives[i], &entries, &unpack_ticks), "unpack failed");
+        mu_assert_int_eq(entries_expected, entries);
+        mu_assert(storage_tar_test_tree(storage, STORAGE_TAR_DST, false), "content mismatch");
+
+        uint32_t pack_speed = storage_tar_speed(source_size, pack_ticks);
+        uint32_t unpack_speed = storage_tar_speed(source_size, unpack_ticks);
+        FURI_LOG_I(
+            "StorageTest",
+            "%s: %lu bytes to %lu, ratio %lu%%, pack %lu.%03lu MB/s, unpack %lu.%03lu MB/s",
+            archives[i],
+            source_size,
+            (uint32_t)archive_size[i],
+            (uint32_t)(archive_size[i] * 100 / source_size),
+            pack_speed / 1000,
+            pack_speed % 1000,
+            unpack_speed / 1000,
+            unpack_speed % 1000);
+    }
+
+    mu_assert(archive_size[1] < archive_size[0], "compressed archive is not smaller");
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_tar_write_mode) {
+    mu_assert_int_eq(
+        TAR_OPEN_MODE_WRITE_HEATSHRINK, tar_archive_get_write_mode_for_path("/ext/a.tar.hs"));
+    // Only the full extension selects compression
+    mu_assert_int_eq(TAR_OPEN_MODE_WRITE, tar_archive_get_write_mode_for_path("/ext/a.hs"));
+    mu_assert_int_eq(TAR_OPEN_MODE_WRITE, tar_archive_get_write_mode_for_path("/ext/a.tar"));
+    mu_assert_int_eq(TAR_OPEN_MODE_WRITE, tar_archive_get_write_mode_for_path(".tar.hs"));
+}
+
+MU_TEST(storage_tar_unpack_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    TarArchive* archive = tar_archive_alloc(storage);
+    mu_assert(tar_archive_open(archive, STORAGE_TAR_COMPRESSED, TAR_OPEN_MODE_READ), "open");
+
+    // Entry is located by archive index without walking through tar headers
+    const StorageTarTestFile* desc = &storage_tar_test_files[4];
+    mu_assert(
+        tar_archive_unpack_file(archive, desc->name, STORAGE_TAR_SINGLE), "unpack file failed");
+    mu_assert(!tar_archive_unpack_file(archive, "a/missing.bin", STORAGE_TAR_SINGLE), "missing");
+    tar_archive_free(archive);
+
+    mu_assert(
+        storage_tar_test_file(storage, STORAGE_TAR_SINGLE, desc, false), "content mismatch");
+
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_tar) {
+    storage_tar_setup();
+    MU_RUN_TEST(storage_tar_write_mode);
+    MU_RUN_TEST(storage_tar_round_trip);
+    MU_RUN_TEST(storage_tar_unpack_file);
+    storage_tar_teardown();
+}
+
 MU_TEST_SUITE(test_data_path) {
     MU_RUN_TEST(test_storage_data_path);
     MU_RUN_TEST(test_storage_data_path_apps);
@@ -642,6 +1338,9 @@ int run_minunit_test_storage() {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
+    MU_RUN_SUITE(storage_batch);
+    MU_RUN_SUITE(storage_browser);
+    MU_RUN_SUITE(storage_tar);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
     MU_RUN_SUITE(test_md5_calc_suite);
@@ -5,18 +5,22 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_playlist_transmitter.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
+#include <lib/subghz/devices/file_replay/file_replay_interconnect.h>
 
 #define TAG "SubGhz TEST"
 #define KEYSTORE_DIR_NAME EXT_PATH("subghz/assets/keeloq_mfcodes")
 #define CAME_ATOMO_DIR_NAME EXT_PATH("subghz/assets/came_atomo")
 #define NICE_FLOR_S_DIR_NAME EXT_PATH("subghz/assets/nice_flor_s")
 #define ALUTECH_AT_4N_DIR_NAME EXT_PATH("subghz/assets/alutech_at_4n")
+#define TEST_KEYSTORE_DIR_NAME EXT_PATH("unit_tests/subghz/keeloq_mfcodes")
 #define TEST_RANDOM_DIR_NAME EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_REPLAY_CAPTURE_NAME EXT_PATH("unit_tests/subghz/replay_capture.sub")
 #define TEST_TIMEOUT 10000
 
 static SubGhzEnvironment* environment_handler;
@@ -148,6 +152,222 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static void
+    subghz_file_replay_test_capture_callback(bool level, uint32_t duration, void* context) {
+    UNUSED(context);
+    subghz_receiver_decode(receiver_handler, level, duration);
+}
+
+static bool subghz_file_replay_test_rx(const SubGhzDevice* device, const char* path) {
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+    uint32_t test_start = furi_get_tick();
+
+    subghz_device_file_replay_set_source(path, SubGhzDeviceFileReplayPacingFast);
+    subghz_devices_start_async_rx(device, subghz_file_replay_test_capture_callback, NULL);
+    while(!subghz_device_file_replay_is_rx_complete() &&
+          furi_get_tick() - test_start < TEST_TIMEOUT * 10) {
+        furi_delay_ms(10);
+    }
+    bool complete = subghz_device_file_replay_is_rx_complete();
+    subghz_devices_stop_async_rx(device);
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingFast);
+
+    FURI_LOG_D(TAG, "\r\n Replay count parse \033[0;33m%d\033[0m ", subghz_test_decoder_count);
+    return complete && subghz_test_decoder_count == TEST_RANDOM_COUNT_PARSE;
+}
+
+static bool subghz_file_replay_test_tx(const SubGhzDevice* device, const char* path) {
+    uint32_t test_start = furi_get_tick();
+    bool complete = false;
+
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingFast);
+    subghz_device_file_replay_set_capture(TEST_REPLAY_CAPTURE_NAME);
+    file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
+    if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        subghz_devices_start_async_tx(
+            device, subghz_file_encoder_worker_get_level_duration, file_worker_encoder_handler);
+        while(!subghz_devices_is_async_complete_tx(device) &&
+              furi_get_tick() - test_start < TEST_TIMEOUT * 10) {
+            furi_delay_ms(10);
+        }
+        complete = subghz_devices_is_async_complete_tx(device);
+        subghz_devices_stop_async_tx(device);
+        subghz_file_encoder_worker_stop(file_worker_encoder_handler);
+    }
+    subghz_file_encoder_worker_free(file_worker_encoder_handler);
+    subghz_device_file_replay_set_capture(NULL);
+
+    return complete;
+}
+
+static const char* const subghz_playlist_test_files[] = {
+    EXT_PATH("unit_tests/subghz/princeton.sub"),
+    EXT_PATH("unit_tests/subghz/came.sub"),
+    EXT_PATH("unit_tests/subghz/nice_flo.sub"),
+    EXT_PATH("unit_tests/subghz/gate_tx.sub"),
+};
+
+#define SUBGHZ_PLAYLIST_TEST_ROUNDS 3
+#define SUBGHZ_PLAYLIST_TEST_GAP_MS 100
+#define SUBGHZ_PLAYLIST_TEST_GAP_TOLERANCE_MS 25
+
+typedef struct {
+    uint32_t sent;
+    uint32_t errors;
+    bool end;
+} SubGhzPlaylistTest;
+
+static void subghz_playlist_test_callback(
+    void* context,
+    SubGhzPlaylistTransmitterEvent event,
+    size_t index) {
+    UNUSED(index);
+    SubGhzPlaylistTest* test = context;
+    if(event == SubGhzPlaylistTransmitterEventSent) {
+        test->sent++;
+    } else if(event == SubGhzPlaylistTransmitterEventError) {
+        test->errors++;
+    } else {
+        test->end = true;
+    }
+}
+
+static bool subghz_playlist_test_run(
+    const SubGhzDevice* device,
+    uint32_t gap_ms,
+    SubGhzPlaylistTransmitterStats* stats) {
+    SubGhzPlaylistTest test = {0};
+    uint32_t test_start = furi_get_tick();
+
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingRealtime);
+    SubGhzPlaylistTransmitter* playlist =
+        subghz_playlist_transmitter_alloc(environment_handler, device);
+    subghz_playlist_transmitter_set_callback(playlist, subghz_playlist_test_callback, &test);
+    subghz_playlist_transmitter_set_gap(playlist, gap_ms);
+    subghz_playlist_transmitter_set_repeat(playlist, 1);
+    for(size_t round = 0; round < SUBGHZ_PLAYLIST_TEST_ROUNDS; round++) {
+        for(size_t i = 0; i < COUNT_OF(subghz_playlist_test_files); i++) {
+            subghz_playlist_transmitter_add(playlist, subghz_playlist_test_files[i]);
+        }
+    }
+
+    subghz_playlist_transmitter_start(playlist);
+    while(subghz_playlist_transmitter_is_running(playlist) &&
+          furi_get_tick() - test_start < TEST_TIMEOUT) {
+        furi_delay_ms(10);
+    }
+    subghz_playlist_transmitter_stop(playlist);
+    subghz_playlist_transmitter_get_stats(playlist, stats);
+    subghz_playlist_transmitter_free(playlist);
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingFast);
+
+    FURI_LOG_I(
+        TAG,
+        "Playlist gap %lu: %lu gaps, min %lu, max %lu, avg %lu ms, %lu restarts, %lu underruns",
+        gap_ms,
+        stats->count,
+        stats->min_ms,
+        stats->max_ms,
+        stats->count ? (uint32_t)(stats->total_ms / stats->count) : 0,
+        stats->restarts,
+        stats->underruns);
+    for(size_t i = 0; i < SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_SIZE; i++) {
+        FURI_LOG_D(
+            TAG,
+            "  +%u ms: %lu",
+            i * SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_STEP_MS,
+            stats->histogram[i]);
+    }
+
+    size_t count = SUBGHZ_PLAYLIST_TEST_ROUNDS * COUNT_OF(subghz_playlist_test_files);
+    return test.end && !test.errors && test.sent == count && stats->count == count - 1;
+}
+
+typedef struct {
+    SubGhzTransmitter* transmitter;
+    bool started;
+    uint32_t start_tick;
+    uint32_t end_tick;
+} SubGhzPlaylistTestBaseline;
+
+static LevelDuration subghz_playlist_test_baseline_yield(void* context) {
+    SubGhzPlaylistTestBaseline* baseline = context;
+    LevelDuration level_duration = subghz_transmitter_yield(baseline->transmitter);
+    if(level_duration_is_reset(level_duration)) {
+        baseline->end_tick = furi_get_tick();
+    } else if(!baseline->started && !level_duration_is_wait(level_duration)) {
+        baseline->started = true;
+        baseline->start_tick = furi_get_tick();
+    }
+    return level_duration;
+}
+
+/** Load and send files one by one, the way playlist app does it */
+static uint32_t subghz_playlist_test_baseline(const SubGhzDevice* device) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    FlipperFormat* fff_data = flipper_format_string_alloc();
+    FuriString* protocol = furi_string_alloc();
+    SubGhzPlaylistTestBaseline baseline = {0};
+    uint32_t repeat = 1;
+    uint32_t max_gap_ms = 0;
+    bool has_end = false;
+
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingRealtime);
+    for(size_t i = 0; i < COUNT_OF(subghz_playlist_test_files); i++) {
+        bool loaded =
+            flipper_format_file_open_existing(fff_file, subghz_playlist_test_files[i]) &&
+            flipper_format_read_string(fff_file, "Protocol", protocol);
+        if(loaded) {
+            // Patch a copy, fixtures are shared with other tests
+            Stream* stream = flipper_format_get_raw_stream(fff_data);
+            stream_clean(stream);
+            stream_copy_full(flipper_format_get_raw_stream(fff_file), stream);
+        }
+        flipper_format_file_close(fff_file);
+        if(!loaded) continue;
+
+        flipper_format_rewind(fff_data);
+        flipper_format_insert_or_update_uint32(fff_data, "Repeat", &repeat, 1);
+        flipper_format_rewind(fff_data);
+        baseline.transmitter = subghz_transmitter_alloc_init(
+            environment_handler, furi_string_get_cstr(protocol));
+        if(baseline.transmitter &&
+           subghz_transmitter_deserialize(baseline.transmitter, fff_data) ==
+               SubGhzProtocolStatusOk) {
+            baseline.started = false;
+            subghz_devices_load_preset(device, FuriHalSubGhzPresetOok650Async, NULL);
+            subghz_devices_set_frequency(device, 433920000);
+            subghz_devices_set_tx(device);
+            subghz_devices_start_async_tx(
+                device, subghz_playlist_test_baseline_yield, &baseline);
+            uint32_t test_start = furi_get_tick();
+            while(!subghz_devices_is_async_complete_tx(device) &&
+                  furi_get_tick() - test_start < TEST_TIMEOUT) {
+                furi_delay_ms(10);
+            }
+            subghz_devices_stop_async_tx(device);
+            subghz_devices_idle(device);
+
+            if(has_end && baseline.started) {
+                uint32_t gap_ms = (baseline.start_tick - baseline.end_tick) * 1000 /
+                                  furi_kernel_get_tick_frequency();
+                max_gap_ms = MAX(max_gap_ms, gap_ms);
+            }
+            has_end = true;
+        }
+        if(baseline.transmitter) subghz_transmitter_free(baseline.transmitter);
+    }
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingFast);
+
+    furi_string_free(protocol);
+    flipper_format_free(fff_data);
+    flipper_format_free(fff_file);
+    furi_record_close(RECORD_STORAGE);
+    return max_gap_ms;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -217,6 +437,110 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+MU_TEST(subghz_protocol_name_lookup_test) {
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    FuriString* name = furi_string_alloc();
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(registry); i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        // Interned pointer and a copy, as read from file
+        furi_string_set(name, protocol->name);
+        const char* copy = furi_string_get_cstr(name);
+        mu_assert_int_eq(
+            i, subghz_environment_get_protocol_index(environment_handler, protocol->name));
+        mu_assert_int_eq(i, subghz_environment_get_protocol_index(environment_handler, copy));
+        mu_assert(
+            subghz_protocol_registry_get_by_name(registry, copy) == protocol,
+            "Registry lookup error");
+
+        if(protocol->decoder && protocol->decoder->alloc) {
+            SubGhzProtocolDecoderBase* decoder =
+                subghz_receiver_search_decoder_base_by_name(receiver_handler, copy);
+            mu_assert(decoder && decoder->protocol == protocol, "Receiver lookup error");
+        }
+
+        // Prefix and one changed char must not match
+        furi_string_left(name, furi_string_size(name) - 1);
+        mu_assert_int_eq(
+            -1,
+            subghz_environment_get_protocol_index(
+                environment_handler, furi_string_get_cstr(name)));
+        furi_string_cat_str(name, "?");
+        mu_assert(
+            subghz_environment_get_protocol_by_name(
+                environment_handler, furi_string_get_cstr(name)) == NULL,
+            "Unknown name found");
+    }
+
+    mu_assert_int_eq(-1, subghz_environment_get_protocol_index(environment_handler, ""));
+    furi_string_free(name);
+}
+
+MU_TEST(subghz_keystore_compiled_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    // Environment holds the original, a copy is loaded from scratch
+    storage_simply_remove(storage, TEST_KEYSTORE_DIR_NAME ".bin");
+    mu_assert(
+        storage_common_copy(storage, KEYSTORE_DIR_NAME, TEST_KEYSTORE_DIR_NAME) == FSE_OK,
+        "Keystore copy error");
+
+    SubGhzKeystore* text = subghz_keystore_alloc();
+    mu_assert(subghz_keystore_load(text, TEST_KEYSTORE_DIR_NAME), "Text keystore load error");
+    mu_assert(
+        storage_file_exists(storage, TEST_KEYSTORE_DIR_NAME ".bin"), "Keystore is not compiled");
+    size_t count = subghz_keystore_get_count(text);
+    mu_assert(count > 0, "Keystore is empty");
+    const SubGhzKey* key = subghz_keystore_get_key(text, count - 1);
+    uint64_t last_key = key->key;
+    FuriString* last_name = furi_string_alloc_set(key->name);
+    subghz_keystore_free(text);
+
+    // Nobody holds it now, so it's read from compiled file
+    SubGhzKeystore* compiled = subghz_keystore_alloc();
+    mu_assert(
+        subghz_keystore_load(compiled, TEST_KEYSTORE_DIR_NAME), "Compiled keystore load error");
+    mu_assert_int_eq(count, subghz_keystore_get_count(compiled));
+    key = subghz_keystore_get_key(compiled, count - 1);
+    mu_assert(key->key == last_key, "Compiled key mismatch");
+    mu_assert_string_eq(furi_string_get_cstr(last_name), key->name);
+
+    // Same file is shared
+    SubGhzKeystore* shared = subghz_keystore_alloc();
+    mu_assert(subghz_keystore_load(shared, TEST_KEYSTORE_DIR_NAME), "Shared keystore load error");
+    mu_assert(
+        subghz_keystore_get_key(shared, 0) == subghz_keystore_get_key(compiled, 0),
+        "Keystore is not shared");
+    subghz_keystore_free(shared);
+    subghz_keystore_free(compiled);
+
+    // Count that doesn't fit file size: text keystore is loaded instead
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(
+            file, TEST_KEYSTORE_DIR_NAME ".bin", FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "Compiled keystore open error");
+    uint32_t huge_count = UINT32_MAX;
+    // SubGhzKeystoreCompiledHeader.count
+    mu_assert(storage_file_seek(file, 16, true), "Compiled keystore seek error");
+    mu_assert(
+        storage_file_write(file, &huge_count, sizeof(huge_count)) == sizeof(huge_count),
+        "Compiled keystore write error");
+    storage_file_close(file);
+    storage_file_free(file);
+
+    SubGhzKeystore* fallback = subghz_keystore_alloc();
+    mu_assert(
+        subghz_keystore_load(fallback, TEST_KEYSTORE_DIR_NAME), "Fallback keystore load error");
+    mu_assert_int_eq(count, subghz_keystore_get_count(fallback));
+    subghz_keystore_free(fallback);
+
+    furi_string_free(last_name);
+    storage_simply_remove(storage, TEST_KEYSTORE_DIR_NAME);
+    storage_simply_remove(storage, TEST_KEYSTORE_DIR_NAME ".bin");
+    furi_record_close(RECORD_STORAGE);
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -816,9 +1140,52 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+MU_TEST(subghz_file_replay_test) {
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_FILE_REPLAY_NAME);
+    mu_assert(device, "File replay device not registered\r\n");
+
+    mu_assert(
+        subghz_file_replay_test_rx(device, TEST_RANDOM_DIR_NAME), "File replay RX error\r\n");
+    // Captured transmission is played back with the same result
+    mu_assert(
+        subghz_file_replay_test_tx(device, TEST_RANDOM_DIR_NAME), "File replay TX error\r\n");
+    mu_assert(
+        subghz_file_replay_test_rx(device, TEST_REPLAY_CAPTURE_NAME),
+        "File replay of TX capture error\r\n");
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, TEST_REPLAY_CAPTURE_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(subghz_playlist_transmitter_test) {
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_FILE_REPLAY_NAME);
+    mu_assert(device, "File replay device not registered\r\n");
+    SubGhzPlaylistTransmitterStats stats;
+
+    // Back to back: dead time is only what the engine adds
+    mu_assert(subghz_playlist_test_run(device, 0, &stats), "Playlist error\r\n");
+    mu_assert(
+        stats.max_ms <= SUBGHZ_PLAYLIST_TEST_GAP_TOLERANCE_MS, "Playlist gap too long\r\n");
+    mu_assert_int_eq(0, stats.restarts);
+
+    mu_assert(
+        subghz_playlist_test_run(device, SUBGHZ_PLAYLIST_TEST_GAP_MS, &stats),
+        "Playlist error\r\n");
+    mu_assert(stats.min_ms + 1 >= SUBGHZ_PLAYLIST_TEST_GAP_MS, "Playlist gap too short\r\n");
+    mu_assert(
+        stats.max_ms <= SUBGHZ_PLAYLIST_TEST_GAP_MS + SUBGHZ_PLAYLIST_TEST_GAP_TOLERANCE_MS,
+        "Playlist gap too long\r\n");
+
+    FURI_LOG_I(
+        TAG, "Sequential load and send: max gap %lu ms", subghz_playlist_test_baseline(device));
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_compiled_test);
+    MU_RUN_TEST(subghz_protocol_name_lookup_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
@@ -891,6 +1258,8 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dooya_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_file_replay_test);
+    MU_RUN_TEST(subghz_playlist_transmitter_test);
     subghz_test_deinit();
 }
 
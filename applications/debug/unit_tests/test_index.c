@@ -27,8 +27,11 @@ int run_minunit_test_lfrfid_protocols();
 int run_minunit_test_nfc();
 int run_minunit_test_bit_lib();
 int run_minunit_test_float_tools();
+int run_minunit_test_profiler();
 int run_minunit_test_bt();
 int run_minunit_test_dialogs_file_browser_options();
+int run_minunit_test_canvas();
+int run_minunit_test_rpc_gui_stream();
 
 typedef int (*UnitTestEntry)();
 
@@ -57,9 +60,12 @@ const UnitTest unit_tests[] = {
     {.name = "lfrfid", .entry = run_minunit_test_lfrfid_protocols},
     {.name = "bit_lib", .entry = run_minunit_test_bit_lib},
     {.name = "float_tools", .entry = run_minunit_test_float_tools},
+    {.name = "profiler", .entry = run_minunit_test_profiler},
     {.name = "bt", .entry = run_minunit_test_bt},
     {.name = "dialogs_file_browser_options",
      .entry = run_minunit_test_dialogs_file_browser_options},
+    {.name = "canvas", .entry = run_minunit_test_canvas},
+    {.name = "rpc_gui_stream", .entry = run_minunit_test_rpc_gui_stream},
 };
 
 void minunit_print_progress() {
@@ -0,0 +1,468 @@
+#include "nested_recovery.h"
+#include "recovery_i.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NESTED_RECOVERY_SEED_BITS (20)
+#define NESTED_RECOVERY_STACK_MIN (4096)
+
+typedef struct {
+    uint32_t* data;
+    size_t count;
+    size_t capacity;
+} NestedRecoveryList;
+
+struct NestedRecovery {
+    uint8_t chunk_bits;
+    uint32_t* arena;
+    size_t arena_size;
+
+    // Odd table of the last chunk, extended through the first level and sorted
+    NestedRecoveryList odd;
+    bool odd_valid;
+    uint32_t odd_chunk;
+    uint32_t odd_ks;
+
+    NestedRecoveryList even;
+
+    const NestedRecoveryTry* nested_try;
+    NestedRecoveryCallback callback;
+    void* context;
+    bool stopped;
+    bool overflow;
+};
+
+static size_t nested_recovery_get_arena_size(uint8_t chunk_bits) {
+    // Tables are used as a stack: odd, even, then bucket copies of every level. A table
+    // keeps the size of its chunk on average while growing, but seeds of a small chunk
+    // share their top bits and grow together: 1.75 of the chunk size at 8 chunk bits.
+    size_t chunk_size = (size_t)1 << (NESTED_RECOVERY_SEED_BITS - chunk_bits);
+    return chunk_size * 2 + chunk_size * chunk_bits / 4 + NESTED_RECOVERY_STACK_MIN;
+}
+
+size_t nested_recovery_get_memory_size(uint8_t chunk_bits) {
+    return sizeof(NestedRecovery) + nested_recovery_get_arena_size(chunk_bits) * sizeof(uint32_t);
+}
+
+NestedRecovery* nested_recovery_alloc(uint8_t chunk_bits) {
+    if(chunk_bits > NESTED_RECOVERY_CHUNK_BITS_MAX) return NULL;
+
+    NestedRecovery* instance = malloc(sizeof(NestedRecovery));
+    memset(instance, 0, sizeof(NestedRecovery));
+    instance->chunk_bits = chunk_bits;
+    instance->arena_size = nested_recovery_get_arena_size(chunk_bits);
+    instance->arena = malloc(instance->arena_size * sizeof(uint32_t));
+    instance->odd.data = instance->arena;
+
+    return instance;
+}
+
+void nested_recovery_free(NestedRecovery* instance) {
+    free(instance->arena);
+    free(instance);
+}
+
+uint32_t nested_recovery_get_chunk_count(NestedRecovery* instance) {
+    return 1UL << (instance->chunk_bits * 2);
+}
+
+uint32_t nested_recovery_get_sub_chunk(
+    uint32_t chunk,
+    uint8_t chunk_bits,
+    uint8_t sub_bits,
+    uint32_t index) {
+    uint32_t chunk_mask = (1UL << chunk_bits) - 1;
+    uint32_t sub_mask = (1UL << sub_bits) - 1;
+    uint32_t odd_chunk = (chunk >> chunk_bits) << sub_bits | (index >> sub_bits & sub_mask);
+    uint32_t even_chunk = (chunk & chunk_mask) << sub_bits | (index & sub_mask);
+    return odd_chunk << (chunk_bits + sub_bits) | even_chunk;
+}
+
+static inline void nested_recovery_update_contribution(uint32_t* item, uint32_t m1, uint32_t m2) {
+    uint32_t p = *item >> 25;
+    p = p << 1 | recovery_parity(*item & m1);
+    p = p << 1 | recovery_parity(*item & m2);
+    *item = p << 24 | (*item & 0xffffff);
+}
+
+/** Grow every state by one bit that gives the keystream bit
+ *
+ * A state either gets the one bit that works, is split in two if both do, or is
+ * dropped. Split states take one more slot, the unprocessed tail is moved out of
+ * the way. With contribution, feedback parity of the new bits is kept in the top
+ * byte for the join.
+ */
+static bool nested_recovery_extend(
+    NestedRecoveryList* list,
+    uint32_t bit,
+    bool contribution,
+    uint32_t m1,
+    uint32_t m2,
+    uint32_t in) {
+    uint32_t* table = list->data;
+    size_t end = list->count;
+    in <<= 24;
+
+    for(size_t i = 0; i < end;) {
+        uint32_t item = table[i] << 1;
+        uint32_t f0 = recovery_filter(item);
+        uint32_t f1 = recovery_filter(item | 1);
+
+        if(f0 ^ f1) {
+            item |= f0 ^ bit;
+            if(contribution) {
+                nested_recovery_update_contribution(&item, m1, m2);
+                item ^= in;
+            }
+            table[i++] = item;
+        } else if(f0 == bit) {
+            if(end >= list->capacity) return false;
+            if(i + 1 < end) table[end] = table[i + 1];
+            end++;
+
+            uint32_t split = item | 1;
+            if(contribution) {
+                nested_recovery_update_contribution(&item, m1, m2);
+                nested_recovery_update_contribution(&split, m1, m2);
+                item ^= in;
+                split ^= in;
+            }
+            table[i++] = item;
+            table[i++] = split;
+        } else {
+            table[i] = table[--end];
+        }
+    }
+
+    list->count = end;
+    return true;
+}
+
+/** In-place radix sort by the top byte: contribution bits the join matches on */
+static void nested_recovery_sort(NestedRecoveryList* list) {
+    uint32_t next[256] = {0};
+    uint32_t end[256];
+
+    for(size_t i = 0; i < list->count; i++) {
+        next[list->data[i] >> 24]++;
+    }
+    uint32_t position = 0;
+    for(size_t b = 0; b < 256; b++) {
+        uint32_t count = next[b];
+        next[b] = position;
+        position += count;
+        end[b] = position;
+    }
+
+    for(size_t b = 0; b < 256; b++) {
+        while(next[b] < end[b]) {
+            uint32_t item = list->data[next[b]];
+            uint32_t d = item >> 24;
+            if(d == b) {
+                next[b]++;
+            } else {
+                list->data[next[b]] = list->data[next[d]];
+                list->data[next[d]++] = item;
+            }
+        }
+    }
+}
+
+static void nested_recovery_emit(NestedRecovery* instance, Crypto1* state) {
+    const NestedRecoveryTry* nested_try = instance->nested_try;
+
+    recovery_rollback_word(state, nested_try->cuid ^ nested_try->nt[0], false);
+    uint64_t key = recovery_get_key(state);
+
+    // Intersection with the states of the second nonce
+    Crypto1 check;
+    recovery_init(&check, key);
+    if(recovery_word(&check, nested_try->cuid ^ nested_try->nt[1], false) != nested_try->ks[1]) {
+        return;
+    }
+
+    if(!instance->callback(key, instance->context)) instance->stopped = true;
+}
+
+/** Join odd and even states of a pair of buckets into full states */
+static void nested_recovery_emit_pairs(
+    NestedRecovery* instance,
+    const NestedRecoveryList* odd,
+    size_t odd_start,
+    size_t odd_end,
+    const NestedRecoveryList* even,
+    size_t even_start,
+    size_t even_end,
+    uint32_t in) {
+    for(size_t e = even_start; e < even_end && !instance->stopped; e++) {
+        uint32_t even_item = even->data[e] << 1 ^
+                             recovery_parity(even->data[e] & RECOVERY_LF_POLY_EVEN) ^ !!(in & 4);
+        for(size_t o = odd_start; o < odd_end && !instance->stopped; o++) {
+            Crypto1 state = {
+                .even = odd->data[o],
+                .odd = even_item ^ recovery_parity(odd->data[o] & RECOVERY_LF_POLY_ODD),
+            };
+            nested_recovery_emit(instance, &state);
+        }
+    }
+}
+
+/** Grow the odd table by steps bits of oks */
+static bool nested_recovery_grow_odd(NestedRecoveryList* odd, uint32_t oks, uint32_t steps) {
+    for(uint32_t i = 1; i <= steps && odd->count; i++) {
+        if(!nested_recovery_extend(
+               odd,
+               oks >> i & 1,
+               true,
+               RECOVERY_LF_POLY_EVEN << 1 | 1,
+               RECOVERY_LF_POLY_ODD << 1,
+               0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Grow the even table by steps bits of eks, shifting in pairs of input bits */
+static bool nested_recovery_grow_even(
+    NestedRecoveryList* even,
+    uint32_t eks,
+    uint32_t in,
+    uint32_t steps) {
+    for(uint32_t i = 1; i <= steps && even->count; i++) {
+        if(!nested_recovery_extend(
+               even,
+               eks >> i & 1,
+               true,
+               RECOVERY_LF_POLY_ODD,
+               RECOVERY_LF_POLY_EVEN << 1 | 1,
+               in >> (2 * i) & 3)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Recover every pair of buckets with the same contribution
+ *
+ * Bucket pairs are copied to the top of the arena and grown there: odd first, with
+ * the rest of the arena but room for the even copy, then even right after it.
+ */
+static void nested_recovery_join(
+    NestedRecovery* instance,
+    NestedRecoveryList* odd,
+    NestedRecoveryList* even,
+    uint32_t oks,
+    uint32_t eks,
+    int32_t rem,
+    uint32_t in,
+    size_t top) {
+    // Out of keystream: the states in matching buckets are the candidates
+    bool last = rem == -1;
+    uint32_t steps = 0;
+    while(!last && steps < 4 && rem--) steps++;
+
+    nested_recovery_sort(odd);
+    nested_recovery_sort(even);
+
+    size_t o = 0;
+    size_t e = 0;
+    while(o < odd->count && e < even->count) {
+        if(instance->stopped || instance->overflow) return;
+
+        uint32_t odd_bucket = odd->data[o] >> 24;
+        uint32_t even_bucket = even->data[e] >> 24;
+        if(odd_bucket < even_bucket) {
+            while(o < odd->count && odd->data[o] >> 24 == odd_bucket) o++;
+            continue;
+        } else if(even_bucket < odd_bucket) {
+            while(e < even->count && even->data[e] >> 24 == even_bucket) e++;
+            continue;
+        }
+
+        size_t odd_end = o;
+        while(odd_end < odd->count && odd->data[odd_end] >> 24 == odd_bucket) odd_end++;
+        size_t even_end = e;
+        while(even_end < even->count && even->data[even_end] >> 24 == even_bucket) even_end++;
+
+        if(last) {
+            nested_recovery_emit_pairs(instance, odd, o, odd_end, even, e, even_end, in);
+            o = odd_end;
+            e = even_end;
+            continue;
+        }
+
+        size_t even_count = even_end - e;
+        if(top + (odd_end - o) + even_count > instance->arena_size) {
+            instance->overflow = true;
+            return;
+        }
+
+        NestedRecoveryList sub_odd = {
+            .data = instance->arena + top,
+            .count = odd_end - o,
+            .capacity = instance->arena_size - top - even_count,
+        };
+        memcpy(sub_odd.data, odd->data + o, sub_odd.count * sizeof(uint32_t));
+        o = odd_end;
+        e = even_end;
+
+        if(!nested_recovery_grow_odd(&sub_odd, oks, steps)) {
+            instance->overflow = true;
+            return;
+        }
+        if(!sub_odd.count) continue;
+
+        NestedRecoveryList sub_even = {
+            .data = sub_odd.data + sub_odd.count,
+            .count = even_count,
+            .capacity = instance->arena_size - top - sub_odd.count,
+        };
+        memcpy(sub_even.data, even->data + even_end - even_count, even_count * sizeof(uint32_t));
+
+        if(!nested_recovery_grow_even(&sub_even, eks, in, steps)) {
+            instance->overflow = true;
+            return;
+        }
+        if(!sub_even.count) continue;
+
+        nested_recovery_join(
+            instance,
+            &sub_odd,
+            &sub_even,
+            oks >> steps,
+            eks >> steps,
+            rem,
+            in >> (2 * steps),
+            top + sub_odd.count + sub_even.count);
+    }
+}
+
+/** Seed states of the chunk that give the first keystream bit, grow by 4 bits */
+static bool nested_recovery_seed(
+    NestedRecovery* instance,
+    NestedRecoveryList* list,
+    uint32_t chunk,
+    uint32_t ks) {
+    uint32_t chunk_size = 1UL << (NESTED_RECOVERY_SEED_BITS - instance->chunk_bits);
+    uint32_t first = chunk * chunk_size;
+
+    if(list->capacity < chunk_size) return false;
+
+    list->count = 0;
+    for(uint32_t i = first; i < first + chunk_size; i++) {
+        if(recovery_filter(i) == (ks & 1)) list->data[list->count++] = i;
+    }
+    for(uint32_t i = 0; i < 4; i++) {
+        ks >>= 1;
+        if(!nested_recovery_extend(list, ks & 1, false, 0, 0, 0)) return false;
+    }
+    return true;
+}
+
+NestedRecoveryResult nested_recovery_run(
+    NestedRecovery* instance,
+    const NestedRecoveryTry* nested_try,
+    uint32_t chunk,
+    NestedRecoveryCallback callback,
+    void* context) {
+    // Keystream bits of odd and even steps
+    uint32_t oks = 0;
+    uint32_t eks = 0;
+    for(int32_t i = 31; i >= 0; i -= 2) {
+        oks = oks << 1 | RECOVERY_BEBIT(nested_try->ks[0], i);
+    }
+    for(int32_t i = 30; i >= 0; i -= 2) {
+        eks = eks << 1 | RECOVERY_BEBIT(nested_try->ks[0], i);
+    }
+    uint32_t in = nested_try->cuid ^ nested_try->nt[0];
+    in = (in >> 16 & 0xff) | (in << 16) | (in & 0xff00);
+    in <<= 1;
+
+    uint32_t odd_chunk = chunk >> instance->chunk_bits;
+    uint32_t even_chunk = chunk & ((1UL << instance->chunk_bits) - 1);
+
+    instance->nested_try = nested_try;
+    instance->callback = callback;
+    instance->context = context;
+    instance->stopped = false;
+    instance->overflow = false;
+
+    // First level of the odd table doesn't depend on the even one: kept for the next pair
+    if(!instance->odd_valid || instance->odd_chunk != odd_chunk || instance->odd_ks != oks) {
+        instance->odd_valid = false;
+        instance->odd.capacity = instance->arena_size - NESTED_RECOVERY_STACK_MIN;
+        if(!nested_recovery_seed(instance, &instance->odd, odd_chunk, oks) ||
+           !nested_recovery_grow_odd(&instance->odd, oks >> 4, 4)) {
+            return NestedRecoveryResultOverflow;
+        }
+        nested_recovery_sort(&instance->odd);
+        instance->odd_valid = true;
+        instance->odd_chunk = odd_chunk;
+        instance->odd_ks = oks;
+    }
+
+    instance->even.data = instance->arena + instance->odd.count;
+    instance->even.capacity = instance->arena_size - instance->odd.count;
+    if(!nested_recovery_seed(instance, &instance->even, even_chunk, eks) ||
+       !nested_recovery_grow_even(&instance->even, eks >> 4, in, 4)) {
+        return NestedRecoveryResultOverflow;
+    }
+
+    nested_recovery_join(
+        instance,
+        &instance->odd,
+        &instance->even,
+        oks >> 8,
+        eks >> 8,
+        7,
+        in >> 8,
+        instance->odd.count + instance->even.count);
+
+    if(instance->overflow) return NestedRecoveryResultOverflow;
+    return instance->stopped ? NestedRecoveryResultStopped : NestedRecoveryResultOk;
+}
+
+bool nested_recovery_check_key(const NestedRecoveryTry* nested_try, uint64_t key) {
+    for(size_t i = 0; i < 2; i++) {
+        Crypto1 state;
+        recovery_init(&state, key);
+        if(recovery_word(&state, nested_try->cuid ^ nested_try->nt[i], false) !=
+           nested_try->ks[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool nested_recovery_predict_nonce(
+    uint32_t nt_prev,
+    uint32_t nt_enc,
+    const uint8_t parity[4],
+    uint32_t distance,
+    uint32_t* nt) {
+    if(distance < NESTED_RECOVERY_DISTANCE_SPREAD) return false;
+
+    size_t count = 0;
+    uint32_t candidate =
+        recovery_prng_successor(nt_prev, distance - NESTED_RECOVERY_DISTANCE_SPREAD);
+    for(uint32_t i = 0; i <= NESTED_RECOVERY_DISTANCE_SPREAD * 2; i++) {
+        uint32_t ks = nt_enc ^ candidate;
+        bool valid = true;
+        // Parity of a byte is encrypted with the first keystream bit of the next one
+        for(uint32_t j = 0; j < 3 && valid; j++) {
+            uint32_t shift = 24 - 8 * j;
+            uint32_t plain = !recovery_parity(candidate >> shift & 0xff);
+            uint32_t encrypted = !recovery_parity(nt_enc >> shift & 0xff);
+            valid = plain == (parity[j] ^ encrypted ^ RECOVERY_BIT(ks, shift - 8));
+        }
+        if(valid) {
+            *nt = candidate;
+            count++;
+        }
+        candidate = recovery_prng_successor(candidate, 1);
+    }
+
+    return count == 1;
+}
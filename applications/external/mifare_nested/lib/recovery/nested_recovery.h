@@ -0,0 +1,142 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Nested attack key recovery.
+ *
+ * A nested try is two authentications to the target block with tag nonces predicted
+ * from the weak PRNG. Keystream of each nonce is ks = nt_enc ^ nt. Crypto1 states
+ * that produce 32 bits of keystream while shifting in uid ^ nt are found by growing
+ * odd and even halves of the state bit by bit and joining them where their feedback
+ * contributions agree (crapto1 lfsr_recovery32). About 2^16 states are left, they
+ * are rolled back to keys, and only keys that also produce the keystream of the
+ * second nonce are reported.
+ *
+ * Odd and even tables are split by the top bits of their 20-bit seeds into
+ * 2^chunk_bits chunks each. A chunk pair is a unit of work: memory is bounded by
+ * the chunk size, pairs are independent and may run in any order or in parallel,
+ * each NestedRecovery in one thread at a time. Odd table of the last chunk is kept:
+ * run pairs of the same odd chunk one after another. Even table is built for every
+ * pair, so total time grows with chunk bits, about 100 times at 8 bits (80 KB): some
+ * 50 s per try on one desktop core. */
+
+#define NESTED_RECOVERY_CHUNK_BITS_MAX (10)
+/** Nested nonce is within distance +- spread PRNG steps, same window as collection */
+#define NESTED_RECOVERY_DISTANCE_SPREAD (2)
+
+typedef struct NestedRecovery NestedRecovery;
+
+typedef struct {
+    uint32_t cuid;
+    uint32_t nt[2];
+    uint32_t ks[2];
+} NestedRecoveryTry;
+
+typedef enum {
+    NestedRecoveryResultOk,
+    NestedRecoveryResultStopped, /**< Callback asked to stop */
+    NestedRecoveryResultOverflow, /**< Tables outgrew memory, use more chunk bits */
+} NestedRecoveryResult;
+
+/** Key callback
+ *
+ * @param key recovered key, needs to be checked on the tag
+ * @param context callback context
+ * @return true to continue
+ */
+typedef bool (*NestedRecoveryCallback)(uint64_t key, void* context);
+
+/** Allocate recovery workspace
+ *
+ * @param chunk_bits 0 (whole tables, about 8 MB) to NESTED_RECOVERY_CHUNK_BITS_MAX,
+ *        every bit about halves memory
+ * @return NestedRecovery instance
+ */
+NestedRecovery* nested_recovery_alloc(uint8_t chunk_bits);
+
+void nested_recovery_free(NestedRecovery* instance);
+
+/** Get workspace size
+ *
+ * @param chunk_bits chunk bits
+ * @return bytes
+ */
+size_t nested_recovery_get_memory_size(uint8_t chunk_bits);
+
+/** Get count of chunk pairs, 4^chunk_bits
+ *
+ * @param instance NestedRecovery instance
+ * @return chunk pair count
+ */
+uint32_t nested_recovery_get_chunk_count(NestedRecovery* instance);
+
+/** Get chunk pair at more chunk bits that is a part of chunk pair
+ *
+ * Chunk pair is covered by 4^sub_bits smaller pairs: run them when it overflows.
+ *
+ * @param chunk chunk pair index
+ * @param chunk_bits chunk bits of chunk
+ * @param sub_bits chunk bits to add, chunk_bits + sub_bits up to
+ *        NESTED_RECOVERY_CHUNK_BITS_MAX
+ * @param index part index, less than 4^sub_bits
+ * @return chunk pair index at chunk_bits + sub_bits
+ */
+uint32_t nested_recovery_get_sub_chunk(
+    uint32_t chunk,
+    uint8_t chunk_bits,
+    uint8_t sub_bits,
+    uint32_t index);
+
+/** Recover keys of one chunk pair
+ *
+ * @param instance NestedRecovery instance
+ * @param nested_try nonces of the try
+ * @param chunk chunk pair index, less than nested_recovery_get_chunk_count
+ * @param callback called for every key consistent with both nonces
+ * @param context callback context
+ * @return NestedRecoveryResult
+ */
+NestedRecoveryResult nested_recovery_run(
+    NestedRecovery* instance,
+    const NestedRecoveryTry* nested_try,
+    uint32_t chunk,
+    NestedRecoveryCallback callback,
+    void* context);
+
+/** Check key against both nonces of the try
+ *
+ * @param nested_try nonces of the try
+ * @param key key
+ * @return true if key produces keystream of both nonces
+ */
+bool nested_recovery_check_key(const NestedRecoveryTry* nested_try, uint64_t key);
+
+/** Predict plain nonce of nested authentication
+ *
+ * Nonce is searched distance +- NESTED_RECOVERY_DISTANCE_SPREAD PRNG steps after the
+ * nonce of the authentication with known key, candidates are checked against parity
+ * of the first 3 bytes.
+ *
+ * @param nt_prev plain nonce of authentication with known key
+ * @param nt_enc encrypted nonce of nested authentication
+ * @param parity oddparity8(byte) ^ received parity of every nt_enc byte, as collected
+ * @param distance PRNG steps between nonces
+ * @param nt output, plain nonce
+ * @return true if exactly one candidate is left
+ */
+bool nested_recovery_predict_nonce(
+    uint32_t nt_prev,
+    uint32_t nt_enc,
+    const uint8_t parity[4],
+    uint32_t distance,
+    uint32_t* nt);
+
+#ifdef __cplusplus
+}
+#endif
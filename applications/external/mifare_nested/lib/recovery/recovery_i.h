@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <lib/nfc/protocols/crypto1.h>
+
+/* Scalar crypto1 for key recovery, same cipher as lib/crypto1 with rollback and key
+ * extraction added. Kept inline and free of furi so recovery builds on host too. */
+
+#define RECOVERY_LF_POLY_ODD (0x29CE5C)
+#define RECOVERY_LF_POLY_EVEN (0x870804)
+
+#define RECOVERY_BIT(x, n) ((x) >> (n)&1)
+#define RECOVERY_BEBIT(x, n) RECOVERY_BIT(x, (n) ^ 24)
+
+static inline uint32_t recovery_parity(uint32_t x) {
+    return __builtin_parity(x);
+}
+
+static inline uint32_t recovery_filter(uint32_t x) {
+    uint32_t f;
+    f = 0xf22c0 >> (x & 0xf) & 16;
+    f |= 0x6c9c0 >> (x >> 4 & 0xf) & 8;
+    f |= 0x3c8b0 >> (x >> 8 & 0xf) & 4;
+    f |= 0x1e458 >> (x >> 12 & 0xf) & 2;
+    f |= 0x0d938 >> (x >> 16 & 0xf) & 1;
+    return RECOVERY_BIT(0xEC57E80A, f);
+}
+
+static inline uint32_t recovery_bit(Crypto1* state, uint32_t in, bool encrypted) {
+    uint32_t out = recovery_filter(state->odd);
+    uint32_t feed = (out & encrypted) ^ (in & 1);
+    feed ^= RECOVERY_LF_POLY_ODD & state->odd;
+    feed ^= RECOVERY_LF_POLY_EVEN & state->even;
+    state->even = state->even << 1 | recovery_parity(feed);
+
+    uint32_t t = state->odd;
+    state->odd = state->even;
+    state->even = t;
+    return out;
+}
+
+/** Shift word in, big endian byte order like on air, return keystream */
+static inline uint32_t recovery_word(Crypto1* state, uint32_t in, bool encrypted) {
+    uint32_t out = 0;
+    for(uint32_t i = 0; i < 32; i++) {
+        out |= recovery_bit(state, RECOVERY_BEBIT(in, i), encrypted) << (24 ^ i);
+    }
+    return out;
+}
+
+/** Step back one bit, inverse of recovery_bit */
+static inline uint32_t recovery_rollback_bit(Crypto1* state, uint32_t in, bool encrypted) {
+    state->odd &= 0xffffff;
+    uint32_t t = state->odd;
+    state->odd = state->even;
+    state->even = t;
+
+    uint32_t out = state->even & 1;
+    out ^= RECOVERY_LF_POLY_EVEN & (state->even >>= 1);
+    out ^= RECOVERY_LF_POLY_ODD & state->odd;
+    out ^= in & 1;
+    uint32_t ret = recovery_filter(state->odd);
+    out ^= ret & encrypted;
+
+    state->even |= recovery_parity(out) << 23;
+    return ret;
+}
+
+static inline void recovery_rollback_word(Crypto1* state, uint32_t in, bool encrypted) {
+    for(int32_t i = 31; i >= 0; i--) {
+        recovery_rollback_bit(state, RECOVERY_BEBIT(in, i), encrypted);
+    }
+}
+
+/** Key to initial state, same as crypto1_init */
+static inline void recovery_init(Crypto1* state, uint64_t key) {
+    state->odd = 0;
+    state->even = 0;
+    for(int32_t i = 47; i > 0; i -= 2) {
+        state->odd = state->odd << 1 | RECOVERY_BIT(key, (i - 1) ^ 7);
+        state->even = state->even << 1 | RECOVERY_BIT(key, i ^ 7);
+    }
+}
+
+/** Initial state to key, inverse of recovery_init */
+static inline uint64_t recovery_get_key(const Crypto1* state) {
+    uint64_t key = 0;
+    for(uint32_t k = 0; k < 24; k++) {
+        key |= (uint64_t)RECOVERY_BIT(state->odd, k) << ((2 * k) ^ 7);
+        key |= (uint64_t)RECOVERY_BIT(state->even, k) << ((2 * k + 1) ^ 7);
+    }
+    return key;
+}
+
+/** PRNG state n steps later, nonces are big endian on air like in prng_successor */
+static inline uint32_t recovery_prng_successor(uint32_t x, uint32_t n) {
+    x = __builtin_bswap32(x);
+    while(n--) x = x >> 1 | (x >> 16 ^ x >> 18 ^ x >> 19 ^ x >> 21) << 31;
+    return __builtin_bswap32(x);
+}
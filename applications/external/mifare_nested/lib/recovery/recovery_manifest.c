@@ -0,0 +1,202 @@
+#include "recovery_manifest.h"
+
+#include <m-array.h>
+#include <stream/file_stream.h>
+
+#define TAG "RecoveryManifest"
+
+#define RECOVERY_MANIFEST_PATH_SIZE (128)
+
+ARRAY_DEF(RecoveryManifestEntryArray, RecoveryManifestEntry, M_POD_OPLIST)
+
+struct RecoveryManifest {
+    RecoveryManifestEntryArray_t entries;
+    // Collected with delay: nonces are predicted from the previous ones
+    uint32_t delay;
+    uint32_t distance;
+};
+
+RecoveryManifest* recovery_manifest_alloc() {
+    RecoveryManifest* instance = malloc(sizeof(RecoveryManifest));
+    RecoveryManifestEntryArray_init(instance->entries);
+    return instance;
+}
+
+static void recovery_manifest_reset(RecoveryManifest* instance) {
+    for(size_t i = 0; i < RecoveryManifestEntryArray_size(instance->entries); i++) {
+        RecoveryManifestEntry* entry = RecoveryManifestEntryArray_get(instance->entries, i);
+        if(entry->path) furi_string_free(entry->path);
+    }
+    RecoveryManifestEntryArray_reset(instance->entries);
+    instance->delay = 0;
+    instance->distance = 0;
+}
+
+void recovery_manifest_free(RecoveryManifest* instance) {
+    furi_assert(instance);
+    recovery_manifest_reset(instance);
+    RecoveryManifestEntryArray_clear(instance->entries);
+    free(instance);
+}
+
+static bool recovery_manifest_parse_parity(const char* digits, uint8_t* parity) {
+    for(size_t i = 0; i < 4; i++) {
+        if(digits[i] != '0' && digits[i] != '1') return false;
+        parity[i] = digits[i] - '0';
+    }
+    return true;
+}
+
+static bool recovery_manifest_parse_line(RecoveryManifest* instance, const char* line) {
+    RecoveryManifestEntry entry = {0};
+    char key_type = 0;
+    unsigned long cuid = 0;
+    unsigned int sector = 0;
+
+    unsigned long nt[2] = {0};
+    unsigned long ks[2] = {0};
+    char parity[2][5] = {0};
+    char path[RECOVERY_MANIFEST_PATH_SIZE] = {0};
+    unsigned long delay = 0;
+    unsigned long distance = 0;
+
+    if(sscanf(
+           line,
+           "Nested: Key %c cuid 0x%lx nt0 0x%lx ks0 0x%lx par0 %4s nt1 0x%lx ks1 0x%lx par1 "
+           "%4s sec %u",
+           &key_type,
+           &cuid,
+           &nt[0],
+           &ks[0],
+           parity[0],
+           &nt[1],
+           &ks[1],
+           parity[1],
+           &sector) == 9) {
+        for(size_t i = 0; i < 2; i++) {
+            entry.nt[i] = nt[i];
+            entry.ks[i] = ks[i];
+            if(!recovery_manifest_parse_parity(parity[i], entry.parity[i])) return false;
+        }
+    } else if(
+        sscanf(
+            line,
+            "HardNested: Key %c cuid 0x%lx file %127s sec %u",
+            &key_type,
+            &cuid,
+            path,
+            &sector) == 4) {
+        entry.hardnested = true;
+        entry.path = furi_string_alloc_set(path);
+    } else if(sscanf(line, "Nested: Delay %lu, distance %lu", &delay, &distance) == 2) {
+        instance->delay = delay;
+        instance->distance = distance;
+        return true;
+    } else {
+        return false;
+    }
+
+    if((key_type != 'A' && key_type != 'B') || sector >= 40) {
+        if(entry.path) furi_string_free(entry.path);
+        return false;
+    }
+
+    entry.key_type = key_type == 'B';
+    entry.sector = sector;
+    entry.cuid = cuid;
+    RecoveryManifestEntryArray_push_back(instance->entries, entry);
+    return true;
+}
+
+bool recovery_manifest_load(RecoveryManifest* instance, Storage* storage, const char* path) {
+    furi_assert(instance);
+    furi_assert(storage);
+    furi_assert(path);
+
+    recovery_manifest_reset(instance);
+
+    Stream* stream = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+
+    if(file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(stream_read_line(stream, line)) {
+            furi_string_trim(line);
+            if(!furi_string_start_with_str(line, "Nested:") &&
+               !furi_string_start_with_str(line, "HardNested:")) {
+                continue;
+            }
+            if(!recovery_manifest_parse_line(instance, furi_string_get_cstr(line))) {
+                FURI_LOG_W(TAG, "Skipping line: %s", furi_string_get_cstr(line));
+            }
+        }
+    } else {
+        FURI_LOG_E(TAG, "Can't open %s", path);
+    }
+
+    furi_string_free(line);
+    file_stream_close(stream);
+    stream_free(stream);
+
+    return RecoveryManifestEntryArray_size(instance->entries) > 0;
+}
+
+size_t recovery_manifest_get_count(RecoveryManifest* instance) {
+    furi_assert(instance);
+    return RecoveryManifestEntryArray_size(instance->entries);
+}
+
+const RecoveryManifestEntry* recovery_manifest_get(RecoveryManifest* instance, size_t index) {
+    furi_assert(instance);
+    return RecoveryManifestEntryArray_get(instance->entries, index);
+}
+
+bool recovery_manifest_get_try(
+    RecoveryManifest* instance,
+    size_t index,
+    NestedRecoveryTry* nested_try) {
+    furi_assert(instance);
+    furi_assert(nested_try);
+
+    const RecoveryManifestEntry* entry = recovery_manifest_get(instance, index);
+    if(entry->hardnested) return false;
+
+    nested_try->cuid = entry->cuid;
+    for(size_t i = 0; i < 2; i++) {
+        if(instance->delay) {
+            uint32_t nt_enc = entry->ks[i];
+            uint32_t* nt = &nested_try->nt[i];
+            if(!nested_recovery_predict_nonce(
+                   entry->nt[i], nt_enc, entry->parity[i], instance->distance, nt)) {
+                return false;
+            }
+            nested_try->ks[i] = nt_enc ^ nested_try->nt[i];
+        } else {
+            nested_try->nt[i] = entry->nt[i];
+            nested_try->ks[i] = entry->ks[i];
+        }
+    }
+
+    return true;
+}
+
+bool recovery_manifest_write_key(Stream* stream, uint8_t key_type, uint8_t sector, uint64_t key) {
+    furi_assert(stream);
+
+    // Key A sector 03: A0 A1 A2 A3 A4 A5
+    uint8_t bytes[6];
+    for(size_t i = 0; i < 6; i++) {
+        bytes[i] = key >> (40 - 8 * i);
+    }
+
+    return stream_write_format(
+               stream,
+               "Key %c sector %02u: %02X %02X %02X %02X %02X %02X\n",
+               !key_type ? 'A' : 'B',
+               sector,
+               bytes[0],
+               bytes[1],
+               bytes[2],
+               bytes[3],
+               bytes[4],
+               bytes[5]) > 0;
+}
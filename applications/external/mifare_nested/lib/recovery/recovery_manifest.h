@@ -0,0 +1,72 @@
+#pragma once
+
+#include "nested_recovery.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <stream/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Nonces manifest (.nonces) written by the collector and found keys file (.keys) read
+ * by key check. Hardnested entries are only listed, their keys need the desktop app. */
+
+typedef struct RecoveryManifest RecoveryManifest;
+
+typedef struct {
+    uint8_t key_type; /**< 0 for key A, 1 for key B */
+    uint8_t sector;
+    bool hardnested;
+    uint32_t cuid;
+    /** Nested: nonces as collected, with delay nt is the previous nonce and ks is nt_enc */
+    uint32_t nt[2];
+    uint32_t ks[2];
+    uint8_t parity[2][4];
+    /** Hardnested: nonces file */
+    FuriString* path;
+} RecoveryManifestEntry;
+
+RecoveryManifest* recovery_manifest_alloc();
+
+void recovery_manifest_free(RecoveryManifest* instance);
+
+/** Load manifest, previous entries are dropped
+ *
+ * @param instance RecoveryManifest instance
+ * @param storage Storage instance
+ * @param path .nonces file path
+ * @return true if file has at least one entry
+ */
+bool recovery_manifest_load(RecoveryManifest* instance, Storage* storage, const char* path);
+
+size_t recovery_manifest_get_count(RecoveryManifest* instance);
+
+const RecoveryManifestEntry* recovery_manifest_get(RecoveryManifest* instance, size_t index);
+
+/** Get nested try of entry, predicting nonces if collected with delay
+ *
+ * @param instance RecoveryManifest instance
+ * @param index entry index
+ * @param nested_try output
+ * @return true if entry is nested and nonces are known
+ */
+bool recovery_manifest_get_try(
+    RecoveryManifest* instance,
+    size_t index,
+    NestedRecoveryTry* nested_try);
+
+/** Write key line of found keys file, as key check reads it
+ *
+ * @param stream open .keys file
+ * @param key_type 0 for key A, 1 for key B
+ * @param sector sector
+ * @param key key
+ * @return true if written
+ */
+bool recovery_manifest_write_key(Stream* stream, uint8_t key_type, uint8_t sector, uint64_t key);
+
+#ifdef __cplusplus
+}
+#endif
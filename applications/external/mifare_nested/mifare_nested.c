@@ -157,6 +157,20 @@ static void check_keys_draw_callback(Canvas* canvas, void* model) {
         canvas_set_font(canvas, FontSecondary);
         elements_multiline_text_aligned(
             canvas, 64, 23, AlignCenter, AlignTop, "Make sure the tag is\npositioned correctly.");
+    } else if(m->recovering_keys) {
+        char draw_str[32] = {};
+        canvas_set_font(canvas, FontPrimary);
+        canvas_draw_str_aligned(canvas, 64, 2, AlignCenter, AlignTop, "Recovering keys...");
+        canvas_set_font(canvas, FontSecondary);
+
+        float progress = m->recovery_total == 0 ?
+                             0 :
+                             (float)(m->recovery_done) / (float)(m->recovery_total);
+
+        elements_progress_bar(canvas, 5, 15, 120, progress);
+        snprintf(draw_str, sizeof(draw_str), "Keys found: %lu", m->keys_found);
+        canvas_draw_str_aligned(canvas, 1, 28, AlignLeft, AlignTop, draw_str);
+        canvas_draw_str_aligned(canvas, 1, 40, AlignLeft, AlignTop, "This can take a while");
     } else if(m->processing_keys) {
         canvas_set_font(canvas, FontPrimary);
         canvas_draw_str_aligned(canvas, 64, 4, AlignCenter, AlignTop, "Processing keys...");
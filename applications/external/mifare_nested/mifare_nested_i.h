@@ -136,6 +136,9 @@ typedef struct {
     uint32_t keys_total;
     bool lost_tag;
     bool processing_keys;
+    bool recovering_keys;
+    uint32_t recovery_done;
+    uint32_t recovery_total;
 } CheckKeysViewModel;
 
 static const NotificationSequence mifare_nested_sequence_blink_start_blue = {
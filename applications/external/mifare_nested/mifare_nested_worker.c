@@ -2,6 +2,7 @@
 
 #include "lib/nested/nested.h"
 #include "lib/parity/parity.h"
+#include "lib/recovery/recovery_manifest.h"
 #include <lib/nfc/protocols/nfc_util.h>
 
 #include <storage/storage.h>
@@ -13,6 +14,12 @@
 
 #define TAG "MifareNestedWorker"
 
+// 80 KB of tables, 65536 chunk pairs per try
+#define MIFARE_NESTED_RECOVERY_CHUNK_BITS (8)
+// Chunk pair that outgrew the tables is run again as 16 smaller pairs
+#define MIFARE_NESTED_RECOVERY_SUB_BITS (2)
+#define MIFARE_NESTED_RECOVERY_PROGRESS_CHUNKS (64)
+
 // possible sum property values
 static uint16_t sums[] =
     {0, 32, 56, 64, 80, 96, 104, 112, 120, 128, 136, 144, 152, 160, 176, 192, 200, 224, 256};
@@ -1486,6 +1493,194 @@ void mifare_nested_worker_write_key(Storage* storage, FuriString* key) {
     file_stream_close(file_stream);
 }
 
+typedef struct {
+    uint64_t key;
+    bool found;
+} MifareNestedRecoveryContext;
+
+static bool mifare_nested_worker_recovery_callback(uint64_t key, void* context) {
+    MifareNestedRecoveryContext* recovery_context = context;
+
+    recovery_context->key = key;
+    recovery_context->found = true;
+
+    // Key is already checked against both nonces, rest of the chunks are not needed
+    return false;
+}
+
+// Chunk pair outgrew memory: free it and run parts of the pair at more chunk bits
+static NestedRecoveryResult mifare_nested_worker_recover_sub_chunks(
+    NestedRecovery** recovery,
+    const NestedRecoveryTry* nested_try,
+    uint32_t chunk,
+    MifareNestedRecoveryContext* recovery_context) {
+    NestedRecoveryResult result = NestedRecoveryResultOk;
+    uint32_t count = 1UL << (MIFARE_NESTED_RECOVERY_SUB_BITS * 2);
+
+    nested_recovery_free(*recovery);
+    NestedRecovery* sub_recovery = nested_recovery_alloc(
+        MIFARE_NESTED_RECOVERY_CHUNK_BITS + MIFARE_NESTED_RECOVERY_SUB_BITS);
+
+    for(uint32_t i = 0; i < count; i++) {
+        NestedRecoveryResult sub_result = nested_recovery_run(
+            sub_recovery,
+            nested_try,
+            nested_recovery_get_sub_chunk(
+                chunk, MIFARE_NESTED_RECOVERY_CHUNK_BITS, MIFARE_NESTED_RECOVERY_SUB_BITS, i),
+            mifare_nested_worker_recovery_callback,
+            recovery_context);
+        if(sub_result == NestedRecoveryResultStopped) {
+            result = sub_result;
+            break;
+        } else if(sub_result == NestedRecoveryResultOverflow) {
+            result = sub_result;
+        }
+    }
+
+    nested_recovery_free(sub_recovery);
+    *recovery = nested_recovery_alloc(MIFARE_NESTED_RECOVERY_CHUNK_BITS);
+
+    return result;
+}
+
+// Recover keys of nested nonces into found keys file, hardnested ones are left for desktop
+bool mifare_nested_worker_recover_keys(
+    MifareNestedWorker* mifare_nested_worker,
+    Storage* storage,
+    FuriHalNfcDevData* data) {
+    KeyInfo_t* key_info = mifare_nested_worker->context->keys;
+    RecoveryManifest* manifest = recovery_manifest_alloc();
+    FuriString* path = furi_string_alloc();
+    uint32_t keys_written = 0;
+
+    mifare_nested_worker_get_nonces_file_path(data, path);
+
+    if(!recovery_manifest_load(manifest, storage, furi_string_get_cstr(path))) {
+        recovery_manifest_free(manifest);
+        furi_string_free(path);
+        return false;
+    }
+
+    size_t count = recovery_manifest_get_count(manifest);
+    size_t nested_count = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(!recovery_manifest_get(manifest, i)->hardnested) nested_count++;
+    }
+
+    if(nested_count) {
+        FURI_LOG_I(
+            TAG,
+            "Recovering %u nested keys, %u bytes",
+            nested_count,
+            nested_recovery_get_memory_size(MIFARE_NESTED_RECOVERY_CHUNK_BITS));
+
+        NestedRecovery* recovery = nested_recovery_alloc(MIFARE_NESTED_RECOVERY_CHUNK_BITS);
+        uint32_t chunk_count = nested_recovery_get_chunk_count(recovery);
+        MifareNestedRecoveryContext recovery_context = {0};
+        bool found_keys[2][40] = {};
+        bool failed_keys[2][40] = {};
+
+        Stream* file_stream = file_stream_alloc(storage);
+        mifare_nested_worker_get_found_keys_file_path(data, path);
+        file_stream_open(
+            file_stream, furi_string_get_cstr(path), FSAM_READ_WRITE, FSOM_CREATE_ALWAYS);
+
+        key_info->recovery_done = 0;
+        key_info->recovery_total = nested_count * chunk_count;
+        key_info->recovered_keys = 0;
+        mifare_nested_worker->callback(
+            MifareNestedWorkerEventRecoveringKeys, mifare_nested_worker->context);
+
+        for(size_t i = 0; i < count; i++) {
+            const RecoveryManifestEntry* entry = recovery_manifest_get(manifest, i);
+            if(entry->hardnested) continue;
+
+            NestedRecoveryTry nested_try;
+            // Same key from other tries is not needed
+            if(found_keys[entry->key_type][entry->sector] ||
+               !recovery_manifest_get_try(manifest, i, &nested_try)) {
+                key_info->recovery_done += chunk_count;
+                continue;
+            }
+
+            recovery_context.found = false;
+            for(uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+                if(mifare_nested_worker->state != MifareNestedWorkerStateValidating) break;
+
+                NestedRecoveryResult result = nested_recovery_run(
+                    recovery,
+                    &nested_try,
+                    chunk,
+                    mifare_nested_worker_recovery_callback,
+                    &recovery_context);
+
+                if(result == NestedRecoveryResultOverflow) {
+                    FURI_LOG_W(TAG, "Sector %u: chunk %lu overflow", entry->sector, chunk);
+                    result = mifare_nested_worker_recover_sub_chunks(
+                        &recovery, &nested_try, chunk, &recovery_context);
+                }
+
+                if(result == NestedRecoveryResultOverflow) {
+                    FURI_LOG_E(TAG, "Sector %u: chunk %lu not searched", entry->sector, chunk);
+                    failed_keys[entry->key_type][entry->sector] = true;
+                } else if(result == NestedRecoveryResultStopped) {
+                    key_info->recovery_done += chunk_count - chunk;
+                    break;
+                }
+
+                key_info->recovery_done++;
+                if(!(key_info->recovery_done % MIFARE_NESTED_RECOVERY_PROGRESS_CHUNKS)) {
+                    mifare_nested_worker->callback(
+                        MifareNestedWorkerEventRecoveringKeys, mifare_nested_worker->context);
+                }
+            }
+
+            if(recovery_context.found) {
+                FURI_LOG_I(
+                    TAG,
+                    "Recovered %c key for sector %u: %012llX",
+                    !entry->key_type ? 'A' : 'B',
+                    entry->sector,
+                    recovery_context.key);
+                recovery_manifest_write_key(
+                    file_stream, entry->key_type, entry->sector, recovery_context.key);
+                found_keys[entry->key_type][entry->sector] = true;
+                keys_written++;
+            }
+
+            key_info->recovered_keys = keys_written;
+        }
+
+        // Part of the key space was not searched, and no other try found the key
+        for(size_t key_type = 0; key_type < 2; key_type++) {
+            for(size_t sector = 0; sector < 40; sector++) {
+                if(failed_keys[key_type][sector] && !found_keys[key_type][sector]) {
+                    key_info->recovery_failed++;
+                }
+            }
+        }
+
+        key_info->recovery_done = key_info->recovery_total;
+        mifare_nested_worker->callback(
+            MifareNestedWorkerEventRecoveringKeys, mifare_nested_worker->context);
+
+        file_stream_close(file_stream);
+        stream_free(file_stream);
+        nested_recovery_free(recovery);
+
+        // Stopped or nothing found: next check starts over
+        if(!keys_written || mifare_nested_worker->state != MifareNestedWorkerStateValidating) {
+            storage_simply_remove(storage, furi_string_get_cstr(path));
+            keys_written = 0;
+        }
+    }
+
+    recovery_manifest_free(manifest);
+    furi_string_free(path);
+
+    return keys_written > 0;
+}
+
 void mifare_nested_worker_check_keys(MifareNestedWorker* mifare_nested_worker) {
     KeyInfo_t* key_info = mifare_nested_worker->context->keys;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -1530,6 +1725,22 @@ void mifare_nested_worker_check_keys(MifareNestedWorker* mifare_nested_worker) {
 
     mifare_nested_worker_get_found_keys_file_path(&data, path);
 
+    key_info->recovery_failed = 0;
+    // Otherwise user is asked first, see NeedKeyRecovery scene
+    if(!storage_file_exists(storage, furi_string_get_cstr(path)) &&
+       key_info->recovery_confirmed) {
+        mifare_nested_worker_recover_keys(mifare_nested_worker, storage, &data);
+
+        if(mifare_nested_worker->state != MifareNestedWorkerStateValidating) {
+            free(file_stream);
+            furi_string_free(path);
+            furi_string_free(next_line);
+            furi_record_close(RECORD_STORAGE);
+
+            return;
+        }
+    }
+
     if(!file_stream_open(file_stream, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
         FURI_LOG_E(TAG, "Can't open %s", furi_string_get_cstr(path));
 
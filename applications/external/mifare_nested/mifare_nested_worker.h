@@ -37,7 +37,8 @@ typedef enum {
     MifareNestedWorkerEventProcessingKeys,
     MifareNestedWorkerEventNeedKeyRecovery,
     MifareNestedWorkerEventNeedCollection,
-    MifareNestedWorkerEventHardnestedStatesFound
+    MifareNestedWorkerEventHardnestedStatesFound,
+    MifareNestedWorkerEventRecoveringKeys
 } MifareNestedWorkerEvent;
 
 typedef bool (*MifareNestedWorkerCallback)(MifareNestedWorkerEvent event, void* context);
@@ -89,6 +90,14 @@ typedef struct {
     uint32_t added_keys;
     uint32_t sector_keys;
     bool tag_lost;
+    // Native key recovery, progress in chunk pairs
+    uint32_t recovery_done;
+    uint32_t recovery_total;
+    uint32_t recovered_keys;
+    // Keys not recovered because tables outgrew memory
+    uint32_t recovery_failed;
+    // User agreed to recover on Flipper, it takes hours
+    bool recovery_confirmed;
 } KeyInfo_t;
 
 typedef struct {
@@ -36,6 +36,20 @@ void mifare_nested_scene_added_keys_on_enter(void* context) {
     }
 
     widget_add_string_element(widget, 0, 12, AlignLeft, AlignTop, FontSecondary, draw_str);
+
+    if(key_info->recovery_failed != 0) {
+        // Desktop app can still recover them
+        snprintf(draw_str, sizeof(draw_str), "Failed: %lu", key_info->recovery_failed);
+        widget_add_string_element(
+            widget,
+            0,
+            key_info->added_keys != 0 ? 22 : 42,
+            AlignLeft,
+            AlignTop,
+            FontSecondary,
+            draw_str);
+    }
+
     widget_add_button_element(
         widget,
         GuiButtonTypeLeft,
@@ -35,6 +35,19 @@ bool mifare_nested_check_keys_worker_callback(MifareNestedWorkerEvent event, voi
 
         with_view_model(
             plugin_state->view, CheckKeysViewModel * model, { model->lost_tag = true; }, true);
+    } else if(event == MifareNestedWorkerEventRecoveringKeys) {
+        KeyInfo_t* key_info = mifare_nested->keys;
+
+        with_view_model(
+            plugin_state->view,
+            CheckKeysViewModel * model,
+            {
+                model->recovering_keys = key_info->recovery_done < key_info->recovery_total;
+                model->recovery_done = key_info->recovery_done;
+                model->recovery_total = key_info->recovery_total;
+                model->keys_found = key_info->recovered_keys;
+            },
+            true);
     } else if(event == MifareNestedWorkerEventProcessingKeys) {
         with_view_model(
             plugin_state->view,
@@ -67,6 +80,9 @@ void mifare_nested_scene_check_keys_on_enter(void* context) {
         {
             model->lost_tag = false;
             model->processing_keys = false;
+            model->recovering_keys = false;
+            model->recovery_done = 0;
+            model->recovery_total = 0;
             model->keys_count = 0;
             model->keys_checked = 0;
             model->keys_found = 0;
@@ -98,6 +114,7 @@ bool mifare_nested_scene_check_keys_on_event(void* context, SceneManagerEvent ev
         } else if(
             event.event == MifareNestedWorkerEventKeyChecked ||
             event.event == MifareNestedWorkerEventNoTagDetected ||
+            event.event == MifareNestedWorkerEventRecoveringKeys ||
             event.event == MifareNestedWorkerEventProcessingKeys) {
             consumed = true;
         }
@@ -14,16 +14,41 @@ void mifare_nested_scene_need_key_recovery_on_enter(void* context) {
     MifareNested* mifare_nested = context;
     Widget* widget = mifare_nested->widget;
 
-    notification_message(mifare_nested->notifications, &sequence_error);
+    KeyInfo_t* key_info = mifare_nested->keys;
 
     widget_add_icon_element(widget, 74, 13, &I_DolphinCry);
-    widget_add_string_element(
-        widget, 0, 0, AlignLeft, AlignTop, FontPrimary, "Missing found keys");
-    widget_add_string_element(
-        widget, 0, 12, AlignLeft, AlignTop, FontSecondary, "First you need to");
-    widget_add_string_element(widget, 0, 22, AlignLeft, AlignTop, FontSecondary, "recover keys");
-    widget_add_string_element(widget, 0, 32, AlignLeft, AlignTop, FontSecondary, "Read \"About\"");
-    widget_add_string_element(widget, 0, 42, AlignLeft, AlignTop, FontSecondary, "for more info");
+    if(key_info->recovery_confirmed) {
+        // Recovery on Flipper ran and wrote nothing
+        notification_message(mifare_nested->notifications, &sequence_error);
+
+        widget_add_string_element(
+            widget, 0, 0, AlignLeft, AlignTop, FontPrimary, "No keys recovered");
+        widget_add_string_element(
+            widget, 0, 12, AlignLeft, AlignTop, FontSecondary, "Use desktop app");
+        widget_add_string_element(
+            widget, 0, 22, AlignLeft, AlignTop, FontSecondary, "to recover keys");
+        widget_add_string_element(
+            widget, 0, 32, AlignLeft, AlignTop, FontSecondary, "Read \"About\"");
+        widget_add_string_element(
+            widget, 0, 42, AlignLeft, AlignTop, FontSecondary, "for more info");
+    } else {
+        widget_add_string_element(
+            widget, 0, 0, AlignLeft, AlignTop, FontPrimary, "Missing found keys");
+        widget_add_string_element(
+            widget, 0, 12, AlignLeft, AlignTop, FontSecondary, "Recover keys on");
+        widget_add_string_element(
+            widget, 0, 22, AlignLeft, AlignTop, FontSecondary, "Flipper? Can take");
+        widget_add_string_element(
+            widget, 0, 32, AlignLeft, AlignTop, FontSecondary, "hours, desktop");
+        widget_add_string_element(
+            widget, 0, 42, AlignLeft, AlignTop, FontSecondary, "app is faster");
+        widget_add_button_element(
+            widget,
+            GuiButtonTypeRight,
+            "Recover",
+            mifare_nested_scene_need_key_recovery_widget_callback,
+            mifare_nested);
+    }
     widget_add_button_element(
         widget,
         GuiButtonTypeLeft,
@@ -40,11 +65,18 @@ bool mifare_nested_scene_need_key_recovery_on_event(void* context, SceneManagerE
     bool consumed = false;
 
     if(event.type == SceneManagerEventTypeCustom) {
-        if(event.event == GuiButtonTypeCenter || event.event == GuiButtonTypeLeft) {
+        if(event.event == GuiButtonTypeRight) {
+            // Check keys again, worker recovers them this time
+            mifare_nested->keys->recovery_confirmed = true;
+            scene_manager_previous_scene(mifare_nested->scene_manager);
+            consumed = true;
+        } else if(event.event == GuiButtonTypeCenter || event.event == GuiButtonTypeLeft) {
+            mifare_nested->keys->recovery_confirmed = false;
             scene_manager_search_and_switch_to_previous_scene(mifare_nested->scene_manager, 0);
             consumed = true;
         }
     } else if(event.type == SceneManagerEventTypeBack) {
+        mifare_nested->keys->recovery_confirmed = false;
         scene_manager_search_and_switch_to_previous_scene(mifare_nested->scene_manager, 0);
         consumed = true;
     }
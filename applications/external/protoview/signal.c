@@ -2,6 +2,7 @@
  * See the LICENSE file for information about the license. */
 
 #include "app.h"
+#include <lib/subghz/blocks/pulse_cluster.h>
 
 bool decode_signal(RawSamplesBuffer* s, uint64_t len, ProtoViewMsgInfo* info);
 
@@ -77,12 +78,15 @@ void reset_current_signal(ProtoViewApp* app) {
  * pulses of ~400us (RF on) VS ~580us (RF off). */
 #define SEARCH_CLASSES 3
 uint32_t search_coherent_signal(RawSamplesBuffer* s, uint32_t idx, uint32_t min_duration) {
-    struct {
-        uint32_t dur[2]; /* dur[0] = low, dur[1] = high */
-        uint32_t count[2]; /* Associated observed frequency. */
-    } classes[SEARCH_CLASSES];
-
-    memset(classes, 0, sizeof(classes));
+    /* classes[0] = low, classes[1] = high. Pulses within 20% of the
+     * class average join it. It is useful to compute the average of the
+     * class we are observing: by always having a better estimate of the
+     * pulse len we can avoid missing next samples in case the first
+     * observed samples are too off. */
+    SubGhzBlockPulseCluster classes[2];
+    for(int level = 0; level < 2; level++) {
+        subghz_protocol_blocks_pulse_cluster_init(&classes[level], SEARCH_CLASSES, 5, 0);
+    }
 
     // Set a min/max duration limit for samples to be considered part of a
     // coherent signal. The maximum length is fixed while the minimum
@@ -101,36 +105,10 @@ uint32_t search_coherent_signal(RawSamplesBuffer* s, uint32_t idx, uint32_t min_
 
         /* Let's see if it matches a class we already have or if we
          * can populate a new (yet empty) class. */
-        uint32_t k;
-        for(k = 0; k < SEARCH_CLASSES; k++) {
-            if(classes[k].count[level] == 0) {
-                classes[k].dur[level] = dur;
-                classes[k].count[level] = 1;
-                break; /* Sample accepted. */
-            } else {
-                uint32_t classavg = classes[k].dur[level];
-                uint32_t count = classes[k].count[level];
-                uint32_t delta = duration_delta(dur, classavg);
-                /* Is the difference in duration between this signal and
-                 * the class we are inspecting less than a given percentage?
-                 * If so, accept this signal. */
-                if(delta < classavg / 5) { /* 100%/5 = 20%. */
-                    /* It is useful to compute the average of the class
-                     * we are observing. We know how many samples we got so
-                     * far, so we can recompute the average easily.
-                     * By always having a better estimate of the pulse len
-                     * we can avoid missing next samples in case the first
-                     * observed samples are too off. */
-                    classavg = ((classavg * count) + dur) / (count + 1);
-                    classes[k].dur[level] = classavg;
-                    classes[k].count[level]++;
-                    break; /* Sample accepted. */
-                }
-            }
+        if(subghz_protocol_blocks_pulse_cluster_add(&classes[level], dur) < 0) {
+            break; /* No match, return. */
         }
 
-        if(k == SEARCH_CLASSES) break; /* No match, return. */
-
         /* If we are here, we accepted this sample. Try with the next
          * one. */
         len++;
@@ -139,15 +117,9 @@ uint32_t search_coherent_signal(RawSamplesBuffer* s, uint32_t idx, uint32_t min_
     /* Update the buffer setting the shortest pulse we found
      * among the three classes. This will be used when scaling
      * for visualization. */
-    uint32_t short_dur[2] = {0, 0};
-    for(int j = 0; j < SEARCH_CLASSES; j++) {
-        for(int level = 0; level < 2; level++) {
-            if(classes[j].dur[level] == 0) continue;
-            if(classes[j].count[level] < 3) continue;
-            if(short_dur[level] == 0 || short_dur[level] > classes[j].dur[level]) {
-                short_dur[level] = classes[j].dur[level];
-            }
-        }
+    uint32_t short_dur[2];
+    for(int level = 0; level < 2; level++) {
+        short_dur[level] = subghz_protocol_blocks_pulse_cluster_get_shortest(&classes[level], 3);
     }
 
     /* Use the average between high and low short pulses duration.
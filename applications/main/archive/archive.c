@@ -23,6 +23,7 @@ static ArchiveApp* archive_alloc() {
 
     archive->fav_move_str = furi_string_alloc();
     archive->dst_path = furi_string_alloc();
+    files_array_init(archive->search_results);
 
     archive->scene_manager = scene_manager_alloc(&archive_scene_handlers, archive);
     archive->view_dispatcher = view_dispatcher_alloc();
@@ -46,6 +47,10 @@ static ArchiveApp* archive_alloc() {
     view_dispatcher_add_view(
         archive->view_dispatcher, ArchiveViewWidget, widget_get_view(archive->widget));
 
+    archive->submenu = submenu_alloc();
+    view_dispatcher_add_view(
+        archive->view_dispatcher, ArchiveViewSubmenu, submenu_get_view(archive->submenu));
+
     archive->view_stack = view_stack_alloc();
     view_dispatcher_add_view(
         view_dispatcher, ArchiveViewStack, view_stack_get_view(archive->view_stack));
@@ -73,6 +78,9 @@ void archive_free(ArchiveApp* archive) {
     view_dispatcher_remove_view(view_dispatcher, ArchiveViewWidget);
     widget_free(archive->widget);
 
+    view_dispatcher_remove_view(view_dispatcher, ArchiveViewSubmenu);
+    submenu_free(archive->submenu);
+
     view_dispatcher_remove_view(view_dispatcher, ArchiveViewStack);
     view_stack_free(archive->view_stack);
 
@@ -84,6 +92,7 @@ void archive_free(ArchiveApp* archive) {
     browser_free(archive->browser);
     furi_string_free(archive->fav_move_str);
     furi_string_free(archive->dst_path);
+    files_array_clear(archive->search_results);
 
     furi_record_close(RECORD_DIALOGS);
     archive->dialogs = NULL;
@@ -7,6 +7,7 @@
 #include <gui/view_dispatcher.h>
 #include <gui/scene_manager.h>
 #include <gui/modules/text_input.h>
+#include <gui/modules/submenu.h>
 #include <gui/modules/widget.h>
 #include <gui/view_stack.h>
 #include <dialogs/dialogs.h>
@@ -20,6 +21,7 @@ typedef enum {
     ArchiveViewBrowser,
     ArchiveViewTextInput,
     ArchiveViewWidget,
+    ArchiveViewSubmenu,
     ArchiveViewTotal,
     ArchiveViewStack,
 } ArchiveViewEnum;
@@ -32,14 +34,18 @@ struct ArchiveApp {
     ArchiveBrowserView* browser;
     TextInput* text_input;
     Widget* widget;
+    Submenu* submenu;
     DialogsApp* dialogs;
     Loading* loading;
     FuriPubSubSubscription* loader_stop_subscription;
 
     FuriString* fav_move_str;
     FuriString* dst_path;
+    files_array_t search_results;
     char text_store[MAX_NAME_LEN];
     char file_extension[MAX_EXT_LEN + 1];
 };
 
-void archive_show_loading_popup(ArchiveApp* context, bool show);
\ No newline at end of file
+void archive_show_loading_popup(ArchiveApp* context, bool show);
+
+void archive_run_in_app(ArchiveBrowserView* browser, ArchiveFile_t* selected);
\ No newline at end of file
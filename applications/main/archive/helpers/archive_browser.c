@@ -470,56 +470,55 @@ void archive_switch_tab(ArchiveBrowserView* browser, InputKey key) {
 
     browser->last_tab_switch_dir = key;
 
-    if(key == InputKeyLeft) {
-        tab = ((tab - 1) + ArchiveTabTotal) % ArchiveTabTotal;
-    } else {
-        tab = (tab + 1) % ArchiveTabTotal;
-    }
-
-    browser->is_root = true;
-    archive_set_tab(browser, tab);
-
-    furi_string_set(browser->path, archive_get_default_path(tab));
     bool tab_empty = true;
-    if(tab == ArchiveTabFavorites) {
-        if(archive_favorites_count(browser) > 0) {
-            tab_empty = false;
+    do {
+        if(key == InputKeyLeft) {
+            tab = ((tab - 1) + ArchiveTabTotal) % ArchiveTabTotal;
+        } else {
+            tab = (tab + 1) % ArchiveTabTotal;
         }
-    } else if(furi_string_start_with_str(browser->path, "/app:")) {
-        char* app_name = strchr(furi_string_get_cstr(browser->path), ':');
-        if(app_name != NULL) {
-            if(archive_app_is_available(browser, furi_string_get_cstr(browser->path))) {
+
+        browser->is_root = true;
+        archive_set_tab(browser, tab);
+
+        furi_string_set(browser->path, archive_get_default_path(tab));
+        tab_empty = true;
+        if(tab == ArchiveTabFavorites) {
+            if(archive_favorites_count(browser) > 0) {
                 tab_empty = false;
             }
+        } else if(furi_string_start_with_str(browser->path, "/app:")) {
+            char* app_name = strchr(furi_string_get_cstr(browser->path), ':');
+            if(app_name != NULL) {
+                if(archive_app_is_available(browser, furi_string_get_cstr(browser->path))) {
+                    tab_empty = false;
+                }
+            }
+        } else {
+            tab = archive_get_tab(browser);
+            if(archive_is_dir_exists(browser->path)) {
+                bool skip_assets = (strcmp(archive_get_tab_ext(tab), "*") == 0) ? false : true;
+                // Hide dot files everywhere except Browser if in debug mode
+                bool hide_dot_files = (strcmp(archive_get_tab_ext(tab), "*") == 0) ?
+                                          !furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug) :
+                                          true;
+                archive_file_browser_set_path(
+                    browser, browser->path, archive_get_tab_ext(tab), skip_assets, hide_dot_files);
+                tab_empty = false; // Empty check will be performed later
+            }
         }
-    } else {
-        tab = archive_get_tab(browser);
-        if(archive_is_dir_exists(browser->path)) {
-            bool skip_assets = (strcmp(archive_get_tab_ext(tab), "*") == 0) ? false : true;
-            // Hide dot files everywhere except Browser if in debug mode
-            bool hide_dot_files = (strcmp(archive_get_tab_ext(tab), "*") == 0) ?
-                                      !furi_hal_rtc_is_flag_set(FuriHalRtcFlagDebug) :
-                                      true;
-            archive_file_browser_set_path(
-                browser, browser->path, archive_get_tab_ext(tab), skip_assets, hide_dot_files);
-            tab_empty = false; // Empty check will be performed later
-        }
-    }
+    } while((tab_empty) && (tab != ArchiveTabBrowser));
 
-    if((tab_empty) && (tab != ArchiveTabBrowser)) {
-        archive_switch_tab(browser, key);
-    } else {
-        with_view_model(
-            browser->view,
-            ArchiveBrowserViewModel * model,
-            {
-                model->item_idx = 0;
-                model->array_offset = 0;
-            },
-            false);
-        archive_get_items(browser, furi_string_get_cstr(browser->path));
-        archive_update_offset(browser);
-    }
+    with_view_model(
+        browser->view,
+        ArchiveBrowserViewModel * model,
+        {
+            model->item_idx = 0;
+            model->array_offset = 0;
+        },
+        false);
+    archive_get_items(browser, furi_string_get_cstr(browser->path));
+    archive_update_offset(browser);
 }
 
 void archive_enter_dir(ArchiveBrowserView* browser, FuriString* path) {
@@ -6,6 +6,7 @@
 #include "../views/archive_browser_view.h"
 #include "archive/scenes/archive_scene.h"
 #include <applications.h>
+#include <indexer/indexer.h>
 
 #define TAG "ArchiveSceneBrowser"
 
@@ -49,7 +50,7 @@ static void archive_loader_callback(const void* message, void* context) {
     }
 }
 
-static void archive_run_in_app(ArchiveBrowserView* browser, ArchiveFile_t* selected) {
+void archive_run_in_app(ArchiveBrowserView* browser, ArchiveFile_t* selected) {
     UNUSED(browser);
     Loader* loader = furi_record_open(RECORD_LOADER);
 
@@ -298,6 +299,13 @@ bool archive_scene_browser_on_event(void* context, SceneManagerEvent event) {
             }
             consumed = true;
             break;
+        case ArchiveBrowserEventSearch:
+            // Search is available only if indexer service is built in and running
+            if(furi_record_exists(RECORD_INDEXER)) {
+                scene_manager_next_scene(archive->scene_manager, ArchiveAppSceneSearch);
+            }
+            consumed = true;
+            break;
 
         case ArchiveBrowserEventExit:
             if(!archive_is_home(browser)) {
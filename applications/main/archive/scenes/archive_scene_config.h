@@ -3,4 +3,5 @@ ADD_SCENE(archive, rename, Rename)
 ADD_SCENE(archive, delete, Delete)
 ADD_SCENE(archive, info, Info)
 ADD_SCENE(archive, show, Show)
-ADD_SCENE(archive, new_dir, NewDir)
\ No newline at end of file
+ADD_SCENE(archive, new_dir, NewDir)
+ADD_SCENE(archive, search, Search)
\ No newline at end of file
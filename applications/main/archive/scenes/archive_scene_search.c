@@ -0,0 +1,119 @@
+#include "../archive_i.h"
+#include "../helpers/archive_files.h"
+#include <indexer/indexer.h>
+
+#define SEARCH_RESULTS_MAX (32)
+
+#define SCENE_SEARCH_CUSTOM_EVENT (0UL)
+#define SCENE_SEARCH_RESULT_EVENT (1UL)
+
+static void archive_scene_search_text_input_callback(void* context) {
+    ArchiveApp* archive = context;
+    view_dispatcher_send_custom_event(archive->view_dispatcher, SCENE_SEARCH_CUSTOM_EVENT);
+}
+
+static void archive_scene_search_submenu_callback(void* context, uint32_t index) {
+    ArchiveApp* archive = context;
+    view_dispatcher_send_custom_event(
+        archive->view_dispatcher, SCENE_SEARCH_RESULT_EVENT + index);
+}
+
+static bool archive_scene_search_query_callback(const IndexerResult* result, void* context) {
+    ArchiveApp* archive = context;
+
+    // One item per file, labeled by the first matched value
+    files_array_it_t it;
+    for(files_array_it(it, archive->search_results); !files_array_end_p(it);
+        files_array_next(it)) {
+        if(furi_string_equal_str(files_array_cref(it)->path, result->path)) {
+            return true;
+        }
+    }
+
+    ArchiveFile_t* item = files_array_push_new(archive->search_results);
+    furi_string_set(item->path, result->path);
+    archive_set_file_type(item, result->path, false, false);
+
+    path_extract_filename(item->path, item->custom_name, true);
+    if(result->field != IndexerFieldName) {
+        furi_string_cat_printf(item->custom_name, " %s", result->value);
+    }
+
+    return files_array_size(archive->search_results) < SEARCH_RESULTS_MAX;
+}
+
+static void archive_scene_search_show_results(ArchiveApp* archive) {
+    Submenu* submenu = archive->submenu;
+    submenu_reset(submenu);
+    files_array_reset(archive->search_results);
+
+    view_dispatcher_switch_to_view(archive->view_dispatcher, ArchiveViewStack);
+    archive_show_loading_popup(archive, true);
+    Indexer* indexer = furi_record_open(RECORD_INDEXER);
+    indexer_query(
+        indexer,
+        archive->text_store,
+        IndexerMatchPrefix,
+        archive_scene_search_query_callback,
+        archive);
+    furi_record_close(RECORD_INDEXER);
+    archive_show_loading_popup(archive, false);
+
+    size_t count = files_array_size(archive->search_results);
+    submenu_set_header(submenu, count ? "Search results:" : "Nothing found");
+    for(size_t i = 0; i < count; i++) {
+        submenu_add_item(
+            submenu,
+            furi_string_get_cstr(files_array_get(archive->search_results, i)->custom_name),
+            i,
+            archive_scene_search_submenu_callback,
+            archive);
+    }
+
+    view_dispatcher_switch_to_view(archive->view_dispatcher, ArchiveViewSubmenu);
+}
+
+void archive_scene_search_on_enter(void* context) {
+    ArchiveApp* archive = context;
+    TextInput* text_input = archive->text_input;
+
+    archive->text_store[0] = '\0';
+    text_input_set_header_text(text_input, "Search key, UID, name:");
+    text_input_set_result_callback(
+        text_input,
+        archive_scene_search_text_input_callback,
+        archive,
+        archive->text_store,
+        MAX_NAME_LEN,
+        false);
+
+    view_dispatcher_switch_to_view(archive->view_dispatcher, ArchiveViewTextInput);
+}
+
+bool archive_scene_search_on_event(void* context, SceneManagerEvent event) {
+    ArchiveApp* archive = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == SCENE_SEARCH_CUSTOM_EVENT) {
+            archive_scene_search_show_results(archive);
+            consumed = true;
+        } else if(event.event >= SCENE_SEARCH_RESULT_EVENT) {
+            size_t index = event.event - SCENE_SEARCH_RESULT_EVENT;
+            if(index < files_array_size(archive->search_results)) {
+                archive_run_in_app(
+                    archive->browser, files_array_get(archive->search_results, index));
+            }
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void archive_scene_search_on_exit(void* context) {
+    ArchiveApp* archive = context;
+    text_input_reset(archive->text_input);
+    submenu_reset(archive->submenu);
+    files_array_reset(archive->search_results);
+}
@@ -570,6 +570,10 @@ static bool archive_view_input(InputEvent* event, void* context) {
                     browser->callback(ArchiveBrowserEventExit, browser->context);
                 }
             }
+        } else if(event->type == InputTypeLong && event->key == InputKeyBack) {
+            if(!move_fav_mode) {
+                browser->callback(ArchiveBrowserEventSearch, browser->context);
+            }
         }
 
         if((event->key == InputKeyUp || event->key == InputKeyDown) &&
@@ -70,6 +70,8 @@ typedef enum {
 
     ArchiveBrowserEventListRefresh,
 
+    ArchiveBrowserEventSearch,
+
     ArchiveBrowserEventExit,
 } ArchiveBrowserEvent;
 
@@ -75,6 +75,7 @@ typedef enum {
     SubGhzCustomEventSceneAnalyzerLock,
     SubGhzCustomEventSceneAnalyzerUnlock,
     SubGhzCustomEventSceneSettingLock,
+    SubGhzCustomEventSceneDecodeRawDone,
 
     SubGhzCustomEventSceneExit,
     SubGhzCustomEventSceneStay,
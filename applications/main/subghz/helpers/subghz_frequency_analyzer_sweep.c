@@ -0,0 +1,365 @@
+#include "subghz_frequency_analyzer_sweep.h"
+
+#include <furi.h>
+#include <math.h>
+
+#define TAG "SubGhzFrequencyAnalyzerSweep"
+
+#define SWEEP_RSSI_NONE (-127.0f)
+
+// Legacy: fixed wait after every retune
+#define SWEEP_DWELL_FIXED_US 2000
+// Adaptive: first read, then read every step until two reads agree
+#define SWEEP_DWELL_MIN_US 500
+#define SWEEP_DWELL_STEP_US 250
+#define SWEEP_DWELL_MAX_US SWEEP_DWELL_FIXED_US
+#define SWEEP_SETTLED_DB 1.0f
+
+// Recently active frequencies visited every cycle
+#define SWEEP_HOT_MAX 4
+// Other frequencies visited per cycle
+#define SWEEP_COLD_SLICE 8
+
+#define SWEEP_ACTIVITY_HIT 64
+#define SWEEP_ACTIVITY_MAX 255
+
+// Wide filter sees neighbours: after trigger check list frequencies this close
+#define SWEEP_NEIGHBOUR_SPAN 1000000
+
+// Fine search: -0.3 ... coarse ... +0.3 MHz, 20 kHz resolution
+#define SWEEP_FINE_SPAN 300000
+#define SWEEP_FINE_STEP 20000
+// 2 - golden ratio
+#define SWEEP_GOLDEN_RATIO 0.381966f
+
+struct SubGhzFrequencyAnalyzerSweep {
+    const SubGhzFrequencyAnalyzerSweepRadio* radio;
+    void* context;
+    bool adaptive;
+
+    uint32_t* frequency;
+    uint8_t* activity;
+    size_t count;
+    size_t capacity;
+
+    size_t cold_cursor;
+};
+
+SubGhzFrequencyAnalyzerSweep* subghz_frequency_analyzer_sweep_alloc(
+    const SubGhzFrequencyAnalyzerSweepRadio* radio,
+    void* context,
+    size_t capacity) {
+    furi_assert(radio);
+    SubGhzFrequencyAnalyzerSweep* instance = malloc(sizeof(SubGhzFrequencyAnalyzerSweep));
+
+    instance->radio = radio;
+    instance->context = context;
+    instance->adaptive = true;
+    instance->capacity = capacity;
+    instance->frequency = malloc(sizeof(uint32_t) * capacity);
+    instance->activity = malloc(sizeof(uint8_t) * capacity);
+
+    return instance;
+}
+
+void subghz_frequency_analyzer_sweep_free(SubGhzFrequencyAnalyzerSweep* instance) {
+    furi_assert(instance);
+
+    free(instance->activity);
+    free(instance->frequency);
+    free(instance);
+}
+
+void subghz_frequency_analyzer_sweep_add_frequency(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    uint32_t frequency) {
+    furi_assert(instance);
+    furi_check(instance->count < instance->capacity);
+
+    instance->frequency[instance->count] = frequency;
+    instance->activity[instance->count] = 0;
+    instance->count++;
+}
+
+void subghz_frequency_analyzer_sweep_set_adaptive(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    bool adaptive) {
+    furi_assert(instance);
+    instance->adaptive = adaptive;
+}
+
+/** Tune and read RSSI once it is valid
+ *
+ * @param      instance   SubGhzFrequencyAnalyzerSweep instance
+ * @param      frequency  frequency to tune, real frequency on return
+ *
+ * @return     RSSI, dBm
+ */
+static float subghz_frequency_analyzer_sweep_measure(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    uint32_t* frequency) {
+    const SubGhzFrequencyAnalyzerSweepRadio* radio = instance->radio;
+    if(!radio->is_frequency_valid(instance->context, *frequency)) return SWEEP_RSSI_NONE;
+
+    *frequency = radio->tune(instance->context, *frequency);
+
+    if(!instance->adaptive) {
+        radio->delay_us(instance->context, SWEEP_DWELL_FIXED_US);
+        return radio->get_rssi(instance->context);
+    }
+
+    // AGC and RSSI filter settle after retune, stop waiting as soon as reads agree
+    radio->delay_us(instance->context, SWEEP_DWELL_MIN_US);
+    float rssi = radio->get_rssi(instance->context);
+    for(uint32_t dwell = SWEEP_DWELL_MIN_US; dwell < SWEEP_DWELL_MAX_US;
+        dwell += SWEEP_DWELL_STEP_US) {
+        radio->delay_us(instance->context, SWEEP_DWELL_STEP_US);
+        float rssi_next = radio->get_rssi(instance->context);
+        bool settled = fabsf(rssi_next - rssi) < SWEEP_SETTLED_DB;
+        rssi = rssi_next;
+        if(settled) break;
+    }
+    return rssi;
+}
+
+/** Coarse frequencies to visit this cycle
+ *
+ * Adaptive: one of the others, most active, then the rest of next slice of
+ * the others. Cold cursor advance after visiting each of them is put to
+ * advance, 0 for active ones.
+ *
+ * @return     index count
+ */
+static size_t subghz_frequency_analyzer_sweep_schedule(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t* order,
+    size_t* advance,
+    size_t* cold_count) {
+    size_t count = 0;
+    *cold_count = 0;
+
+    if(!instance->adaptive) {
+        for(size_t i = 0; i < instance->count; i++) {
+            order[count++] = i;
+        }
+        return count;
+    }
+
+    // Keep few most active, sorted descending
+    for(size_t i = 0; i < instance->count; i++) {
+        uint8_t activity = instance->activity[i];
+        if(!activity) continue;
+
+        size_t position = count;
+        while(position > 0 && instance->activity[order[position - 1]] < activity) {
+            position--;
+        }
+        if(position >= SWEEP_HOT_MAX) continue;
+
+        if(count < SWEEP_HOT_MAX) count++;
+        for(size_t j = count - 1; j > position; j--) {
+            order[j] = order[j - 1];
+        }
+        order[position] = i;
+    }
+    size_t hot_count = count;
+    for(size_t i = 0; i < hot_count; i++) {
+        advance[i] = 0;
+    }
+
+    for(size_t i = 0; i < instance->count && *cold_count < SWEEP_COLD_SLICE; i++) {
+        size_t index = (instance->cold_cursor + i) % instance->count;
+        bool hot = false;
+        for(size_t j = 0; j < hot_count; j++) {
+            if(order[j] == index) hot = true;
+        }
+        if(hot) continue;
+        order[count] = index;
+        // Active ones on the way are visited anyway
+        advance[count] = i + 1;
+        count++;
+        (*cold_count)++;
+    }
+
+    // Busy active frequency stops the cycle early, so it must not starve the others
+    if(*cold_count && hot_count) {
+        size_t first = order[hot_count];
+        size_t first_advance = advance[hot_count];
+        memmove(&order[1], &order[0], sizeof(size_t) * hot_count);
+        memmove(&advance[1], &advance[0], sizeof(size_t) * hot_count);
+        order[0] = first;
+        advance[0] = first_advance;
+    }
+
+    return count;
+}
+
+static void subghz_frequency_analyzer_sweep_fine(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    FrequencyRSSI* result) {
+    uint32_t center = result->frequency_coarse;
+    uint32_t frequency;
+    float rssi;
+
+    instance->radio->set_fine(instance->context, true);
+
+    if(!instance->adaptive) {
+        for(uint32_t i = center - SWEEP_FINE_SPAN; i < center + SWEEP_FINE_SPAN;
+            i += SWEEP_FINE_STEP) {
+            frequency = i;
+            rssi = subghz_frequency_analyzer_sweep_measure(instance, &frequency);
+            if(result->rssi_fine < rssi) {
+                result->rssi_fine = rssi;
+                result->frequency_fine = frequency;
+            }
+        }
+        return;
+    }
+
+    // Golden-section search for RSSI peak, keeps the best measured point
+    uint32_t a = center - SWEEP_FINE_SPAN;
+    uint32_t b = center + SWEEP_FINE_SPAN;
+    uint32_t x[2] = {
+        a + (uint32_t)((b - a) * SWEEP_GOLDEN_RATIO),
+        b - (uint32_t)((b - a) * SWEEP_GOLDEN_RATIO),
+    };
+    float value[2];
+    for(size_t i = 0; i < 2; i++) {
+        frequency = x[i];
+        value[i] = subghz_frequency_analyzer_sweep_measure(instance, &frequency);
+        if(result->rssi_fine < value[i]) {
+            result->rssi_fine = value[i];
+            result->frequency_fine = frequency;
+        }
+    }
+
+    while(b - a > SWEEP_FINE_STEP) {
+        size_t next;
+        if(value[0] > value[1]) {
+            b = x[1];
+            x[1] = x[0];
+            value[1] = value[0];
+            x[0] = a + (uint32_t)((b - a) * SWEEP_GOLDEN_RATIO);
+            next = 0;
+        } else {
+            a = x[0];
+            x[0] = x[1];
+            value[0] = value[1];
+            x[1] = b - (uint32_t)((b - a) * SWEEP_GOLDEN_RATIO);
+            next = 1;
+        }
+
+        frequency = x[next];
+        value[next] = subghz_frequency_analyzer_sweep_measure(instance, &frequency);
+        if(result->rssi_fine < value[next]) {
+            result->rssi_fine = value[next];
+            result->frequency_fine = frequency;
+        }
+    }
+}
+
+void subghz_frequency_analyzer_sweep_run(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    float trigger_level,
+    FrequencyRSSI* result) {
+    furi_assert(instance);
+    furi_assert(result);
+
+    result->frequency_coarse = 0;
+    result->rssi_coarse = SWEEP_RSSI_NONE;
+    result->frequency_fine = 0;
+    result->rssi_fine = SWEEP_RSSI_NONE;
+    if(!instance->count) return;
+
+    size_t order[SWEEP_HOT_MAX + SWEEP_COLD_SLICE];
+    size_t advance[SWEEP_HOT_MAX + SWEEP_COLD_SLICE];
+    size_t* schedule = instance->adaptive ? order : malloc(sizeof(size_t) * instance->count);
+    size_t cold_count;
+    size_t count =
+        subghz_frequency_analyzer_sweep_schedule(instance, schedule, advance, &cold_count);
+    size_t coarse_index = 0;
+    size_t cursor_advance = 0;
+    bool stopped = false;
+
+    // First stage: coarse scan
+    instance->radio->set_fine(instance->context, false);
+    for(size_t i = 0; i < count; i++) {
+        uint32_t frequency = instance->frequency[schedule[i]];
+        float rssi = subghz_frequency_analyzer_sweep_measure(instance, &frequency);
+        if(result->rssi_coarse < rssi) {
+            result->rssi_coarse = rssi;
+            result->frequency_coarse = frequency;
+            coarse_index = schedule[i];
+        }
+        if(!instance->adaptive) continue;
+        cursor_advance = MAX(cursor_advance, advance[i]);
+        // Burst may be short, don't spend time on the rest
+        if(rssi > trigger_level) {
+            stopped = true;
+            break;
+        }
+    }
+
+    // Trigger may come from neighbour of real frequency, find the strongest around
+    if(instance->adaptive && result->rssi_coarse > trigger_level) {
+        uint32_t center = instance->frequency[coarse_index];
+        for(size_t i = 0; i < instance->count; i++) {
+            uint32_t frequency = instance->frequency[i];
+            if(i == coarse_index || frequency + SWEEP_NEIGHBOUR_SPAN < center ||
+               frequency > center + SWEEP_NEIGHBOUR_SPAN) {
+                continue;
+            }
+            float rssi = subghz_frequency_analyzer_sweep_measure(instance, &frequency);
+            if(result->rssi_coarse < rssi) {
+                result->rssi_coarse = rssi;
+                result->frequency_coarse = frequency;
+                coarse_index = i;
+            }
+        }
+    }
+
+    if(instance->adaptive) {
+        // Frequencies not visited because of early stop go first next time
+        size_t cursor = instance->cold_cursor + cursor_advance;
+        // All frequencies are active: every complete cycle is a full pass
+        bool full_pass = !cold_count && !stopped;
+        if(cursor >= instance->count || full_pass) {
+            // Full pass done: activity fades
+            for(size_t i = 0; i < instance->count; i++) {
+                instance->activity[i] -= (instance->activity[i] + 7) / 8;
+            }
+        }
+        instance->cold_cursor = cursor % instance->count;
+    } else {
+        free(schedule);
+    }
+
+    // Second stage: fine scan
+    if(result->rssi_coarse > trigger_level) {
+        uint8_t* activity = &instance->activity[coarse_index];
+        *activity = MIN(SWEEP_ACTIVITY_MAX, *activity + SWEEP_ACTIVITY_HIT);
+
+        subghz_frequency_analyzer_sweep_fine(instance, result);
+    }
+}
+
+size_t subghz_frequency_analyzer_sweep_get_count(SubGhzFrequencyAnalyzerSweep* instance) {
+    furi_assert(instance);
+    return instance->count;
+}
+
+uint32_t subghz_frequency_analyzer_sweep_get_frequency(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->count);
+    return instance->frequency[index];
+}
+
+uint8_t subghz_frequency_analyzer_sweep_get_activity(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->count);
+    return instance->activity[index];
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/** Frequency analyzer sweep scheduler
+ *
+ * Hardware independent: radio is driven through SubGhzFrequencyAnalyzerSweepRadio,
+ * so the same code runs against a simulated radio on host.
+ *
+ * Adaptive mode visits recently active frequencies every cycle and a slice of the
+ * rest, stops the coarse pass at the first frequency over trigger, waits only until
+ * RSSI settles and finds the peak with golden-section search. Legacy mode is the
+ * original full linear sweep with fixed dwell.
+ */
+
+typedef struct SubGhzFrequencyAnalyzerSweep SubGhzFrequencyAnalyzerSweep;
+
+typedef struct {
+    uint32_t frequency_coarse;
+    float rssi_coarse;
+    uint32_t frequency_fine;
+    float rssi_fine;
+} FrequencyRSSI;
+
+typedef struct {
+    /** Switch to wide (coarse) or narrow (fine) RX filter */
+    void (*set_fine)(void* context, bool fine);
+    /** Check frequency is supported by radio */
+    bool (*is_frequency_valid)(void* context, uint32_t frequency);
+    /** Tune and start RX, returns real frequency */
+    uint32_t (*tune)(void* context, uint32_t frequency);
+    /** Current RSSI, dBm */
+    float (*get_rssi)(void* context);
+    void (*delay_us)(void* context, uint32_t us);
+} SubGhzFrequencyAnalyzerSweepRadio;
+
+/** Allocate sweep
+ *
+ * @param      radio     radio operations
+ * @param      context   radio context
+ * @param      capacity  max frequency count
+ *
+ * @return     SubGhzFrequencyAnalyzerSweep instance
+ */
+SubGhzFrequencyAnalyzerSweep* subghz_frequency_analyzer_sweep_alloc(
+    const SubGhzFrequencyAnalyzerSweepRadio* radio,
+    void* context,
+    size_t capacity);
+
+void subghz_frequency_analyzer_sweep_free(SubGhzFrequencyAnalyzerSweep* instance);
+
+/** Add frequency to coarse list
+ *
+ * @param      instance   SubGhzFrequencyAnalyzerSweep instance
+ * @param      frequency  frequency, Hz
+ */
+void subghz_frequency_analyzer_sweep_add_frequency(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    uint32_t frequency);
+
+/** Select adaptive (default) or legacy scheduling
+ *
+ * @param      instance  SubGhzFrequencyAnalyzerSweep instance
+ * @param      adaptive  true for adaptive
+ */
+void subghz_frequency_analyzer_sweep_set_adaptive(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    bool adaptive);
+
+/** Run one sweep cycle
+ *
+ * Fine result is filled only when coarse RSSI is over trigger, otherwise it is
+ * -127 dBm.
+ *
+ * @param      instance       SubGhzFrequencyAnalyzerSweep instance
+ * @param      trigger_level  RSSI trigger, dBm
+ * @param      result         strongest coarse and fine frequencies
+ */
+void subghz_frequency_analyzer_sweep_run(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    float trigger_level,
+    FrequencyRSSI* result);
+
+size_t subghz_frequency_analyzer_sweep_get_count(SubGhzFrequencyAnalyzerSweep* instance);
+
+uint32_t subghz_frequency_analyzer_sweep_get_frequency(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index);
+
+/** Get activity of coarse frequency
+ *
+ * Grows on every trigger on the frequency, decays with every full pass.
+ *
+ * @param      instance  SubGhzFrequencyAnalyzerSweep instance
+ * @param      index     frequency index
+ *
+ * @return     activity, 0 - never or long ago, 255 - most active
+ */
+uint8_t subghz_frequency_analyzer_sweep_get_activity(
+    SubGhzFrequencyAnalyzerSweep* instance,
+    size_t index);
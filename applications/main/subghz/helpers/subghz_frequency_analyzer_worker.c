@@ -27,6 +27,7 @@ struct SubGhzFrequencyAnalyzerWorker {
     uint8_t sample_hold_counter;
     FrequencyRSSI frequency_rssi_buf;
     SubGhzSetting* setting;
+    SubGhzFrequencyAnalyzerSweep* sweep;
 
     const SubGhzDevice* radio_device;
     FuriHalSpiBusHandle* spi_bus;
@@ -67,6 +68,81 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+static void subghz_frequency_analyzer_worker_radio_set_fine(void* context, bool fine) {
+    SubGhzFrequencyAnalyzerWorker* instance = context;
+    // furi_hal_subghz_idle();
+    subghz_devices_idle(instance->radio_device);
+    subghz_frequency_analyzer_worker_load_registers(
+        instance->spi_bus, fine ? subghz_preset_ook_58khz : subghz_preset_ook_650khz);
+}
+
+static bool
+    subghz_frequency_analyzer_worker_radio_is_frequency_valid(void* context, uint32_t frequency) {
+    SubGhzFrequencyAnalyzerWorker* instance = context;
+    // return furi_hal_subghz_is_frequency_valid(frequency);
+    return subghz_devices_is_frequency_valid(instance->radio_device, frequency);
+}
+
+static uint32_t subghz_frequency_analyzer_worker_radio_tune(void* context, uint32_t frequency) {
+    SubGhzFrequencyAnalyzerWorker* instance = context;
+    FuriHalSpiBusHandle* spi_bus = instance->spi_bus;
+    CC1101Status status;
+
+    furi_hal_spi_acquire(spi_bus);
+    cc1101_switch_to_idle(spi_bus);
+    frequency = cc1101_set_frequency(spi_bus, frequency);
+
+    cc1101_calibrate(spi_bus);
+    do {
+        status = cc1101_get_status(spi_bus);
+    } while(status.STATE != CC1101StateIDLE);
+
+    cc1101_switch_to_rx(spi_bus);
+    furi_hal_spi_release(spi_bus);
+
+    return frequency;
+}
+
+static float subghz_frequency_analyzer_worker_radio_get_rssi(void* context) {
+    SubGhzFrequencyAnalyzerWorker* instance = context;
+    // return furi_hal_subghz_get_rssi();
+    return subghz_devices_get_rssi(instance->radio_device);
+}
+
+static void subghz_frequency_analyzer_worker_radio_delay_us(void* context, uint32_t us) {
+    UNUSED(context);
+    furi_delay_us(us);
+}
+
+static const SubGhzFrequencyAnalyzerSweepRadio subghz_frequency_analyzer_worker_radio = {
+    .set_fine = subghz_frequency_analyzer_worker_radio_set_fine,
+    .is_frequency_valid = subghz_frequency_analyzer_worker_radio_is_frequency_valid,
+    .tune = subghz_frequency_analyzer_worker_radio_tune,
+    .get_rssi = subghz_frequency_analyzer_worker_radio_get_rssi,
+    .delay_us = subghz_frequency_analyzer_worker_radio_delay_us,
+};
+
+static SubGhzFrequencyAnalyzerSweep*
+    subghz_frequency_analyzer_worker_sweep_alloc(SubGhzFrequencyAnalyzerWorker* instance) {
+    size_t count = subghz_setting_get_frequency_count(instance->setting);
+    SubGhzFrequencyAnalyzerSweep* sweep = subghz_frequency_analyzer_sweep_alloc(
+        &subghz_frequency_analyzer_worker_radio, instance, count);
+
+    for(size_t i = 0; i < count; i++) {
+        uint32_t current_frequency = subghz_setting_get_frequency(instance->setting, i);
+        if(subghz_devices_is_frequency_valid(instance->radio_device, current_frequency) &&
+           (current_frequency != 467750000) && (current_frequency != 464000000) &&
+           !((instance->ext_radio) &&
+             ((current_frequency == 390000000) || (current_frequency == 312000000) ||
+              (current_frequency == 312100000) || (current_frequency == 312200000) ||
+              (current_frequency == 440175000)))) {
+            subghz_frequency_analyzer_sweep_add_frequency(sweep, current_frequency);
+        }
+    }
+
+    return sweep;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -77,11 +153,8 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     FrequencyRSSI frequency_rssi = {
         .frequency_coarse = 0, .rssi_coarse = 0, .frequency_fine = 0, .rssi_fine = 0};
-    float rssi = 0;
-    uint32_t frequency = 0;
     float rssi_temp = 0;
     uint32_t frequency_temp = 0;
-    CC1101Status status;
 
     FuriHalSpiBusHandle* spi_bus = instance->spi_bus;
     const SubGhzDevice* radio_device = instance->radio_device;
@@ -115,103 +188,22 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
 
     furi_hal_subghz_set_path(FuriHalSubGhzPathIsolate);
 
+    instance->sweep = subghz_frequency_analyzer_worker_sweep_alloc(instance);
+
     while(instance->worker_running) {
         furi_delay_ms(10);
 
-        float rssi_min = 26.0f;
-        float rssi_avg = 0;
-        size_t rssi_avg_samples = 0;
-
-        frequency_rssi.rssi_coarse = -127.0f;
-        frequency_rssi.rssi_fine = -127.0f;
-        // furi_hal_subghz_idle();
-        subghz_devices_idle(radio_device);
-        subghz_frequency_analyzer_worker_load_registers(spi_bus, subghz_preset_ook_650khz);
-
-        // First stage: coarse scan
-        for(size_t i = 0; i < subghz_setting_get_frequency_count(instance->setting); i++) {
-            uint32_t current_frequency = subghz_setting_get_frequency(instance->setting, i);
-            // if(furi_hal_subghz_is_frequency_valid(current_frequency) &&
-            if(subghz_devices_is_frequency_valid(radio_device, current_frequency) &&
-               (current_frequency != 467750000) && (current_frequency != 464000000) &&
-               !((instance->ext_radio) &&
-                 ((current_frequency == 390000000) || (current_frequency == 312000000) ||
-                  (current_frequency == 312100000) || (current_frequency == 312200000) ||
-                  (current_frequency == 440175000)))) {
-                furi_hal_spi_acquire(spi_bus);
-                cc1101_switch_to_idle(spi_bus);
-                frequency = cc1101_set_frequency(spi_bus, current_frequency);
-
-                cc1101_calibrate(spi_bus);
-                do {
-                    status = cc1101_get_status(spi_bus);
-                } while(status.STATE != CC1101StateIDLE);
-
-                cc1101_switch_to_rx(spi_bus);
-                furi_hal_spi_release(spi_bus);
-
-                furi_delay_ms(2);
-
-                // rssi = furi_hal_subghz_get_rssi();
-                rssi = subghz_devices_get_rssi(radio_device);
-
-                rssi_avg += rssi;
-                rssi_avg_samples++;
-
-                if(rssi < rssi_min) rssi_min = rssi;
-
-                if(frequency_rssi.rssi_coarse < rssi) {
-                    frequency_rssi.rssi_coarse = rssi;
-                    frequency_rssi.frequency_coarse = frequency;
-                }
-            }
-        }
+        // Both stages: coarse scan, fine scan around the strongest frequency over trigger
+        subghz_frequency_analyzer_sweep_run(
+            instance->sweep, instance->trigger_level, &frequency_rssi);
 
         FURI_LOG_T(
             TAG,
-            "RSSI: avg %f, max %f at %lu, min %f",
-            (double)(rssi_avg / rssi_avg_samples),
+            "RSSI: max %f at %lu, fine %f at %lu",
             (double)frequency_rssi.rssi_coarse,
             frequency_rssi.frequency_coarse,
-            (double)rssi_min);
-
-        // Second stage: fine scan
-        if(frequency_rssi.rssi_coarse > instance->trigger_level) {
-            // furi_hal_subghz_idle();
-            subghz_devices_idle(radio_device);
-            subghz_frequency_analyzer_worker_load_registers(spi_bus, subghz_preset_ook_58khz);
-            //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
-                // if(furi_hal_subghz_is_frequency_valid(i)) {
-                if(subghz_devices_is_frequency_valid(radio_device, i)) {
-                    furi_hal_spi_acquire(spi_bus);
-                    cc1101_switch_to_idle(spi_bus);
-                    frequency = cc1101_set_frequency(spi_bus, i);
-
-                    cc1101_calibrate(spi_bus);
-                    do {
-                        status = cc1101_get_status(spi_bus);
-                    } while(status.STATE != CC1101StateIDLE);
-
-                    cc1101_switch_to_rx(spi_bus);
-                    furi_hal_spi_release(spi_bus);
-
-                    furi_delay_ms(2);
-
-                    // rssi = furi_hal_subghz_get_rssi();
-                    rssi = subghz_devices_get_rssi(radio_device);
-
-                    FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
-
-                    if(frequency_rssi.rssi_fine < rssi) {
-                        frequency_rssi.rssi_fine = rssi;
-                        frequency_rssi.frequency_fine = frequency;
-                    }
-                }
-            }
-        }
+            (double)frequency_rssi.rssi_fine,
+            frequency_rssi.frequency_fine);
 
         // Deliver results fine
         if(frequency_rssi.rssi_fine > instance->trigger_level) {
@@ -283,6 +275,9 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
     subghz_devices_idle(radio_device);
     subghz_devices_sleep(radio_device);
 
+    subghz_frequency_analyzer_sweep_free(instance->sweep);
+    instance->sweep = NULL;
+
     return 0;
 }
 
@@ -368,3 +363,25 @@ void subghz_frequency_analyzer_worker_set_trigger_level(
 float subghz_frequency_analyzer_worker_get_trigger_level(SubGhzFrequencyAnalyzerWorker* instance) {
     return instance->trigger_level;
 }
+
+size_t subghz_frequency_analyzer_worker_get_activity(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint8_t* activity,
+    size_t size) {
+    furi_assert(instance);
+    furi_assert(activity);
+    SubGhzFrequencyAnalyzerSweep* sweep = instance->sweep;
+    if(!sweep || !size) return 0;
+
+    size_t count = subghz_frequency_analyzer_sweep_get_count(sweep);
+    if(count < size) size = count;
+
+    // Buckets keep frequency order, each shows its most active frequency
+    memset(activity, 0, size);
+    for(size_t i = 0; i < count; i++) {
+        size_t bucket = i * size / count;
+        uint8_t value = subghz_frequency_analyzer_sweep_get_activity(sweep, i);
+        if(activity[bucket] < value) activity[bucket] = value;
+    }
+    return size;
+}
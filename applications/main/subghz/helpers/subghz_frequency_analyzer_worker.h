@@ -2,6 +2,7 @@
 
 #include <furi_hal.h>
 #include "../subghz_i.h"
+#include "subghz_frequency_analyzer_sweep.h"
 
 typedef struct SubGhzFrequencyAnalyzerWorker SubGhzFrequencyAnalyzerWorker;
 
@@ -11,13 +12,6 @@ typedef void (*SubGhzFrequencyAnalyzerWorkerPairCallback)(
     float rssi,
     bool signal);
 
-typedef struct {
-    uint32_t frequency_coarse;
-    float rssi_coarse;
-    uint32_t frequency_fine;
-    float rssi_fine;
-} FrequencyRSSI;
-
 /** Allocate SubGhzFrequencyAnalyzerWorker
  * 
  * @param context SubGhz* context
@@ -77,4 +71,17 @@ void subghz_frequency_analyzer_worker_set_trigger_level(
  * @param instance SubGhzFrequencyAnalyzerWorker instance
  * @return RSSI trigger level
  */
-float subghz_frequency_analyzer_worker_get_trigger_level(SubGhzFrequencyAnalyzerWorker* instance);
\ No newline at end of file
+float subghz_frequency_analyzer_worker_get_trigger_level(SubGhzFrequencyAnalyzerWorker* instance);
+
+/** Get per-frequency activity, coarse list is downsampled to size buckets
+ * Must be called from pair callback, sweep lives in worker thread.
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param activity buffer, 0 - idle, 255 - most active
+ * @param size buffer size
+ * @return bucket count filled
+ */
+size_t subghz_frequency_analyzer_worker_get_activity(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    uint8_t* activity,
+    size_t size);
@@ -0,0 +1,228 @@
+#include "subghz_hopper.h"
+
+#include <furi.h>
+
+#define TAG "SubGhzHopper"
+
+// Activity units: RSSI hold is a weak hint, decoded message is a strong one
+#define SUBGHZ_HOPPER_ACTIVITY_RSSI 32
+#define SUBGHZ_HOPPER_ACTIVITY_HIT 128
+#define SUBGHZ_HOPPER_ACTIVITY_MAX 1024
+// Every hop activity loses 1/256, half-life is ~180 hops, tens of seconds
+#define SUBGHZ_HOPPER_ACTIVITY_DECAY_SHIFT 8
+
+// Share of visits: 1 for quiet frequency, up to 9 for busy one
+#define SUBGHZ_HOPPER_WEIGHT_UNIT 128
+#define SUBGHZ_HOPPER_WEIGHT_PINNED 4
+// Ticks per visit: 1 for quiet frequency, up to 5 for busy one
+#define SUBGHZ_HOPPER_DWELL_UNIT 256
+#define SUBGHZ_HOPPER_DWELL_PINNED 2
+
+// Signal on current frequency holds it, a second at scene tick rate
+#define SUBGHZ_HOPPER_RSSI_THRESHOLD (-90.0f)
+#define SUBGHZ_HOPPER_HOLD_TICKS 10
+
+typedef struct {
+    uint32_t frequency;
+    bool pinned;
+    uint16_t activity;
+    int32_t credit;
+    uint32_t hits;
+    // Decoded on worker thread, folded into activity by subghz_hopper_next()
+    uint32_t hits_pending;
+} SubGhzHopperItem;
+
+struct SubGhzHopper {
+    SubGhzHopperItem* items;
+    size_t count;
+    size_t capacity;
+    bool adaptive;
+
+    size_t current;
+    uint8_t ticks_left;
+    bool holding;
+    uint8_t hold_ticks;
+};
+
+SubGhzHopper* subghz_hopper_alloc(size_t capacity) {
+    SubGhzHopper* instance = malloc(sizeof(SubGhzHopper));
+    instance->items = malloc(sizeof(SubGhzHopperItem) * capacity);
+    instance->capacity = capacity;
+    instance->adaptive = true;
+    instance->ticks_left = 1;
+    return instance;
+}
+
+void subghz_hopper_free(SubGhzHopper* instance) {
+    furi_assert(instance);
+    free(instance->items);
+    free(instance);
+}
+
+void subghz_hopper_add_frequency(SubGhzHopper* instance, uint32_t frequency, bool pinned) {
+    furi_assert(instance);
+    furi_check(instance->count < instance->capacity);
+
+    SubGhzHopperItem* item = &instance->items[instance->count++];
+    memset(item, 0, sizeof(SubGhzHopperItem));
+    item->frequency = frequency;
+    item->pinned = pinned;
+}
+
+void subghz_hopper_set_adaptive(SubGhzHopper* instance, bool adaptive) {
+    furi_assert(instance);
+    instance->adaptive = adaptive;
+}
+
+static int32_t subghz_hopper_get_weight(const SubGhzHopperItem* item) {
+    int32_t weight = 1 + item->activity / SUBGHZ_HOPPER_WEIGHT_UNIT;
+    if(item->pinned) weight += SUBGHZ_HOPPER_WEIGHT_PINNED;
+    return weight;
+}
+
+static uint8_t subghz_hopper_get_dwell(const SubGhzHopperItem* item) {
+    uint8_t dwell = 1 + item->activity / SUBGHZ_HOPPER_DWELL_UNIT;
+    if(item->pinned) dwell = MAX(dwell, SUBGHZ_HOPPER_DWELL_PINNED);
+    return dwell;
+}
+
+static void subghz_hopper_add(SubGhzHopper* instance, size_t index, uint16_t activity) {
+    SubGhzHopperItem* item = &instance->items[index];
+    item->activity = MIN(SUBGHZ_HOPPER_ACTIVITY_MAX, item->activity + activity);
+}
+
+static void subghz_hopper_collect_hits(SubGhzHopper* instance) {
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzHopperItem* item = &instance->items[i];
+        uint32_t hits = __atomic_exchange_n(&item->hits_pending, 0, __ATOMIC_RELAXED);
+        if(!hits) continue;
+        item->hits += hits;
+        subghz_hopper_add(
+            instance, i, MIN(SUBGHZ_HOPPER_ACTIVITY_MAX, hits * SUBGHZ_HOPPER_ACTIVITY_HIT));
+    }
+}
+
+void subghz_hopper_next(SubGhzHopper* instance) {
+    furi_assert(instance);
+    if(!instance->count) return;
+
+    subghz_hopper_collect_hits(instance);
+
+    if(!instance->adaptive) {
+        __atomic_store_n(
+            &instance->current, (instance->current + 1) % instance->count, __ATOMIC_RELAXED);
+        instance->ticks_left = 1;
+        return;
+    }
+
+    // Smooth weighted round-robin: every frequency is visited, busy ones more often,
+    // visits of one frequency are spread evenly
+    int32_t total = 0;
+    size_t next = instance->current;
+    for(size_t i = 0; i < instance->count; i++) {
+        // Start after current, ties go to the next in list order
+        size_t index = (instance->current + 1 + i) % instance->count;
+        SubGhzHopperItem* item = &instance->items[index];
+        int32_t weight = subghz_hopper_get_weight(item);
+        total += weight;
+        item->credit += weight;
+        if(item->credit > instance->items[next].credit || i == 0) next = index;
+    }
+    instance->items[next].credit -= total;
+
+    for(size_t i = 0; i < instance->count; i++) {
+        SubGhzHopperItem* item = &instance->items[i];
+        item->activity -=
+            (item->activity + (1 << SUBGHZ_HOPPER_ACTIVITY_DECAY_SHIFT) - 1) >>
+            SUBGHZ_HOPPER_ACTIVITY_DECAY_SHIFT;
+    }
+
+    __atomic_store_n(&instance->current, next, __ATOMIC_RELAXED);
+    instance->ticks_left = subghz_hopper_get_dwell(&instance->items[next]);
+}
+
+bool subghz_hopper_tick(SubGhzHopper* instance) {
+    furi_assert(instance);
+    if(!instance->count) return false;
+
+    if(instance->ticks_left > 1) {
+        instance->ticks_left--;
+        return false;
+    }
+
+    size_t current = instance->current;
+    subghz_hopper_next(instance);
+    return instance->current != current;
+}
+
+bool subghz_hopper_update(SubGhzHopper* instance, float rssi) {
+    furi_assert(instance);
+
+    if(instance->holding) {
+        if(instance->hold_ticks) {
+            instance->hold_ticks--;
+            return false;
+        }
+        instance->holding = false;
+        subghz_hopper_next(instance);
+        return true;
+    }
+
+    if(rssi > SUBGHZ_HOPPER_RSSI_THRESHOLD) {
+        subghz_hopper_add_activity(instance);
+        instance->holding = true;
+        instance->hold_ticks = SUBGHZ_HOPPER_HOLD_TICKS;
+        return false;
+    }
+
+    return subghz_hopper_tick(instance);
+}
+
+bool subghz_hopper_is_holding(SubGhzHopper* instance) {
+    furi_assert(instance);
+    return instance->holding;
+}
+
+void subghz_hopper_add_activity(SubGhzHopper* instance) {
+    furi_assert(instance);
+    if(!instance->count) return;
+    subghz_hopper_add(instance, instance->current, SUBGHZ_HOPPER_ACTIVITY_RSSI);
+}
+
+void subghz_hopper_add_hit(SubGhzHopper* instance) {
+    furi_assert(instance);
+    if(!instance->count) return;
+    // Only counter is touched here, activity and schedule belong to the caller of next()
+    size_t current = __atomic_load_n(&instance->current, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&instance->items[current].hits_pending, 1, __ATOMIC_RELAXED);
+}
+
+uint32_t subghz_hopper_get_current_frequency(SubGhzHopper* instance) {
+    furi_assert(instance);
+    if(!instance->count) return 0;
+    return instance->items[instance->current].frequency;
+}
+
+size_t subghz_hopper_get_count(SubGhzHopper* instance) {
+    furi_assert(instance);
+    return instance->count;
+}
+
+uint32_t subghz_hopper_get_frequency(SubGhzHopper* instance, size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->count);
+    return instance->items[index].frequency;
+}
+
+bool subghz_hopper_is_pinned(SubGhzHopper* instance, size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->count);
+    return instance->items[index].pinned;
+}
+
+uint32_t subghz_hopper_get_hit_count(SubGhzHopper* instance, size_t index) {
+    furi_assert(instance);
+    furi_assert(index < instance->count);
+    const SubGhzHopperItem* item = &instance->items[index];
+    return item->hits + __atomic_load_n(&item->hits_pending, __ATOMIC_RELAXED);
+}
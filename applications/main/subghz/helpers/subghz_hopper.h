@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/** Frequency hopper scheduler
+ *
+ * Decides which hopper frequency to listen to and for how many ticks. Radio is
+ * not touched here: caller retunes when subghz_hopper_tick() says so.
+ *
+ * Adaptive mode keeps decayed activity per frequency, fed by RSSI holds and decoded
+ * messages. Busy frequencies are visited more often and listened to longer, quiet
+ * ones are still visited. Pinned frequencies always get extra share. Round-robin
+ * mode is the original hopper: one tick per frequency, list order.
+ */
+
+typedef struct SubGhzHopper SubGhzHopper;
+
+/** Allocate hopper
+ *
+ * @param      capacity  max frequency count
+ *
+ * @return     SubGhzHopper instance
+ */
+SubGhzHopper* subghz_hopper_alloc(size_t capacity);
+
+void subghz_hopper_free(SubGhzHopper* instance);
+
+/** Add frequency to hop list
+ *
+ * @param      instance   SubGhzHopper instance
+ * @param      frequency  frequency, Hz
+ * @param      pinned     pinned by user
+ */
+void subghz_hopper_add_frequency(SubGhzHopper* instance, uint32_t frequency, bool pinned);
+
+/** Select adaptive (default) or round-robin scheduling
+ *
+ * @param      instance  SubGhzHopper instance
+ * @param      adaptive  true for adaptive
+ */
+void subghz_hopper_set_adaptive(SubGhzHopper* instance, bool adaptive);
+
+/** Count one tick on current frequency
+ *
+ * @param      instance  SubGhzHopper instance
+ *
+ * @return     true if current frequency changed, caller must retune
+ */
+bool subghz_hopper_tick(SubGhzHopper* instance);
+
+/** Move to next frequency now
+ *
+ * @param      instance  SubGhzHopper instance
+ */
+void subghz_hopper_next(SubGhzHopper* instance);
+
+/** Receiver tick: hold current frequency on RSSI, otherwise count a tick
+ *
+ * RSSI over threshold counts as activity and holds current frequency for a
+ * few ticks, then hopper moves to the next one. Without it same as
+ * subghz_hopper_tick().
+ *
+ * @param      instance  SubGhzHopper instance
+ * @param      rssi      RSSI on current frequency, dBm. Not used while holding
+ *
+ * @return     true if caller must retune
+ */
+bool subghz_hopper_update(SubGhzHopper* instance, float rssi);
+
+/** Current frequency is held after RSSI over threshold
+ *
+ * @param      instance  SubGhzHopper instance
+ *
+ * @return     true if holding, next subghz_hopper_update() doesn't need RSSI
+ */
+bool subghz_hopper_is_holding(SubGhzHopper* instance);
+
+/** RSSI over threshold on current frequency
+ *
+ * @param      instance  SubGhzHopper instance
+ */
+void subghz_hopper_add_activity(SubGhzHopper* instance);
+
+/** Message decoded on current frequency
+ *
+ * Safe to call from worker thread, all other calls must come from one thread.
+ * Hit raises activity on next subghz_hopper_next().
+ *
+ * @param      instance  SubGhzHopper instance
+ */
+void subghz_hopper_add_hit(SubGhzHopper* instance);
+
+/** Get current frequency
+ *
+ * @param      instance  SubGhzHopper instance
+ *
+ * @return     frequency, Hz, 0 if list is empty
+ */
+uint32_t subghz_hopper_get_current_frequency(SubGhzHopper* instance);
+
+size_t subghz_hopper_get_count(SubGhzHopper* instance);
+
+uint32_t subghz_hopper_get_frequency(SubGhzHopper* instance, size_t index);
+
+bool subghz_hopper_is_pinned(SubGhzHopper* instance, size_t index);
+
+/** Get decoded message count on frequency since alloc
+ *
+ * @param      instance  SubGhzHopper instance
+ * @param      index     frequency index
+ *
+ * @return     hit count
+ */
+uint32_t subghz_hopper_get_hit_count(SubGhzHopper* instance, size_t index);
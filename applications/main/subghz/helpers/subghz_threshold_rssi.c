@@ -1,6 +1,5 @@
 #include "subghz_threshold_rssi.h"
 #include <float_tools.h>
-#include "../subghz_i.h"
 
 #define TAG "SubGhzThresholdRssi"
 #define THRESHOLD_RSSI_LOW_COUNT 10
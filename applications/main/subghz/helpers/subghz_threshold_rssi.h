@@ -2,6 +2,9 @@
 
 #include <furi.h>
 
+/** Lowest threshold, RSSI is always above it */
+#define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
+
 typedef struct {
     float rssi; /**< Current RSSI */
     bool is_above; /**< Exceeded threshold level */
@@ -23,10 +23,23 @@ static void subghz_txrx_radio_device_power_off(SubGhzTxRx* instance) {
     if(furi_hal_power_is_otg_enabled()) furi_hal_power_disable_otg();
 }
 
+static SubGhzHopper* subghz_txrx_hopper_alloc(SubGhzSetting* setting) {
+    size_t count = subghz_setting_get_hopper_frequency_count(setting);
+    SubGhzHopper* hopper = subghz_hopper_alloc(count);
+    for(size_t i = 0; i < count; i++) {
+        subghz_hopper_add_frequency(
+            hopper,
+            subghz_setting_get_hopper_frequency(setting, i),
+            subghz_setting_is_hopper_frequency_pinned(setting, i));
+    }
+    return hopper;
+}
+
 SubGhzTxRx* subghz_txrx_alloc() {
     SubGhzTxRx* instance = malloc(sizeof(SubGhzTxRx));
     instance->setting = subghz_setting_alloc();
     subghz_setting_load(instance->setting, EXT_PATH("subghz/assets/setting_user.txt"));
+    instance->hopper = subghz_txrx_hopper_alloc(instance->setting);
 
     instance->preset = malloc(sizeof(SubGhzRadioPreset));
     instance->preset->name = furi_string_alloc();
@@ -86,6 +99,7 @@ void subghz_txrx_free(SubGhzTxRx* instance) {
     subghz_environment_free(instance->environment);
     flipper_format_free(instance->fff_data);
     furi_string_free(instance->preset->name);
+    subghz_hopper_free(instance->hopper);
     subghz_setting_free(instance->setting);
 
     free(instance->preset);
@@ -369,48 +383,29 @@ void subghz_txrx_stop(SubGhzTxRx* instance) {
 void subghz_txrx_hopper_update(SubGhzTxRx* instance) {
     furi_assert(instance);
 
-    switch(instance->hopper_state) {
-    case SubGhzHopperStateOFF:
-    case SubGhzHopperStatePause:
+    if(instance->hopper_state == SubGhzHopperStateOFF ||
+       instance->hopper_state == SubGhzHopperStatePause) {
         return;
-    case SubGhzHopperStateRSSITimeOut:
-        if(instance->hopper_timeout != 0) {
-            instance->hopper_timeout--;
-            return;
-        }
-        break;
-    default:
-        break;
     }
+
     float rssi = -127.0f;
-    if(instance->hopper_state != SubGhzHopperStateRSSITimeOut) {
+    if(!subghz_hopper_is_holding(instance->hopper)) {
         // See RSSI Calculation timings in CC1101 17.3 RSSI
         rssi = subghz_devices_get_rssi(instance->radio_device);
-
-        // Stay if RSSI is high enough
-        if(rssi > -90.0f) {
-            instance->hopper_timeout = 10;
-            instance->hopper_state = SubGhzHopperStateRSSITimeOut;
-            return;
-        }
-    } else {
-        instance->hopper_state = SubGhzHopperStateRunning;
-    }
-    // Select next frequency
-    if(instance->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(instance->setting) - 1) {
-        instance->hopper_idx_frequency++;
-    } else {
-        instance->hopper_idx_frequency = 0;
     }
+    // Stay on signal or if frequency is busy lately
+    bool retune = subghz_hopper_update(instance->hopper, rssi);
+    instance->hopper_state = subghz_hopper_is_holding(instance->hopper) ?
+                                 SubGhzHopperStateRSSITimeOut :
+                                 SubGhzHopperStateRunning;
+    if(!retune) return;
 
     if(instance->txrx_state == SubGhzTxRxStateRx) {
         subghz_txrx_rx_end(instance);
     };
     if(instance->txrx_state == SubGhzTxRxStateIDLE) {
         subghz_receiver_reset(instance->receiver);
-        instance->preset->frequency =
-            subghz_setting_get_hopper_frequency(instance->setting, instance->hopper_idx_frequency);
+        instance->preset->frequency = subghz_hopper_get_current_frequency(instance->hopper);
         subghz_txrx_rx(instance, instance->preset->frequency);
     }
 }
@@ -439,6 +434,18 @@ void subghz_txrx_hopper_pause(SubGhzTxRx* instance) {
     }
 }
 
+void subghz_txrx_hopper_add_hit(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    if(instance->hopper_state != SubGhzHopperStateOFF) {
+        subghz_hopper_add_hit(instance->hopper);
+    }
+}
+
+SubGhzHopper* subghz_txrx_get_hopper(SubGhzTxRx* instance) {
+    furi_assert(instance);
+    return instance->hopper;
+}
+
 void subghz_txrx_speaker_on(SubGhzTxRx* instance) {
     furi_assert(instance);
     if(instance->debug_pin_state) {
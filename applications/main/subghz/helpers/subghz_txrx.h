@@ -1,6 +1,7 @@
 #pragma once
 
 #include "subghz_types.h"
+#include "subghz_hopper.h"
 
 #include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/subghz_setting.h>
@@ -154,6 +155,21 @@ void subghz_txrx_hopper_unpause(SubGhzTxRx* instance);
  */
 void subghz_txrx_hopper_pause(SubGhzTxRx* instance);
 
+/**
+ * Count decoded message on current hopper frequency
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ */
+void subghz_txrx_hopper_add_hit(SubGhzTxRx* instance);
+
+/**
+ * Get hopper scheduler, per-frequency hit counts
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @return SubGhzHopper* 
+ */
+SubGhzHopper* subghz_txrx_get_hopper(SubGhzTxRx* instance);
+
 /**
  * Speaker on
  * 
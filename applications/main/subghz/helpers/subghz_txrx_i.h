@@ -14,8 +14,7 @@ struct SubGhzTxRx {
     SubGhzRadioPreset* preset;
     SubGhzSetting* setting;
 
-    uint8_t hopper_timeout;
-    uint8_t hopper_idx_frequency;
+    SubGhzHopper* hopper;
     bool is_database_loaded;
     SubGhzHopperState hopper_state;
 
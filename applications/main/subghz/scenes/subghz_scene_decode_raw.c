@@ -2,10 +2,9 @@
 #include "../views/receiver.h"
 #include <lib/subghz/protocols/raw.h>
 
-#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_decode_raw_worker.h>
 
 #define TAG "SubGhzDecodeRaw"
-#define SAMPLES_TO_READ_PER_TICK 400
 
 static void subghz_scene_receiver_update_statusbar(void* context) {
     SubGhz* subghz = context;
@@ -44,30 +43,34 @@ static void subghz_scene_add_to_history_callback(
     void* context) {
     furi_assert(context);
     SubGhz* subghz = context;
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-    uint16_t idx = subghz_history_get_item(subghz->history);
     SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
 
     if(subghz_history_add_to_history(subghz->history, decoder_base, &preset)) {
-        furi_string_reset(item_name);
-        furi_string_reset(item_time);
-
         subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-        subghz_history_get_text_item_menu(subghz->history, item_name, idx);
-        subghz_history_get_time_item_menu(subghz->history, item_time, idx);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(item_name),
-            furi_string_get_cstr(item_time),
-            subghz_history_get_type_protocol(subghz->history, idx));
+        subghz_view_receiver_add_item_to_menu(subghz->subghz_receiver);
 
         subghz_scene_receiver_update_statusbar(subghz);
     }
     subghz_receiver_reset(receiver);
-    furi_string_free(item_name);
-    furi_string_free(item_time);
+}
+
+static void subghz_scene_decode_raw_progress_callback(void* context, uint8_t progress) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    char progress_str[8];
+    snprintf(progress_str, sizeof(progress_str), "%03u%%", progress);
+    subghz_view_receiver_add_data_progress(subghz->subghz_receiver, progress_str);
+}
+
+static void subghz_scene_decode_raw_end_callback(void* context, bool completed) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    // Cancelled decoding is stopped by the scene itself
+    if(completed) {
+        view_dispatcher_send_custom_event(
+            subghz->view_dispatcher, SubGhzCustomEventSceneDecodeRawDone);
+    }
 }
 
 bool subghz_scene_decode_raw_start(SubGhz* subghz) {
@@ -91,19 +94,19 @@ bool subghz_scene_decode_raw_start(SubGhz* subghz) {
     if(success) {
         //FURI_LOG_I(TAG, "Listening at \033[0;33m%s\033[0m.", furi_string_get_cstr(file_name));
 
-        subghz->decode_raw_file_worker_encoder = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(
-               subghz->decode_raw_file_worker_encoder,
-               furi_string_get_cstr(file_name),
-               subghz_txrx_radio_device_get_name(subghz->txrx))) {
-            //the worker needs a file in order to open and read part of the file
-            furi_delay_ms(100);
-        } else {
-            success = false;
-        }
+        subghz->decode_raw_worker = subghz_decode_raw_worker_alloc();
+        subghz_decode_raw_worker_set_progress_callback(
+            subghz->decode_raw_worker, subghz_scene_decode_raw_progress_callback, subghz);
+        subghz_decode_raw_worker_set_end_callback(
+            subghz->decode_raw_worker, subghz_scene_decode_raw_end_callback, subghz);
+        success = subghz_decode_raw_worker_start(
+            subghz->decode_raw_worker,
+            subghz_txrx_get_receiver(subghz->txrx),
+            furi_string_get_cstr(file_name));
 
         if(!success) {
-            subghz_file_encoder_worker_free(subghz->decode_raw_file_worker_encoder);
+            subghz_decode_raw_worker_free(subghz->decode_raw_worker);
+            subghz->decode_raw_worker = NULL;
         }
     }
 
@@ -111,48 +114,32 @@ bool subghz_scene_decode_raw_start(SubGhz* subghz) {
     return success;
 }
 
-bool subghz_scene_decode_raw_next(SubGhz* subghz) {
-    LevelDuration level_duration;
-    SubGhzReceiver* receiver = subghz_txrx_get_receiver(subghz->txrx);
-    for(uint32_t read = SAMPLES_TO_READ_PER_TICK; read > 0; --read) {
-        level_duration =
-            subghz_file_encoder_worker_get_level_duration(subghz->decode_raw_file_worker_encoder);
-        if(!level_duration_is_reset(level_duration)) {
-            bool level = level_duration_get_level(level_duration);
-            uint32_t duration = level_duration_get_duration(level_duration);
-            subghz_receiver_decode(receiver, level, duration);
-        } else {
-            scene_manager_set_scene_state(
-                subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateLoaded);
-            subghz->state_notifications = SubGhzNotificationStateIDLE;
-
-            subghz_view_receiver_add_data_progress(subghz->subghz_receiver, "Done!");
-            return false; // No more samples available
-        }
+static void subghz_scene_decode_raw_stop(SubGhz* subghz) {
+    if(subghz->decode_raw_worker) {
+        subghz_decode_raw_worker_stop(subghz->decode_raw_worker);
+        subghz_decode_raw_worker_free(subghz->decode_raw_worker);
+        subghz->decode_raw_worker = NULL;
     }
+}
 
-    // Update progress info
-    FuriString* progress_str = furi_string_alloc();
-    subghz_file_encoder_worker_get_text_progress(
-        subghz->decode_raw_file_worker_encoder, progress_str);
-
-    subghz_view_receiver_add_data_progress(
-        subghz->subghz_receiver, furi_string_get_cstr(progress_str));
-
-    furi_string_free(progress_str);
-
-    return true; // More samples available
+static void subghz_scene_decode_raw_done(SubGhz* subghz) {
+    subghz_scene_decode_raw_stop(subghz);
+    scene_manager_set_scene_state(
+        subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateLoaded);
+    subghz->state_notifications = SubGhzNotificationStateIDLE;
+    subghz_view_receiver_add_data_progress(subghz->subghz_receiver, "Done!");
 }
 
 void subghz_scene_decode_raw_on_enter(void* context) {
     SubGhz* subghz = context;
 
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-
     subghz_view_receiver_set_mode(subghz->subghz_receiver, SubGhzViewReceiverModeFile);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_decode_raw_callback, subghz);
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver,
+        (SubGhzViewReceiverItemCallback)subghz_history_get_menu_item,
+        subghz->history);
 
     subghz_txrx_set_rx_calback(subghz->txrx, subghz_scene_add_to_history_callback, subghz);
 
@@ -170,22 +157,19 @@ void subghz_scene_decode_raw_on_enter(void* context) {
     } else {
         //Load history to receiver
         subghz_view_receiver_exit(subghz->subghz_receiver);
-        for(uint8_t i = 0; i < subghz_history_get_item(subghz->history); i++) {
-            furi_string_reset(item_name);
-            furi_string_reset(item_time);
-            subghz_history_get_text_item_menu(subghz->history, item_name, i);
-            subghz_history_get_time_item_menu(subghz->history, item_time, i);
-            subghz_view_receiver_add_item_to_menu(
-                subghz->subghz_receiver,
-                furi_string_get_cstr(item_name),
-                furi_string_get_cstr(item_time),
-                subghz_history_get_type_protocol(subghz->history, i));
-        }
+        subghz_view_receiver_set_item_count(
+            subghz->subghz_receiver, subghz_history_get_item(subghz->history));
         subghz_view_receiver_set_idx_menu(subghz->subghz_receiver, subghz->idx_menu_chosen);
-    }
 
-    furi_string_free(item_name);
-    furi_string_free(item_time);
+        if(subghz->decode_raw_worker) {
+            // Worker may have finished while the scene was in background
+            if(subghz_decode_raw_worker_is_running(subghz->decode_raw_worker)) {
+                subghz_decode_raw_worker_pause(subghz->decode_raw_worker, false);
+            } else {
+                subghz_scene_decode_raw_done(subghz);
+            }
+        }
+    }
 
     subghz_scene_receiver_update_statusbar(subghz);
 
@@ -202,13 +186,9 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
                 subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateStart);
             subghz->idx_menu_chosen = 0;
 
+            subghz_scene_decode_raw_stop(subghz);
             subghz_txrx_set_rx_calback(subghz->txrx, NULL, subghz);
 
-            if(subghz_file_encoder_worker_is_running(subghz->decode_raw_file_worker_encoder)) {
-                subghz_file_encoder_worker_stop(subghz->decode_raw_file_worker_encoder);
-            }
-            subghz_file_encoder_worker_free(subghz->decode_raw_file_worker_encoder);
-
             subghz->state_notifications = SubGhzNotificationStateIDLE;
             scene_manager_set_scene_state(
                 subghz->scene_manager, SubGhzSceneReadRAW, SubGhzCustomEventManagerNoSet);
@@ -217,6 +197,10 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
             consumed = true;
             break;
         case SubGhzCustomEventViewReceiverOK:
+            // Info scene uses receiver decoders, resumed on return
+            if(subghz->decode_raw_worker) {
+                subghz_decode_raw_worker_pause(subghz->decode_raw_worker, true);
+            }
             subghz->idx_menu_chosen = subghz_view_receiver_get_idx_menu(subghz->subghz_receiver);
             subghz->state_notifications = SubGhzNotificationStateIDLE;
             scene_manager_next_scene(subghz->scene_manager, SubGhzSceneReceiverInfo);
@@ -226,6 +210,10 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
             FURI_LOG_W(TAG, "No config options");
             consumed = true;
             break;
+        case SubGhzCustomEventSceneDecodeRawDone:
+            subghz_scene_decode_raw_done(subghz);
+            consumed = true;
+            break;
         case SubGhzCustomEventViewReceiverOffDisplay:
             notification_message(subghz->notifications, &sequence_display_backlight_off);
             consumed = true;
@@ -245,14 +233,6 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
         default:
             break;
         }
-
-        switch(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW)) {
-        case SubGhzDecodeRawStateLoading:
-            subghz_scene_decode_raw_next(subghz);
-            break;
-        default:
-            break;
-        }
     }
     return consumed;
 }
@@ -101,24 +101,13 @@ static void subghz_scene_add_to_history_callback(
     // The check can be moved to /lib/subghz/receiver.c, but may result in false positives
     if((decoder_base->protocol->flag & subghz->ignore_filter) == 0) {
         SubGhzHistory* history = subghz->history;
-        FuriString* item_name = furi_string_alloc();
-        FuriString* item_time = furi_string_alloc();
-        uint16_t idx = subghz_history_get_item(history);
 
         SubGhzRadioPreset preset = subghz_txrx_get_preset(subghz->txrx);
+        subghz_txrx_hopper_add_hit(subghz->txrx);
         if(subghz_history_add_to_history(history, decoder_base, &preset)) {
-            furi_string_reset(item_name);
-            furi_string_reset(item_time);
-
             subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-            subghz_history_get_text_item_menu(history, item_name, idx);
-            subghz_history_get_time_item_menu(history, item_time, idx);
-            subghz_view_receiver_add_item_to_menu(
-                subghz->subghz_receiver,
-                furi_string_get_cstr(item_name),
-                furi_string_get_cstr(item_time),
-                subghz_history_get_type_protocol(history, idx));
+            subghz_view_receiver_add_item_to_menu(subghz->subghz_receiver);
 
             subghz_scene_receiver_update_statusbar(subghz);
             if(subghz_history_get_text_space_left(subghz->history, NULL)) {
@@ -126,8 +115,6 @@ static void subghz_scene_add_to_history_callback(
             }
         }
         subghz_receiver_reset(receiver);
-        furi_string_free(item_name);
-        furi_string_free(item_time);
         subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
     } else {
         FURI_LOG_I(TAG, "%s protocol ignored", decoder_base->protocol->name);
@@ -138,9 +125,6 @@ void subghz_scene_receiver_on_enter(void* context) {
     SubGhz* subghz = context;
     SubGhzHistory* history = subghz->history;
 
-    FuriString* item_name = furi_string_alloc();
-    FuriString* item_time = furi_string_alloc();
-
     if(subghz_rx_key_state_get(subghz) == SubGhzRxKeyStateIDLE) {
         subghz_txrx_set_preset(subghz->txrx, "AM650", subghz->last_settings->frequency, NULL, 0);
         subghz_history_reset(history);
@@ -153,20 +137,14 @@ void subghz_scene_receiver_on_enter(void* context) {
 
     //Load history to receiver
     subghz_view_receiver_exit(subghz->subghz_receiver);
-    for(uint8_t i = 0; i < subghz_history_get_item(history); i++) {
-        furi_string_reset(item_name);
-        furi_string_reset(item_time);
-        subghz_history_get_text_item_menu(history, item_name, i);
-        subghz_history_get_time_item_menu(history, item_time, i);
-        subghz_view_receiver_add_item_to_menu(
-            subghz->subghz_receiver,
-            furi_string_get_cstr(item_name),
-            furi_string_get_cstr(item_time),
-            subghz_history_get_type_protocol(history, i));
+    subghz_view_receiver_set_item_callback(
+        subghz->subghz_receiver,
+        (SubGhzViewReceiverItemCallback)subghz_history_get_menu_item,
+        history);
+    subghz_view_receiver_set_item_count(subghz->subghz_receiver, subghz_history_get_item(history));
+    if(subghz_history_get_item(history) > 0) {
         subghz_rx_key_state_set(subghz, SubGhzRxKeyStateAddKey);
     }
-    furi_string_free(item_name);
-    furi_string_free(item_time);
     subghz_scene_receiver_update_statusbar(subghz);
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_receiver_callback, subghz);
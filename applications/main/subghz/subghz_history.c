@@ -1,114 +1,329 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/file_stream.h>
 
 #include <furi.h>
 
-#define SUBGHZ_HISTORY_MAX 55
+#define SUBGHZ_HISTORY_MAX UINT16_MAX
 #define SUBGHZ_HISTORY_FREE_HEAP 20480
+// Latest entries with serialized data, older ones are spilled to SD.
+// Without SD card this is the history limit, same as before spilling existed
+#define SUBGHZ_HISTORY_RAM_MAX 55
+// Spilled records are read back by screenfuls
+#define SUBGHZ_HISTORY_CACHE_SIZE 8
+// Distinct protocols and presets seen during one session
+#define SUBGHZ_HISTORY_PROTOCOLS_MAX 128
+#define SUBGHZ_HISTORY_PRESETS_MAX 32
+#define SUBGHZ_HISTORY_LABEL_SIZE 20
+#define SUBGHZ_HISTORY_TMP_DIR EXT_PATH("subghz/tmp_history")
+#define SUBGHZ_HISTORY_RECORDS_PATH SUBGHZ_HISTORY_TMP_DIR "/history.rec"
+#define SUBGHZ_HISTORY_PAYLOADS_PATH SUBGHZ_HISTORY_TMP_DIR "/history.log"
 #define TAG "SubGhzHistory"
 
+/** Fixed size history entry, same layout in RAM and in records file */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
+    uint64_t key;
+    uint32_t timestamp;
+    uint32_t frequency;
+    uint32_t payload_offset;
+    uint32_t payload_size;
+    uint8_t protocol;
+    uint8_t preset;
     uint8_t type;
-    SubGhzRadioPreset* preset;
-    FuriHalRtcDateTime datetime;
-} SubGhzHistoryItem;
-
-ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
+    uint8_t hash;
+    char label[SUBGHZ_HISTORY_LABEL_SIZE];
+} SubGhzHistoryRecord;
 
 typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+    SubGhzHistoryRecord record;
+    FlipperFormat* payload;
+} SubGhzHistoryItem;
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
     uint8_t code_last_hash_data;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
+    FuriMutex* mutex;
+
+    // Entries [0, spilled) are on SD, the rest is RAM ring starting at item_first
+    SubGhzHistoryItem items[SUBGHZ_HISTORY_RAM_MAX];
+    uint16_t item_first;
+    uint16_t spilled;
+
+    // Interned per session, entries only keep indexes
+    const SubGhzProtocol* protocols[SUBGHZ_HISTORY_PROTOCOLS_MAX];
+    uint8_t protocols_count;
+    SubGhzRadioPreset presets[SUBGHZ_HISTORY_PRESETS_MAX];
+    uint8_t presets_count;
+    SubGhzRadioPreset preset;
+
+    Storage* storage;
+    bool spill_available;
+    File* records;
+    Stream* payloads;
+    FlipperFormat* raw_data;
+    SubGhzHistoryRecord cache[SUBGHZ_HISTORY_CACHE_SIZE];
+    uint16_t cache_start;
+    uint16_t cache_count;
 };
 
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->records) {
+        storage_file_free(instance->records);
+        instance->records = NULL;
+    }
+    if(instance->payloads) {
+        file_stream_close(instance->payloads);
+        stream_free(instance->payloads);
+        instance->payloads = NULL;
+    }
+    storage_simply_remove(instance->storage, SUBGHZ_HISTORY_RECORDS_PATH);
+    storage_simply_remove(instance->storage, SUBGHZ_HISTORY_PAYLOADS_PATH);
+}
+
+static bool subghz_history_spill_open(SubGhzHistory* instance) {
+    if(instance->records) return true;
+    if(!instance->spill_available) return false;
+
+    instance->records = storage_file_alloc(instance->storage);
+    instance->payloads = file_stream_alloc(instance->storage);
+
+    bool result = false;
+    do {
+        if(!storage_simply_mkdir(instance->storage, SUBGHZ_HISTORY_TMP_DIR)) break;
+        if(!storage_file_open(
+               instance->records,
+               SUBGHZ_HISTORY_RECORDS_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(!file_stream_open(
+               instance->payloads,
+               SUBGHZ_HISTORY_PAYLOADS_PATH,
+               FSAM_READ_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        result = true;
+    } while(false);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Spill unavailable");
+        subghz_history_spill_close(instance);
+        instance->spill_available = false;
+    }
+    return result;
+}
+
+static inline uint16_t subghz_history_ram_count(SubGhzHistory* instance) {
+    return instance->last_index_write - instance->spilled;
+}
+
+static inline SubGhzHistoryItem* subghz_history_ram_item(SubGhzHistory* instance, uint16_t pos) {
+    return &instance->items[(instance->item_first + pos) % SUBGHZ_HISTORY_RAM_MAX];
+}
+
+static bool subghz_history_write_record(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    const SubGhzHistoryRecord* record) {
+    return storage_file_seek(instance->records, idx * sizeof(SubGhzHistoryRecord), true) &&
+           storage_file_write(instance->records, record, sizeof(SubGhzHistoryRecord)) ==
+               sizeof(SubGhzHistoryRecord);
+}
+
+/** Move oldest RAM entry to SD: payload to log end, record to records file */
+static bool subghz_history_spill_oldest(SubGhzHistory* instance) {
+    if(!subghz_history_spill_open(instance)) return false;
+
+    SubGhzHistoryItem* item = subghz_history_ram_item(instance, 0);
+    Stream* payload = flipper_format_get_raw_stream(item->payload);
+    size_t size = stream_size(payload);
+
+    if(!stream_seek(instance->payloads, 0, StreamOffsetFromEnd)) return false;
+    item->record.payload_offset = stream_tell(instance->payloads);
+    item->record.payload_size = size;
+
+    stream_rewind(payload);
+    if(stream_copy(payload, instance->payloads, size) != size) return false;
+    if(!subghz_history_write_record(instance, instance->spilled, &item->record)) return false;
+
+    instance->item_first = (instance->item_first + 1) % SUBGHZ_HISTORY_RAM_MAX;
+    instance->spilled++;
+    return true;
+}
+
+static const SubGhzHistoryRecord*
+    subghz_history_get_record(SubGhzHistory* instance, uint16_t idx) {
+    if(idx >= instance->last_index_write) return NULL;
+    if(idx >= instance->spilled) {
+        return &subghz_history_ram_item(instance, idx - instance->spilled)->record;
+    }
+
+    if(idx < instance->cache_start || idx >= instance->cache_start + instance->cache_count) {
+        instance->cache_start = idx - idx % SUBGHZ_HISTORY_CACHE_SIZE;
+        uint16_t count = MIN(SUBGHZ_HISTORY_CACHE_SIZE, instance->spilled - instance->cache_start);
+        size_t size = count * sizeof(SubGhzHistoryRecord);
+
+        instance->cache_count = 0;
+        if(!storage_file_seek(
+               instance->records, instance->cache_start * sizeof(SubGhzHistoryRecord), true) ||
+           storage_file_read(instance->records, instance->cache, size) != size) {
+            FURI_LOG_E(TAG, "Records read error");
+            return NULL;
+        }
+        instance->cache_count = count;
+    }
+
+    return &instance->cache[idx - instance->cache_start];
+}
+
+static uint8_t subghz_history_intern_protocol(
+    SubGhzHistory* instance,
+    const SubGhzProtocol* protocol) {
+    for(uint8_t i = 0; i < instance->protocols_count; i++) {
+        if(instance->protocols[i] == protocol) return i;
+    }
+    if(instance->protocols_count == SUBGHZ_HISTORY_PROTOCOLS_MAX) return UINT8_MAX;
+    instance->protocols[instance->protocols_count] = protocol;
+    return instance->protocols_count++;
+}
+
+static uint8_t subghz_history_intern_preset(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    for(uint8_t i = 0; i < instance->presets_count; i++) {
+        SubGhzRadioPreset* item = &instance->presets[i];
+        if(item->data == preset->data && item->data_size == preset->data_size &&
+           furi_string_equal(item->name, preset->name)) {
+            return i;
+        }
+    }
+    if(instance->presets_count == SUBGHZ_HISTORY_PRESETS_MAX) return UINT8_MAX;
+
+    SubGhzRadioPreset* item = &instance->presets[instance->presets_count];
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return instance->presets_count++;
+}
+
+static void subghz_history_clear(SubGhzHistory* instance) {
+    for(uint8_t i = 0; i < instance->presets_count; i++) {
+        furi_string_free(instance->presets[i].name);
+    }
+    instance->presets_count = 0;
+    instance->protocols_count = 0;
+
+    subghz_history_spill_close(instance);
+    instance->spill_available = storage_sd_status(instance->storage) == FSE_OK;
+    instance->cache_count = 0;
+    instance->item_first = 0;
+    instance->spilled = 0;
+    instance->last_index_write = 0;
+    instance->code_last_hash_data = 0;
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->raw_data = flipper_format_string_alloc();
+    instance->spill_available = storage_sd_status(instance->storage) == FSE_OK;
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_clear(instance);
+    for(size_t i = 0; i < SUBGHZ_HISTORY_RAM_MAX; i++) {
+        if(instance->items[i].payload) flipper_format_free(instance->items[i].payload);
+    }
+    flipper_format_free(instance->raw_data);
+    furi_record_close(RECORD_STORAGE);
+    furi_mutex_free(instance->mutex);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
     free(instance);
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    uint32_t frequency = record ? record->frequency : 0;
+    furi_mutex_release(instance->mutex);
+    return frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzRadioPreset* preset = NULL;
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        preset = &instance->preset;
+        *preset = instance->presets[record->preset];
+        preset->frequency = record->frequency;
+    }
+    furi_mutex_release(instance->mutex);
+    return preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    const char* name = record ? furi_string_get_cstr(instance->presets[record->preset].name) : "";
+    furi_mutex_release(instance->mutex);
+    return name;
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_reset(instance->history->data);
-    instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    subghz_history_clear(instance);
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t item_id) {
     furi_assert(instance);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
 
-    SubGhzHistoryItemArray_it_t it;
-    //SubGhzHistoryItem* target_item = SubGhzHistoryItemArray_get(instance->history->data, item_id);
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_ref(it);
-
-        if(it->index == (size_t)(item_id)) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-            SubGhzHistoryItemArray_remove(instance->history->data, it);
+    if(item_id >= instance->last_index_write) {
+        FURI_LOG_E(TAG, "Missing Item");
+    } else if(item_id >= instance->spilled) {
+        // Keep payload containers, the removed one goes to the ring end
+        uint16_t ram_count = subghz_history_ram_count(instance);
+        uint16_t pos = item_id - instance->spilled;
+        SubGhzHistoryItem removed = *subghz_history_ram_item(instance, pos);
+        for(; pos + 1 < ram_count; pos++) {
+            *subghz_history_ram_item(instance, pos) = *subghz_history_ram_item(instance, pos + 1);
         }
-        SubGhzHistoryItemArray_previous(it);
+        *subghz_history_ram_item(instance, ram_count - 1) = removed;
+        instance->last_index_write--;
+    } else {
+        // Payload stays in the log, only records after it are shifted
+        SubGhzHistoryRecord record;
+        for(uint16_t idx = item_id + 1; idx < instance->spilled; idx++) {
+            if(!storage_file_seek(instance->records, idx * sizeof(SubGhzHistoryRecord), true) ||
+               storage_file_read(instance->records, &record, sizeof(record)) != sizeof(record) ||
+               !subghz_history_write_record(instance, idx - 1, &record)) {
+                FURI_LOG_E(TAG, "Records write error");
+                break;
+            }
+        }
+        instance->spilled--;
+        uint32_t size = instance->spilled * sizeof(SubGhzHistoryRecord);
+        storage_file_seek(instance->records, size, true);
+        storage_file_truncate(instance->records);
+        instance->cache_count = 0;
+        instance->last_index_write--;
     }
-    instance->last_index_write--;
+
+    furi_mutex_release(instance->mutex);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
@@ -118,62 +333,156 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    uint8_t type = record ? record->type : 0;
+    furi_mutex_release(instance->mutex);
+    return type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    const char* name = "";
+    if(record) {
+        name = instance->protocols[record->protocol]->name;
+    } else {
         FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
-    }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
     }
-    return furi_string_get_cstr(instance->tmp_string);
+    furi_mutex_release(instance->mutex);
+    return name;
 }
 
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    FlipperFormat* raw_data = NULL;
+
+    if(idx >= instance->spilled && idx < instance->last_index_write) {
+        raw_data = subghz_history_ram_item(instance, idx - instance->spilled)->payload;
     } else {
-        return NULL;
+        // Spilled entry is read back only when it's opened or saved
+        const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+        Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+        stream_clean(stream);
+        if(record &&
+           stream_seek(instance->payloads, record->payload_offset, StreamOffsetFromStart) &&
+           stream_copy(instance->payloads, stream, record->payload_size) == record->payload_size) {
+            raw_data = instance->raw_data;
+        } else {
+            FURI_LOG_E(TAG, "Payload read error");
+        }
     }
+    if(raw_data) flipper_format_rewind(raw_data);
+
+    furi_mutex_release(instance->mutex);
+    return raw_data;
 }
+
 bool subghz_history_get_text_space_left(SubGhzHistory* instance, FuriString* output) {
     furi_assert(instance);
     if(memmgr_get_free_heap() < SUBGHZ_HISTORY_FREE_HEAP) {
         if(output != NULL) furi_string_printf(output, "    Free heap LOW");
         return true;
     }
-    if(instance->last_index_write == SUBGHZ_HISTORY_MAX) {
+    if(instance->last_index_write == SUBGHZ_HISTORY_MAX ||
+       (!instance->spill_available && instance->last_index_write == SUBGHZ_HISTORY_RAM_MAX)) {
         if(output != NULL) furi_string_printf(output, "   Memory is FULL");
         return true;
     }
-    if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_MAX);
+    if(output != NULL) {
+        if(instance->spill_available) {
+            furi_string_printf(output, "%02u", instance->last_index_write);
+        } else {
+            furi_string_printf(
+                output, "%02u/%02u", instance->last_index_write, SUBGHZ_HISTORY_RAM_MAX);
+        }
+    }
     return false;
 }
 
 uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
+
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(!record) {
+        furi_string_reset(output);
+    } else if(!record->key) {
+        furi_string_printf(output, "%s", record->label);
+    } else if(!(uint32_t)(record->key >> 32)) {
+        furi_string_printf(output, "%s %lX", record->label, (uint32_t)(record->key & 0xFFFFFFFF));
+    } else {
+        furi_string_printf(
+            output,
+            "%s %lX%08lX",
+            record->label,
+            (uint32_t)(record->key >> 32),
+            (uint32_t)(record->key & 0xFFFFFFFF));
+    }
+    furi_mutex_release(instance->mutex);
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    FuriHalRtcDateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    const SubGhzHistoryRecord* record = subghz_history_get_record(instance, idx);
+    if(record) {
+        uint32_t seconds = record->timestamp % (60 * 60 * 24);
+        furi_string_printf(
+            output, "%.2lu:%.2lu:%.2lu ", seconds / 3600, seconds / 60 % 60, seconds % 60);
+    } else {
+        furi_string_reset(output);
+    }
+    furi_mutex_release(instance->mutex);
+}
+
+uint8_t subghz_history_get_menu_item(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time) {
+    furi_assert(instance);
+    subghz_history_get_text_item_menu(instance, name, idx);
+    subghz_history_get_time_item_menu(instance, time, idx);
+    return subghz_history_get_type_protocol(instance, idx);
+}
+
+static void subghz_history_parse_payload(
+    SubGhzHistory* instance,
+    FlipperFormat* payload,
+    SubGhzHistoryRecord* record) {
+    const char* name = instance->protocols[record->protocol]->name;
+    const char* prefix = NULL;
+    if(!strcmp(name, "KeeLoq")) {
+        prefix = "KL";
+    } else if(!strcmp(name, "Star Line")) {
+        prefix = "SL";
+    }
+
+    if(prefix && flipper_format_rewind(payload) &&
+       flipper_format_read_string(payload, "Manufacture", instance->tmp_string)) {
+        snprintf(
+            record->label,
+            sizeof(record->label),
+            "%s %s",
+            prefix,
+            furi_string_get_cstr(instance->tmp_string));
+    } else {
+        strlcpy(record->label, name, sizeof(record->label));
+    }
+
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    if(!flipper_format_rewind(payload) ||
+       !flipper_format_read_hex(payload, "Key", key_data, sizeof(uint64_t))) {
+        FURI_LOG_D(TAG, "No Key");
+    }
+    record->key = 0;
+    for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+        record->key = (record->key << 8) | key_data[i];
+    }
 }
 
 bool subghz_history_add_to_history(
@@ -194,82 +503,44 @@ bool subghz_history_add_to_history(
         return false;
     }
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
-
-    FuriString* text = furi_string_alloc();
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
-
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+    bool result = false;
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
+        SubGhzHistoryRecord record = {
+            .protocol = subghz_history_intern_protocol(instance, decoder_base->protocol),
+            .preset = subghz_history_intern_preset(instance, preset),
+            .type = decoder_base->protocol->type,
+            .hash = subghz_protocol_decoder_base_get_hash_data(decoder_base),
+            .frequency = preset->frequency,
+            .timestamp = furi_hal_rtc_get_timestamp(),
+        };
+        if(record.protocol == UINT8_MAX || record.preset == UINT8_MAX) {
+            FURI_LOG_E(TAG, "Too many protocols or presets");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
-            }
-            furi_string_cat(instance->tmp_string, text);
-        }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
+
+        if(subghz_history_ram_count(instance) == SUBGHZ_HISTORY_RAM_MAX &&
+           !subghz_history_spill_oldest(instance)) {
             break;
         }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_D(TAG, "No Key");
-        }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(data != 0) {
-            if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data >> 32),
-                    (uint32_t)(data & 0xFFFFFFFF));
-            }
+
+        SubGhzHistoryItem* item =
+            subghz_history_ram_item(instance, subghz_history_ram_count(instance));
+        if(item->payload) {
+            stream_clean(flipper_format_get_raw_stream(item->payload));
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            item->payload = flipper_format_string_alloc();
         }
+        subghz_protocol_decoder_base_serialize(decoder_base, item->payload, preset);
+        subghz_history_parse_payload(instance, item->payload, &record);
+        item->record = record;
 
+        instance->code_last_hash_data = record.hash;
+        instance->last_update_timestamp = furi_get_tick();
+        instance->last_index_write++;
+        result = true;
     } while(false);
+    furi_mutex_release(instance->mutex);
 
-    furi_string_free(text);
-    instance->last_index_write++;
-    return true;
+    return result;
 }
@@ -86,6 +86,23 @@ void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* outp
  */
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx);
 
+/** Get everything receiver menu needs for history[idx]
+ * 
+ * Matches SubGhzViewReceiverItemCallback, so the view can pull visible items
+ * instead of keeping a copy of the whole history.
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @param name      - FuriString* menu text output
+ * @param time      - FuriString* time output
+ * @return type     - type protocol
+ */
+uint8_t subghz_history_get_menu_item(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time);
+
 /** Get string the remaining number of records to history
  * 
  * @param instance  - SubGhzHistory instance
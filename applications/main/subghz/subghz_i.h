@@ -23,6 +23,7 @@
 #include <subghz/scenes/subghz_scene.h>
 #include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_decode_raw_worker.h>
 #include <lib/subghz/subghz_setting.h>
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
@@ -85,7 +86,7 @@ struct SubGhz {
 
     SecureData* secure_data;
 
-    SubGhzFileEncoderWorker* decode_raw_file_worker_encoder;
+    SubGhzDecodeRawWorker* decode_raw_worker;
 
     SubGhzThresholdRssi* threshold_rssi;
     SubGhzRxKeyState rx_key_state;
@@ -5,7 +5,6 @@
 
 #include <input/input.h>
 #include <gui/elements.h>
-#include <m-array.h>
 
 #define FRAME_HEIGHT 12
 #define MAX_LEN_PX 111
@@ -16,23 +15,6 @@
 
 #define FLIP_TIMEOUT (500)
 
-typedef struct {
-    FuriString* item_str;
-    FuriString* time;
-    uint8_t type;
-} SubGhzReceiverMenuItem;
-
-ARRAY_DEF(SubGhzReceiverMenuItemArray, SubGhzReceiverMenuItem, M_POD_OPLIST)
-
-#define M_OPL_SubGhzReceiverMenuItemArray_t() \
-    ARRAY_OPLIST(SubGhzReceiverMenuItemArray, M_POD_OPLIST)
-
-struct SubGhzReceiverHistory {
-    SubGhzReceiverMenuItemArray_t data;
-};
-
-typedef struct SubGhzReceiverHistory SubGhzReceiverHistory;
-
 static const Icon* ReceiverItemIcons[] = {
     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
     [SubGhzProtocolTypeStatic] = &I_Static_9x7,
@@ -62,7 +44,9 @@ typedef struct {
     FuriString* preset_str;
     FuriString* history_stat_str;
     FuriString* progress_str;
-    SubGhzReceiverHistory* history;
+    FuriString* item_time_str;
+    SubGhzViewReceiverItemCallback item_callback;
+    void* item_context;
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
@@ -169,21 +153,37 @@ static void subghz_view_receiver_flip_string_callback(void* context) {
         true);
 }
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_item_callback(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type) {
+    SubGhzViewReceiverItemCallback callback,
+    void* context) {
+    furi_assert(subghz_receiver);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        {
+            model->item_callback = callback;
+            model->item_context = context;
+        },
+        true);
+}
+
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count) {
+    furi_assert(subghz_receiver);
+    with_view_model(
+        subghz_receiver->view,
+        SubGhzViewReceiverModel * model,
+        { model->history_item = count; },
+        true);
+    subghz_view_receiver_update_offset(subghz_receiver);
+}
+
+void subghz_view_receiver_add_item_to_menu(SubGhzViewReceiver* subghz_receiver) {
     furi_assert(subghz_receiver);
     with_view_model(
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItem* item_menu =
-                SubGhzReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->time = furi_string_alloc_set(time);
-            item_menu->item_str = furi_string_alloc_set(name);
-            item_menu->type = type;
             if((model->idx == model->history_item - 1)) {
                 model->history_item++;
                 model->idx++;
@@ -275,30 +275,26 @@ void subghz_view_receiver_draw(Canvas* canvas, SubGhzViewReceiverModel* model) {
     bool scrollbar = model->history_item > 4;
     FuriString* str_buff = furi_string_alloc();
 
-    if(!model->nodraw) {
-        SubGhzReceiverMenuItem* item_menu;
-
+    if(!model->nodraw && model->item_callback) {
+        // Only visible items are requested, owner keeps the rest
         for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
             size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-            item_menu = SubGhzReceiverMenuItemArray_get(model->history->data, idx);
-            if(item_menu == NULL) {
-                break;
-            }
-            if(item_menu->type == 0) {
+            uint8_t type =
+                model->item_callback(model->item_context, idx, str_buff, model->item_time_str);
+            if(type == 0 || type >= COUNT_OF(ReceiverItemIcons)) {
                 break;
             }
-            furi_string_set(str_buff, item_menu->item_str);
             if(model->idx == idx) {
                 subghz_view_receiver_draw_frame(canvas, i, scrollbar);
                 if(model->show_time) {
                     // Show time of signal one moment
-                    furi_string_set(str_buff, item_menu->time);
+                    furi_string_set(str_buff, model->item_time_str);
                 }
             } else {
                 canvas_set_color(canvas, ColorBlack);
             }
             elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 7 : MAX_LEN_PX);
-            canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
+            canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[type]);
             canvas_draw_str(canvas, 15, 9 + i * FRAME_HEIGHT, furi_string_get_cstr(str_buff));
             furi_string_reset(str_buff);
         }
@@ -532,17 +528,10 @@ void subghz_view_receiver_exit(void* context) {
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
 
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
-                model->nodraw = false;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
+            model->nodraw = false;
         },
         false);
     furi_timer_stop(subghz_receiver->timer);
@@ -577,9 +566,8 @@ SubGhzViewReceiver* subghz_view_receiver_alloc() {
             model->history_stat_str = furi_string_alloc();
             model->progress_str = furi_string_alloc();
             model->bar_show = SubGhzViewReceiverBarShowDefault;
+            model->item_time_str = furi_string_alloc();
             model->nodraw = false;
-            model->history = malloc(sizeof(SubGhzReceiverHistory));
-            SubGhzReceiverMenuItemArray_init(model->history->data);
         },
         true);
     subghz_receiver->timer =
@@ -600,14 +588,7 @@ void subghz_view_receiver_free(SubGhzViewReceiver* subghz_receiver) {
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
             furi_string_free(model->progress_str);
-                for
-                    M_EACH(item_menu, model->history->data, SubGhzReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        furi_string_free(item_menu->time);
-                        item_menu->type = 0;
-                    }
-                SubGhzReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
+            furi_string_free(model->item_time_str);
         },
         false);
     furi_timer_free(subghz_receiver->timer);
@@ -635,23 +616,6 @@ void subghz_view_receiver_delete_element_callback(SubGhzViewReceiver* subghz_rec
         subghz_receiver->view,
         SubGhzViewReceiverModel * model,
         {
-            SubGhzReceiverMenuItemArray_it_t it;
-            // SubGhzReceiverMenuItem* target_item =
-            //     SubGhzReceiverMenuItemArray_get(model->history->data, model->idx);
-            SubGhzReceiverMenuItemArray_it_last(it, model->history->data);
-            while(!SubGhzReceiverMenuItemArray_end_p(it)) {
-                SubGhzReceiverMenuItem* item = SubGhzReceiverMenuItemArray_ref(it);
-
-                if(it->index == (size_t)(model->idx)) {
-                    furi_string_free(item->item_str);
-                    furi_string_free(item->time);
-                    item->type = 0;
-                    SubGhzReceiverMenuItemArray_remove(model->history->data, it);
-                }
-
-                SubGhzReceiverMenuItemArray_previous(it);
-            }
-
             if(model->history_item == 5) {
                 if(model->idx >= 2) {
                     model->idx = model->history_item - 1;
@@ -8,6 +8,16 @@ typedef struct SubGhzViewReceiver SubGhzViewReceiver;
 
 typedef void (*SubGhzViewReceiverCallback)(SubGhzCustomEvent event, void* context);
 
+/** Fill name and time of item for drawing
+ *
+ * @return     item type, 0 if there is no such item
+ */
+typedef uint8_t (*SubGhzViewReceiverItemCallback)(
+    void* context,
+    uint16_t idx,
+    FuriString* name,
+    FuriString* time);
+
 void subghz_view_receiver_set_mode(
     SubGhzViewReceiver* subghz_receiver,
     SubGhzViewReceiverMode mode);
@@ -41,11 +51,14 @@ void subghz_view_receiver_add_data_progress(
     SubGhzViewReceiver* subghz_receiver,
     const char* progress_str);
 
-void subghz_view_receiver_add_item_to_menu(
+void subghz_view_receiver_set_item_callback(
     SubGhzViewReceiver* subghz_receiver,
-    const char* name,
-    const char* time,
-    uint8_t type);
+    SubGhzViewReceiverItemCallback callback,
+    void* context);
+
+void subghz_view_receiver_set_item_count(SubGhzViewReceiver* subghz_receiver, uint16_t count);
+
+void subghz_view_receiver_add_item_to_menu(SubGhzViewReceiver* subghz_receiver);
 
 uint16_t subghz_view_receiver_get_idx_menu(SubGhzViewReceiver* subghz_receiver);
 
@@ -19,6 +19,7 @@
 #define RSSI_SCALE 2.3
 #define TRIGGER_STEP 1
 #define MAX_HISTORY 4
+#define ACTIVITY_BUCKETS 60
 
 static const uint32_t subghz_frequency_list[] = {
     300000000, 302757000, 303875000, 304250000, 307000000, 307500000, 307800000, 309000000,
@@ -62,6 +63,8 @@ typedef struct {
     uint8_t max_index;
     bool show_frame;
     bool is_ext_radio;
+    uint8_t activity[ACTIVITY_BUCKETS];
+    uint8_t activity_count;
 } SubGhzFrequencyAnalyzerModel;
 
 void subghz_frequency_analyzer_set_callback(
@@ -117,6 +120,23 @@ void subghz_frequency_analyzer_draw_rssi(
     canvas_draw_line(canvas, x, y + 3, x + (RSSI_MAX - RSSI_MIN) * 2 / RSSI_SCALE, y + 3);
 }
 
+// Activity histogram under the frequency: one bar per group of coarse frequencies
+static void subghz_frequency_analyzer_activity_draw(
+    Canvas* canvas,
+    SubGhzFrequencyAnalyzerModel* model) {
+    const uint8_t x = 4;
+    const uint8_t y = 28;
+    if(!model->activity_count) return;
+    const uint8_t bar_width = 120 / model->activity_count;
+
+    for(uint8_t i = 0; i < model->activity_count; i++) {
+        uint8_t height = model->activity[i] > 127 ? 2 : (model->activity[i] > 0 ? 1 : 0);
+        if(height) {
+            canvas_draw_box(canvas, x + i * bar_width, y + 1 - height, bar_width, height);
+        }
+    }
+}
+
 static void subghz_frequency_analyzer_history_frequency_draw(
     Canvas* canvas,
     SubGhzFrequencyAnalyzerModel* model) {
@@ -199,6 +219,7 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
 
     canvas_draw_str(canvas, 8, 26, buffer);
     canvas_draw_icon(canvas, 96, 15, &I_MHz_25x11);
+    subghz_frequency_analyzer_activity_draw(canvas, model);
 
     canvas_set_color(canvas, ColorBlack);
     canvas_set_font(canvas, FontSecondary);
@@ -523,6 +544,8 @@ void subghz_frequency_analyzer_pair_callback(
         instance->view,
         SubGhzFrequencyAnalyzerModel * model,
         {
+            model->activity_count = subghz_frequency_analyzer_worker_get_activity(
+                instance->worker, model->activity, ACTIVITY_BUCKETS);
             model->rssi = rssi;
             model->rssi_last = instance->rssi_last;
             model->frequency = frequency;
@@ -3,8 +3,7 @@
 #include <gui/view.h>
 #include "../helpers/subghz_types.h"
 #include "../helpers/subghz_custom_event.h"
-
-#define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
+#include "../helpers/subghz_threshold_rssi.h"
 
 typedef struct SubGhzReadRAW SubGhzReadRAW;
 
@@ -0,0 +1,283 @@
+#include "cli_command_top.h"
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <lib/toolbox/args.h>
+#include <lib/toolbox/profiler_sampler.h>
+#include <storage/storage.h>
+
+#define CLI_TOP_THREADS_MAX (32)
+#define CLI_TOP_HOTSPOTS (8)
+#define CLI_TOP_REFRESH_MS (1000)
+#define CLI_TOP_POLL_MS (50)
+
+// 250Hz sampling: one refresh fits buffer
+#define CLI_TOP_LIVE_PERIOD (4)
+#define CLI_TOP_LIVE_SAMPLES (512)
+// Bucket of 16 bytes merges neighbour instructions, still precise enough
+#define CLI_TOP_LIVE_GRANULARITY (16)
+
+// Every tick, drained every CLI_TOP_POLL_MS
+#define CLI_TOP_RECORD_PERIOD (1)
+#define CLI_TOP_RECORD_SAMPLES (256)
+#define CLI_TOP_RECORD_PATH EXT_PATH("profiler.samples")
+
+#define CLI_TOP_FILE_MAGIC (0x53505A46) // "FZPS"
+#define CLI_TOP_FILE_VERSION (1)
+
+/* Samples file for scripts/profiler.py, little endian:
+ * - CliTopFileHeader
+ * - samples_count * {uint32_t pc, uint32_t thread_id}
+ * - threads_count * CliTopFileThread, threads alive at the end of recording
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tick_frequency;
+    uint32_t period;
+    uint32_t samples_count;
+    uint32_t dropped;
+    uint32_t threads_count;
+} __attribute__((packed)) CliTopFileHeader;
+
+typedef struct {
+    uint32_t thread_id;
+    char name[configMAX_TASK_NAME_LEN];
+} __attribute__((packed)) CliTopFileThread;
+
+typedef struct {
+    FuriThreadId id;
+    uint64_t cycles;
+    uint64_t delta;
+} CliTopThread;
+
+static void cli_command_top_print_usage() {
+    printf("Usage:\r\n");
+    printf("top [cmd] <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\t<none>\t - Live CPU usage and hot addresses, Ctrl+C to exit\r\n");
+    printf("\trecord <seconds> [path]\t - Save PC samples for scripts/profiler.py\r\n");
+}
+
+static size_t cli_command_top_snapshot(CliTopThread* threads, const CliTopThread* previous) {
+    FuriThreadId ids[CLI_TOP_THREADS_MAX];
+    size_t count = furi_thread_enumerate(ids, CLI_TOP_THREADS_MAX);
+
+    for(size_t i = 0; i < count; i++) {
+        threads[i].id = ids[i];
+        threads[i].cycles = furi_thread_get_cpu_cycles(ids[i]);
+        threads[i].delta = threads[i].cycles;
+        // Thread that started during interval has all its cycles in it
+        for(size_t j = 0; previous && j < CLI_TOP_THREADS_MAX && previous[j].id; j++) {
+            if(previous[j].id == ids[i]) {
+                threads[i].delta = threads[i].cycles - previous[j].cycles;
+                break;
+            }
+        }
+    }
+    if(count < CLI_TOP_THREADS_MAX) threads[count].id = NULL;
+
+    // Busiest first
+    for(size_t i = 1; i < count; i++) {
+        CliTopThread thread = threads[i];
+        size_t j = i;
+        for(; j > 0 && threads[j - 1].delta < thread.delta; j--) {
+            threads[j] = threads[j - 1];
+        }
+        threads[j] = thread;
+    }
+
+    return count;
+}
+
+static uint32_t cli_command_top_permille(uint64_t value, uint64_t total) {
+    return total ? (uint32_t)(value * 1000 / total) : 0;
+}
+
+static void cli_command_top_print(
+    const CliTopThread* threads,
+    size_t threads_count,
+    uint64_t interval_cycles,
+    const ProfilerSample* samples,
+    size_t samples_count,
+    uint32_t dropped) {
+    printf("\r\n%-20s %-20s %-7s %s\r\n", "Name", "AppID", "CPU", "Cycles");
+
+    uint64_t busy = 0;
+    for(size_t i = 0; i < threads_count; i++) {
+        uint32_t permille = cli_command_top_permille(threads[i].delta, interval_cycles);
+        busy += threads[i].delta;
+        printf(
+            "%-20s %-20s %3lu.%lu%%  %lu\r\n",
+            furi_thread_get_name(threads[i].id),
+            furi_thread_get_appid(threads[i].id),
+            permille / 10,
+            permille % 10,
+            (uint32_t)threads[i].delta);
+    }
+
+    // Cycle counter stops in STOP mode, what's not accounted is sleep
+    uint32_t sleep = 1000 - MIN(cli_command_top_permille(busy, interval_cycles), 1000UL);
+    printf("%-41s %3lu.%lu%%\r\n", "Sleep", sleep / 10, sleep % 10);
+
+    ProfilerHotspot hotspots[CLI_TOP_HOTSPOTS];
+    size_t hotspots_count = profiler_aggregate_hotspots(
+        samples, samples_count, NULL, CLI_TOP_LIVE_GRANULARITY, hotspots, CLI_TOP_HOTSPOTS);
+    printf("\r\nHot addresses, %zu samples, %lu dropped:\r\n", samples_count, dropped);
+    for(size_t i = 0; i < hotspots_count; i++) {
+        uint32_t permille = cli_command_top_permille(hotspots[i].count, samples_count);
+        printf("0x%08lx %3lu.%lu%%\r\n", hotspots[i].pc, permille / 10, permille % 10);
+    }
+}
+
+static void cli_command_top_live(Cli* cli) {
+    CliTopThread* threads = malloc(sizeof(CliTopThread) * CLI_TOP_THREADS_MAX);
+    CliTopThread* previous = malloc(sizeof(CliTopThread) * CLI_TOP_THREADS_MAX);
+    ProfilerSample* samples = malloc(sizeof(ProfilerSample) * CLI_TOP_LIVE_SAMPLES);
+    ProfilerSampler* sampler = profiler_sampler_alloc(CLI_TOP_LIVE_SAMPLES);
+
+    uint64_t cycles_per_tick = furi_hal_cortex_instructions_per_microsecond() * 1000000ULL /
+                               furi_kernel_get_tick_frequency();
+
+    printf("Press Ctrl+C to stop\r\n");
+    cli_command_top_snapshot(previous, NULL);
+    uint32_t tick = furi_get_tick();
+    profiler_sampler_start(sampler, CLI_TOP_LIVE_PERIOD);
+
+    while(!cli_cmd_interrupt_received(cli)) {
+        furi_delay_ms(CLI_TOP_POLL_MS);
+        if(furi_get_tick() - tick < furi_ms_to_ticks(CLI_TOP_REFRESH_MS)) continue;
+
+        size_t threads_count = cli_command_top_snapshot(threads, previous);
+        uint32_t now = furi_get_tick();
+        size_t samples_count = profiler_sampler_read(sampler, samples, CLI_TOP_LIVE_SAMPLES);
+
+        cli_command_top_print(
+            threads,
+            threads_count,
+            (now - tick) * cycles_per_tick,
+            samples,
+            samples_count,
+            profiler_sampler_get_dropped(sampler));
+
+        CliTopThread* swap = previous;
+        previous = threads;
+        threads = swap;
+        tick = now;
+    }
+
+    profiler_sampler_stop(sampler);
+    profiler_sampler_free(sampler);
+    free(samples);
+    free(previous);
+    free(threads);
+}
+
+static void cli_command_top_record(Cli* cli, FuriString* args) {
+    int seconds = 0;
+    if(!args_read_int_and_trim(args, &seconds) || seconds <= 0) {
+        cli_command_top_print_usage();
+        return;
+    }
+
+    FuriString* path = furi_string_alloc_set(CLI_TOP_RECORD_PATH);
+    args_read_string_and_trim(args, path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    ProfilerSample* samples = malloc(sizeof(ProfilerSample) * CLI_TOP_RECORD_SAMPLES);
+    uint32_t* records = malloc(sizeof(uint32_t) * 2 * CLI_TOP_RECORD_SAMPLES);
+    ProfilerSampler* sampler = profiler_sampler_alloc(CLI_TOP_RECORD_SAMPLES);
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            printf("Failed to open %s\r\n", furi_string_get_cstr(path));
+            break;
+        }
+
+        // Rewritten with real numbers when recording is over
+        CliTopFileHeader header = {
+            .magic = CLI_TOP_FILE_MAGIC,
+            .version = CLI_TOP_FILE_VERSION,
+            .tick_frequency = furi_kernel_get_tick_frequency(),
+            .period = CLI_TOP_RECORD_PERIOD,
+        };
+        bool success = storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+
+        printf("Recording %d s, press Ctrl+C to stop earlier\r\n", seconds);
+        uint32_t start = furi_get_tick();
+        uint32_t duration = furi_ms_to_ticks(seconds * 1000);
+        profiler_sampler_start(sampler, CLI_TOP_RECORD_PERIOD);
+        bool running = true;
+
+        while(success && running) {
+            // Last pass drains what was sampled till stop
+            furi_delay_ms(CLI_TOP_POLL_MS);
+            if(furi_get_tick() - start >= duration || cli_cmd_interrupt_received(cli)) {
+                profiler_sampler_stop(sampler);
+                running = false;
+            }
+
+            size_t count = profiler_sampler_read(sampler, samples, CLI_TOP_RECORD_SAMPLES);
+            for(size_t i = 0; i < count; i++) {
+                records[i * 2] = samples[i].pc;
+                records[i * 2 + 1] = (uint32_t)samples[i].thread_id;
+            }
+            size_t size = sizeof(uint32_t) * 2 * count;
+            success = storage_file_write(file, records, size) == size;
+            header.samples_count += count;
+        }
+        if(running) profiler_sampler_stop(sampler);
+        header.dropped = profiler_sampler_get_dropped(sampler);
+
+        FuriThreadId ids[CLI_TOP_THREADS_MAX];
+        header.threads_count = furi_thread_enumerate(ids, CLI_TOP_THREADS_MAX);
+        for(size_t i = 0; i < header.threads_count && success; i++) {
+            CliTopFileThread thread = {.thread_id = (uint32_t)ids[i]};
+            const char* name = furi_thread_get_name(ids[i]);
+            if(name) strlcpy(thread.name, name, sizeof(thread.name));
+            success = storage_file_write(file, &thread, sizeof(thread)) == sizeof(thread);
+        }
+
+        success = success && storage_file_seek(file, 0, true) &&
+                  storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+        if(!success) {
+            printf("Failed to write %s\r\n", furi_string_get_cstr(path));
+            break;
+        }
+
+        printf(
+            "%lu samples, %lu dropped, saved to %s\r\n",
+            header.samples_count,
+            header.dropped,
+            furi_string_get_cstr(path));
+    } while(false);
+
+    profiler_sampler_free(sampler);
+    free(records);
+    free(samples);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(path);
+}
+
+void cli_command_top(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_command_top_live(cli);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "record") == 0) {
+            cli_command_top_record(cli, args);
+            break;
+        }
+
+        cli_command_top_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+}
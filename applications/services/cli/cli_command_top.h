@@ -0,0 +1,5 @@
+#pragma once
+
+#include "cli_i.h"
+
+void cli_command_top(Cli* cli, FuriString* args, void* context);
@@ -1,5 +1,6 @@
 #include "cli_commands.h"
 #include "cli_command_gpio.h"
+#include "cli_command_top.h"
 
 #include <furi_hal.h>
 #include <furi_hal_info.h>
@@ -8,6 +9,7 @@
 #include <notification/notification_messages.h>
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
+#include <storage/storage.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
 #define CLI_DATE_FORMAT "%.4d-%.2d-%.2d %.2d:%.2d:%.2d %d"
@@ -178,6 +180,7 @@ void cli_command_src(Cli* cli, FuriString* args, void* context) {
 
 #define CLI_COMMAND_LOG_RING_SIZE 2048
 #define CLI_COMMAND_LOG_BUFFER_SIZE 64
+#define CLI_COMMAND_LOG_DUMP_PATH EXT_PATH("log_dump.bin")
 
 void cli_command_log_tx_callback(const uint8_t* buffer, size_t size, void* context) {
     furi_stream_buffer_send(context, buffer, size, 0);
@@ -198,12 +201,47 @@ bool cli_command_log_level_set_from_string(FuriString* level) {
             "<log debug> — debug information including <log info> (may impact system performance)\r\n");
         printf(
             "<log trace> — system traces including <log debug> (may impact system performance)\r\n");
+        printf(
+            "<log deferred> — toggle deferred logging, printed by background thread\r\n");
+        printf(
+            "<log dump> — save recent deferred records to " CLI_COMMAND_LOG_DUMP_PATH "\r\n");
     }
     return false;
 }
 
+static void cli_command_log_dump_callback(const uint8_t* data, size_t size, void* context) {
+    File* file = context;
+    storage_file_write(file, data, size);
+}
+
+static void cli_command_log_dump(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    if(storage_file_open(file, CLI_COMMAND_LOG_DUMP_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        size_t count = furi_log_dump(cli_command_log_dump_callback, file);
+        printf("%u records saved to " CLI_COMMAND_LOG_DUMP_PATH "\r\n", count);
+    } else {
+        printf("Failed to open " CLI_COMMAND_LOG_DUMP_PATH "\r\n");
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
 void cli_command_log(Cli* cli, FuriString* args, void* context) {
     UNUSED(context);
+
+    if(!furi_string_cmp_str(args, "deferred")) {
+        furi_log_set_deferred(!furi_log_is_deferred());
+        printf("Deferred logging %s\r\n", furi_log_is_deferred() ? "enabled" : "disabled");
+        printf("Dropped records: %lu\r\n", furi_log_get_dropped());
+        return;
+    } else if(!furi_string_cmp_str(args, "dump")) {
+        cli_command_log_dump();
+        return;
+    }
+
     FuriStreamBuffer* ring = furi_stream_buffer_alloc(CLI_COMMAND_LOG_RING_SIZE, 1);
     uint8_t buffer[CLI_COMMAND_LOG_BUFFER_SIZE];
     FuriLogLevel previous_level = furi_log_get_level();
@@ -476,6 +514,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "log", CliCommandFlagParallelSafe, cli_command_log, NULL);
     cli_add_command(cli, "sysctl", CliCommandFlagDefault, cli_command_sysctl, NULL);
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
+    cli_add_command(cli, "top", CliCommandFlagParallelSafe, cli_command_top, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
 
@@ -4,6 +4,7 @@
 #include <gui/icon_i.h>
 #include <stdint.h>
 #include <dolphin/dolphin.h>
+#include "animation_pack.h"
 
 typedef struct AnimationManager AnimationManager;
 
@@ -32,6 +33,8 @@ typedef struct {
     uint8_t active_cycles;
     uint16_t duration;
     uint16_t active_cooldown;
+    /* Frames streamed from SD-card, icon_animation.frames is NULL then */
+    AnimationPack* pack;
 } BubbleAnimation;
 
 typedef void (*AnimationManagerSetNewIdleAnimationCallback)(void* context);
@@ -0,0 +1,361 @@
+#include "animation_pack.h"
+
+#include <furi.h>
+#include <toolbox/compress.h>
+
+#define TAG "AnimationPack"
+
+#define ANIMATION_PACK_MAGIC (0x4B504641) /* "AFPK" */
+#define ANIMATION_PACK_VERSION (1)
+#define ANIMATION_PACK_TMP_SUFFIX ".tmp"
+/** Decoded frames kept in memory: displayed one and prefetched next */
+#define ANIMATION_PACK_RING_SIZE (2)
+/** CompressIcon decodes into 128x64 buffer */
+#define ANIMATION_PACK_BITMAP_SIZE_MAX (128 * 64 / 8)
+/** Icon bitmap header: 0x00 for raw data, 0x01 0x00 size_lo size_hi for heatshrink */
+#define ANIMATION_PACK_ICON_HEADER_SIZE (4)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t frame_count;
+    uint8_t width;
+    uint8_t height;
+} AnimationPackHeader;
+
+_Static_assert(sizeof(AnimationPackHeader) == 8, "Incorrect AnimationPackHeader size");
+
+struct AnimationPack {
+    File* file;
+    uint8_t frame_count;
+    size_t bitmap_size;
+    /* frame_count + 1 offsets, frame size is difference of neighbours */
+    uint32_t* index;
+    uint8_t* buffer;
+    CompressIcon* compress_icon;
+    int16_t ring_frame[ANIMATION_PACK_RING_SIZE];
+    uint8_t* ring[ANIMATION_PACK_RING_SIZE];
+    uint8_t ring_next;
+};
+
+static size_t animation_pack_get_bitmap_size(uint8_t width, uint8_t height) {
+    return ROUND_UP_TO(width, 8) * height;
+}
+
+bool animation_pack_is_actual(Storage* storage, const char* path, uint8_t frame_count) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    FuriString* filename = furi_string_alloc_printf("%s/" ANIMATION_PACK_FILE, path);
+    uint32_t pack_timestamp = 0;
+    uint32_t frame_timestamp = 0;
+    bool actual = false;
+
+    do {
+        if(storage_common_timestamp(storage, furi_string_get_cstr(filename), &pack_timestamp) !=
+           FSE_OK)
+            break;
+
+        /* Pack only, frame files were removed by user */
+        furi_string_printf(filename, "%s/frame_%d.bm", path, frame_count - 1);
+        if(storage_common_timestamp(storage, furi_string_get_cstr(filename), &frame_timestamp) !=
+           FSE_OK) {
+            actual = true;
+            break;
+        }
+
+        actual = pack_timestamp >= frame_timestamp;
+    } while(0);
+
+    furi_string_free(filename);
+    return actual;
+}
+
+static bool animation_pack_write_frame(
+    Storage* storage,
+    File* file,
+    const char* filename,
+    Compress* compress,
+    uint8_t* buffer,
+    uint8_t* encoded,
+    size_t encoded_size,
+    size_t bitmap_size,
+    uint32_t* frame_size) {
+    FileInfo file_info;
+    File* frame_file = storage_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(storage_common_stat(storage, filename, &file_info) != FSE_OK) break;
+        if((file_info.size == 0) || (file_info.size > bitmap_size + 1)) {
+            FURI_LOG_E(TAG, "Filesize %lld, max: %u", file_info.size, bitmap_size + 1);
+            break;
+        }
+        if(!storage_file_open(frame_file, filename, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            FURI_LOG_E(TAG, "Can't open file \'%s\'", filename);
+            break;
+        }
+        if(storage_file_read(frame_file, buffer, file_info.size) != file_info.size) break;
+
+        const uint8_t* data = buffer;
+        size_t size = file_info.size;
+        /* Frames packed by old asset tools may be raw, compress them now */
+        if((buffer[0] == 0x00) && (size == bitmap_size + 1)) {
+            size_t compressed_size = 0;
+            if(compress_encode(
+                   compress, &buffer[1], bitmap_size, encoded, encoded_size, &compressed_size) &&
+               encoded[0]) {
+                /* Icon header holds payload size without header itself */
+                uint16_t payload_size = compressed_size - ANIMATION_PACK_ICON_HEADER_SIZE;
+                memcpy(&encoded[2], &payload_size, sizeof(payload_size));
+                data = encoded;
+                size = compressed_size;
+            }
+        }
+
+        if(storage_file_write(file, data, size) != size) break;
+        *frame_size = size;
+        result = true;
+    } while(0);
+
+    storage_file_free(frame_file);
+    return result;
+}
+
+bool animation_pack_build(
+    Storage* storage,
+    const char* path,
+    uint8_t frame_count,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    size_t bitmap_size = animation_pack_get_bitmap_size(width, height);
+    if(!frame_count || !bitmap_size || (bitmap_size > ANIMATION_PACK_BITMAP_SIZE_MAX)) {
+        return false;
+    }
+
+    uint32_t start = furi_get_tick();
+    FuriString* pack_path = furi_string_alloc_printf("%s/" ANIMATION_PACK_FILE, path);
+    FuriString* tmp_path =
+        furi_string_alloc_printf("%s" ANIMATION_PACK_TMP_SUFFIX, furi_string_get_cstr(pack_path));
+    FuriString* filename = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+    Compress* compress = compress_alloc(bitmap_size);
+    /* Fits heatshrink worst case, compress_encode must not run out of space */
+    size_t encoded_size = bitmap_size + bitmap_size / 8 + 16;
+    uint8_t* buffer = malloc(bitmap_size + 1);
+    uint8_t* encoded = malloc(encoded_size);
+    size_t index_size = sizeof(uint32_t) * (frame_count + 1);
+    uint32_t* index = malloc(index_size);
+    bool result = false;
+
+    do {
+        if(!storage_file_open(
+               file, furi_string_get_cstr(tmp_path), FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+
+        AnimationPackHeader header = {
+            .magic = ANIMATION_PACK_MAGIC,
+            .version = ANIMATION_PACK_VERSION,
+            .frame_count = frame_count,
+            .width = width,
+            .height = height,
+        };
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        /* Placeholder, index is known after all frames are written */
+        if(storage_file_write(file, index, index_size) != index_size) break;
+
+        index[0] = sizeof(header) + index_size;
+        bool frames_ok = true;
+        for(uint8_t i = 0; i < frame_count; i++) {
+            uint32_t frame_size = 0;
+            furi_string_printf(filename, "%s/frame_%d.bm", path, i);
+            frames_ok = animation_pack_write_frame(
+                storage,
+                file,
+                furi_string_get_cstr(filename),
+                compress,
+                buffer,
+                encoded,
+                encoded_size,
+                bitmap_size,
+                &frame_size);
+            if(!frames_ok) break;
+            index[i + 1] = index[i] + frame_size;
+        }
+        if(!frames_ok) break;
+
+        if(!storage_file_seek(file, sizeof(header), true)) break;
+        if(storage_file_write(file, index, index_size) != index_size) break;
+        if(!storage_file_close(file)) break;
+
+        if(storage_common_rename(
+               storage, furi_string_get_cstr(tmp_path), furi_string_get_cstr(pack_path)) !=
+           FSE_OK)
+            break;
+
+        FURI_LOG_I(
+            TAG,
+            "Packed \'%s\': %u frames, %lu bytes, %lums",
+            path,
+            frame_count,
+            index[frame_count],
+            furi_get_tick() - start);
+        result = true;
+    } while(0);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Failed to pack \'%s\'", path);
+        storage_file_close(file);
+        storage_common_remove(storage, furi_string_get_cstr(tmp_path));
+    }
+
+    free(index);
+    free(encoded);
+    free(buffer);
+    compress_free(compress);
+    storage_file_free(file);
+    furi_string_free(filename);
+    furi_string_free(tmp_path);
+    furi_string_free(pack_path);
+
+    return result;
+}
+
+AnimationPack* animation_pack_alloc(
+    Storage* storage,
+    const char* path,
+    uint8_t frame_count,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    size_t bitmap_size = animation_pack_get_bitmap_size(width, height);
+    if(!frame_count || !bitmap_size || (bitmap_size > ANIMATION_PACK_BITMAP_SIZE_MAX)) {
+        return NULL;
+    }
+
+    AnimationPack* pack = malloc(sizeof(AnimationPack));
+    pack->file = storage_file_alloc(storage);
+    pack->frame_count = frame_count;
+    pack->bitmap_size = bitmap_size;
+    size_t index_size = sizeof(uint32_t) * (frame_count + 1);
+    pack->index = malloc(index_size);
+
+    FuriString* filename = furi_string_alloc_printf("%s/" ANIMATION_PACK_FILE, path);
+    bool result = false;
+
+    do {
+        if(!storage_file_open(
+               pack->file, furi_string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        AnimationPackHeader header;
+        if(storage_file_read(pack->file, &header, sizeof(header)) != sizeof(header)) break;
+        if((header.magic != ANIMATION_PACK_MAGIC) || (header.version != ANIMATION_PACK_VERSION) ||
+           (header.frame_count != frame_count) || (header.width != width) ||
+           (header.height != height)) {
+            FURI_LOG_W(TAG, "Pack \'%s\' doesn't match meta", path);
+            break;
+        }
+
+        if(storage_file_read(pack->file, pack->index, index_size) != index_size) break;
+
+        bool index_ok = pack->index[0] == sizeof(header) + index_size;
+        for(uint8_t i = 0; index_ok && (i < frame_count); i++) {
+            uint32_t frame_size = pack->index[i + 1] - pack->index[i];
+            index_ok = (pack->index[i + 1] > pack->index[i]) &&
+                       (frame_size <= bitmap_size + ANIMATION_PACK_ICON_HEADER_SIZE);
+        }
+        if(!index_ok || (pack->index[frame_count] != storage_file_size(pack->file))) {
+            FURI_LOG_E(TAG, "Pack \'%s\' is damaged", path);
+            break;
+        }
+
+        result = true;
+    } while(0);
+
+    furi_string_free(filename);
+
+    if(!result) {
+        storage_file_free(pack->file);
+        free(pack->index);
+        free(pack);
+        return NULL;
+    }
+
+    pack->buffer = malloc(bitmap_size + ANIMATION_PACK_ICON_HEADER_SIZE);
+    pack->compress_icon = compress_icon_alloc();
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        pack->ring_frame[i] = -1;
+        pack->ring[i] = malloc(bitmap_size + 1);
+    }
+
+    return pack;
+}
+
+void animation_pack_free(AnimationPack* pack) {
+    furi_assert(pack);
+
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        free(pack->ring[i]);
+    }
+    compress_icon_free(pack->compress_icon);
+    free(pack->buffer);
+    free(pack->index);
+    storage_file_free(pack->file);
+    free(pack);
+}
+
+const uint8_t* animation_pack_get_frame(AnimationPack* pack, uint8_t index) {
+    furi_assert(pack);
+    furi_assert(index < pack->frame_count);
+
+    for(size_t i = 0; i < ANIMATION_PACK_RING_SIZE; i++) {
+        if(pack->ring_frame[i] == index) {
+            return pack->ring[i];
+        }
+    }
+
+    uint8_t slot = pack->ring_next;
+    uint8_t* frame = pack->ring[slot];
+    uint32_t size = pack->index[index + 1] - pack->index[index];
+
+    if(!storage_file_seek(pack->file, pack->index[index], true) ||
+       (storage_file_read(pack->file, pack->buffer, size) != size)) {
+        FURI_LOG_E(TAG, "Failed to read frame %u", index);
+        return NULL;
+    }
+
+    uint16_t payload_size = 0;
+    memcpy(&payload_size, &pack->buffer[2], sizeof(payload_size));
+
+    if(pack->buffer[0] && (size == payload_size + ANIMATION_PACK_ICON_HEADER_SIZE)) {
+        uint8_t* decoded = NULL;
+        compress_icon_decode(pack->compress_icon, pack->buffer, &decoded);
+        memcpy(&frame[1], decoded, pack->bitmap_size);
+    } else if(!pack->buffer[0] && (size == pack->bitmap_size + 1)) {
+        memcpy(&frame[1], &pack->buffer[1], pack->bitmap_size);
+    } else {
+        FURI_LOG_E(TAG, "Frame %u is damaged", index);
+        return NULL;
+    }
+    /* Decoded bitmap, so canvas doesn't decompress it on every draw */
+    frame[0] = 0x00;
+
+    pack->ring_frame[slot] = index;
+    pack->ring_next = (slot + 1) % ANIMATION_PACK_RING_SIZE;
+
+    return frame;
+}
+
+size_t animation_pack_get_resident_size(AnimationPack* pack) {
+    furi_assert(pack);
+
+    return sizeof(AnimationPack) + sizeof(uint32_t) * (pack->frame_count + 1) +
+           pack->bitmap_size + ANIMATION_PACK_ICON_HEADER_SIZE +
+           ANIMATION_PACK_RING_SIZE * (pack->bitmap_size + 1);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <storage/storage.h>
+
+/** Packed animation frames file, lives next to meta.txt */
+#define ANIMATION_PACK_FILE "frames.pack"
+
+/**
+ * Packed animation frames.
+ * Pack is a single file with frame index and frames stored
+ * as icon bitmaps (heatshrink compressed when it pays off).
+ * Frames are read and decoded on demand into small ring,
+ * so only few decoded frames are resident during playback.
+ */
+typedef struct AnimationPack AnimationPack;
+
+/**
+ * Check that pack in animation directory is present and
+ * is not older than frame_N.bm files it was built from.
+ *
+ * @storage     storage instance
+ * @path        animation directory
+ * @frame_count expected frame count
+ * @return      true if pack can be used as is
+ */
+bool animation_pack_is_actual(Storage* storage, const char* path, uint8_t frame_count);
+
+/**
+ * Build pack from frame_N.bm files of animation directory.
+ * Pack is written to temporary file and renamed when complete,
+ * original frame files are left untouched.
+ *
+ * @storage     storage instance
+ * @path        animation directory
+ * @frame_count frame count
+ * @width       frame width
+ * @height      frame height
+ * @return      true on success
+ */
+bool animation_pack_build(
+    Storage* storage,
+    const char* path,
+    uint8_t frame_count,
+    uint8_t width,
+    uint8_t height);
+
+/**
+ * Open pack of animation directory.
+ * File stays open until animation_pack_free().
+ *
+ * @storage     storage instance
+ * @path        animation directory
+ * @frame_count expected frame count
+ * @width       expected frame width
+ * @height      expected frame height
+ * @return      pack instance, NULL if pack is missing or damaged
+ */
+AnimationPack* animation_pack_alloc(
+    Storage* storage,
+    const char* path,
+    uint8_t frame_count,
+    uint8_t width,
+    uint8_t height);
+
+/**
+ * Close pack and free decode ring.
+ *
+ * @pack        pack instance
+ */
+void animation_pack_free(AnimationPack* pack);
+
+/**
+ * Get frame bitmap, reads and decodes it if it's not in ring.
+ * Returned bitmap is uncompressed icon data and stays valid until
+ * ring slot is reused by following calls.
+ *
+ * @pack        pack instance
+ * @index       frame index
+ * @return      icon bitmap, NULL if read failed
+ */
+const uint8_t* animation_pack_get_frame(AnimationPack* pack, uint8_t index);
+
+/**
+ * Get memory held by pack: index and decode ring. Icon decoder and file
+ * handle are not counted, host bench desktop_animation measures the total.
+ *
+ * @pack        pack instance
+ * @return      size in bytes
+ */
+size_t animation_pack_get_resident_size(AnimationPack* pack);
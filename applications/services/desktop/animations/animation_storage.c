@@ -252,7 +252,14 @@ static bool animation_storage_cast_align(FuriString* align_str, Align* align) {
 static void animation_storage_free_frames(BubbleAnimation* animation) {
     furi_assert(animation);
 
-    const Icon* icon = &animation->icon_animation;
+    if(animation->pack) {
+        animation_pack_free(animation->pack);
+        animation->pack = NULL;
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    if(!icon->frames) return;
+
     for(int i = 0; i < icon->frame_count; ++i) {
         if(icon->frames[i]) {
             free((void*)icon->frames[i]);
@@ -260,35 +267,31 @@ static void animation_storage_free_frames(BubbleAnimation* animation) {
     }
 
     free((void*)icon->frames);
+    icon->frames = NULL;
 }
 
-static bool animation_storage_load_frames(
+const uint8_t* animation_storage_get_frame(const BubbleAnimation* animation, uint8_t index) {
+    furi_assert(animation);
+    furi_assert(index < animation->icon_animation.frame_count);
+
+    if(animation->pack) {
+        return animation_pack_get_frame(animation->pack, index);
+    }
+    return animation->icon_animation.frames[index];
+}
+
+/* Fallback for SD-card we can't write pack to: all frames are resident */
+static bool animation_storage_load_frame_files(
     Storage* storage,
     const char* name,
     BubbleAnimation* animation,
-    uint32_t* frame_order,
     uint8_t width,
     uint8_t height) {
-    uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
-
-    /* The frames should go in order (0...N), without omissions */
-    size_t max_frame_count = 0;
-    for(int i = 0; i < frame_order_count; ++i) {
-        max_frame_count = MAX(max_frame_count, frame_order[i]);
-    }
-
-    if((max_frame_count >= frame_order_count) || (max_frame_count >= 256 /* max uint8_t */)) {
-        return false;
-    }
-
     Icon* icon = (Icon*)&animation->icon_animation;
-    FURI_CONST_ASSIGN(icon->frame_count, max_frame_count + 1);
-    FURI_CONST_ASSIGN(icon->frame_rate, 0);
-    FURI_CONST_ASSIGN(icon->height, height);
-    FURI_CONST_ASSIGN(icon->width, width);
     icon->frames = malloc(sizeof(const uint8_t*) * icon->frame_count);
 
     bool frames_ok = false;
+
     File* file = storage_file_alloc(storage);
     FileInfo file_info;
     FuriString* filename;
@@ -348,6 +351,63 @@ static bool animation_storage_load_frames(
     return frames_ok;
 }
 
+static bool animation_storage_load_frames(
+    Storage* storage,
+    const char* name,
+    BubbleAnimation* animation,
+    uint32_t* frame_order,
+    uint8_t width,
+    uint8_t height) {
+    uint16_t frame_order_count = animation->passive_frames + animation->active_frames;
+
+    /* The frames should go in order (0...N), without omissions */
+    size_t max_frame_count = 0;
+    for(int i = 0; i < frame_order_count; ++i) {
+        max_frame_count = MAX(max_frame_count, frame_order[i]);
+    }
+
+    if((max_frame_count >= frame_order_count) || (max_frame_count >= 256 /* max uint8_t */)) {
+        return false;
+    }
+
+    Icon* icon = (Icon*)&animation->icon_animation;
+    FURI_CONST_ASSIGN(icon->frame_count, max_frame_count + 1);
+    FURI_CONST_ASSIGN(icon->frame_rate, 0);
+    FURI_CONST_ASSIGN(icon->height, height);
+    FURI_CONST_ASSIGN(icon->width, width);
+    icon->frames = NULL;
+
+    uint32_t start = furi_get_tick();
+    FuriString* path = furi_string_alloc_printf(ANIMATION_DIR "/%s", name);
+    const char* path_cstr = furi_string_get_cstr(path);
+
+    AnimationPack* pack = NULL;
+    if(animation_pack_is_actual(storage, path_cstr, icon->frame_count)) {
+        pack = animation_pack_alloc(storage, path_cstr, icon->frame_count, width, height);
+    }
+    if(!pack && animation_pack_build(storage, path_cstr, icon->frame_count, width, height)) {
+        pack = animation_pack_alloc(storage, path_cstr, icon->frame_count, width, height);
+    }
+    furi_string_free(path);
+
+    bool frames_ok = false;
+    if(pack) {
+        animation->pack = pack;
+        frames_ok = true;
+        FURI_LOG_I(
+            TAG,
+            "Streaming \'%s\': %u frames, %u bytes resident, %lums",
+            name,
+            icon->frame_count,
+            animation_pack_get_resident_size(pack),
+            furi_get_tick() - start);
+    } else {
+        frames_ok = animation_storage_load_frame_files(storage, name, animation, width, height);
+    }
+
+    return frames_ok;
+}
+
 static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFormat* ff) {
     uint32_t u32value;
     FuriString* str;
@@ -500,6 +560,7 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
     }
 
     if(!success) { //-V547
+        animation_storage_free_frames(animation);
         if(animation->frame_order) {
             free((void*)animation->frame_order);
         }
@@ -46,6 +46,18 @@ void animation_storage_fill_animation_list(StorageAnimationList_t* list);
  */
 const BubbleAnimation* animation_storage_get_bubble_animation(StorageAnimation* storage_animation);
 
+/**
+ * Get frame bitmap of bubble animation.
+ * Frames of packed animations are read from SD-card on demand,
+ * returned bitmap is valid until next frame of the same
+ * animation is requested.
+ *
+ * @animation   bubble animation
+ * @index       frame index
+ * @return      frame bitmap, NULL if failed to read
+ */
+const uint8_t* animation_storage_get_frame(const BubbleAnimation* animation, uint8_t index);
+
 /**
  * Performs caching animation data (Bubble Animation)
  * if this is not done yet.
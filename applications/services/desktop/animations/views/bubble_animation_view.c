@@ -76,8 +76,10 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame = animation_storage_get_frame(animation, index);
+    if(frame) {
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -236,6 +238,10 @@ static void bubble_animation_timer_callback(void* context) {
 
     if(!model->freeze_frame && !activate) {
         bubble_animation_next_frame(model);
+        /* Read streamed frame here rather than in GUI thread on draw */
+        if(model->current) {
+            animation_storage_get_frame(model->current, bubble_animation_get_frame_index(model));
+        }
     }
 
     view_commit_model(view->view, !activate);
@@ -249,10 +255,10 @@ static void bubble_animation_timer_callback(void* context) {
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
+    const uint8_t* frame = animation_storage_get_frame(animation, 0);
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -264,8 +270,14 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      * for compressed header
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
-    FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    uint8_t* bitmap = malloc(max_bitmap_size);
+    if(frame) {
+        memcpy(bitmap, frame, max_bitmap_size);
+    } else {
+        /* Streamed frame failed to read: blank uncompressed bitmap */
+        memset(bitmap, 0, max_bitmap_size);
+    }
+    FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], bitmap);
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -378,7 +390,7 @@ void bubble_animation_freeze(BubbleAnimationView* view) {
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->current);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    model->freeze_frame = bubble_animation_clone_first_frame(model->current);
     model->current = NULL;
     view_commit_model(view->view, false);
     furi_timer_stop(view->timer);
@@ -24,10 +24,12 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init() {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc();
+    CanvasIconCacheArray_init(canvas->icon_cache.items);
 
     // Setup u8g2
     u8g2_Setup_st756x_flipper(&canvas->fb, U8G2_R0, u8x8_hw_spi_stm32, u8g2_gpio_and_delay_stm32);
     canvas->orientation = CanvasOrientationHorizontal;
+    canvas->committed = malloc(canvas_get_buffer_size(canvas));
     // Initialize display
     u8g2_InitDisplay(&canvas->fb);
     // Wake up display
@@ -43,12 +45,177 @@ Canvas* canvas_init() {
 void canvas_free(Canvas* canvas) {
     furi_assert(canvas);
     compress_icon_free(canvas->compress_icon);
+    for
+        M_EACH(item, canvas->icon_cache.items, CanvasIconCacheArray_t) {
+            free(*item);
+        }
+    CanvasIconCacheArray_clear(canvas->icon_cache.items);
+    free(canvas->committed);
     free(canvas);
 }
 
+struct CanvasIconCacheItem {
+    const uint8_t* data;
+    size_t size;
+    uint8_t pin_count;
+    uint8_t bitmap[];
+};
+
+static size_t canvas_icon_bitmap_size(uint8_t width, uint8_t height) {
+    return ((width + 7) / 8) * height;
+}
+
+static bool canvas_icon_cache_is_static(const uint8_t* data) {
+    // Data loaded to RAM can be freed and its address reused, firmware image can't
+    const uint8_t* start = (const uint8_t*)furi_hal_flash_get_base();
+    const uint8_t* end = furi_hal_flash_get_free_start_address();
+    return (data >= start) && (data < end);
+}
+
+static CanvasIconCacheItem* canvas_icon_cache_find(
+    CanvasIconCache* cache,
+    const uint8_t* data,
+    size_t bitmap_size) {
+    size_t count = CanvasIconCacheArray_size(cache->items);
+    for(size_t i = 0; i < count; i++) {
+        CanvasIconCacheItem* item = *CanvasIconCacheArray_get(cache->items, i);
+        if(item->data != data) continue;
+        // Same data drawn as a bigger bitmap, decode again
+        if(item->size - sizeof(CanvasIconCacheItem) < bitmap_size) return NULL;
+        if(i > 0) {
+            CanvasIconCacheArray_pop_at(&item, cache->items, i);
+            CanvasIconCacheArray_push_at(cache->items, 0, item);
+        }
+        return item;
+    }
+    return NULL;
+}
+
+static void canvas_icon_cache_trim(CanvasIconCache* cache, size_t limit) {
+    size_t i = CanvasIconCacheArray_size(cache->items);
+    while((i > 0) && (cache->size - cache->pinned_size > limit)) {
+        i--;
+        CanvasIconCacheItem* item = *CanvasIconCacheArray_get(cache->items, i);
+        if(item->pin_count) continue;
+        CanvasIconCacheArray_pop_at(&item, cache->items, i);
+        cache->size -= item->size;
+        free(item);
+    }
+}
+
+static CanvasIconCacheItem* canvas_icon_cache_add(
+    CanvasIconCache* cache,
+    const uint8_t* data,
+    const uint8_t* bitmap,
+    size_t bitmap_size) {
+    // Replace item decoded for a smaller bitmap
+    size_t count = CanvasIconCacheArray_size(cache->items);
+    for(size_t i = 0; i < count; i++) {
+        CanvasIconCacheItem* item = *CanvasIconCacheArray_get(cache->items, i);
+        if((item->data == data) && !item->pin_count) {
+            CanvasIconCacheArray_pop_at(&item, cache->items, i);
+            cache->size -= item->size;
+            free(item);
+            break;
+        }
+    }
+
+    size_t size = sizeof(CanvasIconCacheItem) + bitmap_size;
+    canvas_icon_cache_trim(cache, CANVAS_ICON_CACHE_SIZE - MIN(size, CANVAS_ICON_CACHE_SIZE));
+
+    CanvasIconCacheItem* item = malloc(size);
+    item->data = data;
+    item->size = size;
+    memcpy(item->bitmap, bitmap, bitmap_size);
+    CanvasIconCacheArray_push_at(cache->items, 0, item);
+    cache->size += size;
+    return item;
+}
+
+static const uint8_t* canvas_icon_decode(
+    Canvas* canvas,
+    const uint8_t* data,
+    uint8_t width,
+    uint8_t height) {
+    CanvasIconCache* cache = &canvas->icon_cache;
+    size_t bitmap_size = canvas_icon_bitmap_size(width, height);
+
+    CanvasIconCacheItem* item = canvas_icon_cache_find(cache, data, bitmap_size);
+    if(item) {
+        cache->hits++;
+        return item->bitmap;
+    }
+
+    uint8_t* bitmap = NULL;
+    compress_icon_decode(canvas->compress_icon, data, &bitmap);
+    // Not compressed data is drawn in place
+    if(bitmap == &data[1]) return bitmap;
+
+    cache->misses++;
+    if((bitmap_size <= CANVAS_ICON_CACHE_ITEM_SIZE_MAX) && canvas_icon_cache_is_static(data)) {
+        canvas_icon_cache_add(cache, data, bitmap, bitmap_size);
+    }
+    return bitmap;
+}
+
+void canvas_icon_pin(Canvas* canvas, const Icon* icon) {
+    furi_assert(canvas);
+    furi_assert(icon);
+
+    CanvasIconCache* cache = &canvas->icon_cache;
+    size_t bitmap_size = canvas_icon_bitmap_size(icon->width, icon->height);
+    for(uint8_t i = 0; i < icon->frame_count; i++) {
+        const uint8_t* data = icon->frames[i];
+        CanvasIconCacheItem* item = canvas_icon_cache_find(cache, data, bitmap_size);
+        if(!item) {
+            uint8_t* bitmap = NULL;
+            compress_icon_decode(canvas->compress_icon, data, &bitmap);
+            if(bitmap == &data[1]) continue;
+            item = canvas_icon_cache_add(cache, data, bitmap, bitmap_size);
+        }
+        if(!item->pin_count) cache->pinned_size += item->size;
+        furi_check(item->pin_count < UINT8_MAX);
+        item->pin_count++;
+    }
+}
+
+void canvas_icon_unpin(Canvas* canvas, const Icon* icon) {
+    furi_assert(canvas);
+    furi_assert(icon);
+
+    CanvasIconCache* cache = &canvas->icon_cache;
+    for(uint8_t i = 0; i < icon->frame_count; i++) {
+        const uint8_t* data = icon->frames[i];
+        size_t count = CanvasIconCacheArray_size(cache->items);
+        for(size_t j = 0; j < count; j++) {
+            CanvasIconCacheItem* item = *CanvasIconCacheArray_get(cache->items, j);
+            if((item->data != data) || !item->pin_count) continue;
+            item->pin_count--;
+            if(!item->pin_count) {
+                cache->pinned_size -= item->size;
+                // Icon from application RAM may be freed right after unpin
+                if(!canvas_icon_cache_is_static(data)) {
+                    CanvasIconCacheArray_pop_at(&item, cache->items, j);
+                    cache->size -= item->size;
+                    free(item);
+                }
+            }
+            break;
+        }
+    }
+
+    canvas_icon_cache_trim(cache, CANVAS_ICON_CACHE_SIZE);
+}
+
+void canvas_icon_cache_clear(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas_icon_cache_trim(&canvas->icon_cache, 0);
+}
+
 void canvas_reset(Canvas* canvas) {
     furi_assert(canvas);
 
+    u8g2_SetMaxClipWindow(&canvas->fb);
     canvas_clear(canvas);
 
     canvas_set_color(canvas, ColorBlack);
@@ -56,9 +223,73 @@ void canvas_reset(Canvas* canvas) {
     canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
 }
 
+void canvas_reset_region(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    furi_assert(canvas);
+
+    u8g2_SetMaxClipWindow(&canvas->fb);
+    canvas_set_color(canvas, ColorWhite);
+    u8g2_DrawBox(&canvas->fb, x, y, width, height);
+    u8g2_SetClipWindow(&canvas->fb, x, y, x + width, y + height);
+
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontSecondary);
+    canvas_set_font_direction(canvas, CanvasDirectionLeftToRight);
+}
+
 void canvas_commit(Canvas* canvas) {
     furi_assert(canvas);
-    u8g2_SendBuffer(&canvas->fb);
+
+    uint8_t* buffer = canvas_get_buffer(canvas);
+    uint8_t tile_width = u8g2_GetBufferTileWidth(&canvas->fb);
+    uint8_t tile_height = u8g2_GetBufferTileHeight(&canvas->fb);
+    size_t page_size = tile_width * 8;
+    uint8_t x_start = UINT8_MAX;
+    uint8_t x_end = 0;
+
+    canvas->damage.pages = 0;
+    for(uint8_t page = 0; page < tile_height; page++) {
+        const uint8_t* data = &buffer[page * page_size];
+        uint8_t* committed = &canvas->committed[page * page_size];
+
+        // Find changed columns, display is updated with 8 column tiles
+        size_t start = 0;
+        size_t end = page_size;
+        if(canvas->committed_valid) {
+            while((start < page_size) && (data[start] == committed[start])) start++;
+            if(start == page_size) continue;
+            while(data[end - 1] == committed[end - 1]) end--;
+        }
+
+        uint8_t tile_start = start / 8;
+        uint8_t tile_count = (end + 7) / 8 - tile_start;
+        u8g2_UpdateDisplayArea(&canvas->fb, tile_start, page, tile_count, 1);
+        memcpy(&committed[tile_start * 8], &data[tile_start * 8], tile_count * 8);
+        canvas->committed_bytes += tile_count * 8;
+
+        canvas->damage.pages |= 1 << page;
+        x_start = MIN(x_start, (uint8_t)start);
+        x_end = MAX(x_end, (uint8_t)(end - 1));
+    }
+
+    if(canvas->damage.pages) {
+        canvas->damage.x = x_start;
+        canvas->damage.width = x_end - x_start + 1;
+        u8x8_RefreshDisplay(u8g2_GetU8x8(&canvas->fb));
+    } else {
+        canvas->damage.x = 0;
+        canvas->damage.width = 0;
+    }
+    canvas->committed_valid = true;
+}
+
+void canvas_invalidate(Canvas* canvas) {
+    furi_assert(canvas);
+    canvas->committed_valid = false;
+}
+
+const CanvasDamage* canvas_get_damage(const Canvas* canvas) {
+    furi_assert(canvas);
+    return &canvas->damage;
 }
 
 uint8_t* canvas_get_buffer(Canvas* canvas) {
@@ -118,10 +349,22 @@ const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font fo
 
 void canvas_clear(Canvas* canvas) {
     furi_assert(canvas);
-    if(CFW_SETTINGS()->dark_mode) {
-        u8g2_FillBuffer(&canvas->fb);
+    u8g2_t* fb = &canvas->fb;
+    bool dark_mode = CFW_SETTINGS()->dark_mode;
+
+    if(fb->clip_x0 == 0 && fb->clip_y0 == 0 && fb->clip_x1 >= u8g2_GetDisplayWidth(fb) &&
+       fb->clip_y1 >= u8g2_GetDisplayHeight(fb)) {
+        if(dark_mode) {
+            u8g2_FillBuffer(fb);
+        } else {
+            u8g2_ClearBuffer(fb);
+        }
     } else {
-        u8g2_ClearBuffer(&canvas->fb);
+        // Partial redraw: keep pixels outside of the redrawn region
+        uint8_t color = u8g2_GetDrawColor(fb);
+        u8g2_SetDrawColor(fb, dark_mode ? 1 : 0);
+        u8g2_DrawBox(fb, 0, 0, u8g2_GetDisplayWidth(fb), u8g2_GetDisplayHeight(fb));
+        u8g2_SetDrawColor(fb, color);
     }
 }
 
@@ -259,8 +502,7 @@ void canvas_draw_bitmap(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* bitmap_data = NULL;
-    compress_icon_decode(canvas->compress_icon, compressed_bitmap_data, &bitmap_data);
+    const uint8_t* bitmap_data = canvas_icon_decode(canvas, compressed_bitmap_data, width, height);
     canvas_draw_u8g2_bitmap(&canvas->fb, x, y, width, height, bitmap_data, IconRotation0);
 }
 
@@ -274,9 +516,11 @@ void canvas_draw_icon_animation(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(
-        canvas->compress_icon, icon_animation_get_data(icon_animation), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas,
+        icon_animation_get_data(icon_animation),
+        icon_animation_get_width(icon_animation),
+        icon_animation_get_height(icon_animation));
     canvas_draw_u8g2_bitmap(
         &canvas->fb,
         x,
@@ -360,6 +604,210 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
+/** Pixel operations for set and unset bitmap bits, every mask is 0x00 or 0xFF */
+typedef struct {
+    uint8_t fg_or;
+    uint8_t fg_xor;
+    uint8_t bg_or;
+    uint8_t bg_xor;
+} CanvasBlitOp;
+
+typedef struct {
+    uint8_t* buffer;
+    uint16_t stride;
+    uint16_t row_offset;
+    CanvasBlitOp op;
+    /* Clip box in display coordinates, x1 and y1 excluded */
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} CanvasBlit;
+
+/* Same as u8g2_ll_hvline_vertical_top_lsb per pixel: or, then xor */
+static inline void canvas_blit_byte(
+    const CanvasBlit* blit,
+    uint8_t* ptr,
+    uint8_t bits,
+    uint8_t valid) {
+    uint8_t set = bits & valid;
+    uint8_t unset = ~bits & valid;
+    uint8_t or_mask = (set & blit->op.fg_or) | (unset & blit->op.bg_or);
+    uint8_t xor_mask = (set & blit->op.fg_xor) | (unset & blit->op.bg_xor);
+    *ptr = (*ptr | or_mask) ^ xor_mask;
+}
+
+static inline uint8_t* canvas_blit_page(const CanvasBlit* blit, int16_t y) {
+    return blit->buffer + ((y - blit->row_offset) >> 3) * blit->stride;
+}
+
+/** Transpose 8x8 bit matrix: bit j of byte k becomes bit k of byte j */
+static inline uint64_t canvas_blit_transpose(uint64_t m) {
+    uint64_t t;
+    t = (m ^ (m >> 7)) & 0x00AA00AA00AA00AAULL;
+    m ^= t ^ (t << 7);
+    t = (m ^ (m >> 14)) & 0x0000CCCC0000CCCCULL;
+    m ^= t ^ (t << 14);
+    t = (m ^ (m >> 28)) & 0x00000000F0F0F0F0ULL;
+    m ^= t ^ (t << 28);
+    return m;
+}
+
+/* Bitmap rows are horizontal: 8 rows landing in one display page are transposed into columns */
+static void canvas_blit_rows(
+    const CanvasBlit* blit,
+    int16_t x,
+    int16_t y,
+    uint8_t h,
+    uint8_t blen,
+    bool flip,
+    const uint8_t* bitmap) {
+    const uint8_t* rows[8];
+
+    for(int16_t page_y = blit->y0 & ~7; page_y < blit->y1; page_y += 8) {
+        uint8_t valid = 0;
+        for(uint8_t k = 0; k < 8; k++) {
+            int16_t sy = page_y + k;
+            if(sy < blit->y0 || sy >= blit->y1) continue;
+            valid |= 1 << k;
+            rows[k] = bitmap + (flip ? (y + h - 1 - sy) : (sy - y)) * blen;
+        }
+
+        uint8_t* page = canvas_blit_page(blit, page_y);
+        for(int16_t chunk_x = x + ((blit->x0 - x) & ~7); chunk_x < blit->x1; chunk_x += 8) {
+            uint8_t chunk = (chunk_x - x) >> 3;
+            uint64_t m = 0;
+            for(uint8_t k = 0; k < 8; k++) {
+                if(valid & (1 << k)) {
+                    m |= (uint64_t)u8x8_pgm_read(rows[k] + chunk) << (k * 8);
+                }
+            }
+            m = canvas_blit_transpose(m);
+
+            int16_t sx = MAX(chunk_x, blit->x0);
+            int16_t sx_end = MIN(chunk_x + 8, blit->x1);
+            for(; sx < sx_end; sx++) {
+                canvas_blit_byte(blit, &page[sx], m >> ((sx - chunk_x) * 8), valid);
+            }
+        }
+    }
+}
+
+/* Bitmap rows are vertical: row bytes already have display page bit order, only shifted */
+static void canvas_blit_columns(
+    const CanvasBlit* blit,
+    int16_t x,
+    int16_t y,
+    uint8_t blen,
+    bool flip,
+    const uint8_t* bitmap) {
+    int16_t c_begin = blit->y0 - y;
+    int16_t c_end = blit->y1 - y;
+
+    for(int16_t sx = blit->x0; sx < blit->x1; sx++) {
+        const uint8_t* row = bitmap + (flip ? (x - sx) : (sx - x)) * blen;
+        for(int16_t c = c_begin & ~7; c < c_end; c += 8) {
+            uint8_t valid = 0xFF;
+            if(c < c_begin) valid &= 0xFF << (c_begin - c);
+            if(c + 8 > c_end) valid &= 0xFF >> (c + 8 - c_end);
+
+            int16_t sy = y + c;
+            uint8_t shift = (sy - blit->row_offset) & 7;
+            uint16_t bits = (uint16_t)u8x8_pgm_read(row + (c >> 3)) << shift;
+            uint16_t mask = (uint16_t)valid << shift;
+
+            uint8_t* page = canvas_blit_page(blit, sy);
+            canvas_blit_byte(blit, &page[sx], bits, mask);
+            if(mask >> 8) {
+                canvas_blit_byte(blit, &page[sx + blit->stride], bits >> 8, mask >> 8);
+            }
+        }
+    }
+}
+
+/** Draw bitmap directly into page buffer
+ *
+ * Produces exactly the same pixels as canvas_draw_u8g2_bitmap_int, including its placement
+ * of rotated bitmaps. Returns false if display rotation is used or coordinates wrap around,
+ * such cases are left to the per pixel implementation.
+ */
+static bool canvas_blit_bitmap(
+    u8g2_t* u8g2,
+    u8g2_uint_t x,
+    u8g2_uint_t y,
+    u8g2_uint_t w,
+    u8g2_uint_t h,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+    if(u8g2->cb != U8G2_R0) return false;
+
+    // Area covered on display, before clipping
+    int16_t area_x = x;
+    int16_t area_y = y;
+    int16_t area_w = w;
+    int16_t area_h = h;
+    if(rotation == IconRotation90 || rotation == IconRotation270) {
+        FURI_SWAP(area_w, area_h);
+    }
+    if(rotation == IconRotation90) {
+        // Rightmost column is x + w + 1, computed in u8g2_uint_t
+        if(x + w + 1 > UINT8_MAX) return false;
+        area_x = x + w + 2 - h;
+        if(area_x < 0) return false;
+    } else if(rotation == IconRotation180) {
+        if(y + h - 1 > UINT8_MAX) return false;
+    } else if(rotation != IconRotation0 && rotation != IconRotation270) {
+        return false;
+    }
+    if(area_x + area_w > UINT8_MAX + 1 || area_y + area_h > UINT8_MAX + 1) return false;
+
+    if(w == 0 || h == 0) return true;
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+    if(u8g2->is_page_clip_window_intersection == 0) return true;
+#endif
+
+    CanvasBlit blit = {
+        .buffer = u8g2->tile_buf_ptr,
+        .stride = u8g2_GetBufferTileWidth(u8g2) * 8,
+        .row_offset = u8g2->pixel_curr_row,
+        .x0 = MAX(area_x, (int16_t)u8g2->user_x0),
+        .y0 = MAX(area_y, (int16_t)u8g2->user_y0),
+        .x1 = MIN(area_x + area_w, (int16_t)u8g2->user_x1),
+        .y1 = MIN(area_y + area_h, (int16_t)u8g2->user_y1),
+    };
+    if(blit.x0 >= blit.x1 || blit.y0 >= blit.y1) return true;
+
+    // Unset pixels are drawn with inverted color, xor mode clears them
+    uint8_t color = u8g2->draw_color;
+    uint8_t ncolor = (color == 0 ? 1 : 0);
+    blit.op.fg_or = (color <= 1) ? 0xFF : 0x00;
+    blit.op.fg_xor = (color != 1) ? 0xFF : 0x00;
+    if(u8g2->bitmap_transparency == 0) {
+        blit.op.bg_or = (ncolor <= 1) ? 0xFF : 0x00;
+        blit.op.bg_xor = (ncolor != 1) ? 0xFF : 0x00;
+    }
+
+    // Same row length as canvas_draw_u8g2_bitmap_int, including u8g2_uint_t overflow
+    u8g2_uint_t blen = w + 7;
+    blen >>= 3;
+    switch(rotation) {
+    case IconRotation0:
+        canvas_blit_rows(&blit, x, y, h, blen, false, bitmap);
+        break;
+    case IconRotation90:
+        canvas_blit_columns(&blit, x + w + 1, y, blen, true, bitmap);
+        break;
+    case IconRotation180:
+        canvas_blit_rows(&blit, x, y, h, blen, true, bitmap);
+        break;
+    default:
+        canvas_blit_columns(&blit, x, y, blen, false, bitmap);
+        break;
+    }
+
+    return true;
+}
+
 void canvas_draw_u8g2_bitmap(
     u8g2_t* u8g2,
     u8g2_uint_t x,
@@ -376,6 +824,8 @@ void canvas_draw_u8g2_bitmap(
     if(u8g2_IsIntersection(u8g2, x, y, x + w, y + h) == 0) return;
 #endif /* U8G2_WITH_INTERSECTION */
 
+    if(canvas_blit_bitmap(u8g2, x, y, w, h, bitmap, rotation)) return;
+
     switch(rotation) {
     case IconRotation0:
         canvas_draw_u8g2_bitmap_int(u8g2, x, y, w, h, 0, 0, bitmap);
@@ -405,8 +855,8 @@ void canvas_draw_icon_ex(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas, icon_get_data(icon), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, rotation);
 }
@@ -417,8 +867,8 @@ void canvas_draw_icon(Canvas* canvas, uint8_t x, uint8_t y, const Icon* icon) {
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas, icon_get_data(icon), icon_get_width(icon), icon_get_height(icon));
     canvas_draw_u8g2_bitmap(
         &canvas->fb, x, y, icon_get_width(icon), icon_get_height(icon), icon_data, IconRotation0);
 }
@@ -552,8 +1002,8 @@ void canvas_draw_icon_bitmap(
 
     x += canvas->offset_x;
     y += canvas->offset_y;
-    uint8_t* icon_data = NULL;
-    compress_icon_decode(canvas->compress_icon, icon_get_data(icon), &icon_data);
+    const uint8_t* icon_data = canvas_icon_decode(
+        canvas, icon_get_data(icon), icon_get_width(icon), icon_get_height(icon));
     u8g2_DrawXBM(&canvas->fb, x, y, w, h, icon_data);
 }
 
@@ -89,6 +89,17 @@ typedef enum {
     IconRotation270,
 } IconRotation;
 
+/** Part of canvas buffer changed by last commit
+ *
+ * Buffer and display memory are split into 8 pixel high pages, coordinates are
+ * in buffer space, without canvas orientation applied.
+ */
+typedef struct {
+    uint8_t pages; /**< Changed pages bit mask, 0 if nothing changed */
+    uint8_t x; /**< First changed column */
+    uint8_t width; /**< Changed columns count */
+} CanvasDamage;
+
 /** Canvas anonymous structure */
 typedef struct Canvas Canvas;
 
@@ -99,6 +110,8 @@ typedef struct Canvas Canvas;
 void canvas_reset(Canvas* canvas);
 
 /** Commit canvas. Send buffer to display
+ *
+ * Only display pages changed since previous commit are sent.
  *
  * @param      canvas  Canvas instance
  */
@@ -146,6 +159,8 @@ uint8_t canvas_current_font_width(const Canvas* canvas);
 const CanvasFontParameters* canvas_get_font_params(const Canvas* canvas, Font font);
 
 /** Clear canvas
+ *
+ * On partial redraw only the redrawn region is cleared.
  *
  * @param      canvas  Canvas instance
  */
@@ -8,11 +8,32 @@
 #include "canvas.h"
 #include <u8g2.h>
 #include <toolbox/compress.h>
+#include <m-array.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Total size of not pinned decoded icons, bytes */
+#define CANVAS_ICON_CACHE_SIZE (2048)
+/** Bigger decoded frames are cached only when pinned, so animations don't flush the cache */
+#define CANVAS_ICON_CACHE_ITEM_SIZE_MAX (512)
+
+typedef struct CanvasIconCacheItem CanvasIconCacheItem;
+
+ARRAY_DEF(CanvasIconCacheArray, CanvasIconCacheItem*, M_PTR_OPLIST);
+
+#define M_OPL_CanvasIconCacheArray_t() ARRAY_OPLIST(CanvasIconCacheArray, M_PTR_OPLIST)
+
+/** Decoded icon frames cache, most recently used first */
+typedef struct {
+    CanvasIconCacheArray_t items;
+    size_t size;
+    size_t pinned_size;
+    uint32_t hits;
+    uint32_t misses;
+} CanvasIconCache;
+
 /** Canvas structure
  */
 struct Canvas {
@@ -23,6 +44,11 @@ struct Canvas {
     uint8_t width;
     uint8_t height;
     CompressIcon* compress_icon;
+    CanvasIconCache icon_cache;
+    uint8_t* committed;
+    bool committed_valid;
+    CanvasDamage damage;
+    uint32_t committed_bytes;
 };
 
 /** Allocate memory and initialize canvas
@@ -53,6 +79,33 @@ uint8_t* canvas_get_buffer(Canvas* canvas);
  */
 size_t canvas_get_buffer_size(const Canvas* canvas);
 
+/** Reset canvas drawing tools configuration and clear region
+ *
+ * Like canvas_reset, but only the region is cleared and all drawing is
+ * clipped to it until next canvas_reset.
+ *
+ * @param      canvas  Canvas instance
+ * @param      x       x coordinate
+ * @param      y       y coordinate
+ * @param      width   width
+ * @param      height  height
+ */
+void canvas_reset_region(Canvas* canvas, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/** Send whole buffer on next commit
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_invalidate(Canvas* canvas);
+
+/** Get damage of last commit
+ *
+ * @param      canvas  Canvas instance
+ *
+ * @return     CanvasDamage instance
+ */
+const CanvasDamage* canvas_get_damage(const Canvas* canvas);
+
 /** Set drawing region relative to real screen buffer
  *
  * @param      canvas    Canvas instance
@@ -102,6 +155,30 @@ void canvas_draw_u8g2_bitmap(
     const uint8_t* bitmap,
     uint8_t rotation);
 
+/** Pin all icon frames in decoded icon cache
+ *
+ * Pinned frames are decoded once and never evicted until unpinned. Calls are
+ * counted, every pin must be paired with unpin. Frames outside of firmware
+ * image are dropped as soon as the last pin is released.
+ *
+ * @param      canvas  Canvas instance
+ * @param      icon    Icon instance
+ */
+void canvas_icon_pin(Canvas* canvas, const Icon* icon);
+
+/** Unpin icon frames pinned with canvas_icon_pin
+ *
+ * @param      canvas  Canvas instance
+ * @param      icon    Icon instance
+ */
+void canvas_icon_unpin(Canvas* canvas, const Icon* icon);
+
+/** Drop all not pinned frames from decoded icon cache
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_icon_cache_clear(Canvas* canvas);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,12 @@
 
 #define TAG "GuiSrv"
 
+static const ViewPortRect gui_status_bar_rect = {
+    GUI_STATUS_BAR_X,
+    GUI_STATUS_BAR_Y,
+    GUI_STATUS_BAR_X + GUI_STATUS_BAR_WIDTH,
+    GUI_STATUS_BAR_Y + GUI_STATUS_BAR_HEIGHT};
+
 ViewPort* gui_view_port_find_enabled(ViewPortArray_t array) {
     // Iterating backward
     ViewPortArray_it_t it;
@@ -43,6 +49,12 @@ uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer) {
 }
 
 void gui_update(Gui* gui) {
+    furi_assert(gui);
+    gui->redraw_full = true;
+    if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
+}
+
+void gui_update_partial(Gui* gui) {
     furi_assert(gui);
     if(!gui->direct_draw) furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_DRAW);
 }
@@ -54,20 +66,6 @@ void gui_input_events_callback(const void* value, void* ctx) {
     Gui* gui = ctx;
 
     furi_message_queue_put(gui->input_queue, value, FuriWaitForever);
-    furi_thread_flags_set(gui->thread_id, GUI_THREAD_FLAG_INPUT);
-}
-
-// Only Fullscreen supports vertical display for now
-static bool gui_redraw_fs(Gui* gui) {
-    canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
-    canvas_frame_set(gui->canvas, 0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT);
-    ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]);
-    if(view_port) {
-        view_port_draw(view_port, gui->canvas);
-        return true;
-    } else {
-        return false;
-    }
 }
 
 static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
@@ -312,27 +310,85 @@ static void gui_redraw_status_bar(Gui* gui, bool need_attention) {
     }
 }
 
-static bool gui_redraw_window(Gui* gui) {
-    canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
-    canvas_frame_set(gui->canvas, GUI_WINDOW_X, GUI_WINDOW_Y, GUI_WINDOW_WIDTH, GUI_WINDOW_HEIGHT);
-    ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerWindow]);
-    if(view_port) {
-        view_port_draw(view_port, gui->canvas);
-        return true;
+// Find ViewPort drawn in main area, only Fullscreen supports vertical display for now
+static ViewPort* gui_find_main_view_port(Gui* gui, ViewPortRect* frame, bool* status_bar) {
+    ViewPort* view_port = NULL;
+    if(!gui->lockdown) {
+        view_port = gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]);
+        if(view_port) {
+            *frame = (ViewPortRect){0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT};
+            *status_bar = false;
+            return view_port;
+        }
+        view_port = gui_view_port_find_enabled(gui->layers[GuiLayerWindow]);
+        if(view_port) {
+            *frame = (ViewPortRect){
+                GUI_WINDOW_X,
+                GUI_WINDOW_Y,
+                GUI_WINDOW_X + GUI_WINDOW_WIDTH,
+                GUI_WINDOW_Y + GUI_WINDOW_HEIGHT};
+            *status_bar = true;
+            return view_port;
+        }
     }
-    return false;
+    *frame = (ViewPortRect){0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT};
+    *status_bar = true;
+    return gui_view_port_find_enabled(gui->layers[GuiLayerDesktop]);
+}
+
+static bool gui_rect_is_empty(const ViewPortRect* rect) {
+    return (rect->x0 >= rect->x1) || (rect->y0 >= rect->y1);
 }
 
-static bool gui_redraw_desktop(Gui* gui) {
-    canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
-    canvas_frame_set(gui->canvas, 0, 0, GUI_DISPLAY_WIDTH, GUI_DISPLAY_HEIGHT);
-    ViewPort* view_port = gui_view_port_find_enabled(gui->layers[GuiLayerDesktop]);
-    if(view_port) {
-        view_port_draw(view_port, gui->canvas);
-        return true;
+static void gui_rect_merge(ViewPortRect* rect, const ViewPortRect* other) {
+    if(gui_rect_is_empty(other)) return;
+    if(gui_rect_is_empty(rect)) {
+        *rect = *other;
+    } else {
+        rect->x0 = MIN(rect->x0, other->x0);
+        rect->y0 = MIN(rect->y0, other->y0);
+        rect->x1 = MAX(rect->x1, other->x1);
+        rect->y1 = MAX(rect->y1, other->y1);
     }
+}
 
-    return false;
+static bool gui_rect_intersects(const ViewPortRect* rect, const ViewPortRect* other) {
+    return !gui_rect_is_empty(rect) && !gui_rect_is_empty(other) && (rect->x0 < other->x1) &&
+           (other->x0 < rect->x1) && (rect->y0 < other->y1) && (other->y0 < rect->y1);
+}
+
+// Collect damage of visible ViewPorts in screen coordinates, reset damage of all ViewPorts
+static ViewPortRect gui_take_damage(
+    Gui* gui,
+    const ViewPort* main_view_port,
+    const ViewPortRect* frame,
+    bool status_bar) {
+    ViewPortRect damage = {0};
+
+    for(size_t layer = 0; layer < GuiLayerMAX; layer++) {
+        bool is_status_bar = (layer != GuiLayerDesktop) && (layer != GuiLayerWindow) &&
+                             (layer != GuiLayerFullscreen);
+        for
+            M_EACH(it, gui->layers[layer], ViewPortArray_t) {
+                ViewPort* view_port = *it;
+                ViewPortRect rect = view_port_take_damage(view_port);
+                if(gui_rect_is_empty(&rect) || !view_port_is_enabled(view_port)) continue;
+
+                if(view_port == main_view_port) {
+                    // ViewPort to screen coordinates, clipped by frame
+                    rect.x0 = MIN(frame->x0 + rect.x0, frame->x1);
+                    rect.y0 = MIN(frame->y0 + rect.y0, frame->y1);
+                    rect.x1 = MIN(frame->x0 + rect.x1, frame->x1);
+                    rect.y1 = MIN(frame->y0 + rect.y1, frame->y1);
+                    gui_rect_merge(&damage, &rect);
+                } else if(is_status_bar && status_bar) {
+                    // Status bar is auto laid out, redraw it whole
+                    gui_rect_merge(&damage, &gui_status_bar_rect);
+                }
+            }
+    }
+
+    return damage;
 }
 
 static void gui_redraw(Gui* gui) {
@@ -342,31 +398,66 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
-        canvas_reset(gui->canvas);
+        ViewPortRect frame;
+        bool status_bar;
+        ViewPort* view_port = gui_find_main_view_port(gui, &frame, &status_bar);
+        ViewPortRect damage = gui_take_damage(gui, view_port, &frame, status_bar);
+
+        // Partial redraw relies on previous frame drawn with the same layout and orientation
+        bool full = gui->redraw_full || (view_port != gui->drawn_view_port) ||
+                    (canvas_get_orientation(gui->canvas) != CanvasOrientationHorizontal) ||
+                    (view_port &&
+                     view_port_get_orientation(view_port) != ViewPortOrientationHorizontal) ||
+                    furi_hal_rtc_is_flag_set(FuriHalRtcFlagHandOrient);
+        gui->redraw_full = false;
+        gui->drawn_view_port = view_port;
+
+        if(full) {
+            canvas_reset(gui->canvas);
+        } else if(gui_rect_is_empty(&damage)) {
+            break;
+        } else {
+            canvas_reset_region(
+                gui->canvas,
+                damage.x0,
+                damage.y0,
+                damage.x1 - damage.x0,
+                damage.y1 - damage.y0);
+        }
 
-        if(gui->lockdown) {
-            gui_redraw_desktop(gui);
+        if(full || gui_rect_intersects(&damage, &frame)) {
+            canvas_set_orientation(gui->canvas, CanvasOrientationHorizontal);
+            canvas_frame_set(
+                gui->canvas, frame.x0, frame.y0, frame.x1 - frame.x0, frame.y1 - frame.y0);
+            if(view_port) view_port_draw(view_port, gui->canvas);
+        }
+
+        if(status_bar && (full || gui_rect_intersects(&damage, &gui_status_bar_rect))) {
             bool need_attention =
+                gui->lockdown &&
                 (gui_view_port_find_enabled(gui->layers[GuiLayerWindow]) != 0 ||
                  gui_view_port_find_enabled(gui->layers[GuiLayerFullscreen]) != 0);
             gui_redraw_status_bar(gui, need_attention);
-        } else {
-            if(!gui_redraw_fs(gui)) {
-                if(!gui_redraw_window(gui)) {
-                    gui_redraw_desktop(gui);
-                }
-                gui_redraw_status_bar(gui, false);
-            }
         }
 
         canvas_commit(gui->canvas);
+        const CanvasDamage* canvas_damage = canvas_get_damage(gui->canvas);
         for
             M_EACH(p, gui->canvas_callback_pair, CanvasCallbackPairArray_t) {
-                p->callback(
-                    canvas_get_buffer(gui->canvas),
-                    canvas_get_buffer_size(gui->canvas),
-                    canvas_get_orientation(gui->canvas),
-                    p->context);
+                if(p->damage_callback) {
+                    p->damage_callback(
+                        canvas_get_buffer(gui->canvas),
+                        canvas_get_buffer_size(gui->canvas),
+                        canvas_get_orientation(gui->canvas),
+                        canvas_damage,
+                        p->context);
+                } else {
+                    p->callback(
+                        canvas_get_buffer(gui->canvas),
+                        canvas_get_buffer_size(gui->canvas),
+                        canvas_get_orientation(gui->canvas),
+                        p->context);
+                }
             }
     } while(false);
 
@@ -583,31 +674,51 @@ void gui_view_port_send_to_back(Gui* gui, ViewPort* view_port) {
     gui_update(gui);
 }
 
-void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
-    furi_assert(gui);
-
-    const CanvasCallbackPair p = {callback, context};
-
+static void gui_add_canvas_callback_pair(Gui* gui, const CanvasCallbackPair p) {
     gui_lock(gui);
     furi_assert(!CanvasCallbackPairArray_count(gui->canvas_callback_pair, p));
     CanvasCallbackPairArray_push_back(gui->canvas_callback_pair, p);
+    // New callback receives whole frame first
+    canvas_invalidate(gui->canvas);
     gui_unlock(gui);
 
     // Request redraw
     gui_update(gui);
 }
 
-void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
-    furi_assert(gui);
-
-    const CanvasCallbackPair p = {callback, context};
-
+static void gui_remove_canvas_callback_pair(Gui* gui, const CanvasCallbackPair p) {
     gui_lock(gui);
     furi_assert(CanvasCallbackPairArray_count(gui->canvas_callback_pair, p) == 1);
     CanvasCallbackPairArray_remove_val(gui->canvas_callback_pair, p);
     gui_unlock(gui);
 }
 
+void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
+    furi_assert(gui);
+    gui_add_canvas_callback_pair(gui, (CanvasCallbackPair){callback, NULL, context});
+}
+
+void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context) {
+    furi_assert(gui);
+    gui_remove_canvas_callback_pair(gui, (CanvasCallbackPair){callback, NULL, context});
+}
+
+void gui_add_framebuffer_damage_callback(
+    Gui* gui,
+    GuiCanvasDamageCallback callback,
+    void* context) {
+    furi_assert(gui);
+    gui_add_canvas_callback_pair(gui, (CanvasCallbackPair){NULL, callback, context});
+}
+
+void gui_remove_framebuffer_damage_callback(
+    Gui* gui,
+    GuiCanvasDamageCallback callback,
+    void* context) {
+    furi_assert(gui);
+    gui_remove_canvas_callback_pair(gui, (CanvasCallbackPair){NULL, callback, context});
+}
+
 size_t gui_get_framebuffer_size(const Gui* gui) {
     furi_assert(gui);
     return canvas_get_buffer_size(gui->canvas);
@@ -664,6 +775,38 @@ void gui_direct_draw_release(Gui* gui) {
     gui_update(gui);
 }
 
+void gui_icon_pin(Gui* gui, const Icon* icon) {
+    furi_assert(gui);
+    furi_assert(icon);
+
+    gui_lock(gui);
+    canvas_icon_pin(gui->canvas, icon);
+    gui_unlock(gui);
+}
+
+void gui_icon_unpin(Gui* gui, const Icon* icon) {
+    furi_assert(gui);
+    furi_assert(icon);
+
+    gui_lock(gui);
+    canvas_icon_unpin(gui->canvas, icon);
+    gui_unlock(gui);
+}
+
+void gui_get_icon_cache_stats(Gui* gui, GuiIconCacheStats* stats) {
+    furi_assert(gui);
+    furi_assert(stats);
+
+    gui_lock(gui);
+    const CanvasIconCache* cache = &gui->canvas->icon_cache;
+    stats->size = cache->size;
+    stats->pinned_size = cache->pinned_size;
+    stats->count = CanvasIconCacheArray_size(cache->items);
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    gui_unlock(gui);
+}
+
 Gui* gui_alloc() {
     Gui* gui = malloc(sizeof(Gui));
     // Thread ID
@@ -695,30 +838,35 @@ Gui* gui_alloc() {
     return gui;
 }
 
+static void gui_input_queue_callback(FuriMessageQueue* queue, void* context) {
+    Gui* gui = context;
+    // Process till queue become empty
+    InputEvent input_event;
+    while(furi_message_queue_get(queue, &input_event, 0) == FuriStatusOk) {
+        gui_input(gui, &input_event);
+    }
+}
+
+static void gui_draw_flags_callback(uint32_t flags, void* context) {
+    UNUSED(flags);
+    Gui* gui = context;
+    gui_redraw(gui);
+}
+
 int32_t gui_srv(void* p) {
     UNUSED(p);
     Gui* gui = gui_alloc();
 
     furi_record_create(RECORD_GUI, gui);
 
-    while(1) {
-        uint32_t flags =
-            furi_thread_flags_wait(GUI_THREAD_FLAG_ALL, FuriFlagWaitAny, FuriWaitForever);
-        // Process and dispatch input
-        if(flags & GUI_THREAD_FLAG_INPUT) {
-            // Process till queue become empty
-            InputEvent input_event;
-            while(furi_message_queue_get(gui->input_queue, &input_event, 0) == FuriStatusOk) {
-                gui_input(gui, &input_event);
-            }
-        }
-        // Process and dispatch draw call
-        if(flags & GUI_THREAD_FLAG_DRAW) {
-            // Clear flags that arrived on input step
-            furi_thread_flags_clear(GUI_THREAD_FLAG_DRAW);
-            gui_redraw(gui);
-        }
-    }
+    // Input is dispatched before draw flag, so one redraw covers all processed input
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        event_loop, gui->input_queue, gui_input_queue_callback, gui);
+    furi_event_loop_subscribe_thread_flags(
+        event_loop, GUI_THREAD_FLAG_DRAW, gui_draw_flags_callback, gui);
+
+    furi_event_loop_run(event_loop);
 
     return 0;
 }
@@ -36,6 +36,26 @@ typedef void (*GuiCanvasCommitCallback)(
     CanvasOrientation orientation,
     void* context);
 
+/** Decoded icon cache statistics */
+typedef struct {
+    size_t size; /**< Memory used by decoded icons, bytes */
+    size_t pinned_size; /**< Part of size used by pinned icons, bytes */
+    size_t count; /**< Decoded icon frames in cache */
+    uint32_t hits; /**< Draws served from cache */
+    uint32_t misses; /**< Draws that decompressed icon */
+} GuiIconCacheStats;
+
+/** Gui Canvas Commit Callback with changed part of the frame
+ *
+ * damage->pages is 0 if frame is the same as previous one.
+ */
+typedef void (*GuiCanvasDamageCallback)(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    const CanvasDamage* damage,
+    void* context);
+
 #define RECORD_GUI "gui"
 
 typedef struct Gui Gui;
@@ -96,6 +116,30 @@ void gui_add_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, vo
  */
 void gui_remove_framebuffer_callback(Gui* gui, GuiCanvasCommitCallback callback, void* context);
 
+/** Add gui canvas commit callback receiving changed part of the frame
+ *
+ * First call after adding callback receives whole frame as damaged.
+ *
+ * @param      gui       Gui instance
+ * @param      callback  GuiCanvasDamageCallback
+ * @param      context   GuiCanvasDamageCallback context
+ */
+void gui_add_framebuffer_damage_callback(
+    Gui* gui,
+    GuiCanvasDamageCallback callback,
+    void* context);
+
+/** Remove gui canvas commit callback receiving changed part of the frame
+ *
+ * @param      gui       Gui instance
+ * @param      callback  GuiCanvasDamageCallback
+ * @param      context   GuiCanvasDamageCallback context
+ */
+void gui_remove_framebuffer_damage_callback(
+    Gui* gui,
+    GuiCanvasDamageCallback callback,
+    void* context);
+
 /** Get gui canvas frame buffer size
  * *
  * @param      gui       Gui instance
@@ -144,6 +188,32 @@ Canvas* gui_direct_draw_acquire(Gui* gui);
  */
 void gui_direct_draw_release(Gui* gui);
 
+/** Pin icon in decoded icon cache
+ *
+ * GUI keeps recently drawn compressed icons decoded. Pin icons that are drawn
+ * on every frame, like animations or game sprites, so they are decompressed
+ * only once. Pins are counted, call gui_icon_unpin for every pin before icon
+ * data is freed.
+ *
+ * @param      gui   Gui instance
+ * @param      icon  Icon instance
+ */
+void gui_icon_pin(Gui* gui, const Icon* icon);
+
+/** Unpin icon pinned with gui_icon_pin
+ *
+ * @param      gui   Gui instance
+ * @param      icon  Icon instance
+ */
+void gui_icon_unpin(Gui* gui, const Icon* icon);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      gui    Gui instance
+ * @param      stats  GuiIconCacheStats to fill
+ */
+void gui_get_icon_cache_stats(Gui* gui, GuiIconCacheStats* stats);
+
 uint8_t gui_get_count_of_enabled_view_port_in_layer(Gui* gui, GuiLayer layer);
 
 #ifdef __cplusplus
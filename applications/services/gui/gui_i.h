@@ -39,13 +39,14 @@
 #define GUI_WINDOW_HEIGHT (GUI_DISPLAY_HEIGHT - GUI_WINDOW_Y)
 
 #define GUI_THREAD_FLAG_DRAW (1 << 0)
-#define GUI_THREAD_FLAG_INPUT (1 << 1)
-#define GUI_THREAD_FLAG_ALL (GUI_THREAD_FLAG_DRAW | GUI_THREAD_FLAG_INPUT)
 
 ARRAY_DEF(ViewPortArray, ViewPort*, M_PTR_OPLIST);
 
+#define M_OPL_ViewPortArray_t() ARRAY_OPLIST(ViewPortArray, M_PTR_OPLIST)
+
 typedef struct {
     GuiCanvasCommitCallback callback;
+    GuiCanvasDamageCallback damage_callback;
     void* context;
 } CanvasCallbackPair;
 
@@ -66,6 +67,8 @@ struct Gui {
     bool lockdown;
     bool direct_draw;
     ViewPortArray_t layers[GuiLayerMAX];
+    bool redraw_full;
+    ViewPort* drawn_view_port;
     Canvas* canvas;
     CanvasCallbackPairArray_t canvas_callback_pair;
 
@@ -90,6 +93,12 @@ ViewPort* gui_view_port_find_enabled(ViewPortArray_t array);
  */
 void gui_update(Gui* gui);
 
+/** Request redraw of damaged ViewPort regions only
+ *
+ * @param      gui   Gui instance
+ */
+void gui_update_partial(Gui* gui);
+
 /** Input event callback
  * 
  * Used to receive input from input service or to inject new input events
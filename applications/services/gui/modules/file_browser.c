@@ -266,6 +266,7 @@ void file_browser_start(FileBrowser* browser, FuriString* path) {
         browser->ext_filter,
         browser->skip_assets,
         browser->hide_dot_files);
+    file_browser_worker_set_hide_ext(browser->worker, browser->hide_ext);
     file_browser_worker_set_callback_context(browser->worker, browser);
     file_browser_worker_set_folder_callback(browser->worker, browser_folder_open_cb);
     file_browser_worker_set_list_callback(browser->worker, browser_list_load_cb);
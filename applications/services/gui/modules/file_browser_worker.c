@@ -4,21 +4,31 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <toolbox/dir_walk.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
+#include <furi_hal_rtc.h>
 
 #include <m-array.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <cfw.h>
 
 #define TAG "BrowserWorker"
 
 #define ASSETS_DIR "assets"
 #define BROWSER_ROOT STORAGE_ANY_PATH_PREFIX
-#define FILE_NAME_LEN_MAX 256
 #define LONG_LOAD_THRESHOLD 100
 
+#define LISTING_CACHE_SIZE 2
+#define LISTING_ITEM_FOLDER (1UL << 31)
+#define LISTING_NAMES_CHUNK 1024
+#define LISTING_ITEMS_CHUNK 128
+#define LISTING_HEAP_RESERVE (24 * 1024)
+
 typedef enum {
     WorkerEvtStop = (1 << 0),
     WorkerEvtLoad = (1 << 1),
@@ -34,6 +44,24 @@ typedef enum {
 
 ARRAY_DEF(idx_last_array, int32_t)
 
+/** Sorted directory listing, kept in memory until the directory storage is modified */
+typedef struct {
+    FuriString* path;
+    uint32_t storage_timestamp;
+    uint32_t build_timestamp;
+    uint32_t last_used;
+    bool dirs_first;
+    bool hide_ext;
+    bool valid;
+
+    char* names; /**< Pool of NUL-terminated names */
+    size_t names_size;
+    size_t names_capacity;
+    uint32_t* items; /**< Name offset in pool, LISTING_ITEM_FOLDER flag for folders */
+    uint32_t items_count;
+    size_t items_capacity;
+} BrowserListing;
+
 struct BrowserWorker {
     FuriThread* thread;
 
@@ -46,6 +74,7 @@ struct BrowserWorker {
     uint32_t load_count;
     bool skip_assets;
     bool hide_dot_files;
+    bool hide_ext;
     idx_last_array_t idx_last;
 
     void* cb_ctx;
@@ -53,6 +82,11 @@ struct BrowserWorker {
     BrowserWorkerListLoadCallback list_load_cb;
     BrowserWorkerListItemCallback list_item_cb;
     BrowserWorkerLongLoadCallback long_load_cb;
+
+    BrowserListing listing[LISTING_CACHE_SIZE];
+    uint32_t listing_use_counter;
+    FuriPubSubSubscription* storage_subscription;
+    volatile bool listing_invalidate;
 };
 
 static bool browser_path_is_file(FuriString* path) {
@@ -79,10 +113,10 @@ static bool browser_path_trim(FuriString* path) {
     return is_root;
 }
 
-static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, bool is_folder) {
+static bool browser_filter_by_name(BrowserWorker* browser, const char* name, bool is_folder) {
     // Skip dot files if enabled
     if(browser->hide_dot_files) {
-        if(furi_string_start_with_str(name, ".")) {
+        if(name[0] == '.') {
             return false;
         }
     }
@@ -90,7 +124,7 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
     if(is_folder) {
         // Skip assets folders (if enabled)
         if(browser->skip_assets) {
-            return ((furi_string_cmp_str(name, ASSETS_DIR) == 0) ? (false) : (true));
+            return ((strcmp(name, ASSETS_DIR) == 0) ? (false) : (true));
         } else {
             return true;
         }
@@ -100,13 +134,33 @@ static bool browser_filter_by_name(BrowserWorker* browser, FuriString* name, boo
            (furi_string_cmp_str(browser->filter_extension, "*") == 0)) {
             return true;
         }
-        if(furi_string_end_with(name, browser->filter_extension)) {
+        size_t name_len = strlen(name);
+        size_t ext_len = furi_string_size(browser->filter_extension);
+        if((name_len >= ext_len) &&
+           (strcmp(name + name_len - ext_len, furi_string_get_cstr(browser->filter_extension)) ==
+            0)) {
             return true;
         }
     }
     return false;
 }
 
+// DirWalk returns "path/name", name starts right after the folder path
+static const char* browser_item_name(FuriString* path, FuriString* item_path) {
+    return furi_string_get_cstr(item_path) + furi_string_size(path) + 1;
+}
+
+static DirWalk* browser_dir_walk_alloc(Storage* storage) {
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    dir_walk_set_recursive(dir_walk, false);
+    return dir_walk;
+}
+
+static void browser_dir_walk_free(DirWalk* dir_walk) {
+    dir_walk_close(dir_walk);
+    dir_walk_free(dir_walk);
+}
+
 static bool browser_folder_check_and_switch(FuriString* path) {
     FileInfo file_info;
     Storage* storage = furi_record_open(RECORD_STORAGE);
@@ -132,6 +186,292 @@ static bool browser_folder_check_and_switch(FuriString* path) {
     return is_root;
 }
 
+static void browser_listing_reset(BrowserListing* listing) {
+    free(listing->names);
+    free(listing->items);
+    listing->names = NULL;
+    listing->names_size = 0;
+    listing->names_capacity = 0;
+    listing->items = NULL;
+    listing->items_count = 0;
+    listing->items_capacity = 0;
+    listing->valid = false;
+}
+
+static void browser_listing_invalidate_all(BrowserWorker* browser) {
+    for(size_t i = 0; i < LISTING_CACHE_SIZE; i++) {
+        browser_listing_reset(&browser->listing[i]);
+    }
+}
+
+static void browser_listing_invalidate(BrowserWorker* browser, FuriString* path) {
+    for(size_t i = 0; i < LISTING_CACHE_SIZE; i++) {
+        if(furi_string_equal(browser->listing[i].path, path)) {
+            browser_listing_reset(&browser->listing[i]);
+        }
+    }
+}
+
+static void browser_storage_callback(const void* message, void* context) {
+    const StorageEvent* event = message;
+    BrowserWorker* browser = context;
+
+    if(event->type == StorageEventTypeCardMount || event->type == StorageEventTypeCardUnmount ||
+       event->type == StorageEventTypeCardMountError) {
+        browser->listing_invalidate = true;
+    }
+}
+
+static bool browser_listing_grow(void** buffer, size_t* capacity, size_t required, size_t chunk) {
+    if(required <= *capacity) {
+        return true;
+    }
+
+    size_t new_capacity = MAX(*capacity * 2, chunk);
+    while(new_capacity < required) {
+        new_capacity *= 2;
+    }
+    // Listing is an optimization, never starve the rest of the system for it
+    if(memmgr_heap_get_max_free_block() < new_capacity + LISTING_HEAP_RESERVE) {
+        return false;
+    }
+
+    *buffer = realloc(*buffer, new_capacity); //-V701
+    *capacity = new_capacity;
+    return true;
+}
+
+/** Length of the name as file_browser displays it, extension trimmed like path_extract_filename */
+static size_t browser_listing_name_len(const char* name, bool trim_ext) {
+    const char* dot = trim_ext ? strrchr(name, '.') : NULL;
+    return (dot && dot != name) ? (size_t)(dot - name) : strlen(name);
+}
+
+/** Same order as furi_string_cmpi, used by file_browser to sort display names */
+static int browser_listing_cmp_names(const char* a, size_t a_len, const char* b, size_t b_len) {
+    for(size_t i = 0;; i++) {
+        int char_a = i < a_len ? toupper((unsigned char)a[i]) : 0;
+        int char_b = i < b_len ? toupper((unsigned char)b[i]) : 0;
+        if(char_a != char_b || !char_a) return char_a - char_b;
+    }
+}
+
+static int browser_listing_cmp(const void* a, const void* b, void* context) {
+    const BrowserListing* listing = context;
+    const uint32_t item_a = *(const uint32_t*)a;
+    const uint32_t item_b = *(const uint32_t*)b;
+
+    if(listing->dirs_first) {
+        if((item_a & LISTING_ITEM_FOLDER) && !(item_b & LISTING_ITEM_FOLDER)) {
+            return -1;
+        }
+        if(!(item_a & LISTING_ITEM_FOLDER) && (item_b & LISTING_ITEM_FOLDER)) {
+            return 1;
+        }
+    }
+
+    const char* name_a = &listing->names[item_a & ~LISTING_ITEM_FOLDER];
+    const char* name_b = &listing->names[item_b & ~LISTING_ITEM_FOLDER];
+    bool trim_a = listing->hide_ext && !(item_a & LISTING_ITEM_FOLDER);
+    bool trim_b = listing->hide_ext && !(item_b & LISTING_ITEM_FOLDER);
+
+    int result = browser_listing_cmp_names(
+        name_a,
+        browser_listing_name_len(name_a, trim_a),
+        name_b,
+        browser_listing_name_len(name_b, trim_b));
+    if(result == 0) {
+        // Same display name, order by extension to keep the order stable
+        result = browser_listing_cmp_names(name_a, strlen(name_a), name_b, strlen(name_b));
+    }
+    return result;
+}
+
+static bool browser_listing_build(
+    BrowserWorker* browser,
+    BrowserListing* listing,
+    FuriString* path,
+    uint32_t storage_timestamp) {
+    browser_listing_reset(listing);
+    furi_string_set(listing->path, path);
+    listing->storage_timestamp = storage_timestamp;
+    listing->dirs_first = CFW_SETTINGS()->sort_dirs_first;
+    listing->hide_ext = browser->hide_ext;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirWalk* dir_walk = browser_dir_walk_alloc(storage);
+    FuriString* item_path = furi_string_alloc();
+    FileInfo file_info;
+
+    bool success = dir_walk_open(dir_walk, furi_string_get_cstr(path));
+    while(success) {
+        DirWalkResult result = dir_walk_read(dir_walk, item_path, &file_info);
+        if(result != DirWalkOK) {
+            success = (result == DirWalkLast);
+            break;
+        }
+
+        const char* name = browser_item_name(path, item_path);
+        size_t name_size = strlen(name) + 1;
+        if(name_size == 1) continue;
+
+        if(!browser_listing_grow(
+               (void**)&listing->names,
+               &listing->names_capacity,
+               listing->names_size + name_size,
+               LISTING_NAMES_CHUNK) ||
+           !browser_listing_grow(
+               (void**)&listing->items,
+               &listing->items_capacity,
+               (listing->items_count + 1) * sizeof(uint32_t),
+               LISTING_ITEMS_CHUNK * sizeof(uint32_t))) {
+            FURI_LOG_W(TAG, "Listing doesn't fit in memory: %lu items", listing->items_count);
+            success = false;
+            break;
+        }
+
+        memcpy(&listing->names[listing->names_size], name, name_size);
+        listing->items[listing->items_count] = listing->names_size;
+        if(file_info_is_dir(&file_info)) {
+            listing->items[listing->items_count] |= LISTING_ITEM_FOLDER;
+        }
+        listing->names_size += name_size;
+        listing->items_count++;
+
+        if(listing->items_count == LONG_LOAD_THRESHOLD) {
+            // Too many files in folder, loading them will take some time - send callback to app
+            if(browser->long_load_cb) {
+                browser->long_load_cb(browser->cb_ctx);
+            }
+        }
+    }
+
+    furi_string_free(item_path);
+    browser_dir_walk_free(dir_walk);
+    furi_record_close(RECORD_STORAGE);
+
+    if(success) {
+        qsort_r(
+            listing->items,
+            listing->items_count,
+            sizeof(uint32_t),
+            browser_listing_cmp,
+            listing);
+        listing->build_timestamp = furi_hal_rtc_get_timestamp();
+        listing->valid = true;
+    } else {
+        browser_listing_reset(listing);
+    }
+
+    return success;
+}
+
+/** Get sorted listing of the folder from cache, (re)load it if the folder storage was modified
+ * @return listing or NULL if listing can't be cached and folder should be read directly
+ */
+static BrowserListing* browser_listing_get(BrowserWorker* browser, FuriString* path) {
+    if(browser->listing_invalidate) {
+        browser->listing_invalidate = false;
+        browser_listing_invalidate_all(browser);
+    }
+
+    uint32_t storage_timestamp = 0;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FS_Error error =
+        storage_common_timestamp(storage, furi_string_get_cstr(path), &storage_timestamp);
+    furi_record_close(RECORD_STORAGE);
+    if(error != FSE_OK) {
+        return NULL;
+    }
+
+    BrowserListing* listing = NULL;
+    BrowserListing* lru = &browser->listing[0];
+    for(size_t i = 0; i < LISTING_CACHE_SIZE; i++) {
+        BrowserListing* slot = &browser->listing[i];
+        if(slot->valid && furi_string_equal(slot->path, path)) {
+            // Modification in the same second as build can't be detected by timestamp
+            if((slot->storage_timestamp == storage_timestamp) &&
+               (slot->build_timestamp > storage_timestamp) &&
+               (slot->dirs_first == CFW_SETTINGS()->sort_dirs_first) &&
+               (slot->hide_ext == browser->hide_ext)) {
+                listing = slot;
+            } else {
+                browser_listing_reset(slot);
+            }
+        }
+        if(!browser->listing[i].valid ||
+           (lru->valid && (browser->listing[i].last_used < lru->last_used))) {
+            lru = &browser->listing[i];
+        }
+    }
+
+    if(!listing) {
+        if(browser_listing_build(browser, lru, path, storage_timestamp)) {
+            listing = lru;
+        }
+    }
+
+    if(listing) {
+        listing->last_used = ++browser->listing_use_counter;
+    }
+
+    return listing;
+}
+
+static inline const char* browser_listing_get_name(BrowserListing* listing, uint32_t idx) {
+    return &listing->names[listing->items[idx] & ~LISTING_ITEM_FOLDER];
+}
+
+static inline bool browser_listing_is_folder(BrowserListing* listing, uint32_t idx) {
+    return (listing->items[idx] & LISTING_ITEM_FOLDER) != 0;
+}
+
+static void browser_listing_folder_init(
+    BrowserWorker* browser,
+    BrowserListing* listing,
+    FuriString* filename,
+    uint32_t* item_cnt,
+    int32_t* file_idx) {
+    for(uint32_t i = 0; i < listing->items_count; i++) {
+        const char* name = browser_listing_get_name(listing, i);
+        if(browser_filter_by_name(browser, name, browser_listing_is_folder(listing, i))) {
+            if(!furi_string_empty(filename)) {
+                if(furi_string_cmp_str(filename, name) == 0) {
+                    *file_idx = *item_cnt;
+                }
+            }
+            (*item_cnt)++;
+        }
+    }
+}
+
+static uint32_t browser_listing_load(
+    BrowserWorker* browser,
+    BrowserListing* listing,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    FuriString* item_path = furi_string_alloc();
+    uint32_t filtered_idx = 0;
+    uint32_t items_cnt = 0;
+
+    for(uint32_t i = 0; (i < listing->items_count) && (items_cnt < count); i++) {
+        const char* name = browser_listing_get_name(listing, i);
+        bool is_folder = browser_listing_is_folder(listing, i);
+        if(!browser_filter_by_name(browser, name, is_folder)) continue;
+        if(filtered_idx++ < offset) continue;
+
+        furi_string_printf(item_path, "%s/%s", furi_string_get_cstr(path), name);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, item_path, items_cnt, is_folder, false);
+        }
+        items_cnt++;
+    }
+
+    furi_string_free(item_path);
+    return items_cnt;
+}
+
 static bool browser_folder_init(
     BrowserWorker* browser,
     FuriString* path,
@@ -142,28 +482,30 @@ static bool browser_folder_init(
     FileInfo file_info;
     uint32_t total_files_cnt = 0;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
-
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
-
     *item_cnt = 0;
     *file_idx = -1;
 
-    if(storage_dir_open(directory, furi_string_get_cstr(path))) {
+    BrowserListing* listing = browser_listing_get(browser, path);
+    if(listing) {
+        browser_listing_folder_init(browser, listing, filename, item_cnt, file_idx);
+        return true;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirWalk* dir_walk = browser_dir_walk_alloc(storage);
+
+    FuriString* item_path;
+    item_path = furi_string_alloc();
+
+    if(dir_walk_open(dir_walk, furi_string_get_cstr(path))) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
+        while(dir_walk_read(dir_walk, item_path, &file_info) == DirWalkOK) {
+            const char* name = browser_item_name(path, item_path);
+            if(name[0] != '\0') {
                 total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
+                if(browser_filter_by_name(browser, name, file_info_is_dir(&file_info))) {
                     if(!furi_string_empty(filename)) {
-                        if(furi_string_cmp(name_str, filename) == 0) {
+                        if(furi_string_cmp_str(filename, name) == 0) {
                             *file_idx = *item_cnt;
                         }
                     }
@@ -179,50 +521,55 @@ static bool browser_folder_init(
         }
     }
 
-    furi_string_free(name_str);
+    furi_string_free(item_path);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_walk_free(dir_walk);
 
     furi_record_close(RECORD_STORAGE);
 
     return state;
 }
 
-// Load files list by chunks, like it was originally, not compatible with sorting, sorting needs to be disabled to use this
+// Load files list by chunks, sorted if folder listing is cached, in folder order otherwise
 static bool browser_folder_load_chunked(
     BrowserWorker* browser,
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
     FileInfo file_info;
+    uint32_t items_cnt = 0;
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    BrowserListing* listing = browser_listing_get(browser, path);
+    if(listing) {
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+        items_cnt = browser_listing_load(browser, listing, path, offset, count);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, 0, false, true);
+        }
+        return (items_cnt == count);
+    }
 
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirWalk* dir_walk = browser_dir_walk_alloc(storage);
 
-    uint32_t items_cnt = 0;
+    FuriString* item_path;
+    item_path = furi_string_alloc();
 
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!dir_walk_open(dir_walk, furi_string_get_cstr(path))) {
             break;
         }
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(dir_walk_read(dir_walk, item_path, &file_info) != DirWalkOK) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            if(browser_filter_by_name(
+                   browser, browser_item_name(path, item_path), file_info_is_dir(&file_info))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -235,25 +582,20 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(dir_walk_read(dir_walk, item_path, &file_info) != DirWalkOK) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx,
-                            name_str,
-                            items_cnt,
-                            file_info_is_dir(&file_info),
-                            false);
-                    }
-                    items_cnt++;
+            if(browser_filter_by_name(
+                   browser, browser_item_name(path, item_path), file_info_is_dir(&file_info))) {
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx,
+                        item_path,
+                        items_cnt,
+                        file_info_is_dir(&file_info),
+                        false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -261,10 +603,9 @@ static bool browser_folder_load_chunked(
         }
     } while(0);
 
-    furi_string_free(name_str);
+    furi_string_free(item_path);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_walk_free(dir_walk);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -275,31 +616,44 @@ static bool browser_folder_load_chunked(
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     FileInfo file_info;
 
+    BrowserListing* listing = browser_listing_get(browser, path);
+    if(listing) {
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, 0);
+        }
+        browser_listing_load(browser, listing, path, 0, UINT32_MAX);
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, 0, false, true);
+        }
+        return true;
+    }
+
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    File* directory = storage_file_alloc(storage);
+    DirWalk* dir_walk = browser_dir_walk_alloc(storage);
 
-    char name_temp[FILE_NAME_LEN_MAX];
-    FuriString* name_str;
-    name_str = furi_string_alloc();
+    FuriString* item_path;
+    item_path = furi_string_alloc();
 
     uint32_t items_cnt = 0;
 
     bool ret = false;
     do {
-        if(!storage_dir_open(directory, furi_string_get_cstr(path))) {
+        if(!dir_walk_open(dir_walk, furi_string_get_cstr(path))) {
             break;
         }
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
-            furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+        while(dir_walk_read(dir_walk, item_path, &file_info) == DirWalkOK) {
+            if(browser_filter_by_name(
+                   browser, browser_item_name(path, item_path), file_info_is_dir(&file_info))) {
                 if(browser->list_item_cb) {
                     browser->list_item_cb(
-                        browser->cb_ctx, name_str, items_cnt, file_info_is_dir(&file_info), false);
+                        browser->cb_ctx,
+                        item_path,
+                        items_cnt,
+                        file_info_is_dir(&file_info),
+                        false);
                 }
                 items_cnt++;
             }
@@ -310,10 +664,9 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
         ret = true;
     } while(0);
 
-    furi_string_free(name_str);
+    furi_string_free(item_path);
 
-    storage_dir_close(directory);
-    storage_file_free(directory);
+    browser_dir_walk_free(dir_walk);
 
     furi_record_close(RECORD_STORAGE);
 
@@ -395,6 +748,8 @@ static int32_t browser_worker(void* context) {
         }
 
         if(flags & WorkerEvtFolderRefresh) {
+            // Refresh is requested after folder content was changed
+            browser_listing_invalidate(browser, path);
             bool is_root = browser_folder_check_and_switch(path);
 
             int32_t file_idx = 0;
@@ -427,6 +782,8 @@ static int32_t browser_worker(void* context) {
         }
     }
 
+    browser_listing_invalidate_all(browser);
+
     furi_string_free(filename);
     furi_string_free(path);
 
@@ -457,6 +814,14 @@ BrowserWorker* file_browser_worker_alloc(
         furi_string_set_str(browser->path_start, base_path);
     }
 
+    for(size_t i = 0; i < LISTING_CACHE_SIZE; i++) {
+        browser->listing[i].path = furi_string_alloc();
+    }
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    browser->storage_subscription =
+        furi_pubsub_subscribe(storage_get_pubsub(storage), browser_storage_callback, browser);
+    furi_record_close(RECORD_STORAGE);
+
     browser->thread = furi_thread_alloc_ex("BrowserWorker", 2048, browser_worker, browser);
     furi_thread_start(browser->thread);
 
@@ -470,6 +835,13 @@ void file_browser_worker_free(BrowserWorker* browser) {
     furi_thread_join(browser->thread);
     furi_thread_free(browser->thread);
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    furi_pubsub_unsubscribe(storage_get_pubsub(storage), browser->storage_subscription);
+    furi_record_close(RECORD_STORAGE);
+    for(size_t i = 0; i < LISTING_CACHE_SIZE; i++) {
+        furi_string_free(browser->listing[i].path);
+    }
+
     furi_string_free(browser->filter_extension);
     furi_string_free(browser->path_next);
     furi_string_free(browser->path_current);
@@ -527,6 +899,11 @@ void file_browser_worker_set_config(
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtConfigChange);
 }
 
+void file_browser_worker_set_hide_ext(BrowserWorker* browser, bool hide_ext) {
+    furi_assert(browser);
+    browser->hide_ext = hide_ext;
+}
+
 void file_browser_worker_folder_enter(BrowserWorker* browser, FuriString* path, int32_t item_idx) {
     furi_assert(browser);
     furi_string_set(browser->path_next, path);
@@ -58,6 +58,11 @@ void file_browser_worker_set_config(
     bool skip_assets,
     bool hide_dot_files);
 
+/** Sort file names with extension trimmed, as file_browser displays them with hide_ext
+ * Items with display names from an item callback are still sorted by file name.
+ */
+void file_browser_worker_set_hide_ext(BrowserWorker* browser, bool hide_ext);
+
 void file_browser_worker_folder_enter(BrowserWorker* browser, FuriString* path, int32_t item_idx);
 
 bool file_browser_worker_is_in_start_folder(BrowserWorker* browser);
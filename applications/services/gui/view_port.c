@@ -154,7 +154,46 @@ void view_port_input_callback_set(
 
 void view_port_update(ViewPort* view_port) {
     furi_assert(view_port);
-    if(view_port->gui && view_port->is_enabled) gui_update(view_port->gui);
+    view_port_update_rect(view_port, 0, 0, UINT8_MAX, UINT8_MAX);
+}
+
+void view_port_update_rect(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height) {
+    furi_assert(view_port);
+
+    uint8_t x1 = MIN(x + width, UINT8_MAX);
+    uint8_t y1 = MIN(y + height, UINT8_MAX);
+    if((x >= x1) || (y >= y1)) return;
+
+    // Called from any thread while GUI thread takes damage
+    FURI_CRITICAL_ENTER();
+    ViewPortRect* damage = &view_port->damage;
+    if(damage->x0 >= damage->x1) {
+        *damage = (ViewPortRect){.x0 = x, .y0 = y, .x1 = x1, .y1 = y1};
+    } else {
+        damage->x0 = MIN(damage->x0, x);
+        damage->y0 = MIN(damage->y0, y);
+        damage->x1 = MAX(damage->x1, x1);
+        damage->y1 = MAX(damage->y1, y1);
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(view_port->gui && view_port->is_enabled) gui_update_partial(view_port->gui);
+}
+
+ViewPortRect view_port_take_damage(ViewPort* view_port) {
+    furi_assert(view_port);
+
+    FURI_CRITICAL_ENTER();
+    ViewPortRect damage = view_port->damage;
+    view_port->damage = (ViewPortRect){0};
+    FURI_CRITICAL_EXIT();
+
+    return damage;
 }
 
 void view_port_gui_set(ViewPort* view_port, Gui* gui) {
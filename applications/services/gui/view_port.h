@@ -97,6 +97,25 @@ void view_port_input_callback_set(
  */
 void view_port_update(ViewPort* view_port);
 
+/** Emit update signal to GUI system for part of ViewPort.
+ *
+ * Only this region is redrawn and sent to display: draw callback is called as
+ * usual, but drawing outside of the region is clipped. Regions of multiple
+ * updates are merged until GUI system processes signal.
+ *
+ * @param      view_port  ViewPort instance
+ * @param      x          x coordinate, in ViewPort coordinates
+ * @param      y          y coordinate, in ViewPort coordinates
+ * @param      width      region width
+ * @param      height     region height
+ */
+void view_port_update_rect(
+    ViewPort* view_port,
+    uint8_t x,
+    uint8_t y,
+    uint8_t width,
+    uint8_t height);
+
 /** Set ViewPort orientation.
  *
  * @param      view_port    ViewPort instance
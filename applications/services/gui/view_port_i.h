@@ -8,6 +8,14 @@
 #include "gui_i.h"
 #include "view_port.h"
 
+/** Rectangle, x1 and y1 are exclusive, empty if x0 >= x1 */
+typedef struct {
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+} ViewPortRect;
+
 struct ViewPort {
     Gui* gui;
     bool is_enabled;
@@ -16,6 +24,8 @@ struct ViewPort {
     uint8_t width;
     uint8_t height;
 
+    ViewPortRect damage;
+
     ViewPortDrawCallback draw_callback;
     void* draw_callback_context;
 
@@ -32,6 +42,16 @@ struct ViewPort {
  */
 void view_port_gui_set(ViewPort* view_port, Gui* gui);
 
+/** Get and reset region changed since previous call
+ *
+ * To be used by GUI, called on tree redraw.
+ *
+ * @param      view_port  ViewPort instance
+ *
+ * @return     damaged region in ViewPort coordinates
+ */
+ViewPortRect view_port_take_damage(ViewPort* view_port);
+
 /** Process draw call. Calls draw callback.
  *
  * To be used by GUI, called on tree redraw.
@@ -0,0 +1,325 @@
+#include "indexer_i.h"
+
+#include <furi_hal.h>
+#include <ctype.h>
+
+#define TAG "Indexer"
+
+// Wait for SD card activity to settle before walking folders
+#define INDEXER_SETTLE_TIME (3000)
+// Minimal interval between updates caused by SD card activity
+#define INDEXER_UPDATE_INTERVAL (30000)
+
+static const char* const indexer_app_names[IndexerAppCount] = {
+    [IndexerAppSubGhz] = "SubGhz",
+    [IndexerAppNfc] = "NFC",
+    [IndexerAppLfRfid] = "RFID",
+    [IndexerAppInfrared] = "Infrared",
+    [IndexerAppIButton] = "iButton",
+};
+
+static const char* const indexer_field_names[IndexerFieldCount] = {
+    [IndexerFieldName] = "Name",
+    [IndexerFieldProtocol] = "Protocol",
+    [IndexerFieldFrequency] = "Frequency",
+    [IndexerFieldUid] = "UID",
+    [IndexerFieldKey] = "Key",
+};
+
+const char* indexer_app_get_name(IndexerApp app) {
+    furi_check(app < IndexerAppCount);
+    return indexer_app_names[app];
+}
+
+const char* indexer_field_get_name(IndexerField field) {
+    furi_check(field < IndexerFieldCount);
+    return indexer_field_names[field];
+}
+
+size_t indexer_normalize(const char* value, char* out) {
+    size_t size = 0;
+    for(; *value && (size < INDEXER_VALUE_SIZE - 1); value++) {
+        if(isspace((unsigned char)*value)) continue;
+        out[size++] = toupper((unsigned char)*value);
+    }
+    memset(&out[size], 0, INDEXER_VALUE_SIZE - size);
+    return size;
+}
+
+static void indexer_storage_callback(const void* message, void* context) {
+    const StorageEvent* event = message;
+    Indexer* indexer = context;
+
+    if(event->type == StorageEventTypeCardMount) {
+        furi_thread_flags_set(indexer->thread_id, IndexerFlagMount);
+    } else if(
+        event->type == StorageEventTypeCardUnmount ||
+        event->type == StorageEventTypeCardMountError) {
+        furi_thread_flags_set(indexer->thread_id, IndexerFlagUnmount);
+    } else if(event->type == StorageEventTypeFileClose) {
+        furi_thread_flags_set(indexer->thread_id, IndexerFlagChanged);
+    }
+}
+
+static bool indexer_read_term(File* file, uint32_t offset, IndexerTerm* term) {
+    return storage_file_seek(file, offset, true) &&
+           (storage_file_read(file, term, sizeof(IndexerTerm)) == sizeof(IndexerTerm));
+}
+
+static bool indexer_read_doc(File* file, uint16_t doc, IndexerApp* app, char* path) {
+    uint32_t offset = 0;
+    IndexerDoc doc_info;
+
+    bool success = false;
+    do {
+        if(!storage_file_seek(file, sizeof(IndexerBucketHeader) + doc * sizeof(uint32_t), true))
+            break;
+        if(storage_file_read(file, &offset, sizeof(uint32_t)) != sizeof(uint32_t)) break;
+        if(!storage_file_seek(file, offset, true)) break;
+        if(storage_file_read(file, &doc_info, sizeof(IndexerDoc)) != sizeof(IndexerDoc)) break;
+        if(doc_info.app >= IndexerAppCount) break;
+        if(storage_file_read(file, path, doc_info.path_size) != doc_info.path_size) break;
+
+        path[doc_info.path_size] = '\0';
+        *app = doc_info.app;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+/** Search one bucket file, returns false if callback requested to stop */
+static bool indexer_bucket_query(
+    File* file,
+    const char* value,
+    size_t value_size,
+    IndexerMatch match,
+    IndexerQueryCallback callback,
+    void* context,
+    size_t* matches) {
+    IndexerBucketHeader header;
+    if((storage_file_read(file, &header, sizeof(header)) != sizeof(header)) ||
+       (header.magic != INDEXER_BUCKET_MAGIC) || (header.version != INDEXER_BUCKET_VERSION)) {
+        return true;
+    }
+
+    IndexerTerm term;
+
+    // Lower bound of the value in sorted terms
+    uint32_t low = 0;
+    uint32_t high = header.terms_count;
+    while(low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if(!indexer_read_term(file, header.terms_offset + mid * sizeof(IndexerTerm), &term)) {
+            return true;
+        }
+        if(strncmp(term.value, value, INDEXER_VALUE_SIZE) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    char path[UINT8_MAX + 1];
+    for(uint32_t i = low; i < header.terms_count; i++) {
+        if(!indexer_read_term(file, header.terms_offset + i * sizeof(IndexerTerm), &term)) {
+            break;
+        }
+        term.value[INDEXER_VALUE_SIZE - 1] = '\0';
+
+        if(match == IndexerMatchExact) {
+            if(strcmp(term.value, value) != 0) break;
+        } else {
+            if(strncmp(term.value, value, value_size) != 0) break;
+        }
+
+        IndexerApp app;
+        if(term.field >= IndexerFieldCount || !indexer_read_doc(file, term.doc, &app, path)) {
+            continue;
+        }
+
+        IndexerResult result = {
+            .path = path,
+            .value = term.value,
+            .app = app,
+            .field = term.field,
+        };
+        (*matches)++;
+        if(!callback(&result, context)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t indexer_query(
+    Indexer* indexer,
+    const char* query,
+    IndexerMatch match,
+    IndexerQueryCallback callback,
+    void* context) {
+    furi_assert(indexer);
+    furi_assert(query);
+    furi_assert(callback);
+
+    char value[INDEXER_VALUE_SIZE];
+    size_t value_size = indexer_normalize(query, value);
+    if(value_size == 0) return 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    size_t matches = 0;
+
+    bool proceed = true;
+    for(size_t i = 0; (i < INDEXER_BUCKETS_COUNT) && proceed; i++) {
+        // Bucket files are replaced by update under the same lock
+        furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+        if(indexer->buckets[i].terms_count > 0) {
+            furi_string_printf(path, INDEXER_BUCKET_PATH_FORMAT, i);
+            const char* bucket_path = furi_string_get_cstr(path);
+            if(storage_file_open(file, bucket_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+                proceed = indexer_bucket_query(
+                    file, value, value_size, match, callback, context, &matches);
+            }
+            storage_file_close(file);
+        }
+        furi_mutex_release(indexer->mutex);
+    }
+
+    furi_string_free(path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return matches;
+}
+
+void indexer_update(Indexer* indexer) {
+    furi_assert(indexer);
+    furi_thread_flags_set(indexer->thread_id, IndexerFlagUpdate);
+}
+
+IndexerStats indexer_get_stats(Indexer* indexer) {
+    furi_assert(indexer);
+    IndexerStats stats = {0};
+
+    furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+    stats.state = indexer->state;
+    for(size_t i = 0; i < INDEXER_BUCKETS_COUNT; i++) {
+        stats.docs_count += indexer->buckets[i].docs_count;
+        stats.terms_count += indexer->buckets[i].terms_count;
+    }
+    stats.buckets_rebuilt = indexer->buckets_rebuilt;
+    stats.update_time = indexer->update_time;
+    furi_mutex_release(indexer->mutex);
+
+    return stats;
+}
+
+static Indexer* indexer_alloc() {
+    Indexer* indexer = malloc(sizeof(Indexer));
+    indexer->thread_id = furi_thread_get_current_id();
+    indexer->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    indexer->state = IndexerStateUnavailable;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    indexer->storage_subscription =
+        furi_pubsub_subscribe(storage_get_pubsub(storage), indexer_storage_callback, indexer);
+    furi_record_close(RECORD_STORAGE);
+
+    return indexer;
+}
+
+static void indexer_set_unavailable(Indexer* indexer) {
+    furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+    memset(indexer->buckets, 0, sizeof(indexer->buckets));
+    indexer->state = IndexerStateUnavailable;
+    indexer->storage_timestamp = 0;
+    furi_mutex_release(indexer->mutex);
+}
+
+int32_t indexer_srv(void* p) {
+    UNUSED(p);
+
+    if(!furi_hal_is_normal_boot()) {
+        FURI_LOG_W(TAG, "Skipping start in special boot mode");
+        return 0;
+    }
+
+    Indexer* indexer = indexer_alloc();
+    furi_record_create(RECORD_INDEXER, indexer);
+
+    // Indexing is a background job, never compete with applications for CPU
+    furi_thread_set_current_priority(FuriThreadPriorityLow);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(storage_sd_status(storage) == FSE_OK) {
+        furi_thread_flags_set(indexer->thread_id, IndexerFlagMount);
+    }
+
+    uint32_t update_tick = 0;
+    bool updated = false;
+
+    while(1) {
+        uint32_t flags =
+            furi_thread_flags_wait(INDEXER_FLAGS_ALL, FuriFlagWaitAny, FuriWaitForever);
+        furi_assert((flags & FuriFlagError) == 0);
+
+        if(flags & IndexerFlagUnmount) {
+            FURI_LOG_I(TAG, "SD card removed");
+            indexer_set_unavailable(indexer);
+        }
+
+        if(!(flags & (IndexerFlagUpdate | IndexerFlagChanged | IndexerFlagMount))) {
+            continue;
+        }
+
+        if(!(flags & IndexerFlagUpdate)) {
+            // Postpone update while files are being written
+            while(!(furi_thread_flags_wait(
+                        IndexerFlagChanged, FuriFlagWaitAny, INDEXER_SETTLE_TIME) &
+                    FuriFlagError)) {
+            }
+
+            // Walk folders at most once per interval, explicit requests are never delayed
+            uint32_t elapsed = furi_get_tick() - update_tick;
+            if(updated && (elapsed < INDEXER_UPDATE_INTERVAL)) {
+                uint32_t interrupt = furi_thread_flags_wait(
+                    IndexerFlagUpdate | IndexerFlagMount | IndexerFlagUnmount,
+                    FuriFlagWaitAny | FuriFlagNoClear,
+                    INDEXER_UPDATE_INTERVAL - elapsed);
+                if(!(interrupt & FuriFlagError)) {
+                    // Handle new flags first, then get back to pending changes
+                    furi_thread_flags_set(indexer->thread_id, IndexerFlagChanged);
+                    continue;
+                }
+            }
+        }
+
+        uint32_t timestamp = 0;
+        if(storage_common_timestamp(storage, STORAGE_EXT_PATH_PREFIX, &timestamp) != FSE_OK) {
+            continue;
+        }
+
+        bool force = (flags & IndexerFlagUpdate);
+        if((flags & IndexerFlagMount) || (indexer->state == IndexerStateUnavailable)) {
+            indexer_buckets_load(indexer);
+            force = true;
+        }
+
+        if(force || (timestamp != indexer->storage_timestamp)) {
+            // Files written during update raise IndexerFlagChanged and move timestamp,
+            // so they are picked up by the next pass. Index files written by update itself
+            // cause one more pass too, which finds nothing to rebuild.
+            indexer->storage_timestamp = timestamp;
+            indexer_buckets_update(indexer);
+            update_tick = furi_get_tick();
+            updated = true;
+        }
+    }
+
+    furi_crash("That was unexpected");
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file indexer.h
+ * Indexer service: content search across saved SubGhz, NFC, RFID, Infrared and iButton files
+ *
+ * Service walks application folders on SD card, extracts key fields (protocol, frequency,
+ * UID, key data, names) and keeps them in a compact inverted index on SD card.
+ * Index is updated incrementally in background when SD card content changes.
+ */
+#pragma once
+
+#include <furi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RECORD_INDEXER "indexer"
+
+typedef struct Indexer Indexer;
+
+typedef enum {
+    IndexerAppSubGhz,
+    IndexerAppNfc,
+    IndexerAppLfRfid,
+    IndexerAppInfrared,
+    IndexerAppIButton,
+
+    IndexerAppCount,
+} IndexerApp;
+
+typedef enum {
+    IndexerFieldName, /**< File name or signal name */
+    IndexerFieldProtocol, /**< Protocol or device type */
+    IndexerFieldFrequency, /**< Frequency, Hz */
+    IndexerFieldUid, /**< Card UID */
+    IndexerFieldKey, /**< Key data */
+
+    IndexerFieldCount,
+} IndexerField;
+
+typedef enum {
+    IndexerMatchExact,
+    IndexerMatchPrefix,
+} IndexerMatch;
+
+typedef enum {
+    IndexerStateUnavailable, /**< SD card is not mounted */
+    IndexerStateIdle,
+    IndexerStateUpdating,
+} IndexerState;
+
+typedef struct {
+    IndexerState state;
+    uint32_t docs_count; /**< Indexed files */
+    uint32_t terms_count; /**< Indexed values */
+    uint32_t buckets_rebuilt; /**< Index buckets rebuilt by last update */
+    uint32_t update_time; /**< Last update duration, ms */
+} IndexerStats;
+
+typedef struct {
+    const char* path; /**< Full path of the matched file */
+    const char* value; /**< Matched value, normalized */
+    IndexerApp app;
+    IndexerField field;
+} IndexerResult;
+
+/** Query result callback
+ * Called with index locked, must not call Indexer API.
+ *
+ * @param result matched value, valid only during callback
+ * @param context callback context
+ * @return true to continue query, false to stop
+ */
+typedef bool (*IndexerQueryCallback)(const IndexerResult* result, void* context);
+
+/** Search index for a value
+ * Query is normalized the same way as indexed values: spaces are removed and letters are
+ * uppercased, so "a1 b2" matches key "A1 B2 C3" with IndexerMatchPrefix.
+ * Thread safe, blocking, executed in caller thread.
+ *
+ * @param indexer Indexer instance
+ * @param query value to search
+ * @param match exact or prefix match
+ * @param callback called for every match
+ * @param context callback context
+ * @return number of reported matches
+ */
+size_t indexer_query(
+    Indexer* indexer,
+    const char* query,
+    IndexerMatch match,
+    IndexerQueryCallback callback,
+    void* context);
+
+/** Request index update
+ * Thread safe, async
+ *
+ * @param indexer Indexer instance
+ */
+void indexer_update(Indexer* indexer);
+
+/** Get index statistics
+ * Thread safe
+ *
+ * @param indexer Indexer instance
+ * @return IndexerStats
+ */
+IndexerStats indexer_get_stats(Indexer* indexer);
+
+/** Get application name
+ *
+ * @param app IndexerApp
+ * @return const char* name
+ */
+const char* indexer_app_get_name(IndexerApp app);
+
+/** Get field name
+ *
+ * @param field IndexerField
+ * @return const char* name
+ */
+const char* indexer_field_get_name(IndexerField field);
+
+#ifdef __cplusplus
+}
+#endif
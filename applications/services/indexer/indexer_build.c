@@ -0,0 +1,562 @@
+#include "indexer_i.h"
+
+#include <toolbox/dir_walk.h>
+#include <toolbox/path.h>
+#include <toolbox/stream/buffered_file_stream.h>
+#include <stdlib.h>
+
+#define TAG "Indexer"
+
+// Buckets built in one pass over application folders
+#define INDEXER_BUILDERS_COUNT (8)
+#define INDEXER_BUILDER_PATHS_CHUNK (512)
+#define INDEXER_BUILDER_TERMS_CHUNK (32)
+#define INDEXER_HEAP_RESERVE (24 * 1024)
+
+typedef struct {
+    const char* key;
+    IndexerField field;
+} IndexerKey;
+
+typedef struct {
+    IndexerApp app;
+    const char* path;
+    const char* extension;
+    const IndexerKey* keys;
+    size_t keys_count;
+    const char* stop_key; /**< Bulk data starts with this key, no fields after it */
+    size_t lines_max;
+} IndexerSource;
+
+static const IndexerKey indexer_subghz_keys[] = {
+    {"Frequency", IndexerFieldFrequency},
+    {"Protocol", IndexerFieldProtocol},
+    {"Key", IndexerFieldKey},
+    {"Manufacture", IndexerFieldName},
+};
+
+static const IndexerKey indexer_nfc_keys[] = {
+    {"Device type", IndexerFieldProtocol},
+    {"UID", IndexerFieldUid},
+};
+
+static const IndexerKey indexer_lfrfid_keys[] = {
+    {"Key type", IndexerFieldProtocol},
+    {"Data", IndexerFieldKey},
+};
+
+static const IndexerKey indexer_infrared_keys[] = {
+    {"name", IndexerFieldName},
+    {"protocol", IndexerFieldProtocol},
+};
+
+static const IndexerKey indexer_ibutton_keys[] = {
+    {"Protocol", IndexerFieldProtocol},
+    {"Key type", IndexerFieldProtocol},
+    {"Rom Data", IndexerFieldKey},
+    {"Data", IndexerFieldKey},
+};
+
+static const IndexerSource indexer_sources[] = {
+    {IndexerAppSubGhz,
+     EXT_PATH("subghz"),
+     ".sub",
+     indexer_subghz_keys,
+     COUNT_OF(indexer_subghz_keys),
+     "RAW_Data",
+     32},
+    {IndexerAppNfc,
+     EXT_PATH("nfc"),
+     ".nfc",
+     indexer_nfc_keys,
+     COUNT_OF(indexer_nfc_keys),
+     NULL,
+     32},
+    {IndexerAppLfRfid,
+     EXT_PATH("lfrfid"),
+     ".rfid",
+     indexer_lfrfid_keys,
+     COUNT_OF(indexer_lfrfid_keys),
+     NULL,
+     16},
+    {IndexerAppInfrared,
+     EXT_PATH("infrared"),
+     ".ir",
+     indexer_infrared_keys,
+     COUNT_OF(indexer_infrared_keys),
+     NULL,
+     1024},
+    {IndexerAppIButton,
+     EXT_PATH("ibutton"),
+     ".ibtn",
+     indexer_ibutton_keys,
+     COUNT_OF(indexer_ibutton_keys),
+     NULL,
+     16},
+};
+
+typedef struct {
+    uint8_t bucket;
+    bool failed;
+    uint32_t signature;
+    uint16_t docs_count;
+
+    uint8_t* docs; /**< IndexerDoc + path records */
+    size_t docs_size;
+    size_t docs_capacity;
+    uint32_t* doc_offsets;
+    size_t doc_offsets_capacity;
+    IndexerTerm* terms;
+    uint32_t terms_count;
+    size_t terms_capacity;
+} IndexerBuilder;
+
+typedef struct {
+    Indexer* indexer;
+    Stream* stream;
+    FuriString* line;
+    FuriString* name;
+
+    // Pass 1: state of the files on SD card
+    uint32_t signature[INDEXER_BUCKETS_COUNT];
+    uint16_t docs_count[INDEXER_BUCKETS_COUNT];
+
+    // Pass 2: buckets under construction
+    IndexerBuilder builders[INDEXER_BUILDERS_COUNT];
+    size_t builders_count;
+    int8_t bucket_builder[INDEXER_BUCKETS_COUNT];
+} IndexerUpdate;
+
+typedef void (*IndexerWalkCallback)(
+    IndexerUpdate* update,
+    const IndexerSource* source,
+    FuriString* path,
+    const FileInfo* file_info,
+    uint32_t mtime);
+
+static uint32_t indexer_hash(const char* path) {
+    // FNV-1a
+    uint32_t hash = 0x811C9DC5UL;
+    while(*path) {
+        hash ^= (uint8_t)*path++;
+        hash *= 0x01000193UL;
+    }
+    return hash;
+}
+
+static uint32_t indexer_doc_signature(uint32_t hash, uint64_t size, uint32_t mtime) {
+    // Order independent: bucket signature is a sum of documents signatures
+    // Modification time catches same size edits, like changed key or UID
+    return (hash ^ (uint32_t)size ^ (mtime * 0x85EBCA6BUL)) * 0x9E3779B1UL;
+}
+
+static bool indexer_walk_filter(const char* name, FileInfo* file_info, void* context) {
+    const IndexerSource* source = context;
+    if(file_info_is_dir(file_info)) return false;
+
+    size_t name_size = strlen(name);
+    size_t extension_size = strlen(source->extension);
+    return (name_size > extension_size) &&
+           (strcasecmp(&name[name_size - extension_size], source->extension) == 0);
+}
+
+static void indexer_walk(Storage* storage, IndexerUpdate* update, IndexerWalkCallback callback) {
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    FileInfo file_info;
+
+    for(size_t i = 0; i < COUNT_OF(indexer_sources); i++) {
+        const IndexerSource* source = &indexer_sources[i];
+        dir_walk_set_filter_cb(dir_walk, indexer_walk_filter, (void*)source);
+
+        if(dir_walk_open(dir_walk, source->path)) {
+            while(dir_walk_read(dir_walk, path, &file_info) == DirWalkOK) {
+                // Assets are databases, not user files
+                if(furi_string_search_str(path, "/assets/") != FURI_STRING_FAILURE) continue;
+                if(furi_string_size(path) > UINT8_MAX) continue;
+                callback(update, source, path, &file_info, dir_walk_get_mtime(dir_walk));
+            }
+        }
+        dir_walk_close(dir_walk);
+    }
+
+    furi_string_free(path);
+    dir_walk_free(dir_walk);
+}
+
+static void indexer_scan_callback(
+    IndexerUpdate* update,
+    const IndexerSource* source,
+    FuriString* path,
+    const FileInfo* file_info,
+    uint32_t mtime) {
+    UNUSED(source);
+    uint32_t hash = indexer_hash(furi_string_get_cstr(path));
+    uint8_t bucket = hash % INDEXER_BUCKETS_COUNT;
+    update->signature[bucket] += indexer_doc_signature(hash, file_info->size, mtime);
+    update->docs_count[bucket]++;
+}
+
+static bool indexer_builder_grow(void** buffer, size_t* capacity, size_t required, size_t chunk) {
+    if(required <= *capacity) {
+        return true;
+    }
+
+    size_t new_capacity = MAX(*capacity * 2, chunk);
+    while(new_capacity < required) {
+        new_capacity *= 2;
+    }
+    // Index is built in background, never starve applications for it
+    if(memmgr_heap_get_max_free_block() < new_capacity + INDEXER_HEAP_RESERVE) {
+        return false;
+    }
+
+    *buffer = realloc(*buffer, new_capacity); //-V701
+    *capacity = new_capacity;
+    return true;
+}
+
+static void indexer_builder_reset(IndexerBuilder* builder) {
+    free(builder->docs);
+    free(builder->doc_offsets);
+    free(builder->terms);
+    memset(builder, 0, sizeof(IndexerBuilder));
+}
+
+static bool indexer_builder_add_term(
+    IndexerBuilder* builder,
+    const char* value,
+    IndexerField field) {
+    if(!indexer_builder_grow(
+           (void**)&builder->terms,
+           &builder->terms_capacity,
+           (builder->terms_count + 1) * sizeof(IndexerTerm),
+           INDEXER_BUILDER_TERMS_CHUNK * sizeof(IndexerTerm))) {
+        return false;
+    }
+
+    IndexerTerm* term = &builder->terms[builder->terms_count];
+    if(indexer_normalize(value, term->value) == 0) {
+        return true;
+    }
+    term->doc = builder->docs_count - 1;
+    term->field = field;
+    term->reserved = 0;
+    builder->terms_count++;
+
+    return true;
+}
+
+static bool indexer_builder_add_doc(IndexerBuilder* builder, IndexerApp app, const char* path) {
+    size_t path_size = strlen(path);
+    size_t record_size = sizeof(IndexerDoc) + path_size;
+
+    if((builder->docs_count == UINT16_MAX) ||
+       !indexer_builder_grow(
+           (void**)&builder->docs,
+           &builder->docs_capacity,
+           builder->docs_size + record_size,
+           INDEXER_BUILDER_PATHS_CHUNK) ||
+       !indexer_builder_grow(
+           (void**)&builder->doc_offsets,
+           &builder->doc_offsets_capacity,
+           (builder->docs_count + 1) * sizeof(uint32_t),
+           INDEXER_BUILDER_TERMS_CHUNK * sizeof(uint32_t))) {
+        return false;
+    }
+
+    IndexerDoc doc = {.app = app, .path_size = path_size};
+    memcpy(&builder->docs[builder->docs_size], &doc, sizeof(IndexerDoc));
+    memcpy(&builder->docs[builder->docs_size + sizeof(IndexerDoc)], path, path_size);
+    builder->doc_offsets[builder->docs_count] = builder->docs_size;
+    builder->docs_size += record_size;
+    builder->docs_count++;
+
+    return true;
+}
+
+static bool indexer_parse_line(
+    IndexerBuilder* builder,
+    const IndexerSource* source,
+    FuriString* line,
+    bool* stop) {
+    const char* str = furi_string_get_cstr(line);
+    const char* separator = strchr(str, ':');
+    if(!separator) return true;
+
+    size_t key_size = separator - str;
+    if(source->stop_key && (strlen(source->stop_key) == key_size) &&
+       (strncmp(str, source->stop_key, key_size) == 0)) {
+        *stop = true;
+        return true;
+    }
+
+    for(size_t i = 0; i < source->keys_count; i++) {
+        const IndexerKey* key = &source->keys[i];
+        if((strlen(key->key) == key_size) && (strncmp(str, key->key, key_size) == 0)) {
+            return indexer_builder_add_term(builder, separator + 1, key->field);
+        }
+    }
+
+    return true;
+}
+
+static bool indexer_parse_doc(
+    IndexerUpdate* update,
+    IndexerBuilder* builder,
+    const IndexerSource* source,
+    FuriString* path) {
+    if(!indexer_builder_add_doc(builder, source->app, furi_string_get_cstr(path))) {
+        return false;
+    }
+
+    path_extract_filename(path, update->name, true);
+    if(!indexer_builder_add_term(builder, furi_string_get_cstr(update->name), IndexerFieldName)) {
+        return false;
+    }
+
+    bool success = true;
+    if(buffered_file_stream_open(
+           update->stream, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        bool stop = false;
+        for(size_t i = 0; (i < source->lines_max) && !stop; i++) {
+            if(!stream_read_line(update->stream, update->line)) break;
+            success = indexer_parse_line(builder, source, update->line, &stop);
+            if(!success) break;
+        }
+    }
+    buffered_file_stream_close(update->stream);
+
+    return success;
+}
+
+static void indexer_build_callback(
+    IndexerUpdate* update,
+    const IndexerSource* source,
+    FuriString* path,
+    const FileInfo* file_info,
+    uint32_t mtime) {
+    uint32_t hash = indexer_hash(furi_string_get_cstr(path));
+    uint8_t bucket = hash % INDEXER_BUCKETS_COUNT;
+    if(update->bucket_builder[bucket] < 0) return;
+
+    IndexerBuilder* builder = &update->builders[update->bucket_builder[bucket]];
+    if(builder->failed) return;
+
+    builder->signature += indexer_doc_signature(hash, file_info->size, mtime);
+    if(!indexer_parse_doc(update, builder, source, path)) {
+        FURI_LOG_W(TAG, "Bucket %u doesn't fit in memory", bucket);
+        builder->failed = true;
+    }
+}
+
+static int indexer_term_cmp(const void* a, const void* b) {
+    const IndexerTerm* term_a = a;
+    const IndexerTerm* term_b = b;
+
+    int result = strncmp(term_a->value, term_b->value, INDEXER_VALUE_SIZE);
+    if(result == 0) {
+        result = (int)term_a->doc - (int)term_b->doc;
+    }
+    if(result == 0) {
+        result = (int)term_a->field - (int)term_b->field;
+    }
+    return result;
+}
+
+static void indexer_builder_finalize(IndexerBuilder* builder) {
+    qsort(builder->terms, builder->terms_count, sizeof(IndexerTerm), indexer_term_cmp);
+
+    // Same value in the same field of one file is reported once
+    uint32_t count = 0;
+    for(uint32_t i = 0; i < builder->terms_count; i++) {
+        if(count > 0 && indexer_term_cmp(&builder->terms[count - 1], &builder->terms[i]) == 0) {
+            continue;
+        }
+        builder->terms[count++] = builder->terms[i];
+    }
+    builder->terms_count = count;
+}
+
+static bool indexer_builder_write(IndexerBuilder* builder, File* file, const char* path) {
+    uint32_t offsets_size = builder->docs_count * sizeof(uint32_t);
+    uint32_t docs_offset = sizeof(IndexerBucketHeader) + offsets_size;
+
+    IndexerBucketHeader header = {
+        .magic = INDEXER_BUCKET_MAGIC,
+        .version = INDEXER_BUCKET_VERSION,
+        .docs_count = builder->docs_count,
+        .signature = builder->signature,
+        .terms_count = builder->terms_count,
+        .terms_offset = docs_offset + builder->docs_size,
+    };
+
+    // Offsets are stored relative to the file start
+    for(uint16_t i = 0; i < builder->docs_count; i++) {
+        builder->doc_offsets[i] += docs_offset;
+    }
+
+    size_t terms_size = builder->terms_count * sizeof(IndexerTerm);
+    bool success = false;
+    do {
+        if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(file, builder->doc_offsets, offsets_size) != offsets_size) break;
+        if(storage_file_write(file, builder->docs, builder->docs_size) != builder->docs_size)
+            break;
+        if(storage_file_write(file, builder->terms, terms_size) != terms_size) break;
+        success = true;
+    } while(false);
+    storage_file_close(file);
+
+    return success;
+}
+
+static void indexer_bucket_commit(Indexer* indexer, Storage* storage, IndexerBuilder* builder) {
+    File* file = storage_file_alloc(storage);
+    FuriString* tmp_path =
+        furi_string_alloc_printf(INDEXER_BUCKET_TMP_PATH_FORMAT, builder->bucket);
+    FuriString* path = furi_string_alloc_printf(INDEXER_BUCKET_PATH_FORMAT, builder->bucket);
+
+    indexer_builder_finalize(builder);
+    if(indexer_builder_write(builder, file, furi_string_get_cstr(tmp_path))) {
+        furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+        storage_common_remove(storage, furi_string_get_cstr(path));
+        if(storage_common_rename(
+               storage, furi_string_get_cstr(tmp_path), furi_string_get_cstr(path)) == FSE_OK) {
+            IndexerBucket* bucket = &indexer->buckets[builder->bucket];
+            bucket->signature = builder->signature;
+            bucket->docs_count = builder->docs_count;
+            bucket->terms_count = builder->terms_count;
+            indexer->buckets_rebuilt++;
+        } else {
+            memset(&indexer->buckets[builder->bucket], 0, sizeof(IndexerBucket));
+        }
+        furi_mutex_release(indexer->mutex);
+    } else {
+        FURI_LOG_E(TAG, "Bucket %u write failed", builder->bucket);
+        storage_common_remove(storage, furi_string_get_cstr(tmp_path));
+    }
+
+    furi_string_free(path);
+    furi_string_free(tmp_path);
+    storage_file_free(file);
+}
+
+static void indexer_bucket_remove(Indexer* indexer, Storage* storage, uint8_t bucket) {
+    FuriString* path = furi_string_alloc_printf(INDEXER_BUCKET_PATH_FORMAT, bucket);
+
+    furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+    storage_common_remove(storage, furi_string_get_cstr(path));
+    memset(&indexer->buckets[bucket], 0, sizeof(IndexerBucket));
+    indexer->buckets_rebuilt++;
+    furi_mutex_release(indexer->mutex);
+
+    furi_string_free(path);
+}
+
+void indexer_buckets_load(Indexer* indexer) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+    IndexerBucket buckets[INDEXER_BUCKETS_COUNT];
+
+    memset(buckets, 0, sizeof(buckets));
+    for(size_t i = 0; i < INDEXER_BUCKETS_COUNT; i++) {
+        IndexerBucketHeader header;
+        furi_string_printf(path, INDEXER_BUCKET_PATH_FORMAT, i);
+        if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING) &&
+           (storage_file_read(file, &header, sizeof(header)) == sizeof(header)) &&
+           (header.magic == INDEXER_BUCKET_MAGIC) && (header.version == INDEXER_BUCKET_VERSION)) {
+            buckets[i].signature = header.signature;
+            buckets[i].docs_count = header.docs_count;
+            buckets[i].terms_count = header.terms_count;
+        }
+        storage_file_close(file);
+    }
+
+    furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+    memcpy(indexer->buckets, buckets, sizeof(buckets));
+    indexer->state = IndexerStateIdle;
+    furi_mutex_release(indexer->mutex);
+
+    furi_string_free(path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void indexer_set_state(Indexer* indexer, IndexerState state) {
+    furi_check(furi_mutex_acquire(indexer->mutex, FuriWaitForever) == FuriStatusOk);
+    indexer->state = state;
+    furi_mutex_release(indexer->mutex);
+}
+
+void indexer_buckets_update(Indexer* indexer) {
+    uint32_t start = furi_get_tick();
+    indexer_set_state(indexer, IndexerStateUpdating);
+    indexer->buckets_rebuilt = 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    IndexerUpdate* update = malloc(sizeof(IndexerUpdate));
+    update->indexer = indexer;
+    update->stream = buffered_file_stream_alloc(storage);
+    update->line = furi_string_alloc();
+    update->name = furi_string_alloc();
+
+    // Pass 1: find buckets with added, removed or resized files
+    indexer_walk(storage, update, indexer_scan_callback);
+
+    uint32_t changed = 0;
+    for(size_t i = 0; i < INDEXER_BUCKETS_COUNT; i++) {
+        // Bucket array is modified only by this thread, no lock needed for reading
+        IndexerBucket* bucket = &indexer->buckets[i];
+        if((bucket->docs_count != update->docs_count[i]) ||
+           (bucket->signature != update->signature[i])) {
+            if(update->docs_count[i] == 0) {
+                indexer_bucket_remove(indexer, storage, i);
+            } else {
+                changed |= (1UL << i);
+            }
+        }
+    }
+
+    if(changed) {
+        storage_simply_mkdir(storage, INDEXER_PATH);
+    }
+
+    // Pass 2: rebuild changed buckets, few at a time to limit memory usage
+    while(changed) {
+        memset(update->bucket_builder, -1, sizeof(update->bucket_builder));
+        update->builders_count = 0;
+        for(size_t i = 0; (i < INDEXER_BUCKETS_COUNT) &&
+                          (update->builders_count < INDEXER_BUILDERS_COUNT);
+            i++) {
+            if(changed & (1UL << i)) {
+                changed &= ~(1UL << i);
+                update->builders[update->builders_count].bucket = i;
+                update->bucket_builder[i] = update->builders_count++;
+            }
+        }
+
+        indexer_walk(storage, update, indexer_build_callback);
+
+        for(size_t i = 0; i < update->builders_count; i++) {
+            IndexerBuilder* builder = &update->builders[i];
+            if(!builder->failed) {
+                indexer_bucket_commit(indexer, storage, builder);
+            }
+            indexer_builder_reset(builder);
+        }
+    }
+
+    furi_string_free(update->name);
+    furi_string_free(update->line);
+    stream_free(update->stream);
+    free(update);
+    furi_record_close(RECORD_STORAGE);
+
+    indexer->update_time = furi_get_tick() - start;
+    indexer_set_state(indexer, IndexerStateIdle);
+    FURI_LOG_I(
+        TAG, "Updated: %lu buckets in %lu ms", indexer->buckets_rebuilt, indexer->update_time);
+}
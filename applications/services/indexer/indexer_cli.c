@@ -0,0 +1,109 @@
+#include <furi.h>
+#include <cli/cli.h>
+#include <lib/toolbox/args.h>
+
+#include "indexer.h"
+
+static void indexer_cli_print_usage() {
+    printf("Usage:\r\n");
+    printf("index <cmd> <args>\r\n");
+    printf("Cmd list:\r\n");
+    printf("\tstatus\t - show index state\r\n");
+    printf("\tupdate\t - update index now\r\n");
+    printf("\tfind <value>\t - find files with fields starting with value\r\n");
+    printf("\texact <value>\t - find files with fields equal to value\r\n");
+}
+
+static void indexer_cli_status(Indexer* indexer) {
+    const char* states[] = {
+        [IndexerStateUnavailable] = "unavailable",
+        [IndexerStateIdle] = "idle",
+        [IndexerStateUpdating] = "updating",
+    };
+
+    IndexerStats stats = indexer_get_stats(indexer);
+    printf("State: %s\r\n", states[stats.state]);
+    printf("Files: %lu\r\n", stats.docs_count);
+    printf("Values: %lu\r\n", stats.terms_count);
+    printf(
+        "Last update: %lu buckets rebuilt in %lu ms\r\n",
+        stats.buckets_rebuilt,
+        stats.update_time);
+}
+
+static bool indexer_cli_query_callback(const IndexerResult* result, void* context) {
+    Cli* cli = context;
+    printf(
+        "%s\t%s: %s\t%s\r\n",
+        indexer_app_get_name(result->app),
+        indexer_field_get_name(result->field),
+        result->value,
+        result->path);
+    return !cli_cmd_interrupt_received(cli);
+}
+
+static void indexer_cli_query(Cli* cli, Indexer* indexer, FuriString* args, IndexerMatch match) {
+    furi_string_trim(args);
+    if(furi_string_empty(args)) {
+        indexer_cli_print_usage();
+        return;
+    }
+
+    uint32_t ticks = furi_get_tick();
+    size_t matches = indexer_query(
+        indexer, furi_string_get_cstr(args), match, indexer_cli_query_callback, cli);
+    printf("%u matches in %lu ms\r\n", matches, furi_get_tick() - ticks);
+}
+
+static void indexer_cli(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    if(!furi_record_exists(RECORD_INDEXER)) {
+        printf("Indexer is not running\r\n");
+        return;
+    }
+
+    Indexer* indexer = furi_record_open(RECORD_INDEXER);
+    FuriString* cmd = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            indexer_cli_print_usage();
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "status") == 0) {
+            indexer_cli_status(indexer);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "update") == 0) {
+            indexer_update(indexer);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "find") == 0) {
+            indexer_cli_query(cli, indexer, args, IndexerMatchPrefix);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "exact") == 0) {
+            indexer_cli_query(cli, indexer, args, IndexerMatchExact);
+            break;
+        }
+
+        indexer_cli_print_usage();
+    } while(false);
+
+    furi_string_free(cmd);
+    furi_record_close(RECORD_INDEXER);
+}
+
+void indexer_on_system_start() {
+#ifdef SRV_CLI
+    Cli* cli = furi_record_open(RECORD_CLI);
+    cli_add_command(cli, "index", CliCommandFlagParallelSafe, indexer_cli, NULL);
+    furi_record_close(RECORD_CLI);
+#else
+    UNUSED(indexer_cli);
+#endif
+}
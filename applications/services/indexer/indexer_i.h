@@ -0,0 +1,87 @@
+#pragma once
+
+#include "indexer.h"
+
+#include <storage/storage.h>
+
+#define INDEXER_PATH EXT_PATH(".index")
+#define INDEXER_BUCKET_PATH_FORMAT INDEXER_PATH "/%02x.idx"
+#define INDEXER_BUCKET_TMP_PATH_FORMAT INDEXER_PATH "/%02x.tmp"
+
+#define INDEXER_BUCKET_MAGIC (0x58444946UL) // "FIDX"
+#define INDEXER_BUCKET_VERSION (2)
+#define INDEXER_BUCKETS_COUNT (32)
+#define INDEXER_VALUE_SIZE (28)
+
+typedef enum {
+    IndexerFlagUpdate = (1 << 0),
+    IndexerFlagChanged = (1 << 1),
+    IndexerFlagMount = (1 << 2),
+    IndexerFlagUnmount = (1 << 3),
+} IndexerFlag;
+
+#define INDEXER_FLAGS_ALL \
+    (IndexerFlagUpdate | IndexerFlagChanged | IndexerFlagMount | IndexerFlagUnmount)
+
+/* On SD bucket file layout:
+ *   IndexerBucketHeader
+ *   uint32_t doc_offset[docs_count]       offsets of documents from file start
+ *   IndexerDoc + path, docs_count times   path is not NUL-terminated
+ *   IndexerTerm[terms_count]              sorted by value, then doc
+ *
+ * Files are distributed between buckets by path hash, so only buckets with changed
+ * files are rebuilt on update and only one bucket at a time is held in memory.
+ */
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t docs_count;
+    uint32_t signature;
+    uint32_t terms_count;
+    uint32_t terms_offset;
+} __attribute__((packed)) IndexerBucketHeader;
+
+typedef struct {
+    uint8_t app;
+    uint8_t path_size;
+} __attribute__((packed)) IndexerDoc;
+
+typedef struct {
+    char value[INDEXER_VALUE_SIZE];
+    uint16_t doc;
+    uint8_t field;
+    uint8_t reserved;
+} __attribute__((packed)) IndexerTerm;
+
+/** In memory copy of bucket header, used to find changed buckets and skip empty ones */
+typedef struct {
+    uint32_t signature;
+    uint16_t docs_count;
+    uint32_t terms_count;
+} IndexerBucket;
+
+struct Indexer {
+    FuriThreadId thread_id;
+    FuriMutex* mutex;
+    FuriPubSubSubscription* storage_subscription;
+
+    IndexerBucket buckets[INDEXER_BUCKETS_COUNT];
+    IndexerState state;
+    uint32_t storage_timestamp;
+    uint32_t buckets_rebuilt;
+    uint32_t update_time;
+};
+
+/** Normalize value for indexing and search: remove spaces, uppercase, truncate
+ * @param value source string
+ * @param out output buffer, INDEXER_VALUE_SIZE bytes
+ * @return normalized value length
+ */
+size_t indexer_normalize(const char* value, char* out);
+
+/** Read headers of all bucket files into memory */
+void indexer_buckets_load(Indexer* indexer);
+
+/** Find files changed since last update and rebuild their buckets */
+void indexer_buckets_update(Indexer* indexer);
@@ -81,6 +81,7 @@ struct RpcSession {
     RpcSessionClosedCallback closed_callback;
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
+    uint32_t flags;
     bool status;
     void* context;
 };
@@ -94,6 +95,16 @@ RpcOwner rpc_session_get_owner(RpcSession* session) {
     return session->owner;
 }
 
+void rpc_session_set_flags(RpcSession* session, uint32_t flags) {
+    furi_assert(session);
+    session->flags = flags;
+}
+
+uint32_t rpc_session_get_flags(RpcSession* session) {
+    furi_assert(session);
+    return session->flags;
+}
+
 static void rpc_close_session_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
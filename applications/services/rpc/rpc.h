@@ -45,6 +45,28 @@ typedef enum {
  */
 RpcOwner rpc_session_get_owner(RpcSession* session);
 
+/** RPC session options, agreed with client by transport layer */
+typedef enum {
+    RpcSessionFlagNone = 0,
+    /** Screen frames are delta encoded, see rpc_gui_stream.h */
+    RpcSessionFlagScreenStreamDelta = (1 << 0),
+} RpcSessionFlag;
+
+/** Set RPC session options
+ * Must be called before first rpc_session_feed()
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @param   flags       RpcSessionFlag bits
+ */
+void rpc_session_set_flags(RpcSession* session, uint32_t flags);
+
+/** Get RPC session options
+ *
+ * @param   session     pointer to RpcSession descriptor
+ * @return              RpcSessionFlag bits
+ */
+uint32_t rpc_session_get_flags(RpcSession* session);
+
 /** Open RPC session
  *
  * USAGE:
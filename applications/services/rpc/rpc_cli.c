@@ -2,6 +2,7 @@
 #include <furi.h>
 #include <rpc/rpc.h>
 #include <furi_hal.h>
+#include <toolbox/args.h>
 #include <semphr.h>
 
 #define TAG "RpcCli"
@@ -14,6 +15,9 @@ typedef struct {
 
 #define CLI_READ_BUFFER_SIZE 64
 
+/** Session option: delta encoded screen stream frames */
+#define RPC_CLI_OPTION_SCREEN_DELTA "screen_delta"
+
 static void rpc_cli_send_bytes_callback(void* context, uint8_t* bytes, size_t bytes_len) {
     furi_assert(context);
     furi_assert(bytes);
@@ -38,7 +42,6 @@ static void rpc_cli_session_terminated_callback(void* context) {
 }
 
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
-    UNUSED(args);
     furi_assert(cli);
     furi_assert(context);
     Rpc* rpc = context;
@@ -54,6 +57,17 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
         return;
     }
 
+    // Client without options gets plain session, like before
+    uint32_t flags = RpcSessionFlagNone;
+    FuriString* option = furi_string_alloc();
+    while(args_read_string_and_trim(args, option)) {
+        if(furi_string_cmp_str(option, RPC_CLI_OPTION_SCREEN_DELTA) == 0) {
+            flags |= RpcSessionFlagScreenStreamDelta;
+        }
+    }
+    furi_string_free(option);
+    rpc_session_set_flags(rpc_session, flags);
+
     CliRpc cli_rpc = {.cli = cli, .session_close_request = false};
     cli_rpc.terminate_semaphore = furi_semaphore_alloc(1, 0);
     rpc_session_set_context(rpc_session, &cli_rpc);
@@ -1,5 +1,6 @@
 #include "flipper.pb.h"
 #include "rpc_i.h"
+#include "rpc_gui_stream.h"
 #include "gui.pb.h"
 #include <gui/gui_i.h>
 #include <desktop/desktop_settings.h>
@@ -16,6 +17,11 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+#define RPC_GUI_STREAM_KEYFRAME_INTERVAL (64u)
+/** Part of measured link throughput screen stream may use, percents */
+#define RPC_GUI_STREAM_LINK_SHARE (50u)
+#define RPC_GUI_STREAM_FRAME_INTERVAL_MAX (1000u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -27,6 +33,12 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    FuriMutex* stream_mutex;
+    uint8_t* stream_frame;
+    uint8_t* stream_transmit_frame;
+    PB_Gui_ScreenOrientation stream_orientation;
+    bool stream_pending;
+    RpcGuiStreamEncoder* stream_encoder;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -51,51 +63,115 @@ static void rpc_system_gui_screen_stream_frame_callback(
     uint8_t* data,
     size_t size,
     CanvasOrientation orientation,
+    const CanvasDamage* damage,
     void* context) {
     furi_assert(data);
+    furi_assert(damage);
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
-
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
-
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
+    PB_Gui_ScreenOrientation screen_orientation =
         rpc_system_gui_screen_orientation_map[orientation];
 
-    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+    furi_mutex_acquire(rpc_gui->stream_mutex, FuriWaitForever);
+    // Don't send the same frame again
+    bool changed = damage->pages || (screen_orientation != rpc_gui->stream_orientation);
+    if(changed) {
+        // Frame waiting for transmission is replaced, so slow link skips frames
+        memcpy(rpc_gui->stream_frame, data, size);
+        rpc_gui->stream_orientation = screen_orientation;
+        rpc_gui->stream_pending = true;
+    }
+    furi_mutex_release(rpc_gui->stream_mutex);
+
+    if(changed) {
+        furi_thread_flags_set(
+            furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+    }
 }
 
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
 
-    uint32_t transmit_time = 0;
+    uint32_t next_transmit = furi_get_tick();
+    uint32_t rate = 0;
     while(true) {
         uint32_t flags =
             furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
 
-        if(flags & RpcGuiWorkerFlagTransmit) {
-            transmit_time = furi_get_tick();
-            rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
-            transmit_time = furi_get_tick() - transmit_time;
+        if(flags & RpcGuiWorkerFlagExit) {
+            break;
+        }
 
-            // Guaranteed bandwidth reserve
-            uint32_t extra_delay = transmit_time / 20;
-            if(extra_delay > 500) extra_delay = 500;
-            if(extra_delay) furi_delay_tick(extra_delay);
+        // Keep link share for other traffic, frames committed meanwhile replace pending one
+        int32_t delay = next_transmit - furi_get_tick();
+        if(delay > 0) {
+            flags = furi_thread_flags_wait(RpcGuiWorkerFlagExit, FuriFlagWaitAny, delay);
+            if(!(flags & FuriFlagError) && (flags & RpcGuiWorkerFlagExit)) {
+                break;
+            }
         }
 
-        if(flags & RpcGuiWorkerFlagExit) {
-            break;
+        furi_mutex_acquire(rpc_gui->stream_mutex, FuriWaitForever);
+        bool pending = rpc_gui->stream_pending;
+        if(pending) {
+            memcpy(rpc_gui->stream_transmit_frame, rpc_gui->stream_frame, framebuffer_size);
+            frame->orientation = rpc_gui->stream_orientation;
+            rpc_gui->stream_pending = false;
         }
+        furi_mutex_release(rpc_gui->stream_mutex);
+        if(!pending) continue;
+
+        if(rpc_gui->stream_encoder) {
+            frame->data->size = rpc_gui_stream_encode(
+                rpc_gui->stream_encoder, rpc_gui->stream_transmit_frame, frame->data->bytes);
+        } else {
+            memcpy(frame->data->bytes, rpc_gui->stream_transmit_frame, framebuffer_size);
+            frame->data->size = framebuffer_size;
+        }
+
+        uint32_t transmit_start = furi_get_tick();
+        rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
+        uint32_t transmit_time = furi_get_tick() - transmit_start;
+
+        // Link throughput estimate, bytes per second
+        uint32_t sample = frame->data->size * 1000 / MAX(transmit_time, 1UL);
+        rate = rate ? (rate * 3 + sample) / 4 : sample;
+        uint32_t interval = (uint64_t)frame->data->size * 1000 * 100 /
+                            ((uint64_t)MAX(rate, 1UL) * RPC_GUI_STREAM_LINK_SHARE);
+        next_transmit = transmit_start + MIN(interval, RPC_GUI_STREAM_FRAME_INTERVAL_MAX);
     }
 
     return 0;
 }
 
+static void rpc_system_gui_screen_stream_free(RpcGuiSystem* rpc_gui) {
+    rpc_gui->is_streaming = false;
+    // Remove GUI framebuffer callback
+    gui_remove_framebuffer_damage_callback(
+        rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, rpc_gui);
+    // Stop and release worker thread
+    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
+    furi_thread_join(rpc_gui->transmit_thread);
+    furi_thread_free(rpc_gui->transmit_thread);
+    // Release frame
+    pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
+    free(rpc_gui->transmit_frame);
+    rpc_gui->transmit_frame = NULL;
+    // Release stream state
+    if(rpc_gui->stream_encoder) {
+        rpc_gui_stream_encoder_free(rpc_gui->stream_encoder);
+        rpc_gui->stream_encoder = NULL;
+    }
+    free(rpc_gui->stream_frame);
+    free(rpc_gui->stream_transmit_frame);
+    furi_mutex_free(rpc_gui->stream_mutex);
+}
+
 static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -112,21 +188,36 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
     } else {
         rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
 
+        // Protobuf schema has no stream options, client asks for delta frames on session start
+        bool delta = rpc_session_get_flags(session) & RpcSessionFlagScreenStreamDelta;
+
         rpc_gui->is_streaming = true;
         size_t framebuffer_size = gui_get_framebuffer_size(rpc_gui->gui);
+        size_t frame_size =
+            delta ? rpc_gui_stream_get_max_size(framebuffer_size) : framebuffer_size;
         // Reusable Frame
         rpc_gui->transmit_frame = malloc(sizeof(PB_Main));
         rpc_gui->transmit_frame->which_content = PB_Main_gui_screen_frame_tag;
         rpc_gui->transmit_frame->command_status = PB_CommandStatus_OK;
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
-            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
-        rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+            malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(frame_size));
+        rpc_gui->transmit_frame->content.gui_screen_frame.data->size = frame_size;
+        // Latest frame and frame being transmitted
+        rpc_gui->stream_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        rpc_gui->stream_frame = malloc(framebuffer_size);
+        rpc_gui->stream_transmit_frame = malloc(framebuffer_size);
+        rpc_gui->stream_orientation = PB_Gui_ScreenOrientation_HORIZONTAL;
+        rpc_gui->stream_pending = false;
+        if(delta) {
+            rpc_gui->stream_encoder = rpc_gui_stream_encoder_alloc(
+                framebuffer_size, RPC_GUI_STREAM_KEYFRAME_INTERVAL);
+        }
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
         furi_thread_start(rpc_gui->transmit_thread);
         // GUI framebuffer callback
-        gui_add_framebuffer_callback(
+        gui_add_framebuffer_damage_callback(
             rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
     }
 }
@@ -142,18 +233,7 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
     furi_assert(session);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_free(rpc_gui);
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -484,18 +564,7 @@ void rpc_system_gui_free(void* context) {
     view_port_free(rpc_gui->rpc_session_active_viewport_slim);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_free(rpc_gui);
     }
     furi_record_close(RECORD_GUI);
     free(rpc_gui);
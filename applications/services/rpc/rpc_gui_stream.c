@@ -0,0 +1,270 @@
+#include "rpc_gui_stream.h"
+
+#include <furi.h>
+#include <toolbox/compress.h>
+
+#define TAG "RpcGuiStream"
+
+#define RPC_GUI_STREAM_RLE_RUN_MAX (128)
+/** RLE output size that is good enough to skip heatshrink, part of frame size */
+#define RPC_GUI_STREAM_RLE_GOOD_RATIO (16)
+/** Heatshrink input buffer, encoder doesn't use it */
+#define RPC_GUI_STREAM_ENCODER_BUFF_SIZE (128)
+/** Heatshrink output worst case: 9 bits per literal, plus header and slack */
+#define RPC_GUI_STREAM_COMPRESSED_SIZE(frame_size) ((frame_size) + (frame_size) / 8 + 16)
+
+struct RpcGuiStreamEncoder {
+    size_t frame_size;
+    uint16_t keyframe_interval;
+    uint16_t frames_since_keyframe;
+    uint16_t sequence;
+    bool keyframe;
+    uint8_t* previous;
+    uint8_t* delta;
+    uint8_t* compressed;
+    Compress* compress;
+};
+
+struct RpcGuiStreamDecoder {
+    size_t frame_size;
+    bool valid;
+    uint16_t sequence;
+    uint8_t* frame;
+    uint8_t* delta;
+    Compress* compress;
+};
+
+static size_t rpc_gui_stream_rle_encode(
+    const uint8_t* in,
+    size_t in_size,
+    uint8_t* out,
+    size_t out_size) {
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+
+    while(in_pos < in_size) {
+        if(out_pos >= out_size) return 0;
+
+        size_t run = 0;
+        while((in_pos + run < in_size) && (in[in_pos + run] == 0) &&
+              (run < RPC_GUI_STREAM_RLE_RUN_MAX)) {
+            run++;
+        }
+
+        if(run >= 2) {
+            out[out_pos++] = 0x80 | (run - 1);
+            in_pos += run;
+            continue;
+        }
+
+        // Literals up to the next pair of zeros
+        size_t literal = 0;
+        while((in_pos + literal < in_size) && (literal < RPC_GUI_STREAM_RLE_RUN_MAX)) {
+            size_t pos = in_pos + literal;
+            if((in[pos] == 0) && (pos + 1 < in_size) && (in[pos + 1] == 0)) break;
+            literal++;
+        }
+
+        if(out_pos + 1 + literal > out_size) return 0;
+        out[out_pos++] = literal - 1;
+        memcpy(&out[out_pos], &in[in_pos], literal);
+        out_pos += literal;
+        in_pos += literal;
+    }
+
+    return out_pos;
+}
+
+static bool rpc_gui_stream_rle_decode(
+    const uint8_t* in,
+    size_t in_size,
+    uint8_t* out,
+    size_t out_size) {
+    size_t in_pos = 0;
+    size_t out_pos = 0;
+
+    while(in_pos < in_size) {
+        uint8_t token = in[in_pos++];
+        size_t count = (token & 0x7F) + 1;
+        if(out_pos + count > out_size) return false;
+
+        if(token & 0x80) {
+            memset(&out[out_pos], 0, count);
+        } else {
+            if(in_pos + count > in_size) return false;
+            memcpy(&out[out_pos], &in[in_pos], count);
+            in_pos += count;
+        }
+        out_pos += count;
+    }
+
+    return out_pos == out_size;
+}
+
+size_t rpc_gui_stream_get_max_size(size_t frame_size) {
+    return sizeof(RpcGuiStreamHeader) + frame_size;
+}
+
+RpcGuiStreamEncoder* rpc_gui_stream_encoder_alloc(size_t frame_size, uint16_t keyframe_interval) {
+    furi_assert(frame_size);
+    furi_assert(keyframe_interval);
+
+    RpcGuiStreamEncoder* encoder = malloc(sizeof(RpcGuiStreamEncoder));
+    encoder->frame_size = frame_size;
+    encoder->keyframe_interval = keyframe_interval;
+    encoder->keyframe = true;
+    encoder->previous = malloc(frame_size);
+    encoder->delta = malloc(frame_size);
+    // compress_encode must never run out of output space, even on noise
+    encoder->compressed = malloc(RPC_GUI_STREAM_COMPRESSED_SIZE(frame_size));
+    encoder->compress = compress_alloc(RPC_GUI_STREAM_ENCODER_BUFF_SIZE);
+    return encoder;
+}
+
+void rpc_gui_stream_encoder_free(RpcGuiStreamEncoder* encoder) {
+    furi_assert(encoder);
+    compress_free(encoder->compress);
+    free(encoder->compressed);
+    free(encoder->delta);
+    free(encoder->previous);
+    free(encoder);
+}
+
+void rpc_gui_stream_encoder_reset(RpcGuiStreamEncoder* encoder) {
+    furi_assert(encoder);
+    encoder->keyframe = true;
+}
+
+size_t rpc_gui_stream_encode(RpcGuiStreamEncoder* encoder, const uint8_t* frame, uint8_t* data) {
+    furi_assert(encoder);
+    furi_assert(frame);
+    furi_assert(data);
+
+    size_t frame_size = encoder->frame_size;
+    bool keyframe = encoder->keyframe ||
+                    (encoder->frames_since_keyframe >= encoder->keyframe_interval);
+
+    if(keyframe) {
+        memcpy(encoder->delta, frame, frame_size);
+        encoder->frames_since_keyframe = 0;
+        encoder->keyframe = false;
+    } else {
+        for(size_t i = 0; i < frame_size; i++) {
+            encoder->delta[i] = frame[i] ^ encoder->previous[i];
+        }
+    }
+    encoder->frames_since_keyframe++;
+    memcpy(encoder->previous, frame, frame_size);
+
+    uint8_t* payload = &data[sizeof(RpcGuiStreamHeader)];
+    RpcGuiStreamEncoding encoding = RpcGuiStreamEncodingRle;
+    size_t size = rpc_gui_stream_rle_encode(encoder->delta, frame_size, payload, frame_size);
+
+    // RLE is enough for small changes, heatshrink wins on keyframes and big changes
+    if(!size || (size > frame_size / RPC_GUI_STREAM_RLE_GOOD_RATIO)) {
+        size_t compressed_size = 0;
+        bool compressed = compress_encode(
+            encoder->compress,
+            encoder->delta,
+            frame_size,
+            encoder->compressed,
+            RPC_GUI_STREAM_COMPRESSED_SIZE(frame_size),
+            &compressed_size);
+        // First byte is set if data was actually compressed
+        if(compressed && encoder->compressed[0] && (compressed_size < frame_size) &&
+           (!size || (compressed_size < size))) {
+            memcpy(payload, encoder->compressed, compressed_size);
+            size = compressed_size;
+            encoding = RpcGuiStreamEncodingHeatshrink;
+        }
+    }
+
+    if(!size) {
+        memcpy(payload, encoder->delta, frame_size);
+        size = frame_size;
+        encoding = RpcGuiStreamEncodingStored;
+    }
+
+    RpcGuiStreamHeader header = {
+        .flags = keyframe ? RPC_GUI_STREAM_FLAG_KEYFRAME : 0,
+        .encoding = encoding,
+        .sequence = encoder->sequence++,
+    };
+    memcpy(data, &header, sizeof(RpcGuiStreamHeader));
+
+    return sizeof(RpcGuiStreamHeader) + size;
+}
+
+RpcGuiStreamDecoder* rpc_gui_stream_decoder_alloc(size_t frame_size) {
+    furi_assert(frame_size);
+
+    RpcGuiStreamDecoder* decoder = malloc(sizeof(RpcGuiStreamDecoder));
+    decoder->frame_size = frame_size;
+    decoder->frame = malloc(frame_size);
+    decoder->delta = malloc(frame_size);
+    decoder->compress = compress_alloc(frame_size);
+    return decoder;
+}
+
+void rpc_gui_stream_decoder_free(RpcGuiStreamDecoder* decoder) {
+    furi_assert(decoder);
+    compress_free(decoder->compress);
+    free(decoder->delta);
+    free(decoder->frame);
+    free(decoder);
+}
+
+const uint8_t*
+    rpc_gui_stream_decode(RpcGuiStreamDecoder* decoder, const uint8_t* data, size_t size) {
+    furi_assert(decoder);
+    furi_assert(data);
+
+    if(size < sizeof(RpcGuiStreamHeader)) return NULL;
+
+    RpcGuiStreamHeader header;
+    memcpy(&header, data, sizeof(RpcGuiStreamHeader));
+    bool keyframe = header.flags & RPC_GUI_STREAM_FLAG_KEYFRAME;
+    if(!keyframe && (!decoder->valid || (header.sequence != (uint16_t)(decoder->sequence + 1)))) {
+        FURI_LOG_W(TAG, "Frame %u is out of sequence", header.sequence);
+        return NULL;
+    }
+
+    const uint8_t* payload = &data[sizeof(RpcGuiStreamHeader)];
+    size_t payload_size = size - sizeof(RpcGuiStreamHeader);
+    size_t frame_size = decoder->frame_size;
+    bool decoded = false;
+
+    if(header.encoding == RpcGuiStreamEncodingStored) {
+        decoded = payload_size == frame_size;
+        if(decoded) memcpy(decoder->delta, payload, frame_size);
+    } else if(header.encoding == RpcGuiStreamEncodingRle) {
+        decoded = rpc_gui_stream_rle_decode(payload, payload_size, decoder->delta, frame_size);
+    } else if(header.encoding == RpcGuiStreamEncodingHeatshrink) {
+        size_t decoded_size = 0;
+        decoded = compress_decode(
+                      decoder->compress,
+                      (uint8_t*)payload,
+                      payload_size,
+                      decoder->delta,
+                      frame_size,
+                      &decoded_size) &&
+                  (decoded_size == frame_size);
+    }
+
+    if(!decoded) {
+        decoder->valid = false;
+        return NULL;
+    }
+
+    if(keyframe) {
+        memcpy(decoder->frame, decoder->delta, frame_size);
+    } else {
+        for(size_t i = 0; i < frame_size; i++) {
+            decoder->frame[i] ^= decoder->delta[i];
+        }
+    }
+    decoder->valid = true;
+    decoder->sequence = header.sequence;
+
+    return decoder->frame;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file rpc_gui_stream.h
+ * RPC: screen stream delta codec
+ *
+ * Delta mode is asked for on session start, `start_rpc_session screen_delta`
+ * in CLI, see RpcSessionFlagScreenStreamDelta.
+ *
+ * In delta mode every ScreenFrame data starts with RpcGuiStreamHeader.
+ * Keyframe payload is encoded framebuffer, other frames carry framebuffer XOR
+ * previous frame, so unchanged pixels are zeros and compress well.
+ *
+ * Payload encodings:
+ * - Stored: bytes as is.
+ * - Rle: tokens, token with high bit set is (token & 0x7F) + 1 zero bytes,
+ *   otherwise token + 1 literal bytes follow.
+ * - Heatshrink: toolbox compress_encode output.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_GUI_STREAM_FLAG_KEYFRAME (1 << 0)
+
+typedef enum {
+    RpcGuiStreamEncodingStored,
+    RpcGuiStreamEncodingRle,
+    RpcGuiStreamEncodingHeatshrink,
+} RpcGuiStreamEncoding;
+
+typedef struct {
+    uint8_t flags;
+    uint8_t encoding; /**< RpcGuiStreamEncoding */
+    uint16_t sequence; /**< Frame number, delta applies to previous sequence */
+} __attribute__((packed)) RpcGuiStreamHeader;
+
+typedef struct RpcGuiStreamEncoder RpcGuiStreamEncoder;
+
+typedef struct RpcGuiStreamDecoder RpcGuiStreamDecoder;
+
+/** Get maximum encoded frame size
+ *
+ * @param frame_size framebuffer size
+ * @return size of the output buffer for rpc_gui_stream_encode
+ */
+size_t rpc_gui_stream_get_max_size(size_t frame_size);
+
+/** Allocate encoder
+ *
+ * @param frame_size framebuffer size
+ * @param keyframe_interval frames between keyframes
+ * @return RpcGuiStreamEncoder instance
+ */
+RpcGuiStreamEncoder* rpc_gui_stream_encoder_alloc(size_t frame_size, uint16_t keyframe_interval);
+
+/** Free encoder
+ *
+ * @param encoder RpcGuiStreamEncoder instance
+ */
+void rpc_gui_stream_encoder_free(RpcGuiStreamEncoder* encoder);
+
+/** Make next encoded frame a keyframe
+ *
+ * @param encoder RpcGuiStreamEncoder instance
+ */
+void rpc_gui_stream_encoder_reset(RpcGuiStreamEncoder* encoder);
+
+/** Encode frame against previously encoded one
+ *
+ * @param encoder RpcGuiStreamEncoder instance
+ * @param frame framebuffer
+ * @param data output buffer, rpc_gui_stream_get_max_size bytes
+ * @return encoded size
+ */
+size_t rpc_gui_stream_encode(RpcGuiStreamEncoder* encoder, const uint8_t* frame, uint8_t* data);
+
+/** Allocate decoder
+ *
+ * @param frame_size framebuffer size
+ * @return RpcGuiStreamDecoder instance
+ */
+RpcGuiStreamDecoder* rpc_gui_stream_decoder_alloc(size_t frame_size);
+
+/** Free decoder
+ *
+ * @param decoder RpcGuiStreamDecoder instance
+ */
+void rpc_gui_stream_decoder_free(RpcGuiStreamDecoder* decoder);
+
+/** Decode frame
+ *
+ * @param decoder RpcGuiStreamDecoder instance
+ * @param data encoded frame
+ * @param size encoded frame size
+ * @return decoded framebuffer or NULL if data is damaged or frame is out of sequence
+ */
+const uint8_t*
+    rpc_gui_stream_decode(RpcGuiStreamDecoder* decoder, const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
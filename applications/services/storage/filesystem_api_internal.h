@@ -125,6 +125,7 @@ typedef struct {
  *      @param fileinfo pointer to read FileInfo, can be NULL
  *      @param name pointer to name buffer, can be NULL
  *      @param name_length name buffer length
+ *      @param mtime pointer to read FAT modification date and time (0 if unknown), can be NULL
  *      @return success flag (if next object not exist also returns false and set error_id to FSE_NOT_EXIST)
  * 
  *  @var FS_Dir_Api::rewind
@@ -140,7 +141,8 @@ typedef struct {
         File* file,
         FileInfo* fileinfo,
         char* name,
-        uint16_t name_length);
+        uint16_t name_length,
+        uint32_t* mtime);
     bool (*const rewind)(void* context, File* file);
 } FS_Dir_Api;
 
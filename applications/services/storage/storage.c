@@ -101,19 +101,34 @@ void storage_tick(Storage* app) {
     }
 }
 
+static void storage_message_queue_callback(FuriMessageQueue* queue, void* context) {
+    Storage* app = context;
+    StorageMessage message;
+    // One message per call, timer is checked in between
+    if(furi_message_queue_get(queue, &message, 0) == FuriStatusOk) {
+        storage_process_message(app, &message);
+    }
+}
+
+static void storage_tick_callback(void* context) {
+    Storage* app = context;
+    storage_tick(app);
+}
+
 int32_t storage_srv(void* p) {
     UNUSED(p);
     Storage* app = storage_app_alloc();
     furi_record_create(RECORD_STORAGE, app);
 
-    StorageMessage message;
-    while(1) {
-        if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
-            storage_process_message(app, &message);
-        } else {
-            storage_tick(app);
-        }
-    }
+    // Tick runs on time even when queue is never idle
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        event_loop, app->message_queue, storage_message_queue_callback, app);
+    FuriEventLoopTimer* tick_timer = furi_event_loop_timer_alloc(
+        event_loop, storage_tick_callback, FuriEventLoopTimerTypePeriodic, app);
+    furi_event_loop_timer_start(tick_timer, STORAGE_TICK);
+
+    furi_event_loop_run(event_loop);
 
     return 0;
 }
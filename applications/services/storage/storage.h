@@ -309,6 +309,72 @@ FS_Error storage_common_migrate(Storage* storage, const char* source, const char
  */
 bool storage_common_exists(Storage* storage, const char* path);
 
+/******************* Batch Functions *******************/
+
+/** Batched operation type */
+typedef enum {
+    StorageBatchOpStat, /**< storage_common_stat: path, fileinfo (may be NULL) */
+    StorageBatchOpFileOpen, /**< storage_file_open: file, path, access_mode, open_mode */
+    StorageBatchOpFileRead, /**< storage_file_read: file, buff, size */
+    StorageBatchOpFileSeek, /**< storage_file_seek: file, offset, from_start */
+    StorageBatchOpFileClose, /**< storage_file_close: file */
+    StorageBatchOpDirRead, /**< storage_dir_read: file, fileinfo (may be NULL), buff, size */
+} StorageBatchOpType;
+
+/** Single operation of a batch
+ * Fill the arguments required by the operation type, results are filled by the storage.
+ */
+typedef struct {
+    StorageBatchOpType type;
+
+    File* file;
+    const char* path;
+    FileInfo* fileinfo;
+    void* buff;
+    uint16_t size;
+    uint32_t offset;
+    bool from_start;
+    FS_AccessMode access_mode;
+    FS_OpenMode open_mode;
+
+    FS_Error error; /**< operation result, filled by storage */
+    uint16_t bytes_read; /**< bytes read by StorageBatchOpFileRead, filled by storage */
+    uint32_t mtime; /**< FAT date and time of entry read by StorageBatchOpDirRead, 0 if unknown */
+} StorageBatchOp;
+
+/** Executes a batch of operations in one storage service round trip
+ * Operations are executed in order. Unlike storage_file_open and storage_dir_open,
+ * StorageBatchOpFileOpen does not wait for an already open file to be closed and
+ * fails with FSE_ALREADY_OPEN instead.
+ * You need to close files opened by a batch even if the open operation failed.
+ *
+ * @param storage pointer to the api
+ * @param ops array of operations
+ * @param ops_count operations count
+ * @param stop_on_error stop processing on the first operation that returned an error
+ * @return size_t count of executed operations, results of the rest are left untouched
+ */
+size_t storage_batch_execute(
+    Storage* storage,
+    StorageBatchOp* ops,
+    size_t ops_count,
+    bool stop_on_error);
+
+/** Scatter read buffer */
+typedef struct {
+    void* buff;
+    uint16_t size;
+} StorageIoVec;
+
+/** Reads bytes from a file into several buffers in one storage service round trip
+ * Buffers are filled in order, reading stops on the first short read.
+ * @param file pointer to file object.
+ * @param iov array of buffers
+ * @param iov_count buffers count
+ * @return size_t how many bytes were actually read
+ */
+size_t storage_file_read_v(File* file, const StorageIoVec* iov, size_t iov_count);
+
 /******************* Error Functions *******************/
 
 /** Retrieves the error text from the error id
@@ -367,13 +433,14 @@ FS_Error storage_sd_status(Storage* api);
 typedef void (*Storage_name_converter)(FuriString*);
 
 /** Backs up internal storage to a tar archive
+ * Archive is heatshrink compressed if dstname ends with ".tar.hs"
  * @param api pointer to the api
  * @param dstname destination archive path
  * @return FS_Error operation result
  */
 FS_Error storage_int_backup(Storage* api, const char* dstname);
 
-/** Restores internal storage from a tar archive
+/** Restores internal storage from a tar archive, plain or compressed
  * @param api pointer to the api
  * @param dstname archive path
  * @param converter pointer to filename conversion function, may be NULL
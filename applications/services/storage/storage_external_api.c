@@ -43,6 +43,7 @@
 #define S_RETURN_BOOL (return_data.bool_value);
 #define S_RETURN_UINT16 (return_data.uint16_value);
 #define S_RETURN_UINT64 (return_data.uint64_value);
+#define S_RETURN_SIZE (return_data.size_value);
 #define S_RETURN_ERROR (return_data.error_value);
 #define S_RETURN_CSTRING (return_data.cstring_value);
 
@@ -287,6 +288,26 @@ bool storage_file_copy_to_file(File* source, File* destination, uint32_t size) {
     return size == 0;
 }
 
+size_t storage_file_read_v(File* file, const StorageIoVec* iov, size_t iov_count) {
+    if(iov_count == 0) {
+        return 0;
+    }
+
+    S_FILE_API_PROLOGUE;
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .freadv = {
+            .file = file,
+            .iov = iov,
+            .iov_count = iov_count,
+        }};
+
+    S_API_MESSAGE(StorageCommandFileReadV);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 /****************** DIR ******************/
 
 static bool storage_dir_open_internal(File* file, const char* path) {
@@ -757,6 +778,32 @@ bool storage_common_exists(Storage* storage, const char* path) {
     return storage_common_stat(storage, path, &file_info) == FSE_OK;
 }
 
+/****************** BATCH ******************/
+
+size_t storage_batch_execute(
+    Storage* storage,
+    StorageBatchOp* ops,
+    size_t ops_count,
+    bool stop_on_error) {
+    if(ops_count == 0) {
+        return 0;
+    }
+
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .batch = {
+            .ops = ops,
+            .ops_count = ops_count,
+            .stop_on_error = stop_on_error,
+            .thread_id = furi_thread_get_current_id(),
+        }};
+
+    S_API_MESSAGE(StorageCommandBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_SIZE;
+}
+
 /****************** ERROR ******************/
 
 const char* storage_error_get_desc(FS_Error error_id) {
@@ -25,6 +25,7 @@ struct Storage {
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    uint32_t processed_messages; /**< API round trips counter, for diagnostics */
 };
 
 #ifdef __cplusplus
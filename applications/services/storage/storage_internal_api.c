@@ -4,7 +4,8 @@
 
 FS_Error storage_int_backup(Storage* api, const char* dstname) {
     TarArchive* archive = tar_archive_alloc(api);
-    bool success = tar_archive_open(archive, dstname, TAR_OPEN_MODE_WRITE) &&
+    TarOpenMode mode = tar_archive_get_write_mode_for_path(dstname);
+    bool success = tar_archive_open(archive, dstname, mode) &&
                    tar_archive_add_dir(archive, STORAGE_INT_PATH_PREFIX, "") &&
                    tar_archive_finalize(archive);
     tar_archive_free(archive);
@@ -91,12 +91,26 @@ typedef struct {
     SDInfo* info;
 } SAInfo;
 
+typedef struct {
+    StorageBatchOp* ops;
+    size_t ops_count;
+    bool stop_on_error;
+    FuriThreadId thread_id;
+} SADataBatch;
+
+typedef struct {
+    File* file;
+    const StorageIoVec* iov;
+    size_t iov_count;
+} SADataFReadV;
+
 typedef union {
     SADataFOpen fopen;
     SADataFRead fread;
     SADataFWrite fwrite;
     SADataFSeek fseek;
     SADataFExpand fexpand;
+    SADataFReadV freadv;
 
     SADataDOpen dopen;
     SADataDRead dread;
@@ -112,12 +126,15 @@ typedef union {
     SADataPath path;
 
     SAInfo sdinfo;
+
+    SADataBatch batch;
 } SAData;
 
 typedef union {
     bool bool_value;
     uint16_t uint16_value;
     uint64_t uint64_value;
+    size_t size_value;
     FS_Error error_value;
     const char* cstring_value;
 } SAReturn;
@@ -148,6 +165,8 @@ typedef enum {
     StorageCommandSDInfo,
     StorageCommandSDStatus,
     StorageCommandCommonResolvePath,
+    StorageCommandFileReadV,
+    StorageCommandBatch,
 } StorageCommand;
 
 typedef struct {
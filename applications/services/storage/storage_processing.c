@@ -158,6 +158,22 @@ static uint16_t
     return ret;
 }
 
+static size_t storage_process_file_read_v(
+    Storage* app,
+    File* file,
+    const StorageIoVec* iov,
+    const size_t iov_count) {
+    size_t ret = 0;
+
+    for(size_t i = 0; i < iov_count; i++) {
+        uint16_t bytes_read = storage_process_file_read(app, file, iov[i].buff, iov[i].size);
+        ret += bytes_read;
+        if(bytes_read != iov[i].size) break;
+    }
+
+    return ret;
+}
+
 static uint16_t storage_process_file_write(
     Storage* app,
     File* file,
@@ -314,14 +330,15 @@ bool storage_process_dir_read(
     File* file,
     FileInfo* fileinfo,
     char* name,
-    const uint16_t name_length) {
+    const uint16_t name_length,
+    uint32_t* mtime) {
     bool ret = false;
     StorageData* storage = get_storage_by_file(file, app->storage);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length));
+        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length, mtime));
     }
 
     return ret;
@@ -523,6 +540,73 @@ void storage_process_alias(
     }
 }
 
+/****************** Batch processing ******************/
+
+static bool storage_process_batch_op(
+    Storage* app,
+    StorageBatchOp* op,
+    FuriString* path,
+    FuriThreadId thread_id) {
+    op->error = FSE_OK;
+
+    switch(op->type) {
+    case StorageBatchOpStat:
+        furi_string_set(path, op->path);
+        storage_process_alias(app, path, thread_id, false);
+        op->error = storage_process_common_stat(app, path, op->fileinfo);
+        break;
+    case StorageBatchOpFileOpen:
+        furi_string_set(path, op->path);
+        storage_process_alias(app, path, thread_id, true);
+        op->file->type = FileTypeOpenFile;
+        storage_process_file_open(app, op->file, path, op->access_mode, op->open_mode);
+        op->error = op->file->error_id;
+        break;
+    case StorageBatchOpFileRead:
+        op->bytes_read = storage_process_file_read(app, op->file, op->buff, op->size);
+        op->error = op->file->error_id;
+        break;
+    case StorageBatchOpFileSeek:
+        storage_process_file_seek(app, op->file, op->offset, op->from_start);
+        op->error = op->file->error_id;
+        break;
+    case StorageBatchOpFileClose:
+        storage_process_file_close(app, op->file);
+        op->file->type = FileTypeClosed;
+        op->error = op->file->error_id;
+        break;
+    case StorageBatchOpDirRead:
+        storage_process_dir_read(
+            app, op->file, op->fileinfo, op->buff, op->size, &op->mtime);
+        op->error = op->file->error_id;
+        break;
+    default:
+        op->error = FSE_INVALID_PARAMETER;
+        break;
+    }
+
+    return op->error == FSE_OK;
+}
+
+static size_t storage_process_batch(
+    Storage* app,
+    StorageBatchOp* ops,
+    size_t ops_count,
+    bool stop_on_error,
+    FuriThreadId thread_id) {
+    FuriString* path = furi_string_alloc();
+    size_t executed = 0;
+
+    while(executed < ops_count) {
+        bool success = storage_process_batch_op(app, &ops[executed], path, thread_id);
+        executed++;
+        if(!success && stop_on_error) break;
+    }
+
+    furi_string_free(path);
+    return executed;
+}
+
 /****************** API calls processing ******************/
 
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
@@ -606,7 +690,8 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->dread.file,
             message->data->dread.fileinfo,
             message->data->dread.name,
-            message->data->dread.name_length);
+            message->data->dread.name_length,
+            NULL);
         break;
     case StorageCommandDirRewind:
         message->return_data->bool_value =
@@ -646,6 +731,21 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         storage_process_alias(
             app, message->data->cresolvepath.path, message->data->cresolvepath.thread_id, true);
         break;
+    case StorageCommandFileReadV:
+        message->return_data->size_value = storage_process_file_read_v(
+            app,
+            message->data->freadv.file,
+            message->data->freadv.iov,
+            message->data->freadv.iov_count);
+        break;
+    case StorageCommandBatch:
+        message->return_data->size_value = storage_process_batch(
+            app,
+            message->data->batch.ops,
+            message->data->batch.ops_count,
+            message->data->batch.stop_on_error,
+            message->data->batch.thread_id);
+        break;
 
     // SD operations
     case StorageCommandSDFormat:
@@ -671,5 +771,6 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
+    app->processed_messages++;
     storage_process_message_internal(app, message);
 }
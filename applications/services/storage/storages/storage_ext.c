@@ -489,7 +489,8 @@ static bool storage_ext_dir_read(
     File* file,
     FileInfo* fileinfo,
     char* name,
-    const uint16_t name_length) {
+    const uint16_t name_length,
+    uint32_t* mtime) {
     StorageData* storage = ctx;
     SDDir* file_data = storage_get_storage_file_data(file, storage);
 
@@ -508,6 +509,10 @@ static bool storage_ext_dir_read(
         snprintf(name, name_length, "%s", _fileinfo.fname);
     }
 
+    if(mtime != NULL) {
+        *mtime = ((uint32_t)_fileinfo.fdate << 16) | _fileinfo.ftime;
+    }
+
     if(_fileinfo.fname[0] == 0) {
         file->error_id = FSE_NOT_EXIST;
     }
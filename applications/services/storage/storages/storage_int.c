@@ -589,7 +589,8 @@ static bool storage_int_dir_read(
     File* file,
     FileInfo* fileinfo,
     char* name,
-    const uint16_t name_length) {
+    const uint16_t name_length,
+    uint32_t* mtime) {
     StorageData* storage = ctx;
     lfs_t* lfs = lfs_get_from_storage(storage);
     LFSHandle* handle = storage_get_storage_file_data(file, storage);
@@ -613,6 +614,11 @@ static bool storage_int_dir_read(
             snprintf(name, name_length, "%s", _fileinfo.name);
         }
 
+        // LFS doesn't keep modification time
+        if(mtime != NULL) {
+            *mtime = 0;
+        }
+
         // set FSE_NOT_EXIST error on end of directory
         if(file->internal_error_id == 0) {
             file->error_id = FSE_NOT_EXIST;
@@ -5,6 +5,9 @@
 
 #define FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND (SystemCoreClock / 1000000)
 
+static uint32_t furi_hal_cortex_cycles_high = 0;
+static uint32_t furi_hal_cortex_cycles_last = 0;
+
 void furi_hal_cortex_init_early() {
     CoreDebug->DEMCR |= (CoreDebug_DEMCR_TRCENA_Msk | CoreDebug_DEMCR_MON_EN_Msk);
     DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
@@ -25,6 +28,22 @@ uint32_t furi_hal_cortex_instructions_per_microsecond() {
     return FURI_HAL_CORTEX_INSTRUCTIONS_PER_MICROSECOND;
 }
 
+uint64_t furi_hal_cortex_get_cycles64() {
+    // Called from PendSV and SysTick too, so plain critical section won't do
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t cycles = DWT->CYCCNT;
+    if(cycles < furi_hal_cortex_cycles_last) {
+        furi_hal_cortex_cycles_high++;
+    }
+    furi_hal_cortex_cycles_last = cycles;
+    uint64_t result = ((uint64_t)furi_hal_cortex_cycles_high << 32) | cycles;
+
+    __set_PRIMASK(primask);
+    return result;
+}
+
 FuriHalCortexTimer furi_hal_cortex_timer_get(uint32_t timeout_us) {
     FuriHalCortexTimer cortex_timer = {0};
     cortex_timer.start = DWT->CYCCNT;
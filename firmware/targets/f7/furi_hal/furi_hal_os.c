@@ -5,6 +5,7 @@
 #include <furi_hal_gpio.h>
 #include <furi_hal_resources.h>
 #include <furi_hal_idle_timer.h>
+#include <furi_hal_cortex.h>
 
 #include <stm32wbxx_ll_cortex.h>
 
@@ -53,6 +54,15 @@ extern void xPortSysTickHandler();
 
 static volatile uint32_t furi_hal_os_skew;
 
+typedef struct {
+    FuriHalOsTickSampleCallback callback;
+    void* context;
+    uint32_t period;
+    uint32_t counter;
+} FuriHalOsTickSample;
+
+static FuriHalOsTickSample furi_hal_os_tick_sample = {0};
+
 void furi_hal_os_init() {
     furi_hal_idle_timer_init();
 
@@ -76,10 +86,38 @@ void furi_hal_os_tick() {
         furi_hal_gpio_write(
             FURI_HAL_OS_DEBUG_TICK_GPIO, !furi_hal_gpio_read(FURI_HAL_OS_DEBUG_TICK_GPIO));
 #endif
+        // Keep 64-bit cycle counter from missing a wrap
+        furi_hal_cortex_get_cycles64();
+
+        if(furi_hal_os_tick_sample.callback &&
+           ++furi_hal_os_tick_sample.counter >= furi_hal_os_tick_sample.period) {
+            furi_hal_os_tick_sample.counter = 0;
+            // SysTick has the lowest priority: it can only preempt thread mode,
+            // so interrupted thread's exception frame is on top of PSP.
+            uint32_t* frame = (uint32_t*)__get_PSP();
+            furi_hal_os_tick_sample.callback(
+                frame[6], xTaskGetCurrentTaskHandle(), furi_hal_os_tick_sample.context);
+        }
+
         xPortSysTickHandler();
     }
 }
 
+void furi_hal_os_set_tick_sample_callback(
+    FuriHalOsTickSampleCallback callback,
+    uint32_t period,
+    void* context) {
+    furi_check(period);
+
+    FURI_CRITICAL_ENTER();
+    furi_check(!callback || !furi_hal_os_tick_sample.callback);
+    furi_hal_os_tick_sample.callback = callback;
+    furi_hal_os_tick_sample.context = context;
+    furi_hal_os_tick_sample.period = period;
+    furi_hal_os_tick_sample.counter = 0;
+    FURI_CRITICAL_EXIT();
+}
+
 #ifdef FURI_HAL_OS_DEBUG
 // Find out the IRQ number while debugging
 static void furi_hal_os_nvic_dbg_trap() {
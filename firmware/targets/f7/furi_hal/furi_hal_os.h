@@ -15,6 +15,30 @@ void furi_hal_os_init();
  */
 void furi_hal_os_tick();
 
+/** Tick sample callback
+ *
+ * Called from OS tick interrupt, keep it short.
+ *
+ * @param      pc         program counter of interrupted thread
+ * @param      thread_id  interrupted thread, FuriThreadId
+ * @param      context    callback context
+ */
+typedef void (*FuriHalOsTickSampleCallback)(uint32_t pc, void* thread_id, void* context);
+
+/** Set tick sample callback
+ *
+ * Callback is called every `period` OS ticks with state of interrupted thread.
+ * Only one callback can be set at a time.
+ *
+ * @param      callback  callback or NULL to disable sampling
+ * @param      period    sampling period in ticks, must be non-zero
+ * @param      context   callback context
+ */
+void furi_hal_os_set_tick_sample_callback(
+    FuriHalOsTickSampleCallback callback,
+    uint32_t period,
+    void* context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #pragma GCC diagnostic ignored "-Wredundant-decls"
 extern uint32_t SystemCoreClock;
+extern uint64_t furi_hal_cortex_get_cycles64();
 #endif
 
 #ifndef CMSIS_device_header
@@ -27,7 +28,8 @@ extern uint32_t SystemCoreClock;
 /* Heap size determined automatically by linker */
 // #define configTOTAL_HEAP_SIZE                    ((size_t)0)
 #define configMAX_TASK_NAME_LEN (16)
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
+#define configRUN_TIME_COUNTER_TYPE uint64_t
 #define configUSE_TRACE_FACILITY 1
 #define configUSE_16_BIT_TICKS 0
 #define configUSE_MUTEXES 1
@@ -78,7 +80,7 @@ to exclude the API function. */
 #define INCLUDE_xTimerPendFunctionCall 1
 
 /* Furi-specific */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
 
 extern __attribute__((__noreturn__)) void furi_thread_catch();
 #define configTASK_RETURN_ADDRESS (furi_thread_catch + 2)
@@ -132,6 +134,10 @@ standard names. */
 #define vPortSVCHandler SVC_Handler
 #define xPortPendSVHandler PendSV_Handler
 
+/* Per-thread run time in CPU cycles, DWT is enabled by furi_hal_cortex_init_early */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() furi_hal_cortex_get_cycles64()
+
 #define USE_CUSTOM_SYSTICK_HANDLER_IMPLEMENTATION 1
 #define configOVERRIDE_DEFAULT_TICK_CONFIGURATION \
     1 /* required only for Keil but does not hurt otherwise */
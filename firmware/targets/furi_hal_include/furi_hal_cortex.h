@@ -34,6 +34,18 @@ void furi_hal_cortex_delay_us(uint32_t microseconds);
  */
 uint32_t furi_hal_cortex_instructions_per_microsecond();
 
+/** Get 64-bit CPU cycle count
+ *
+ * Extends DWT cycle counter to 64 bits. Counter wraps every 67 seconds at
+ * 64MHz, so it must be read at least that often: OS tick and context switch
+ * take care of it.
+ *
+ * @warning    Counter doesn't advance while core is in STOP mode
+ *
+ * @return     CPU cycles since boot
+ */
+uint64_t furi_hal_cortex_get_cycles64();
+
 /** Get Timer
  *
  * @param[in]  timeout_us  The expire timeout in us
@@ -1,5 +1,6 @@
 #include "check.h"
 #include "common_defines.h"
+#include "log.h"
 
 #include <stm32wbxx.h>
 #include <furi_hal_console.h>
@@ -142,6 +143,9 @@ FURI_NORETURN void __furi_crash() {
         __furi_check_message = "furi_check failed";
     }
 
+    // Records logged right before the crash are the most useful ones
+    furi_log_crash_flush();
+
     furi_hal_console_puts("\r\n\033[0;31m[CRASH]");
     __furi_print_name(isr);
     furi_hal_console_puts(__furi_check_message);
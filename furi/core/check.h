@@ -33,6 +33,14 @@ FURI_NORETURN void __furi_crash();
 /** Halt system */
 FURI_NORETURN void __furi_halt();
 
+#ifdef FURI_HOST
+/** Host build: print message and abort. Message can be a flag instead of pointer. */
+FURI_NORETURN void __furi_crash_host(const char* message);
+
+#define furi_crash(message) __furi_crash_host((const char*)(uintptr_t)(message))
+
+#define furi_halt(message) __furi_crash_host((const char*)(uintptr_t)(message))
+#else
 /** Crash system with message. Show message after reboot. */
 #define furi_crash(message)                                   \
     do {                                                      \
@@ -48,6 +56,7 @@ FURI_NORETURN void __furi_halt();
         asm volatile("sukima%=:" : : "r"(r12));               \
         __furi_halt();                                        \
     } while(0)
+#endif
 
 /** Check condition and crash if check failed */
 #define __furi_check(__e, __m) \
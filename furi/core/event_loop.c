@@ -0,0 +1,459 @@
+#include "event_loop_i.h"
+#include "thread_i.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define FURI_EVENT_LOOP_ITEMS_MASK ((1UL << FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX) - 1)
+
+typedef enum {
+    FuriEventLoopItemTypeNone = 0,
+    FuriEventLoopItemTypeMessageQueue,
+    FuriEventLoopItemTypeStreamBuffer,
+    FuriEventLoopItemTypeSemaphore,
+} FuriEventLoopItemType;
+
+typedef union {
+    FuriEventLoopMessageQueueCallback message_queue;
+    FuriEventLoopStreamBufferCallback stream_buffer;
+    FuriEventLoopSemaphoreCallback semaphore;
+} FuriEventLoopItemCallback;
+
+typedef struct {
+    FuriEventLoopItemType type;
+    void* object;
+    FuriEventLoopLink* link;
+    FuriEventLoopItemCallback callback;
+    void* context;
+} FuriEventLoopItem;
+
+struct FuriEventLoopTimer {
+    FuriEventLoop* event_loop;
+    FuriEventLoopTimerCallback callback;
+    void* context;
+    FuriEventLoopTimerType type;
+    uint32_t interval;
+    uint32_t deadline;
+    bool running;
+    FuriEventLoopTimer* next;
+};
+
+struct FuriEventLoop {
+    FuriThreadId thread_id;
+    FuriThread* thread;
+
+    // Index in this array is event bit of subscription
+    FuriEventLoopItem items[FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX];
+
+    uint32_t thread_flags;
+    FuriEventLoopThreadFlagsCallback thread_flags_callback;
+    void* thread_flags_context;
+
+    // Running timers sorted by deadline, head is the next to expire
+    FuriEventLoopTimer* timers;
+    size_t timer_count;
+
+    uint32_t wakeup_count;
+};
+
+static void furi_event_loop_notify(FuriThreadId thread_id, uint32_t events) {
+    if(FURI_IS_IRQ_MODE()) {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyIndexedFromISR(
+            (TaskHandle_t)thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, events, eSetBits, &yield);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        (void)xTaskNotifyIndexed(
+            (TaskHandle_t)thread_id, FURI_EVENT_LOOP_NOTIFY_INDEX, events, eSetBits);
+    }
+}
+
+static inline void furi_event_loop_check_thread(FuriEventLoop* instance) {
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+}
+
+FuriEventLoop* furi_event_loop_alloc() {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+    furi_check(thread->event_loop == NULL);
+
+    FuriEventLoop* instance = malloc(sizeof(FuriEventLoop));
+    instance->thread_id = furi_thread_get_current_id();
+    instance->thread = thread;
+
+    // Drop events left from previous event loop of this thread
+    (void)xTaskNotifyStateClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX);
+    (void)ulTaskNotifyValueClearIndexed(NULL, FURI_EVENT_LOOP_NOTIFY_INDEX, 0xFFFFFFFFUL);
+
+    thread->event_loop = instance;
+
+    return instance;
+}
+
+void furi_event_loop_free(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_event_loop_check_thread(instance);
+
+    for(size_t i = 0; i < FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX; i++) {
+        furi_check(instance->items[i].type == FuriEventLoopItemTypeNone);
+    }
+    furi_check(instance->timer_count == 0);
+
+    instance->thread->event_loop = NULL;
+    free(instance);
+}
+
+static bool furi_event_loop_item_is_ready(FuriEventLoopItem* item) {
+    switch(item->type) {
+    case FuriEventLoopItemTypeMessageQueue:
+        return furi_message_queue_get_count(item->object) > 0;
+    case FuriEventLoopItemTypeStreamBuffer:
+        return !furi_stream_buffer_is_empty(item->object);
+    case FuriEventLoopItemTypeSemaphore:
+        return furi_semaphore_get_count(item->object) > 0;
+    default:
+        return false;
+    }
+}
+
+static void furi_event_loop_process_item(FuriEventLoop* instance, FuriEventLoopItem* item) {
+    // Event of unsubscribed item, or object was drained by somebody else
+    if(!furi_event_loop_item_is_ready(item)) return;
+
+    switch(item->type) {
+    case FuriEventLoopItemTypeMessageQueue:
+        item->callback.message_queue(item->object, item->context);
+        break;
+    case FuriEventLoopItemTypeStreamBuffer:
+        item->callback.stream_buffer(item->object, item->context);
+        break;
+    case FuriEventLoopItemTypeSemaphore:
+        item->callback.semaphore(item->object, item->context);
+        break;
+    default:
+        furi_crash(NULL);
+    }
+
+    // Level triggered: come back after other events if something is left
+    if(furi_event_loop_item_is_ready(item)) {
+        furi_event_loop_notify(instance->thread_id, item->link->event_bit);
+    }
+}
+
+static void furi_event_loop_process_thread_flags(FuriEventLoop* instance) {
+    if(!instance->thread_flags_callback) return;
+
+    uint32_t flags = furi_thread_flags_wait(instance->thread_flags, FuriFlagWaitAny, 0);
+    if(flags & FuriFlagError) return;
+
+    instance->thread_flags_callback(
+        flags & instance->thread_flags, instance->thread_flags_context);
+}
+
+static inline bool furi_event_loop_tick_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void furi_event_loop_timer_insert(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
+    FuriEventLoopTimer** position = &instance->timers;
+    // Timers with equal deadline fire in start order
+    while(*position && !furi_event_loop_tick_before(timer->deadline, (*position)->deadline)) {
+        position = &(*position)->next;
+    }
+    timer->next = *position;
+    *position = timer;
+    timer->running = true;
+}
+
+static void furi_event_loop_timer_remove(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
+    if(!timer->running) return;
+
+    FuriEventLoopTimer** position = &instance->timers;
+    while(*position != timer) {
+        furi_assert(*position);
+        position = &(*position)->next;
+    }
+    *position = timer->next;
+    timer->next = NULL;
+    timer->running = false;
+}
+
+static uint32_t furi_event_loop_get_timeout(FuriEventLoop* instance) {
+    if(!instance->timers) return FuriWaitForever;
+
+    int32_t left = (int32_t)(instance->timers->deadline - xTaskGetTickCount());
+    return left > 0 ? (uint32_t)left : 0;
+}
+
+static void furi_event_loop_process_timers(FuriEventLoop* instance) {
+    uint32_t now = xTaskGetTickCount();
+
+    while(instance->timers && !furi_event_loop_tick_before(now, instance->timers->deadline)) {
+        FuriEventLoopTimer* timer = instance->timers;
+        furi_event_loop_timer_remove(instance, timer);
+
+        if(timer->type == FuriEventLoopTimerTypePeriodic) {
+            // Counted from deadline, not from now, so period doesn't drift
+            timer->deadline += timer->interval;
+            // Missed periods are skipped instead of firing in a burst
+            if(!furi_event_loop_tick_before(now, timer->deadline)) {
+                timer->deadline = now + timer->interval;
+            }
+            furi_event_loop_timer_insert(instance, timer);
+        }
+
+        // Callback may stop, restart or free this timer
+        timer->callback(timer->context);
+    }
+}
+
+void furi_event_loop_run(FuriEventLoop* instance) {
+    furi_check(instance);
+    furi_event_loop_check_thread(instance);
+
+    while(true) {
+        uint32_t events = 0;
+        (void)xTaskNotifyWaitIndexed(
+            FURI_EVENT_LOOP_NOTIFY_INDEX,
+            0,
+            0xFFFFFFFFUL,
+            &events,
+            furi_event_loop_get_timeout(instance));
+        instance->wakeup_count++;
+
+        if(events & FURI_EVENT_LOOP_FLAG_STOP) {
+            // Keep the rest for the next run
+            events &= ~FURI_EVENT_LOOP_FLAG_STOP;
+            if(events) furi_event_loop_notify(instance->thread_id, events);
+            break;
+        }
+
+        uint32_t items = events & FURI_EVENT_LOOP_ITEMS_MASK;
+        while(items) {
+            uint32_t index = __builtin_ctz(items);
+            items &= ~(1UL << index);
+            furi_event_loop_process_item(instance, &instance->items[index]);
+        }
+
+        // After items, so draw-like flags see the result of processed messages
+        if(events & FURI_EVENT_LOOP_FLAG_THREAD_FLAGS) {
+            furi_event_loop_process_thread_flags(instance);
+        }
+
+        furi_event_loop_process_timers(instance);
+    }
+}
+
+void furi_event_loop_stop(FuriEventLoop* instance) {
+    furi_assert(instance);
+    furi_event_loop_notify(instance->thread_id, FURI_EVENT_LOOP_FLAG_STOP);
+}
+
+static void furi_event_loop_subscribe(
+    FuriEventLoop* instance,
+    FuriEventLoopItemType type,
+    void* object,
+    FuriEventLoopLink* link,
+    FuriEventLoopItemCallback callback,
+    void* context) {
+    furi_event_loop_check_thread(instance);
+
+    size_t index = FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX;
+    for(size_t i = 0; i < FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX; i++) {
+        furi_check(instance->items[i].object != object);
+        if(index == FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX &&
+           instance->items[i].type == FuriEventLoopItemTypeNone) {
+            index = i;
+        }
+    }
+    furi_check(index < FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX);
+
+    FuriEventLoopItem* item = &instance->items[index];
+    item->type = type;
+    item->object = object;
+    item->link = link;
+    item->callback = callback;
+    item->context = context;
+
+    FURI_CRITICAL_ENTER();
+    furi_check(link->event_loop == NULL);
+    link->event_bit = 1UL << index;
+    link->event_loop = instance;
+    FURI_CRITICAL_EXIT();
+
+    // Object may already have data
+    furi_event_loop_notify(instance->thread_id, link->event_bit);
+}
+
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(queue);
+    furi_check(callback);
+
+    furi_event_loop_subscribe(
+        instance,
+        FuriEventLoopItemTypeMessageQueue,
+        queue,
+        furi_message_queue_get_event_loop_link(queue),
+        (FuriEventLoopItemCallback){.message_queue = callback},
+        context);
+}
+
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(stream_buffer);
+    furi_check(callback);
+
+    furi_event_loop_subscribe(
+        instance,
+        FuriEventLoopItemTypeStreamBuffer,
+        stream_buffer,
+        furi_stream_buffer_get_event_loop_link(stream_buffer),
+        (FuriEventLoopItemCallback){.stream_buffer = callback},
+        context);
+}
+
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopSemaphoreCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(semaphore);
+    furi_check(callback);
+
+    furi_event_loop_subscribe(
+        instance,
+        FuriEventLoopItemTypeSemaphore,
+        semaphore,
+        furi_semaphore_get_event_loop_link(semaphore),
+        (FuriEventLoopItemCallback){.semaphore = callback},
+        context);
+}
+
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object) {
+    furi_check(instance);
+    furi_check(object);
+    furi_event_loop_check_thread(instance);
+
+    FuriEventLoopItem* item = NULL;
+    for(size_t i = 0; i < FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX; i++) {
+        if(instance->items[i].object == object) {
+            item = &instance->items[i];
+            break;
+        }
+    }
+    furi_check(item);
+
+    // After this no writer can reach event loop through the link
+    FURI_CRITICAL_ENTER();
+    item->link->event_loop = NULL;
+    item->link->event_bit = 0;
+    FURI_CRITICAL_EXIT();
+
+    memset(item, 0, sizeof(FuriEventLoopItem));
+}
+
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_event_loop_check_thread(instance);
+
+    instance->thread_flags = callback ? flags : 0;
+    instance->thread_flags_callback = callback;
+    instance->thread_flags_context = context;
+
+    // Flags may already be set
+    if(callback) furi_event_loop_notify(instance->thread_id, FURI_EVENT_LOOP_FLAG_THREAD_FLAGS);
+}
+
+uint32_t furi_event_loop_get_wakeup_count(FuriEventLoop* instance) {
+    furi_check(instance);
+    return instance->wakeup_count;
+}
+
+void furi_event_loop_link_notify(FuriEventLoopLink* link) {
+    // Fast path for objects without subscription
+    if(!__atomic_load_n(&link->event_loop, __ATOMIC_RELAXED)) return;
+
+    // Event loop can't be unsubscribed while we are using it
+    FURI_CRITICAL_ENTER();
+    FuriEventLoop* instance = link->event_loop;
+    if(instance) {
+        furi_event_loop_notify(instance->thread_id, link->event_bit);
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id) {
+    furi_event_loop_notify(thread_id, FURI_EVENT_LOOP_FLAG_THREAD_FLAGS);
+}
+
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context) {
+    furi_check(instance);
+    furi_check(callback);
+    furi_event_loop_check_thread(instance);
+
+    FuriEventLoopTimer* timer = malloc(sizeof(FuriEventLoopTimer));
+    timer->event_loop = instance;
+    timer->callback = callback;
+    timer->type = type;
+    timer->context = context;
+    instance->timer_count++;
+
+    return timer;
+}
+
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    FuriEventLoop* instance = timer->event_loop;
+    furi_event_loop_check_thread(instance);
+
+    furi_event_loop_timer_remove(instance, timer);
+    instance->timer_count--;
+    free(timer);
+}
+
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval) {
+    furi_check(timer);
+    furi_check(interval > 0);
+    FuriEventLoop* instance = timer->event_loop;
+    furi_event_loop_check_thread(instance);
+
+    furi_event_loop_timer_remove(instance, timer);
+    timer->interval = interval;
+    timer->deadline = xTaskGetTickCount() + interval;
+    furi_event_loop_timer_insert(instance, timer);
+}
+
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    FuriEventLoop* instance = timer->event_loop;
+    furi_event_loop_check_thread(instance);
+
+    furi_event_loop_timer_remove(instance, timer);
+}
+
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer) {
+    furi_check(timer);
+    return timer->running;
+}
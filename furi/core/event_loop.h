@@ -0,0 +1,199 @@
+/**
+ * @file event_loop.h
+ * Furi Event Loop
+ *
+ * Lets one thread wait on several message queues, stream buffers, semaphores,
+ * its own thread flags and any number of timers at once, instead of polling
+ * each of them with a timeout.
+ *
+ * Event loop is bound to the thread that allocated it: subscriptions, timers
+ * and run must be used from that thread only. Objects can be written from any
+ * thread or interrupt, writer wakes the loop through dedicated task
+ * notification index. Dispatch doesn't allocate memory.
+ *
+ * Subscriptions are level triggered: callback is called again on the next
+ * iteration if it didn't drain the object.
+ *
+ * ***NOTE***: object must be unsubscribed before it is freed.
+ */
+#pragma once
+
+#include "base.h"
+#include "message_queue.h"
+#include "stream_buffer.h"
+#include "semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum count of subscribed objects per event loop */
+#define FURI_EVENT_LOOP_SUBSCRIPTIONS_MAX (16U)
+
+typedef struct FuriEventLoop FuriEventLoop;
+
+typedef struct FuriEventLoopTimer FuriEventLoopTimer;
+
+/** Message queue has messages */
+typedef void (*FuriEventLoopMessageQueueCallback)(FuriMessageQueue* queue, void* context);
+
+/** Stream buffer has data */
+typedef void (*FuriEventLoopStreamBufferCallback)(FuriStreamBuffer* stream_buffer, void* context);
+
+/** Semaphore can be acquired */
+typedef void (*FuriEventLoopSemaphoreCallback)(FuriSemaphore* semaphore, void* context);
+
+/** Subscribed thread flags were set, flags are already cleared */
+typedef void (*FuriEventLoopThreadFlagsCallback)(uint32_t flags, void* context);
+
+typedef void (*FuriEventLoopTimerCallback)(void* context);
+
+typedef enum {
+    FuriEventLoopTimerTypeOnce = 0, ///< One-shot timer
+    FuriEventLoopTimerTypePeriodic = 1, ///< Repeating timer, period doesn't drift
+} FuriEventLoopTimerType;
+
+/** Allocate event loop bound to current thread
+ *
+ * Thread can own only one event loop.
+ *
+ * @return     FuriEventLoop instance
+ */
+FuriEventLoop* furi_event_loop_alloc();
+
+/** Free event loop, everything must be unsubscribed and timers freed
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_free(FuriEventLoop* instance);
+
+/** Dispatch events until furi_event_loop_stop is called
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_run(FuriEventLoop* instance);
+
+/** Make furi_event_loop_run return, safe from any context
+ *
+ * Events that are already pending are dispatched on the next run.
+ *
+ * @param      instance  FuriEventLoop instance
+ */
+void furi_event_loop_stop(FuriEventLoop* instance);
+
+/** Subscribe to message queue
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      queue     FuriMessageQueue instance, one event loop at a time
+ * @param      callback  called while queue is not empty
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_message_queue(
+    FuriEventLoop* instance,
+    FuriMessageQueue* queue,
+    FuriEventLoopMessageQueueCallback callback,
+    void* context);
+
+/** Subscribe to stream buffer
+ *
+ * @param      instance       FuriEventLoop instance
+ * @param      stream_buffer  FuriStreamBuffer instance, one event loop at a time
+ * @param      callback       called while stream buffer is not empty
+ * @param      context        callback context
+ */
+void furi_event_loop_subscribe_stream_buffer(
+    FuriEventLoop* instance,
+    FuriStreamBuffer* stream_buffer,
+    FuriEventLoopStreamBufferCallback callback,
+    void* context);
+
+/** Subscribe to semaphore
+ *
+ * @param      instance   FuriEventLoop instance
+ * @param      semaphore  FuriSemaphore instance, one event loop at a time
+ * @param      callback   called while semaphore count is not zero
+ * @param      context    callback context
+ */
+void furi_event_loop_subscribe_semaphore(
+    FuriEventLoop* instance,
+    FuriSemaphore* semaphore,
+    FuriEventLoopSemaphoreCallback callback,
+    void* context);
+
+/** Unsubscribe from message queue, stream buffer or semaphore
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      object    subscribed object
+ */
+void furi_event_loop_unsubscribe(FuriEventLoop* instance, void* object);
+
+/** Subscribe to thread flags of event loop thread
+ *
+ * Subscribed flags are cleared by the loop before callback is called.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      flags     flags mask
+ * @param      callback  called with set flags, NULL to unsubscribe
+ * @param      context   callback context
+ */
+void furi_event_loop_subscribe_thread_flags(
+    FuriEventLoop* instance,
+    uint32_t flags,
+    FuriEventLoopThreadFlagsCallback callback,
+    void* context);
+
+/** Get count of times event loop thread was woken up
+ *
+ * @param      instance  FuriEventLoop instance
+ *
+ * @return     wakeup count
+ */
+uint32_t furi_event_loop_get_wakeup_count(FuriEventLoop* instance);
+
+/** Allocate event loop timer
+ *
+ * Timer callback runs in event loop thread, not in timer service.
+ *
+ * @param      instance  FuriEventLoop instance
+ * @param      callback  timer callback
+ * @param      type      timer type
+ * @param      context   callback context
+ *
+ * @return     FuriEventLoopTimer instance
+ */
+FuriEventLoopTimer* furi_event_loop_timer_alloc(
+    FuriEventLoop* instance,
+    FuriEventLoopTimerCallback callback,
+    FuriEventLoopTimerType type,
+    void* context);
+
+/** Free event loop timer, stops it if running
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_free(FuriEventLoopTimer* timer);
+
+/** Start or restart timer
+ *
+ * @param      timer     FuriEventLoopTimer instance
+ * @param      interval  interval in ticks, not 0
+ */
+void furi_event_loop_timer_start(FuriEventLoopTimer* timer, uint32_t interval);
+
+/** Stop timer
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ */
+void furi_event_loop_timer_stop(FuriEventLoopTimer* timer);
+
+/** Is timer running
+ *
+ * @param      timer  FuriEventLoopTimer instance
+ *
+ * @return     true if running
+ */
+bool furi_event_loop_timer_is_running(FuriEventLoopTimer* timer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "event_loop.h"
+#include "thread.h"
+
+/* Index 0 is used for stream buffers, 1 for thread flags */
+#define FURI_EVENT_LOOP_NOTIFY_INDEX (2U)
+
+/* Notification bits: one per subscription, the rest are loop events */
+#define FURI_EVENT_LOOP_FLAG_THREAD_FLAGS (1UL << 30)
+#define FURI_EVENT_LOOP_FLAG_STOP (1UL << 31)
+
+/** Object side of subscription, embedded in every primitive that can be subscribed */
+typedef struct {
+    FuriEventLoop* event_loop;
+    uint32_t event_bit;
+} FuriEventLoopLink;
+
+/** Wake event loop subscribed to object, if any. Safe from any context.
+ *
+ * @param      link  object link
+ */
+void furi_event_loop_link_notify(FuriEventLoopLink* link);
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance);
+
+FuriEventLoopLink* furi_stream_buffer_get_event_loop_link(FuriStreamBuffer* stream_buffer);
+
+FuriEventLoopLink* furi_semaphore_get_event_loop_link(FuriSemaphore* instance);
+
+/** Wake event loop of thread after its thread flags were set. Safe from any context.
+ *
+ * @param      thread_id  event loop thread
+ */
+void furi_event_loop_thread_flags_notify(FuriThreadId thread_id);
@@ -1,15 +1,84 @@
 #include "log.h"
+#include "log_ring.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
+#include <string.h>
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+#define FURI_LOG_RING_SIZE (4096)
+/** Packed arguments of single deferred record, longer ones are printed right away */
+#define FURI_LOG_ARGS_SIZE_MAX (96)
+/** Longest %s argument copied to deferred record */
+#define FURI_LOG_STRING_SIZE_MAX (32)
+#define FURI_LOG_SPEC_SIZE_MAX (16)
+#define FURI_LOG_DRAIN_STACK_SIZE (2048)
+/** Drain period, catches records committed out of order without notification */
+#define FURI_LOG_DRAIN_PERIOD_MS (100)
+/** Printed records kept for furi_log_dump */
+#define FURI_LOG_HISTORY_SIZE (2048)
+/** Output chunk of formatter, single conversion longer than that is truncated */
+#define FURI_LOG_OUTPUT_CHUNK_SIZE (64)
+
+#define FURI_LOG_DUMP_MAGIC (0x474F4C46) /* "FLOG" */
+#define FURI_LOG_DUMP_VERSION (1)
+
+typedef enum {
+    FuriLogDrainFlagData = (1 << 0),
+    FuriLogDrainFlagStop = (1 << 1),
+} FuriLogDrainFlag;
+
+#define FuriLogDrainFlagAll (FuriLogDrainFlagData | FuriLogDrainFlagStop)
+
+typedef enum {
+    FuriLogArgNone,
+    FuriLogArgInt,
+    FuriLogArgLong,
+    FuriLogArgLongLong,
+    FuriLogArgSize,
+    FuriLogArgDouble,
+    FuriLogArgPointer,
+    FuriLogArgString,
+    FuriLogArgInvalid,
+} FuriLogArg;
+
+/** Deferred record, followed by packed arguments */
+typedef struct {
+    uint32_t timestamp;
+    const char* tag;
+    const char* format;
+    uint8_t level;
+    uint8_t reserved;
+    uint16_t args_size;
+} FuriLogRecord;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_header_size;
+    uint32_t dropped;
+} FuriLogDumpHeader;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPuts puts;
     FuriLogTimestamp timestamp;
     FuriMutex* mutex;
+
+    /* Deferred mode, ring is never freed as producers don't lock */
+    volatile bool deferred;
+    FuriLogRing* ring;
+    FuriMutex* consumer_mutex;
+    FuriThread* drain_thread;
+    volatile FuriThreadId drain_thread_id;
+    uint32_t dropped_reported;
+
+    /* Printed records as size prefixed copies, oldest are evicted */
+    uint8_t* history;
+    size_t history_start;
+    size_t history_used;
 } FuriLogParams;
 
 static FuriLogParams furi_log;
@@ -37,47 +106,409 @@ void furi_log_init() {
     furi_log.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
 }
 
-void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
-    if(level <= furi_log.log_level &&
-       furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
-        FuriString* string;
-        string = furi_string_alloc();
+static const char* furi_log_get_color(FuriLogLevel level, const char** log_letter) {
+    const char* color = _FURI_LOG_CLR_RESET;
+    *log_letter = " ";
+    switch(level) {
+    case FuriLogLevelError:
+        color = _FURI_LOG_CLR_E;
+        *log_letter = "E";
+        break;
+    case FuriLogLevelWarn:
+        color = _FURI_LOG_CLR_W;
+        *log_letter = "W";
+        break;
+    case FuriLogLevelInfo:
+        color = _FURI_LOG_CLR_I;
+        *log_letter = "I";
+        break;
+    case FuriLogLevelDebug:
+        color = _FURI_LOG_CLR_D;
+        *log_letter = "D";
+        break;
+    case FuriLogLevelTrace:
+        color = _FURI_LOG_CLR_T;
+        *log_letter = "T";
+        break;
+    default:
+        break;
+    }
+    return color;
+}
 
-        const char* color = _FURI_LOG_CLR_RESET;
-        const char* log_letter = " ";
-        switch(level) {
-        case FuriLogLevelError:
-            color = _FURI_LOG_CLR_E;
-            log_letter = "E";
+static void furi_log_print_prefix(
+    FuriString* string,
+    uint32_t timestamp,
+    FuriLogLevel level,
+    const char* tag) {
+    const char* log_letter;
+    const char* color = furi_log_get_color(level, &log_letter);
+    furi_string_printf(
+        string, "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET, timestamp, color, log_letter, tag);
+}
+
+/** Parse conversion specification
+ *
+ * @param      spec  pointer to '%'
+ * @param      arg   argument type
+ *
+ * @return     specification length
+ */
+static size_t furi_log_parse_spec(const char* spec, FuriLogArg* arg) {
+    const char* p = spec + 1;
+    *arg = FuriLogArgInvalid;
+
+    if(*p == '%') {
+        *arg = FuriLogArgNone;
+        return 2;
+    }
+
+    // Flags, width and precision, '*' needs extra argument and is not supported
+    while(*p && strchr("-+ #0123456789.", *p)) p++;
+
+    FuriLogArg integer = FuriLogArgInt;
+    if(p[0] == 'l' && p[1] == 'l') {
+        integer = FuriLogArgLongLong;
+        p += 2;
+    } else if(p[0] == 'l') {
+        integer = FuriLogArgLong;
+        p++;
+    } else if(p[0] == 'z' || p[0] == 't') {
+        integer = FuriLogArgSize;
+        p++;
+    } else {
+        while(*p == 'h') p++;
+    }
+
+    switch(*p) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'c':
+        *arg = integer;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        *arg = FuriLogArgDouble;
+        break;
+    case 'p':
+        *arg = FuriLogArgPointer;
+        break;
+    case 's':
+        *arg = FuriLogArgString;
+        break;
+    default:
+        return 0;
+    }
+
+    size_t size = p - spec + 1;
+    if(size >= FURI_LOG_SPEC_SIZE_MAX) {
+        *arg = FuriLogArgInvalid;
+        return 0;
+    }
+    return size;
+}
+
+#define FURI_LOG_PACK(type)                                             \
+    do {                                                                \
+        type value = va_arg(args, type);                                \
+        if(*size + sizeof(type) > FURI_LOG_ARGS_SIZE_MAX) return false; \
+        memcpy(&out[*size], &value, sizeof(type));                      \
+        *size += sizeof(type);                                          \
+    } while(0)
+
+/** Pack arguments of format into buffer
+ *
+ * @return     false if format can't be deferred
+ */
+static bool furi_log_pack_args(const char* format, va_list args, uint8_t* out, size_t* size) {
+    FuriLogArg arg;
+    *size = 0;
+
+    for(const char* p = strchr(format, '%'); p; p = strchr(p, '%')) {
+        size_t spec_size = furi_log_parse_spec(p, &arg);
+        if(!spec_size) return false;
+        p += spec_size;
+
+        switch(arg) {
+        case FuriLogArgInt:
+            FURI_LOG_PACK(int);
+            break;
+        case FuriLogArgLong:
+            FURI_LOG_PACK(long);
             break;
-        case FuriLogLevelWarn:
-            color = _FURI_LOG_CLR_W;
-            log_letter = "W";
+        case FuriLogArgLongLong:
+            FURI_LOG_PACK(long long);
             break;
-        case FuriLogLevelInfo:
-            color = _FURI_LOG_CLR_I;
-            log_letter = "I";
+        case FuriLogArgSize:
+            FURI_LOG_PACK(size_t);
             break;
-        case FuriLogLevelDebug:
-            color = _FURI_LOG_CLR_D;
-            log_letter = "D";
+        case FuriLogArgDouble:
+            FURI_LOG_PACK(double);
             break;
-        case FuriLogLevelTrace:
-            color = _FURI_LOG_CLR_T;
-            log_letter = "T";
+        case FuriLogArgPointer:
+            FURI_LOG_PACK(void*);
             break;
+        case FuriLogArgString: {
+            // Strings may be on caller's stack, so copy them
+            const char* value = va_arg(args, const char*);
+            if(!value) value = "(null)";
+            size_t length = strnlen(value, FURI_LOG_STRING_SIZE_MAX + 1);
+            // Never cut strings, print record with long one right away
+            if(length > FURI_LOG_STRING_SIZE_MAX) return false;
+            if(*size + length + 1 > FURI_LOG_ARGS_SIZE_MAX) return false;
+            memcpy(&out[*size], value, length);
+            *size += length;
+            out[(*size)++] = '\0';
+            break;
+        }
         default:
             break;
         }
+    }
 
-        // Timestamp
+    return true;
+}
+
+typedef void (*FuriLogOutput)(const char* data, void* context);
+
+#define FURI_LOG_UNPACK(type)                            \
+    do {                                                 \
+        type value;                                      \
+        memcpy(&value, &args[offset], sizeof(type));     \
+        offset += sizeof(type);                          \
+        snprintf(chunk, sizeof(chunk), spec, value);     \
+    } while(0)
+
+/** Format deferred record with prefix and line end
+ *
+ * Output goes in chunks through stack buffer, no memory is allocated, so it
+ * is safe to use from crash handler.
+ */
+static void
+    furi_log_format_record(const FuriLogRecord* record, FuriLogOutput output, void* context) {
+    const uint8_t* args = (const uint8_t*)(record + 1);
+    size_t offset = 0;
+    char chunk[FURI_LOG_OUTPUT_CHUNK_SIZE];
+    char spec[FURI_LOG_SPEC_SIZE_MAX];
+    FuriLogArg arg;
+
+    const char* log_letter;
+    const char* color = furi_log_get_color(record->level, &log_letter);
+    snprintf(chunk, sizeof(chunk), "%lu %s[%s][", record->timestamp, color, log_letter);
+    output(chunk, context);
+    output(record->tag, context);
+    output("] " _FURI_LOG_CLR_RESET, context);
+
+    size_t length = 0;
+    for(const char* p = record->format; *p;) {
+        if(*p != '%') {
+            chunk[length++] = *p++;
+            if(length == sizeof(chunk) - 1) {
+                chunk[length] = '\0';
+                output(chunk, context);
+                length = 0;
+            }
+            continue;
+        }
+
+        if(length) {
+            chunk[length] = '\0';
+            output(chunk, context);
+            length = 0;
+        }
+
+        size_t spec_size = furi_log_parse_spec(p, &arg);
+        furi_check(spec_size);
+        memcpy(spec, p, spec_size);
+        spec[spec_size] = '\0';
+        p += spec_size;
+
+        chunk[0] = '\0';
+        switch(arg) {
+        case FuriLogArgNone:
+            strcpy(chunk, "%");
+            break;
+        case FuriLogArgInt:
+            FURI_LOG_UNPACK(int);
+            break;
+        case FuriLogArgLong:
+            FURI_LOG_UNPACK(long);
+            break;
+        case FuriLogArgLongLong:
+            FURI_LOG_UNPACK(long long);
+            break;
+        case FuriLogArgSize:
+            FURI_LOG_UNPACK(size_t);
+            break;
+        case FuriLogArgDouble:
+            FURI_LOG_UNPACK(double);
+            break;
+        case FuriLogArgPointer:
+            FURI_LOG_UNPACK(void*);
+            break;
+        case FuriLogArgString: {
+            const char* value = (const char*)&args[offset];
+            offset += strlen(value) + 1;
+            snprintf(chunk, sizeof(chunk), spec, value);
+            break;
+        }
+        default:
+            break;
+        }
+        output(chunk, context);
+    }
+
+    chunk[length] = '\0';
+    output(chunk, context);
+    output("\r\n", context);
+}
+
+static void furi_log_output_string(const char* data, void* context) {
+    furi_string_cat_str(context, data);
+}
+
+static void furi_log_output_console(const char* data, void* context) {
+    UNUSED(context);
+    furi_hal_console_puts(data);
+}
+
+static void furi_log_history_copy(size_t position, uint8_t* data, size_t size, bool write) {
+    position %= FURI_LOG_HISTORY_SIZE;
+    size_t part = MIN(size, FURI_LOG_HISTORY_SIZE - position);
+    if(write) {
+        memcpy(&furi_log.history[position], data, part);
+        memcpy(furi_log.history, data + part, size - part);
+    } else {
+        memcpy(data, &furi_log.history[position], part);
+        memcpy(data + part, furi_log.history, size - part);
+    }
+}
+
+/** Keep copy of printed record for furi_log_dump, consumer only */
+static void furi_log_history_push(const FuriLogRecord* record) {
+    uint16_t size = sizeof(FuriLogRecord) + record->args_size;
+    while(furi_log.history_used + sizeof(size) + size > FURI_LOG_HISTORY_SIZE) {
+        uint16_t oldest;
+        furi_log_history_copy(furi_log.history_start, (uint8_t*)&oldest, sizeof(oldest), false);
+        furi_log.history_start =
+            (furi_log.history_start + sizeof(oldest) + oldest) % FURI_LOG_HISTORY_SIZE;
+        furi_log.history_used -= sizeof(oldest) + oldest;
+    }
+
+    size_t position = furi_log.history_start + furi_log.history_used;
+    furi_log_history_copy(position, (uint8_t*)&size, sizeof(size), true);
+    furi_log_history_copy(position + sizeof(size), (uint8_t*)record, size, true);
+    furi_log.history_used += sizeof(size) + size;
+}
+
+static bool furi_log_is_const(const char* str) {
+    // Only firmware strings outlive the call: application may be unloaded before drain
+    return ((size_t)str >= furi_hal_flash_get_base()) &&
+           ((const void*)str < furi_hal_flash_get_free_start_address());
+}
+
+static bool furi_log_push(FuriLogLevel level, const char* tag, const char* format, va_list args) {
+    if(!furi_log_is_const(tag) || !furi_log_is_const(format)) return false;
+
+    uint8_t packed[FURI_LOG_ARGS_SIZE_MAX];
+    size_t args_size = 0;
+    if(!furi_log_pack_args(format, args, packed, &args_size)) return false;
+
+    bool was_empty = false;
+    FuriLogRecord* record = furi_log_ring_reserve(
+        furi_log.ring, sizeof(FuriLogRecord) + args_size, &was_empty);
+    // Dropped records are counted by ring and reported by drain thread
+    if(!record) return true;
+
+    record->timestamp = furi_log.timestamp();
+    record->tag = tag;
+    record->format = format;
+    record->level = level;
+    record->args_size = args_size;
+    memcpy(record + 1, packed, args_size);
+    furi_log_ring_commit(furi_log.ring, record);
+
+    FuriThreadId drain_thread_id = furi_log.drain_thread_id;
+    if(was_empty && drain_thread_id) {
+        furi_thread_flags_set(drain_thread_id, FuriLogDrainFlagData);
+    }
+
+    return true;
+}
+
+static void furi_log_drain(FuriString* string) {
+    furi_check(furi_mutex_acquire(furi_log.consumer_mutex, FuriWaitForever) == FuriStatusOk);
+
+    const FuriLogRecord* record;
+    size_t size;
+    while((record = furi_log_ring_peek(furi_log.ring, &size))) {
+        furi_string_reset(string);
+        furi_log_format_record(record, furi_log_output_string, string);
+        furi_log_history_push(record);
+        furi_log_ring_release(furi_log.ring);
+
+        furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+        furi_log.puts(furi_string_get_cstr(string));
+        furi_mutex_release(furi_log.mutex);
+    }
+
+    uint32_t dropped = furi_log_ring_get_dropped(furi_log.ring);
+    if(dropped != furi_log.dropped_reported) {
         furi_string_printf(
             string,
-            "%lu %s[%s][%s] " _FURI_LOG_CLR_RESET,
+            "%lu " _FURI_LOG_CLR_W "[W][Log] " _FURI_LOG_CLR_RESET "%lu messages dropped\r\n",
             furi_log.timestamp(),
-            color,
-            log_letter,
-            tag);
+            dropped - furi_log.dropped_reported);
+        furi_log.dropped_reported = dropped;
+
+        furi_check(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk);
+        furi_log.puts(furi_string_get_cstr(string));
+        furi_mutex_release(furi_log.mutex);
+    }
+
+    furi_mutex_release(furi_log.consumer_mutex);
+}
+
+static int32_t furi_log_drain_thread(void* context) {
+    UNUSED(context);
+    FuriString* string = furi_string_alloc();
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            FuriLogDrainFlagAll, FuriFlagWaitAny, FURI_LOG_DRAIN_PERIOD_MS);
+        furi_log_drain(string);
+        if(!(flags & FuriFlagError) && (flags & FuriLogDrainFlagStop)) break;
+    }
+
+    furi_string_free(string);
+    return 0;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > furi_log.log_level) return;
+
+    if(furi_log.deferred) {
+        va_list args;
+        va_start(args, format);
+        bool pushed = furi_log_push(level, tag, format, args);
+        va_end(args);
+        if(pushed) return;
+    }
+
+    if(furi_mutex_acquire(furi_log.mutex, FuriWaitForever) == FuriStatusOk) {
+        FuriString* string;
+        string = furi_string_alloc();
+
+        // Timestamp
+        furi_log_print_prefix(string, furi_log.timestamp(), level, tag);
         furi_log.puts(furi_string_get_cstr(string));
         furi_string_reset(string);
 
@@ -133,6 +564,88 @@ void furi_log_set_timestamp(FuriLogTimestamp timestamp) {
     furi_log.timestamp = timestamp;
 }
 
+void furi_log_set_deferred(bool deferred) {
+    if(deferred == furi_log.deferred) return;
+
+    if(deferred) {
+        if(!furi_log.ring) {
+            furi_log.ring = furi_log_ring_alloc(FURI_LOG_RING_SIZE);
+            furi_log.consumer_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+            furi_log.history = malloc(FURI_LOG_HISTORY_SIZE);
+        }
+        furi_log.drain_thread = furi_thread_alloc_ex(
+            "LogDrain", FURI_LOG_DRAIN_STACK_SIZE, furi_log_drain_thread, NULL);
+        furi_thread_set_priority(furi_log.drain_thread, FuriThreadPriorityLowest);
+        furi_thread_start(furi_log.drain_thread);
+        furi_log.drain_thread_id = furi_thread_get_id(furi_log.drain_thread);
+        furi_log.deferred = true;
+    } else {
+        furi_log.deferred = false;
+        furi_log.drain_thread_id = NULL;
+        // Drain thread flushes the ring before exit
+        furi_thread_flags_set(furi_thread_get_id(furi_log.drain_thread), FuriLogDrainFlagStop);
+        furi_thread_join(furi_log.drain_thread);
+        furi_thread_free(furi_log.drain_thread);
+        furi_log.drain_thread = NULL;
+    }
+}
+
+bool furi_log_is_deferred(void) {
+    return furi_log.deferred;
+}
+
+uint32_t furi_log_get_dropped(void) {
+    return furi_log.ring ? furi_log_ring_get_dropped(furi_log.ring) : 0;
+}
+
+size_t furi_log_dump(FuriLogDumpCallback callback, void* context) {
+    furi_assert(callback);
+    if(!furi_log.ring) return 0;
+
+    // Pending records are printed first, so dump ends with the latest one
+    FuriString* string = furi_string_alloc();
+    furi_log_drain(string);
+    furi_string_free(string);
+
+    furi_check(furi_mutex_acquire(furi_log.consumer_mutex, FuriWaitForever) == FuriStatusOk);
+
+    FuriLogDumpHeader header = {
+        .magic = FURI_LOG_DUMP_MAGIC,
+        .version = FURI_LOG_DUMP_VERSION,
+        .record_header_size = sizeof(FuriLogRecord),
+        .dropped = furi_log_ring_get_dropped(furi_log.ring),
+    };
+    callback((const uint8_t*)&header, sizeof(header), context);
+
+    size_t count = 0;
+    uint8_t record[sizeof(FuriLogRecord) + FURI_LOG_ARGS_SIZE_MAX];
+    for(size_t offset = 0; offset < furi_log.history_used;) {
+        size_t position = furi_log.history_start + offset;
+        uint16_t size;
+        furi_log_history_copy(position, (uint8_t*)&size, sizeof(size), false);
+        furi_log_history_copy(position + sizeof(size), record, size, false);
+        callback(record, size, context);
+        offset += sizeof(size) + size;
+        count++;
+    }
+
+    furi_mutex_release(furi_log.consumer_mutex);
+    return count;
+}
+
+void furi_log_crash_flush(void) {
+    // Scheduler is stopped: consumer mutex can't be taken, record being printed by
+    // drain thread may be printed once more
+    if(!furi_log.ring) return;
+
+    const FuriLogRecord* record;
+    size_t size;
+    while((record = furi_log_ring_peek(furi_log.ring, &size))) {
+        furi_log_format_record(record, furi_log_output_console, NULL);
+        furi_log_ring_release(furi_log.ring);
+    }
+}
+
 bool furi_log_level_to_string(FuriLogLevel level, const char** str) {
     for(size_t i = 0; i < COUNT_OF(FURI_LOG_LEVEL_DESCRIPTIONS); i++) {
         if(level == FURI_LOG_LEVEL_DESCRIPTIONS[i].level) {
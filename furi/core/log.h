@@ -41,6 +41,7 @@ typedef enum {
 
 typedef void (*FuriLogPuts)(const char* data);
 typedef uint32_t (*FuriLogTimestamp)(void);
+typedef void (*FuriLogDumpCallback)(const uint8_t* data, size_t size, void* context);
 
 /** Initialize logging */
 void furi_log_init();
@@ -88,6 +89,56 @@ void furi_log_set_puts(FuriLogPuts puts);
  */
 void furi_log_set_timestamp(FuriLogTimestamp timestamp);
 
+/** Enable or disable deferred logging
+ *
+ * In deferred mode log records with firmware tag and format are pushed to
+ * lock-free ring together with packed arguments, and formatted by low
+ * priority drain thread. Caller doesn't wait for output. Records with other
+ * tag or format, unsupported conversions ('*', '%n') or too many arguments
+ * are printed right away, as well as records with %s arguments longer than
+ * 32 characters. When ring is full records are dropped and counted. Records
+ * not printed yet are flushed to console on crash.
+ *
+ * @param[in]  deferred  true to enable
+ */
+void furi_log_set_deferred(bool deferred);
+
+/** Get deferred logging state
+ *
+ * @return     true if enabled
+ */
+bool furi_log_is_deferred(void);
+
+/** Get count of records dropped in deferred mode
+ *
+ * @return     dropped records count
+ */
+uint32_t furi_log_get_dropped(void);
+
+/** Take recent deferred records in binary form
+ *
+ * Pending records are printed first. Then the last printed records that fit
+ * in 2KiB history are passed to callback, oldest first.
+ *
+ * Output is header {uint32 magic "FLOG", uint16 version,
+ * uint16 record header size, uint32 dropped}, then records: {uint32
+ * timestamp, tag address, format address, uint8 level, uint8 reserved,
+ * uint16 arguments size} followed by arguments in format order, strings
+ * are NUL terminated. Addresses are resolved with firmware ELF.
+ *
+ * @param[in]  callback  output callback, called for header and every record
+ * @param      context   callback context
+ *
+ * @return     records count
+ */
+size_t furi_log_dump(FuriLogDumpCallback callback, void* context);
+
+/** Print pending deferred records to console from crash handler
+ *
+ * Doesn't lock and doesn't allocate memory.
+ */
+void furi_log_crash_flush(void);
+
 /** Log level to string
  *
  * @param[in]  level  The level
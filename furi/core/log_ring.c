@@ -0,0 +1,137 @@
+#include "log_ring.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Every record starts with header word: size including header and flags */
+#define FURI_LOG_RING_COMMITTED (1UL << 31)
+#define FURI_LOG_RING_PADDING (1UL << 30)
+#define FURI_LOG_RING_SIZE_MASK (0xFFFFUL)
+#define FURI_LOG_RING_HEADER_SIZE (sizeof(uint32_t))
+#define FURI_LOG_RING_SIZE_MAX (0x10000UL)
+
+struct FuriLogRing {
+    uint8_t* buffer;
+    uint32_t size;
+    /* Free running positions, wrapped with mask on access */
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+};
+
+static inline uint32_t* furi_log_ring_header(FuriLogRing* ring, uint32_t position) {
+    return (uint32_t*)&ring->buffer[position & (ring->size - 1)];
+}
+
+FuriLogRing* furi_log_ring_alloc(size_t size) {
+    furi_check(size >= 2 * FURI_LOG_RING_HEADER_SIZE);
+    furi_check(size <= FURI_LOG_RING_SIZE_MAX);
+    furi_check((size & (size - 1)) == 0);
+
+    FuriLogRing* ring = malloc(sizeof(FuriLogRing));
+    /* Consumer keeps free space zeroed, so stale data never looks committed */
+    ring->buffer = malloc(size);
+    memset(ring->buffer, 0, size);
+    ring->size = size;
+    return ring;
+}
+
+void furi_log_ring_free(FuriLogRing* ring) {
+    furi_assert(ring);
+    free(ring->buffer);
+    free(ring);
+}
+
+void* furi_log_ring_reserve(FuriLogRing* ring, size_t size, bool* was_empty) {
+    furi_assert(ring);
+
+    uint32_t record_size = (size + FURI_LOG_RING_HEADER_SIZE + 3) & ~3UL;
+    if(record_size > ring->size / 2) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail, padding;
+    do {
+        tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        uint32_t offset = head & (ring->size - 1);
+        /* Records are contiguous, skip the end of buffer if record doesn't fit */
+        padding = (offset + record_size > ring->size) ? ring->size - offset : 0;
+        if(head + padding + record_size - tail > ring->size) {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &ring->head,
+        &head,
+        head + padding + record_size,
+        true,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_RELAXED));
+
+    if(was_empty) *was_empty = (head == tail);
+
+    if(padding) {
+        __atomic_store_n(
+            furi_log_ring_header(ring, head),
+            padding | FURI_LOG_RING_PADDING | FURI_LOG_RING_COMMITTED,
+            __ATOMIC_RELEASE);
+        head += padding;
+    }
+
+    uint32_t* header = furi_log_ring_header(ring, head);
+    __atomic_store_n(header, record_size, __ATOMIC_RELAXED);
+    return header + 1;
+}
+
+void furi_log_ring_commit(FuriLogRing* ring, void* data) {
+    furi_assert(ring);
+    furi_assert(data);
+    UNUSED(ring);
+
+    uint32_t* header = (uint32_t*)data - 1;
+    __atomic_store_n(header, *header | FURI_LOG_RING_COMMITTED, __ATOMIC_RELEASE);
+}
+
+const void* furi_log_ring_peek(FuriLogRing* ring, size_t* size) {
+    furi_assert(ring);
+    furi_assert(size);
+
+    while(true) {
+        uint32_t tail = ring->tail;
+        if(tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)) return NULL;
+
+        uint32_t* header = furi_log_ring_header(ring, tail);
+        uint32_t value = __atomic_load_n(header, __ATOMIC_ACQUIRE);
+        /* Reserved, but producer is still writing it */
+        if(!(value & FURI_LOG_RING_COMMITTED)) return NULL;
+
+        if(value & FURI_LOG_RING_PADDING) {
+            furi_log_ring_release(ring);
+            continue;
+        }
+
+        *size = (value & FURI_LOG_RING_SIZE_MASK) - FURI_LOG_RING_HEADER_SIZE;
+        return header + 1;
+    }
+}
+
+void furi_log_ring_release(FuriLogRing* ring) {
+    furi_assert(ring);
+
+    uint32_t tail = ring->tail;
+    uint32_t* header = furi_log_ring_header(ring, tail);
+    uint32_t record_size = *header & FURI_LOG_RING_SIZE_MASK;
+    furi_assert(*header & FURI_LOG_RING_COMMITTED);
+
+    memset(header, 0, record_size);
+    __atomic_store_n(&ring->tail, tail + record_size, __ATOMIC_RELEASE);
+}
+
+uint32_t furi_log_ring_get_dropped(FuriLogRing* ring) {
+    furi_assert(ring);
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file log_ring.h
+ * Furi lock-free log ring
+ *
+ * Multiple producers, single consumer ring of variable size records.
+ * Producers reserve space with compare-and-swap on the head, so they can
+ * be threads or interrupts and never block. Records become visible to the
+ * consumer in reservation order once committed. If there is no space,
+ * record is dropped and counted.
+ *
+ * ***NOTE***: only one consumer may call peek/release at a time.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriLogRing FuriLogRing;
+
+/** Allocate ring
+ *
+ * @param      size  ring size in bytes, power of two, 64KiB max
+ *
+ * @return     FuriLogRing instance
+ */
+FuriLogRing* furi_log_ring_alloc(size_t size);
+
+/** Free ring, there must be no producers
+ *
+ * @param      ring  FuriLogRing instance
+ */
+void furi_log_ring_free(FuriLogRing* ring);
+
+/** Reserve space for record, safe from any context
+ *
+ * @param      ring       FuriLogRing instance
+ * @param      size       record size
+ * @param      was_empty  set to true if ring had nothing for consumer, may be NULL
+ *
+ * @return     pointer to record data, NULL if record is dropped
+ */
+void* furi_log_ring_reserve(FuriLogRing* ring, size_t size, bool* was_empty);
+
+/** Commit reserved record, makes it visible to consumer
+ *
+ * @param      ring  FuriLogRing instance
+ * @param      data  pointer returned by furi_log_ring_reserve
+ */
+void furi_log_ring_commit(FuriLogRing* ring, void* data);
+
+/** Get oldest committed record
+ *
+ * @param      ring  FuriLogRing instance
+ * @param      size  record size, may be bigger than reserved due to alignment
+ *
+ * @return     pointer to record data, NULL if there is no committed record
+ */
+const void* furi_log_ring_peek(FuriLogRing* ring, size_t* size);
+
+/** Release record returned by furi_log_ring_peek
+ *
+ * @param      ring  FuriLogRing instance
+ */
+void furi_log_ring_release(FuriLogRing* ring);
+
+/** Get count of records dropped since allocation
+ *
+ * @param      ring  FuriLogRing instance
+ *
+ * @return     dropped records count
+ */
+uint32_t furi_log_ring_get_dropped(FuriLogRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
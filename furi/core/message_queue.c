@@ -3,26 +3,39 @@
 #include <FreeRTOS.h>
 #include <queue.h>
 #include "check.h"
+#include "memmgr.h"
+#include "event_loop_i.h"
+
+struct FuriMessageQueue {
+    QueueHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+};
+
+#define FURI_MESSAGE_QUEUE_HANDLE(instance) ((instance) ? (instance)->handle : NULL)
 
 FuriMessageQueue* furi_message_queue_alloc(uint32_t msg_count, uint32_t msg_size) {
     furi_assert((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
 
-    QueueHandle_t handle = xQueueCreate(msg_count, msg_size);
-    furi_check(handle);
+    FuriMessageQueue* instance = malloc(sizeof(FuriMessageQueue));
+    instance->handle = xQueueCreate(msg_count, msg_size);
+    furi_check(instance->handle);
 
-    return ((FuriMessageQueue*)handle);
+    return instance;
 }
 
 void furi_message_queue_free(FuriMessageQueue* instance) {
     furi_assert(furi_kernel_is_irq_or_masked() == 0U);
     furi_assert(instance);
+    // Event loop must unsubscribe first
+    furi_check(instance->event_loop_link.event_loop == NULL);
 
-    vQueueDelete((QueueHandle_t)instance);
+    vQueueDelete(instance->handle);
+    free(instance);
 }
 
 FuriStatus
     furi_message_queue_put(FuriMessageQueue* instance, const void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = FURI_MESSAGE_QUEUE_HANDLE(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -54,12 +67,16 @@ FuriStatus
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link);
+    }
+
     /* Return execution status */
     return (stat);
 }
 
 FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uint32_t timeout) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = FURI_MESSAGE_QUEUE_HANDLE(instance);
     FuriStatus stat;
     BaseType_t yield;
 
@@ -96,7 +113,7 @@ FuriStatus furi_message_queue_get(FuriMessageQueue* instance, void* msg_ptr, uin
 }
 
 uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)FURI_MESSAGE_QUEUE_HANDLE(instance);
     uint32_t capacity;
 
     if(mq == NULL) {
@@ -111,7 +128,7 @@ uint32_t furi_message_queue_get_capacity(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)FURI_MESSAGE_QUEUE_HANDLE(instance);
     uint32_t size;
 
     if(mq == NULL) {
@@ -126,7 +143,7 @@ uint32_t furi_message_queue_get_message_size(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = FURI_MESSAGE_QUEUE_HANDLE(instance);
     UBaseType_t count;
 
     if(hQueue == NULL) {
@@ -142,7 +159,7 @@ uint32_t furi_message_queue_get_count(FuriMessageQueue* instance) {
 }
 
 uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
-    StaticQueue_t* mq = (StaticQueue_t*)instance;
+    StaticQueue_t* mq = (StaticQueue_t*)FURI_MESSAGE_QUEUE_HANDLE(instance);
     uint32_t space;
     uint32_t isrm;
 
@@ -164,7 +181,7 @@ uint32_t furi_message_queue_get_space(FuriMessageQueue* instance) {
 }
 
 FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
-    QueueHandle_t hQueue = (QueueHandle_t)instance;
+    QueueHandle_t hQueue = FURI_MESSAGE_QUEUE_HANDLE(instance);
     FuriStatus stat;
 
     if(furi_kernel_is_irq_or_masked() != 0U) {
@@ -179,3 +196,8 @@ FuriStatus furi_message_queue_reset(FuriMessageQueue* instance) {
     /* Return execution status */
     return (stat);
 }
+
+FuriEventLoopLink* furi_message_queue_get_event_loop_link(FuriMessageQueue* instance) {
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
@@ -2,18 +2,28 @@
 #include "memmgr.h"
 #include "check.h"
 #include "mutex.h"
+#include "kernel.h"
+#include "common_defines.h"
 
-#include <m-list.h>
+#include <string.h>
 
 struct FuriPubSubSubscription {
     FuriPubSubCallback callback;
     void* callback_context;
+    FuriMessageQueue* queue;
+    uint32_t dropped;
 };
 
-LIST_DEF(FuriPubSubSubscriptionList, FuriPubSubSubscription, M_POD_OPLIST);
+/** Immutable subscriber list, replaced as a whole on subscribe/unsubscribe */
+typedef struct {
+    uint32_t readers;
+    size_t count;
+    FuriPubSubSubscription* items[];
+} FuriPubSubSnapshot;
 
 struct FuriPubSub {
-    FuriPubSubSubscriptionList_t items;
+    FuriPubSubSnapshot* snapshot;
+    /* Serializes writers only, publish doesn't take it */
     FuriMutex* mutex;
 };
 
@@ -23,7 +33,7 @@ FuriPubSub* furi_pubsub_alloc() {
     pubsub->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     furi_assert(pubsub->mutex);
 
-    FuriPubSubSubscriptionList_init(pubsub->items);
+    pubsub->snapshot = NULL;
 
     return pubsub;
 }
@@ -31,28 +41,108 @@ FuriPubSub* furi_pubsub_alloc() {
 void furi_pubsub_free(FuriPubSub* pubsub) {
     furi_assert(pubsub);
 
-    furi_check(FuriPubSubSubscriptionList_size(pubsub->items) == 0);
-
-    FuriPubSubSubscriptionList_clear(pubsub->items);
+    furi_check(pubsub->snapshot == NULL);
 
     furi_mutex_free(pubsub->mutex);
 
     free(pubsub);
 }
 
+static FuriPubSubSnapshot* furi_pubsub_snapshot_alloc(size_t count) {
+    if(!count) return NULL;
+    FuriPubSubSnapshot* snapshot =
+        malloc(sizeof(FuriPubSubSnapshot) + sizeof(FuriPubSubSubscription*) * count);
+    snapshot->count = count;
+    return snapshot;
+}
+
+/* Publish current snapshot and wait until nobody iterates the previous one */
+static void furi_pubsub_replace_snapshot(FuriPubSub* pubsub, FuriPubSubSnapshot* snapshot) {
+    FuriPubSubSnapshot* previous;
+
+    FURI_CRITICAL_ENTER();
+    previous = pubsub->snapshot;
+    pubsub->snapshot = snapshot;
+    FURI_CRITICAL_EXIT();
+
+    if(previous) {
+        while(__atomic_load_n(&previous->readers, __ATOMIC_ACQUIRE)) {
+            furi_delay_tick(1);
+        }
+        free(previous);
+    }
+}
+
+static FuriPubSubSnapshot* furi_pubsub_acquire_snapshot(FuriPubSub* pubsub) {
+    FuriPubSubSnapshot* snapshot;
+
+    // Few instructions, so pointer can't be freed between load and increment
+    FURI_CRITICAL_ENTER();
+    snapshot = pubsub->snapshot;
+    if(snapshot) snapshot->readers++;
+    FURI_CRITICAL_EXIT();
+
+    return snapshot;
+}
+
+static void furi_pubsub_release_snapshot(FuriPubSubSnapshot* snapshot) {
+    FURI_CRITICAL_ENTER();
+    snapshot->readers--;
+    FURI_CRITICAL_EXIT();
+}
+
+static FuriPubSubSubscription*
+    furi_pubsub_add(FuriPubSub* pubsub, FuriPubSubSubscription* subscription) {
+    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+
+    FuriPubSubSnapshot* current = pubsub->snapshot;
+    size_t count = current ? current->count : 0;
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(count + 1);
+    if(count) {
+        memcpy(snapshot->items, current->items, sizeof(FuriPubSubSubscription*) * count);
+    }
+    snapshot->items[count] = subscription;
+    furi_pubsub_replace_snapshot(pubsub, snapshot);
+
+    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+
+    return subscription;
+}
+
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    // put uninitialized item to the list
-    FuriPubSubSubscription* item = FuriPubSubSubscriptionList_push_raw(pubsub->items);
+    furi_assert(pubsub);
+    furi_assert(callback);
 
-    // initialize item
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
     item->callback = callback;
     item->callback_context = callback_context;
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    return furi_pubsub_add(pubsub, item);
+}
+
+static void furi_pubsub_queue_callback(const void* message, void* context) {
+    FuriPubSubSubscription* item = context;
+    if(furi_message_queue_put(item->queue, message, 0) != FuriStatusOk) {
+        __atomic_fetch_add(&item->dropped, 1, __ATOMIC_RELAXED);
+    }
+}
+
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue) {
+    furi_assert(pubsub);
+    furi_assert(queue);
+
+    FuriPubSubSubscription* item = malloc(sizeof(FuriPubSubSubscription));
+    item->callback = furi_pubsub_queue_callback;
+    item->callback_context = item;
+    item->queue = queue;
 
-    return item;
+    return furi_pubsub_add(pubsub, item);
+}
+
+uint32_t furi_pubsub_subscription_get_dropped(FuriPubSubSubscription* pubsub_subscription) {
+    furi_assert(pubsub_subscription);
+    return __atomic_load_n(&pubsub_subscription->dropped, __ATOMIC_RELAXED);
 }
 
 void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_subscription) {
@@ -60,36 +150,46 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
     furi_assert(pubsub_subscription);
 
     furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
-    bool result = false;
-
-    // iterate over items
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
-
-        // if the iterator is equal to our element
-        if(item == pubsub_subscription) {
-            FuriPubSubSubscriptionList_remove(pubsub->items, it);
-            result = true;
+
+    FuriPubSubSnapshot* current = pubsub->snapshot;
+    furi_check(current);
+
+    size_t index = current->count;
+    for(size_t i = 0; i < current->count; i++) {
+        if(current->items[i] == pubsub_subscription) {
+            index = i;
             break;
         }
     }
+    furi_check(index < current->count);
+
+    FuriPubSubSnapshot* snapshot = furi_pubsub_snapshot_alloc(current->count - 1);
+    if(snapshot) {
+        memcpy(snapshot->items, current->items, sizeof(FuriPubSubSubscription*) * index);
+        memcpy(
+            &snapshot->items[index],
+            &current->items[index + 1],
+            sizeof(FuriPubSubSubscription*) * (current->count - index - 1));
+    }
+    // Returns when no publisher can call the removed subscription anymore
+    furi_pubsub_replace_snapshot(pubsub, snapshot);
 
     furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
-    furi_check(result);
+
+    free(pubsub_subscription);
 }
 
 void furi_pubsub_publish(FuriPubSub* pubsub, void* message) {
-    furi_check(furi_mutex_acquire(pubsub->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_assert(pubsub);
+
+    FuriPubSubSnapshot* snapshot = furi_pubsub_acquire_snapshot(pubsub);
+    if(!snapshot) return;
 
     // iterate over subscribers
-    FuriPubSubSubscriptionList_it_t it;
-    for(FuriPubSubSubscriptionList_it(it, pubsub->items); !FuriPubSubSubscriptionList_end_p(it);
-        FuriPubSubSubscriptionList_next(it)) {
-        const FuriPubSubSubscription* item = FuriPubSubSubscriptionList_cref(it);
+    for(size_t i = 0; i < snapshot->count; i++) {
+        const FuriPubSubSubscription* item = snapshot->items[i];
         item->callback(message, item->callback_context);
     }
 
-    furi_check(furi_mutex_release(pubsub->mutex) == FuriStatusOk);
+    furi_pubsub_release_snapshot(snapshot);
 }
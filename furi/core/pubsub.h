@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include "message_queue.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -44,9 +46,34 @@ void furi_pubsub_free(FuriPubSub* pubsub);
 FuriPubSubSubscription*
     furi_pubsub_subscribe(FuriPubSub* pubsub, FuriPubSubCallback callback, void* callback_context);
 
+/** Subscribe to FuriPubSub with asynchronous delivery
+ *
+ * Published message is copied to the queue without waiting, so slow
+ * subscriber doesn't stall publisher. Messages that don't fit are dropped
+ * and counted. Queue message size must match published message size.
+ * Threadsafe, Reentrable
+ *
+ * @param      pubsub  pointer to FuriPubSub instance
+ * @param      queue   queue owned by subscriber, must outlive subscription
+ *
+ * @return     pointer to FuriPubSubSubscription instance
+ */
+FuriPubSubSubscription* furi_pubsub_subscribe_queue(FuriPubSub* pubsub, FuriMessageQueue* queue);
+
+/** Get count of messages dropped for asynchronous subscription
+ *
+ * @param      pubsub_subscription  pointer to FuriPubSubSubscription instance
+ *
+ * @return     dropped messages count
+ */
+uint32_t furi_pubsub_subscription_get_dropped(FuriPubSubSubscription* pubsub_subscription);
+
 /** Unsubscribe from FuriPubSub
  * 
- * No use of `pubsub_subscription` allowed after call of this method
+ * No use of `pubsub_subscription` allowed after call of this method.
+ * Waits for publishers that may still call the subscription, so callback
+ * is never called after return. Must not be called from callback of the
+ * same FuriPubSub.
  * Threadsafe, Reentrable.
  *
  * @param      pubsub               pointer to FuriPubSub instance
@@ -56,6 +83,8 @@ void furi_pubsub_unsubscribe(FuriPubSub* pubsub, FuriPubSubSubscription* pubsub_
 
 /** Publish message to FuriPubSub
  *
+ * Doesn't take the pubsub mutex: iterates over subscribers snapshot, so
+ * publishers don't serialize against each other or subscribe/unsubscribe.
  * Threadsafe, Reentrable.
  * 
  * @param      pubsub   pointer to FuriPubSub instance
@@ -1,9 +1,16 @@
 #include "semaphore.h"
 #include "check.h"
 #include "common_defines.h"
+#include "event_loop_i.h"
+#include "memmgr.h"
 
 #include <semphr.h>
 
+struct FuriSemaphore {
+    SemaphoreHandle_t handle;
+    FuriEventLoopLink event_loop_link;
+};
+
 FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count) {
     furi_assert(!FURI_IS_IRQ_MODE());
     furi_assert((max_count > 0U) && (initial_count <= max_count));
@@ -23,23 +30,28 @@ FuriSemaphore* furi_semaphore_alloc(uint32_t max_count, uint32_t initial_count)
 
     furi_check(hSemaphore);
 
+    FuriSemaphore* instance = malloc(sizeof(FuriSemaphore));
+    instance->handle = hSemaphore;
+
     /* Return semaphore ID */
-    return ((FuriSemaphore*)hSemaphore);
+    return instance;
 }
 
 void furi_semaphore_free(FuriSemaphore* instance) {
     furi_assert(instance);
     furi_assert(!FURI_IS_IRQ_MODE());
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    // Event loop must unsubscribe first
+    furi_check(instance->event_loop_link.event_loop == NULL);
 
-    vSemaphoreDelete(hSemaphore);
+    vSemaphoreDelete(instance->handle);
+    free(instance);
 }
 
 FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = instance->handle;
     FuriStatus stat;
     BaseType_t yield;
 
@@ -74,7 +86,7 @@ FuriStatus furi_semaphore_acquire(FuriSemaphore* instance, uint32_t timeout) {
 FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = instance->handle;
     FuriStatus stat;
     BaseType_t yield;
 
@@ -94,6 +106,10 @@ FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
         }
     }
 
+    if(stat == FuriStatusOk) {
+        furi_event_loop_link_notify(&instance->event_loop_link);
+    }
+
     /* Return execution status */
     return (stat);
 }
@@ -101,7 +117,7 @@ FuriStatus furi_semaphore_release(FuriSemaphore* instance) {
 uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
     furi_assert(instance);
 
-    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)instance;
+    SemaphoreHandle_t hSemaphore = instance->handle;
     uint32_t count;
 
     if(FURI_IS_IRQ_MODE()) {
@@ -113,3 +129,8 @@ uint32_t furi_semaphore_get_count(FuriSemaphore* instance) {
     /* Return number of tokens */
     return (count);
 }
+
+FuriEventLoopLink* furi_semaphore_get_event_loop_link(FuriSemaphore* instance) {
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
@@ -8,6 +8,7 @@
 #include "common_defines.h"
 #include "mutex.h"
 #include "string.h"
+#include "event_loop_i.h"
 
 #include <task.h>
 #include <timers.h>
@@ -342,6 +343,11 @@ uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
             (void)xTaskNotifyIndexed(hTask, THREAD_NOTIFY_INDEX, flags, eSetBits);
             (void)xTaskNotifyAndQueryIndexed(hTask, THREAD_NOTIFY_INDEX, 0, eNoAction, &rflags);
         }
+
+        FuriThread* thread = pvTaskGetThreadLocalStoragePointer(hTask, 0);
+        if(thread && thread->event_loop) {
+            furi_event_loop_thread_flags_notify(hTask);
+        }
     }
     /* Return flags after setting */
     return (rflags);
@@ -537,6 +543,19 @@ uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
     return (sz);
 }
 
+uint64_t furi_thread_get_cpu_cycles(FuriThreadId thread_id) {
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    uint64_t cycles = 0;
+
+    if(!FURI_IS_IRQ_MODE() && (hTask != NULL)) {
+        TaskStatus_t status;
+        vTaskGetInfo(hTask, &status, pdFALSE, eInvalid);
+        cycles = status.ulRunTimeCounter;
+    }
+
+    return cycles;
+}
+
 static size_t __furi_thread_stdout_write(FuriThread* thread, const char* data, size_t size) {
     if(thread->output.write_callback != NULL) {
         thread->output.write_callback(data, size);
@@ -281,6 +281,16 @@ const char* furi_thread_get_appid(FuriThreadId thread_id);
  */
 uint32_t furi_thread_get_stack_space(FuriThreadId thread_id);
 
+/**
+ * @brief Get CPU cycles spent by thread
+ * 
+ * Counter is updated on context switch, time slice in progress is not included.
+ * 
+ * @param thread_id 
+ * @return uint64_t CPU cycles, 0 if thread_id is invalid
+ */
+uint64_t furi_thread_get_cpu_cycles(FuriThreadId thread_id);
+
 /** Get STDOUT callback for thead
  *
  * @return STDOUT callback
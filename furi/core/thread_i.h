@@ -2,6 +2,7 @@
 
 #include "thread.h"
 #include "string.h"
+#include "event_loop.h"
 
 typedef struct {
     FuriThreadStdoutWriteCallback write_callback;
@@ -28,6 +29,9 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    // Owned event loop, woken up on thread flags
+    FuriEventLoop* event_loop;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "../furi_shim/storage_ram.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <time.h>
+
+uint64_t bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void bench_report_add(
+    BenchReport* report,
+    const char* suite,
+    const char* name,
+    const char* unit,
+    uint64_t items,
+    uint32_t iterations,
+    uint64_t elapsed_ns,
+    uint32_t decoded) {
+    furi_check(report->count < BENCH_RESULTS_MAX);
+
+    BenchResult* result = &report->results[report->count++];
+    result->suite = suite;
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->unit = unit;
+    result->items = items;
+    result->iterations = iterations;
+    result->elapsed_ns = elapsed_ns;
+    result->decoded = decoded;
+}
+
+static int bench_corpus_compare(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+size_t bench_corpus_load(
+    const BenchConfig* config,
+    const char* subdir,
+    const char* extension,
+    char*** names) {
+    FuriString* host_path = furi_string_alloc_printf("%s/%s", config->corpus_dir, subdir);
+    FuriString* path = furi_string_alloc();
+    size_t count = 0;
+    *names = NULL;
+
+    DIR* dir = opendir(furi_string_get_cstr(host_path));
+    if(dir) {
+        struct dirent* entry;
+        while((entry = readdir(dir)) != NULL) {
+            size_t length = strlen(entry->d_name);
+            if(length <= strlen(extension) ||
+               strcmp(entry->d_name + length - strlen(extension), extension) != 0) {
+                continue;
+            }
+
+            furi_string_printf(host_path, "%s/%s/%s", config->corpus_dir, subdir, entry->d_name);
+            furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), subdir, entry->d_name);
+            if(!storage_ram_load_file(
+                   config->storage,
+                   furi_string_get_cstr(path),
+                   furi_string_get_cstr(host_path))) {
+                continue;
+            }
+
+            *names = realloc(*names, sizeof(char*) * (count + 1));
+            (*names)[count++] = strdup(entry->d_name);
+        }
+        closedir(dir);
+    }
+
+    // Same order on every run, so results are comparable
+    if(count) qsort(*names, count, sizeof(char*), bench_corpus_compare);
+
+    furi_string_free(path);
+    furi_string_free(host_path);
+    return count;
+}
+
+void bench_corpus_free(char** names, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        free(names[i]);
+    }
+    free(names);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file bench.h
+ * Host benchmark runner
+ *
+ * Every suite loads its corpus, runs each case `iterations` times and adds
+ * one result per case. Runner prints results as JSON.
+ */
+#pragma once
+
+#include <furi.h>
+#include <storage/storage.h>
+
+/* Host uint32_t is unsigned int, firmware %lu doesn't fit it */
+#include <inttypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_RESULTS_MAX (512)
+
+typedef struct {
+    const char* corpus_dir;
+    uint32_t iterations;
+    Storage* storage;
+} BenchConfig;
+
+typedef struct {
+    const char* suite;
+    char name[64];
+    const char* unit;
+    uint64_t items;
+    uint32_t iterations;
+    uint64_t elapsed_ns;
+    uint32_t decoded;
+} BenchResult;
+
+typedef struct {
+    BenchResult results[BENCH_RESULTS_MAX];
+    size_t count;
+} BenchReport;
+
+typedef void (*BenchSuiteRun)(BenchReport* report, const BenchConfig* config);
+
+typedef struct {
+    const char* name;
+    BenchSuiteRun run;
+} BenchSuite;
+
+/** Monotonic time in nanoseconds */
+uint64_t bench_time_ns(void);
+
+/** Add result to report
+ *
+ * @param      report      BenchReport instance
+ * @param      suite       suite name
+ * @param      name        case name
+ * @param      unit        what items are: samples, bytes, words
+ * @param      items       items processed in all iterations
+ * @param      iterations  iteration count
+ * @param      elapsed_ns  time of all iterations
+ * @param      decoded     decoded messages in all iterations, 0 if not a decoder
+ */
+void bench_report_add(
+    BenchReport* report,
+    const char* suite,
+    const char* name,
+    const char* unit,
+    uint64_t items,
+    uint32_t iterations,
+    uint64_t elapsed_ns,
+    uint32_t decoded);
+
+/** Copy corpus files with extension to storage
+ *
+ * @param      config     bench config
+ * @param      subdir     corpus subdirectory, files go to EXT_PATH("unit_tests/<subdir>")
+ * @param      extension  file extension with dot
+ * @param      names      output, file names, caller frees with bench_corpus_free
+ *
+ * @return     file count
+ */
+size_t bench_corpus_load(
+    const BenchConfig* config,
+    const char* subdir,
+    const char* extension,
+    char*** names);
+
+void bench_corpus_free(char** names, size_t count);
+
+/** SubGhz RAW file samples: positive high, negative low, us */
+typedef struct {
+    int32_t* samples;
+    size_t count;
+    size_t capacity;
+} BenchSubGhzCapture;
+
+/** Load all RAW_Data of SubGhz RAW file
+ *
+ * @param      path     file path in storage
+ * @param      capture  output, caller frees samples
+ *
+ * @return     true if file is RAW and has samples
+ */
+bool bench_subghz_load_capture(const char* path, BenchSubGhzCapture* capture);
+
+void bench_subghz(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_history(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_frequency_analyzer(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_hopper(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_bin_raw(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_rx_ring(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_load(BenchReport* report, const BenchConfig* config);
+
+void bench_subghz_file_replay(BenchReport* report, const BenchConfig* config);
+
+void bench_desktop_animation(BenchReport* report, const BenchConfig* config);
+
+void bench_rpc_gui_stream(BenchReport* report, const BenchConfig* config);
+
+void bench_infrared(BenchReport* report, const BenchConfig* config);
+
+void bench_lfrfid(BenchReport* report, const BenchConfig* config);
+
+void bench_nfc(BenchReport* report, const BenchConfig* config);
+
+void bench_mifare_nested(BenchReport* report, const BenchConfig* config);
+
+void bench_profiler(BenchReport* report, const BenchConfig* config);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,233 @@
+#include "bench.h"
+#include "../furi_shim/storage_ram.h"
+
+#include <malloc.h>
+#include <toolbox/compress.h>
+#include <desktop/animations/animation_pack.h>
+
+/* Desktop animation frames: folder layout with every frame_N.bm resident,
+ * against streamed pack. Corpus frames are raw bitmaps of dolphin animations,
+ * they are compressed here like asset tools do for SD-card animations.
+ *
+ * Results: _resident items - heap bytes held by loaded animation, not a rate.
+ * _load, _pack_build and _pack_open items - frames, elapsed_ns - time until
+ * animation is ready. _playback items - frames read and decoded from pack. */
+
+#define BENCH_ANIMATION_CORPUS "desktop"
+
+static const char* const bench_animation_names[] = {
+    "L1_Cry_128x64",
+    "L1_Laptop_128x51",
+    "L1_Kaiju_128x64",
+};
+
+/* Heap in use, glibc counts shim malloc too. Not under sanitizers */
+static size_t bench_animation_get_heap_used(void) {
+    return mallinfo2().uordblks;
+}
+
+/* Compress frame files in place, same format as scripts/flipper/assets/icon.py */
+static void bench_animation_compress_frames(
+    Storage* storage,
+    const char* path,
+    uint8_t** frames,
+    size_t frame_count,
+    size_t bitmap_size) {
+    Compress* compress = compress_alloc(bitmap_size);
+    size_t encoded_size = bitmap_size + bitmap_size / 8 + 16;
+    uint8_t* encoded = malloc(encoded_size);
+    FuriString* filename = furi_string_alloc();
+
+    for(size_t i = 0; i < frame_count; i++) {
+        furi_string_printf(filename, "%s/frame_%zu.bm", path, i);
+        size_t size = 0;
+        if(compress_encode(compress, &frames[i][1], bitmap_size, encoded, encoded_size, &size) &&
+           encoded[0] && (size < bitmap_size + 1)) {
+            // Icon header holds payload size without header itself
+            uint16_t payload_size = size - 4;
+            memcpy(&encoded[2], &payload_size, sizeof(payload_size));
+            storage_ram_add_file(storage, furi_string_get_cstr(filename), encoded, size);
+        }
+    }
+
+    furi_string_free(filename);
+    free(encoded);
+    compress_free(compress);
+}
+
+/* animation_storage_load_frame_files: every frame file is read into its own buffer */
+static void bench_animation_load_folder(
+    Storage* storage,
+    const char* path,
+    uint8_t** loaded,
+    size_t frame_count) {
+    File* file = storage_file_alloc(storage);
+    FuriString* filename = furi_string_alloc();
+    FileInfo file_info;
+
+    for(size_t i = 0; i < frame_count; i++) {
+        furi_string_printf(filename, "%s/frame_%zu.bm", path, i);
+        furi_check(
+            storage_common_stat(storage, furi_string_get_cstr(filename), &file_info) == FSE_OK);
+        furi_check(storage_file_open(
+            file, furi_string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING));
+        loaded[i] = malloc(file_info.size);
+        furi_check(storage_file_read(file, loaded[i], file_info.size) == file_info.size);
+        storage_file_close(file);
+    }
+
+    furi_string_free(filename);
+    storage_file_free(file);
+}
+
+static void bench_animation_run(
+    BenchReport* report,
+    const BenchConfig* config,
+    const char* name,
+    FuriString* case_name) {
+    FuriString* subdir = furi_string_alloc_printf("%s/%s", BENCH_ANIMATION_CORPUS, name);
+    char** names;
+    size_t frame_count = bench_corpus_load(config, furi_string_get_cstr(subdir), ".bm", &names);
+    furi_check(frame_count && frame_count < 256);
+    bench_corpus_free(names, frame_count);
+
+    unsigned width = 0;
+    unsigned height = 0;
+    furi_check(sscanf(strrchr(name, '_'), "_%ux%u", &width, &height) == 2);
+    size_t bitmap_size = ROUND_UP_TO(width, 8) * height;
+
+    FuriString* path =
+        furi_string_alloc_printf(EXT_PATH("unit_tests/%s"), furi_string_get_cstr(subdir));
+    const char* path_cstr = furi_string_get_cstr(path);
+    FuriString* filename = furi_string_alloc();
+
+    // Raw corpus frames are the reference for decoded ones
+    uint8_t** frames = malloc(sizeof(uint8_t*) * frame_count);
+    for(size_t i = 0; i < frame_count; i++) {
+        frames[i] = malloc(bitmap_size + 1);
+        furi_string_printf(filename, "%s/frame_%zu.bm", path_cstr, i);
+        File* file = storage_file_alloc(config->storage);
+        furi_check(storage_file_open(
+            file, furi_string_get_cstr(filename), FSAM_READ, FSOM_OPEN_EXISTING));
+        furi_check(storage_file_read(file, frames[i], bitmap_size + 1) == bitmap_size + 1);
+        storage_file_free(file);
+    }
+    bench_animation_compress_frames(config->storage, path_cstr, frames, frame_count, bitmap_size);
+
+    // Folder layout
+    uint8_t** loaded = malloc(sizeof(uint8_t*) * frame_count);
+    size_t heap_before = bench_animation_get_heap_used();
+    uint64_t start = bench_time_ns();
+    bench_animation_load_folder(config->storage, path_cstr, loaded, frame_count);
+    uint64_t elapsed = bench_time_ns() - start;
+    size_t folder_resident = bench_animation_get_heap_used() - heap_before;
+    for(size_t i = 0; i < frame_count; i++) {
+        free(loaded[i]);
+    }
+    free(loaded);
+
+    furi_string_printf(case_name, "%s_load", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "frames",
+        frame_count,
+        1,
+        elapsed,
+        0);
+    furi_string_printf(case_name, "%s_resident", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "bytes",
+        folder_resident,
+        1,
+        0,
+        0);
+
+    // Pack: conversion on first start, then open on every start
+    start = bench_time_ns();
+    furi_check(animation_pack_build(config->storage, path_cstr, frame_count, width, height));
+    elapsed = bench_time_ns() - start;
+    furi_check(animation_pack_is_actual(config->storage, path_cstr, frame_count));
+    furi_string_printf(case_name, "%s_pack_build", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "frames",
+        frame_count,
+        1,
+        elapsed,
+        0);
+
+    heap_before = bench_animation_get_heap_used();
+    start = bench_time_ns();
+    AnimationPack* pack =
+        animation_pack_alloc(config->storage, path_cstr, frame_count, width, height);
+    elapsed = bench_time_ns() - start;
+    furi_check(pack);
+    furi_string_printf(case_name, "%s_pack_open", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "frames",
+        frame_count,
+        1,
+        elapsed,
+        0);
+
+    // Playback: every frame is decoded as it was drawn
+    start = bench_time_ns();
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        for(size_t i = 0; i < frame_count; i++) {
+            const uint8_t* frame = animation_pack_get_frame(pack, i);
+            furi_check(frame && !frame[0] && !memcmp(&frame[1], &frames[i][1], bitmap_size));
+        }
+    }
+    elapsed = bench_time_ns() - start;
+    size_t pack_resident = bench_animation_get_heap_used() - heap_before;
+    animation_pack_free(pack);
+
+    furi_string_printf(case_name, "%s_playback", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "frames",
+        (uint64_t)frame_count * config->iterations,
+        config->iterations,
+        elapsed,
+        0);
+    furi_string_printf(case_name, "%s_pack_resident", name);
+    bench_report_add(
+        report,
+        "desktop_animation",
+        furi_string_get_cstr(case_name),
+        "bytes",
+        pack_resident,
+        1,
+        0,
+        0);
+
+    for(size_t i = 0; i < frame_count; i++) {
+        free(frames[i]);
+    }
+    free(frames);
+    furi_string_free(filename);
+    furi_string_free(path);
+    furi_string_free(subdir);
+}
+
+void bench_desktop_animation(BenchReport* report, const BenchConfig* config) {
+    FuriString* case_name = furi_string_alloc();
+
+    for(size_t i = 0; i < COUNT_OF(bench_animation_names); i++) {
+        bench_animation_run(report, config, bench_animation_names[i], case_name);
+    }
+
+    furi_string_free(case_name);
+}
@@ -0,0 +1,155 @@
+#include "bench.h"
+
+#include <infrared.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "BenchInfrared"
+
+#define BENCH_INFRARED_CORPUS "infrared"
+#define BENCH_INFRARED_PREFIX "test_"
+#define BENCH_INFRARED_SUFFIX ".irtest"
+#define BENCH_INFRARED_INPUTS_MAX (16)
+
+typedef struct {
+    uint32_t* timings;
+    uint32_t count;
+} BenchInfraredInput;
+
+/* Every decoder_input signal of test file, expected results are not needed */
+static size_t bench_infrared_load_inputs(const char* path, BenchInfraredInput* inputs) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version;
+    size_t count = 0;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+
+        while(count < BENCH_INFRARED_INPUTS_MAX &&
+              flipper_format_read_string(ff, "name", temp_str)) {
+            if(!furi_string_start_with_str(temp_str, "decoder_input")) continue;
+            if(!flipper_format_read_string(ff, "type", temp_str) ||
+               furi_string_cmp_str(temp_str, "raw")) {
+                continue;
+            }
+
+            uint32_t timings_count;
+            if(!flipper_format_get_value_count(ff, "data", &timings_count) || !timings_count) {
+                continue;
+            }
+            uint32_t* timings = malloc(sizeof(uint32_t) * timings_count);
+            if(!flipper_format_read_uint32(ff, "data", timings, timings_count)) {
+                free(timings);
+                continue;
+            }
+            inputs[count].timings = timings;
+            inputs[count].count = timings_count;
+            count++;
+        }
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    return count;
+}
+
+/* Same feeding as infrared unit test: check by timeout on long gaps, then edge */
+static uint32_t bench_infrared_decode(
+    InfraredDecoderHandler* decoder,
+    const BenchInfraredInput* input) {
+    uint32_t decoded = 0;
+    bool level = false;
+
+    infrared_reset_decoder(decoder);
+    for(uint32_t i = 0; i < input->count; i++) {
+        if(input->timings[i] > INFRARED_RAW_RX_TIMING_DELAY_US) {
+            if(infrared_check_decoder_ready(decoder)) decoded++;
+        }
+        if(infrared_decode(decoder, level, input->timings[i])) decoded++;
+        level = !level;
+    }
+    if(infrared_check_decoder_ready(decoder)) decoded++;
+
+    return decoded;
+}
+
+void bench_infrared(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count =
+        bench_corpus_load(config, BENCH_INFRARED_CORPUS, BENCH_INFRARED_SUFFIX, &names);
+
+    InfraredDecoderHandler* decoder = infrared_alloc_decoder();
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    BenchInfraredInput inputs[BENCH_INFRARED_INPUTS_MAX];
+    uint64_t total_timings = 0;
+    uint64_t total_elapsed = 0;
+    uint32_t total_decoded = 0;
+
+    for(size_t i = 0; i < name_count; i++) {
+        furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), BENCH_INFRARED_CORPUS, names[i]);
+        size_t input_count = bench_infrared_load_inputs(furi_string_get_cstr(path), inputs);
+        if(!input_count) {
+            FURI_LOG_W(TAG, "Skipped %s", names[i]);
+            continue;
+        }
+
+        uint64_t timings = 0;
+        for(size_t j = 0; j < input_count; j++) {
+            timings += inputs[j].count;
+        }
+
+        uint32_t decoded = 0;
+        uint64_t start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            for(size_t j = 0; j < input_count; j++) {
+                decoded += bench_infrared_decode(decoder, &inputs[j]);
+            }
+        }
+        uint64_t elapsed = bench_time_ns() - start;
+
+        // test_nec.irtest -> nec
+        furi_string_set(name, names[i]);
+        if(furi_string_start_with_str(name, BENCH_INFRARED_PREFIX)) {
+            furi_string_right(name, strlen(BENCH_INFRARED_PREFIX));
+        }
+        furi_string_left(name, furi_string_size(name) - strlen(BENCH_INFRARED_SUFFIX));
+        bench_report_add(
+            report,
+            "infrared",
+            furi_string_get_cstr(name),
+            "timings",
+            timings * config->iterations,
+            config->iterations,
+            elapsed,
+            decoded);
+
+        total_timings += timings * config->iterations;
+        total_elapsed += elapsed;
+        total_decoded += decoded;
+
+        for(size_t j = 0; j < input_count; j++) {
+            free(inputs[j].timings);
+        }
+    }
+
+    if(name_count) {
+        bench_report_add(
+            report,
+            "infrared",
+            "all",
+            "timings",
+            total_timings,
+            config->iterations,
+            total_elapsed,
+            total_decoded);
+    }
+
+    furi_string_free(name);
+    furi_string_free(path);
+    infrared_free_decoder(decoder);
+    bench_corpus_free(names, name_count);
+}
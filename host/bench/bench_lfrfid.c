@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+
+/* There are no RFID captures in corpus, so timings come from protocol encoders.
+ * Read path is the same as lfrfid_worker: pulse glue, then every decoder. */
+
+#define BENCH_LFRFID_READ_TIMING_MULTIPLIER (8)
+#define BENCH_LFRFID_TIMINGS_COUNT (4096)
+
+typedef struct {
+    const char* name;
+    LFRFIDProtocol protocol;
+    uint8_t data[8];
+    size_t data_size;
+} BenchLfrfidCase;
+
+static const BenchLfrfidCase bench_lfrfid_cases[] = {
+    {"em4100", LFRFIDProtocolEM4100, {0x58, 0x00, 0x85, 0x64, 0x02}, 5},
+    {"h10301", LFRFIDProtocolH10301, {0x8D, 0x48, 0xA8}, 3},
+};
+
+static void bench_lfrfid_encode(ProtocolDict* dict, const BenchLfrfidCase* test, int32_t* out) {
+    protocol_dict_set_data(dict, test->protocol, test->data, test->data_size);
+    protocol_dict_encoder_start(dict, test->protocol);
+
+    for(size_t i = 0; i < BENCH_LFRFID_TIMINGS_COUNT; i++) {
+        LevelDuration level_duration = protocol_dict_encoder_yield(dict, test->protocol);
+        int32_t duration = level_duration_get_duration(level_duration);
+        out[i] = level_duration_get_level(level_duration) ? duration : -duration;
+    }
+}
+
+static uint32_t bench_lfrfid_decode(ProtocolDict* dict, const int32_t* timings) {
+    uint32_t decoded = 0;
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    protocol_dict_decoders_start(dict);
+    for(size_t i = 0; i < BENCH_LFRFID_TIMINGS_COUNT; i++) {
+        bool level = timings[i] >= 0;
+        uint32_t duration = level ? timings[i] : -timings[i];
+        if(!pulse_glue_push(pulse_glue, level, duration * BENCH_LFRFID_READ_TIMING_MULTIPLIER)) {
+            continue;
+        }
+
+        uint32_t length, period;
+        pulse_glue_pop(pulse_glue, &length, &period);
+        if(protocol_dict_decoders_feed(dict, true, period) != PROTOCOL_NO) decoded++;
+        if(protocol_dict_decoders_feed(dict, false, length - period) != PROTOCOL_NO) decoded++;
+    }
+
+    pulse_glue_free(pulse_glue);
+    return decoded;
+}
+
+void bench_lfrfid(BenchReport* report, const BenchConfig* config) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    int32_t* timings = malloc(sizeof(int32_t) * BENCH_LFRFID_TIMINGS_COUNT);
+
+    for(size_t i = 0; i < COUNT_OF(bench_lfrfid_cases); i++) {
+        bench_lfrfid_encode(dict, &bench_lfrfid_cases[i], timings);
+
+        uint32_t decoded = 0;
+        uint64_t start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            decoded += bench_lfrfid_decode(dict, timings);
+        }
+        uint64_t elapsed = bench_time_ns() - start;
+
+        bench_report_add(
+            report,
+            "lfrfid",
+            bench_lfrfid_cases[i].name,
+            "timings",
+            (uint64_t)BENCH_LFRFID_TIMINGS_COUNT * config->iterations,
+            config->iterations,
+            elapsed,
+            decoded);
+    }
+
+    free(timings);
+    protocol_dict_free(dict);
+}
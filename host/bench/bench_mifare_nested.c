@@ -0,0 +1,305 @@
+#include "bench.h"
+
+#include <applications/external/mifare_nested/lib/recovery/recovery_manifest.h>
+#include <stream/file_stream.h>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define TAG "BenchMifareNested"
+
+/* Mifare Nested key recovery on nonces manifests in collector format.
+ *
+ * Every manifest comes with the keys file of the card it was collected from.
+ * Nested entries are recovered from the whole tables in one thread, and from
+ * chunks split between threads. Hardnested entries are skipped, they need the
+ * desktop app. Device case runs the first chunk pairs of the first nested entry
+ * at chunk size of the app, to estimate on-device time.
+ *
+ * Recovery takes seconds, so every case runs once regardless of iterations.
+ *
+ * Results: items - manifest entries (chunk pairs for device case), decoded -
+ * keys matching the keys file. */
+
+#define BENCH_NESTED_SUBDIR "nfc/nested"
+#define BENCH_NESTED_THREADS_MAX (8)
+#define BENCH_NESTED_HOST_CHUNK_BITS (4)
+// Same as mifare_nested_worker.c
+#define BENCH_NESTED_DEVICE_CHUNK_BITS (8)
+#define BENCH_NESTED_DEVICE_CHUNKS (1024)
+#define BENCH_NESTED_KEYS_MAX (80)
+
+typedef struct {
+    uint8_t key_type;
+    uint8_t sector;
+    uint64_t key;
+} BenchNestedKey;
+
+typedef struct {
+    BenchNestedKey keys[BENCH_NESTED_KEYS_MAX];
+    size_t count;
+} BenchNestedKeys;
+
+typedef struct {
+    const NestedRecoveryTry* nested_try;
+    uint32_t* next_row;
+
+    uint32_t candidates;
+    uint64_t key;
+} BenchNestedThread;
+
+static uint32_t bench_nested_get_thread_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if(count < 1) return 1;
+    return count < BENCH_NESTED_THREADS_MAX ? count : BENCH_NESTED_THREADS_MAX;
+}
+
+static void bench_nested_load_keys(Storage* storage, const char* path, BenchNestedKeys* keys) {
+    Stream* stream = file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    keys->count = 0;
+
+    if(file_stream_open(stream, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(keys->count < BENCH_NESTED_KEYS_MAX && stream_read_line(stream, line)) {
+            char key_type = 0;
+            unsigned int sector = 0;
+            unsigned int bytes[6];
+            if(sscanf(
+                   furi_string_get_cstr(line),
+                   "Key %c sector %u: %x %x %x %x %x %x",
+                   &key_type,
+                   &sector,
+                   &bytes[0],
+                   &bytes[1],
+                   &bytes[2],
+                   &bytes[3],
+                   &bytes[4],
+                   &bytes[5]) != 8) {
+                continue;
+            }
+
+            BenchNestedKey* key = &keys->keys[keys->count++];
+            key->key_type = key_type == 'B';
+            key->sector = sector;
+            key->key = 0;
+            for(size_t i = 0; i < 6; i++) {
+                key->key = key->key << 8 | bytes[i];
+            }
+        }
+    } else {
+        FURI_LOG_E(TAG, "Can't open %s", path);
+    }
+
+    furi_string_free(line);
+    file_stream_close(stream);
+    stream_free(stream);
+}
+
+static const BenchNestedKey* bench_nested_find_key(
+    const BenchNestedKeys* keys,
+    const RecoveryManifestEntry* entry) {
+    for(size_t i = 0; i < keys->count; i++) {
+        if(keys->keys[i].key_type == entry->key_type && keys->keys[i].sector == entry->sector) {
+            return &keys->keys[i];
+        }
+    }
+    return NULL;
+}
+
+static bool bench_nested_key_callback(uint64_t key, void* context) {
+    BenchNestedThread* thread = context;
+    if(!thread->candidates++) thread->key = key;
+    // Whole chunk range is searched, so time doesn't depend on where the key is
+    return true;
+}
+
+static void* bench_nested_chunks_thread(void* context) {
+    BenchNestedThread* thread = context;
+    NestedRecovery* recovery = nested_recovery_alloc(BENCH_NESTED_HOST_CHUNK_BITS);
+    uint32_t chunks = nested_recovery_get_chunk_count(recovery);
+    uint32_t row_size = 1UL << BENCH_NESTED_HOST_CHUNK_BITS;
+
+    // Whole rows of the same odd chunk, so odd table is built once per row
+    uint32_t row;
+    while((row = __atomic_fetch_add(thread->next_row, 1, __ATOMIC_RELAXED)) < chunks / row_size) {
+        for(uint32_t chunk = row * row_size; chunk < (row + 1) * row_size; chunk++) {
+            NestedRecoveryResult result = nested_recovery_run(
+                recovery, thread->nested_try, chunk, bench_nested_key_callback, thread);
+            furi_check(result == NestedRecoveryResultOk);
+        }
+    }
+
+    nested_recovery_free(recovery);
+    return NULL;
+}
+
+static uint32_t bench_nested_run_threads(
+    BenchNestedThread* threads,
+    uint32_t thread_count,
+    void* (*run)(void*),
+    uint64_t* key) {
+    pthread_t ids[BENCH_NESTED_THREADS_MAX];
+    for(uint32_t i = 0; i < thread_count; i++) {
+        furi_check(!pthread_create(&ids[i], NULL, run, &threads[i]));
+    }
+
+    uint32_t candidates = 0;
+    for(uint32_t i = 0; i < thread_count; i++) {
+        pthread_join(ids[i], NULL);
+        if(threads[i].candidates && !candidates) *key = threads[i].key;
+        candidates += threads[i].candidates;
+    }
+    return candidates;
+}
+
+static uint32_t bench_nested_recover(
+    const NestedRecoveryTry* nested_try,
+    uint32_t thread_count,
+    uint64_t* key) {
+    if(thread_count == 1) {
+        BenchNestedThread thread = {.nested_try = nested_try};
+        NestedRecovery* recovery = nested_recovery_alloc(0);
+        furi_check(
+            nested_recovery_run(recovery, nested_try, 0, bench_nested_key_callback, &thread) ==
+            NestedRecoveryResultOk);
+        nested_recovery_free(recovery);
+        *key = thread.key;
+        return thread.candidates;
+    }
+
+    uint32_t next_row = 0;
+    BenchNestedThread threads[BENCH_NESTED_THREADS_MAX] = {0};
+    for(uint32_t i = 0; i < thread_count; i++) {
+        threads[i].nested_try = nested_try;
+        threads[i].next_row = &next_row;
+    }
+    return bench_nested_run_threads(threads, thread_count, bench_nested_chunks_thread, key);
+}
+
+/** Recover keys of all manifest entries, returns count of keys matching keys file */
+static uint32_t bench_nested_run_manifest(
+    RecoveryManifest* manifest,
+    const BenchNestedKeys* keys,
+    uint32_t thread_count) {
+    uint32_t matched = 0;
+    for(size_t i = 0; i < recovery_manifest_get_count(manifest); i++) {
+        const RecoveryManifestEntry* entry = recovery_manifest_get(manifest, i);
+        const BenchNestedKey* expected = bench_nested_find_key(keys, entry);
+        uint64_t key = 0;
+
+        NestedRecoveryTry nested_try;
+        if(!recovery_manifest_get_try(manifest, i, &nested_try)) continue;
+        uint32_t candidates = bench_nested_recover(&nested_try, thread_count, &key);
+
+        if(candidates > 1) {
+            FURI_LOG_W(TAG, "Sector %u: %" PRIu32 " candidate keys", entry->sector, candidates);
+        }
+        if(candidates && expected && expected->key == key) matched++;
+    }
+    return matched;
+}
+
+static void bench_nested_run_device(
+    BenchReport* report,
+    RecoveryManifest* manifest,
+    const char* name) {
+    NestedRecoveryTry nested_try;
+    size_t index = 0;
+    while(index < recovery_manifest_get_count(manifest) &&
+          !recovery_manifest_get_try(manifest, index, &nested_try)) {
+        index++;
+    }
+    if(index == recovery_manifest_get_count(manifest)) return;
+
+    NestedRecovery* recovery = nested_recovery_alloc(BENCH_NESTED_DEVICE_CHUNK_BITS);
+    BenchNestedThread thread = {.nested_try = &nested_try};
+
+    uint64_t start = bench_time_ns();
+    for(uint32_t chunk = 0; chunk < BENCH_NESTED_DEVICE_CHUNKS; chunk++) {
+        NestedRecoveryResult result = nested_recovery_run(
+            recovery, &nested_try, chunk, bench_nested_key_callback, &thread);
+        furi_check(result == NestedRecoveryResultOk);
+    }
+    uint64_t elapsed = bench_time_ns() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %zu bytes, %" PRIu32 " chunk pairs per entry",
+        name,
+        nested_recovery_get_memory_size(BENCH_NESTED_DEVICE_CHUNK_BITS),
+        nested_recovery_get_chunk_count(recovery));
+    nested_recovery_free(recovery);
+
+    bench_report_add(
+        report, "mifare_nested", name, "chunks", BENCH_NESTED_DEVICE_CHUNKS, 1, elapsed, 0);
+}
+
+void bench_mifare_nested(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t count = bench_corpus_load(config, BENCH_NESTED_SUBDIR, ".nonces", &names);
+    char** keys_names;
+    size_t keys_count = bench_corpus_load(config, BENCH_NESTED_SUBDIR, ".keys", &keys_names);
+    bench_corpus_free(keys_names, keys_count);
+
+    RecoveryManifest* manifest = recovery_manifest_alloc();
+    BenchNestedKeys* keys = malloc(sizeof(BenchNestedKeys));
+    FuriString* base = furi_string_alloc();
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    const uint32_t thread_counts[] = {1, bench_nested_get_thread_count()};
+    // Single core host: the threaded case would repeat the first one
+    const size_t thread_cases = thread_counts[1] > 1 ? COUNT_OF(thread_counts) : 1;
+
+    for(size_t i = 0; i < count; i++) {
+        furi_string_set(base, names[i]);
+        furi_string_left(base, furi_string_size(base) - strlen(".nonces"));
+
+        furi_string_printf(
+            path,
+            EXT_PATH("unit_tests/%s/%s.keys"),
+            BENCH_NESTED_SUBDIR,
+            furi_string_get_cstr(base));
+        bench_nested_load_keys(config->storage, furi_string_get_cstr(path), keys);
+
+        furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), BENCH_NESTED_SUBDIR, names[i]);
+        if(!recovery_manifest_load(manifest, config->storage, furi_string_get_cstr(path))) {
+            continue;
+        }
+        size_t entries = recovery_manifest_get_count(manifest);
+
+        for(size_t j = 0; j < thread_cases; j++) {
+            uint64_t start = bench_time_ns();
+            uint32_t matched = bench_nested_run_manifest(manifest, keys, thread_counts[j]);
+            uint64_t elapsed = bench_time_ns() - start;
+
+            furi_string_printf(
+                name, "%s_threads_%" PRIu32, furi_string_get_cstr(base), thread_counts[j]);
+            FURI_LOG_I(
+                TAG,
+                "%s: %" PRIu32 " of %zu keys",
+                furi_string_get_cstr(name),
+                matched,
+                keys->count);
+            bench_report_add(
+                report,
+                "mifare_nested",
+                furi_string_get_cstr(name),
+                "entries",
+                entries,
+                1,
+                elapsed,
+                matched);
+        }
+
+        furi_string_printf(name, "%s_device_chunks", furi_string_get_cstr(base));
+        bench_nested_run_device(report, manifest, furi_string_get_cstr(name));
+    }
+
+    furi_string_free(name);
+    furi_string_free(path);
+    furi_string_free(base);
+    free(keys);
+    recovery_manifest_free(manifest);
+    bench_corpus_free(names, count);
+}
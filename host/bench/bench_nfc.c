@@ -0,0 +1,122 @@
+#include "bench.h"
+
+#include <lib/nfc/protocols/crypto1.h>
+#include <lib/nfc/protocols/nfc_util.h>
+
+/* NFC corpus is digital signal captures that need the hardware, so this suite
+ * covers the Mifare Classic hot path on fixed vectors instead. */
+
+#define BENCH_NFC_OPERATIONS (4096)
+#define BENCH_NFC_BLOCK_SIZE (18)
+
+static const uint64_t bench_nfc_key = 0xA0A1A2A3A4A5;
+static const uint32_t bench_nfc_uid = 0x2A234F80;
+static const uint32_t bench_nfc_nt = 0x01200145;
+
+/* Keeps results alive, so compiler can't drop the work */
+static volatile uint32_t bench_nfc_sink;
+
+static uint64_t bench_nfc_crypto1_word(void) {
+    Crypto1 crypto = {0};
+    uint32_t sink = 0;
+    for(size_t i = 0; i < BENCH_NFC_OPERATIONS; i++) {
+        crypto1_init(&crypto, bench_nfc_key);
+        sink ^= crypto1_word(&crypto, bench_nfc_uid ^ (bench_nfc_nt + i), 0);
+    }
+    bench_nfc_sink = sink;
+    return BENCH_NFC_OPERATIONS;
+}
+
+static uint64_t bench_nfc_crypto1_encrypt(void) {
+    Crypto1 crypto = {0};
+    uint8_t plain[BENCH_NFC_BLOCK_SIZE];
+    uint8_t encrypted[BENCH_NFC_BLOCK_SIZE];
+    uint8_t parity[BENCH_NFC_BLOCK_SIZE / 8 + 1];
+
+    for(size_t i = 0; i < BENCH_NFC_BLOCK_SIZE; i++) {
+        plain[i] = i * 17;
+    }
+
+    crypto1_init(&crypto, bench_nfc_key);
+    for(size_t i = 0; i < BENCH_NFC_OPERATIONS; i++) {
+        crypto1_encrypt(&crypto, NULL, plain, BENCH_NFC_BLOCK_SIZE * 8, encrypted, parity);
+    }
+    bench_nfc_sink = encrypted[0] ^ parity[0];
+    return (uint64_t)BENCH_NFC_OPERATIONS * BENCH_NFC_BLOCK_SIZE;
+}
+
+static uint64_t bench_nfc_crypto1_decrypt(void) {
+    Crypto1 crypto = {0};
+    uint8_t encrypted[BENCH_NFC_BLOCK_SIZE];
+    uint8_t plain[BENCH_NFC_BLOCK_SIZE];
+
+    for(size_t i = 0; i < BENCH_NFC_BLOCK_SIZE; i++) {
+        encrypted[i] = i * 31;
+    }
+
+    crypto1_init(&crypto, bench_nfc_key);
+    for(size_t i = 0; i < BENCH_NFC_OPERATIONS; i++) {
+        crypto1_decrypt(&crypto, encrypted, BENCH_NFC_BLOCK_SIZE * 8, plain);
+    }
+    bench_nfc_sink = plain[0];
+    return (uint64_t)BENCH_NFC_OPERATIONS * BENCH_NFC_BLOCK_SIZE;
+}
+
+static uint64_t bench_nfc_prng_successor(void) {
+    uint32_t nt = bench_nfc_nt;
+    for(size_t i = 0; i < BENCH_NFC_OPERATIONS; i++) {
+        nt = prng_successor(nt, 64);
+    }
+    bench_nfc_sink = nt;
+    return BENCH_NFC_OPERATIONS;
+}
+
+static uint64_t bench_nfc_odd_parity(void) {
+    uint8_t data[BENCH_NFC_BLOCK_SIZE];
+    uint8_t parity[BENCH_NFC_BLOCK_SIZE / 8 + 1];
+
+    for(size_t i = 0; i < BENCH_NFC_BLOCK_SIZE; i++) {
+        data[i] = i * 13;
+    }
+    for(size_t i = 0; i < BENCH_NFC_OPERATIONS; i++) {
+        data[0] = i;
+        nfc_util_odd_parity(data, parity, BENCH_NFC_BLOCK_SIZE);
+    }
+    bench_nfc_sink = parity[0];
+    return (uint64_t)BENCH_NFC_OPERATIONS * BENCH_NFC_BLOCK_SIZE;
+}
+
+typedef struct {
+    const char* name;
+    const char* unit;
+    uint64_t (*run)(void);
+} BenchNfcCase;
+
+static const BenchNfcCase bench_nfc_cases[] = {
+    {"crypto1_word", "words", bench_nfc_crypto1_word},
+    {"crypto1_encrypt", "bytes", bench_nfc_crypto1_encrypt},
+    {"crypto1_decrypt", "bytes", bench_nfc_crypto1_decrypt},
+    {"prng_successor", "words", bench_nfc_prng_successor},
+    {"odd_parity", "bytes", bench_nfc_odd_parity},
+};
+
+void bench_nfc(BenchReport* report, const BenchConfig* config) {
+    for(size_t i = 0; i < COUNT_OF(bench_nfc_cases); i++) {
+        uint64_t items = 0;
+        uint64_t start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            items += bench_nfc_cases[i].run();
+        }
+        uint64_t elapsed = bench_time_ns() - start;
+
+        bench_report_add(
+            report,
+            "nfc",
+            bench_nfc_cases[i].name,
+            bench_nfc_cases[i].unit,
+            items,
+            config->iterations,
+            elapsed,
+            0);
+    }
+}
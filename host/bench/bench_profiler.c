@@ -0,0 +1,107 @@
+#include "bench.h"
+
+#include <toolbox/profiler_aggregate.h>
+
+/* Sample aggregation runs on device after every `top` refresh. Synthetic
+ * samples: few hot loops over uniform noise, like a busy firmware. Result is
+ * checked against straightforward counting, so this suite is a test too. */
+
+#define BENCH_PROFILER_SAMPLES (16384)
+#define BENCH_PROFILER_HOTSPOTS (8)
+#define BENCH_PROFILER_GRANULARITY (16)
+#define BENCH_PROFILER_FLASH_START (0x08000000)
+#define BENCH_PROFILER_FLASH_SIZE (0x100000)
+
+static const uint32_t bench_profiler_hot[] = {0x08012340, 0x08045670, 0x08001230};
+
+static FuriThreadId bench_profiler_thread(size_t index) {
+    return (FuriThreadId)(uintptr_t)(0x20001000 + (index % 4) * 0x100);
+}
+
+static void bench_profiler_generate(ProfilerSample* samples) {
+    uint32_t state = 0x12345678;
+    for(size_t i = 0; i < BENCH_PROFILER_SAMPLES; i++) {
+        // xorshift32, same samples on every run
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        if(state % 4 == 0) {
+            samples[i].pc = BENCH_PROFILER_FLASH_START + (state >> 2) % BENCH_PROFILER_FLASH_SIZE;
+        } else {
+            // Hot loops are few instructions long
+            samples[i].pc = bench_profiler_hot[state % COUNT_OF(bench_profiler_hot)] +
+                            (state >> 8) % BENCH_PROFILER_GRANULARITY;
+        }
+        samples[i].thread_id = bench_profiler_thread(i);
+    }
+}
+
+static void bench_profiler_verify(
+    const ProfilerSample* samples,
+    FuriThreadId thread_id,
+    const ProfilerHotspot* hotspots,
+    size_t count) {
+    furi_check(count == BENCH_PROFILER_HOTSPOTS);
+    uint32_t mask = ~(BENCH_PROFILER_GRANULARITY - 1);
+
+    for(size_t i = 0; i < count; i++) {
+        size_t expected = 0;
+        for(size_t j = 0; j < BENCH_PROFILER_SAMPLES; j++) {
+            if(thread_id && samples[j].thread_id != thread_id) continue;
+            if((samples[j].pc & mask) == hotspots[i].pc) expected++;
+        }
+        furi_check(expected == hotspots[i].count);
+        furi_check(!i || hotspots[i - 1].count >= hotspots[i].count);
+    }
+
+    for(size_t i = 0; i < COUNT_OF(bench_profiler_hot); i++) {
+        bool found = false;
+        for(size_t j = 0; j < COUNT_OF(bench_profiler_hot); j++) {
+            found |= hotspots[j].pc == bench_profiler_hot[i];
+        }
+        furi_check(found);
+    }
+}
+
+void bench_profiler(BenchReport* report, const BenchConfig* config) {
+    ProfilerSample* samples = malloc(sizeof(ProfilerSample) * BENCH_PROFILER_SAMPLES);
+    ProfilerHotspot hotspots[BENCH_PROFILER_HOTSPOTS];
+    bench_profiler_generate(samples);
+
+    const struct {
+        const char* name;
+        FuriThreadId thread_id;
+    } cases[] = {
+        {"hotspots_all", NULL},
+        {"hotspots_thread", bench_profiler_thread(1)},
+    };
+
+    for(size_t i = 0; i < COUNT_OF(cases); i++) {
+        size_t count = 0;
+        uint64_t start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            count = profiler_aggregate_hotspots(
+                samples,
+                BENCH_PROFILER_SAMPLES,
+                cases[i].thread_id,
+                BENCH_PROFILER_GRANULARITY,
+                hotspots,
+                BENCH_PROFILER_HOTSPOTS);
+        }
+        uint64_t elapsed = bench_time_ns() - start;
+
+        bench_profiler_verify(samples, cases[i].thread_id, hotspots, count);
+        bench_report_add(
+            report,
+            "profiler",
+            cases[i].name,
+            "samples",
+            (uint64_t)BENCH_PROFILER_SAMPLES * config->iterations,
+            config->iterations,
+            elapsed,
+            count);
+    }
+
+    free(samples);
+}
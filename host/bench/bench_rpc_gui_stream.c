@@ -0,0 +1,233 @@
+#include "bench.h"
+
+#include <u8g2.h>
+#include <rpc/rpc_gui_stream.h>
+
+/* Screen stream link usage on scripted UI sessions, rendered with u8g2 into
+ * the gui framebuffer layout. Like gui damage tracking, frames equal to the
+ * previous one are not sent.
+ *
+ * Results: _raw and _delta items - bytes sent, elapsed_ns - session time at
+ * BENCH_RPC_GUI_STREAM_FPS, so items_per_second is link bytes per second.
+ * _encode items - frames, elapsed_ns - measured encode and decode time. */
+
+#define TAG "BenchRpcGuiStream"
+
+#define BENCH_RPC_GUI_STREAM_WIDTH (128)
+#define BENCH_RPC_GUI_STREAM_HEIGHT (64)
+#define BENCH_RPC_GUI_STREAM_FRAME_SIZE \
+    (BENCH_RPC_GUI_STREAM_WIDTH * BENCH_RPC_GUI_STREAM_HEIGHT / 8)
+#define BENCH_RPC_GUI_STREAM_FPS (30)
+/* Same as rpc_gui.c */
+#define BENCH_RPC_GUI_STREAM_KEYFRAME_INTERVAL (64)
+#define BENCH_RPC_GUI_STREAM_MENU_ITEMS (5)
+
+static const u8x8_display_info_t bench_rpc_gui_stream_display_info = {
+    .tile_width = BENCH_RPC_GUI_STREAM_WIDTH / 8,
+    .tile_height = BENCH_RPC_GUI_STREAM_HEIGHT / 8,
+    .pixel_width = BENCH_RPC_GUI_STREAM_WIDTH,
+    .pixel_height = BENCH_RPC_GUI_STREAM_HEIGHT,
+};
+
+/* 3x5 digits, fonts are not part of the host build */
+static const uint8_t bench_rpc_gui_stream_digits[10][5] = {
+    {7, 5, 5, 5, 7},
+    {2, 3, 2, 2, 7},
+    {7, 4, 7, 1, 7},
+    {7, 4, 6, 4, 7},
+    {5, 5, 7, 4, 4},
+    {7, 1, 7, 4, 7},
+    {7, 1, 7, 5, 7},
+    {7, 4, 4, 2, 2},
+    {7, 5, 7, 5, 7},
+    {7, 5, 7, 4, 7},
+};
+
+static uint8_t
+    bench_rpc_gui_stream_display_cb(u8x8_t* u8x8, uint8_t msg, uint8_t arg_int, void* arg_ptr) {
+    UNUSED(arg_int);
+    UNUSED(arg_ptr);
+    if(msg == U8X8_MSG_DISPLAY_SETUP_MEMORY) {
+        u8x8_d_helper_display_setup_memory(u8x8, &bench_rpc_gui_stream_display_info);
+        return 1;
+    }
+    return 0;
+}
+
+static void bench_rpc_gui_stream_draw_number(u8g2_t* u8g2, uint8_t x, uint8_t y, uint32_t value) {
+    for(uint8_t i = 0; i < 2; i++) {
+        uint8_t digit = (i == 0) ? (value / 10) % 10 : value % 10;
+        u8g2_DrawXBM(u8g2, x + i * 4, y, 3, 5, bench_rpc_gui_stream_digits[digit]);
+    }
+}
+
+/* Words of a text line as boxes, glyph height */
+static void bench_rpc_gui_stream_draw_text(u8g2_t* u8g2, int16_t x, uint8_t y, uint8_t seed) {
+    for(uint8_t word = 0; word < 4; word++) {
+        uint8_t width = 8 + ((seed + word * 7) % 5) * 4;
+        if(x >= 0 && x + width < BENCH_RPC_GUI_STREAM_WIDTH) {
+            u8g2_DrawBox(u8g2, x, y, width, 7);
+        }
+        x += width + 4;
+    }
+}
+
+typedef void (*BenchRpcGuiStreamScene)(u8g2_t* u8g2, uint32_t frame);
+
+/* Menu with selection moving every 15 frames and a ticking clock */
+static void bench_rpc_gui_stream_scene_menu(u8g2_t* u8g2, uint32_t frame) {
+    uint8_t selected = (frame / 15) % BENCH_RPC_GUI_STREAM_MENU_ITEMS;
+    for(uint8_t i = 0; i < BENCH_RPC_GUI_STREAM_MENU_ITEMS; i++) {
+        uint8_t y = 13 + i * 10;
+        u8g2_SetDrawColor(u8g2, 1);
+        if(i == selected) {
+            u8g2_DrawBox(u8g2, 0, y, 120, 10);
+            u8g2_SetDrawColor(u8g2, 0);
+        }
+        bench_rpc_gui_stream_draw_text(u8g2, 4, y + 1, i);
+    }
+    u8g2_SetDrawColor(u8g2, 1);
+    bench_rpc_gui_stream_draw_number(u8g2, 100, 2, 12);
+    bench_rpc_gui_stream_draw_number(u8g2, 110, 2, (frame / BENCH_RPC_GUI_STREAM_FPS) % 60);
+}
+
+/* Scrolling text and progress bar, like long file names in archive */
+static void bench_rpc_gui_stream_scene_scroll(u8g2_t* u8g2, uint32_t frame) {
+    u8g2_DrawFrame(u8g2, 0, 0, BENCH_RPC_GUI_STREAM_WIDTH, BENCH_RPC_GUI_STREAM_HEIGHT);
+    bench_rpc_gui_stream_draw_text(u8g2, 4 - (frame % 120), 24, 3);
+    u8g2_DrawBox(u8g2, 0, 50, (frame * 2) % BENCH_RPC_GUI_STREAM_WIDTH, 6);
+}
+
+/* Bouncing sprite over moving background, worst case for delta frames */
+static void bench_rpc_gui_stream_scene_animation(u8g2_t* u8g2, uint32_t frame) {
+    for(uint8_t x = 0; x < BENCH_RPC_GUI_STREAM_WIDTH; x += 4) {
+        u8g2_DrawVLine(u8g2, x, (x * 7 + frame) % 32, 32);
+    }
+    uint8_t x = frame % 224;
+    if(x > 112) x = 224 - x;
+    u8g2_DrawDisc(u8g2, x + 8, 32, 8, U8G2_DRAW_ALL);
+}
+
+static const struct {
+    const char* name;
+    BenchRpcGuiStreamScene scene;
+    uint32_t frames;
+} bench_rpc_gui_stream_sessions[] = {
+    {"menu", bench_rpc_gui_stream_scene_menu, 300},
+    {"scroll", bench_rpc_gui_stream_scene_scroll, 300},
+    {"animation", bench_rpc_gui_stream_scene_animation, 300},
+};
+
+void bench_rpc_gui_stream(BenchReport* report, const BenchConfig* config) {
+    u8g2_t* u8g2 = malloc(sizeof(u8g2_t));
+    uint8_t* buffer = malloc(BENCH_RPC_GUI_STREAM_FRAME_SIZE);
+    u8g2_SetupDisplay(
+        u8g2,
+        bench_rpc_gui_stream_display_cb,
+        u8x8_cad_empty,
+        u8x8_dummy_cb,
+        u8x8_dummy_cb);
+    u8g2_SetupBuffer(
+        u8g2,
+        buffer,
+        BENCH_RPC_GUI_STREAM_HEIGHT / 8,
+        u8g2_ll_hvline_vertical_top_lsb,
+        U8G2_R0);
+
+    uint8_t* data = malloc(rpc_gui_stream_get_max_size(BENCH_RPC_GUI_STREAM_FRAME_SIZE));
+    FuriString* name = furi_string_alloc();
+    uint64_t raw_total = 0;
+    uint64_t delta_total = 0;
+
+    for(size_t i = 0; i < COUNT_OF(bench_rpc_gui_stream_sessions); i++) {
+        // Session is rendered once, encoding is what is measured
+        uint32_t frames = bench_rpc_gui_stream_sessions[i].frames;
+        uint8_t* session = malloc((size_t)frames * BENCH_RPC_GUI_STREAM_FRAME_SIZE);
+        uint32_t sent = 0;
+        for(uint32_t frame = 0; frame < frames; frame++) {
+            u8g2_ClearBuffer(u8g2);
+            bench_rpc_gui_stream_sessions[i].scene(u8g2, frame);
+            if(sent && !memcmp(
+                           &session[(size_t)(sent - 1) * BENCH_RPC_GUI_STREAM_FRAME_SIZE],
+                           buffer,
+                           BENCH_RPC_GUI_STREAM_FRAME_SIZE)) {
+                continue;
+            }
+            memcpy(
+                &session[(size_t)sent * BENCH_RPC_GUI_STREAM_FRAME_SIZE],
+                buffer,
+                BENCH_RPC_GUI_STREAM_FRAME_SIZE);
+            sent++;
+        }
+
+        RpcGuiStreamEncoder* encoder = rpc_gui_stream_encoder_alloc(
+            BENCH_RPC_GUI_STREAM_FRAME_SIZE, BENCH_RPC_GUI_STREAM_KEYFRAME_INTERVAL);
+        RpcGuiStreamDecoder* decoder =
+            rpc_gui_stream_decoder_alloc(BENCH_RPC_GUI_STREAM_FRAME_SIZE);
+        uint64_t delta_size = 0;
+        uint64_t start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            rpc_gui_stream_encoder_reset(encoder);
+            delta_size = 0;
+            for(uint32_t frame = 0; frame < sent; frame++) {
+                const uint8_t* source = &session[(size_t)frame * BENCH_RPC_GUI_STREAM_FRAME_SIZE];
+                size_t size = rpc_gui_stream_encode(encoder, source, data);
+                delta_size += size;
+                // Client must see every frame as it was drawn
+                const uint8_t* result = rpc_gui_stream_decode(decoder, data, size);
+                furi_check(result && !memcmp(result, source, BENCH_RPC_GUI_STREAM_FRAME_SIZE));
+            }
+        }
+        uint64_t elapsed = bench_time_ns() - start;
+        rpc_gui_stream_decoder_free(decoder);
+        rpc_gui_stream_encoder_free(encoder);
+        free(session);
+
+        const char* session_name = bench_rpc_gui_stream_sessions[i].name;
+        uint64_t session_ns = (uint64_t)frames * 1000000000 / BENCH_RPC_GUI_STREAM_FPS;
+        uint64_t raw_size = (uint64_t)sent * BENCH_RPC_GUI_STREAM_FRAME_SIZE;
+        furi_check(delta_size < raw_size);
+
+        furi_string_printf(name, "%s_raw", session_name);
+        bench_report_add(
+            report,
+            "rpc_gui_stream",
+            furi_string_get_cstr(name),
+            "bytes",
+            raw_size,
+            1,
+            session_ns,
+            0);
+        furi_string_printf(name, "%s_delta", session_name);
+        bench_report_add(
+            report,
+            "rpc_gui_stream",
+            furi_string_get_cstr(name),
+            "bytes",
+            delta_size,
+            1,
+            session_ns,
+            0);
+        furi_string_printf(name, "%s_encode", session_name);
+        bench_report_add(
+            report,
+            "rpc_gui_stream",
+            furi_string_get_cstr(name),
+            "frames",
+            (uint64_t)sent * config->iterations,
+            config->iterations,
+            elapsed,
+            0);
+
+        raw_total += raw_size;
+        delta_total += delta_size;
+    }
+
+    // Same bound as rpc_gui_stream unit test
+    furi_check(delta_total * 4 < raw_total, "delta stream is not at least 4 times smaller");
+
+    furi_string_free(name);
+    free(data);
+    free(buffer);
+    free(u8g2);
+}
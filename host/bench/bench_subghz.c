@@ -0,0 +1,286 @@
+#include "bench.h"
+
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_decode_raw_worker.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "BenchSubGhz"
+
+#define BENCH_SUBGHZ_CORPUS "subghz"
+#define BENCH_SUBGHZ_SUFFIX "_raw.sub"
+
+typedef struct {
+    uint32_t count;
+    FuriString** messages;
+    size_t capacity;
+    // Messages are serialized into it, NULL to count only
+    FlipperFormat* flipper_format;
+    SubGhzRadioPreset* preset;
+} BenchSubGhzDecoded;
+
+static void bench_subghz_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    BenchSubGhzDecoded* decoded = context;
+
+    if(decoded->flipper_format) {
+        // Whole message as saved to file: protocol, key, bit count and protocol fields
+        if(decoded->count == decoded->capacity) {
+            decoded->capacity = decoded->capacity ? decoded->capacity * 2 : 64;
+            decoded->messages =
+                realloc(decoded->messages, sizeof(FuriString*) * decoded->capacity);
+        }
+        Stream* stream = flipper_format_get_raw_stream(decoded->flipper_format);
+        stream_clean(stream);
+        subghz_protocol_decoder_base_serialize(
+            decoder_base, decoded->flipper_format, decoded->preset);
+        FuriString* message = furi_string_alloc();
+        FuriString* line = furi_string_alloc();
+        stream_rewind(stream);
+        while(stream_read_line(stream, line)) {
+            furi_string_cat(message, line);
+        }
+        furi_string_free(line);
+        decoded->messages[decoded->count] = message;
+    }
+    decoded->count++;
+    // Same as unit tests: every message is counted once
+    subghz_receiver_reset(receiver);
+}
+
+static void bench_subghz_decoded_reset(BenchSubGhzDecoded* decoded) {
+    for(size_t i = 0; decoded->messages && i < decoded->count; i++) {
+        furi_string_free(decoded->messages[i]);
+    }
+    decoded->count = 0;
+}
+
+/* RAW_Data is split over many lines, read all of them */
+bool bench_subghz_load_capture(const char* path, BenchSubGhzCapture* capture) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version;
+    bool result = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(!flipper_format_read_string(ff, "Protocol", temp_str) ||
+           furi_string_cmp_str(temp_str, "RAW")) {
+            break;
+        }
+
+        uint32_t count;
+        while(flipper_format_get_value_count(ff, "RAW_Data", &count) && count) {
+            if(capture->count + count > capture->capacity) {
+                capture->capacity = (capture->count + count) * 2;
+                capture->samples =
+                    realloc(capture->samples, sizeof(int32_t) * capture->capacity);
+            }
+            if(!flipper_format_read_int32(
+                   ff, "RAW_Data", capture->samples + capture->count, count)) {
+                break;
+            }
+            capture->count += count;
+        }
+        result = capture->count > 0;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+/* Reference for the decode worker: the old scene path, samples pulled from
+ * SubGhzFileEncoderWorker until the end of file. Waits for a slow reader are
+ * skipped instead of being fed to the receiver. */
+static void bench_subghz_replay(SubGhzReceiver* receiver, const char* path) {
+    SubGhzFileEncoderWorker* worker = subghz_file_encoder_worker_alloc();
+    furi_check(subghz_file_encoder_worker_start(worker, path, NULL));
+
+    subghz_receiver_reset(receiver);
+    while(true) {
+        LevelDuration level_duration = subghz_file_encoder_worker_get_level_duration(worker);
+        if(level_duration_is_reset(level_duration)) break;
+        if(level_duration_is_wait(level_duration)) {
+            furi_delay_ms(1);
+            continue;
+        }
+        subghz_receiver_decode(
+            receiver,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
+    }
+
+    subghz_file_encoder_worker_stop(worker);
+    subghz_file_encoder_worker_free(worker);
+}
+
+/* Decode worker must give the same messages as the reference, in the same order */
+static void bench_subghz_compare(
+    const char* name,
+    const BenchSubGhzDecoded* worker,
+    const BenchSubGhzDecoded* reference) {
+    for(size_t i = 0; i < MAX(worker->count, reference->count); i++) {
+        const char* worker_message =
+            i < worker->count ? furi_string_get_cstr(worker->messages[i]) : "(none)";
+        const char* reference_message =
+            i < reference->count ? furi_string_get_cstr(reference->messages[i]) : "(none)";
+        if(strcmp(worker_message, reference_message)) {
+            fprintf(
+                stderr,
+                "%s: message %zu of %" PRIu32 " differs\r\n"
+                "worker:\r\n%s\r\nreference:\r\n%s\r\n",
+                name,
+                i,
+                reference->count,
+                worker_message,
+                reference_message);
+            furi_crash("Decode worker mismatch");
+        }
+    }
+}
+
+void bench_subghz(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count =
+        bench_corpus_load(config, BENCH_SUBGHZ_CORPUS, BENCH_SUBGHZ_SUFFIX, &names);
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+
+    SubGhzRadioPreset preset = {
+        .name = furi_string_alloc_set("AM650"),
+        .frequency = 433920000,
+    };
+    BenchSubGhzDecoded decoded = {0};
+    BenchSubGhzDecoded reference = {
+        .flipper_format = flipper_format_string_alloc(),
+        .preset = &preset,
+    };
+    BenchSubGhzDecoded compared = reference;
+    compared.flipper_format = flipper_format_string_alloc();
+
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    SubGhzDecodeRawWorker* worker = subghz_decode_raw_worker_alloc();
+
+    FuriString* path = furi_string_alloc();
+    uint64_t total_samples = 0;
+    uint64_t total_elapsed = 0;
+    uint32_t total_decoded = 0;
+
+    for(size_t i = 0; i < name_count; i++) {
+        furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), BENCH_SUBGHZ_CORPUS, names[i]);
+
+        // File parsing is measured separately, it is flipper_format throughput
+        BenchSubGhzCapture capture = {0};
+        uint64_t start = bench_time_ns();
+        bool loaded = bench_subghz_load_capture(furi_string_get_cstr(path), &capture);
+        uint64_t elapsed = bench_time_ns() - start;
+        if(!loaded) {
+            FURI_LOG_W(TAG, "Skipped %s", names[i]);
+            free(capture.samples);
+            continue;
+        }
+
+        FuriString* name = furi_string_alloc_set(names[i]);
+        furi_string_left(name, furi_string_size(name) - strlen(BENCH_SUBGHZ_SUFFIX));
+        furi_string_cat_str(name, "_parse");
+        bench_report_add(
+            report, "subghz", furi_string_get_cstr(name), "samples", capture.count, 1, elapsed, 0);
+
+        subghz_receiver_set_rx_callback(receiver, bench_subghz_rx_callback, &decoded);
+        bench_subghz_decoded_reset(&decoded);
+        start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            subghz_receiver_reset(receiver);
+            for(size_t j = 0; j < capture.count; j++) {
+                int32_t sample = capture.samples[j];
+                subghz_receiver_decode(receiver, sample > 0, sample > 0 ? sample : -sample);
+            }
+        }
+        elapsed = bench_time_ns() - start;
+
+        furi_string_set(name, names[i]);
+        furi_string_left(name, furi_string_size(name) - strlen(BENCH_SUBGHZ_SUFFIX));
+        bench_report_add(
+            report,
+            "subghz",
+            furi_string_get_cstr(name),
+            "samples",
+            (uint64_t)capture.count * config->iterations,
+            config->iterations,
+            elapsed,
+            decoded.count);
+
+        total_samples += (uint64_t)capture.count * config->iterations;
+        total_elapsed += elapsed;
+        total_decoded += decoded.count;
+
+        // Decode worker: parsing included, messages must match the old scene path
+        subghz_receiver_set_rx_callback(receiver, bench_subghz_rx_callback, &reference);
+        bench_subghz_decoded_reset(&reference);
+        bench_subghz_replay(receiver, furi_string_get_cstr(path));
+
+        subghz_receiver_set_rx_callback(receiver, bench_subghz_rx_callback, &compared);
+        bench_subghz_decoded_reset(&compared);
+        furi_check(subghz_decode_raw_worker_decode(worker, receiver, furi_string_get_cstr(path)));
+        bench_subghz_compare(names[i], &compared, &reference);
+
+        subghz_receiver_set_rx_callback(receiver, bench_subghz_rx_callback, &decoded);
+        bench_subghz_decoded_reset(&decoded);
+        start = bench_time_ns();
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            furi_check(
+                subghz_decode_raw_worker_decode(worker, receiver, furi_string_get_cstr(path)));
+        }
+        elapsed = bench_time_ns() - start;
+        furi_check(decoded.count == reference.count * config->iterations);
+
+        furi_string_cat_str(name, "_worker");
+        bench_report_add(
+            report,
+            "subghz",
+            furi_string_get_cstr(name),
+            "samples",
+            (uint64_t)capture.count * config->iterations,
+            config->iterations,
+            elapsed,
+            decoded.count);
+
+        furi_string_free(name);
+        free(capture.samples);
+    }
+
+    if(name_count) {
+        bench_report_add(
+            report,
+            "subghz",
+            "all",
+            "samples",
+            total_samples,
+            config->iterations,
+            total_elapsed,
+            total_decoded);
+    }
+
+    bench_subghz_decoded_reset(&reference);
+    bench_subghz_decoded_reset(&compared);
+    free(reference.messages);
+    free(compared.messages);
+    flipper_format_free(reference.flipper_format);
+    flipper_format_free(compared.flipper_format);
+    furi_string_free(preset.name);
+    furi_string_free(path);
+    subghz_decode_raw_worker_free(worker);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+    bench_corpus_free(names, name_count);
+}
@@ -0,0 +1,338 @@
+#include "bench.h"
+
+#include <lib/subghz/blocks/math.h>
+#include <lib/subghz/blocks/pulse_cluster.h>
+#include <lib/subghz/protocols/bin_raw.h>
+
+#define TAG "BenchSubGhzBinRaw"
+
+/* BinRAW pulse width classification on captures it knows nothing about.
+ *
+ * Captures are split into bursts at long silence, as RSSI would do it on air.
+ * Batch is the classifier BinRAW used before: all durations are classified when the
+ * burst is over. Online is SubGhzBlockPulseCluster fed while the burst is received,
+ * only ranking is left for the end. TE is then taken from the classes the same way
+ * in both, and checked against the nominal TE of the protocol in the capture.
+ *
+ * Results: items - bursts, decoded - bursts with right TE, elapsed_ns - work done
+ * at the end of burst. Decoder case: items - pulses, decoded - BinRAW messages,
+ * elapsed_ns - whole decoder run. */
+
+#define BENCH_BIN_RAW_CORPUS "subghz"
+#define BENCH_BIN_RAW_SUFFIX "_raw.sub"
+
+// Same as bin_raw.c
+#define BENCH_BIN_RAW_BUF_SIZE (2048)
+#define BENCH_BIN_RAW_MIN_COUNT (128)
+#define BENCH_BIN_RAW_CLASSES (20)
+#define BENCH_BIN_RAW_CLASSIFY_COUNT (512)
+#define BENCH_BIN_RAW_CLASSIFY_SKIP_END (100)
+#define BENCH_BIN_RAW_TE_MIN_COUNT (40)
+
+#define BENCH_BIN_RAW_SILENCE_US (30000)
+#define BENCH_BIN_RAW_RSSI_ON (-40.0f)
+#define BENCH_BIN_RAW_RSSI_OFF (-120.0f)
+
+typedef struct {
+    const char* name;
+    uint32_t te;
+} BenchBinRawNominal;
+
+// te_short of the protocol in capture, bursts of other captures are never right
+static const BenchBinRawNominal bench_bin_raw_nominal[] = {
+    {"alutech_at_4n", 400},
+    {"ansonic", 555},
+    {"bett", 340},
+    {"came_atomo", 600},
+    {"came", 320},
+    {"came_twee", 500},
+    {"clemsa", 385},
+    {"doitrand", 400},
+    {"doorhan", 400},
+    {"dooya", 366},
+    {"faac_slh", 255},
+    {"gate_tx", 350},
+    {"holtek_ht12x", 320},
+    {"holtek", 430},
+    {"honeywell_wdb", 160},
+    {"hormann_hsm", 500},
+    {"ido_117_111", 450},
+    {"intertechno_v3", 275},
+    {"kia_seed", 250},
+    {"kinggates_stylo4k", 400},
+    {"linear_delta3", 500},
+    {"linear", 500},
+    {"magellan", 200},
+    {"marantec", 1000},
+    {"megacode", 1000},
+    {"nero_radio", 200},
+    {"nero_sketch", 330},
+    {"nice_flo", 700},
+    {"nice_flor_s", 500},
+    {"nice_one", 500},
+    {"phoenix_v2", 427},
+    {"power_smart", 225},
+    {"princeton", 390},
+    {"security_pls_1_0", 500},
+    {"security_pls_2_0", 250},
+    {"smc5326", 300},
+    {"somfy_keytis", 640},
+    {"somfy_telis", 640},
+};
+
+typedef struct {
+    uint32_t bursts;
+    uint32_t correct;
+    uint64_t elapsed;
+} BenchBinRawStats;
+
+static uint32_t bench_bin_raw_get_nominal(const char* name) {
+    for(size_t i = 0; i < COUNT_OF(bench_bin_raw_nominal); i++) {
+        if(!strcmp(bench_bin_raw_nominal[i].name, name)) return bench_bin_raw_nominal[i].te;
+    }
+    return 0;
+}
+
+/* BinRAW may take a fraction of the short pulse as TE */
+static bool bench_bin_raw_is_te_correct(uint32_t te, uint32_t nominal) {
+    if(!te || !nominal) return false;
+    uint32_t k = (nominal + te / 2) / te;
+    if(k < 1 || k > 4) return false;
+    return DURATION_DIFF(nominal, k * te) < nominal / 5;
+}
+
+/** Batch classifier, as it was in bin_raw.c, ranked by count */
+static void bench_bin_raw_classify_batch(
+    const int32_t* data_raw,
+    size_t data_raw_ind,
+    SubGhzBlockPulseClass* classes) {
+    memset(classes, 0x00, sizeof(SubGhzBlockPulseClass) * BENCH_BIN_RAW_CLASSES);
+
+    size_t ind = BENCH_BIN_RAW_CLASSIFY_COUNT;
+    if(data_raw_ind < BENCH_BIN_RAW_CLASSIFY_COUNT) {
+        ind = data_raw_ind - BENCH_BIN_RAW_CLASSIFY_SKIP_END;
+    }
+
+    for(size_t i = 0; i < ind; i++) {
+        float duration = (float)(abs(data_raw[i]));
+        for(size_t k = 0; k < BENCH_BIN_RAW_CLASSES; k++) {
+            if(classes[k].count == 0) {
+                classes[k].duration = duration;
+                classes[k].count++;
+                break;
+            } else if(DURATION_DIFF(duration, classes[k].duration) < (classes[k].duration / 4)) {
+                classes[k].duration += (duration - classes[k].duration) * 0.05f;
+                classes[k].count++;
+                break;
+            }
+        }
+    }
+
+    bool swap = true;
+    while(swap) {
+        swap = false;
+        for(size_t i = 1; i < BENCH_BIN_RAW_CLASSES; i++) {
+            if(classes[i].count > classes[i - 1].count) {
+                uint32_t data = classes[i - 1].duration;
+                uint32_t count = classes[i - 1].count;
+                classes[i - 1] = classes[i];
+                classes[i].duration = data;
+                classes[i].count = count;
+                swap = true;
+            }
+        }
+    }
+}
+
+/** TE from ranked classes, as in subghz_protocol_bin_raw_check_remote_controller */
+static uint32_t bench_bin_raw_get_te(SubGhzBlockPulseClass* classes) {
+    if((classes[0].count > BENCH_BIN_RAW_TE_MIN_COUNT) && (classes[1].count == 0)) {
+        return (uint32_t)classes[0].duration;
+    }
+    if((classes[0].count < BENCH_BIN_RAW_TE_MIN_COUNT) ||
+       (classes[1].count < (BENCH_BIN_RAW_TE_MIN_COUNT >> 1))) {
+        return 0;
+    }
+    if(classes[0].duration > classes[1].duration) {
+        classes[0].duration = classes[1].duration;
+    }
+    for(uint8_t k = 1; k < 5; k++) {
+        float delta = (classes[1].duration / (classes[0].duration / k));
+        delta -= (uint32_t)delta;
+        if((delta < 0.20f) || (delta > 0.80f)) return (uint32_t)classes[0].duration / k;
+    }
+    return 0;
+}
+
+static void bench_bin_raw_burst(
+    const int32_t* samples,
+    size_t count,
+    uint32_t nominal,
+    SubGhzBlockPulseCluster* cluster,
+    BenchBinRawStats* batch,
+    BenchBinRawStats* online) {
+    SubGhzBlockPulseClass classes[BENCH_BIN_RAW_CLASSES];
+    count = MIN(count, (size_t)BENCH_BIN_RAW_BUF_SIZE);
+
+    uint64_t start = bench_time_ns();
+    bench_bin_raw_classify_batch(samples, count, classes);
+    batch->elapsed += bench_time_ns() - start;
+    batch->bursts++;
+    if(bench_bin_raw_is_te_correct(bench_bin_raw_get_te(classes), nominal)) batch->correct++;
+
+    // Feed as subghz_protocol_decoder_bin_raw_feed does, not timed: spread over the burst
+    subghz_protocol_blocks_pulse_cluster_reset(cluster);
+    for(size_t i = BENCH_BIN_RAW_CLASSIFY_SKIP_END; i < count; i++) {
+        if(i - BENCH_BIN_RAW_CLASSIFY_SKIP_END == BENCH_BIN_RAW_CLASSIFY_COUNT) break;
+        subghz_protocol_blocks_pulse_cluster_add(
+            cluster, abs(samples[i - BENCH_BIN_RAW_CLASSIFY_SKIP_END]));
+    }
+
+    start = bench_time_ns();
+    while(count >= BENCH_BIN_RAW_CLASSIFY_COUNT &&
+          cluster->pulse_count < BENCH_BIN_RAW_CLASSIFY_COUNT) {
+        subghz_protocol_blocks_pulse_cluster_add(cluster, abs(samples[cluster->pulse_count]));
+    }
+    memset(classes, 0x00, sizeof(classes));
+    subghz_protocol_blocks_pulse_cluster_get_ranked(cluster, classes);
+    online->elapsed += bench_time_ns() - start;
+    online->bursts++;
+    if(bench_bin_raw_is_te_correct(bench_bin_raw_get_te(classes), nominal)) online->correct++;
+}
+
+static void bench_bin_raw_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
+    UNUSED(decoder_base);
+    uint32_t* decoded = context;
+    (*decoded)++;
+}
+
+/** Whole BinRAW decoder, RSSI goes up and down around every burst */
+static void bench_bin_raw_decode(
+    void* decoder,
+    const BenchSubGhzCapture* capture,
+    uint64_t* pulses) {
+    bool receiving = false;
+    for(size_t i = 0; i < capture->count; i++) {
+        int32_t sample = capture->samples[i];
+        uint32_t duration = abs(sample);
+        if(duration >= BENCH_BIN_RAW_SILENCE_US) {
+            if(receiving) {
+                subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BENCH_BIN_RAW_RSSI_OFF);
+                receiving = false;
+            }
+            continue;
+        }
+        if(!receiving) {
+            subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BENCH_BIN_RAW_RSSI_ON);
+            receiving = true;
+        }
+        subghz_protocol_decoder_bin_raw_feed(decoder, sample > 0, duration);
+        (*pulses)++;
+    }
+    if(receiving) {
+        subghz_protocol_decoder_bin_raw_data_input_rssi(decoder, BENCH_BIN_RAW_RSSI_OFF);
+    }
+}
+
+static void bench_bin_raw_add(
+    BenchReport* report,
+    const char* name,
+    const char* method,
+    const BenchBinRawStats* stats,
+    uint32_t iterations) {
+    char case_name[64];
+    snprintf(case_name, sizeof(case_name), "%s_%s", name, method);
+    bench_report_add(
+        report,
+        "subghz_bin_raw",
+        case_name,
+        "bursts",
+        stats->bursts,
+        iterations,
+        stats->elapsed,
+        stats->correct);
+}
+
+void bench_subghz_bin_raw(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count =
+        bench_corpus_load(config, BENCH_BIN_RAW_CORPUS, BENCH_BIN_RAW_SUFFIX, &names);
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    SubGhzBlockPulseCluster cluster;
+    subghz_protocol_blocks_pulse_cluster_init(&cluster, BENCH_BIN_RAW_CLASSES, 4, 0.05f);
+    BenchBinRawStats batch_total = {0}, online_total = {0};
+
+    void* decoder = subghz_protocol_decoder_bin_raw_alloc(NULL);
+    uint32_t decoded = 0;
+    subghz_protocol_decoder_base_set_decoder_callback(
+        decoder, bench_bin_raw_rx_callback, &decoded);
+    uint64_t decoder_pulses = 0;
+    uint64_t decoder_elapsed = 0;
+
+    for(size_t i = 0; i < name_count; i++) {
+        furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), BENCH_BIN_RAW_CORPUS, names[i]);
+        BenchSubGhzCapture capture = {0};
+        if(!bench_subghz_load_capture(furi_string_get_cstr(path), &capture)) {
+            FURI_LOG_W(TAG, "Skipped %s", names[i]);
+            free(capture.samples);
+            continue;
+        }
+        furi_string_set(name, names[i]);
+        furi_string_left(name, furi_string_size(name) - strlen(BENCH_BIN_RAW_SUFFIX));
+        uint32_t nominal = bench_bin_raw_get_nominal(furi_string_get_cstr(name));
+
+        BenchBinRawStats batch = {0}, online = {0};
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            size_t begin = 0;
+            for(size_t j = 0; j <= capture.count; j++) {
+                if(j < capture.count && abs(capture.samples[j]) < BENCH_BIN_RAW_SILENCE_US) {
+                    continue;
+                }
+                if(j - begin >= BENCH_BIN_RAW_MIN_COUNT) {
+                    bench_bin_raw_burst(
+                        capture.samples + begin, j - begin, nominal, &cluster, &batch, &online);
+                }
+                begin = j + 1;
+            }
+
+            uint64_t start = bench_time_ns();
+            bench_bin_raw_decode(decoder, &capture, &decoder_pulses);
+            decoder_elapsed += bench_time_ns() - start;
+        }
+
+        if(batch.bursts) {
+            bench_bin_raw_add(
+                report, furi_string_get_cstr(name), "batch", &batch, config->iterations);
+            bench_bin_raw_add(
+                report, furi_string_get_cstr(name), "online", &online, config->iterations);
+        }
+        batch_total.bursts += batch.bursts;
+        batch_total.correct += batch.correct;
+        batch_total.elapsed += batch.elapsed;
+        online_total.bursts += online.bursts;
+        online_total.correct += online.correct;
+        online_total.elapsed += online.elapsed;
+        free(capture.samples);
+    }
+
+    if(name_count) {
+        bench_bin_raw_add(report, "all", "batch", &batch_total, config->iterations);
+        bench_bin_raw_add(report, "all", "online", &online_total, config->iterations);
+        bench_report_add(
+            report,
+            "subghz_bin_raw",
+            "all_decoder",
+            "pulses",
+            decoder_pulses,
+            config->iterations,
+            decoder_elapsed,
+            decoded);
+    }
+
+    subghz_protocol_decoder_bin_raw_free(decoder);
+    furi_string_free(name);
+    furi_string_free(path);
+    bench_corpus_free(names, name_count);
+}
@@ -0,0 +1,391 @@
+#include "bench.h"
+
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_worker.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/devices/file_replay/file_replay_interconnect.h>
+#include <helpers/subghz_hopper.h>
+#include <helpers/subghz_threshold_rssi.h>
+
+#include <sys/resource.h>
+
+#define TAG "BenchSubGhzFileReplay"
+
+/* Whole receive stack on the file_replay device: device thread plays a RAW
+ * capture in real time, SubGhzWorker thread glues edges and decodes them.
+ *
+ * Latency cases: every message of the capture decoded directly must come out.
+ * Latency is from delivery of the level that completes a message to the
+ * decoder callback. Worker passes a level on when the next one is delivered, so
+ * latency includes the level after the message, usually a gap.
+ * Results: items - messages, elapsed_ns - all latencies. Max case has the worst
+ * one. Load cases: items is CPU time of all threads per mille of wall time, not
+ * a rate.
+ *
+ * Hopper case: capture is heard on one frequency only. Loop of receiver scene
+ * updates hopper and RSSI threshold on device RSSI and retunes, like
+ * subghz_txrx_hopper_update. Messages must be decoded, the frequency held
+ * while heard, threshold must follow RSSI. Results: items - ticks, decoded -
+ * messages.
+ *
+ * Air time is wall time, so every case runs once regardless of iterations. */
+
+#define BENCH_FILE_REPLAY_CORPUS "subghz"
+#define BENCH_FILE_REPLAY_SUFFIX "_raw.sub"
+
+// Short captures, ten seconds of air time in all
+static const char* const bench_file_replay_names[] = {
+    "princeton",
+    "came",
+    "nice_flor_s",
+    // Densest one, ~4 edges per ms
+    "kia_seed",
+};
+
+#define BENCH_FILE_REPLAY_HOPPER_NAME "princeton"
+#define BENCH_FILE_REPLAY_HOPPER_FREQUENCY (433920000)
+// Same as receiver scene tick
+#define BENCH_FILE_REPLAY_TICK_MS (100)
+#define BENCH_FILE_REPLAY_THRESHOLD (-70.0f)
+// Same as hopper, RSSI is not read while holding
+#define BENCH_FILE_REPLAY_RSSI_HOLDING (-127.0f)
+// Twice SubGhzWorker drain timeout, worker takes the rest of delivered edges
+#define BENCH_FILE_REPLAY_DRAIN_MS (20)
+
+// Hopper list of assets/resources/subghz/assets/setting_user.txt
+static const uint32_t bench_file_replay_frequency[] = {
+    310000000,
+    313000000,
+    315000000,
+    390000000,
+    433920000,
+    434420000,
+    868350000,
+};
+
+typedef struct {
+    uint64_t air_end_us;
+    uint64_t time_ns;
+} BenchFileReplayEdge;
+
+typedef struct {
+    SubGhzWorker* worker;
+    SubGhzReceiver* receiver;
+    // Hits are counted if set
+    SubGhzHopper* hopper;
+
+    // Delivered levels, latency is measured if set. Written by device thread
+    BenchFileReplayEdge* edges;
+    size_t edges_capacity;
+    size_t edge_count;
+    uint64_t delivered_us;
+
+    // Written by worker thread
+    uint64_t decoded_us;
+    size_t edge_index;
+    uint32_t messages;
+    uint64_t latency_ns;
+    uint64_t latency_max_ns;
+} BenchFileReplay;
+
+static void bench_file_replay_capture_callback(bool level, uint32_t duration, void* context) {
+    BenchFileReplay* instance = context;
+
+    if(instance->edges) {
+        size_t index = instance->edge_count;
+        furi_check(index < instance->edges_capacity);
+        instance->delivered_us += duration;
+        instance->edges[index] = (BenchFileReplayEdge){
+            .air_end_us = instance->delivered_us,
+            .time_ns = bench_time_ns(),
+        };
+        __atomic_store_n(&instance->edge_count, index + 1, __ATOMIC_RELEASE);
+    }
+
+    subghz_worker_rx_callback(level, duration, instance->worker);
+}
+
+static void bench_file_replay_pair_callback(void* context, bool level, uint32_t duration) {
+    BenchFileReplay* instance = context;
+    // Worker glues whole levels, so passed levels end where delivered ones do
+    instance->decoded_us += duration;
+    subghz_receiver_decode(instance->receiver, level, duration);
+}
+
+static void bench_file_replay_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(decoder_base);
+    BenchFileReplay* instance = context;
+    uint64_t now = bench_time_ns();
+
+    if(instance->edges) {
+        size_t count = __atomic_load_n(&instance->edge_count, __ATOMIC_ACQUIRE);
+        while(instance->edge_index < count &&
+              instance->edges[instance->edge_index].air_end_us < instance->decoded_us) {
+            instance->edge_index++;
+        }
+        furi_check(instance->edge_index < count);
+        const BenchFileReplayEdge* edge = &instance->edges[instance->edge_index];
+        furi_check(edge->air_end_us == instance->decoded_us);
+
+        uint64_t latency = now - edge->time_ns;
+        instance->latency_ns += latency;
+        instance->latency_max_ns = MAX(instance->latency_max_ns, latency);
+    }
+    if(instance->hopper) subghz_hopper_add_hit(instance->hopper);
+    instance->messages++;
+
+    // Same as unit tests: every message is counted once
+    subghz_receiver_reset(receiver);
+}
+
+static uint64_t bench_file_replay_get_cpu_ns(void) {
+    struct rusage usage;
+    furi_check(getrusage(RUSAGE_SELF, &usage) == 0);
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000 +
+           (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000;
+}
+
+static BenchFileReplay* bench_file_replay_alloc(SubGhzEnvironment* environment) {
+    BenchFileReplay* instance = malloc(sizeof(BenchFileReplay));
+
+    instance->receiver = subghz_receiver_alloc_init(environment);
+    subghz_receiver_set_filter(instance->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(
+        instance->receiver, bench_file_replay_rx_callback, instance);
+
+    instance->worker = subghz_worker_alloc();
+    subghz_worker_set_pair_callback(instance->worker, bench_file_replay_pair_callback);
+    subghz_worker_set_context(instance->worker, instance);
+    return instance;
+}
+
+static void bench_file_replay_free(BenchFileReplay* instance) {
+    subghz_worker_free(instance->worker);
+    subghz_receiver_free(instance->receiver);
+    free(instance->edges);
+    free(instance);
+}
+
+/* Same order as subghz_txrx_rx and subghz_txrx_rx_end */
+static void bench_file_replay_rx_start(BenchFileReplay* instance, uint32_t frequency) {
+    const SubGhzDeviceInterconnect* radio = subghz_device_file_replay.interconnect;
+    radio->set_frequency(frequency);
+    subghz_receiver_reset(instance->receiver);
+    subghz_worker_start(instance->worker);
+    radio->start_async_rx(bench_file_replay_capture_callback, instance);
+}
+
+static void bench_file_replay_rx_end(BenchFileReplay* instance) {
+    const SubGhzDeviceInterconnect* radio = subghz_device_file_replay.interconnect;
+    radio->stop_async_rx();
+    subghz_worker_stop(instance->worker);
+}
+
+static void bench_file_replay_run_latency(
+    BenchReport* report,
+    SubGhzEnvironment* environment,
+    const char* name,
+    const char* path,
+    const BenchSubGhzCapture* capture) {
+    BenchFileReplay* instance = bench_file_replay_alloc(environment);
+    for(size_t i = 0; i < capture->count; i++) {
+        int32_t sample = capture->samples[i];
+        subghz_receiver_decode(instance->receiver, sample > 0, sample > 0 ? sample : -sample);
+    }
+    uint32_t expected = instance->messages;
+    instance->messages = 0;
+
+    instance->edges = malloc(sizeof(BenchFileReplayEdge) * capture->count);
+    instance->edges_capacity = capture->count;
+    subghz_device_file_replay_set_source(path, SubGhzDeviceFileReplayPacingRealtime);
+
+    uint64_t cpu = bench_file_replay_get_cpu_ns();
+    uint64_t start = bench_time_ns();
+    bench_file_replay_rx_start(instance, BENCH_FILE_REPLAY_HOPPER_FREQUENCY);
+    while(!subghz_device_file_replay_is_rx_complete()) {
+        furi_delay_ms(BENCH_FILE_REPLAY_TICK_MS);
+    }
+    furi_delay_ms(BENCH_FILE_REPLAY_DRAIN_MS);
+    bench_file_replay_rx_end(instance);
+    uint64_t elapsed = bench_time_ns() - start;
+    cpu = bench_file_replay_get_cpu_ns() - cpu;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %" PRIu32 " of %" PRIu32 " messages, %zu of %zu levels",
+        name,
+        instance->messages,
+        expected,
+        instance->edge_count,
+        capture->count);
+    furi_check(instance->messages && instance->messages == expected);
+    furi_check(!subghz_worker_get_overrun_count(instance->worker));
+
+    FuriString* case_name = furi_string_alloc_printf("%s_latency", name);
+    bench_report_add(
+        report,
+        "subghz_file_replay",
+        furi_string_get_cstr(case_name),
+        "messages",
+        instance->messages,
+        1,
+        instance->latency_ns,
+        instance->messages);
+    furi_string_printf(case_name, "%s_latency_max", name);
+    bench_report_add(
+        report,
+        "subghz_file_replay",
+        furi_string_get_cstr(case_name),
+        "messages",
+        1,
+        1,
+        instance->latency_max_ns,
+        0);
+    furi_string_printf(case_name, "%s_load", name);
+    bench_report_add(
+        report,
+        "subghz_file_replay",
+        furi_string_get_cstr(case_name),
+        "permille",
+        cpu * 1000 / elapsed,
+        1,
+        0,
+        0);
+    furi_string_free(case_name);
+
+    bench_file_replay_free(instance);
+}
+
+static void bench_file_replay_run_hopper(
+    BenchReport* report,
+    SubGhzEnvironment* environment,
+    const char* path,
+    uint64_t air_us) {
+    BenchFileReplay* instance = bench_file_replay_alloc(environment);
+    instance->hopper = subghz_hopper_alloc(COUNT_OF(bench_file_replay_frequency));
+    size_t source_index = 0;
+    for(size_t i = 0; i < COUNT_OF(bench_file_replay_frequency); i++) {
+        subghz_hopper_add_frequency(instance->hopper, bench_file_replay_frequency[i], false);
+        if(bench_file_replay_frequency[i] == BENCH_FILE_REPLAY_HOPPER_FREQUENCY) {
+            source_index = i;
+        }
+    }
+    SubGhzThresholdRssi* threshold = subghz_threshold_rssi_alloc();
+    subghz_threshold_rssi_set(threshold, BENCH_FILE_REPLAY_THRESHOLD);
+
+    subghz_device_file_replay_set_source(path, SubGhzDeviceFileReplayPacingRealtime);
+    subghz_device_file_replay_set_source_frequency(BENCH_FILE_REPLAY_HOPPER_FREQUENCY);
+    const SubGhzDeviceInterconnect* radio = subghz_device_file_replay.interconnect;
+
+    uint32_t ticks = 0;
+    uint32_t held = 0;
+    uint32_t above_heard = 0;
+    uint32_t below_elsewhere = 0;
+    uint64_t start = bench_time_ns();
+    bench_file_replay_rx_start(instance, subghz_hopper_get_current_frequency(instance->hopper));
+
+    while(bench_time_ns() - start < air_us * 1000) {
+        furi_delay_ms(BENCH_FILE_REPLAY_TICK_MS);
+        ticks++;
+
+        bool heard = subghz_hopper_get_current_frequency(instance->hopper) ==
+                     BENCH_FILE_REPLAY_HOPPER_FREQUENCY;
+        float rssi = radio->get_rssi();
+        SubGhzThresholdRssiData rssi_data = subghz_threshold_get_rssi_data(threshold, rssi);
+        if(heard && rssi_data.is_above) above_heard++;
+        if(!heard && !rssi_data.is_above) below_elsewhere++;
+
+        if(subghz_hopper_is_holding(instance->hopper)) {
+            rssi = BENCH_FILE_REPLAY_RSSI_HOLDING;
+            if(heard) held++;
+        }
+        if(subghz_hopper_update(instance->hopper, rssi)) {
+            bench_file_replay_rx_end(instance);
+            bench_file_replay_rx_start(
+                instance, subghz_hopper_get_current_frequency(instance->hopper));
+        }
+    }
+    bench_file_replay_rx_end(instance);
+    uint64_t elapsed = bench_time_ns() - start;
+
+    uint32_t hits = 0;
+    for(size_t i = 0; i < COUNT_OF(bench_file_replay_frequency); i++) {
+        hits += subghz_hopper_get_hit_count(instance->hopper, i);
+    }
+    FURI_LOG_I(
+        TAG,
+        "Hopper: %" PRIu32 " messages, %" PRIu32 " ticks held, %" PRIu32 " above threshold",
+        instance->messages,
+        held,
+        above_heard);
+    furi_check(instance->messages, "Nothing decoded");
+    furi_check(hits == instance->messages);
+    furi_check(subghz_hopper_get_hit_count(instance->hopper, source_index));
+    furi_check(held, "Heard frequency is not held");
+    furi_check(above_heard, "Threshold missed the signal");
+    furi_check(below_elsewhere, "Threshold missed the noise");
+
+    bench_report_add(
+        report,
+        "subghz_file_replay",
+        "hopper_threshold",
+        "ticks",
+        ticks,
+        1,
+        elapsed,
+        instance->messages);
+
+    subghz_device_file_replay_set_source_frequency(0);
+    subghz_threshold_rssi_free(threshold);
+    subghz_hopper_free(instance->hopper);
+    bench_file_replay_free(instance);
+}
+
+void bench_subghz_file_replay(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count =
+        bench_corpus_load(config, BENCH_FILE_REPLAY_CORPUS, BENCH_FILE_REPLAY_SUFFIX, &names);
+    bench_corpus_free(names, name_count);
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    FuriString* path = furi_string_alloc();
+
+    for(size_t i = 0; i < COUNT_OF(bench_file_replay_names); i++) {
+        furi_string_printf(
+            path,
+            EXT_PATH("unit_tests/%s/%s%s"),
+            BENCH_FILE_REPLAY_CORPUS,
+            bench_file_replay_names[i],
+            BENCH_FILE_REPLAY_SUFFIX);
+        BenchSubGhzCapture capture = {0};
+        if(!bench_subghz_load_capture(furi_string_get_cstr(path), &capture)) {
+            FURI_LOG_W(TAG, "Skipped %s", bench_file_replay_names[i]);
+            free(capture.samples);
+            continue;
+        }
+
+        bench_file_replay_run_latency(
+            report,
+            environment,
+            bench_file_replay_names[i],
+            furi_string_get_cstr(path),
+            &capture);
+
+        if(!strcmp(bench_file_replay_names[i], BENCH_FILE_REPLAY_HOPPER_NAME)) {
+            uint64_t air_us = 0;
+            for(size_t j = 0; j < capture.count; j++) {
+                air_us += capture.samples[j] > 0 ? capture.samples[j] : -capture.samples[j];
+            }
+            bench_file_replay_run_hopper(report, environment, furi_string_get_cstr(path), air_us);
+        }
+        free(capture.samples);
+    }
+
+    subghz_device_file_replay_set_source(NULL, SubGhzDeviceFileReplayPacingRealtime);
+    furi_string_free(path);
+    subghz_environment_free(environment);
+}
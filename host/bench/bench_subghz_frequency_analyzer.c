@@ -0,0 +1,225 @@
+#include "bench.h"
+
+#include <helpers/subghz_frequency_analyzer_sweep.h>
+
+#include <math.h>
+
+/* Frequency analyzer sweep against a simulated radio.
+ *
+ * Time is virtual: tune and RSSI read cost what they cost on CC1101, waits advance
+ * the clock. Transmitters send single bursts, most of them on a few popular
+ * frequencies. A burst is detected when a cycle reports fine frequency over trigger
+ * close to the transmitter while the burst is on air.
+ *
+ * Results: items - bursts, decoded - bursts detected, elapsed_ns - simulated time
+ * from burst start to detection, summed over detected bursts. */
+
+#define BENCH_FA_TUNE_US (750)
+#define BENCH_FA_RSSI_US (20)
+// Worker sleeps between cycles
+#define BENCH_FA_CYCLE_DELAY_US (10000)
+
+#define BENCH_FA_NOISE_DB (-100.0f)
+#define BENCH_FA_SIGNAL_DB (-45.0f)
+// RSSI right after retune, settles exponentially to the real value
+#define BENCH_FA_SETTLE_FROM_DB (-110.0f)
+#define BENCH_FA_SETTLE_TAU_US (300.0f)
+// Attenuation slope outside of the filter: wide filter sees neighbours better
+#define BENCH_FA_SLOPE_COARSE_DB_PER_MHZ (40.0f)
+#define BENCH_FA_SLOPE_FINE_DB_PER_MHZ (150.0f)
+
+#define BENCH_FA_TRIGGER_DB (-80.0f)
+#define BENCH_FA_FINE_TOLERANCE (40000)
+#define BENCH_FA_TRIALS (50)
+// Idle air between bursts
+#define BENCH_FA_GAP_MAX_US (300000)
+
+static const uint32_t bench_fa_frequency[] = {
+    300000000, 302757000, 303875000, 304250000, 307000000, 307500000, 307800000,
+    309000000, 310000000, 312000000, 312100000, 313000000, 313850000, 314000000,
+    314350000, 314980000, 315000000, 318000000, 330000000, 345000000, 348000000,
+    350000000, 387000000, 390000000, 418000000, 430000000, 431000000, 431500000,
+    433075000, 433220000, 433420000, 433657070, 433889000, 433920000, 434075000,
+    434176948, 434390000, 434420000, 434775000, 438900000, 440175000, 779000000,
+    868350000, 868400000, 868800000, 868950000, 906400000, 915000000, 925000000,
+    928000000,
+};
+
+static const uint32_t bench_fa_popular[] = {433920000, 315000000, 868350000};
+
+static const uint32_t bench_fa_burst_ms[] = {20, 50, 100, 200};
+
+typedef struct {
+    uint64_t now_us;
+    uint32_t random;
+
+    bool fine;
+    uint32_t tuned;
+    uint64_t tuned_us;
+
+    uint32_t burst_frequency;
+    uint64_t burst_start_us;
+    uint64_t burst_end_us;
+} BenchFaModel;
+
+static uint32_t bench_fa_random(BenchFaModel* model) {
+    model->random = model->random * 1103515245 + 12345;
+    return model->random >> 8;
+}
+
+static void bench_fa_set_fine(void* context, bool fine) {
+    BenchFaModel* model = context;
+    model->fine = fine;
+}
+
+static bool bench_fa_is_frequency_valid(void* context, uint32_t frequency) {
+    UNUSED(context);
+    // CC1101 bands
+    return (frequency >= 281000000 && frequency <= 361000000) ||
+           (frequency >= 378000000 && frequency <= 481000000) ||
+           (frequency >= 749000000 && frequency <= 962000000);
+}
+
+static uint32_t bench_fa_tune(void* context, uint32_t frequency) {
+    BenchFaModel* model = context;
+    model->now_us += BENCH_FA_TUNE_US;
+    model->tuned = frequency;
+    model->tuned_us = model->now_us;
+    return frequency;
+}
+
+static float bench_fa_get_rssi(void* context) {
+    BenchFaModel* model = context;
+    model->now_us += BENCH_FA_RSSI_US;
+
+    float level = BENCH_FA_NOISE_DB;
+    if(model->now_us >= model->burst_start_us && model->now_us < model->burst_end_us) {
+        float offset_mhz = fabsf((float)model->tuned - (float)model->burst_frequency) / 1e6f;
+        float slope = model->fine ? BENCH_FA_SLOPE_FINE_DB_PER_MHZ :
+                                    BENCH_FA_SLOPE_COARSE_DB_PER_MHZ;
+        level = MAX(level, BENCH_FA_SIGNAL_DB - offset_mhz * slope);
+    }
+    // +-0.5 dB
+    level += (float)(bench_fa_random(model) % 1000) / 1000.0f - 0.5f;
+
+    float settle = expf(-(float)(model->now_us - model->tuned_us) / BENCH_FA_SETTLE_TAU_US);
+    return level + (BENCH_FA_SETTLE_FROM_DB - level) * settle;
+}
+
+static void bench_fa_delay_us(void* context, uint32_t us) {
+    BenchFaModel* model = context;
+    model->now_us += us;
+}
+
+static const SubGhzFrequencyAnalyzerSweepRadio bench_fa_radio = {
+    .set_fine = bench_fa_set_fine,
+    .is_frequency_valid = bench_fa_is_frequency_valid,
+    .tune = bench_fa_tune,
+    .get_rssi = bench_fa_get_rssi,
+    .delay_us = bench_fa_delay_us,
+};
+
+static SubGhzFrequencyAnalyzerSweep* bench_fa_sweep_alloc(BenchFaModel* model, bool adaptive) {
+    SubGhzFrequencyAnalyzerSweep* sweep = subghz_frequency_analyzer_sweep_alloc(
+        &bench_fa_radio, model, COUNT_OF(bench_fa_frequency));
+    for(size_t i = 0; i < COUNT_OF(bench_fa_frequency); i++) {
+        subghz_frequency_analyzer_sweep_add_frequency(sweep, bench_fa_frequency[i]);
+    }
+    subghz_frequency_analyzer_sweep_set_adaptive(sweep, adaptive);
+    return sweep;
+}
+
+/** One worker cycle, as in subghz_frequency_analyzer_worker_thread */
+static void bench_fa_cycle(
+    BenchFaModel* model,
+    SubGhzFrequencyAnalyzerSweep* sweep,
+    FrequencyRSSI* result) {
+    model->now_us += BENCH_FA_CYCLE_DELAY_US;
+    subghz_frequency_analyzer_sweep_run(sweep, BENCH_FA_TRIGGER_DB, result);
+}
+
+static void bench_fa_detection(
+    BenchReport* report,
+    const BenchConfig* config,
+    bool adaptive,
+    uint32_t burst_ms) {
+    // Same air for both modes
+    BenchFaModel model = {.random = burst_ms};
+    SubGhzFrequencyAnalyzerSweep* sweep = bench_fa_sweep_alloc(&model, adaptive);
+    uint32_t trials = BENCH_FA_TRIALS * config->iterations;
+    uint32_t detected = 0;
+    uint64_t latency_us = 0;
+    FrequencyRSSI result;
+
+    for(uint32_t trial = 0; trial < trials; trial++) {
+        uint32_t choice = bench_fa_random(&model);
+        uint32_t frequency = (choice % 4) ?
+                                 bench_fa_popular[(choice / 4) % COUNT_OF(bench_fa_popular)] :
+                                 bench_fa_frequency[(choice / 4) % COUNT_OF(bench_fa_frequency)];
+        // Remotes are off by a few tens of kHz
+        int32_t offset = (int32_t)(bench_fa_random(&model) % 60001) - 30000;
+
+        model.burst_frequency = frequency + offset;
+        model.burst_start_us = model.now_us + bench_fa_random(&model) % BENCH_FA_GAP_MAX_US;
+        model.burst_end_us = model.burst_start_us + burst_ms * 1000;
+
+        while(model.now_us < model.burst_end_us) {
+            bench_fa_cycle(&model, sweep, &result);
+            if(model.now_us < model.burst_start_us) continue;
+            if(result.rssi_fine > BENCH_FA_TRIGGER_DB &&
+               (uint32_t)abs((int32_t)(result.frequency_fine - model.burst_frequency)) <=
+                   BENCH_FA_FINE_TOLERANCE) {
+                detected++;
+                latency_us += model.now_us - model.burst_start_us;
+                break;
+            }
+        }
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "%s_%" PRIu32 "ms", adaptive ? "adaptive" : "legacy", burst_ms);
+    bench_report_add(
+        report,
+        "subghz_frequency_analyzer",
+        name,
+        "bursts",
+        trials,
+        config->iterations,
+        latency_us * 1000,
+        detected);
+
+    subghz_frequency_analyzer_sweep_free(sweep);
+}
+
+/* Cycle time on quiet air: how long one frequency is left unwatched */
+static void bench_fa_cycle_time(BenchReport* report, const BenchConfig* config, bool adaptive) {
+    BenchFaModel model = {.random = 1};
+    SubGhzFrequencyAnalyzerSweep* sweep = bench_fa_sweep_alloc(&model, adaptive);
+    uint32_t cycles = BENCH_FA_TRIALS * config->iterations;
+    FrequencyRSSI result;
+
+    for(uint32_t i = 0; i < cycles; i++) {
+        bench_fa_cycle(&model, sweep, &result);
+    }
+
+    bench_report_add(
+        report,
+        "subghz_frequency_analyzer",
+        adaptive ? "adaptive_cycle" : "legacy_cycle",
+        "cycles",
+        cycles,
+        config->iterations,
+        model.now_us * 1000,
+        0);
+
+    subghz_frequency_analyzer_sweep_free(sweep);
+}
+
+void bench_subghz_frequency_analyzer(BenchReport* report, const BenchConfig* config) {
+    for(size_t i = 0; i < COUNT_OF(bench_fa_burst_ms); i++) {
+        bench_fa_detection(report, config, false, bench_fa_burst_ms[i]);
+        bench_fa_detection(report, config, true, bench_fa_burst_ms[i]);
+    }
+    bench_fa_cycle_time(report, config, false);
+    bench_fa_cycle_time(report, config, true);
+}
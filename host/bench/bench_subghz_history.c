@@ -0,0 +1,178 @@
+#include "bench.h"
+#include "../furi_shim/storage_ram.h"
+
+#include <subghz_history.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/transmitter.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <flipper_format/flipper_format.h>
+
+#include <malloc.h>
+
+/* Receive history as the receiver scene fills it: one decoder, new key every
+ * time. First entries stay in RAM, the rest are spilled to storage. */
+
+#define BENCH_HISTORY_ENTRIES (1024)
+// Same as SUBGHZ_HISTORY_RAM_MAX
+#define BENCH_HISTORY_RAM_ENTRIES (55)
+
+static size_t bench_subghz_history_heap(const BenchConfig* config) {
+    // Spilled files are RAM on host, but SD on device
+    return mallinfo2().uordblks - storage_ram_get_allocated(config->storage);
+}
+
+typedef struct {
+    SubGhzHistory* history;
+    SubGhzRadioPreset* preset;
+    bool decoded;
+    bool added;
+    uint64_t elapsed;
+} BenchSubGhzHistoryAdd;
+
+/* Adds from the decoder callback, like the receiver scene: history dedup
+ * hashes live decoder state, which only a real decode sets */
+static void
+    bench_subghz_history_decoder_callback(SubGhzProtocolDecoderBase* decoder, void* context) {
+    BenchSubGhzHistoryAdd* add = context;
+    // Repeats of the same key are dropped by history, time the first one only
+    if(add->decoded) return;
+    add->decoded = true;
+
+    uint64_t start = bench_time_ns();
+    add->added = subghz_history_add_to_history(add->history, decoder, add->preset);
+    add->elapsed = bench_time_ns() - start;
+}
+
+static void bench_subghz_history_send_key(
+    SubGhzTransmitter* transmitter,
+    SubGhzProtocolDecoderBase* decoder,
+    FlipperFormat* ff,
+    uint32_t key) {
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    for(size_t i = 0; i < sizeof(uint32_t); i++) {
+        key_data[sizeof(uint64_t) - 1 - i] = key >> (i * 8);
+    }
+
+    furi_check(flipper_format_rewind(ff));
+    furi_check(flipper_format_update_hex(ff, "Key", key_data, sizeof(uint64_t)));
+    furi_check(flipper_format_rewind(ff));
+    furi_check(subghz_transmitter_deserialize(transmitter, ff) == SubGhzProtocolStatusOk);
+
+    while(true) {
+        LevelDuration level_duration = subghz_transmitter_yield(transmitter);
+        if(level_duration_is_reset(level_duration)) break;
+        decoder->protocol->decoder->feed(
+            decoder,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
+    }
+    subghz_transmitter_stop(transmitter);
+}
+
+void bench_subghz_history(BenchReport* report, const BenchConfig* config) {
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_PRINCETON_NAME);
+    furi_check(decoder);
+    SubGhzTransmitter* transmitter =
+        subghz_transmitter_alloc_init(environment, SUBGHZ_PROTOCOL_PRINCETON_NAME);
+    furi_check(transmitter);
+
+    FlipperFormat* ff = flipper_format_string_alloc();
+    flipper_format_write_string_cstr(ff, "Protocol", SUBGHZ_PROTOCOL_PRINCETON_NAME);
+    uint32_t bit = 24;
+    flipper_format_write_uint32(ff, "Bit", &bit, 1);
+    uint8_t key_data[sizeof(uint64_t)] = {0};
+    flipper_format_write_hex(ff, "Key", key_data, sizeof(uint64_t));
+    uint32_t te = 400;
+    flipper_format_write_uint32(ff, "TE", &te, 1);
+    // Decoder syncs on the first gap and needs two equal copies after it
+    uint32_t repeat = 4;
+    flipper_format_write_uint32(ff, "Repeat", &repeat, 1);
+
+    SubGhzRadioPreset preset = {
+        .name = furi_string_alloc_set("AM650"),
+        .frequency = 433920000,
+    };
+
+    uint64_t ram_elapsed = 0, spill_elapsed = 0, spill_max = 0;
+    uint64_t ram_items = 0, spill_items = 0;
+    size_t ram_bytes = 0, spill_bytes = 0;
+
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        size_t heap_empty = bench_subghz_history_heap(config);
+        SubGhzHistory* history = subghz_history_alloc();
+        size_t heap_full = 0;
+        BenchSubGhzHistoryAdd add = {.history = history, .preset = &preset};
+        subghz_protocol_decoder_base_set_decoder_callback(
+            decoder, bench_subghz_history_decoder_callback, &add);
+
+        for(uint32_t i = 0; i < BENCH_HISTORY_ENTRIES; i++) {
+            add.decoded = false;
+            add.added = false;
+            // Odd multiplier: every key differs and is not 0, xor hash of neighbours
+            // differs too, so history drops none of them as repeats
+            bench_subghz_history_send_key(
+                transmitter, decoder, ff, ((i + 1) * 0x5BD1E9U) & 0xFFFFFF);
+            furi_check(add.decoded && add.added);
+            uint64_t elapsed = add.elapsed;
+
+            if(i < BENCH_HISTORY_RAM_ENTRIES) {
+                ram_elapsed += elapsed;
+                ram_items++;
+                if(i == BENCH_HISTORY_RAM_ENTRIES - 1) {
+                    heap_full = bench_subghz_history_heap(config);
+                }
+            } else {
+                spill_elapsed += elapsed;
+                spill_max = MAX(spill_max, elapsed);
+                spill_items++;
+            }
+        }
+
+        size_t heap_end = bench_subghz_history_heap(config);
+        ram_bytes = (heap_full - heap_empty) / BENCH_HISTORY_RAM_ENTRIES;
+        spill_bytes = heap_end > heap_full ? heap_end - heap_full : 0;
+        subghz_history_free(history);
+    }
+
+    bench_report_add(
+        report,
+        "subghz_history",
+        "add_ram",
+        "entries",
+        ram_items,
+        config->iterations,
+        ram_elapsed,
+        0);
+    bench_report_add(
+        report,
+        "subghz_history",
+        "add_spill",
+        "entries",
+        spill_items,
+        config->iterations,
+        spill_elapsed,
+        0);
+    // Worst single add, includes records file growth
+    bench_report_add(report, "subghz_history", "add_spill_max", "entries", 1, 1, spill_max, 0);
+    // Memory cases: items is bytes, not a rate
+    bench_report_add(report, "subghz_history", "heap_per_ram_entry", "bytes", ram_bytes, 1, 0, 0);
+    bench_report_add(
+        report,
+        "subghz_history",
+        "heap_growth_after_spill",
+        "bytes",
+        spill_bytes,
+        BENCH_HISTORY_ENTRIES - BENCH_HISTORY_RAM_ENTRIES,
+        0,
+        0);
+
+    furi_string_free(preset.name);
+    flipper_format_free(ff);
+    subghz_transmitter_free(transmitter);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+}
@@ -0,0 +1,201 @@
+#include "bench.h"
+
+#include <helpers/subghz_hopper.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "BenchSubGhzHopper"
+
+/* Hopper schedulers replayed against activity traces.
+ *
+ * Receiver scene ticks every 100 ms and updates the hopper the same way as
+ * subghz_txrx_hopper_update, RSSI is over threshold while a burst is heard.
+ * A burst is captured when the radio listened to its frequency for 100 ms of it,
+ * or for all of it if shorter: decoders need a few repeats.
+ *
+ * Results: items - bursts, decoded - bursts captured, elapsed_ns - scheduler and
+ * replay time on host. */
+
+#define BENCH_HOPPER_CORPUS "subghz"
+#define BENCH_HOPPER_SUFFIX ".trace"
+#define BENCH_HOPPER_FILE_TYPE "Flipper SubGhz Hopper Trace"
+
+#define BENCH_HOPPER_STEP_MS (10)
+#define BENCH_HOPPER_TICK_MS (100)
+#define BENCH_HOPPER_RSSI_SIGNAL (-40.0f)
+#define BENCH_HOPPER_RSSI_NOISE (-100.0f)
+#define BENCH_HOPPER_CAPTURE_MS (100)
+// Longest burst in a trace, older bursts are not looked at
+#define BENCH_HOPPER_BURST_MAX_MS (5000)
+
+// Hopper list of assets/resources/subghz/assets/setting_user.txt
+static const uint32_t bench_hopper_frequency[] = {
+    310000000,
+    313000000,
+    315000000,
+    390000000,
+    433920000,
+    434420000,
+    868350000,
+};
+
+#define BENCH_HOPPER_PINNED (433920000)
+
+typedef struct {
+    uint32_t start;
+    uint32_t frequency;
+    uint32_t duration;
+    uint32_t heard;
+    bool captured;
+} BenchHopperBurst;
+
+typedef struct {
+    BenchHopperBurst* bursts;
+    size_t count;
+} BenchHopperTrace;
+
+typedef enum {
+    BenchHopperModeRoundRobin,
+    BenchHopperModeAdaptive,
+    BenchHopperModePinned,
+} BenchHopperMode;
+
+static const char* const bench_hopper_mode_name[] = {
+    [BenchHopperModeRoundRobin] = "round_robin",
+    [BenchHopperModeAdaptive] = "adaptive",
+    [BenchHopperModePinned] = "adaptive_pinned",
+};
+
+static bool bench_hopper_load_trace(const char* path, BenchHopperTrace* trace) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t version;
+    bool result = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, BENCH_HOPPER_FILE_TYPE)) break;
+
+        uint32_t burst[3];
+        size_t capacity = 0;
+        while(flipper_format_read_uint32(ff, "Burst", burst, COUNT_OF(burst))) {
+            if(trace->count == capacity) {
+                capacity = capacity ? capacity * 2 : 64;
+                trace->bursts = realloc(trace->bursts, sizeof(BenchHopperBurst) * capacity);
+            }
+            trace->bursts[trace->count++] = (BenchHopperBurst){
+                .start = burst[0],
+                .frequency = burst[1],
+                .duration = burst[2],
+            };
+        }
+        result = trace->count > 0;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+static SubGhzHopper* bench_hopper_alloc(BenchHopperMode mode) {
+    SubGhzHopper* hopper = subghz_hopper_alloc(COUNT_OF(bench_hopper_frequency));
+    for(size_t i = 0; i < COUNT_OF(bench_hopper_frequency); i++) {
+        bool pinned = mode == BenchHopperModePinned &&
+                      bench_hopper_frequency[i] == BENCH_HOPPER_PINNED;
+        subghz_hopper_add_frequency(hopper, bench_hopper_frequency[i], pinned);
+    }
+    subghz_hopper_set_adaptive(hopper, mode != BenchHopperModeRoundRobin);
+    return hopper;
+}
+
+/** Replay trace, returns captured burst count */
+static uint32_t bench_hopper_replay(BenchHopperTrace* trace, BenchHopperMode mode) {
+    SubGhzHopper* hopper = bench_hopper_alloc(mode);
+    uint32_t end = 0;
+    for(size_t i = 0; i < trace->count; i++) {
+        trace->bursts[i].heard = 0;
+        trace->bursts[i].captured = false;
+        end = MAX(end, trace->bursts[i].start + trace->bursts[i].duration);
+    }
+
+    uint32_t captured = 0;
+    size_t first = 0;
+
+    for(uint32_t now = 0; now < end; now += BENCH_HOPPER_STEP_MS) {
+        uint32_t tuned = subghz_hopper_get_current_frequency(hopper);
+        bool signal = false;
+
+        while(first < trace->count &&
+              trace->bursts[first].start + BENCH_HOPPER_BURST_MAX_MS < now) {
+            first++;
+        }
+        for(size_t i = first; i < trace->count; i++) {
+            BenchHopperBurst* burst = &trace->bursts[i];
+            if(burst->start >= now + BENCH_HOPPER_STEP_MS) break;
+            uint32_t burst_end = burst->start + burst->duration;
+            if(burst->frequency != tuned || burst_end <= now) continue;
+
+            signal = true;
+            burst->heard += MIN(burst_end, now + BENCH_HOPPER_STEP_MS) - MAX(burst->start, now);
+            uint32_t needed = MIN(burst->duration, (uint32_t)BENCH_HOPPER_CAPTURE_MS);
+            if(!burst->captured && burst->heard >= needed) {
+                burst->captured = true;
+                captured++;
+                subghz_hopper_add_hit(hopper);
+            }
+        }
+
+        if((now + BENCH_HOPPER_STEP_MS) % BENCH_HOPPER_TICK_MS) continue;
+        subghz_hopper_update(hopper, signal ? BENCH_HOPPER_RSSI_SIGNAL : BENCH_HOPPER_RSSI_NOISE);
+    }
+
+    subghz_hopper_free(hopper);
+    return captured;
+}
+
+void bench_subghz_hopper(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count =
+        bench_corpus_load(config, BENCH_HOPPER_CORPUS, BENCH_HOPPER_SUFFIX, &names);
+    FuriString* path = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    for(size_t i = 0; i < name_count; i++) {
+        furi_string_printf(path, EXT_PATH("unit_tests/%s/%s"), BENCH_HOPPER_CORPUS, names[i]);
+        BenchHopperTrace trace = {0};
+        if(!bench_hopper_load_trace(furi_string_get_cstr(path), &trace)) {
+            FURI_LOG_W(TAG, "Skipped %s", names[i]);
+            free(trace.bursts);
+            continue;
+        }
+
+        for(size_t mode = 0; mode < COUNT_OF(bench_hopper_mode_name); mode++) {
+            uint32_t captured = 0;
+            uint64_t start = bench_time_ns();
+            for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+                captured += bench_hopper_replay(&trace, mode);
+            }
+            uint64_t elapsed = bench_time_ns() - start;
+
+            furi_string_set(name, names[i]);
+            furi_string_left(name, furi_string_size(name) - strlen(BENCH_HOPPER_SUFFIX));
+            furi_string_cat_printf(name, "_%s", bench_hopper_mode_name[mode]);
+            bench_report_add(
+                report,
+                "subghz_hopper",
+                furi_string_get_cstr(name),
+                "bursts",
+                (uint64_t)trace.count * config->iterations,
+                config->iterations,
+                elapsed,
+                captured);
+        }
+        free(trace.bursts);
+    }
+
+    furi_string_free(name);
+    furi_string_free(path);
+    bench_corpus_free(names, name_count);
+}
@@ -0,0 +1,222 @@
+#include "bench.h"
+
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/transmitter.h>
+#include <lib/subghz/protocols/protocol_items.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "BenchSubGhzLoad"
+
+/* Mass loading of SubGhz key files, as playlist, subbrute and remote apps do it.
+ *
+ * Key files of the corpus are repeated into a playlist of a few hundred entries.
+ * Every entry is opened, its protocol found by the name read from file and the key
+ * deserialized: by transmitter (playlist) and by receiver decoder (SubGhz app).
+ * Name lookup alone is measured over the same names, linear registry scan against
+ * the environment perfect hash. RAW files are left out: their encoder streams the
+ * file from a thread.
+ *
+ * Results: items - files or lookups, decoded - files loaded or protocols found. */
+
+#define BENCH_LOAD_CORPUS "subghz"
+#define BENCH_LOAD_SUFFIX ".sub"
+#define BENCH_LOAD_PLAYLIST_SIZE (500)
+
+typedef struct {
+    FuriString** paths;
+    FuriString** protocols;
+    size_t count;
+} BenchLoadPlaylist;
+
+static void bench_load_playlist_alloc(
+    BenchLoadPlaylist* playlist,
+    char** names,
+    size_t name_count) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    FuriString* protocol = furi_string_alloc();
+
+    // Key files only
+    FuriString** keys = malloc(sizeof(FuriString*) * name_count);
+    FuriString** key_protocols = malloc(sizeof(FuriString*) * name_count);
+    size_t key_count = 0;
+    for(size_t i = 0; i < name_count; i++) {
+        FuriString* path = furi_string_alloc_printf(
+            EXT_PATH("unit_tests/%s/%s"), BENCH_LOAD_CORPUS, names[i]);
+        bool is_key = flipper_format_file_open_existing(ff, furi_string_get_cstr(path)) &&
+                      flipper_format_read_string(ff, "Protocol", protocol) &&
+                      furi_string_cmp_str(protocol, "RAW");
+        flipper_format_file_close(ff);
+        if(is_key) {
+            keys[key_count] = path;
+            key_protocols[key_count] = furi_string_alloc_set(protocol);
+            key_count++;
+        } else {
+            furi_string_free(path);
+        }
+    }
+
+    playlist->count = key_count ? BENCH_LOAD_PLAYLIST_SIZE : 0;
+    playlist->paths = malloc(sizeof(FuriString*) * BENCH_LOAD_PLAYLIST_SIZE);
+    playlist->protocols = malloc(sizeof(FuriString*) * BENCH_LOAD_PLAYLIST_SIZE);
+    for(size_t i = 0; i < playlist->count; i++) {
+        playlist->paths[i] = furi_string_alloc_set(keys[i % key_count]);
+        playlist->protocols[i] = furi_string_alloc_set(key_protocols[i % key_count]);
+    }
+
+    for(size_t i = 0; i < key_count; i++) {
+        furi_string_free(keys[i]);
+        furi_string_free(key_protocols[i]);
+    }
+    free(keys);
+    free(key_protocols);
+    furi_string_free(protocol);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void bench_load_playlist_free(BenchLoadPlaylist* playlist) {
+    for(size_t i = 0; i < playlist->count; i++) {
+        furi_string_free(playlist->paths[i]);
+        furi_string_free(playlist->protocols[i]);
+    }
+    free(playlist->paths);
+    free(playlist->protocols);
+}
+
+static uint32_t bench_load_transmitter(
+    SubGhzEnvironment* environment,
+    FlipperFormat* ff,
+    FuriString* protocol,
+    const BenchLoadPlaylist* playlist) {
+    uint32_t loaded = 0;
+    for(size_t i = 0; i < playlist->count; i++) {
+        if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(playlist->paths[i])))
+            continue;
+        if(flipper_format_read_string(ff, "Protocol", protocol)) {
+            SubGhzTransmitter* transmitter =
+                subghz_transmitter_alloc_init(environment, furi_string_get_cstr(protocol));
+            if(transmitter) {
+                flipper_format_rewind(ff);
+                if(subghz_transmitter_deserialize(transmitter, ff) == SubGhzProtocolStatusOk)
+                    loaded++;
+                subghz_transmitter_free(transmitter);
+            }
+        }
+        flipper_format_file_close(ff);
+    }
+    return loaded;
+}
+
+static uint32_t bench_load_receiver(
+    SubGhzReceiver* receiver,
+    FlipperFormat* ff,
+    FuriString* protocol,
+    const BenchLoadPlaylist* playlist) {
+    uint32_t loaded = 0;
+    for(size_t i = 0; i < playlist->count; i++) {
+        if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(playlist->paths[i])))
+            continue;
+        if(flipper_format_read_string(ff, "Protocol", protocol)) {
+            SubGhzProtocolDecoderBase* decoder = subghz_receiver_search_decoder_base_by_name(
+                receiver, furi_string_get_cstr(protocol));
+            if(decoder) {
+                flipper_format_rewind(ff);
+                if(subghz_protocol_decoder_base_deserialize(decoder, ff) ==
+                   SubGhzProtocolStatusOk)
+                    loaded++;
+            }
+        }
+        flipper_format_file_close(ff);
+    }
+    return loaded;
+}
+
+void bench_subghz_load(BenchReport* report, const BenchConfig* config) {
+    char** names;
+    size_t name_count = bench_corpus_load(config, BENCH_LOAD_CORPUS, BENCH_LOAD_SUFFIX, &names);
+
+    BenchLoadPlaylist playlist = {0};
+    bench_load_playlist_alloc(&playlist, names, name_count);
+    bench_corpus_free(names, name_count);
+    if(!playlist.count) {
+        FURI_LOG_W(TAG, "No key files");
+        bench_load_playlist_free(&playlist);
+        return;
+    }
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    FuriString* protocol = furi_string_alloc();
+    uint64_t items = (uint64_t)playlist.count * config->iterations;
+
+    uint32_t loaded = 0;
+    uint64_t start = bench_time_ns();
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        loaded += bench_load_transmitter(environment, ff, protocol, &playlist);
+    }
+    uint64_t elapsed = bench_time_ns() - start;
+    bench_report_add(
+        report, "subghz_load", "transmitter", "files", items, config->iterations, elapsed, loaded);
+
+    loaded = 0;
+    start = bench_time_ns();
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        loaded += bench_load_receiver(receiver, ff, protocol, &playlist);
+    }
+    elapsed = bench_time_ns() - start;
+    bench_report_add(
+        report, "subghz_load", "receiver", "files", items, config->iterations, elapsed, loaded);
+
+    // Name lookup alone: names are copies read from files, never interned pointers
+    const SubGhzProtocolRegistry* registry = subghz_environment_get_protocol_registry(environment);
+    uint32_t found = 0;
+    start = bench_time_ns();
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        for(size_t i = 0; i < playlist.count; i++) {
+            const char* name = furi_string_get_cstr(playlist.protocols[i]);
+            if(subghz_protocol_registry_get_by_name(registry, name)) found++;
+        }
+    }
+    elapsed = bench_time_ns() - start;
+    bench_report_add(
+        report,
+        "subghz_load",
+        "lookup_linear",
+        "names",
+        items,
+        config->iterations,
+        elapsed,
+        found);
+
+    uint32_t found_indexed = 0;
+    start = bench_time_ns();
+    for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+        for(size_t i = 0; i < playlist.count; i++) {
+            const char* name = furi_string_get_cstr(playlist.protocols[i]);
+            if(subghz_environment_get_protocol_by_name(environment, name)) found_indexed++;
+        }
+    }
+    elapsed = bench_time_ns() - start;
+    furi_check(found_indexed == found);
+    bench_report_add(
+        report,
+        "subghz_load",
+        "lookup_indexed",
+        "names",
+        items,
+        config->iterations,
+        elapsed,
+        found_indexed);
+
+    furi_string_free(protocol);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+    bench_load_playlist_free(&playlist);
+}
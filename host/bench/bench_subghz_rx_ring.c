@@ -0,0 +1,212 @@
+#include "bench.h"
+
+#include <toolbox/level_duration_ring.h>
+
+#include <pthread.h>
+#include <time.h>
+
+#define TAG "BenchSubGhzRxRing"
+
+/* SubGhz worker receive ring driven by a producer thread at synthetic edge rates.
+ *
+ * Producer stands for the capture interrupt: pushes edges carrying sequence
+ * numbers, paced to the case rate, and wakes consumer when push asks for it.
+ * Consumer stands for the worker thread: waits for a wakeup or timeout, drains
+ * blocks and checks them. Every case checks that edges come in order, that
+ * sequence jumps only right after a reset mark and by exactly the dropped count,
+ * and that received and dropped add up to pushed.
+ *
+ * Results: items - edges pushed, decoded - edges received, elapsed_ns - time
+ * until consumer has seen the last edge. */
+
+// Same as subghz_worker.c
+#define BENCH_RX_RING_SIZE (4096)
+#define BENCH_RX_RING_WATERMARK (BENCH_RX_RING_SIZE / 4)
+#define BENCH_RX_RING_TIMEOUT_MS (10)
+
+// Edge sequence numbers wrap at LevelDuration duration width
+#define BENCH_RX_RING_SEQUENCE_MASK (0x3FFFFFFFU)
+
+typedef struct {
+    const char* name;
+    // Edges per second, 0: as fast as possible
+    uint32_t rate;
+    uint32_t edges;
+    // Consumer work per edge, ns: decoders feed
+    uint32_t edge_cost_ns;
+} BenchRxRingCase;
+
+static const BenchRxRingCase bench_rx_ring_cases[] = {
+    // Slow remotes, every edge delivered on timeout
+    {"50k_edges_per_s", 50000, 5000, 0},
+    // Noise on CC1101 async output
+    {"200k_edges_per_s", 200000, 20000, 0},
+    {"1m_edges_per_s", 1000000, 100000, 0},
+    {"unlimited", 0, 1000000, 0},
+    // Consumer can't keep up: overruns must be accounted for exactly
+    {"unlimited_slow_consumer", 0, 200000, 200},
+};
+
+typedef struct {
+    LevelDurationRing* ring;
+    const BenchRxRingCase* test_case;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool wakeup;
+    bool done;
+
+    uint32_t wakeups;
+    uint32_t received;
+    uint32_t resets;
+} BenchRxRing;
+
+static void bench_rx_ring_spin_ns(uint64_t ns) {
+    uint64_t until = bench_time_ns() + ns;
+    while(bench_time_ns() < until) {
+    }
+}
+
+static void bench_rx_ring_wake(BenchRxRing* bench, bool done) {
+    pthread_mutex_lock(&bench->mutex);
+    bench->wakeup = true;
+    if(done) bench->done = true;
+    pthread_cond_signal(&bench->cond);
+    pthread_mutex_unlock(&bench->mutex);
+}
+
+static void* bench_rx_ring_producer(void* context) {
+    BenchRxRing* bench = context;
+    const BenchRxRingCase* test_case = bench->test_case;
+
+    uint64_t start = bench_time_ns();
+    for(uint32_t i = 0; i < test_case->edges; i++) {
+        if(test_case->rate) {
+            uint64_t due = start + (uint64_t)i * 1000000000ULL / test_case->rate;
+            while(bench_time_ns() < due) {
+            }
+        }
+        LevelDuration edge = level_duration_make(i & 1, i & BENCH_RX_RING_SEQUENCE_MASK);
+        if(level_duration_ring_push(bench->ring, edge)) bench_rx_ring_wake(bench, false);
+    }
+    bench_rx_ring_wake(bench, true);
+
+    return NULL;
+}
+
+static bool bench_rx_ring_wait(BenchRxRing* bench) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += BENCH_RX_RING_TIMEOUT_MS * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&bench->mutex);
+    while(!bench->wakeup) {
+        if(pthread_cond_timedwait(&bench->cond, &bench->mutex, &deadline)) break;
+    }
+    if(bench->wakeup) bench->wakeups++;
+    bench->wakeup = false;
+    bool done = bench->done;
+    pthread_mutex_unlock(&bench->mutex);
+
+    return done;
+}
+
+static uint64_t bench_rx_ring_run(const BenchRxRingCase* test_case, BenchRxRing* bench) {
+    bench->ring = level_duration_ring_alloc(BENCH_RX_RING_SIZE, BENCH_RX_RING_WATERMARK);
+    bench->test_case = test_case;
+    pthread_mutex_init(&bench->mutex, NULL);
+    pthread_cond_init(&bench->cond, NULL);
+
+    uint64_t start = bench_time_ns();
+    pthread_t producer;
+    furi_check(!pthread_create(&producer, NULL, bench_rx_ring_producer, bench));
+
+    uint32_t expected = 0;
+    uint32_t skipped = 0;
+    bool after_reset = false;
+    bool done = false;
+    while(true) {
+        const LevelDuration* block;
+        size_t count;
+        while((count = level_duration_ring_peek(bench->ring, &block)) > 0) {
+            for(size_t i = 0; i < count; i++) {
+                if(level_duration_is_reset(block[i])) {
+                    furi_check(!after_reset);
+                    after_reset = true;
+                    bench->resets++;
+                    continue;
+                }
+
+                uint32_t sequence = level_duration_get_duration(block[i]);
+                if(sequence != (expected & BENCH_RX_RING_SEQUENCE_MASK)) {
+                    furi_check(after_reset, "edge lost without reset mark");
+                    uint32_t gap = (sequence - expected) & BENCH_RX_RING_SEQUENCE_MASK;
+                    skipped += gap;
+                    expected += gap;
+                }
+                furi_check(level_duration_get_level(block[i]) == (expected & 1));
+                after_reset = false;
+                expected++;
+                bench->received++;
+            }
+            if(test_case->edge_cost_ns) bench_rx_ring_spin_ns(count * test_case->edge_cost_ns);
+            level_duration_ring_release(bench->ring, count);
+        }
+        // Producer was finished before this drain: nothing is left behind
+        if(done) break;
+        done = bench_rx_ring_wait(bench);
+    }
+    uint64_t elapsed = bench_time_ns() - start;
+    pthread_join(producer, NULL);
+
+    uint32_t dropped = level_duration_ring_get_dropped_count(bench->ring);
+    uint32_t overruns = level_duration_ring_get_overrun_count(bench->ring);
+    furi_check(bench->received + dropped == test_case->edges);
+    // Edges dropped at the very end have no following edge to carry reset mark
+    bool tail_dropped = expected != test_case->edges;
+    furi_check(skipped + (test_case->edges - expected) == dropped);
+    furi_check(overruns == bench->resets + (tail_dropped ? 1 : 0));
+
+    pthread_cond_destroy(&bench->cond);
+    pthread_mutex_destroy(&bench->mutex);
+    level_duration_ring_free(bench->ring);
+
+    return elapsed;
+}
+
+void bench_subghz_rx_ring(BenchReport* report, const BenchConfig* config) {
+    for(size_t i = 0; i < COUNT_OF(bench_rx_ring_cases); i++) {
+        const BenchRxRingCase* test_case = &bench_rx_ring_cases[i];
+
+        uint64_t elapsed = 0;
+        uint64_t received = 0;
+        uint32_t wakeups = 0;
+        for(uint32_t iteration = 0; iteration < config->iterations; iteration++) {
+            BenchRxRing bench = {0};
+            elapsed += bench_rx_ring_run(test_case, &bench);
+            received += bench.received;
+            wakeups += bench.wakeups;
+        }
+
+        FURI_LOG_I(
+            TAG,
+            "%s: %" PRIu32 " wakeups, %" PRIu64 " of %" PRIu64 " edges received",
+            test_case->name,
+            wakeups,
+            received,
+            (uint64_t)test_case->edges * config->iterations);
+        bench_report_add(
+            report,
+            "subghz_rx_ring",
+            test_case->name,
+            "edges",
+            (uint64_t)test_case->edges * config->iterations,
+            config->iterations,
+            elapsed,
+            received);
+    }
+}
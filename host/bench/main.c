@@ -0,0 +1,116 @@
+#include "bench.h"
+#include "../furi_shim/storage_ram.h"
+
+#include <stdio.h>
+
+#define BENCH_JSON_VERSION (1)
+#define BENCH_ITERATIONS_DEFAULT (20)
+
+static const BenchSuite bench_suites[] = {
+    {"subghz", bench_subghz},
+    {"subghz_history", bench_subghz_history},
+    {"subghz_frequency_analyzer", bench_subghz_frequency_analyzer},
+    {"subghz_hopper", bench_subghz_hopper},
+    {"subghz_bin_raw", bench_subghz_bin_raw},
+    {"subghz_rx_ring", bench_subghz_rx_ring},
+    {"subghz_load", bench_subghz_load},
+    {"subghz_file_replay", bench_subghz_file_replay},
+    {"desktop_animation", bench_desktop_animation},
+    {"rpc_gui_stream", bench_rpc_gui_stream},
+    {"infrared", bench_infrared},
+    {"lfrfid", bench_lfrfid},
+    {"nfc", bench_nfc},
+    {"mifare_nested", bench_mifare_nested},
+    {"profiler", bench_profiler},
+};
+
+static void bench_usage(const char* name) {
+    fprintf(
+        stderr,
+        "Usage: %s [options]\r\n"
+        "  --corpus <dir>      corpus directory, default: assets/unit_tests\r\n"
+        "  --iterations <n>    runs of every case, default: %d\r\n"
+        "  --filter <suite>    run only suites containing <suite>\r\n"
+        "  --output <file>     JSON output, default: stdout\r\n"
+        "  --verbose           print library logs\r\n",
+        name,
+        BENCH_ITERATIONS_DEFAULT);
+}
+
+static void bench_report_write_json(const BenchReport* report, FILE* output) {
+    fprintf(output, "{\n  \"version\": %d,\n  \"results\": [", BENCH_JSON_VERSION);
+    for(size_t i = 0; i < report->count; i++) {
+        const BenchResult* result = &report->results[i];
+        double seconds = result->elapsed_ns / 1e9;
+        fprintf(
+            output,
+            "%s\n    {\"suite\": \"%s\", \"name\": \"%s\", \"unit\": \"%s\", "
+            "\"items\": %" PRIu64 ", \"iterations\": %" PRIu32 ", \"elapsed_ns\": %" PRIu64
+            ", \"items_per_second\": %.0f, \"decoded\": %" PRIu32 "}",
+            i ? "," : "",
+            result->suite,
+            result->name,
+            result->unit,
+            result->items,
+            result->iterations,
+            result->elapsed_ns,
+            seconds > 0 ? result->items / seconds : 0,
+            result->decoded);
+    }
+    fprintf(output, "\n  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config = {
+        .corpus_dir = "assets/unit_tests",
+        .iterations = BENCH_ITERATIONS_DEFAULT,
+    };
+    const char* filter = NULL;
+    const char* output_path = NULL;
+
+    for(int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if(!strcmp(argv[i], "--corpus") && has_value) {
+            config.corpus_dir = argv[++i];
+        } else if(!strcmp(argv[i], "--iterations") && has_value) {
+            config.iterations = strtoul(argv[++i], NULL, 10);
+        } else if(!strcmp(argv[i], "--filter") && has_value) {
+            filter = argv[++i];
+        } else if(!strcmp(argv[i], "--output") && has_value) {
+            output_path = argv[++i];
+        } else if(!strcmp(argv[i], "--verbose")) {
+            furi_log_set_level(FuriLogLevelDebug);
+        } else {
+            bench_usage(argv[0]);
+            return 1;
+        }
+    }
+    if(!config.iterations) config.iterations = 1;
+
+    config.storage = storage_ram_alloc();
+    furi_record_create(RECORD_STORAGE, config.storage);
+
+    BenchReport* report = malloc(sizeof(BenchReport));
+    for(size_t i = 0; i < COUNT_OF(bench_suites); i++) {
+        if(filter && !strstr(bench_suites[i].name, filter)) continue;
+        size_t first = report->count;
+        bench_suites[i].run(report, &config);
+        fprintf(stderr, "%s: %zu cases\r\n", bench_suites[i].name, report->count - first);
+    }
+
+    int ret = 0;
+    FILE* output = output_path ? fopen(output_path, "w") : stdout;
+    if(output) {
+        bench_report_write_json(report, output);
+        if(output != stdout) fclose(output);
+    } else {
+        fprintf(stderr, "Unable to open %s\r\n", output_path);
+        ret = 1;
+    }
+
+    free(report);
+    furi_record_destroy(RECORD_STORAGE);
+    storage_ram_free(config.storage);
+
+    return ret;
+}
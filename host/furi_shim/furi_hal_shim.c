@@ -0,0 +1,50 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <time.h>
+
+/* Host build: device keys never leave the secure enclave, so encrypted
+ * keystores and rainbow tables are unavailable and loading them fails cleanly. */
+
+bool furi_hal_crypto_enclave_load_key(uint8_t slot, const uint8_t* iv) {
+    UNUSED(slot);
+    UNUSED(iv);
+    return false;
+}
+
+bool furi_hal_crypto_enclave_unload_key(uint8_t slot) {
+    UNUSED(slot);
+    return false;
+}
+
+bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i++) {
+        buf[i] = rand();
+    }
+}
+
+uint32_t furi_hal_rtc_get_timestamp() {
+    return time(NULL);
+}
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units() {
+    return FuriHalRtcLocaleUnitsMetric;
+}
+
+uint8_t furi_hal_subghz_get_rolling_counter_mult(void) {
+    return 1;
+}
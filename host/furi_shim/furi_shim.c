@@ -0,0 +1,241 @@
+#include <furi.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+
+/* Host build has no kernel: benches start their own pthreads, so mutexes and
+ * critical sections are real locks, records are a plain table under a lock */
+
+#define FURI_SHIM_RECORDS_MAX (16)
+
+typedef struct {
+    const char* name;
+    void* data;
+} FuriShimRecord;
+
+static FuriShimRecord furi_shim_records[FURI_SHIM_RECORDS_MAX];
+static pthread_mutex_t furi_shim_records_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FuriLogLevel furi_shim_log_level = FuriLogLevelNone;
+
+/* Critical sections of all threads exclude each other, like interrupts masking on device */
+static pthread_mutex_t furi_shim_critical_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+void __furi_crash_host(const char* message) {
+    if((uintptr_t)message == __FURI_ASSERT_MESSAGE_FLAG) {
+        message = "furi_assert failed";
+    } else if((uintptr_t)message == __FURI_CHECK_MESSAGE_FLAG) {
+        message = "furi_check failed";
+    } else if(message == NULL) {
+        message = "Fatal Error";
+    }
+    fprintf(stderr, "\r\n\033[0;31m[CRASH]\033[0m %s\r\n", message);
+    fflush(stderr);
+    abort();
+}
+
+/* Linked with -Wl,--wrap=malloc: furi code expects zeroed memory and no NULL */
+void* __wrap_malloc(size_t size) {
+    void* p = calloc(1, size);
+    furi_check(p, "out of memory");
+    return p;
+}
+
+#ifdef FURI_SHIM_STRLCPY
+size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t length = strlen(src);
+    if(size) {
+        size_t copy = MIN(length, size - 1);
+        memcpy(dst, src, copy);
+        dst[copy] = '\0';
+    }
+    return length;
+}
+#endif
+
+size_t memmgr_get_free_heap(void) {
+    // No heap limit on host
+    return SIZE_MAX;
+}
+
+__FuriCriticalInfo __furi_critical_enter(void) {
+    __FuriCriticalInfo info = {0};
+    furi_check(pthread_mutex_lock(&furi_shim_critical_mutex) == 0);
+    return info;
+}
+
+void __furi_critical_exit(__FuriCriticalInfo info) {
+    UNUSED(info);
+    furi_check(pthread_mutex_unlock(&furi_shim_critical_mutex) == 0);
+}
+
+FuriMutex* furi_mutex_alloc(FuriMutexType type) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    // Error checking catches release by a thread that doesn't own the mutex
+    pthread_mutexattr_settype(
+        &attr,
+        (type == FuriMutexTypeRecursive) ? PTHREAD_MUTEX_RECURSIVE : PTHREAD_MUTEX_ERRORCHECK);
+
+    pthread_mutex_t* mutex = malloc(sizeof(pthread_mutex_t));
+    furi_check(pthread_mutex_init(mutex, &attr) == 0);
+    pthread_mutexattr_destroy(&attr);
+    return mutex;
+}
+
+void furi_mutex_free(FuriMutex* instance) {
+    furi_assert(instance);
+    furi_check(pthread_mutex_destroy(instance) == 0);
+    free(instance);
+}
+
+FuriStatus furi_mutex_acquire(FuriMutex* instance, uint32_t timeout) {
+    furi_assert(instance);
+
+    int error;
+    if(timeout == FuriWaitForever) {
+        error = pthread_mutex_lock(instance);
+    } else if(timeout == 0) {
+        error = pthread_mutex_trylock(instance);
+    } else {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000;
+        if(deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        error = pthread_mutex_timedlock(instance, &deadline);
+    }
+
+    if(error == 0) {
+        return FuriStatusOk;
+    } else if(error == EBUSY || error == ETIMEDOUT) {
+        return (timeout == 0) ? FuriStatusErrorResource : FuriStatusErrorTimeout;
+    } else {
+        return FuriStatusError;
+    }
+}
+
+FuriStatus furi_mutex_release(FuriMutex* instance) {
+    furi_assert(instance);
+    return pthread_mutex_unlock(instance) == 0 ? FuriStatusOk : FuriStatusErrorResource;
+}
+
+uint32_t furi_get_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+uint32_t furi_kernel_get_tick_frequency() {
+    return 1000;
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    usleep(ticks * 1000);
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    usleep(milliseconds * 1000);
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    usleep(microseconds);
+}
+
+static FuriShimRecord* furi_shim_record_find(const char* name) {
+    for(size_t i = 0; i < FURI_SHIM_RECORDS_MAX; i++) {
+        if(furi_shim_records[i].name && strcmp(furi_shim_records[i].name, name) == 0) {
+            return &furi_shim_records[i];
+        }
+    }
+    return NULL;
+}
+
+bool furi_record_exists(const char* name) {
+    furi_assert(name);
+    pthread_mutex_lock(&furi_shim_records_mutex);
+    bool exists = furi_shim_record_find(name) != NULL;
+    pthread_mutex_unlock(&furi_shim_records_mutex);
+    return exists;
+}
+
+void furi_record_create(const char* name, void* data) {
+    furi_assert(name);
+    pthread_mutex_lock(&furi_shim_records_mutex);
+    furi_check(!furi_shim_record_find(name));
+
+    size_t i = 0;
+    while((i < FURI_SHIM_RECORDS_MAX) && furi_shim_records[i].name) i++;
+    furi_check(i < FURI_SHIM_RECORDS_MAX, "too many records");
+    furi_shim_records[i].name = name;
+    furi_shim_records[i].data = data;
+    pthread_mutex_unlock(&furi_shim_records_mutex);
+}
+
+bool furi_record_destroy(const char* name) {
+    furi_assert(name);
+    pthread_mutex_lock(&furi_shim_records_mutex);
+    FuriShimRecord* record = furi_shim_record_find(name);
+    if(record) {
+        record->name = NULL;
+        record->data = NULL;
+    }
+    pthread_mutex_unlock(&furi_shim_records_mutex);
+    return record != NULL;
+}
+
+void* furi_record_open(const char* name) {
+    furi_assert(name);
+    pthread_mutex_lock(&furi_shim_records_mutex);
+    FuriShimRecord* record = furi_shim_record_find(name);
+    // Nobody will ever create it on host
+    furi_check(record, "record is not created");
+    void* data = record->data;
+    pthread_mutex_unlock(&furi_shim_records_mutex);
+    return data;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+void furi_log_set_level(FuriLogLevel level) {
+    furi_shim_log_level = level;
+}
+
+FuriLogLevel furi_log_get_level() {
+    return furi_shim_log_level;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > furi_shim_log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    // Keep lines of concurrent benches whole
+    flockfile(stderr);
+    fprintf(stderr, "[%s] ", tag);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\r\n");
+    funlockfile(stderr);
+    va_end(args);
+}
+
+void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
+    if(level > furi_shim_log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+/* Host build: only what furi public headers take from FreeRTOS */
+#define configMAX_PRIORITIES (32)
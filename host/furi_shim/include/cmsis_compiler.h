@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Host build: always thread mode with interrupts enabled */
+static inline uint32_t __get_IPSR(void) {
+    return 0;
+}
+
+static inline uint32_t __get_PRIMASK(void) {
+    return 0;
+}
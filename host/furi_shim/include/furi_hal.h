@@ -0,0 +1,26 @@
+#pragma once
+
+/* Host build: HAL subset used by protocol libraries, see furi_hal_shim.c */
+#include <furi.h>
+#include <furi_hal_crypto.h>
+#include <furi_hal_random.h>
+#include <furi_hal_rtc.h>
+
+/* Comes with furi_hal_subghz.h on device */
+#include <toolbox/level_duration.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Rolling code counter increment, always 1 on host */
+uint8_t furi_hal_subghz_get_rolling_counter_mult(void);
+
+/* Async RX/TX callbacks of furi_hal_subghz.h, file_replay device implements them on host */
+typedef void (*FuriHalSubGhzCaptureCallback)(bool level, uint32_t duration, void* context);
+
+typedef LevelDuration (*FuriHalSubGhzAsyncTxCallback)(void* context);
+
+#ifdef __cplusplus
+}
+#endif
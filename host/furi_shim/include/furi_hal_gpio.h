@@ -0,0 +1,9 @@
+#pragma once
+
+#include <stdint.h>
+
+/* Host build: no GPIO, type only for headers that pass pins around */
+typedef struct {
+    void* port;
+    uint16_t pin;
+} GpioPin;
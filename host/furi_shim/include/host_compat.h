@@ -0,0 +1,12 @@
+#pragma once
+
+/* Host build: C library functions newlib has and older glibc doesn't,
+ * included into every source with -include */
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+#define FURI_SHIM_STRLCPY
+
+size_t strlcpy(char* dst, const char* src, size_t size);
+#endif
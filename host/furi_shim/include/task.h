@@ -0,0 +1,3 @@
+#pragma once
+
+/* Host build: no scheduler, included by furi headers only */
@@ -0,0 +1,3 @@
+#pragma once
+
+/* Host build: no timer service, included by furi headers only */
@@ -0,0 +1,412 @@
+#include "storage_ram.h"
+
+#include <furi.h>
+#include <stdio.h>
+
+typedef struct {
+    char* path;
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} StorageRamNode;
+
+struct Storage {
+    StorageRamNode* nodes;
+    size_t count;
+    size_t capacity;
+};
+
+struct File {
+    Storage* storage;
+    /* Index, nodes array can move on file creation */
+    size_t node;
+    size_t position;
+    FS_AccessMode access_mode;
+    FS_Error error;
+    bool is_open;
+};
+
+static const char* storage_ram_normalize(const char* path, char* buffer, size_t size) {
+    if(strncmp(path, STORAGE_ANY_PATH_PREFIX, strlen(STORAGE_ANY_PATH_PREFIX)) == 0) {
+        snprintf(
+            buffer,
+            size,
+            "%s%s",
+            STORAGE_EXT_PATH_PREFIX,
+            path + strlen(STORAGE_ANY_PATH_PREFIX));
+        return buffer;
+    }
+    return path;
+}
+
+static bool storage_ram_find(Storage* storage, const char* path, size_t* index) {
+    char buffer[256];
+    path = storage_ram_normalize(path, buffer, sizeof(buffer));
+
+    for(size_t i = 0; i < storage->count; i++) {
+        if(storage->nodes[i].path && strcmp(storage->nodes[i].path, path) == 0) {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t storage_ram_create(Storage* storage, const char* path) {
+    char buffer[256];
+    path = storage_ram_normalize(path, buffer, sizeof(buffer));
+
+    // Reuse removed node first
+    for(size_t i = 0; i < storage->count; i++) {
+        if(!storage->nodes[i].path) {
+            storage->nodes[i].path = strdup(path);
+            return i;
+        }
+    }
+
+    if(storage->count == storage->capacity) {
+        storage->capacity = storage->capacity ? storage->capacity * 2 : 16;
+        storage->nodes = realloc(storage->nodes, sizeof(StorageRamNode) * storage->capacity);
+        furi_check(storage->nodes);
+    }
+
+    StorageRamNode* node = &storage->nodes[storage->count];
+    memset(node, 0, sizeof(StorageRamNode));
+    node->path = strdup(path);
+    return storage->count++;
+}
+
+static void storage_ram_reserve(StorageRamNode* node, size_t size) {
+    if(size <= node->capacity) return;
+
+    size_t capacity = node->capacity ? node->capacity : 256;
+    while(capacity < size) capacity *= 2;
+    node->data = realloc(node->data, capacity);
+    furi_check(node->data);
+    memset(node->data + node->capacity, 0, capacity - node->capacity);
+    node->capacity = capacity;
+}
+
+Storage* storage_ram_alloc(void) {
+    Storage* storage = malloc(sizeof(Storage));
+    return storage;
+}
+
+void storage_ram_free(Storage* storage) {
+    furi_assert(storage);
+
+    for(size_t i = 0; i < storage->count; i++) {
+        free(storage->nodes[i].path);
+        free(storage->nodes[i].data);
+    }
+    free(storage->nodes);
+    free(storage);
+}
+
+void storage_ram_add_file(Storage* storage, const char* path, const void* data, size_t size) {
+    furi_assert(storage);
+    furi_assert(path);
+
+    size_t index;
+    if(!storage_ram_find(storage, path, &index)) {
+        index = storage_ram_create(storage, path);
+    }
+
+    StorageRamNode* node = &storage->nodes[index];
+    storage_ram_reserve(node, size);
+    memcpy(node->data, data, size);
+    node->size = size;
+}
+
+bool storage_ram_load_file(Storage* storage, const char* path, const char* host_path) {
+    FILE* file = fopen(host_path, "rb");
+    if(!file) return false;
+
+    bool result = false;
+    do {
+        if(fseek(file, 0, SEEK_END) != 0) break;
+        long size = ftell(file);
+        if(size < 0 || fseek(file, 0, SEEK_SET) != 0) break;
+
+        uint8_t* data = malloc(size + 1);
+        if(fread(data, 1, size, file) == (size_t)size) {
+            storage_ram_add_file(storage, path, data, size);
+            result = true;
+        }
+        free(data);
+    } while(false);
+
+    fclose(file);
+    return result;
+}
+
+size_t storage_ram_get_allocated(Storage* storage) {
+    furi_assert(storage);
+
+    size_t allocated = 0;
+    for(size_t i = 0; i < storage->count; i++) {
+        allocated += storage->nodes[i].capacity;
+    }
+    return allocated;
+}
+
+File* storage_file_alloc(Storage* storage) {
+    furi_assert(storage);
+    File* file = malloc(sizeof(File));
+    file->storage = storage;
+    return file;
+}
+
+void storage_file_free(File* file) {
+    furi_assert(file);
+    if(file->is_open) storage_file_close(file);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_assert(file);
+    furi_check(!file->is_open);
+
+    if(!path) {
+        file->error = FSE_INVALID_NAME;
+        return false;
+    }
+
+    size_t index;
+    bool exists = storage_ram_find(file->storage, path, &index);
+
+    file->error = FSE_OK;
+    if(open_mode == FSOM_OPEN_EXISTING && !exists) {
+        file->error = FSE_NOT_EXIST;
+    } else if(open_mode == FSOM_CREATE_NEW && exists) {
+        file->error = FSE_EXIST;
+    }
+    if(file->error != FSE_OK) return false;
+
+    if(!exists) index = storage_ram_create(file->storage, path);
+
+    file->node = index;
+    file->access_mode = access_mode;
+    file->position = 0;
+    file->is_open = true;
+
+    if(open_mode == FSOM_CREATE_ALWAYS) {
+        file->storage->nodes[index].size = 0;
+    } else if(open_mode == FSOM_OPEN_APPEND) {
+        file->position = file->storage->nodes[index].size;
+    }
+
+    return true;
+}
+
+bool storage_file_close(File* file) {
+    furi_assert(file);
+    bool was_open = file->is_open;
+    file->is_open = false;
+    file->error = was_open ? FSE_OK : FSE_INVALID_PARAMETER;
+    return was_open;
+}
+
+bool storage_file_is_open(File* file) {
+    furi_assert(file);
+    return file->is_open;
+}
+
+uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
+    furi_assert(file);
+    if(!file->is_open || !(file->access_mode & FSAM_READ)) {
+        file->error = FSE_DENIED;
+        return 0;
+    }
+
+    StorageRamNode* node = &file->storage->nodes[file->node];
+    size_t available = node->size > file->position ? node->size - file->position : 0;
+    if(bytes_to_read > available) bytes_to_read = available;
+
+    memcpy(buff, node->data + file->position, bytes_to_read);
+    file->position += bytes_to_read;
+    file->error = FSE_OK;
+    return bytes_to_read;
+}
+
+uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
+    furi_assert(file);
+    if(!file->is_open || !(file->access_mode & FSAM_WRITE)) {
+        file->error = FSE_DENIED;
+        return 0;
+    }
+
+    StorageRamNode* node = &file->storage->nodes[file->node];
+    storage_ram_reserve(node, file->position + bytes_to_write);
+    memcpy(node->data + file->position, buff, bytes_to_write);
+    file->position += bytes_to_write;
+    if(file->position > node->size) node->size = file->position;
+    file->error = FSE_OK;
+    return bytes_to_write;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    furi_assert(file);
+    if(!file->is_open) {
+        file->error = FSE_INVALID_PARAMETER;
+        return false;
+    }
+
+    StorageRamNode* node = &file->storage->nodes[file->node];
+    size_t position = from_start ? offset : file->position + offset;
+
+    // Same as FatFs: seeking past the end expands writable file, clamps otherwise
+    if(position > node->size) {
+        if(file->access_mode & FSAM_WRITE) {
+            storage_ram_reserve(node, position);
+            node->size = position;
+        } else {
+            position = node->size;
+        }
+    }
+
+    file->position = position;
+    file->error = FSE_OK;
+    return true;
+}
+
+uint64_t storage_file_tell(File* file) {
+    furi_assert(file);
+    return file->position;
+}
+
+bool storage_file_truncate(File* file) {
+    furi_assert(file);
+    if(!file->is_open || !(file->access_mode & FSAM_WRITE)) {
+        file->error = FSE_DENIED;
+        return false;
+    }
+
+    file->storage->nodes[file->node].size = file->position;
+    file->error = FSE_OK;
+    return true;
+}
+
+uint64_t storage_file_size(File* file) {
+    furi_assert(file);
+    if(!file->is_open) return 0;
+    return file->storage->nodes[file->node].size;
+}
+
+bool storage_file_sync(File* file) {
+    furi_assert(file);
+    return file->is_open;
+}
+
+bool storage_file_eof(File* file) {
+    furi_assert(file);
+    if(!file->is_open) return true;
+    return file->position >= file->storage->nodes[file->node].size;
+}
+
+FS_Error storage_file_get_error(File* file) {
+    furi_assert(file);
+    return file->error;
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    furi_assert(storage);
+    size_t index;
+    return storage_ram_find(storage, path, &index);
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    furi_assert(storage);
+    size_t index;
+    if(!storage_ram_find(storage, path, &index)) return FSE_NOT_EXIST;
+
+    if(fileinfo) {
+        fileinfo->flags = 0;
+        fileinfo->size = storage->nodes[index].size;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
+    furi_assert(storage);
+    size_t index;
+    if(!storage_ram_find(storage, path, &index)) return FSE_NOT_EXIST;
+
+    // Not tracked, size tells changes apart
+    *timestamp = 0;
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    furi_assert(storage);
+    size_t index;
+    if(!storage_ram_find(storage, path, &index)) return FSE_NOT_EXIST;
+
+    // Slot is reused by next created file, open handles keep index
+    StorageRamNode* node = &storage->nodes[index];
+    free(node->path);
+    free(node->data);
+    memset(node, 0, sizeof(StorageRamNode));
+    return FSE_OK;
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    furi_assert(storage);
+    size_t index;
+    if(!storage_ram_find(storage, old_path, &index)) return FSE_NOT_EXIST;
+
+    // Existing destination is replaced, nodes don't move on remove
+    storage_common_remove(storage, new_path);
+    char buffer[256];
+    StorageRamNode* node = &storage->nodes[index];
+    free(node->path);
+    node->path = strdup(storage_ram_normalize(new_path, buffer, sizeof(buffer)));
+    return FSE_OK;
+}
+
+FS_Error storage_sd_status(Storage* storage) {
+    // RAM storage is always mounted
+    UNUSED(storage);
+    return FSE_OK;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error result = storage_common_remove(storage, path);
+    return result == FSE_OK || result == FSE_NOT_EXIST;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    // Directories are implicit
+    UNUSED(storage);
+    UNUSED(path);
+    return true;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    FuriString* temp_str;
+    uint16_t num = 0;
+
+    temp_str = furi_string_alloc_printf("%s/%s%s", dirname, filename, fileextension);
+
+    while(storage_common_stat(storage, furi_string_get_cstr(temp_str), NULL) == FSE_OK) {
+        num++;
+        furi_string_printf(temp_str, "%s/%s%d%s", dirname, filename, num, fileextension);
+    }
+    if(num && (max_len > strlen(filename))) {
+        furi_string_printf(nextfilename, "%s%d", filename, num);
+    } else {
+        furi_string_printf(nextfilename, "%s", filename);
+    }
+
+    furi_string_free(temp_str);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file storage_ram.h
+ * RAM backed Storage for host builds
+ *
+ * Implements the part of storage API used by streams and flipper_format.
+ * Files live in memory, directories are implicit. Paths starting with
+ * /any are the same as /ext.
+ */
+#pragma once
+
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Allocate empty storage
+ *
+ * @return     Storage instance, register it as RECORD_STORAGE
+ */
+Storage* storage_ram_alloc(void);
+
+/** Free storage and all files, files must be closed
+ *
+ * @param      storage  Storage instance
+ */
+void storage_ram_free(Storage* storage);
+
+/** Create or replace file
+ *
+ * @param      storage  Storage instance
+ * @param      path     file path
+ * @param      data     file content, copied
+ * @param      size     content size
+ */
+void storage_ram_add_file(Storage* storage, const char* path, const void* data, size_t size);
+
+/** Load file from host file system
+ *
+ * @param      storage    Storage instance
+ * @param      path       file path in storage
+ * @param      host_path  file path on host
+ *
+ * @return     true if host file was read
+ */
+bool storage_ram_load_file(Storage* storage, const char* path, const char* host_path);
+
+/** Get memory taken by file contents, what would be on SD on device
+ *
+ * @param      storage  Storage instance
+ *
+ * @return     allocated bytes of all files
+ */
+size_t storage_ram_get_allocated(Storage* storage);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,15 @@
+#include <furi.h>
+#include <lib/subghz/devices/devices.h>
+
+/* Host build: no radio devices. RAW file workers are started without a device,
+ * so they only need these two to link. */
+
+const SubGhzDevice* subghz_devices_get_by_name(const char* device_name) {
+    UNUSED(device_name);
+    return NULL;
+}
+
+bool subghz_devices_is_async_complete_tx(const SubGhzDevice* device) {
+    UNUSED(device);
+    return true;
+}
@@ -0,0 +1,311 @@
+#include <furi.h>
+
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+
+/* Host build: furi threads are pthreads, so workers and virtual radio devices
+ * run as on device. Thread flags and stream buffers are a mutex and a condition. */
+
+struct FuriThread {
+    const char* name;
+    FuriThreadCallback callback;
+    void* context;
+    pthread_t pthread;
+    bool joinable;
+    volatile FuriThreadState state;
+    int32_t return_code;
+
+    pthread_mutex_t flags_mutex;
+    pthread_cond_t flags_cond;
+    uint32_t flags;
+};
+
+struct FuriStreamBuffer {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint8_t* data;
+    size_t size;
+    size_t trigger_level;
+    size_t head;
+    size_t count;
+};
+
+static __thread FuriThread* furi_shim_thread_current;
+static pthread_once_t furi_shim_thread_main_once = PTHREAD_ONCE_INIT;
+static FuriThread furi_shim_thread_main = {.name = "main", .state = FuriThreadStateRunning};
+
+/* Deadline for a timeout in ticks, which are milliseconds on host */
+static struct timespec furi_shim_deadline(uint32_t timeout) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout / 1000;
+    ts.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if(ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+    return ts;
+}
+
+/* Wait on condition, false on timeout. Spurious wakeups are handled by callers' loops */
+static bool furi_shim_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    uint32_t timeout,
+    const struct timespec* deadline) {
+    if(timeout == FuriWaitForever) {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline) != ETIMEDOUT;
+}
+
+static void furi_shim_thread_init_sync(FuriThread* thread) {
+    pthread_mutex_init(&thread->flags_mutex, NULL);
+    pthread_cond_init(&thread->flags_cond, NULL);
+}
+
+static void furi_shim_thread_main_init(void) {
+    furi_shim_thread_init_sync(&furi_shim_thread_main);
+}
+
+static void* furi_shim_thread_body(void* context) {
+    FuriThread* thread = context;
+    furi_shim_thread_current = thread;
+    thread->state = FuriThreadStateRunning;
+    thread->return_code = thread->callback(thread->context);
+    thread->state = FuriThreadStateStopped;
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc_ex(
+    const char* name,
+    uint32_t stack_size,
+    FuriThreadCallback callback,
+    void* context) {
+    UNUSED(stack_size);
+    FuriThread* thread = malloc(sizeof(FuriThread));
+    thread->name = name;
+    thread->callback = callback;
+    thread->context = context;
+    thread->state = FuriThreadStateStopped;
+    furi_shim_thread_init_sync(thread);
+    return thread;
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+    furi_check(!thread->joinable);
+    pthread_cond_destroy(&thread->flags_cond);
+    pthread_mutex_destroy(&thread->flags_mutex);
+    free(thread);
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->state;
+}
+
+void furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_check(!thread->joinable);
+    thread->state = FuriThreadStateStarting;
+    thread->flags = 0;
+    furi_check(pthread_create(&thread->pthread, NULL, furi_shim_thread_body, thread) == 0);
+    thread->joinable = true;
+}
+
+bool furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+    furi_check(thread != furi_shim_thread_current);
+    if(!thread->joinable) return true;
+    furi_check(pthread_join(thread->pthread, NULL) == 0);
+    thread->joinable = false;
+    return true;
+}
+
+int32_t furi_thread_get_return_code(FuriThread* thread) {
+    furi_assert(thread);
+    return thread->return_code;
+}
+
+FuriThreadId furi_thread_get_id(FuriThread* thread) {
+    furi_assert(thread);
+    return thread;
+}
+
+FuriThreadId furi_thread_get_current_id() {
+    if(furi_shim_thread_current) return furi_shim_thread_current;
+    // Threads not started by furi share one id, in practice it is the runner
+    pthread_once(&furi_shim_thread_main_once, furi_shim_thread_main_init);
+    return &furi_shim_thread_main;
+}
+
+void furi_thread_yield() {
+    sched_yield();
+}
+
+uint32_t furi_thread_flags_set(FuriThreadId thread_id, uint32_t flags) {
+    FuriThread* thread = thread_id;
+    if(!thread || (flags & FuriFlagError)) return FuriFlagErrorParameter;
+
+    pthread_mutex_lock(&thread->flags_mutex);
+    thread->flags |= flags;
+    uint32_t result = thread->flags;
+    pthread_cond_broadcast(&thread->flags_cond);
+    pthread_mutex_unlock(&thread->flags_mutex);
+    return result;
+}
+
+uint32_t furi_thread_flags_clear(uint32_t flags) {
+    FuriThread* thread = furi_thread_get_current_id();
+
+    pthread_mutex_lock(&thread->flags_mutex);
+    uint32_t result = thread->flags;
+    thread->flags &= ~flags;
+    pthread_mutex_unlock(&thread->flags_mutex);
+    return result;
+}
+
+uint32_t furi_thread_flags_get(void) {
+    FuriThread* thread = furi_thread_get_current_id();
+
+    pthread_mutex_lock(&thread->flags_mutex);
+    uint32_t result = thread->flags;
+    pthread_mutex_unlock(&thread->flags_mutex);
+    return result;
+}
+
+uint32_t furi_thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    FuriThread* thread = furi_thread_get_current_id();
+    struct timespec deadline = furi_shim_deadline(timeout);
+    uint32_t result = FuriFlagErrorTimeout;
+
+    pthread_mutex_lock(&thread->flags_mutex);
+    while(true) {
+        uint32_t set = thread->flags & flags;
+        bool done = (options & FuriFlagWaitAll) ? set == flags : set != 0;
+        if(done) {
+            result = thread->flags;
+            if(!(options & FuriFlagNoClear)) thread->flags &= ~flags;
+            break;
+        }
+        if(!timeout || !furi_shim_cond_wait(
+                           &thread->flags_cond, &thread->flags_mutex, timeout, &deadline)) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&thread->flags_mutex);
+    return result;
+}
+
+FuriStreamBuffer* furi_stream_buffer_alloc(size_t size, size_t trigger_level) {
+    furi_assert(size != 0);
+    FuriStreamBuffer* stream_buffer = malloc(sizeof(FuriStreamBuffer));
+    pthread_mutex_init(&stream_buffer->mutex, NULL);
+    pthread_cond_init(&stream_buffer->cond, NULL);
+    stream_buffer->data = malloc(size);
+    stream_buffer->size = size;
+    stream_buffer->trigger_level = trigger_level ? trigger_level : 1;
+    return stream_buffer;
+}
+
+void furi_stream_buffer_free(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    pthread_cond_destroy(&stream_buffer->cond);
+    pthread_mutex_destroy(&stream_buffer->mutex);
+    free(stream_buffer->data);
+    free(stream_buffer);
+}
+
+bool furi_stream_set_trigger_level(FuriStreamBuffer* stream_buffer, size_t trigger_level) {
+    furi_assert(stream_buffer);
+    if(trigger_level > stream_buffer->size) return false;
+    pthread_mutex_lock(&stream_buffer->mutex);
+    stream_buffer->trigger_level = trigger_level ? trigger_level : 1;
+    pthread_cond_broadcast(&stream_buffer->cond);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return true;
+}
+
+size_t furi_stream_buffer_send(
+    FuriStreamBuffer* stream_buffer,
+    const void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+    struct timespec deadline = furi_shim_deadline(timeout);
+    size_t sent = 0;
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+    // Like FreeRTOS: wait for any space, then write as much as fits
+    while(stream_buffer->count == stream_buffer->size && timeout &&
+          furi_shim_cond_wait(&stream_buffer->cond, &stream_buffer->mutex, timeout, &deadline)) {
+    }
+    while(sent < length && stream_buffer->count < stream_buffer->size) {
+        size_t tail = (stream_buffer->head + stream_buffer->count) % stream_buffer->size;
+        stream_buffer->data[tail] = ((const uint8_t*)data)[sent++];
+        stream_buffer->count++;
+    }
+    if(sent) pthread_cond_broadcast(&stream_buffer->cond);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return sent;
+}
+
+size_t furi_stream_buffer_receive(
+    FuriStreamBuffer* stream_buffer,
+    void* data,
+    size_t length,
+    uint32_t timeout) {
+    furi_assert(stream_buffer);
+    struct timespec deadline = furi_shim_deadline(timeout);
+    size_t received = 0;
+
+    pthread_mutex_lock(&stream_buffer->mutex);
+    // Like FreeRTOS: wake up at trigger level, or with anything available on timeout
+    size_t wanted = MIN(stream_buffer->trigger_level, length);
+    while(stream_buffer->count < wanted && timeout &&
+          furi_shim_cond_wait(&stream_buffer->cond, &stream_buffer->mutex, timeout, &deadline)) {
+    }
+    while(received < length && stream_buffer->count) {
+        ((uint8_t*)data)[received++] = stream_buffer->data[stream_buffer->head];
+        stream_buffer->head = (stream_buffer->head + 1) % stream_buffer->size;
+        stream_buffer->count--;
+    }
+    if(received) pthread_cond_broadcast(&stream_buffer->cond);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return received;
+}
+
+size_t furi_stream_buffer_bytes_available(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    pthread_mutex_lock(&stream_buffer->mutex);
+    size_t count = stream_buffer->count;
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return count;
+}
+
+size_t furi_stream_buffer_spaces_available(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    return stream_buffer->size - furi_stream_buffer_bytes_available(stream_buffer);
+}
+
+bool furi_stream_buffer_is_full(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_spaces_available(stream_buffer) == 0;
+}
+
+bool furi_stream_buffer_is_empty(FuriStreamBuffer* stream_buffer) {
+    return furi_stream_buffer_bytes_available(stream_buffer) == 0;
+}
+
+FuriStatus furi_stream_buffer_reset(FuriStreamBuffer* stream_buffer) {
+    furi_assert(stream_buffer);
+    pthread_mutex_lock(&stream_buffer->mutex);
+    stream_buffer->head = 0;
+    stream_buffer->count = 0;
+    pthread_cond_broadcast(&stream_buffer->cond);
+    pthread_mutex_unlock(&stream_buffer->mutex);
+    return FuriStatusOk;
+}
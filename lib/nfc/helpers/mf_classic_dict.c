@@ -10,6 +10,9 @@
 #define TAG "MfClassicDict"
 
 #define NFC_MF_CLASSIC_KEY_LEN (13)
+#define MF_CLASSIC_DICT_SCAN_CHUNK_SIZE (512)
+/** Chunks read in one storage round trip while counting keys */
+#define MF_CLASSIC_DICT_SCAN_CHUNKS (4)
 
 struct MfClassicDict {
     Stream* stream;
@@ -34,78 +37,139 @@ bool mf_classic_dict_check_presence(MfClassicDictType dict_type) {
     return dict_present;
 }
 
+// Count keys the same way stream_read_line based lookup sees them: '\r' ignored, '\n' included
+static bool mf_classic_dict_scan(
+    Storage* storage,
+    const char* path,
+    uint32_t* total_keys,
+    bool* new_line_ending) {
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(MF_CLASSIC_DICT_SCAN_CHUNK_SIZE * MF_CLASSIC_DICT_SCAN_CHUNKS);
+
+    // File is opened by the first round trip, every round trip reads several chunks
+    StorageBatchOp ops[1 + MF_CLASSIC_DICT_SCAN_CHUNKS];
+    ops[0] = (StorageBatchOp){
+        .type = StorageBatchOpFileOpen,
+        .file = file,
+        .path = path,
+        .access_mode = FSAM_READ,
+        .open_mode = FSOM_OPEN_EXISTING,
+    };
+
+    bool opened = false;
+    bool eof = false;
+    FS_Error error = FSE_OK;
+    size_t line_len = 0;
+    bool is_comment = false;
+    uint8_t last_char = '\n';
+    *total_keys = 0;
+
+    do {
+        for(size_t i = 0; i < MF_CLASSIC_DICT_SCAN_CHUNKS; i++) {
+            ops[1 + i] = (StorageBatchOp){
+                .type = StorageBatchOpFileRead,
+                .file = file,
+                .buff = &buffer[i * MF_CLASSIC_DICT_SCAN_CHUNK_SIZE],
+                .size = MF_CLASSIC_DICT_SCAN_CHUNK_SIZE,
+            };
+        }
+        size_t ops_first = opened ? 1 : 0;
+        storage_batch_execute(storage, &ops[ops_first], COUNT_OF(ops) - ops_first, true);
+
+        if(!opened) {
+            // Batch doesn't wait for the file to be closed, storage_file_open does
+            if(ops[0].error == FSE_ALREADY_OPEN) {
+                storage_file_close(file);
+                opened = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+                error = opened ? FSE_OK : storage_file_get_error(file);
+                // Reads were skipped, nothing was consumed yet
+                continue;
+            }
+            error = ops[0].error;
+            if(error != FSE_OK) break;
+            opened = true;
+        }
+
+        for(size_t i = 1; (i < COUNT_OF(ops)) && !eof; i++) {
+            error = ops[i].error;
+            if(error != FSE_OK) break;
+
+            const uint8_t* chunk = ops[i].buff;
+            for(uint16_t j = 0; j < ops[i].bytes_read; j++) {
+                if(chunk[j] == '\r') continue;
+                if(line_len == 0) is_comment = (chunk[j] == '#');
+                line_len++;
+                if(chunk[j] == '\n') {
+                    if(!is_comment && line_len == NFC_MF_CLASSIC_KEY_LEN) (*total_keys)++;
+                    line_len = 0;
+                }
+            }
+            if(ops[i].bytes_read > 0) last_char = chunk[ops[i].bytes_read - 1];
+            eof = ops[i].bytes_read < ops[i].size;
+        }
+    } while(!eof && (error == FSE_OK));
+
+    // Last line will get new line ending appended
+    if(!is_comment && line_len + 1 == NFC_MF_CLASSIC_KEY_LEN) (*total_keys)++;
+    *new_line_ending = (last_char == '\n');
+
+    storage_file_close(file);
+    storage_file_free(file);
+    free(buffer);
+
+    return (error == FSE_OK) || (!opened && (error == FSE_NOT_EXIST));
+}
+
 MfClassicDict* mf_classic_dict_alloc(MfClassicDictType dict_type) {
     MfClassicDict* dict = malloc(sizeof(MfClassicDict));
     Storage* storage = furi_record_open(RECORD_STORAGE);
     dict->stream = buffered_file_stream_alloc(storage);
-    furi_record_close(RECORD_STORAGE);
+    dict->total_keys = 0;
+
+    const char* path = NULL;
+    FS_OpenMode open_mode = FSOM_OPEN_ALWAYS;
+    if(dict_type == MfClassicDictTypeSystem) {
+        path = MF_CLASSIC_DICT_FLIPPER_PATH;
+        open_mode = FSOM_OPEN_EXISTING;
+    } else if(dict_type == MfClassicDictTypeUser) {
+        path = MF_CLASSIC_DICT_USER_PATH;
+    } else if(dict_type == MfClassicDictTypeUnitTest) {
+        path = MF_CLASSIC_DICT_UNIT_TEST_PATH;
+    }
 
     bool dict_loaded = false;
     do {
-        if(dict_type == MfClassicDictTypeSystem) {
-            if(!buffered_file_stream_open(
-                   dict->stream,
-                   MF_CLASSIC_DICT_FLIPPER_PATH,
-                   FSAM_READ_WRITE,
-                   FSOM_OPEN_EXISTING)) {
-                buffered_file_stream_close(dict->stream);
-                break;
-            }
-        } else if(dict_type == MfClassicDictTypeUser) {
-            if(!buffered_file_stream_open(
-                   dict->stream, MF_CLASSIC_DICT_USER_PATH, FSAM_READ_WRITE, FSOM_OPEN_ALWAYS)) {
-                buffered_file_stream_close(dict->stream);
-                break;
-            }
-        } else if(dict_type == MfClassicDictTypeUnitTest) {
-            if(!buffered_file_stream_open(
-                   dict->stream,
-                   MF_CLASSIC_DICT_UNIT_TEST_PATH,
-                   FSAM_READ_WRITE,
-                   FSOM_OPEN_ALWAYS)) {
-                buffered_file_stream_close(dict->stream);
-                break;
-            }
+        if(!path) break;
+
+        // Read total amount of keys
+        bool new_line_ending = true;
+        if(!mf_classic_dict_scan(storage, path, &dict->total_keys, &new_line_ending)) {
+            FURI_LOG_E(TAG, "Failed to scan dictionary");
+            break;
         }
 
-        // Check for new line ending
-        if(!stream_eof(dict->stream)) {
-            if(!stream_seek(dict->stream, -1, StreamOffsetFromEnd)) break;
-            uint8_t last_char = 0;
-            if(stream_read(dict->stream, &last_char, 1) != 1) break;
-            if(last_char != '\n') {
-                FURI_LOG_D(TAG, "Adding new line ending");
-                if(stream_write_char(dict->stream, '\n') != 1) break;
-            }
-            if(!stream_rewind(dict->stream)) break;
+        if(!buffered_file_stream_open(dict->stream, path, FSAM_READ_WRITE, open_mode)) {
+            buffered_file_stream_close(dict->stream);
+            break;
         }
 
-        // Read total amount of keys
-        FuriString* next_line;
-        next_line = furi_string_alloc();
-        while(true) {
-            if(!stream_read_line(dict->stream, next_line)) {
-                FURI_LOG_T(TAG, "No keys left in dict");
-                break;
-            }
-            FURI_LOG_T(
-                TAG,
-                "Read line: %s, len: %zu",
-                furi_string_get_cstr(next_line),
-                furi_string_size(next_line));
-            if(furi_string_get_char(next_line, 0) == '#') continue;
-            if(furi_string_size(next_line) != NFC_MF_CLASSIC_KEY_LEN) continue;
-            dict->total_keys++;
+        // Check for new line ending
+        if(!new_line_ending) {
+            FURI_LOG_D(TAG, "Adding new line ending");
+            if(!stream_seek(dict->stream, 0, StreamOffsetFromEnd)) break;
+            if(stream_write_char(dict->stream, '\n') != 1) break;
+            if(!stream_rewind(dict->stream)) break;
         }
-        furi_string_free(next_line);
-        stream_rewind(dict->stream);
 
         dict_loaded = true;
         FURI_LOG_I(TAG, "Loaded dictionary with %lu keys", dict->total_keys);
     } while(false);
 
+    furi_record_close(RECORD_STORAGE);
+
     if(!dict_loaded) {
         buffered_file_stream_close(dict->stream);
+        stream_free(dict->stream);
         free(dict);
         dict = NULL;
     }
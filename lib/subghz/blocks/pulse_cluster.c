@@ -0,0 +1,92 @@
+#include "pulse_cluster.h"
+#include "math.h"
+
+#include <furi.h>
+
+#define TAG "SubGhzBlockPulseCluster"
+
+void subghz_protocol_blocks_pulse_cluster_init(
+    SubGhzBlockPulseCluster* cluster,
+    uint8_t class_limit,
+    uint8_t tolerance_div,
+    float weight) {
+    furi_assert(cluster);
+    furi_assert(class_limit && class_limit <= SUBGHZ_BLOCK_PULSE_CLUSTER_CLASS_MAX);
+    furi_assert(tolerance_div);
+
+    cluster->class_limit = class_limit;
+    cluster->tolerance_div = tolerance_div;
+    cluster->weight = weight;
+    subghz_protocol_blocks_pulse_cluster_reset(cluster);
+}
+
+void subghz_protocol_blocks_pulse_cluster_reset(SubGhzBlockPulseCluster* cluster) {
+    furi_assert(cluster);
+    memset(cluster->classes, 0x00, sizeof(cluster->classes));
+    cluster->class_count = 0;
+    cluster->pulse_count = 0;
+    cluster->unmatched_count = 0;
+}
+
+int32_t subghz_protocol_blocks_pulse_cluster_add(
+    SubGhzBlockPulseCluster* cluster,
+    uint32_t duration) {
+    furi_assert(cluster);
+    cluster->pulse_count++;
+
+    float value = (float)duration;
+    for(uint8_t k = 0; k < cluster->class_count; k++) {
+        SubGhzBlockPulseClass* item = &cluster->classes[k];
+        if(DURATION_DIFF(value, item->duration) < item->duration / cluster->tolerance_div) {
+            item->count++;
+            if(cluster->weight > 0.0f) {
+                item->duration += (value - item->duration) * cluster->weight;
+            } else {
+                item->duration += (value - item->duration) / item->count;
+            }
+            return k;
+        }
+    }
+
+    if(cluster->class_count == cluster->class_limit) {
+        cluster->unmatched_count++;
+        return -1;
+    }
+
+    SubGhzBlockPulseClass* item = &cluster->classes[cluster->class_count];
+    item->duration = value;
+    item->count = 1;
+    return cluster->class_count++;
+}
+
+size_t subghz_protocol_blocks_pulse_cluster_get_ranked(
+    SubGhzBlockPulseCluster* cluster,
+    SubGhzBlockPulseClass* ranked) {
+    furi_assert(cluster);
+    furi_assert(ranked);
+
+    // Insertion sort: few classes, stable
+    for(size_t i = 0; i < cluster->class_count; i++) {
+        size_t position = i;
+        while(position > 0 && ranked[position - 1].count < cluster->classes[i].count) {
+            ranked[position] = ranked[position - 1];
+            position--;
+        }
+        ranked[position] = cluster->classes[i];
+    }
+    return cluster->class_count;
+}
+
+uint32_t subghz_protocol_blocks_pulse_cluster_get_shortest(
+    SubGhzBlockPulseCluster* cluster,
+    uint32_t min_count) {
+    furi_assert(cluster);
+
+    float shortest = 0.0f;
+    for(size_t i = 0; i < cluster->class_count; i++) {
+        const SubGhzBlockPulseClass* item = &cluster->classes[i];
+        if(item->count < min_count) continue;
+        if(shortest == 0.0f || item->duration < shortest) shortest = item->duration;
+    }
+    return (uint32_t)shortest;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_BLOCK_PULSE_CLUSTER_CLASS_MAX 20
+
+/** Pulse width class: centroid and member count */
+typedef struct {
+    float duration;
+    uint32_t count;
+} SubGhzBlockPulseClass;
+
+typedef struct SubGhzBlockPulseCluster SubGhzBlockPulseCluster;
+
+/** Online pulse width clustering
+ *
+ * Pulses are added one by one as they arrive, each one costs at most class_limit
+ * comparisons, nothing is kept but the classes. Pulse joins the first class whose
+ * centroid is closer than centroid / tolerance_div, otherwise opens a new class.
+ * When all classes are taken, unmatched pulses are only counted.
+ */
+struct SubGhzBlockPulseCluster {
+    SubGhzBlockPulseClass classes[SUBGHZ_BLOCK_PULSE_CLUSTER_CLASS_MAX];
+    uint8_t class_count;
+    uint8_t class_limit;
+    uint8_t tolerance_div;
+    float weight;
+    uint32_t pulse_count;
+    uint32_t unmatched_count;
+};
+
+/**
+ * Set up clustering, classes are cleared.
+ * @param cluster Pointer to a SubGhzBlockPulseCluster instance
+ * @param class_limit max class count, up to SUBGHZ_BLOCK_PULSE_CLUSTER_CLASS_MAX
+ * @param tolerance_div pulse matches class if it is closer than centroid / tolerance_div
+ * @param weight centroid running average weight, 0 for plain mean of all members
+ */
+void subghz_protocol_blocks_pulse_cluster_init(
+    SubGhzBlockPulseCluster* cluster,
+    uint8_t class_limit,
+    uint8_t tolerance_div,
+    float weight);
+
+/**
+ * Clear classes and counters, settings are kept.
+ * @param cluster Pointer to a SubGhzBlockPulseCluster instance
+ */
+void subghz_protocol_blocks_pulse_cluster_reset(SubGhzBlockPulseCluster* cluster);
+
+/**
+ * Add pulse.
+ * @param cluster Pointer to a SubGhzBlockPulseCluster instance
+ * @param duration pulse duration, us
+ * @return class index, -1 if pulse matches no class and there is no free one
+ */
+int32_t subghz_protocol_blocks_pulse_cluster_add(
+    SubGhzBlockPulseCluster* cluster,
+    uint32_t duration);
+
+/**
+ * Get classes ordered by member count, most common first. Classes with equal
+ * count keep the order they were opened in.
+ * @param cluster Pointer to a SubGhzBlockPulseCluster instance
+ * @param ranked output, room for class_limit classes
+ * @return class count
+ */
+size_t subghz_protocol_blocks_pulse_cluster_get_ranked(
+    SubGhzBlockPulseCluster* cluster,
+    SubGhzBlockPulseClass* ranked);
+
+/**
+ * Get shortest class centroid.
+ * @param cluster Pointer to a SubGhzBlockPulseCluster instance
+ * @param min_count classes with fewer members are ignored
+ * @return centroid, us, 0 if there is no such class
+ */
+uint32_t subghz_protocol_blocks_pulse_cluster_get_shortest(
+    SubGhzBlockPulseCluster* cluster,
+    uint32_t min_count);
+
+#ifdef __cplusplus
+}
+#endif
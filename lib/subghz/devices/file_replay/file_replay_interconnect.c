@@ -0,0 +1,538 @@
+#include "file_replay_interconnect.h"
+#include "../../types.h"
+
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "SubGhzDeviceFileReplay"
+
+// Same as longest RAW_Data line written by RAW protocol
+#define SUBGHZ_DEVICE_FILE_REPLAY_CHUNK 512
+// Longer level is a gap between packets, not a part of them
+#define SUBGHZ_DEVICE_FILE_REPLAY_GAP_US 20000
+#define SUBGHZ_DEVICE_FILE_REPLAY_RSSI_SIGNAL (-40.0f)
+#define SUBGHZ_DEVICE_FILE_REPLAY_RSSI_NOISE (-100.0f)
+// Max sleep between checks of stop request
+#define SUBGHZ_DEVICE_FILE_REPLAY_WAIT_MS 10
+// Follows 0x00 0x00 terminator of CC1101 register pairs in preset data
+#define SUBGHZ_DEVICE_FILE_REPLAY_PA_TABLE_SIZE 8
+
+typedef struct {
+    FuriString* source_path;
+    FuriString* capture_path;
+    SubGhzDeviceFileReplayPacing pacing;
+    uint32_t source_frequency;
+    // Tick of realtime source start, valid if on_air
+    uint32_t air_start;
+    bool on_air;
+    float rssi_signal;
+    float rssi_noise;
+
+    uint32_t frequency;
+    FuriHalSubGhzPreset preset;
+    uint8_t* preset_data;
+    size_t preset_data_size;
+
+    FuriThread* thread;
+    void* callback;
+    void* context;
+    volatile bool running;
+    volatile bool rx_complete;
+    volatile bool tx_complete;
+    volatile float rssi;
+} SubGhzDeviceFileReplay;
+
+typedef struct {
+    FlipperFormat* flipper_format; // RAW .sub file
+    File* file; // Binary capture
+    FuriString* temp_str;
+} SubGhzDeviceFileReplaySource;
+
+static SubGhzDeviceFileReplay subghz_device_file_replay_state = {
+    .pacing = SubGhzDeviceFileReplayPacingRealtime,
+    .rssi_signal = SUBGHZ_DEVICE_FILE_REPLAY_RSSI_SIGNAL,
+    .rssi_noise = SUBGHZ_DEVICE_FILE_REPLAY_RSSI_NOISE,
+    .frequency = 433920000,
+    .preset = FuriHalSubGhzPresetOok650Async,
+    .rx_complete = true,
+    .tx_complete = true,
+    .rssi = SUBGHZ_DEVICE_FILE_REPLAY_RSSI_NOISE,
+};
+
+void subghz_device_file_replay_set_source(const char* path, SubGhzDeviceFileReplayPacing pacing) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    furi_check(!instance->thread);
+
+    if(path) {
+        if(!instance->source_path) instance->source_path = furi_string_alloc();
+        furi_string_set(instance->source_path, path);
+    } else if(instance->source_path) {
+        furi_string_free(instance->source_path);
+        instance->source_path = NULL;
+    }
+    instance->pacing = pacing;
+    instance->on_air = false;
+}
+
+void subghz_device_file_replay_set_source_frequency(uint32_t frequency) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    furi_check(!instance->thread);
+    instance->source_frequency = frequency;
+}
+
+void subghz_device_file_replay_set_capture(const char* path) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    furi_check(!instance->thread);
+
+    if(path) {
+        if(!instance->capture_path) instance->capture_path = furi_string_alloc();
+        furi_string_set(instance->capture_path, path);
+    } else if(instance->capture_path) {
+        furi_string_free(instance->capture_path);
+        instance->capture_path = NULL;
+    }
+}
+
+void subghz_device_file_replay_set_rssi(float signal, float noise) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    instance->rssi_signal = signal;
+    instance->rssi_noise = noise;
+    instance->rssi = noise;
+}
+
+bool subghz_device_file_replay_is_rx_complete(void) {
+    return subghz_device_file_replay_state.rx_complete;
+}
+
+/** Sleep until the edge is due, wakes up early on stop request
+ *
+ * @param      start       Tick of playback start
+ * @param      played_us   Playback time of the edge
+ */
+static void subghz_device_file_replay_wait(uint32_t start, uint64_t played_us) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    uint32_t due = start + furi_ms_to_ticks(played_us / 1000);
+
+    while(instance->running) {
+        int32_t left = (int32_t)(due - furi_get_tick());
+        if(left <= 0) break;
+        furi_delay_tick(MIN((uint32_t)left, furi_ms_to_ticks(SUBGHZ_DEVICE_FILE_REPLAY_WAIT_MS)));
+    }
+}
+
+static bool subghz_device_file_replay_source_open(
+    SubGhzDeviceFileReplaySource* source,
+    Storage* storage,
+    FuriString* path) {
+    bool result = false;
+
+    if(furi_string_end_with_str(path, SUBGHZ_APP_EXTENSION)) {
+        source->flipper_format = flipper_format_buffered_file_alloc(storage);
+        source->temp_str = furi_string_alloc();
+        uint32_t version;
+        do {
+            if(!flipper_format_buffered_file_open_existing(
+                   source->flipper_format, furi_string_get_cstr(path))) {
+                break;
+            }
+            if(!flipper_format_read_header(source->flipper_format, source->temp_str, &version)) {
+                break;
+            }
+            if(!flipper_format_read_string(source->flipper_format, "Protocol", source->temp_str) ||
+               furi_string_cmp_str(source->temp_str, "RAW")) {
+                FURI_LOG_E(TAG, "Not a RAW file");
+                break;
+            }
+            result = true;
+        } while(false);
+    } else {
+        source->file = storage_file_alloc(storage);
+        result = storage_file_open(
+            source->file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING);
+    }
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Unable to open source: %s", furi_string_get_cstr(path));
+    }
+    return result;
+}
+
+/** Read next block of samples
+ *
+ * @return     Number of samples read, 0 at the end of the source
+ */
+static size_t subghz_device_file_replay_source_read(
+    SubGhzDeviceFileReplaySource* source,
+    int32_t* buffer) {
+    size_t count = 0;
+
+    if(source->flipper_format) {
+        uint32_t line_count;
+        if(flipper_format_get_value_count(source->flipper_format, "RAW_Data", &line_count) &&
+           line_count <= SUBGHZ_DEVICE_FILE_REPLAY_CHUNK &&
+           flipper_format_read_int32(source->flipper_format, "RAW_Data", buffer, line_count)) {
+            count = line_count;
+        }
+    } else {
+        count = storage_file_read(
+                    source->file, buffer, SUBGHZ_DEVICE_FILE_REPLAY_CHUNK * sizeof(int32_t)) /
+                sizeof(int32_t);
+    }
+
+    return count;
+}
+
+static void subghz_device_file_replay_source_close(SubGhzDeviceFileReplaySource* source) {
+    if(source->flipper_format) flipper_format_free(source->flipper_format);
+    if(source->temp_str) furi_string_free(source->temp_str);
+    if(source->file) storage_file_free(source->file);
+}
+
+static int32_t subghz_device_file_replay_rx_thread(void* context) {
+    SubGhzDeviceFileReplay* instance = context;
+    FuriHalSubGhzCaptureCallback callback = instance->callback;
+    bool realtime = instance->pacing == SubGhzDeviceFileReplayPacingRealtime;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzDeviceFileReplaySource source = {0};
+    int32_t* buffer = malloc(sizeof(int32_t) * SUBGHZ_DEVICE_FILE_REPLAY_CHUNK);
+    uint64_t played_us = 0;
+    uint32_t start = realtime ? instance->air_start : furi_get_tick();
+    // Air time before this start, not heard
+    uint64_t joined_us =
+        (uint64_t)(furi_get_tick() - start) * 1000000 / furi_kernel_get_tick_frequency();
+    bool tuned = !instance->source_frequency ||
+                 instance->frequency == instance->source_frequency;
+
+    if(subghz_device_file_replay_source_open(&source, storage, instance->source_path)) {
+        size_t count;
+        while(instance->running &&
+              (count = subghz_device_file_replay_source_read(&source, buffer))) {
+            for(size_t i = 0; i < count && instance->running; i++) {
+                bool level = buffer[i] > 0;
+                uint32_t duration = level ? buffer[i] : -buffer[i];
+                if(realtime) {
+                    played_us += duration;
+                    if(played_us <= joined_us) continue;
+                    // Level in progress at start is heard from the start
+                    duration = MIN(duration, played_us - joined_us);
+                }
+                instance->rssi = tuned && duration < SUBGHZ_DEVICE_FILE_REPLAY_GAP_US ?
+                                     instance->rssi_signal :
+                                     instance->rssi_noise;
+                // Capture callback is called at the end of the level
+                if(realtime) subghz_device_file_replay_wait(start, played_us);
+                if(tuned) callback(level, duration, instance->context);
+            }
+            // Let receiver drain its buffer, burst is smaller than one
+            if(!realtime) furi_delay_tick(1);
+        }
+    }
+
+    instance->rssi = instance->rssi_noise;
+    instance->rx_complete = true;
+    free(buffer);
+    subghz_device_file_replay_source_close(&source);
+    furi_record_close(RECORD_STORAGE);
+    return 0;
+}
+
+static bool
+    subghz_device_file_replay_capture_open(FlipperFormat* flipper_format, FuriString* path) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    bool result = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_always(flipper_format, furi_string_get_cstr(path))) {
+            break;
+        }
+        if(!flipper_format_write_header_cstr(
+               flipper_format, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION)) {
+            break;
+        }
+        if(!flipper_format_write_uint32(flipper_format, "Frequency", &instance->frequency, 1)) {
+            break;
+        }
+
+        const char* preset_name = "FuriHalSubGhzPresetCustom";
+        switch(instance->preset) {
+        case FuriHalSubGhzPresetOok270Async:
+            preset_name = "FuriHalSubGhzPresetOok270Async";
+            break;
+        case FuriHalSubGhzPresetOok650Async:
+            preset_name = "FuriHalSubGhzPresetOok650Async";
+            break;
+        case FuriHalSubGhzPreset2FSKDev238Async:
+            preset_name = "FuriHalSubGhzPreset2FSKDev238Async";
+            break;
+        case FuriHalSubGhzPreset2FSKDev476Async:
+            preset_name = "FuriHalSubGhzPreset2FSKDev476Async";
+            break;
+        default:
+            break;
+        }
+        if(!flipper_format_write_string_cstr(flipper_format, "Preset", preset_name)) break;
+        if(instance->preset_data) {
+            if(!flipper_format_write_string_cstr(
+                   flipper_format, "Custom_preset_module", "CC1101")) {
+                break;
+            }
+            if(!flipper_format_write_hex(
+                   flipper_format,
+                   "Custom_preset_data",
+                   instance->preset_data,
+                   instance->preset_data_size)) {
+                break;
+            }
+        }
+        if(!flipper_format_write_string_cstr(flipper_format, "Protocol", "RAW")) break;
+        result = true;
+    } while(false);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Unable to open capture: %s", furi_string_get_cstr(path));
+    }
+    return result;
+}
+
+static int32_t subghz_device_file_replay_tx_thread(void* context) {
+    SubGhzDeviceFileReplay* instance = context;
+    FuriHalSubGhzAsyncTxCallback callback = instance->callback;
+    bool realtime = instance->pacing == SubGhzDeviceFileReplayPacingRealtime;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = NULL;
+    if(instance->capture_path) {
+        flipper_format = flipper_format_buffered_file_alloc(storage);
+        if(!subghz_device_file_replay_capture_open(flipper_format, instance->capture_path)) {
+            flipper_format_free(flipper_format);
+            flipper_format = NULL;
+        }
+    }
+
+    int32_t* buffer = malloc(sizeof(int32_t) * SUBGHZ_DEVICE_FILE_REPLAY_CHUNK);
+    size_t count = 0;
+    // Encoders may yield the same level twice, RAW needs alternating levels
+    int32_t pending = 0;
+    uint64_t played_us = 0;
+    uint32_t start = furi_get_tick();
+
+    while(instance->running) {
+        LevelDuration level_duration = callback(instance->context);
+        if(level_duration_is_reset(level_duration)) break;
+        if(level_duration_is_wait(level_duration)) {
+            furi_delay_tick(1);
+            continue;
+        }
+
+        bool level = level_duration_get_level(level_duration);
+        uint32_t duration = level_duration_get_duration(level_duration);
+        if(pending && (pending > 0) == level) {
+            pending += level ? (int32_t)duration : -(int32_t)duration;
+            continue;
+        }
+
+        if(pending) {
+            buffer[count++] = pending;
+            if(count == SUBGHZ_DEVICE_FILE_REPLAY_CHUNK) {
+                if(flipper_format) {
+                    flipper_format_write_int32(flipper_format, "RAW_Data", buffer, count);
+                }
+                count = 0;
+                if(!realtime) furi_delay_tick(1);
+            }
+        }
+        pending = level ? (int32_t)duration : -(int32_t)duration;
+
+        if(realtime) {
+            played_us += duration;
+            subghz_device_file_replay_wait(start, played_us);
+        }
+    }
+
+    if(pending) buffer[count++] = pending;
+    if(flipper_format) {
+        if(count) flipper_format_write_int32(flipper_format, "RAW_Data", buffer, count);
+        flipper_format_free(flipper_format);
+    }
+    free(buffer);
+    furi_record_close(RECORD_STORAGE);
+
+    instance->tx_complete = true;
+    return 0;
+}
+
+static void subghz_device_file_replay_start(
+    FuriThreadCallback thread_callback,
+    void* callback,
+    void* context) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    furi_check(!instance->thread);
+
+    instance->callback = callback;
+    instance->context = context;
+    instance->running = true;
+    instance->thread = furi_thread_alloc_ex("SubGhzFileReplay", 2048, thread_callback, instance);
+    furi_thread_start(instance->thread);
+}
+
+static void subghz_device_file_replay_stop(void) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    if(!instance->thread) return;
+
+    instance->running = false;
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    instance->thread = NULL;
+}
+
+static bool subghz_device_file_replay_interconnect_is_connect(void) {
+    return true;
+}
+
+static void subghz_device_file_replay_interconnect_reset(void) {
+    subghz_device_file_replay_stop();
+}
+
+static void subghz_device_file_replay_interconnect_idle(void) {
+    subghz_device_file_replay_stop();
+}
+
+static void subghz_device_file_replay_interconnect_load_preset(
+    FuriHalSubGhzPreset preset,
+    uint8_t* preset_data) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    instance->preset = preset;
+
+    free(instance->preset_data);
+    instance->preset_data = NULL;
+    instance->preset_data_size = 0;
+    if(preset == FuriHalSubGhzPresetCustom && preset_data) {
+        size_t size = 0;
+        while(preset_data[size]) {
+            size += 2;
+        }
+        size += 2 + SUBGHZ_DEVICE_FILE_REPLAY_PA_TABLE_SIZE;
+        instance->preset_data = malloc(size);
+        memcpy(instance->preset_data, preset_data, size);
+        instance->preset_data_size = size;
+    }
+}
+
+static uint32_t subghz_device_file_replay_interconnect_set_frequency(uint32_t frequency) {
+    subghz_device_file_replay_state.frequency = frequency;
+    return frequency;
+}
+
+static bool subghz_device_file_replay_interconnect_is_frequency_valid(uint32_t frequency) {
+    UNUSED(frequency);
+    return true;
+}
+
+static void subghz_device_file_replay_interconnect_set_async_mirror_pin(const GpioPin* gpio) {
+    UNUSED(gpio);
+}
+
+static const GpioPin* subghz_device_file_replay_interconnect_get_data_gpio(void) {
+    return NULL;
+}
+
+static bool subghz_device_file_replay_interconnect_set_tx(void) {
+    return true;
+}
+
+static void subghz_device_file_replay_interconnect_flush(void) {
+}
+
+static bool subghz_device_file_replay_interconnect_start_async_tx(void* callback, void* context) {
+    subghz_device_file_replay_state.tx_complete = false;
+    subghz_device_file_replay_start(subghz_device_file_replay_tx_thread, callback, context);
+    return true;
+}
+
+static bool subghz_device_file_replay_interconnect_is_async_complete_tx(void) {
+    return subghz_device_file_replay_state.tx_complete;
+}
+
+static void subghz_device_file_replay_interconnect_set_rx(void) {
+}
+
+static void subghz_device_file_replay_interconnect_start_async_rx(void* callback, void* context) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    instance->rx_complete = !instance->source_path;
+    if(instance->rx_complete) return;
+
+    if(!instance->on_air) {
+        instance->air_start = furi_get_tick();
+        instance->on_air = true;
+    }
+
+    subghz_device_file_replay_start(subghz_device_file_replay_rx_thread, callback, context);
+}
+
+static float subghz_device_file_replay_interconnect_get_rssi(void) {
+    SubGhzDeviceFileReplay* instance = &subghz_device_file_replay_state;
+    return instance->thread ? instance->rssi : instance->rssi_noise;
+}
+
+static uint8_t subghz_device_file_replay_interconnect_get_lqi(void) {
+    return 0;
+}
+
+static bool subghz_device_file_replay_interconnect_rx_pipe_not_empty(void) {
+    return false;
+}
+
+static bool subghz_device_file_replay_interconnect_is_rx_data_crc_valid(void) {
+    return false;
+}
+
+static void subghz_device_file_replay_interconnect_read_packet(uint8_t* data, uint8_t* size) {
+    UNUSED(data);
+    *size = 0;
+}
+
+static void
+    subghz_device_file_replay_interconnect_write_packet(const uint8_t* data, uint8_t size) {
+    UNUSED(data);
+    UNUSED(size);
+}
+
+const SubGhzDeviceInterconnect subghz_device_file_replay_interconnect = {
+    .begin = NULL,
+    .end = subghz_device_file_replay_stop,
+    .is_connect = subghz_device_file_replay_interconnect_is_connect,
+    .reset = subghz_device_file_replay_interconnect_reset,
+    .sleep = subghz_device_file_replay_interconnect_idle,
+    .idle = subghz_device_file_replay_interconnect_idle,
+    .load_preset = subghz_device_file_replay_interconnect_load_preset,
+    .set_frequency = subghz_device_file_replay_interconnect_set_frequency,
+    .is_frequency_valid = subghz_device_file_replay_interconnect_is_frequency_valid,
+    .set_async_mirror_pin = subghz_device_file_replay_interconnect_set_async_mirror_pin,
+    .get_data_gpio = subghz_device_file_replay_interconnect_get_data_gpio,
+
+    .set_tx = subghz_device_file_replay_interconnect_set_tx,
+    .flush_tx = subghz_device_file_replay_interconnect_flush,
+    .start_async_tx = subghz_device_file_replay_interconnect_start_async_tx,
+    .is_async_complete_tx = subghz_device_file_replay_interconnect_is_async_complete_tx,
+    .stop_async_tx = subghz_device_file_replay_stop,
+
+    .set_rx = subghz_device_file_replay_interconnect_set_rx,
+    .flush_rx = subghz_device_file_replay_interconnect_flush,
+    .start_async_rx = subghz_device_file_replay_interconnect_start_async_rx,
+    .stop_async_rx = subghz_device_file_replay_stop,
+
+    .get_rssi = subghz_device_file_replay_interconnect_get_rssi,
+    .get_lqi = subghz_device_file_replay_interconnect_get_lqi,
+
+    .rx_pipe_not_empty = subghz_device_file_replay_interconnect_rx_pipe_not_empty,
+    .is_rx_data_crc_valid = subghz_device_file_replay_interconnect_is_rx_data_crc_valid,
+    .read_packet = subghz_device_file_replay_interconnect_read_packet,
+    .write_packet = subghz_device_file_replay_interconnect_write_packet,
+};
+
+const SubGhzDevice subghz_device_file_replay = {
+    .name = SUBGHZ_DEVICE_FILE_REPLAY_NAME,
+    .interconnect = &subghz_device_file_replay_interconnect,
+};
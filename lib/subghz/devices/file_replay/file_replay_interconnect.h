@@ -0,0 +1,62 @@
+#pragma once
+#include "../types.h"
+
+#define SUBGHZ_DEVICE_FILE_REPLAY_NAME "file_replay"
+
+/** Virtual radio device.
+ *
+ * Async RX plays a capture file instead of listening to the air, async TX is
+ * captured into a RAW .sub file. Used to benchmark decode latency and to
+ * regression test receiver logic (hopper, RSSI threshold) without a radio.
+ *
+ * Sources are RAW .sub files or binary captures: little-endian int32
+ * durations in us, sign is the level, same as RAW_Data values.
+ */
+
+typedef enum {
+    SubGhzDeviceFileReplayPacingRealtime, /**< Deliver every edge at its time */
+    SubGhzDeviceFileReplayPacingFast, /**< As fast as the receiver keeps up */
+} SubGhzDeviceFileReplayPacing;
+
+/** Set file played by async RX, applies to the next start
+ *
+ * Realtime source is on the air from the first RX start after this call: RX
+ * started again later, e.g. after retune, joins it where it is now and misses
+ * what was played meanwhile. Fast source is played from the start every time.
+ *
+ * @param      path    RAW .sub or binary capture, NULL to receive nothing
+ * @param      pacing  Pacing of RX playback and TX capture
+ */
+void subghz_device_file_replay_set_source(const char* path, SubGhzDeviceFileReplayPacing pacing);
+
+/** Set frequency the source is heard on
+ *
+ * Tuned elsewhere RX gets no edges and noise RSSI, source keeps playing.
+ *
+ * @param      frequency  frequency, Hz. 0 to hear the source on any frequency
+ */
+void subghz_device_file_replay_set_source_frequency(uint32_t frequency);
+
+/** Set file async TX is written to, applies to the next start
+ *
+ * @param      path  RAW .sub file, overwritten. NULL to discard TX
+ */
+void subghz_device_file_replay_set_capture(const char* path);
+
+/** Set synthetic RSSI track
+ *
+ * get_rssi returns signal level while pulses are played and noise level
+ * during long gaps, after the end of the source and outside of RX.
+ *
+ * @param      signal  RSSI of the signal, dBm
+ * @param      noise   RSSI of the noise floor, dBm
+ */
+void subghz_device_file_replay_set_rssi(float signal, float noise);
+
+/** Whole source was played since last async RX start
+ *
+ * @return     true if playback is over
+ */
+bool subghz_device_file_replay_is_rx_complete(void);
+
+extern const SubGhzDevice subghz_device_file_replay;
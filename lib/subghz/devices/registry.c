@@ -1,6 +1,7 @@
 #include "registry.h"
 
 #include "cc1101_int/cc1101_int_interconnect.h"
+#include "file_replay/file_replay_interconnect.h"
 #include <flipper_application/plugins/plugin_manager.h>
 #include <loader/firmware_api/firmware_api.h>
 
@@ -29,12 +30,13 @@ void subghz_device_registry_init(void) {
         FURI_LOG_E(TAG, "Failed to load all libs");
     }
 
-    subghz_device->size = plugin_manager_get_count(subghz_device->manager) + 1;
+    subghz_device->size = plugin_manager_get_count(subghz_device->manager) + 2;
     subghz_device->items =
         (const SubGhzDevice**)malloc(sizeof(SubGhzDevice*) * subghz_device->size);
     subghz_device->items[0] = &subghz_device_cc1101_int;
-    for(uint32_t i = 1; i < subghz_device->size; i++) {
-        const SubGhzDevice* plugin = plugin_manager_get_ep(subghz_device->manager, i - 1);
+    subghz_device->items[1] = &subghz_device_file_replay;
+    for(uint32_t i = 2; i < subghz_device->size; i++) {
+        const SubGhzDevice* plugin = plugin_manager_get_ep(subghz_device->manager, i - 2);
         subghz_device->items[i] = plugin;
     }
 
@@ -1,9 +1,18 @@
 #include "environment.h"
 #include "registry.h"
 
+#define TAG "SubGhzEnvironment"
+
+// Seeds tried on one table size before it is doubled
+#define SUBGHZ_ENVIRONMENT_NAME_SEED_TRIES 32
+
 struct SubGhzEnvironment {
     SubGhzKeystore* keystore;
     const SubGhzProtocolRegistry* protocol_registry;
+    /* Perfect hash of protocol names: slot holds registry index + 1, 0 is empty */
+    uint16_t* name_table;
+    uint32_t name_table_mask;
+    uint32_t name_seed;
     const char* came_atomo_rainbow_table_file_name;
     const char* nice_flor_s_rainbow_table_file_name;
     const char* alutech_at_4n_rainbow_table_file_name;
@@ -16,6 +25,7 @@ SubGhzEnvironment* subghz_environment_alloc() {
 
     instance->keystore = subghz_keystore_alloc();
     instance->protocol_registry = NULL;
+    instance->name_table = NULL;
     instance->came_atomo_rainbow_table_file_name = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
@@ -29,6 +39,7 @@ void subghz_environment_free(SubGhzEnvironment* instance) {
     furi_assert(instance);
 
     instance->protocol_registry = NULL;
+    free(instance->name_table);
     instance->came_atomo_rainbow_table_file_name = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
@@ -94,12 +105,69 @@ const char*
     return instance->nice_flor_s_rainbow_table_file_name;
 }
 
+static uint32_t subghz_environment_name_hash(const char* name, uint32_t seed) {
+    // FNV-1a, seed mixed into offset basis
+    uint32_t hash = 2166136261UL ^ seed;
+    while(*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619UL;
+    }
+    return hash ^ (hash >> 15);
+}
+
+/** Find seed and table size where every name gets its own slot */
+static void subghz_environment_build_name_table(SubGhzEnvironment* instance) {
+    const SubGhzProtocolRegistry* registry = instance->protocol_registry;
+    size_t count = subghz_protocol_registry_count(registry);
+    furi_check(count < UINT16_MAX);
+
+    size_t size = 4;
+    while(size < count * 2) size <<= 1;
+
+    while(true) {
+        uint16_t* table = malloc(sizeof(uint16_t) * size);
+        for(uint32_t seed = 0; seed < SUBGHZ_ENVIRONMENT_NAME_SEED_TRIES; seed++) {
+            memset(table, 0, sizeof(uint16_t) * size);
+            bool collision = false;
+            for(size_t i = 0; i < count && !collision; i++) {
+                const char* name = registry->items[i]->name;
+                uint16_t* slot = &table[subghz_environment_name_hash(name, seed) & (size - 1)];
+                if(*slot == 0) {
+                    *slot = i + 1;
+                } else if(strcmp(registry->items[*slot - 1]->name, name) != 0) {
+                    collision = true;
+                }
+                // Same name twice: first one wins, as in registry lookup
+            }
+            if(!collision) {
+                instance->name_table = table;
+                instance->name_table_mask = size - 1;
+                instance->name_seed = seed;
+                FURI_LOG_D(
+                    TAG,
+                    "Name table: %u names, %u slots, seed %lu",
+                    count,
+                    size,
+                    seed);
+                return;
+            }
+        }
+        free(table);
+        size <<= 1;
+    }
+}
+
 void subghz_environment_set_protocol_registry(
     SubGhzEnvironment* instance,
     const SubGhzProtocolRegistry* protocol_registry_items) {
     furi_assert(instance);
     const SubGhzProtocolRegistry* protocol_registry = protocol_registry_items;
+    if(instance->protocol_registry == protocol_registry) return;
+
     instance->protocol_registry = protocol_registry;
+    free(instance->name_table);
+    instance->name_table = NULL;
+    if(protocol_registry) subghz_environment_build_name_table(instance);
 }
 
 const SubGhzProtocolRegistry*
@@ -122,6 +190,29 @@ const char*
     }
 }
 
+int32_t subghz_environment_get_protocol_index(SubGhzEnvironment* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(instance->protocol_registry);
+    furi_assert(name);
+
+    uint16_t slot = instance->name_table
+                        [subghz_environment_name_hash(name, instance->name_seed) &
+                         instance->name_table_mask];
+    if(slot == 0) return -1;
+
+    // Names taken from protocols are interned: same pointer, no compare
+    const char* protocol_name = instance->protocol_registry->items[slot - 1]->name;
+    if(protocol_name != name && strcmp(protocol_name, name) != 0) return -1;
+    return slot - 1;
+}
+
+const SubGhzProtocol*
+    subghz_environment_get_protocol_by_name(SubGhzEnvironment* instance, const char* name) {
+    int32_t index = subghz_environment_get_protocol_index(instance, name);
+    if(index < 0) return NULL;
+    return subghz_protocol_registry_get_by_index(instance->protocol_registry, index);
+}
+
 void subghz_environment_reset_keeloq(SubGhzEnvironment* instance) {
     furi_assert(instance);
 
@@ -11,6 +11,7 @@ extern "C" {
 
 typedef struct SubGhzEnvironment SubGhzEnvironment;
 typedef struct SubGhzProtocolRegistry SubGhzProtocolRegistry;
+typedef struct SubGhzProtocol SubGhzProtocol;
 
 /**
  * Allocate SubGhzEnvironment.
@@ -113,6 +114,25 @@ const SubGhzProtocolRegistry*
  */
 const char* subghz_environment_get_protocol_name_registry(SubGhzEnvironment* instance, size_t idx);
 
+/**
+ * Get protocol index in registry by name.
+ * Lookup is a perfect hash built when registry is set: one hash and at most one
+ * string compare, none if name is the protocol name pointer itself.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @param name Protocol name
+ * @return index in registry, -1 if there is no such protocol
+ */
+int32_t subghz_environment_get_protocol_index(SubGhzEnvironment* instance, const char* name);
+
+/**
+ * Get protocol by name, same lookup as subghz_environment_get_protocol_index.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @param name Protocol name
+ * @return SubGhzProtocol* pointer to a SubGhzProtocol instance, NULL if there is no such protocol
+ */
+const SubGhzProtocol*
+    subghz_environment_get_protocol_by_name(SubGhzEnvironment* instance, const char* name);
+
 /**
  * Resetting the parameters used in the keeloq protocol.
  * @param instance Pointer to a SubGhzEnvironment instance
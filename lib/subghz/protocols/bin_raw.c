@@ -5,6 +5,7 @@
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
+#include "../blocks/pulse_cluster.h"
 #include <lib/toolbox/float_tools.h>
 #include <lib/toolbox/stream/stream.h>
 #include <lib/flipper_format/flipper_format_i.h>
@@ -18,6 +19,12 @@
 #define BIN_RAW_THRESHOLD_RSSI -85.0f
 #define BIN_RAW_DELTA_RSSI 7.0f
 #define BIN_RAW_SEARCH_CLASSES 20
+//pulse joins a class if it differs by less than 25%, class keeps running average k=0.05
+#define BIN_RAW_CLASS_TOLERANCE_DIV 4
+#define BIN_RAW_CLASS_WEIGHT 0.05f
+//durations used for classification, there is usually garbage at the end of the record
+#define BIN_RAW_CLASSIFY_COUNT 512
+#define BIN_RAW_CLASSIFY_SKIP_END 100
 #define BIN_RAW_TE_MIN_COUNT 40
 #define BIN_RAW_BUF_MIN_DATA_COUNT 128
 #define BIN_RAW_MAX_MARKUP_COUNT 20
@@ -72,6 +79,7 @@ struct SubGhzProtocolDecoderBinRAW {
     uint8_t* data;
     BinRAW_Markup data_markup[BIN_RAW_MAX_MARKUP_COUNT];
     size_t data_raw_ind;
+    SubGhzBlockPulseCluster cluster;
     uint32_t te;
     float adaptive_threshold_rssi;
 };
@@ -355,6 +363,11 @@ void* subghz_protocol_decoder_bin_raw_alloc(SubGhzEnvironment* environment) {
     instance->data_raw = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
     instance->data = malloc(BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
+    subghz_protocol_blocks_pulse_cluster_init(
+        &instance->cluster,
+        BIN_RAW_SEARCH_CLASSES,
+        BIN_RAW_CLASS_TOLERANCE_DIV,
+        BIN_RAW_CLASS_WEIGHT);
     instance->adaptive_threshold_rssi = BIN_RAW_THRESHOLD_RSSI;
     return instance;
 }
@@ -387,6 +400,14 @@ void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t du
             instance->decoder.parser_step = BinRAWDecoderStepBufFull;
         } else {
             instance->data_raw[instance->data_raw_ind++] = (level ? duration : -duration);
+            //classify as we go, lagging behind so that the end of the record is not taken
+            size_t ind = instance->data_raw_ind - 1;
+            if((ind >= BIN_RAW_CLASSIFY_SKIP_END) &&
+               (ind - BIN_RAW_CLASSIFY_SKIP_END < BIN_RAW_CLASSIFY_COUNT)) {
+                subghz_protocol_blocks_pulse_cluster_add(
+                    &instance->cluster,
+                    abs(instance->data_raw[ind - BIN_RAW_CLASSIFY_SKIP_END]));
+            }
         }
     }
 }
@@ -397,10 +418,7 @@ void subghz_protocol_decoder_bin_raw_feed(void* context, bool level, uint32_t du
  */
 static bool
     subghz_protocol_bin_raw_check_remote_controller(SubGhzProtocolDecoderBinRAW* instance) {
-    struct {
-        float data;
-        uint16_t count;
-    } classes[BIN_RAW_SEARCH_CLASSES];
+    SubGhzBlockPulseClass classes[BIN_RAW_SEARCH_CLASSES];
 
     size_t ind = 0;
 
@@ -409,33 +427,19 @@ static bool
     uint16_t data_markup_ind = 0;
     memset(instance->data_markup, 0x00, BIN_RAW_MAX_MARKUP_COUNT * sizeof(BinRAW_Markup));
 
-    if(instance->data_raw_ind < 512) {
-        ind =
-            instance->data_raw_ind -
-            100; //there is usually garbage at the end of the record, we exclude it from the classification
-    } else {
-        ind = 512;
-    }
-
-    //sort the durations to find the shortest correlated interval
-    for(size_t i = 0; i < ind; i++) {
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if(classes[k].count == 0) {
-                classes[k].data = (float)(abs(instance->data_raw[i]));
-                classes[k].count++;
-                break;
-            } else if(
-                DURATION_DIFF((float)(abs(instance->data_raw[i])), (classes[k].data)) <
-                (classes[k].data / 4)) { //if the test value does not differ by more than 25%
-                classes[k].data += ((float)(abs(instance->data_raw[i])) - classes[k].data) *
-                                   0.05f; //running average k=0.05
-                classes[k].count++;
-                break;
-            }
+    //durations were classified as they came, the last BIN_RAW_CLASSIFY_SKIP_END are left out
+    //of a short record, a long one is classified up to BIN_RAW_CLASSIFY_COUNT
+    if(instance->data_raw_ind >= BIN_RAW_CLASSIFY_COUNT) {
+        while(instance->cluster.pulse_count < BIN_RAW_CLASSIFY_COUNT) {
+            subghz_protocol_blocks_pulse_cluster_add(
+                &instance->cluster, abs(instance->data_raw[instance->cluster.pulse_count]));
         }
     }
 
-    // if(classes[BIN_RAW_SEARCH_CLASSES - 1].count != 0) {
+    //durations sorted by number of occurrences
+    subghz_protocol_blocks_pulse_cluster_get_ranked(&instance->cluster, classes);
+
+    // if(instance->cluster.unmatched_count != 0) {
     //     //filling the classifier, it means that they received an unclean signal
     //     return false;
     // }
@@ -450,33 +454,18 @@ static bool
     int data_temp = 0;
     BinRAWType bin_raw_type = BinRAWTypeUnknown;
 
-    //sort by number of occurrences
-    bool swap = true;
-    while(swap) {
-        swap = false;
-        for(size_t i = 1; i < BIN_RAW_SEARCH_CLASSES; i++) {
-            if(classes[i].count > classes[i - 1].count) {
-                uint32_t data = classes[i - 1].data;
-                uint32_t count = classes[i - 1].count;
-                classes[i - 1].data = classes[i].data;
-                classes[i - 1].count = classes[i].count;
-                classes[i].data = data;
-                classes[i].count = count;
-                swap = true;
-            }
-        }
-    }
 #ifdef BIN_RAW_DEBUG
     bin_raw_debug_tag(TAG, "Sorted durations\r\n");
     bin_raw_debug("\t\tind\tcount\tus\r\n");
     for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-        bin_raw_debug("\t\t%zu\t%u\t%lu\r\n", k, classes[k].count, (uint32_t)classes[k].data);
+        bin_raw_debug(
+            "\t\t%zu\t%lu\t%lu\r\n", k, classes[k].count, (uint32_t)classes[k].duration);
     }
     bin_raw_debug("\r\n");
 #endif
     if((classes[0].count > BIN_RAW_TE_MIN_COUNT) && (classes[1].count == 0)) {
         //adopted only the preamble
-        instance->te = (uint32_t)classes[0].data;
+        instance->te = (uint32_t)classes[0].duration;
         te_ok = true;
         gap = 0; //gap no
     } else {
@@ -486,20 +475,20 @@ static bool
            (classes[1].count < (BIN_RAW_TE_MIN_COUNT >> 1)))
             return false;
         //arrange the first 2 date values in ascending order
-        if(classes[0].data > classes[1].data) {
-            uint32_t data = classes[1].data;
-            classes[0].data = classes[1].data;
-            classes[1].data = data;
+        if(classes[0].duration > classes[1].duration) {
+            uint32_t data = classes[1].duration;
+            classes[0].duration = classes[1].duration;
+            classes[1].duration = data;
         }
 
         //determine the value to be corrected
         for(uint8_t k = 1; k < 5; k++) {
-            float delta = (classes[1].data / (classes[0].data / k));
+            float delta = (classes[1].duration / (classes[0].duration / k));
             bin_raw_debug_tag(TAG, "K_div= %f\r\n", (double)(delta));
             delta -= (uint32_t)delta;
 
             if((delta < 0.20f) || (delta > 0.80f)) {
-                instance->te = (uint32_t)classes[0].data / k;
+                instance->te = (uint32_t)classes[0].duration / k;
                 bin_raw_debug_tag(TAG, "K= %d\r\n", k);
                 te_ok = true; //found a correlated duration
                 break;
@@ -513,8 +502,8 @@ static bool
 
         //looking for a gap
         for(size_t k = 2; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            if((classes[k].count > 2) && (classes[k].data > gap)) {
-                gap = (uint32_t)classes[k].data;
+            if((classes[k].count > 2) && (classes[k].duration > gap)) {
+                gap = (uint32_t)classes[k].duration;
                 gap_delta = gap / 5; //calculate 20% deviation from ideal value
             }
         }
@@ -577,36 +566,40 @@ static bool
 
         bin_raw_debug("\r\n\t count bit= %zu\r\n\r\n", (BIN_RAW_BUF_DATA_SIZE * 8) - ind);
 
-        //reset the classifier and classify the received data
-        memset(classes, 0x00, sizeof(classes));
+        //classify the received pieces by bit count
+        struct {
+            uint16_t bit_count;
+            uint16_t count;
+        } lengths[BIN_RAW_MAX_MARKUP_COUNT];
+        memset(lengths, 0x00, sizeof(lengths));
 
         bin_raw_debug_tag(TAG, "Sort the found pieces by the number of bits in them\r\n");
         for(size_t i = 0; i < data_markup_ind; i++) {
-            for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-                if(classes[k].count == 0) {
-                    classes[k].data = instance->data_markup[i].bit_count;
-                    classes[k].count++;
+            for(size_t k = 0; k < BIN_RAW_MAX_MARKUP_COUNT; k++) {
+                if(lengths[k].count == 0) {
+                    lengths[k].bit_count = instance->data_markup[i].bit_count;
+                    lengths[k].count++;
                     break;
-                } else if(instance->data_markup[i].bit_count == (uint16_t)classes[k].data) {
-                    classes[k].count++;
+                } else if(instance->data_markup[i].bit_count == lengths[k].bit_count) {
+                    lengths[k].count++;
                     break;
                 }
             }
         }
 
 #ifdef BIN_RAW_DEBUG
-        bin_raw_debug("\t\tind\tcount\tus\r\n");
-        for(size_t k = 0; k < BIN_RAW_SEARCH_CLASSES; k++) {
-            bin_raw_debug("\t\t%zu\t%u\t%lu\r\n", k, classes[k].count, (uint32_t)classes[k].data);
+        bin_raw_debug("\t\tind\tcount\tbit\r\n");
+        for(size_t k = 0; k < BIN_RAW_MAX_MARKUP_COUNT; k++) {
+            bin_raw_debug("\t\t%zu\t%u\t%u\r\n", k, lengths[k].count, lengths[k].bit_count);
         }
         bin_raw_debug("\r\n");
 #endif
 
         //choose the value with the maximum repetition
         data_temp = 0;
-        for(size_t i = 0; i < BIN_RAW_SEARCH_CLASSES; i++) {
-            if((classes[i].count > 1) && (data_temp < classes[i].count))
-                data_temp = (int)classes[i].data;
+        for(size_t i = 0; i < BIN_RAW_MAX_MARKUP_COUNT; i++) {
+            if((lengths[i].count > 1) && (data_temp < lengths[i].count))
+                data_temp = (int)lengths[i].bit_count;
         }
 
         //if(data_markup_ind == 0) return false;
@@ -635,7 +628,7 @@ static bool
         bin_raw_debug_tag(TAG, "Analyze sequences of long %d bit\r\n\r\n", data_temp);
 #endif
 
-        //if(data_temp == 0) data_temp = (int)classes[0].data;
+        //if(data_temp == 0) data_temp = (int)lengths[0].bit_count;
 
         if(data_temp != 0) {
             //check that data in transmission is repeated every packet
@@ -891,6 +884,7 @@ void subghz_protocol_decoder_bin_raw_data_input_rssi(
             instance->data_raw_ind = 0;
             memset(instance->data_raw, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(int32_t));
             memset(instance->data, 0x00, BIN_RAW_BUF_RAW_SIZE * sizeof(uint8_t));
+            subghz_protocol_blocks_pulse_cluster_reset(&instance->cluster);
             instance->decoder.parser_step = BinRAWDecoderStepWrite;
             bin_raw_debug_tag(TAG, "RSSI\r\n");
         } else {
@@ -148,21 +148,21 @@ static bool subghz_protocol_faac_slh_gen_data(
         decrypt = fixx[2] << 28 | fixx[3] << 24 | fixx[4] << 20 |
                   (instance->generic.cnt & 0xFFFFF);
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-            if(res == 0) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_FAAC:
-                    //FAAC Learning
-                    man = subghz_protocol_keeloq_common_faac_learning(
-                        instance->generic.seed, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                    break;
-                }
+    for(size_t i = 0; i < subghz_keystore_get_count(instance->keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(instance->keystore, i);
+        res = strcmp(manufacture_code->name, instance->manufacture_name);
+        if(res == 0) {
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_FAAC:
+                //FAAC Learning
+                man = subghz_protocol_keeloq_common_faac_learning(
+                    instance->generic.seed, manufacture_code->key);
+                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
                 break;
             }
+            break;
         }
+    }
     if(hop) {
         instance->generic.data = (uint64_t)fix << 32 | hop;
     }
@@ -434,18 +434,18 @@ static void subghz_protocol_faac_slh_check_remote_controller(
     uint32_t decrypt = 0;
     uint64_t man;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_FAAC:
-                // FAAC Learning
-                man = subghz_protocol_keeloq_common_faac_learning(
-                    instance->seed, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(code_hop, man);
-                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                break;
-            }
+    for(size_t i = 0; i < subghz_keystore_get_count(keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(keystore, i);
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_FAAC:
+            // FAAC Learning
+            man = subghz_protocol_keeloq_common_faac_learning(
+                instance->seed, manufacture_code->key);
+            decrypt = subghz_protocol_keeloq_common_decrypt(code_hop, man);
+            *manufacture_name = manufacture_code->name;
+            break;
         }
+    }
     instance->cnt = decrypt & 0xFFFFF;
 }
 
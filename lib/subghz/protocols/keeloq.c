@@ -236,69 +236,65 @@ static bool subghz_protocol_keeloq_gen_data(
                 // Centurion -> no serial in hop, uses fixed value 0x1CE - normal learning
             }
             uint8_t kl_type_en = instance->keystore->kl_type;
-            for
-                M_EACH(
-                    manufacture_code,
-                    *subghz_keystore_get_data(instance->keystore),
-                    SubGhzKeyArray_t) {
-                    res = strcmp(
-                        furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-                    if(res == 0) {
-                        switch(manufacture_code->type) {
-                        case KEELOQ_LEARNING_SIMPLE:
-                            //Simple Learning
+            for(size_t i = 0; i < subghz_keystore_get_count(instance->keystore); i++) {
+                const SubGhzKey* manufacture_code = subghz_keystore_get_key(instance->keystore, i);
+                res = strcmp(manufacture_code->name, instance->manufacture_name);
+                if(res == 0) {
+                    switch(manufacture_code->type) {
+                    case KEELOQ_LEARNING_SIMPLE:
+                        //Simple Learning
+                        hop = subghz_protocol_keeloq_common_encrypt(
+                            decrypt, manufacture_code->key);
+                        break;
+                    case KEELOQ_LEARNING_NORMAL:
+                        //Simple Learning
+                        man = subghz_protocol_keeloq_common_normal_learning(
+                            fix, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                        break;
+                    case KEELOQ_LEARNING_SECURE:
+                        //Secure Learning
+                        man = subghz_protocol_keeloq_common_secure_learning(
+                            fix, instance->generic.seed, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                        break;
+                    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+                        //Magic XOR type-1 Learning
+                        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                            instance->generic.serial, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                        break;
+                    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+                        //Magic Serial Type 1 learning
+                        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+                            fix, manufacture_code->key);
+                        hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                        break;
+                    case KEELOQ_LEARNING_UNKNOWN:
+                        if(kl_type_en == 1) {
                             hop = subghz_protocol_keeloq_common_encrypt(
                                 decrypt, manufacture_code->key);
-                            break;
-                        case KEELOQ_LEARNING_NORMAL:
-                            //Simple Learning
+                        }
+                        if(kl_type_en == 2) {
                             man = subghz_protocol_keeloq_common_normal_learning(
                                 fix, manufacture_code->key);
                             hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_SECURE:
-                            //Secure Learning
+                        }
+                        if(kl_type_en == 3) {
                             man = subghz_protocol_keeloq_common_secure_learning(
                                 fix, instance->generic.seed, manufacture_code->key);
                             hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                            //Magic XOR type-1 Learning
+                        }
+                        if(kl_type_en == 4) {
                             man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
                                 instance->generic.serial, manufacture_code->key);
                             hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                            //Magic Serial Type 1 learning
-                            man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                                fix, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            break;
-                        case KEELOQ_LEARNING_UNKNOWN:
-                            if(kl_type_en == 1) {
-                                hop = subghz_protocol_keeloq_common_encrypt(
-                                    decrypt, manufacture_code->key);
-                            }
-                            if(kl_type_en == 2) {
-                                man = subghz_protocol_keeloq_common_normal_learning(
-                                    fix, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            if(kl_type_en == 3) {
-                                man = subghz_protocol_keeloq_common_secure_learning(
-                                    fix, instance->generic.seed, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            if(kl_type_en == 4) {
-                                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                                    instance->generic.serial, manufacture_code->key);
-                                hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                            }
-                            break;
                         }
                         break;
                     }
+                    break;
                 }
+            }
         }
     }
     if(hop) {
@@ -771,186 +767,184 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+    for(size_t i = 0; i < subghz_keystore_get_count(keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(keystore, i);
+        if(mf_not_set || (strcmp(manufacture_code->name, mfname) == 0)) {
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_SIMPLE:
+                // Simple Learning
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_NORMAL:
+                // Normal Learning
+                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                man =
+                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if((strcmp(manufacture_code->name, "Centurion") == 0)) {
+                    if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
                         return 1;
                     }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+                } else {
                     if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                        *manufacture_name = manufacture_code->name;
                         keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
                         return 1;
                     }
+                }
+                break;
+            case KEELOQ_LEARNING_SECURE:
+                man = subghz_protocol_keeloq_common_secure_learning(
+                    fix, instance->seed, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                    fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+                man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+                    fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+                man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
+                    fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+                man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
+                    fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_UNKNOWN:
+                // Simple Learning
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 1;
+                    return 1;
+                }
 
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
+                // Check for mirrored man
+                uint64_t man_rev = 0;
+                uint64_t man_rev_byte = 0;
+                for(uint8_t i = 0; i < 64; i += 8) {
+                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+                    man_rev = man_rev | man_rev_byte << (56 - i);
+                }
 
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 1;
+                    return 1;
+                }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
+                //###########################
+                // Normal Learning
+                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                man =
+                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 2;
+                    return 1;
+                }
 
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
+                // Check for mirrored man
+                man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 2;
+                    return 1;
+                }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
+                // Secure Learning
+                man = subghz_protocol_keeloq_common_secure_learning(
+                    fix, instance->seed, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 3;
+                    return 1;
+                }
 
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+                // Check for mirrored man
+                man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, man_rev);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 3;
+                    return 1;
+                }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+                // Magic xor type1 learning
+                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
+                    fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 4;
+                    return 1;
+                }
 
-                    break;
+                // Check for mirrored man
+                man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+                if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 4;
+                    return 1;
                 }
+
+                break;
             }
         }
+    }
 
     *manufacture_name = "Unknown";
     keystore->mfname = "Unknown";
@@ -144,15 +144,15 @@ static bool subghz_protocol_kinggates_stylo_4k_gen_data(
     int res = 0;
     uint32_t decrypt = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), "Kingates_Stylo4k");
-            if(res == 0) {
-                //Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                break;
-            }
+    for(size_t i = 0; i < subghz_keystore_get_count(instance->keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(instance->keystore, i);
+        res = strcmp(manufacture_code->name, "Kingates_Stylo4k");
+        if(res == 0) {
+            //Simple Learning
+            decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+            break;
         }
+    }
     instance->generic.cnt = decrypt & 0xFFFF;
 
     if(instance->generic.cnt < 0xFFFF) {
@@ -171,17 +171,17 @@ static bool subghz_protocol_kinggates_stylo_4k_gen_data(
     uint32_t data = (decrypt & 0xFFFF0000) | instance->generic.cnt;
 
     uint64_t encrypt = 0;
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(furi_string_get_cstr(manufacture_code->name), "Kingates_Stylo4k");
-            if(res == 0) {
-                //Simple Learning
-                encrypt = subghz_protocol_keeloq_common_encrypt(data, manufacture_code->key);
-                encrypt = subghz_protocol_blocks_reverse_key(encrypt, 32);
-                instance->generic.data_2 = encrypt << 4;
-                return true;
-            }
+    for(size_t i = 0; i < subghz_keystore_get_count(instance->keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(instance->keystore, i);
+        res = strcmp(manufacture_code->name, "Kingates_Stylo4k");
+        if(res == 0) {
+            //Simple Learning
+            encrypt = subghz_protocol_keeloq_common_encrypt(data, manufacture_code->key);
+            encrypt = subghz_protocol_blocks_reverse_key(encrypt, 32);
+            instance->generic.data_2 = encrypt << 4;
+            return true;
         }
+    }
 
     return false;
 }
@@ -481,17 +481,17 @@ static void subghz_protocol_kinggates_stylo_4k_remote_controller(
     instance->btn = (fix >> 17) & 0x0F;
     instance->serial = ((fix >> 5) & 0xFFFF0000) | (fix & 0xFFFF);
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(manufacture_code->type == KEELOQ_LEARNING_SIMPLE) {
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if(((decrypt >> 28) == instance->btn) && (((decrypt >> 24) & 0x0F) == 0x0C) &&
-                   (((decrypt >> 16) & 0xFF) == (instance->serial & 0xFF))) {
-                    ret = true;
-                    break;
-                }
+    for(size_t i = 0; i < subghz_keystore_get_count(keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(keystore, i);
+        if(manufacture_code->type == KEELOQ_LEARNING_SIMPLE) {
+            decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+            if(((decrypt >> 28) == instance->btn) && (((decrypt >> 24) & 0x0F) == 0x0C) &&
+               (((decrypt >> 16) & 0xFF) == (instance->serial & 0xFF))) {
+                ret = true;
+                break;
             }
         }
+    }
     if(ret) {
         instance->cnt = decrypt & 0xFFFF;
     } else {
@@ -155,41 +155,37 @@ static bool
         hop = code_found_reverse & 0x00000000ffffffff;
     } else {
         uint8_t kl_type_en = instance->keystore->kl_type;
-        for
-            M_EACH(
-                manufacture_code,
-                *subghz_keystore_get_data(instance->keystore),
-                SubGhzKeyArray_t) {
-                res = strcmp(
-                    furi_string_get_cstr(manufacture_code->name), instance->manufacture_name);
-                if(res == 0) {
-                    switch(manufacture_code->type) {
-                    case KEELOQ_LEARNING_SIMPLE:
-                        //Simple Learning
-                        hop =
-                            subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
-                        break;
-                    case KEELOQ_LEARNING_NORMAL:
-                        //Normal Learning
+        for(size_t i = 0; i < subghz_keystore_get_count(instance->keystore); i++) {
+            const SubGhzKey* manufacture_code = subghz_keystore_get_key(instance->keystore, i);
+            res = strcmp(manufacture_code->name, instance->manufacture_name);
+            if(res == 0) {
+                switch(manufacture_code->type) {
+                case KEELOQ_LEARNING_SIMPLE:
+                    //Simple Learning
+                    hop =
+                        subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+                    break;
+                case KEELOQ_LEARNING_NORMAL:
+                    //Normal Learning
+                    man = subghz_protocol_keeloq_common_normal_learning(
+                        fix, manufacture_code->key);
+                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
+                    break;
+                case KEELOQ_LEARNING_UNKNOWN:
+                    if(kl_type_en == 1) {
+                        hop = subghz_protocol_keeloq_common_encrypt(
+                            decrypt, manufacture_code->key);
+                    }
+                    if(kl_type_en == 2) {
                         man = subghz_protocol_keeloq_common_normal_learning(
                             fix, manufacture_code->key);
                         hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                        break;
-                    case KEELOQ_LEARNING_UNKNOWN:
-                        if(kl_type_en == 1) {
-                            hop = subghz_protocol_keeloq_common_encrypt(
-                                decrypt, manufacture_code->key);
-                        }
-                        if(kl_type_en == 2) {
-                            man = subghz_protocol_keeloq_common_normal_learning(
-                                fix, manufacture_code->key);
-                            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man);
-                        }
-                        break;
                     }
                     break;
                 }
+                break;
             }
+        }
     }
     if(hop) {
         uint64_t yek = (uint64_t)fix << 32 | hop;
@@ -528,86 +524,80 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-                    break;
+    for(size_t i = 0; i < subghz_keystore_get_count(keystore); i++) {
+        const SubGhzKey* manufacture_code = subghz_keystore_get_key(keystore, i);
+        if(mf_not_set || (strcmp(manufacture_code->name, mfname) == 0)) {
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_SIMPLE:
+                // Simple Learning
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
+                }
+                break;
+            case KEELOQ_LEARNING_NORMAL:
+                // Normal Learning
+                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                man_normal_learning =
+                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    return 1;
                 }
+                break;
+            case KEELOQ_LEARNING_UNKNOWN:
+                // Simple Learning
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 1;
+                    return 1;
+                }
+                // Check for mirrored man
+                uint64_t man_rev = 0;
+                uint64_t man_rev_byte = 0;
+                for(uint8_t i = 0; i < 64; i += 8) {
+                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+                    man_rev = man_rev | man_rev_byte << (56 - i);
+                }
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 1;
+                    return 1;
+                }
+                //###########################
+                // Normal Learning
+                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+                man_normal_learning =
+                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 2;
+                    return 1;
+                }
+                // Check for mirrored man
+                man_normal_learning =
+                    subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+                if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+                    *manufacture_name = manufacture_code->name;
+                    keystore->mfname = *manufacture_name;
+                    keystore->kl_type = 2;
+                    return 1;
+                }
+                break;
             }
         }
+    }
 
     *manufacture_name = "Unknown";
     keystore->mfname = "Unknown";
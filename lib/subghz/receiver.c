@@ -14,6 +14,10 @@ ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
 
 struct SubGhzReceiver {
     SubGhzReceiverSlotArray_t slots;
+    SubGhzEnvironment* environment;
+    const SubGhzProtocolRegistry* protocol_registry;
+    /* Slot of every registry protocol, -1 if it has no decoder */
+    int16_t* slot_index;
     SubGhzProtocolFlag filter;
 
     SubGhzReceiverCallback callback;
@@ -25,12 +29,20 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiverSlotArray_init(instance->slots);
     const SubGhzProtocolRegistry* protocol_registry_items =
         subghz_environment_get_protocol_registry(environment);
+    size_t protocol_count = subghz_protocol_registry_count(protocol_registry_items);
+    furi_check(protocol_count < INT16_MAX);
 
-    for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry_items); ++i) {
+    instance->environment = environment;
+    instance->protocol_registry = protocol_registry_items;
+    instance->slot_index = malloc(sizeof(int16_t) * protocol_count);
+
+    for(size_t i = 0; i < protocol_count; ++i) {
         const SubGhzProtocol* protocol =
             subghz_protocol_registry_get_by_index(protocol_registry_items, i);
 
+        instance->slot_index[i] = -1;
         if(protocol->decoder && protocol->decoder->alloc) {
+            instance->slot_index[i] = SubGhzReceiverSlotArray_size(instance->slots);
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
         }
@@ -54,6 +66,7 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
             slot->base = NULL;
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
+    free(instance->slot_index);
 
     free(instance);
 }
@@ -113,6 +126,18 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
     const char* decoder_name) {
     SubGhzProtocolDecoderBase* result = NULL;
 
+    // Slots follow the registry receiver was built from, environment may have another now
+    if(subghz_environment_get_protocol_registry(instance->environment) ==
+       instance->protocol_registry) {
+        int32_t index = subghz_environment_get_protocol_index(instance->environment, decoder_name);
+        if(index >= 0 && instance->slot_index[index] >= 0) {
+            SubGhzReceiverSlot* slot =
+                SubGhzReceiverSlotArray_get(instance->slots, instance->slot_index[index]);
+            result = (SubGhzProtocolDecoderBase*)slot->base;
+        }
+        return result;
+    }
+
     for
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             if(strcmp(slot->base->protocol->name, decoder_name) == 0) {
@@ -6,7 +6,8 @@ const SubGhzProtocol* subghz_protocol_registry_get_by_name(
     furi_assert(protocol_registry);
 
     for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry); i++) {
-        if(strcmp(name, protocol_registry->items[i]->name) == 0) {
+        const char* protocol_name = protocol_registry->items[i]->name;
+        if(protocol_name == name || strcmp(name, protocol_name) == 0) {
             return protocol_registry->items[i];
         }
     }
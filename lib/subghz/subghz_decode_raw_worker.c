@@ -0,0 +1,271 @@
+#include "subghz_decode_raw_worker.h"
+
+#include <storage/storage.h>
+#include <toolbox/stream/stream.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "SubGhzDecodeRawWorker"
+
+// Longest RAW_Data line written by RAW protocol, longer lines grow the buffer
+#define SUBGHZ_DECODE_RAW_WORKER_LINE_SIZE 512
+// Same clamp as SubGhzFileEncoderWorker, results must match the replay path
+#define SUBGHZ_DECODE_RAW_WORKER_DURATION_MAX 1000000
+#define SUBGHZ_DECODE_RAW_WORKER_DURATION_CLAMPED 100
+#define SUBGHZ_DECODE_RAW_WORKER_PAUSE_MS 10
+
+struct SubGhzDecodeRawWorker {
+    FuriThread* thread;
+    volatile bool cancel;
+    volatile bool pause;
+    // Held while decoders are fed, pause waits for it
+    FuriMutex* feed_mutex;
+
+    SubGhzReceiver* receiver;
+    SubGhzProtocolDecoderBase* decoder;
+    FuriString* protocol_name;
+    FuriString* file_path;
+
+    int32_t* buffer;
+    size_t buffer_size;
+
+    SubGhzDecodeRawWorkerCallbackProgress callback_progress;
+    void* context_progress;
+    SubGhzDecodeRawWorkerCallbackEnd callback_end;
+    void* context_end;
+};
+
+SubGhzDecodeRawWorker* subghz_decode_raw_worker_alloc(void) {
+    SubGhzDecodeRawWorker* instance = malloc(sizeof(SubGhzDecodeRawWorker));
+
+    instance->protocol_name = furi_string_alloc();
+    instance->file_path = furi_string_alloc();
+    instance->buffer_size = SUBGHZ_DECODE_RAW_WORKER_LINE_SIZE;
+    instance->buffer = malloc(sizeof(int32_t) * instance->buffer_size);
+    instance->feed_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+
+    return instance;
+}
+
+void subghz_decode_raw_worker_free(SubGhzDecodeRawWorker* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+
+    furi_mutex_free(instance->feed_mutex);
+    free(instance->buffer);
+    furi_string_free(instance->file_path);
+    furi_string_free(instance->protocol_name);
+    free(instance);
+}
+
+void subghz_decode_raw_worker_set_progress_callback(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzDecodeRawWorkerCallbackProgress callback,
+    void* context) {
+    furi_assert(instance);
+    instance->callback_progress = callback;
+    instance->context_progress = context;
+}
+
+void subghz_decode_raw_worker_set_end_callback(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzDecodeRawWorkerCallbackEnd callback,
+    void* context) {
+    furi_assert(instance);
+    instance->callback_end = callback;
+    instance->context_end = context;
+}
+
+void subghz_decode_raw_worker_set_protocol(
+    SubGhzDecodeRawWorker* instance,
+    const char* protocol_name) {
+    furi_assert(instance);
+    furi_string_set(instance->protocol_name, protocol_name ? protocol_name : "");
+}
+
+/** Feed one RAW_Data line
+ *
+ * Levels must alternate, same as in SubGhzFileEncoderWorker: a repeated
+ * level is dropped.
+ */
+static void subghz_decode_raw_worker_feed(
+    SubGhzDecodeRawWorker* instance,
+    size_t count,
+    bool* level_last) {
+    for(size_t i = 0; i < count; i++) {
+        int32_t sample = instance->buffer[i];
+        bool level = sample > 0;
+        if(!sample || level == *level_last) {
+            FURI_LOG_E(TAG, "Invalid level in the stream");
+            continue;
+        }
+        *level_last = level;
+
+        uint32_t duration = level ? sample : -sample;
+        if(duration > SUBGHZ_DECODE_RAW_WORKER_DURATION_MAX) {
+            duration = SUBGHZ_DECODE_RAW_WORKER_DURATION_CLAMPED;
+        }
+
+        if(instance->decoder) {
+            instance->decoder->protocol->decoder->feed(instance->decoder, level, duration);
+        } else {
+            subghz_receiver_decode(instance->receiver, level, duration);
+        }
+    }
+}
+
+static bool subghz_decode_raw_worker_process(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path) {
+    instance->receiver = receiver;
+    instance->decoder = NULL;
+    if(!furi_string_empty(instance->protocol_name)) {
+        instance->decoder = subghz_receiver_search_decoder_base_by_name(
+            receiver, furi_string_get_cstr(instance->protocol_name));
+        if(!instance->decoder) {
+            FURI_LOG_E(
+                TAG, "Unknown protocol %s", furi_string_get_cstr(instance->protocol_name));
+            return false;
+        }
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_buffered_file_alloc(storage);
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    FuriString* temp_str = furi_string_alloc();
+    bool completed = false;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(flipper_format, file_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_path);
+            break;
+        }
+        if(!flipper_format_read_string(flipper_format, "Protocol", temp_str) ||
+           furi_string_cmp_str(temp_str, "RAW")) {
+            FURI_LOG_E(TAG, "Not a RAW file");
+            break;
+        }
+
+        size_t file_size = stream_size(stream);
+        uint8_t progress_last = 0;
+        // Same start state as SubGhzFileEncoderWorker: first level must be high
+        bool level_last = false;
+        uint32_t count;
+
+        subghz_receiver_reset(receiver);
+        while(!instance->cancel &&
+              flipper_format_get_value_count(flipper_format, "RAW_Data", &count)) {
+            furi_check(
+                furi_mutex_acquire(instance->feed_mutex, FuriWaitForever) == FuriStatusOk);
+            // Checked under lock: once pause returned, decoders are not touched
+            if(instance->pause) {
+                furi_mutex_release(instance->feed_mutex);
+                furi_delay_ms(SUBGHZ_DECODE_RAW_WORKER_PAUSE_MS);
+                continue;
+            }
+            if(count > instance->buffer_size) {
+                instance->buffer_size = count;
+                instance->buffer = realloc(instance->buffer, sizeof(int32_t) * count); //-V701
+            }
+            bool read =
+                flipper_format_read_int32(flipper_format, "RAW_Data", instance->buffer, count);
+            if(read) {
+                subghz_decode_raw_worker_feed(instance, count, &level_last);
+            }
+            furi_mutex_release(instance->feed_mutex);
+            if(!read) break;
+
+            uint8_t progress = file_size ? stream_tell(stream) * 100 / file_size : 100;
+            if(progress != progress_last && instance->callback_progress) {
+                instance->callback_progress(instance->context_progress, progress);
+            }
+            progress_last = progress;
+        }
+        completed = !instance->cancel;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    return completed;
+}
+
+bool subghz_decode_raw_worker_decode(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    furi_assert(receiver);
+    furi_assert(file_path);
+
+    instance->cancel = false;
+    return subghz_decode_raw_worker_process(instance, receiver, file_path);
+}
+
+static int32_t subghz_decode_raw_worker_thread(void* context) {
+    SubGhzDecodeRawWorker* instance = context;
+    FURI_LOG_I(TAG, "Worker start");
+
+    bool completed = subghz_decode_raw_worker_process(
+        instance, instance->receiver, furi_string_get_cstr(instance->file_path));
+    if(instance->callback_end) instance->callback_end(instance->context_end, completed);
+
+    FURI_LOG_I(TAG, "Worker stop");
+    return 0;
+}
+
+bool subghz_decode_raw_worker_start(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    furi_assert(receiver);
+    furi_assert(file_path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool file_exists = storage_file_exists(storage, file_path);
+    furi_record_close(RECORD_STORAGE);
+    if(!file_exists) {
+        FURI_LOG_E(TAG, "File not found: %s", file_path);
+        return false;
+    }
+
+    instance->receiver = receiver;
+    furi_string_set(instance->file_path, file_path);
+    instance->cancel = false;
+    instance->pause = false;
+    instance->thread =
+        furi_thread_alloc_ex("SubGhzDecodeRaw", 2048, subghz_decode_raw_worker_thread, instance);
+    furi_thread_start(instance->thread);
+
+    return true;
+}
+
+void subghz_decode_raw_worker_stop(SubGhzDecodeRawWorker* instance) {
+    furi_assert(instance);
+    if(!instance->thread) return;
+
+    instance->cancel = true;
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    instance->thread = NULL;
+}
+
+void subghz_decode_raw_worker_pause(SubGhzDecodeRawWorker* instance, bool pause) {
+    furi_assert(instance);
+    instance->pause = pause;
+    if(pause) {
+        // Wait for the line being fed
+        furi_check(furi_mutex_acquire(instance->feed_mutex, FuriWaitForever) == FuriStatusOk);
+        furi_mutex_release(instance->feed_mutex);
+    }
+}
+
+bool subghz_decode_raw_worker_is_running(SubGhzDecodeRawWorker* instance) {
+    furi_assert(instance);
+    return instance->thread && furi_thread_get_state(instance->thread) != FuriThreadStateStopped;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "receiver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*SubGhzDecodeRawWorkerCallbackProgress)(void* context, uint8_t progress);
+typedef void (*SubGhzDecodeRawWorkerCallbackEnd)(void* context, bool completed);
+
+typedef struct SubGhzDecodeRawWorker SubGhzDecodeRawWorker;
+
+/**
+ * Allocate SubGhzDecodeRawWorker.
+ * Decodes RAW file as fast as the CPU allows, results are delivered by receiver callback
+ * from the worker thread.
+ * @return SubGhzDecodeRawWorker* pointer to a SubGhzDecodeRawWorker instance
+ */
+SubGhzDecodeRawWorker* subghz_decode_raw_worker_alloc(void);
+
+/**
+ * Free SubGhzDecodeRawWorker.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ */
+void subghz_decode_raw_worker_free(SubGhzDecodeRawWorker* instance);
+
+/**
+ * Progress callback, called from the worker thread when percentage changes.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param callback SubGhzDecodeRawWorkerCallbackProgress callback
+ * @param context
+ */
+void subghz_decode_raw_worker_set_progress_callback(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzDecodeRawWorkerCallbackProgress callback,
+    void* context);
+
+/**
+ * End callback, called from the worker thread once the file is over or decoding is cancelled.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param callback SubGhzDecodeRawWorkerCallbackEnd callback
+ * @param context
+ */
+void subghz_decode_raw_worker_set_end_callback(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzDecodeRawWorkerCallbackEnd callback,
+    void* context);
+
+/**
+ * Feed samples to one protocol only, instead of every decoder allowed by receiver filter.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param protocol_name Protocol name, NULL for all protocols
+ */
+void subghz_decode_raw_worker_set_protocol(
+    SubGhzDecodeRawWorker* instance,
+    const char* protocol_name);
+
+/**
+ * Decode file in the calling thread.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param receiver SubGhzReceiver instance, its callback gets decoded messages
+ * @param file_path RAW file path
+ * @return bool - true if the whole file was decoded
+ */
+bool subghz_decode_raw_worker_decode(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path);
+
+/**
+ * Start decoding in the worker thread.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param receiver SubGhzReceiver instance, its callback gets decoded messages
+ * @param file_path RAW file path
+ * @return bool - true if ok
+ */
+bool subghz_decode_raw_worker_start(
+    SubGhzDecodeRawWorker* instance,
+    SubGhzReceiver* receiver,
+    const char* file_path);
+
+/**
+ * Cancel decoding and wait for the worker thread.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ */
+void subghz_decode_raw_worker_stop(SubGhzDecodeRawWorker* instance);
+
+/**
+ * Pause decoding in the worker thread, decoders keep their state.
+ * Pause returns when worker is done with the current line, so the receiver
+ * can be used by caller until resume.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @param pause true to pause, false to resume
+ */
+void subghz_decode_raw_worker_pause(SubGhzDecodeRawWorker* instance, bool pause);
+
+/**
+ * Check if worker thread is still decoding.
+ * @param instance Pointer to a SubGhzDecodeRawWorker instance
+ * @return bool - true if running
+ */
+bool subghz_decode_raw_worker_is_running(SubGhzDecodeRawWorker* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -22,15 +22,82 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+// Compiled keystore lives next to the text one, which stays the source of truth
+#define SUBGHZ_KEYSTORE_COMPILED_EXTENSION ".bin"
+#define SUBGHZ_KEYSTORE_COMPILED_MAGIC 0x4B5A4753
+#define SUBGHZ_KEYSTORE_COMPILED_VERSION 1
+#define SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE 512
+#define SUBGHZ_KEYSTORE_AES_BLOCK_SIZE 16
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+/** Text file the keystore was built from */
+typedef struct {
+    uint32_t size;
+    uint32_t timestamp;
+} SubGhzKeystoreSource;
+
+/** Compiled file header, followed by records and name table in one AES stream */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t encryption;
+    SubGhzKeystoreSource source;
+    uint32_t count;
+    uint32_t names_size;
+    uint8_t iv[16];
+} SubGhzKeystoreCompiledHeader;
+
+typedef struct {
+    uint64_t key;
+    uint32_t name;
+    uint16_t type;
+    uint16_t reserved;
+} SubGhzKeystoreRecord;
+
+/** Keys of one file, loaded once and shared by all keystores */
+struct SubGhzKeystoreSet {
+    SubGhzKeystoreSet* next;
+    FuriString* path;
+    SubGhzKeystoreSource source;
+    size_t refs;
+    size_t count;
+    char* names;
+    size_t names_size;
+    SubGhzKey keys[];
+};
+
+/** Text keystore being parsed, same layout as compiled file */
+typedef struct {
+    SubGhzKeystoreRecord* records;
+    size_t count;
+    size_t capacity;
+    char* names;
+    size_t names_size;
+    size_t names_capacity;
+    uint32_t names_last;
+} SubGhzKeystoreBuilder;
+
+static FuriMutex* subghz_keystore_sets_mutex = NULL;
+static SubGhzKeystoreSet* subghz_keystore_sets = NULL;
+
 SubGhzKeystore* subghz_keystore_alloc() {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
-    SubGhzKeyArray_init(instance->data);
+    if(!subghz_keystore_sets_mutex) {
+        // Keystores can be created from different threads, only one mutex is kept
+        FuriMutex* mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+        FURI_CRITICAL_ENTER();
+        if(!subghz_keystore_sets_mutex) {
+            subghz_keystore_sets_mutex = mutex;
+            mutex = NULL;
+        }
+        FURI_CRITICAL_EXIT();
+        if(mutex) furi_mutex_free(mutex);
+    }
 
     subghz_keystore_reset_kl(instance);
 
@@ -44,31 +111,114 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
     instance->kl_type = 0;
 }
 
+static void subghz_keystore_set_release(SubGhzKeystoreSet* set) {
+    furi_check(set->refs > 0);
+    if(--set->refs) return;
+
+    SubGhzKeystoreSet** link = &subghz_keystore_sets;
+    while(*link != set) {
+        link = &(*link)->next;
+    }
+    *link = set->next;
+
+    furi_string_free(set->path);
+    // Do not leave keys in freed memory
+    memset(set->keys, 0, set->count * sizeof(SubGhzKey));
+    free(set);
+}
+
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
-    for
-        M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
-            manufacture_code->key = 0;
-        }
-    SubGhzKeyArray_clear(instance->data);
+    furi_check(furi_mutex_acquire(subghz_keystore_sets_mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < instance->sets_count; i++) {
+        subghz_keystore_set_release(instance->sets[i]);
+    }
+    furi_mutex_release(subghz_keystore_sets_mutex);
 
     free(instance);
 }
 
-static void subghz_keystore_add_key(
-    SubGhzKeystore* instance,
+static SubGhzKeystoreSet* subghz_keystore_set_alloc(
+    const char* file_name,
+    const SubGhzKeystoreSource* source,
+    size_t count,
+    size_t names_size) {
+    SubGhzKeystoreSet* set =
+        malloc(sizeof(SubGhzKeystoreSet) + count * sizeof(SubGhzKey) + names_size);
+    set->path = furi_string_alloc_set(file_name);
+    set->source = *source;
+    set->count = count;
+    set->names = (char*)&set->keys[count];
+    set->names_size = names_size;
+    return set;
+}
+
+static void subghz_keystore_set_free(SubGhzKeystoreSet* set) {
+    furi_string_free(set->path);
+    free(set);
+}
+
+static uint32_t
+    subghz_keystore_builder_add_name(SubGhzKeystoreBuilder* builder, const char* name) {
+    // Keys of one manufacture usually go in a row
+    if(builder->names_size && strcmp(builder->names + builder->names_last, name) == 0) {
+        return builder->names_last;
+    }
+    size_t offset = 0;
+    while(offset < builder->names_size) {
+        if(strcmp(builder->names + offset, name) == 0) return offset;
+        offset += strlen(builder->names + offset) + 1;
+    }
+
+    size_t size = strlen(name) + 1;
+    if(builder->names_size + size > builder->names_capacity) {
+        builder->names_capacity = MAX(builder->names_capacity * 2, builder->names_size + size);
+        builder->names = realloc(builder->names, builder->names_capacity); //-V701
+    }
+    memcpy(builder->names + builder->names_size, name, size);
+    builder->names_last = builder->names_size;
+    builder->names_size += size;
+    return builder->names_last;
+}
+
+static void subghz_keystore_builder_add_key(
+    SubGhzKeystoreBuilder* builder,
     const char* name,
     uint64_t key,
     uint16_t type) {
-    SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
-    manufacture_code->key = key;
-    manufacture_code->type = type;
+    if(builder->count == builder->capacity) {
+        builder->capacity = builder->capacity ? builder->capacity * 2 : 64;
+        size_t size = builder->capacity * sizeof(SubGhzKeystoreRecord);
+        builder->records = realloc(builder->records, size); //-V701
+    }
+    SubGhzKeystoreRecord* record = &builder->records[builder->count++];
+    record->key = key;
+    record->name = subghz_keystore_builder_add_name(builder, name);
+    record->type = type;
+    record->reserved = 0;
+}
+
+/** Pad name table to AES block, so records and names are one stream */
+static void subghz_keystore_builder_finish(SubGhzKeystoreBuilder* builder) {
+    size_t size = builder->names_size + SUBGHZ_KEYSTORE_AES_BLOCK_SIZE -
+                  builder->names_size % SUBGHZ_KEYSTORE_AES_BLOCK_SIZE;
+    builder->names = realloc(builder->names, size); //-V701
+    memset(builder->names + builder->names_size, 0, size - builder->names_size);
+    builder->names_size = size;
+    builder->names_capacity = size;
+}
+
+static void subghz_keystore_builder_reset(SubGhzKeystoreBuilder* builder) {
+    if(builder->records) {
+        memset(builder->records, 0, builder->capacity * sizeof(SubGhzKeystoreRecord));
+        free(builder->records);
+    }
+    free(builder->names);
+    memset(builder, 0, sizeof(SubGhzKeystoreBuilder));
 }
 
-static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
+static bool subghz_keystore_process_line(SubGhzKeystoreBuilder* builder, char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
     char skey[17] = {0};
@@ -76,7 +226,7 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     int ret = sscanf(line, "%16s:%hu:%64s", skey, &type, name);
     key = strtoull(skey, NULL, 16);
     if(ret == 3) {
-        subghz_keystore_add_key(instance, name, key, type);
+        subghz_keystore_builder_add_key(builder, name, key, type);
         return true;
     } else {
         FURI_LOG_E(TAG, "Failed to load line: %s\r\n", line);
@@ -86,11 +236,16 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
 
 static void subghz_keystore_mess_with_iv(uint8_t* iv) {
     // Alignment check for `ldrd` instruction
-    furi_assert(((uint32_t)iv) % 4 == 0);
+    furi_assert(((uintptr_t)iv) % 4 == 0);
     // Please do not share decrypted manufacture keys
     // Sharing them will bring some discomfort to legal owners
     // And potential legal action against you
     // While you reading this code think about your own personal responsibility
+#ifdef FURI_HOST
+    // Host build has no enclave keys, encrypted files never get this far
+    UNUSED(iv);
+    furi_crash("Encrypted keystore on host");
+#else
     asm volatile("nani%=:                  \n"
                  "ldrd  r0, r2, [%0, #0x0] \n"
                  "lsl   r1, r0, #8         \n"
@@ -110,9 +265,11 @@ static void subghz_keystore_mess_with_iv(uint8_t* iv) {
                  :
                  : "r"(iv)
                  : "r0", "r1", "r2", "r3", "memory");
+#endif
 }
 
-static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream, uint8_t* iv) {
+static bool
+    subghz_keystore_read_file(SubGhzKeystoreBuilder* builder, Stream* stream, uint8_t* iv) {
     bool result = true;
     uint8_t buffer[FILE_BUFFER_SIZE];
 
@@ -150,7 +307,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
 
                             if(furi_hal_crypto_decrypt(
                                    (uint8_t*)encrypted_line, (uint8_t*)decrypted_line, len)) {
-                                subghz_keystore_process_line(instance, decrypted_line);
+                                subghz_keystore_process_line(builder, decrypted_line);
                             } else {
                                 FURI_LOG_E(TAG, "Decryption failed");
                                 result = false;
@@ -160,7 +317,7 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
                             FURI_LOG_E(TAG, "Invalid encrypted data: %s", encrypted_line);
                         }
                     } else {
-                        subghz_keystore_process_line(instance, encrypted_line);
+                        subghz_keystore_process_line(builder, encrypted_line);
                     }
                     // reset line buffer
                     memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
@@ -190,20 +347,18 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
-bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
-    furi_assert(instance);
+static bool subghz_keystore_text_load(
+    Storage* storage,
+    const char* file_name,
+    SubGhzKeystoreBuilder* builder,
+    SubGhzKeystoreEncryption* encryption) {
     bool result = false;
     uint8_t iv[16];
     uint32_t version;
-    uint32_t encryption;
 
     FuriString* filetype;
     filetype = furi_string_alloc();
 
-    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
-
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
     do {
         if(!flipper_format_file_open_existing(flipper_format, file_name)) {
@@ -214,7 +369,7 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
             FURI_LOG_E(TAG, "Missing or incorrect header");
             break;
         }
-        if(!flipper_format_read_uint32(flipper_format, "Encryption", (uint32_t*)&encryption, 1)) {
+        if(!flipper_format_read_uint32(flipper_format, "Encryption", (uint32_t*)encryption, 1)) {
             FURI_LOG_E(TAG, "Missing encryption type");
             break;
         }
@@ -226,15 +381,15 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
         }
 
         Stream* stream = flipper_format_get_raw_stream(flipper_format);
-        if(encryption == SubGhzKeystoreEncryptionNone) {
-            result = subghz_keystore_read_file(instance, stream, NULL);
-        } else if(encryption == SubGhzKeystoreEncryptionAES256) {
+        if(*encryption == SubGhzKeystoreEncryptionNone) {
+            result = subghz_keystore_read_file(builder, stream, NULL);
+        } else if(*encryption == SubGhzKeystoreEncryptionAES256) {
             if(!flipper_format_read_hex(flipper_format, "IV", iv, 16)) {
                 FURI_LOG_E(TAG, "Missing IV");
                 break;
             }
             subghz_keystore_mess_with_iv(iv);
-            result = subghz_keystore_read_file(instance, stream, iv);
+            result = subghz_keystore_read_file(builder, stream, iv);
         } else {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
@@ -242,13 +397,287 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     } while(0);
     flipper_format_free(flipper_format);
 
-    furi_record_close(RECORD_STORAGE);
-
     furi_string_free(filetype);
 
     return result;
 }
 
+/** Read size bytes of compiled stream, size is multiple of AES block */
+static bool subghz_keystore_compiled_read(
+    File* file,
+    uint8_t* block,
+    uint8_t* output,
+    size_t size,
+    bool encrypted) {
+    if(storage_file_read(file, encrypted ? block : output, size) != size) return false;
+    return !encrypted || furi_hal_crypto_decrypt(block, output, size);
+}
+
+static bool subghz_keystore_compiled_write(
+    File* file,
+    uint8_t* block,
+    const uint8_t* input,
+    size_t size,
+    bool encrypted) {
+    if(encrypted) {
+        if(!furi_hal_crypto_encrypt(input, block, size)) return false;
+        input = block;
+    }
+    return storage_file_write(file, input, size) == size;
+}
+
+static bool subghz_keystore_compiled_read_set(
+    SubGhzKeystoreSet* set,
+    File* file,
+    uint8_t* block,
+    bool encrypted) {
+    uint8_t* plain = block + SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE;
+    const size_t records_per_block = SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE /
+                                     sizeof(SubGhzKeystoreRecord);
+
+    for(size_t i = 0; i < set->count; i += records_per_block) {
+        size_t count = MIN(records_per_block, set->count - i);
+        if(!subghz_keystore_compiled_read(
+               file, block, plain, count * sizeof(SubGhzKeystoreRecord), encrypted)) {
+            return false;
+        }
+        const SubGhzKeystoreRecord* records = (const SubGhzKeystoreRecord*)plain;
+        for(size_t j = 0; j < count; j++) {
+            if(records[j].name >= set->names_size || records[j].reserved) return false;
+            set->keys[i + j].key = records[j].key;
+            set->keys[i + j].name = set->names + records[j].name;
+            set->keys[i + j].type = records[j].type;
+        }
+    }
+    memset(plain, 0, SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE);
+
+    for(size_t offset = 0; offset < set->names_size;
+        offset += SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE) {
+        size_t size = MIN(SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE, set->names_size - offset);
+        if(!subghz_keystore_compiled_read(
+               file, block, (uint8_t*)set->names + offset, size, encrypted)) {
+            return false;
+        }
+    }
+
+    // Table is zero padded: wrong key or damaged file ends up here
+    return set->names[set->names_size - 1] == '\0';
+}
+
+static SubGhzKeystoreSet* subghz_keystore_compiled_load(
+    Storage* storage,
+    const char* file_name,
+    const SubGhzKeystoreSource* source) {
+    FuriString* path =
+        furi_string_alloc_printf("%s%s", file_name, SUBGHZ_KEYSTORE_COMPILED_EXTENSION);
+    File* file = storage_file_alloc(storage);
+    uint8_t* block = malloc(SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE * 2);
+    SubGhzKeystoreCompiledHeader header;
+    SubGhzKeystoreSet* set = NULL;
+    bool encrypted = false;
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header) ||
+           header.magic != SUBGHZ_KEYSTORE_COMPILED_MAGIC ||
+           header.version != SUBGHZ_KEYSTORE_COMPILED_VERSION) {
+            FURI_LOG_W(TAG, "Compiled keystore is damaged");
+            break;
+        }
+        if(memcmp(&header.source, source, sizeof(SubGhzKeystoreSource)) != 0) {
+            FURI_LOG_I(TAG, "Compiled keystore is outdated");
+            break;
+        }
+        if(!header.names_size || header.names_size % SUBGHZ_KEYSTORE_AES_BLOCK_SIZE) break;
+        // Sizes are allocated as is, they must add up to file size. No overflow in 64 bits
+        uint64_t records_size = (uint64_t)header.count * sizeof(SubGhzKeystoreRecord);
+        if(storage_file_size(file) != sizeof(header) + records_size + header.names_size) {
+            FURI_LOG_W(TAG, "Compiled keystore size mismatch");
+            break;
+        }
+
+        if(header.encryption == SubGhzKeystoreEncryptionAES256) {
+            subghz_keystore_mess_with_iv(header.iv);
+            if(!furi_hal_crypto_enclave_load_key(
+                   SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, header.iv)) {
+                FURI_LOG_E(TAG, "Unable to load decryption key");
+                break;
+            }
+            encrypted = true;
+        } else if(header.encryption != SubGhzKeystoreEncryptionNone) {
+            break;
+        }
+
+        set = subghz_keystore_set_alloc(file_name, source, header.count, header.names_size);
+        if(!subghz_keystore_compiled_read_set(set, file, block, encrypted)) {
+            FURI_LOG_W(TAG, "Compiled keystore is damaged");
+            subghz_keystore_set_free(set);
+            set = NULL;
+        }
+    } while(false);
+
+    if(encrypted) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+
+    memset(block, 0, SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE * 2);
+    free(block);
+    storage_file_free(file);
+    furi_string_free(path);
+    return set;
+}
+
+static void subghz_keystore_compiled_save(
+    Storage* storage,
+    const char* file_name,
+    const SubGhzKeystoreSource* source,
+    const SubGhzKeystoreBuilder* builder,
+    SubGhzKeystoreEncryption encryption) {
+    FuriString* path =
+        furi_string_alloc_printf("%s%s", file_name, SUBGHZ_KEYSTORE_COMPILED_EXTENSION);
+    File* file = storage_file_alloc(storage);
+    uint8_t* block = malloc(SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE);
+    bool encrypted = encryption == SubGhzKeystoreEncryptionAES256;
+    bool key_loaded = false;
+    bool result = false;
+
+    SubGhzKeystoreCompiledHeader header = {
+        .magic = SUBGHZ_KEYSTORE_COMPILED_MAGIC,
+        .version = SUBGHZ_KEYSTORE_COMPILED_VERSION,
+        .encryption = encryption,
+        .source = *source,
+        .count = builder->count,
+        .names_size = builder->names_size,
+    };
+
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        if(encrypted) {
+            uint8_t iv[16];
+            furi_hal_random_fill_buf(header.iv, sizeof(header.iv));
+            memcpy(iv, header.iv, sizeof(iv));
+            subghz_keystore_mess_with_iv(iv);
+            if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT, iv)) {
+                FURI_LOG_E(TAG, "Unable to load encryption key");
+                break;
+            }
+            key_loaded = true;
+        }
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        const uint8_t* data[] = {(const uint8_t*)builder->records, (const uint8_t*)builder->names};
+        const size_t sizes[] = {
+            builder->count * sizeof(SubGhzKeystoreRecord), builder->names_size};
+        result = true;
+        for(size_t i = 0; i < COUNT_OF(data) && result; i++) {
+            for(size_t offset = 0; offset < sizes[i] && result;
+                offset += SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE) {
+                size_t size = MIN(SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE, sizes[i] - offset);
+                result = subghz_keystore_compiled_write(
+                    file, block, data[i] + offset, size, encrypted);
+            }
+        }
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
+    storage_file_close(file);
+
+    if(result) {
+        FURI_LOG_I(TAG, "Compiled %zu keys to %s", builder->count, furi_string_get_cstr(path));
+    } else {
+        // Stale or partial file must not be picked up
+        FURI_LOG_W(TAG, "Unable to compile keystore");
+        storage_simply_remove(storage, furi_string_get_cstr(path));
+    }
+
+    memset(block, 0, SUBGHZ_KEYSTORE_COMPILED_BLOCK_SIZE);
+    free(block);
+    storage_file_free(file);
+    furi_string_free(path);
+}
+
+static SubGhzKeystoreSet* subghz_keystore_set_build(
+    Storage* storage,
+    const char* file_name,
+    const SubGhzKeystoreSource* source) {
+    SubGhzKeystoreBuilder builder = {0};
+    SubGhzKeystoreEncryption encryption = SubGhzKeystoreEncryptionNone;
+    SubGhzKeystoreSet* set = NULL;
+
+    if(subghz_keystore_text_load(storage, file_name, &builder, &encryption)) {
+        subghz_keystore_builder_finish(&builder);
+        set = subghz_keystore_set_alloc(file_name, source, builder.count, builder.names_size);
+        memcpy(set->names, builder.names, builder.names_size);
+        for(size_t i = 0; i < builder.count; i++) {
+            set->keys[i].key = builder.records[i].key;
+            set->keys[i].name = set->names + builder.records[i].name;
+            set->keys[i].type = builder.records[i].type;
+        }
+        subghz_keystore_compiled_save(storage, file_name, source, &builder, encryption);
+    }
+
+    subghz_keystore_builder_reset(&builder);
+    return set;
+}
+
+/** Find loaded set or load it: compiled file first, text file if it's missing or outdated */
+static SubGhzKeystoreSet* subghz_keystore_set_acquire(Storage* storage, const char* file_name) {
+    SubGhzKeystoreSource source = {0};
+    FileInfo fileinfo;
+    if(storage_common_stat(storage, file_name, &fileinfo) != FSE_OK) {
+        FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
+        return NULL;
+    }
+    source.size = fileinfo.size;
+    // Without timestamp size alone tells that file is changed
+    storage_common_timestamp(storage, file_name, &source.timestamp);
+
+    SubGhzKeystoreSet* set = subghz_keystore_sets;
+    while(set) {
+        if(furi_string_equal_str(set->path, file_name) &&
+           memcmp(&set->source, &source, sizeof(SubGhzKeystoreSource)) == 0) {
+            break;
+        }
+        set = set->next;
+    }
+
+    if(!set) {
+        set = subghz_keystore_compiled_load(storage, file_name, &source);
+        if(!set) set = subghz_keystore_set_build(storage, file_name, &source);
+        if(!set) return NULL;
+
+        set->next = subghz_keystore_sets;
+        subghz_keystore_sets = set;
+    }
+
+    set->refs++;
+    return set;
+}
+
+bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
+    furi_assert(instance);
+    furi_check(instance->sets_count < SUBGHZ_KEYSTORE_SETS_MAX);
+
+    FURI_LOG_I(TAG, "Loading keystore %s", file_name);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    furi_check(furi_mutex_acquire(subghz_keystore_sets_mutex, FuriWaitForever) == FuriStatusOk);
+    SubGhzKeystoreSet* set = subghz_keystore_set_acquire(storage, file_name);
+    furi_mutex_release(subghz_keystore_sets_mutex);
+
+    furi_record_close(RECORD_STORAGE);
+
+    if(set) {
+        instance->sets[instance->sets_count++] = set;
+        instance->count += set->count;
+    }
+
+    return set != NULL;
+}
+
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8_t* iv) {
     furi_assert(instance);
     bool result = false;
@@ -287,47 +716,47 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
 
         Stream* stream = flipper_format_get_raw_stream(flipper_format);
         size_t encrypted_line_count = 0;
-        for
-            M_EACH(key, instance->data, SubGhzKeyArray_t) {
-                // Wipe buffer before packing
-                memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-                memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
-                // Form unecreypted line
-                int len = snprintf(
-                    decrypted_line,
-                    SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE,
-                    "%08lX%08lX:%hu:%s",
-                    (uint32_t)(key->key >> 32),
-                    (uint32_t)key->key,
-                    key->type,
-                    furi_string_get_cstr(key->name));
-                // Verify length and align
-                furi_assert(len > 0);
-                if(len % 16 != 0) {
-                    len += (16 - len % 16);
-                }
-                furi_assert(len % 16 == 0);
-                furi_assert(len <= SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
-                // Form encrypted line
-                if(!furi_hal_crypto_encrypt(
-                       (uint8_t*)decrypted_line, (uint8_t*)encrypted_line, len)) {
-                    FURI_LOG_E(TAG, "Encryption failed");
-                    break;
-                }
-                // HEX Encode encrypted line
-                const char xx[] = "0123456789ABCDEF";
-                for(int i = 0; i < len; i++) {
-                    size_t cursor = len - i - 1;
-                    size_t hex_cursor = len * 2 - i * 2 - 1;
-                    encrypted_line[hex_cursor] = xx[encrypted_line[cursor] & 0xF];
-                    encrypted_line[hex_cursor - 1] = xx[(encrypted_line[cursor] >> 4) & 0xF];
-                }
-                stream_write_cstring(stream, encrypted_line);
-                stream_write_char(stream, '\n');
-                encrypted_line_count++;
+        for(size_t i = 0; i < subghz_keystore_get_count(instance); i++) {
+            const SubGhzKey* key = subghz_keystore_get_key(instance, i);
+            // Wipe buffer before packing
+            memset(decrypted_line, 0, SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+            memset(encrypted_line, 0, SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE);
+            // Form unecreypted line
+            int len = snprintf(
+                decrypted_line,
+                SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE,
+                "%08lX%08lX:%hu:%s",
+                (uint32_t)(key->key >> 32),
+                (uint32_t)key->key,
+                key->type,
+                key->name);
+            // Verify length and align
+            furi_assert(len > 0);
+            if(len % 16 != 0) {
+                len += (16 - len % 16);
+            }
+            furi_assert(len % 16 == 0);
+            furi_assert(len <= SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE);
+            // Form encrypted line
+            if(!furi_hal_crypto_encrypt(
+                   (uint8_t*)decrypted_line, (uint8_t*)encrypted_line, len)) {
+                FURI_LOG_E(TAG, "Encryption failed");
+                break;
+            }
+            // HEX Encode encrypted line
+            const char xx[] = "0123456789ABCDEF";
+            for(int i = 0; i < len; i++) {
+                size_t cursor = len - i - 1;
+                size_t hex_cursor = len * 2 - i * 2 - 1;
+                encrypted_line[hex_cursor] = xx[encrypted_line[cursor] & 0xF];
+                encrypted_line[hex_cursor - 1] = xx[(encrypted_line[cursor] >> 4) & 0xF];
             }
+            stream_write_cstring(stream, encrypted_line);
+            stream_write_char(stream, '\n');
+            encrypted_line_count++;
+        }
         furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_FILE_ENCRYPTION_KEY_SLOT);
-        size_t total_keys = SubGhzKeyArray_size(instance->data);
+        size_t total_keys = subghz_keystore_get_count(instance);
         result = encrypted_line_count == total_keys;
         if(result) {
             FURI_LOG_I(TAG, "Success. Encrypted: %zu of %zu", encrypted_line_count, total_keys);
@@ -344,9 +773,21 @@ bool subghz_keystore_save(SubGhzKeystore* instance, const char* file_name, uint8
     return result;
 }
 
-SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
+size_t subghz_keystore_get_count(SubGhzKeystore* instance) {
     furi_assert(instance);
-    return &instance->data;
+    return instance->count;
+}
+
+const SubGhzKey* subghz_keystore_get_key(SubGhzKeystore* instance, size_t index) {
+    furi_assert(instance);
+    furi_check(index < instance->count);
+
+    size_t set_index = 0;
+    while(index >= instance->sets[set_index]->count) {
+        index -= instance->sets[set_index]->count;
+        set_index++;
+    }
+    return &instance->sets[set_index]->keys[index];
 }
 
 bool subghz_keystore_raw_encrypted_save(
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <furi.h>
-#include <m-array.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -9,15 +8,11 @@ extern "C" {
 #endif
 
 typedef struct {
-    FuriString* name;
     uint64_t key;
+    const char* name;
     uint16_t type;
 } SubGhzKey;
 
-ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
-
-#define M_OPL_SubGhzKeyArray_t() ARRAY_OPLIST(SubGhzKeyArray, M_POD_OPLIST)
-
 typedef struct SubGhzKeystore SubGhzKeystore;
 
 /**
@@ -34,6 +29,8 @@ void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** 
  * Loading manufacture key from file
+ * Keys are read from compiled copy of the file, it's rebuilt when the file changes.
+ * Loaded keys are shared by all keystores that load the same file.
  * @param instance Pointer to a SubGhzKeystore instance
  * @param filename Full path to the file
  */
@@ -48,11 +45,19 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
 bool subghz_keystore_save(SubGhzKeystore* instance, const char* filename, uint8_t* iv);
 
 /** 
- * Get array of keys and names manufacture
+ * Get count of manufacture keys in all loaded files
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @return size_t
+ */
+size_t subghz_keystore_get_count(SubGhzKeystore* instance);
+
+/** 
+ * Get manufacture key and name, valid until keystore is freed
  * @param instance Pointer to a SubGhzKeystore instance
- * @return SubGhzKeyArray_t*
+ * @param index Key index, less than subghz_keystore_get_count
+ * @return const SubGhzKey*
  */
-SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance);
+const SubGhzKey* subghz_keystore_get_key(SubGhzKeystore* instance, size_t index);
 
 /** 
  * Save RAW encrypted to file
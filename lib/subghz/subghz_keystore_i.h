@@ -1,9 +1,15 @@
 #pragma once
 
-#include <m-array.h>
+#include "subghz_keystore.h"
+
+#define SUBGHZ_KEYSTORE_SETS_MAX 4
+
+typedef struct SubGhzKeystoreSet SubGhzKeystoreSet;
 
 struct SubGhzKeystore {
-    SubGhzKeyArray_t data;
+    SubGhzKeystoreSet* sets[SUBGHZ_KEYSTORE_SETS_MAX];
+    size_t sets_count;
+    size_t count;
     const char* mfname;
     uint8_t kl_type;
 };
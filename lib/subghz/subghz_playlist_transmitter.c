@@ -0,0 +1,649 @@
+#include "subghz_playlist_transmitter.h"
+
+#include "protocols/base.h"
+#include "protocols/raw.h"
+
+#include <m-array.h>
+#include <storage/storage.h>
+#include <toolbox/stream/stream.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "SubGhzPlaylistTransmitter"
+
+// Power of two: one on air, prefetched ones and sent ones not reclaimed yet
+#define SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS 8
+#define SUBGHZ_PLAYLIST_TRANSMITTER_PREFETCH_DEFAULT 2
+#define SUBGHZ_PLAYLIST_TRANSMITTER_GAP_DEFAULT_MS 100
+// Encoder default of all protocols but KeeLoq
+#define SUBGHZ_PLAYLIST_TRANSMITTER_REPEAT_DEFAULT 10
+// Signal is encoded ahead up to this size, the rest comes from encoder on air
+#define SUBGHZ_PLAYLIST_TRANSMITTER_UPLOAD_MIN 256
+#define SUBGHZ_PLAYLIST_TRANSMITTER_UPLOAD_MAX 4096
+#define SUBGHZ_PLAYLIST_TRANSMITTER_POOL_SIZE 8
+#define SUBGHZ_PLAYLIST_TRANSMITTER_POLL_MS 10
+#define SUBGHZ_PLAYLIST_TRANSMITTER_FREQUENCY_DEFAULT 433920000
+
+typedef enum {
+    SubGhzPlaylistTransmitterFlagWake = (1 << 0),
+    SubGhzPlaylistTransmitterFlagExit = (1 << 1),
+} SubGhzPlaylistTransmitterFlag;
+
+ARRAY_DEF(SubGhzPlaylistTransmitterPathArray, FuriString*, FURI_STRING_OPLIST)
+
+typedef struct {
+    size_t index;
+    bool failed;
+
+    uint32_t frequency;
+    FuriHalSubGhzPreset preset;
+    uint8_t* preset_data;
+    size_t preset_data_size;
+
+    const SubGhzProtocol* protocol;
+    /* Encoder is kept only if the signal didn't fit into upload */
+    void* encoder;
+    bool encoder_complete;
+    LevelDuration* upload;
+    size_t upload_size;
+    size_t upload_capacity;
+    size_t front;
+} SubGhzPlaylistTransmitterSlot;
+
+typedef struct {
+    const SubGhzProtocol* protocol;
+    void* encoder;
+} SubGhzPlaylistTransmitterPoolItem;
+
+struct SubGhzPlaylistTransmitter {
+    FuriThread* thread;
+    volatile bool running;
+    SubGhzEnvironment* environment;
+    const SubGhzDevice* device;
+    SubGhzPlaylistTransmitterPathArray_t paths;
+
+    uint32_t gap_ms;
+    size_t prefetch;
+    uint32_t repeat;
+    SubGhzPlaylistTransmitterCallback callback;
+    void* context;
+
+    /* Free running slot positions: loaded by thread, sent by tx callback while radio is
+     * on and by thread otherwise, reclaimed by thread */
+    SubGhzPlaylistTransmitterSlot slots[SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS];
+    uint32_t head;
+    uint32_t air;
+    uint32_t tail;
+    bool loaded_all;
+
+    SubGhzPlaylistTransmitterPoolItem pool[SUBGHZ_PLAYLIST_TRANSMITTER_POOL_SIZE];
+    size_t pool_count;
+
+    /* Radio session, set up by thread before tx start */
+    bool session;
+    uint32_t session_frequency;
+    FuriHalSubGhzPreset session_preset;
+    uint8_t* session_preset_data;
+    size_t session_preset_data_size;
+
+    /* Tx callback state */
+    SubGhzPlaylistTransmitterSlot* current;
+    bool signal_started;
+    bool gap_pending;
+    bool underrun;
+    bool has_signal_end;
+    uint32_t signal_end_tick;
+    SubGhzPlaylistTransmitterStats stats;
+};
+
+SubGhzPlaylistTransmitter*
+    subghz_playlist_transmitter_alloc(SubGhzEnvironment* environment, const SubGhzDevice* device) {
+    furi_assert(environment);
+    furi_assert(device);
+    SubGhzPlaylistTransmitter* instance = malloc(sizeof(SubGhzPlaylistTransmitter));
+
+    instance->environment = environment;
+    instance->device = device;
+    SubGhzPlaylistTransmitterPathArray_init(instance->paths);
+    instance->gap_ms = SUBGHZ_PLAYLIST_TRANSMITTER_GAP_DEFAULT_MS;
+    instance->prefetch = SUBGHZ_PLAYLIST_TRANSMITTER_PREFETCH_DEFAULT;
+    instance->repeat = SUBGHZ_PLAYLIST_TRANSMITTER_REPEAT_DEFAULT;
+
+    return instance;
+}
+
+void subghz_playlist_transmitter_free(SubGhzPlaylistTransmitter* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+
+    for(size_t i = 0; i < SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS; i++) {
+        free(instance->slots[i].upload);
+    }
+    free(instance->session_preset_data);
+    SubGhzPlaylistTransmitterPathArray_clear(instance->paths);
+    free(instance);
+}
+
+void subghz_playlist_transmitter_set_callback(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    instance->callback = callback;
+    instance->context = context;
+}
+
+void subghz_playlist_transmitter_set_gap(SubGhzPlaylistTransmitter* instance, uint32_t gap_ms) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    instance->gap_ms = gap_ms;
+}
+
+void subghz_playlist_transmitter_set_prefetch(SubGhzPlaylistTransmitter* instance, size_t count) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    furi_check(count >= 1 && count <= SUBGHZ_PLAYLIST_TRANSMITTER_PREFETCH_MAX);
+    instance->prefetch = count;
+}
+
+void subghz_playlist_transmitter_set_repeat(SubGhzPlaylistTransmitter* instance, uint32_t repeat) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    instance->repeat = repeat;
+}
+
+void subghz_playlist_transmitter_add(SubGhzPlaylistTransmitter* instance, const char* path) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    FuriString* item = furi_string_alloc_set(path);
+    SubGhzPlaylistTransmitterPathArray_push_back(instance->paths, item);
+    furi_string_free(item);
+}
+
+void subghz_playlist_transmitter_clear(SubGhzPlaylistTransmitter* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+    SubGhzPlaylistTransmitterPathArray_reset(instance->paths);
+}
+
+static FuriHalSubGhzPreset subghz_playlist_transmitter_get_preset(const char* preset_name) {
+    if(!strcmp(preset_name, "FuriHalSubGhzPresetOok270Async")) {
+        return FuriHalSubGhzPresetOok270Async;
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPresetOok650Async")) {
+        return FuriHalSubGhzPresetOok650Async;
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPreset2FSKDev238Async")) {
+        return FuriHalSubGhzPreset2FSKDev238Async;
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPreset2FSKDev476Async")) {
+        return FuriHalSubGhzPreset2FSKDev476Async;
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPresetMSK99_97KbAsync")) {
+        return FuriHalSubGhzPresetMSK99_97KbAsync;
+    } else if(!strcmp(preset_name, "FuriHalSubGhzPresetGFSK9_99KbAsync")) {
+        return FuriHalSubGhzPresetGFSK9_99KbAsync;
+    }
+    return FuriHalSubGhzPresetCustom;
+}
+
+static void* subghz_playlist_transmitter_pool_take(
+    SubGhzPlaylistTransmitter* instance,
+    const SubGhzProtocol* protocol) {
+    for(size_t i = 0; i < instance->pool_count; i++) {
+        if(instance->pool[i].protocol == protocol) {
+            void* encoder = instance->pool[i].encoder;
+            instance->pool[i] = instance->pool[--instance->pool_count];
+            return encoder;
+        }
+    }
+    return protocol->encoder->alloc(instance->environment);
+}
+
+/** Keep encoder for the next file of its protocol
+ *
+ * Only encoders that ran to the end are kept: they have nothing left to send and
+ * deserialize sets everything else. RAW encoder owns a file worker, it is not kept.
+ */
+static void subghz_playlist_transmitter_pool_put(
+    SubGhzPlaylistTransmitter* instance,
+    const SubGhzProtocol* protocol,
+    void* encoder,
+    bool complete) {
+    if(complete && protocol->type != SubGhzProtocolTypeRAW &&
+       instance->pool_count < SUBGHZ_PLAYLIST_TRANSMITTER_POOL_SIZE) {
+        instance->pool[instance->pool_count].protocol = protocol;
+        instance->pool[instance->pool_count].encoder = encoder;
+        instance->pool_count++;
+    } else {
+        if(!complete) protocol->encoder->stop(encoder);
+        protocol->encoder->free(encoder);
+    }
+}
+
+static void subghz_playlist_transmitter_pool_clear(SubGhzPlaylistTransmitter* instance) {
+    for(size_t i = 0; i < instance->pool_count; i++) {
+        instance->pool[i].protocol->encoder->free(instance->pool[i].encoder);
+    }
+    instance->pool_count = 0;
+}
+
+/** Encode signal ahead: take edges from encoder until it is over or upload is full */
+static void subghz_playlist_transmitter_encode(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterSlot* slot) {
+    while(true) {
+        if(slot->upload_size == slot->upload_capacity) {
+            if(slot->upload_capacity == SUBGHZ_PLAYLIST_TRANSMITTER_UPLOAD_MAX) return;
+            slot->upload_capacity = slot->upload_capacity ? slot->upload_capacity * 2 :
+                                                            SUBGHZ_PLAYLIST_TRANSMITTER_UPLOAD_MIN;
+            slot->upload = realloc(slot->upload, sizeof(LevelDuration) * slot->upload_capacity);
+        }
+
+        LevelDuration level_duration = slot->protocol->encoder->yield(slot->encoder);
+        if(level_duration_is_reset(level_duration)) {
+            subghz_playlist_transmitter_pool_put(instance, slot->protocol, slot->encoder, true);
+            slot->encoder = NULL;
+            return;
+        }
+        slot->upload[slot->upload_size++] = level_duration;
+    }
+}
+
+static bool subghz_playlist_transmitter_load(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterSlot* slot,
+    const char* path,
+    FlipperFormat* fff_file,
+    FlipperFormat* fff_data,
+    FuriString* temp_str) {
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(fff_file, path)) {
+            FURI_LOG_E(TAG, "Unable to open %s", path);
+            break;
+        }
+
+        if(!flipper_format_read_uint32(fff_file, "Frequency", &slot->frequency, 1)) {
+            FURI_LOG_W(TAG, "Missing Frequency, defaulting to 433.92MHz");
+            slot->frequency = SUBGHZ_PLAYLIST_TRANSMITTER_FREQUENCY_DEFAULT;
+        }
+        if(!subghz_devices_is_frequency_valid(instance->device, slot->frequency)) {
+            FURI_LOG_E(TAG, "Frequency not supported by device: %lu", slot->frequency);
+            break;
+        }
+
+        if(!flipper_format_read_string(fff_file, "Preset", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Preset");
+            break;
+        }
+        slot->preset = subghz_playlist_transmitter_get_preset(furi_string_get_cstr(temp_str));
+        if(slot->preset == FuriHalSubGhzPresetCustom) {
+            uint32_t size = 0;
+            if(!flipper_format_get_value_count(fff_file, "Custom_preset_data", &size) || !size) {
+                FURI_LOG_E(TAG, "Missing Custom_preset_data");
+                break;
+            }
+            slot->preset_data = malloc(size);
+            slot->preset_data_size = size;
+            if(!flipper_format_read_hex(fff_file, "Custom_preset_data", slot->preset_data, size)) {
+                FURI_LOG_E(TAG, "Custom_preset_data read error");
+                break;
+            }
+        }
+
+        if(!flipper_format_read_string(fff_file, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+        slot->protocol = subghz_environment_get_protocol_by_name(
+            instance->environment, furi_string_get_cstr(temp_str));
+        if(!slot->protocol || !slot->protocol->encoder || !slot->protocol->encoder->alloc) {
+            FURI_LOG_E(TAG, "Protocol can't be sent: %s", furi_string_get_cstr(temp_str));
+            break;
+        }
+
+        if(slot->protocol->type == SubGhzProtocolTypeRAW) {
+            subghz_protocol_raw_gen_fff_data(
+                fff_data, path, subghz_devices_get_name(instance->device));
+        } else {
+            Stream* stream = flipper_format_get_raw_stream(fff_data);
+            stream_clean(stream);
+            stream_copy_full(flipper_format_get_raw_stream(fff_file), stream);
+            // Reused encoder has repeat count of the previous file
+            flipper_format_rewind(fff_data);
+            if(!flipper_format_key_exist(fff_data, "Repeat")) {
+                flipper_format_insert_or_update_uint32(fff_data, "Repeat", &instance->repeat, 1);
+            }
+        }
+        flipper_format_rewind(fff_data);
+
+        slot->encoder = subghz_playlist_transmitter_pool_take(instance, slot->protocol);
+        if(slot->protocol->encoder->deserialize(slot->encoder, fff_data) !=
+           SubGhzProtocolStatusOk) {
+            FURI_LOG_E(TAG, "Unable to load %s", path);
+            subghz_playlist_transmitter_pool_put(instance, slot->protocol, slot->encoder, false);
+            slot->encoder = NULL;
+            break;
+        }
+
+        // RAW is streamed from file on air
+        if(slot->protocol->type != SubGhzProtocolTypeRAW) {
+            subghz_playlist_transmitter_encode(instance, slot);
+        }
+        result = true;
+    } while(false);
+
+    flipper_format_file_close(fff_file);
+    return result;
+}
+
+static void subghz_playlist_transmitter_slot_release(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterSlot* slot) {
+    if(slot->encoder) {
+        subghz_playlist_transmitter_pool_put(
+            instance, slot->protocol, slot->encoder, slot->encoder_complete);
+        slot->encoder = NULL;
+    }
+    free(slot->preset_data);
+    slot->preset_data = NULL;
+    slot->preset_data_size = 0;
+}
+
+static void subghz_playlist_transmitter_reclaim(SubGhzPlaylistTransmitter* instance) {
+    uint32_t air = __atomic_load_n(&instance->air, __ATOMIC_ACQUIRE);
+    while(instance->tail != air) {
+        SubGhzPlaylistTransmitterSlot* slot =
+            &instance->slots[instance->tail & (SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS - 1)];
+        subghz_playlist_transmitter_slot_release(instance, slot);
+        instance->tail++;
+
+        if(instance->callback) {
+            instance->callback(
+                instance->context,
+                slot->failed ? SubGhzPlaylistTransmitterEventError :
+                               SubGhzPlaylistTransmitterEventSent,
+                slot->index);
+        }
+    }
+}
+
+static LevelDuration subghz_playlist_transmitter_slot_yield(SubGhzPlaylistTransmitterSlot* slot) {
+    if(slot->front < slot->upload_size) {
+        return slot->upload[slot->front++];
+    }
+    if(slot->encoder && !slot->encoder_complete) {
+        LevelDuration level_duration = slot->protocol->encoder->yield(slot->encoder);
+        if(level_duration_is_reset(level_duration)) slot->encoder_complete = true;
+        return level_duration;
+    }
+    return level_duration_reset();
+}
+
+static void subghz_playlist_transmitter_signal_start(SubGhzPlaylistTransmitter* instance) {
+    instance->signal_started = true;
+    if(!instance->has_signal_end) return;
+
+    SubGhzPlaylistTransmitterStats* stats = &instance->stats;
+    uint32_t gap_ms = (furi_get_tick() - instance->signal_end_tick) * 1000 /
+                      furi_kernel_get_tick_frequency();
+    if(!stats->count || gap_ms < stats->min_ms) stats->min_ms = gap_ms;
+    if(gap_ms > stats->max_ms) stats->max_ms = gap_ms;
+    stats->total_ms += gap_ms;
+    stats->count++;
+
+    uint32_t extra_ms = gap_ms > instance->gap_ms ? gap_ms - instance->gap_ms : 0;
+    size_t bin = extra_ms / SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_STEP_MS;
+    stats->histogram[MIN(bin, (size_t)SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_SIZE - 1)]++;
+}
+
+static bool subghz_playlist_transmitter_is_same_session(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterSlot* slot) {
+    return slot->frequency == instance->session_frequency &&
+           slot->preset == instance->session_preset &&
+           slot->preset_data_size == instance->session_preset_data_size &&
+           (!slot->preset_data_size ||
+            !memcmp(slot->preset_data, instance->session_preset_data, slot->preset_data_size));
+}
+
+/** Async tx callback, called from interrupt
+ *
+ * Plays loaded signals back to back with silence in between, while they are on the
+ * frequency and preset of the session. Radio is released at the first signal that
+ * needs another setup, or at the end of playlist.
+ */
+static LevelDuration subghz_playlist_transmitter_yield(void* context) {
+    SubGhzPlaylistTransmitter* instance = context;
+
+    while(true) {
+        if(instance->current) {
+            LevelDuration level_duration =
+                subghz_playlist_transmitter_slot_yield(instance->current);
+            if(!level_duration_is_reset(level_duration)) {
+                if(!instance->signal_started && !level_duration_is_wait(level_duration)) {
+                    subghz_playlist_transmitter_signal_start(instance);
+                }
+                return level_duration;
+            }
+
+            instance->current = NULL;
+            instance->has_signal_end = true;
+            instance->signal_end_tick = furi_get_tick();
+            instance->gap_pending = true;
+            __atomic_store_n(&instance->air, instance->air + 1, __ATOMIC_RELEASE);
+            furi_thread_flags_set(
+                furi_thread_get_id(instance->thread), SubGhzPlaylistTransmitterFlagWake);
+        }
+
+        // Last head is published before loaded_all
+        bool loaded_all = __atomic_load_n(&instance->loaded_all, __ATOMIC_ACQUIRE);
+        if(instance->air == __atomic_load_n(&instance->head, __ATOMIC_ACQUIRE)) {
+            if(loaded_all || !instance->running) return level_duration_reset();
+            if(!instance->underrun) {
+                instance->underrun = true;
+                instance->stats.underruns++;
+            }
+            return level_duration_wait();
+        }
+
+        SubGhzPlaylistTransmitterSlot* slot =
+            &instance->slots[instance->air & (SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS - 1)];
+        if(!subghz_playlist_transmitter_is_same_session(instance, slot)) {
+            return level_duration_reset();
+        }
+
+        if(instance->gap_pending) {
+            instance->gap_pending = false;
+            if(instance->gap_ms) return level_duration_make(false, instance->gap_ms * 1000);
+        }
+
+        instance->current = slot;
+        instance->signal_started = false;
+        instance->underrun = false;
+    }
+}
+
+/** Set radio up for the first loaded signal and start tx, after the gap */
+static void subghz_playlist_transmitter_session_start(SubGhzPlaylistTransmitter* instance) {
+    SubGhzPlaylistTransmitterSlot* slot =
+        &instance->slots[instance->air & (SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS - 1)];
+
+    if(instance->has_signal_end) {
+        uint32_t due = instance->signal_end_tick + furi_ms_to_ticks(instance->gap_ms);
+        while(instance->running) {
+            int32_t left = (int32_t)(due - furi_get_tick());
+            if(left <= 0) break;
+            furi_thread_flags_wait(SubGhzPlaylistTransmitterFlagExit, FuriFlagWaitAny, left);
+        }
+        if(!instance->running) return;
+        instance->stats.restarts++;
+    }
+
+    instance->session_frequency = slot->frequency;
+    instance->session_preset = slot->preset;
+    instance->session_preset_data_size = slot->preset_data_size;
+    free(instance->session_preset_data);
+    instance->session_preset_data = NULL;
+    if(slot->preset_data_size) {
+        instance->session_preset_data = malloc(slot->preset_data_size);
+        memcpy(instance->session_preset_data, slot->preset_data, slot->preset_data_size);
+    }
+
+    subghz_devices_load_preset(instance->device, slot->preset, slot->preset_data);
+    subghz_devices_set_frequency(instance->device, slot->frequency);
+
+    instance->current = NULL;
+    instance->gap_pending = false;
+    instance->underrun = false;
+    if(!subghz_devices_set_tx(instance->device) ||
+       !subghz_devices_start_async_tx(
+           instance->device, subghz_playlist_transmitter_yield, instance)) {
+        FURI_LOG_E(TAG, "Tx is not allowed on %lu", slot->frequency);
+        subghz_devices_idle(instance->device);
+        slot->failed = true;
+        __atomic_store_n(&instance->air, instance->air + 1, __ATOMIC_RELEASE);
+        return;
+    }
+    instance->session = true;
+}
+
+static void subghz_playlist_transmitter_session_stop(SubGhzPlaylistTransmitter* instance) {
+    subghz_devices_stop_async_tx(instance->device);
+    subghz_devices_idle(instance->device);
+    instance->session = false;
+}
+
+static int32_t subghz_playlist_transmitter_thread(void* context) {
+    SubGhzPlaylistTransmitter* instance = context;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    FlipperFormat* fff_data = flipper_format_string_alloc();
+    FuriString* temp_str = furi_string_alloc();
+
+    size_t count = SubGhzPlaylistTransmitterPathArray_size(instance->paths);
+    size_t next = 0;
+    if(!count) __atomic_store_n(&instance->loaded_all, true, __ATOMIC_RELEASE);
+
+    bool completed = false;
+    while(instance->running) {
+        // Radio first: gap is counted from the end of signal
+        if(instance->session && subghz_devices_is_async_complete_tx(instance->device)) {
+            subghz_playlist_transmitter_session_stop(instance);
+        }
+        subghz_playlist_transmitter_reclaim(instance);
+
+        uint32_t air = __atomic_load_n(&instance->air, __ATOMIC_ACQUIRE);
+        if(!instance->session && air != instance->head) {
+            subghz_playlist_transmitter_session_start(instance);
+            continue;
+        }
+
+        if(next < count && instance->head - air <= instance->prefetch &&
+           instance->head - instance->tail < SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS) {
+            SubGhzPlaylistTransmitterSlot* slot =
+                &instance->slots[instance->head & (SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS - 1)];
+            slot->index = next;
+            slot->failed = false;
+            slot->encoder = NULL;
+            slot->encoder_complete = false;
+            slot->upload_size = 0;
+            slot->front = 0;
+
+            FuriString* path = *SubGhzPlaylistTransmitterPathArray_get(instance->paths, next);
+            if(subghz_playlist_transmitter_load(
+                   instance, slot, furi_string_get_cstr(path), fff_file, fff_data, temp_str)) {
+                __atomic_store_n(&instance->head, instance->head + 1, __ATOMIC_RELEASE);
+            } else {
+                subghz_playlist_transmitter_slot_release(instance, slot);
+                if(instance->callback) {
+                    instance->callback(
+                        instance->context, SubGhzPlaylistTransmitterEventError, next);
+                }
+            }
+
+            next++;
+            if(next == count) __atomic_store_n(&instance->loaded_all, true, __ATOMIC_RELEASE);
+            continue;
+        }
+
+        if(next == count && !instance->session && air == instance->head) {
+            completed = true;
+            break;
+        }
+
+        furi_thread_flags_wait(
+            SubGhzPlaylistTransmitterFlagWake | SubGhzPlaylistTransmitterFlagExit,
+            FuriFlagWaitAny,
+            SUBGHZ_PLAYLIST_TRANSMITTER_POLL_MS);
+    }
+
+    if(instance->session) subghz_playlist_transmitter_session_stop(instance);
+    subghz_playlist_transmitter_reclaim(instance);
+    // Loaded and never sent
+    while(instance->tail != instance->head) {
+        subghz_playlist_transmitter_slot_release(
+            instance, &instance->slots[instance->tail & (SUBGHZ_PLAYLIST_TRANSMITTER_SLOTS - 1)]);
+        instance->tail++;
+    }
+    subghz_playlist_transmitter_pool_clear(instance);
+
+    furi_string_free(temp_str);
+    flipper_format_free(fff_data);
+    flipper_format_free(fff_file);
+    furi_record_close(RECORD_STORAGE);
+
+    instance->running = false;
+    if(completed && instance->callback) {
+        instance->callback(instance->context, SubGhzPlaylistTransmitterEventEnd, 0);
+    }
+    return 0;
+}
+
+bool subghz_playlist_transmitter_start(SubGhzPlaylistTransmitter* instance) {
+    furi_assert(instance);
+    furi_assert(!instance->thread);
+
+    instance->head = 0;
+    instance->air = 0;
+    instance->tail = 0;
+    instance->loaded_all = false;
+    instance->session = false;
+    instance->current = NULL;
+    instance->has_signal_end = false;
+    memset(&instance->stats, 0, sizeof(SubGhzPlaylistTransmitterStats));
+
+    instance->running = true;
+    instance->thread = furi_thread_alloc_ex(
+        "SubGhzPlaylistTx", 2048, subghz_playlist_transmitter_thread, instance);
+    furi_thread_start(instance->thread);
+    return true;
+}
+
+void subghz_playlist_transmitter_stop(SubGhzPlaylistTransmitter* instance) {
+    furi_assert(instance);
+    if(!instance->thread) return;
+
+    instance->running = false;
+    furi_thread_flags_set(
+        furi_thread_get_id(instance->thread), SubGhzPlaylistTransmitterFlagExit);
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    instance->thread = NULL;
+}
+
+bool subghz_playlist_transmitter_is_running(SubGhzPlaylistTransmitter* instance) {
+    furi_assert(instance);
+    return instance->thread && furi_thread_get_state(instance->thread) != FuriThreadStateStopped;
+}
+
+void subghz_playlist_transmitter_get_stats(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = instance->stats;
+    FURI_CRITICAL_EXIT();
+}
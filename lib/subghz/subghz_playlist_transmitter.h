@@ -0,0 +1,143 @@
+#pragma once
+
+#include "environment.h"
+#include "devices/devices.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SubGhzPlaylistTransmitter SubGhzPlaylistTransmitter;
+
+typedef enum {
+    SubGhzPlaylistTransmitterEventSent, /**< File was sent */
+    SubGhzPlaylistTransmitterEventError, /**< File can't be loaded or sent, skipped */
+    SubGhzPlaylistTransmitterEventEnd, /**< All files are done, transmitter is idle */
+} SubGhzPlaylistTransmitterEvent;
+
+/** Event callback, called from the worker thread
+ *
+ * @param context callback context
+ * @param event SubGhzPlaylistTransmitterEvent
+ * @param index file index in playlist, undefined for End
+ */
+typedef void (*SubGhzPlaylistTransmitterCallback)(
+    void* context,
+    SubGhzPlaylistTransmitterEvent event,
+    size_t index);
+
+#define SUBGHZ_PLAYLIST_TRANSMITTER_PREFETCH_MAX 4
+#define SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_SIZE 8
+#define SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_STEP_MS 5
+
+/** Gaps between signals, from the end of one signal to the start of the next */
+typedef struct {
+    uint32_t count;
+    uint32_t min_ms;
+    uint32_t max_ms;
+    uint64_t total_ms;
+    /** Gaps longer than configured by [i * STEP, (i + 1) * STEP) ms, last one is open */
+    uint32_t histogram[SUBGHZ_PLAYLIST_TRANSMITTER_HISTOGRAM_SIZE];
+    /** Radio was restarted between signals: frequency or preset changed */
+    uint32_t restarts;
+    /** Next signal was not loaded yet when it was due */
+    uint32_t underruns;
+} SubGhzPlaylistTransmitterStats;
+
+/**
+ * Allocate SubGhzPlaylistTransmitter.
+ * Sends .sub files one after another without dead time: the worker thread loads and
+ * encodes the next files while the current one is on air. Files on the same frequency
+ * and preset are sent in one radio session, separated by silence of configured gap.
+ * Encoder instances are kept per protocol and reused.
+ * @param environment Pointer to a SubGhzEnvironment instance, with registry and keystore set
+ * @param device Pointer to a SubGhzDevice, begun by caller
+ * @return SubGhzPlaylistTransmitter* pointer to a SubGhzPlaylistTransmitter instance
+ */
+SubGhzPlaylistTransmitter*
+    subghz_playlist_transmitter_alloc(SubGhzEnvironment* environment, const SubGhzDevice* device);
+
+/**
+ * Free SubGhzPlaylistTransmitter.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ */
+void subghz_playlist_transmitter_free(SubGhzPlaylistTransmitter* instance);
+
+/**
+ * Set event callback.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param callback SubGhzPlaylistTransmitterCallback callback
+ * @param context
+ */
+void subghz_playlist_transmitter_set_callback(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterCallback callback,
+    void* context);
+
+/**
+ * Set gap between signals. It is the minimum: gap is longer if the next file is not
+ * loaded yet or radio has to be restarted.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param gap_ms gap, ms
+ */
+void subghz_playlist_transmitter_set_gap(SubGhzPlaylistTransmitter* instance, uint32_t gap_ms);
+
+/**
+ * Set count of files loaded ahead of the one on air.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param count 1 to SUBGHZ_PLAYLIST_TRANSMITTER_PREFETCH_MAX
+ */
+void subghz_playlist_transmitter_set_prefetch(SubGhzPlaylistTransmitter* instance, size_t count);
+
+/**
+ * Set repeat count of files without Repeat key.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param repeat repeat count
+ */
+void subghz_playlist_transmitter_set_repeat(SubGhzPlaylistTransmitter* instance, uint32_t repeat);
+
+/**
+ * Add file to playlist.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param path .sub file path, key or RAW
+ */
+void subghz_playlist_transmitter_add(SubGhzPlaylistTransmitter* instance, const char* path);
+
+/**
+ * Remove all files from playlist.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ */
+void subghz_playlist_transmitter_clear(SubGhzPlaylistTransmitter* instance);
+
+/**
+ * Start sending playlist from the first file, stats are reset.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @return bool - true if ok
+ */
+bool subghz_playlist_transmitter_start(SubGhzPlaylistTransmitter* instance);
+
+/**
+ * Stop sending and wait for the worker thread, radio is left idle.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ */
+void subghz_playlist_transmitter_stop(SubGhzPlaylistTransmitter* instance);
+
+/**
+ * Check if playlist is still being sent.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @return bool - true if running
+ */
+bool subghz_playlist_transmitter_is_running(SubGhzPlaylistTransmitter* instance);
+
+/**
+ * Get gap stats since start.
+ * @param instance Pointer to a SubGhzPlaylistTransmitter instance
+ * @param stats output
+ */
+void subghz_playlist_transmitter_get_stats(
+    SubGhzPlaylistTransmitter* instance,
+    SubGhzPlaylistTransmitterStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,6 +10,8 @@
 
 #define FREQUENCY_FLAG_DEFAULT (1 << 31)
 #define FREQUENCY_MASK (0xFFFFFFFF ^ FREQUENCY_FLAG_DEFAULT)
+// Same bit, hopper list only
+#define FREQUENCY_FLAG_PINNED FREQUENCY_FLAG_DEFAULT
 
 /* Default */
 static const uint32_t subghz_frequency_list[] = {
@@ -192,6 +194,17 @@ static void subghz_setting_load_default_region(
         instance, "FM476", subghz_device_cc1101_preset_2fsk_dev47_6khz_async_regs);
 }
 
+static void subghz_setting_pin_hopper_frequency(SubGhzSetting* instance, uint32_t frequency) {
+    for
+        M_EACH(item, instance->hopper_frequencies, FrequencyList_t) {
+            if((*item & FREQUENCY_MASK) == frequency) {
+                *item |= FREQUENCY_FLAG_PINNED;
+                return;
+            }
+        }
+    FrequencyList_push_back(instance->hopper_frequencies, frequency | FREQUENCY_FLAG_PINNED);
+}
+
 // Region check removed
 void subghz_setting_load_default(SubGhzSetting* instance) {
     subghz_setting_load_default_region(
@@ -272,6 +285,21 @@ void subghz_setting_load(SubGhzSetting* instance, const char* file_path) {
                 }
             }
 
+            // Pinned hopper frequencies (optional)
+            if(!flipper_format_rewind(fff_data_file)) {
+                FURI_LOG_E(TAG, "Rewind error");
+                break;
+            }
+            while(flipper_format_read_uint32(
+                fff_data_file, "Hopper_pinned_frequency", (uint32_t*)&temp_data32, 1)) {
+                if(furi_hal_subghz_is_frequency_valid(temp_data32)) {
+                    FURI_LOG_I(TAG, "Hopper pinned frequency loaded %lu", temp_data32);
+                    subghz_setting_pin_hopper_frequency(instance, temp_data32);
+                } else {
+                    FURI_LOG_E(TAG, "Hopper frequency not supported %lu", temp_data32);
+                }
+            }
+
             // Default frequency (optional)
             if(!flipper_format_rewind(fff_data_file)) {
                 FURI_LOG_E(TAG, "Rewind error");
@@ -439,12 +467,21 @@ uint32_t subghz_setting_get_frequency(SubGhzSetting* instance, size_t idx) {
 uint32_t subghz_setting_get_hopper_frequency(SubGhzSetting* instance, size_t idx) {
     furi_assert(instance);
     if(idx < FrequencyList_size(instance->hopper_frequencies)) {
-        return *FrequencyList_get(instance->hopper_frequencies, idx);
+        return (*FrequencyList_get(instance->hopper_frequencies, idx)) & FREQUENCY_MASK;
     } else {
         return 0;
     }
 }
 
+bool subghz_setting_is_hopper_frequency_pinned(SubGhzSetting* instance, size_t idx) {
+    furi_assert(instance);
+    if(idx < FrequencyList_size(instance->hopper_frequencies)) {
+        return (*FrequencyList_get(instance->hopper_frequencies, idx)) & FREQUENCY_FLAG_PINNED;
+    } else {
+        return false;
+    }
+}
+
 uint32_t subghz_setting_get_frequency_default_index(SubGhzSetting* instance) {
     furi_assert(instance);
     for(size_t i = 0; i < FrequencyList_size(instance->frequencies); i++) {
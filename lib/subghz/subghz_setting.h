@@ -55,6 +55,8 @@ uint32_t subghz_setting_get_frequency(SubGhzSetting* instance, size_t idx);
 
 uint32_t subghz_setting_get_hopper_frequency(SubGhzSetting* instance, size_t idx);
 
+bool subghz_setting_is_hopper_frequency_pinned(SubGhzSetting* instance, size_t idx);
+
 uint32_t subghz_setting_get_frequency_default_index(SubGhzSetting* instance);
 
 uint32_t subghz_setting_get_default_frequency(SubGhzSetting* instance);
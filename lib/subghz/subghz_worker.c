@@ -1,15 +1,27 @@
 #include "subghz_worker.h"
 
 #include <furi.h>
+#include <toolbox/level_duration_ring.h>
 
 #define TAG "SubGhzWorker"
 
+// ~40 ms of noise at the highest edge rate
+#define SUBGHZ_WORKER_RING_SIZE 4096
+// Wake the thread early when a quarter of the ring is taken
+#define SUBGHZ_WORKER_RING_WATERMARK (SUBGHZ_WORKER_RING_SIZE / 4)
+// Otherwise drain on timeout, slow signals are not held back
+#define SUBGHZ_WORKER_DRAIN_TIMEOUT_MS 10
+
+typedef enum {
+    SubGhzWorkerFlagData = (1 << 0),
+    SubGhzWorkerFlagExit = (1 << 1),
+} SubGhzWorkerFlag;
+
 struct SubGhzWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    LevelDurationRing* ring;
 
     volatile bool running;
-    volatile bool overrun;
 
     LevelDuration filter_level_duration;
     uint16_t filter_duration;
@@ -28,14 +40,50 @@ struct SubGhzWorker {
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration = level_duration_make(level, duration);
-    if(instance->overrun) {
-        instance->overrun = false;
-        level_duration = level_duration_reset();
+    if(level_duration_ring_push(instance->ring, level_duration_make(level, duration))) {
+        FuriThreadId thread_id = furi_thread_get_id(instance->thread);
+        if(thread_id) furi_thread_flags_set(thread_id, SubGhzWorkerFlagData);
+    }
+}
+
+/** Glue short durations and same levels, pass complete pairs on
+ * 
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param block received durations
+ * @param count duration count
+ */
+static void subghz_worker_filter(
+    SubGhzWorker* instance,
+    const LevelDuration* block,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        if(level_duration_is_reset(block[i])) {
+            FURI_LOG_E(
+                TAG,
+                "Overrun buffer, %lu dropped",
+                level_duration_ring_get_dropped_count(instance->ring));
+            if(instance->overrun_callback) instance->overrun_callback(instance->context);
+            continue;
+        }
+
+        bool level = level_duration_get_level(block[i]);
+        uint32_t duration = level_duration_get_duration(block[i]);
+
+        if((duration < instance->filter_duration) ||
+           (instance->filter_level_duration.level == level)) {
+            instance->filter_level_duration.duration += duration;
+
+        } else if(instance->filter_level_duration.level != level) {
+            if(instance->pair_callback)
+                instance->pair_callback(
+                    instance->context,
+                    instance->filter_level_duration.level,
+                    instance->filter_level_duration.duration);
+
+            instance->filter_level_duration.duration = duration;
+            instance->filter_level_duration.level = level;
+        }
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
 }
 
 /** Worker callback thread
@@ -46,33 +94,17 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    const LevelDuration* block;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                FURI_LOG_E(TAG, "Overrun buffer");
-                if(instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-
-                if((duration < instance->filter_duration) ||
-                   (instance->filter_level_duration.level == level)) {
-                    instance->filter_level_duration.duration += duration;
-
-                } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
-
-                    instance->filter_level_duration.duration = duration;
-                    instance->filter_level_duration.level = level;
-                }
-            }
+        furi_thread_flags_wait(
+            SubGhzWorkerFlagData | SubGhzWorkerFlagExit,
+            FuriFlagWaitAny,
+            SUBGHZ_WORKER_DRAIN_TIMEOUT_MS);
+
+        size_t count;
+        while((count = level_duration_ring_peek(instance->ring, &block)) > 0) {
+            subghz_worker_filter(instance, block, count);
+            level_duration_ring_release(instance->ring, count);
         }
     }
 
@@ -85,8 +117,8 @@ SubGhzWorker* subghz_worker_alloc() {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->ring =
+        level_duration_ring_alloc(SUBGHZ_WORKER_RING_SIZE, SUBGHZ_WORKER_RING_WATERMARK);
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -97,7 +129,7 @@ SubGhzWorker* subghz_worker_alloc() {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_assert(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    level_duration_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
@@ -134,6 +166,7 @@ void subghz_worker_stop(SubGhzWorker* instance) {
     furi_assert(instance->running);
 
     instance->running = false;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), SubGhzWorkerFlagExit);
 
     furi_thread_join(instance->thread);
 }
@@ -146,4 +179,14 @@ bool subghz_worker_is_running(SubGhzWorker* instance) {
 void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout) {
     furi_assert(instance);
     instance->filter_duration = timeout;
-}
\ No newline at end of file
+}
+
+uint32_t subghz_worker_get_overrun_count(SubGhzWorker* instance) {
+    furi_assert(instance);
+    return level_duration_ring_get_overrun_count(instance->ring);
+}
+
+uint32_t subghz_worker_get_dropped_count(SubGhzWorker* instance) {
+    furi_assert(instance);
+    return level_duration_ring_get_dropped_count(instance->ring);
+}
@@ -75,6 +75,21 @@ bool subghz_worker_is_running(SubGhzWorker* instance);
  */
 void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout);
 
+/** 
+ * Get count of receive buffer overruns since allocation.
+ * Every overrun is one gap in the received stream, overrun callback is called for it.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @return overrun count
+ */
+uint32_t subghz_worker_get_overrun_count(SubGhzWorker* instance);
+
+/** 
+ * Get count of durations lost in overruns since allocation.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @return dropped duration count
+ */
+uint32_t subghz_worker_get_dropped_count(SubGhzWorker* instance);
+
 #ifdef __cplusplus
 }
 #endif
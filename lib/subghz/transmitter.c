@@ -12,11 +12,8 @@ struct SubGhzTransmitter {
 SubGhzTransmitter*
     subghz_transmitter_alloc_init(SubGhzEnvironment* environment, const char* protocol_name) {
     SubGhzTransmitter* instance = NULL;
-    const SubGhzProtocolRegistry* protocol_registry_items =
-        subghz_environment_get_protocol_registry(environment);
-
     const SubGhzProtocol* protocol =
-        subghz_protocol_registry_get_by_name(protocol_registry_items, protocol_name);
+        subghz_environment_get_protocol_by_name(environment, protocol_name);
 
     if(protocol && protocol->encoder && protocol->encoder->alloc) {
         instance = malloc(sizeof(SubGhzTransmitter));
@@ -1,9 +1,13 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
+#define DIR_WALK_NAME_LENGTH 256
+#define DIR_WALK_BATCH_SIZE 4
+
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
+    Storage* storage;
     File* file;
     FuriString* path;
     DirIndexList_t index_list;
@@ -11,15 +15,30 @@ struct DirWalk {
     bool recursive;
     DirWalkFilterCb filter_cb;
     void* filter_context;
+
+    // Directory entries read ahead in one storage round trip
+    StorageBatchOp batch[DIR_WALK_BATCH_SIZE];
+    FileInfo batch_info[DIR_WALK_BATCH_SIZE];
+    char* batch_names;
+    size_t batch_count;
+    size_t batch_pos;
+    FS_Error error;
+    uint32_t mtime;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
     DirWalk* dir_walk = malloc(sizeof(DirWalk));
+    dir_walk->storage = storage;
     dir_walk->path = furi_string_alloc();
     dir_walk->file = storage_file_alloc(storage);
     DirIndexList_init(dir_walk->index_list);
     dir_walk->recursive = true;
     dir_walk->filter_cb = NULL;
+    dir_walk->batch_names = malloc(DIR_WALK_BATCH_SIZE * DIR_WALK_NAME_LENGTH);
+    dir_walk->batch_count = 0;
+    dir_walk->batch_pos = 0;
+    dir_walk->error = FSE_OK;
+    dir_walk->mtime = 0;
     return dir_walk;
 }
 
@@ -27,6 +46,7 @@ void dir_walk_free(DirWalk* dir_walk) {
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
+    free(dir_walk->batch_names);
     free(dir_walk);
 }
 
@@ -39,10 +59,56 @@ void dir_walk_set_filter_cb(DirWalk* dir_walk, DirWalkFilterCb cb, void* context
     dir_walk->filter_context = context;
 }
 
+static bool dir_walk_dir_open(DirWalk* dir_walk) {
+    dir_walk->batch_count = 0;
+    dir_walk->batch_pos = 0;
+    bool result = storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+    dir_walk->error = storage_file_get_error(dir_walk->file);
+    return result;
+}
+
+static void dir_walk_dir_close(DirWalk* dir_walk) {
+    storage_dir_close(dir_walk->file);
+    dir_walk->batch_count = 0;
+    dir_walk->batch_pos = 0;
+}
+
+/** Reads next directory entry, refilling read-ahead buffer when it is exhausted */
+static FS_Error
+    dir_walk_dir_read(DirWalk* dir_walk, FileInfo** fileinfo, char** name, uint32_t* mtime) {
+    if(dir_walk->batch_pos == dir_walk->batch_count) {
+        for(size_t i = 0; i < DIR_WALK_BATCH_SIZE; i++) {
+            dir_walk->batch[i] = (StorageBatchOp){
+                .type = StorageBatchOpDirRead,
+                .file = dir_walk->file,
+                .fileinfo = &dir_walk->batch_info[i],
+                .buff = &dir_walk->batch_names[i * DIR_WALK_NAME_LENGTH],
+                .size = DIR_WALK_NAME_LENGTH - 1,
+            };
+        }
+
+        dir_walk->batch_count =
+            storage_batch_execute(dir_walk->storage, dir_walk->batch, DIR_WALK_BATCH_SIZE, true);
+        dir_walk->batch_pos = 0;
+    }
+
+    // Failed operation stays in place, so end of directory is reported on every next read
+    StorageBatchOp* op = &dir_walk->batch[dir_walk->batch_pos];
+    dir_walk->error = op->error;
+    if(op->error == FSE_OK) {
+        *fileinfo = op->fileinfo;
+        *name = op->buff;
+        *mtime = op->mtime;
+        dir_walk->batch_pos++;
+    }
+
+    return dir_walk->error;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    return dir_walk_dir_open(dir_walk);
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -56,18 +122,19 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(256); // FIXME: remove magic number
-    FileInfo info;
+    FileInfo* info;
+    char* name;
+    uint32_t mtime;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, 255);
+        FS_Error error = dir_walk_dir_read(dir_walk, &info, &name, &mtime);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(error == FSE_OK) {
             result = DirWalkOK;
             dir_walk->current_index++;
 
-            if(dir_walk_filter(dir_walk, name, &info)) {
+            if(dir_walk_filter(dir_walk, name, info)) {
                 if(return_path != NULL) {
                     furi_string_printf( //-V576
                         return_path,
@@ -77,22 +144,24 @@ static DirWalkResult
                 }
 
                 if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
+                    memcpy(fileinfo, info, sizeof(FileInfo));
                 }
 
+                dir_walk->mtime = mtime;
+
                 end = true;
             }
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
+            if(file_info_is_dir(info) && dir_walk->recursive) {
                 // step into
                 DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                 dir_walk->current_index = 0;
-                storage_dir_close(dir_walk->file);
-
                 furi_string_cat_printf(dir_walk->path, "/%s", name);
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+
+                dir_walk_dir_close(dir_walk);
+                dir_walk_dir_open(dir_walk);
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
+        } else if(error == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
                 // last
                 result = DirWalkLast;
@@ -103,14 +172,14 @@ static DirWalkResult
                 DirIndexList_pop_back(&index, dir_walk->index_list);
                 dir_walk->current_index = 0;
 
-                storage_dir_close(dir_walk->file);
+                dir_walk_dir_close(dir_walk);
 
                 size_t last_char = furi_string_search_rchar(dir_walk->path, '/');
                 if(last_char != FURI_STRING_FAILURE) {
                     furi_string_left(dir_walk->path, last_char);
                 }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk_dir_open(dir_walk);
 
                 // rewind
                 while(true) {
@@ -119,7 +188,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, 255)) {
+                    if(dir_walk_dir_read(dir_walk, &info, &name, &mtime) != FSE_OK) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -134,21 +203,24 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
 FS_Error dir_walk_get_error(DirWalk* dir_walk) {
-    return storage_file_get_error(dir_walk->file);
+    return dir_walk->error;
 }
 
 DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     return dir_walk_iter(dir_walk, return_path, fileinfo);
 }
 
+uint32_t dir_walk_get_mtime(DirWalk* dir_walk) {
+    return dir_walk->mtime;
+}
+
 void dir_walk_close(DirWalk* dir_walk) {
     if(storage_file_is_open(dir_walk->file)) {
-        storage_dir_close(dir_walk->file);
+        dir_walk_dir_close(dir_walk);
     }
 
     DirIndexList_reset(dir_walk->index_list);
@@ -68,6 +68,13 @@ FS_Error dir_walk_get_error(DirWalk* dir_walk);
  */
 DirWalkResult dir_walk_read(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo);
 
+/**
+ * Get modification time of the element returned by the last dir_walk_read
+ * @param dir_walk 
+ * @return uint32_t FAT date in high and time in low 16 bits, 0 if storage doesn't keep it
+ */
+uint32_t dir_walk_get_mtime(DirWalk* dir_walk);
+
 /**
  * Close directory
  * @param dir_walk 
@@ -0,0 +1,97 @@
+#include "level_duration_ring.h"
+
+#include <furi.h>
+
+struct LevelDurationRing {
+    LevelDuration* buffer;
+    uint32_t size;
+    uint32_t watermark;
+    /* Free running positions, wrapped with mask on access */
+    uint32_t head;
+    uint32_t tail;
+    /* Producer only: reset mark must go before next item */
+    bool overrun;
+    uint32_t overrun_count;
+    uint32_t dropped;
+};
+
+LevelDurationRing* level_duration_ring_alloc(size_t size, size_t watermark) {
+    furi_check(size >= 2);
+    furi_check((size & (size - 1)) == 0);
+    furi_check(watermark >= 1 && watermark <= size);
+
+    LevelDurationRing* ring = malloc(sizeof(LevelDurationRing));
+    ring->buffer = malloc(sizeof(LevelDuration) * size);
+    ring->size = size;
+    ring->watermark = watermark;
+    return ring;
+}
+
+void level_duration_ring_free(LevelDurationRing* ring) {
+    furi_assert(ring);
+    free(ring->buffer);
+    free(ring);
+}
+
+static inline void level_duration_ring_drop(LevelDurationRing* ring) {
+    __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+}
+
+bool level_duration_ring_push(LevelDurationRing* ring, LevelDuration level_duration) {
+    uint32_t head = ring->head;
+    uint32_t used = head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if(ring->overrun) {
+        // Reset mark goes in only together with the item, one mark per gap
+        if(ring->size - used < 2) {
+            level_duration_ring_drop(ring);
+            return false;
+        }
+        ring->buffer[head++ & (ring->size - 1)] = level_duration_reset();
+        used++;
+        ring->overrun = false;
+    }
+
+    bool wakeup;
+    if(used == ring->size) {
+        ring->overrun = true;
+        __atomic_store_n(&ring->overrun_count, ring->overrun_count + 1, __ATOMIC_RELAXED);
+        level_duration_ring_drop(ring);
+        wakeup = true;
+    } else {
+        ring->buffer[head++ & (ring->size - 1)] = level_duration;
+        wakeup = (used + 1 == ring->watermark);
+    }
+
+    __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    return wakeup;
+}
+
+size_t level_duration_ring_peek(LevelDurationRing* ring, const LevelDuration** block) {
+    furi_assert(ring);
+    furi_assert(block);
+
+    uint32_t tail = ring->tail;
+    uint32_t count = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+    uint32_t offset = tail & (ring->size - 1);
+
+    *block = &ring->buffer[offset];
+    return MIN(count, ring->size - offset);
+}
+
+void level_duration_ring_release(LevelDurationRing* ring, size_t count) {
+    furi_assert(ring);
+    furi_assert(count <= __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - ring->tail);
+
+    __atomic_store_n(&ring->tail, ring->tail + count, __ATOMIC_RELEASE);
+}
+
+uint32_t level_duration_ring_get_overrun_count(LevelDurationRing* ring) {
+    furi_assert(ring);
+    return __atomic_load_n(&ring->overrun_count, __ATOMIC_RELAXED);
+}
+
+uint32_t level_duration_ring_get_dropped_count(LevelDurationRing* ring) {
+    furi_assert(ring);
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
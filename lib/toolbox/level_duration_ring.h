@@ -0,0 +1,95 @@
+/**
+ * @file level_duration_ring.h
+ * Lock-free ring of LevelDuration
+ *
+ * Single producer, single consumer. Producer is an interrupt pushing one edge
+ * at a time, it never blocks and never takes a lock. Consumer takes pending
+ * edges as contiguous blocks, straight from the ring memory, and releases them
+ * when done.
+ *
+ * Producer asks for a wakeup only when fill reaches the watermark, consumer is
+ * expected to drain on its own on timeout too, so slow signals are not delayed.
+ *
+ * When the ring is full, edges are dropped and counted. First edge pushed after
+ * that is preceded by level_duration_reset(), so the consumer knows exactly where
+ * the gap is.
+ *
+ * ***NOTE***: only one producer and one consumer at a time.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "level_duration.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LevelDurationRing LevelDurationRing;
+
+/** Allocate ring
+ *
+ * @param      size       ring size in items, power of two
+ * @param      watermark  fill that wakes consumer, 1 to size
+ *
+ * @return     LevelDurationRing instance
+ */
+LevelDurationRing* level_duration_ring_alloc(size_t size, size_t watermark);
+
+/** Free ring, there must be no producer
+ *
+ * @param      ring  LevelDurationRing instance
+ */
+void level_duration_ring_free(LevelDurationRing* ring);
+
+/** Push item, producer side, safe from ISR
+ *
+ * @param      ring            LevelDurationRing instance
+ * @param      level_duration  item
+ *
+ * @return     true if consumer should be woken: fill reached watermark or ring
+ *             overran
+ */
+bool level_duration_ring_push(LevelDurationRing* ring, LevelDuration level_duration);
+
+/** Get pending items, consumer side
+ *
+ * Items are contiguous: if pending items wrap around the end of the ring, the
+ * rest comes on next call.
+ *
+ * @param      ring   LevelDurationRing instance
+ * @param      block  pointer to first item
+ *
+ * @return     item count, 0 if ring is empty
+ */
+size_t level_duration_ring_peek(LevelDurationRing* ring, const LevelDuration** block);
+
+/** Release items returned by level_duration_ring_peek, consumer side
+ *
+ * @param      ring   LevelDurationRing instance
+ * @param      count  item count, up to what peek returned
+ */
+void level_duration_ring_release(LevelDurationRing* ring, size_t count);
+
+/** Get count of times ring overran since allocation
+ *
+ * @param      ring  LevelDurationRing instance
+ *
+ * @return     overrun count, one per gap in the stream
+ */
+uint32_t level_duration_ring_get_overrun_count(LevelDurationRing* ring);
+
+/** Get count of items dropped since allocation
+ *
+ * @param      ring  LevelDurationRing instance
+ *
+ * @return     dropped items count
+ */
+uint32_t level_duration_ring_get_dropped_count(LevelDurationRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
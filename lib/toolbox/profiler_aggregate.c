@@ -0,0 +1,82 @@
+#include "profiler_aggregate.h"
+
+#include <stdlib.h>
+#include <core/check.h>
+
+static int profiler_aggregate_compare(const void* a, const void* b) {
+    uint32_t pc_a = *(const uint32_t*)a;
+    uint32_t pc_b = *(const uint32_t*)b;
+    return (pc_a > pc_b) - (pc_a < pc_b);
+}
+
+static size_t profiler_aggregate_insert(
+    ProfilerHotspot* hotspots,
+    size_t size,
+    size_t hotspots_max,
+    uint32_t pc,
+    uint32_t count) {
+    // Buckets come in address order, so equal counts keep it
+    if(size == hotspots_max && hotspots[size - 1].count >= count) return size;
+
+    size_t position = (size < hotspots_max) ? size++ : size - 1;
+    while(position > 0 && hotspots[position - 1].count < count) {
+        hotspots[position] = hotspots[position - 1];
+        position--;
+    }
+    hotspots[position].pc = pc;
+    hotspots[position].count = count;
+
+    return size;
+}
+
+size_t profiler_aggregate_hotspots(
+    const ProfilerSample* samples,
+    size_t count,
+    FuriThreadId thread_id,
+    uint32_t granularity,
+    ProfilerHotspot* hotspots,
+    size_t hotspots_max) {
+    furi_assert(samples || !count);
+    furi_assert(hotspots);
+    furi_check(granularity && !(granularity & (granularity - 1)));
+
+    if(!count || !hotspots_max) return 0;
+
+    uint32_t mask = ~(granularity - 1);
+    uint32_t* pcs = malloc(sizeof(uint32_t) * count);
+    size_t pcs_count = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(thread_id && samples[i].thread_id != thread_id) continue;
+        pcs[pcs_count++] = samples[i].pc & mask;
+    }
+
+    qsort(pcs, pcs_count, sizeof(uint32_t), profiler_aggregate_compare);
+
+    size_t size = 0;
+    size_t run_start = 0;
+    for(size_t i = 1; i <= pcs_count; i++) {
+        if(i == pcs_count || pcs[i] != pcs[run_start]) {
+            size = profiler_aggregate_insert(
+                hotspots, size, hotspots_max, pcs[run_start], i - run_start);
+            run_start = i;
+        }
+    }
+
+    free(pcs);
+    return size;
+}
+
+size_t profiler_aggregate_count(
+    const ProfilerSample* samples,
+    size_t count,
+    FuriThreadId thread_id) {
+    furi_assert(samples || !count);
+
+    if(!thread_id) return count;
+
+    size_t result = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(samples[i].thread_id == thread_id) result++;
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file profiler_aggregate.h
+ * PC sample aggregation
+ *
+ * Hardware independent, so it works on host too.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <core/thread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Single sample of interrupted thread */
+typedef struct {
+    uint32_t pc;
+    FuriThreadId thread_id;
+} ProfilerSample;
+
+/** Address bucket and amount of samples that fell into it */
+typedef struct {
+    uint32_t pc;
+    uint32_t count;
+} ProfilerHotspot;
+
+/** Find most sampled addresses
+ *
+ * @param      samples       samples array
+ * @param      count         samples count
+ * @param      thread_id     count only this thread samples, NULL for all
+ * @param      granularity   bucket size in bytes, power of 2. Use 1 for exact
+ *                           PCs and i.e. 64 to merge samples of small function.
+ * @param      hotspots      output array
+ * @param      hotspots_max  output array size
+ *
+ * @return     hotspots written, ordered by count, then by address
+ */
+size_t profiler_aggregate_hotspots(
+    const ProfilerSample* samples,
+    size_t count,
+    FuriThreadId thread_id,
+    uint32_t granularity,
+    ProfilerHotspot* hotspots,
+    size_t hotspots_max);
+
+/** Count samples of thread
+ *
+ * @param      samples    samples array
+ * @param      count      samples count
+ * @param      thread_id  thread to count, NULL for all
+ *
+ * @return     amount of samples of thread
+ */
+size_t profiler_aggregate_count(
+    const ProfilerSample* samples,
+    size_t count,
+    FuriThreadId thread_id);
+
+#ifdef __cplusplus
+}
+#endif
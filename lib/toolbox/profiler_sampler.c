@@ -0,0 +1,88 @@
+#include "profiler_sampler.h"
+
+#include <furi.h>
+#include <furi_hal_os.h>
+
+struct ProfilerSampler {
+    ProfilerSample* buffer;
+    size_t capacity;
+    volatile size_t write;
+    volatile size_t read;
+    volatile uint32_t dropped;
+    bool running;
+};
+
+static void profiler_sampler_tick_callback(uint32_t pc, void* thread_id, void* context) {
+    ProfilerSampler* sampler = context;
+
+    // Reader only moves `read` with interrupts disabled, no need to lock here
+    if(sampler->write - sampler->read >= sampler->capacity) {
+        sampler->dropped++;
+        return;
+    }
+
+    ProfilerSample* sample = &sampler->buffer[sampler->write % sampler->capacity];
+    sample->pc = pc;
+    sample->thread_id = thread_id;
+    sampler->write++;
+}
+
+ProfilerSampler* profiler_sampler_alloc(size_t capacity) {
+    furi_check(capacity);
+
+    ProfilerSampler* sampler = malloc(sizeof(ProfilerSampler));
+    sampler->buffer = malloc(sizeof(ProfilerSample) * capacity);
+    sampler->capacity = capacity;
+    return sampler;
+}
+
+void profiler_sampler_free(ProfilerSampler* sampler) {
+    furi_assert(sampler);
+    furi_check(!sampler->running);
+
+    free(sampler->buffer);
+    free(sampler);
+}
+
+void profiler_sampler_start(ProfilerSampler* sampler, uint32_t period) {
+    furi_assert(sampler);
+    furi_check(!sampler->running);
+
+    sampler->write = 0;
+    sampler->read = 0;
+    sampler->dropped = 0;
+    sampler->running = true;
+    furi_hal_os_set_tick_sample_callback(profiler_sampler_tick_callback, period, sampler);
+}
+
+void profiler_sampler_stop(ProfilerSampler* sampler) {
+    furi_assert(sampler);
+    furi_check(sampler->running);
+
+    furi_hal_os_set_tick_sample_callback(NULL, 1, NULL);
+    sampler->running = false;
+}
+
+size_t profiler_sampler_read(
+    ProfilerSampler* sampler,
+    ProfilerSample* samples,
+    size_t samples_max) {
+    furi_assert(sampler);
+    furi_assert(samples);
+
+    size_t count = 0;
+
+    FURI_CRITICAL_ENTER();
+    while(count < samples_max && sampler->read != sampler->write) {
+        samples[count++] = sampler->buffer[sampler->read % sampler->capacity];
+        sampler->read++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return count;
+}
+
+uint32_t profiler_sampler_get_dropped(ProfilerSampler* sampler) {
+    furi_assert(sampler);
+    return sampler->dropped;
+}
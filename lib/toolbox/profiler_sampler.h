@@ -0,0 +1,67 @@
+/**
+ * @file profiler_sampler.h
+ * Statistical profiler: PC of running thread is sampled from OS tick into
+ * fixed buffer. Reader drains buffer and aggregates samples or stores them
+ * for offline symbolization against firmware elf.
+ */
+#pragma once
+
+#include "profiler_aggregate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ProfilerSampler ProfilerSampler;
+
+/** Allocate sampler
+ *
+ * @param      capacity  samples buffer size, samples are dropped when full
+ *
+ * @return     ProfilerSampler instance
+ */
+ProfilerSampler* profiler_sampler_alloc(size_t capacity);
+
+/** Free sampler, must be stopped
+ *
+ * @param      sampler  ProfilerSampler instance
+ */
+void profiler_sampler_free(ProfilerSampler* sampler);
+
+/** Start sampling, only one sampler can run at a time
+ *
+ * @param      sampler  ProfilerSampler instance
+ * @param      period   sampling period in OS ticks
+ */
+void profiler_sampler_start(ProfilerSampler* sampler, uint32_t period);
+
+/** Stop sampling
+ *
+ * @param      sampler  ProfilerSampler instance
+ */
+void profiler_sampler_stop(ProfilerSampler* sampler);
+
+/** Move collected samples out of sampler, oldest first
+ *
+ * @param      sampler      ProfilerSampler instance
+ * @param      samples      output array
+ * @param      samples_max  output array size
+ *
+ * @return     samples written
+ */
+size_t profiler_sampler_read(
+    ProfilerSampler* sampler,
+    ProfilerSample* samples,
+    size_t samples_max);
+
+/** Get amount of samples dropped because buffer was full
+ *
+ * @param      sampler  ProfilerSampler instance
+ *
+ * @return     dropped samples since start
+ */
+uint32_t profiler_sampler_get_dropped(ProfilerSampler* sampler);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,5 @@
 #include "tar_archive.h"
+#include "tar_archive_hs.h"
 
 #include <microtar.h>
 #include <storage/storage.h>
@@ -15,6 +16,7 @@
 typedef struct TarArchive {
     Storage* storage;
     mtar_t tar;
+    TarHsStream* hs;
     tar_unpack_file_cb unpack_cb;
     void* unpack_cb_context;
 } TarArchive;
@@ -71,6 +73,7 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         open_mode = FSOM_OPEN_EXISTING;
         break;
     case TAR_OPEN_MODE_WRITE:
+    case TAR_OPEN_MODE_WRITE_HEATSHRINK:
         mtar_access = MTAR_WRITE;
         access_mode = FSAM_WRITE;
         open_mode = FSOM_CREATE_ALWAYS;
@@ -84,14 +87,45 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         storage_file_free(stream);
         return false;
     }
-    mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
+
+    archive->hs = NULL;
+    bool compressed = false;
+    if(mode == TAR_OPEN_MODE_WRITE_HEATSHRINK) {
+        compressed = true;
+        archive->hs = tar_hs_stream_alloc_writer(stream);
+    } else if(mode == TAR_OPEN_MODE_READ && tar_hs_stream_detect(stream)) {
+        compressed = true;
+        archive->hs = tar_hs_stream_alloc_reader(stream);
+    }
+
+    if(compressed) {
+        if(!archive->hs) {
+            storage_file_free(stream);
+            return false;
+        }
+        mtar_init(&archive->tar, mtar_access, &tar_hs_ops, archive->hs);
+    } else {
+        mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
+    }
 
     return true;
 }
 
+TarOpenMode tar_archive_get_write_mode_for_path(const char* path) {
+    furi_assert(path);
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(TAR_HEATSHRINK_EXTENSION);
+    if((path_len > ext_len) &&
+       (strcmp(&path[path_len - ext_len], TAR_HEATSHRINK_EXTENSION) == 0)) {
+        return TAR_OPEN_MODE_WRITE_HEATSHRINK;
+    }
+    return TAR_OPEN_MODE_WRITE;
+}
+
 void tar_archive_free(TarArchive* archive) {
     furi_assert(archive);
     if(mtar_is_open(&archive->tar)) {
+        // Closes compressed stream as well
         mtar_close(&archive->tar);
     }
     free(archive);
@@ -113,6 +147,10 @@ static int tar_archive_entry_counter(mtar_t* tar, const mtar_header_t* header, v
 }
 
 int32_t tar_archive_get_entries_count(TarArchive* archive) {
+    if(archive->hs) {
+        return tar_hs_stream_get_entries_count(archive->hs);
+    }
+
     int32_t counter = 0;
     if(mtar_foreach(&archive->tar, tar_archive_entry_counter, &counter) != MTAR_ESUCCESS) {
         counter = -1;
@@ -122,12 +160,16 @@ int32_t tar_archive_get_entries_count(TarArchive* archive) {
 
 bool tar_archive_dir_add_element(TarArchive* archive, const char* dirpath) {
     furi_assert(archive);
+    if(archive->hs) {
+        tar_hs_stream_add_entry(archive->hs, dirpath, 0, MTAR_TDIR);
+    }
     return (mtar_write_dir_header(&archive->tar, dirpath) == MTAR_ESUCCESS);
 }
 
 bool tar_archive_finalize(TarArchive* archive) {
     furi_assert(archive);
-    return (mtar_finalize(&archive->tar) == MTAR_ESUCCESS);
+    return (mtar_finalize(&archive->tar) == MTAR_ESUCCESS) &&
+           (!archive->hs || tar_hs_stream_finish(archive->hs));
 }
 
 bool tar_archive_store_data(
@@ -145,6 +187,9 @@ bool tar_archive_store_data(
 
 bool tar_archive_file_add_header(TarArchive* archive, const char* path, const int32_t data_len) {
     furi_assert(archive);
+    if(archive->hs) {
+        tar_hs_stream_add_entry(archive->hs, path, data_len, MTAR_TREG);
+    }
 
     return (mtar_write_file_header(&archive->tar, path, data_len) == MTAR_ESUCCESS);
 }
@@ -169,24 +214,28 @@ typedef struct {
     Storage_name_converter converter;
 } TarArchiveDirectoryOpParams;
 
+static bool archive_open_extracted_file(File* out_file, const char* dst_path) {
+    uint8_t n_tries = FILE_OPEN_NTRIES;
+    while(n_tries-- > 0) {
+        if(storage_file_open(out_file, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            break;
+        }
+        FURI_LOG_W(TAG, "Failed to open '%s', reties: %d", dst_path, n_tries);
+        storage_file_close(out_file);
+        furi_delay_ms(FILE_OPEN_RETRY_DELAY);
+    }
+
+    return storage_file_is_open(out_file);
+}
+
 static bool archive_extract_current_file(TarArchive* archive, const char* dst_path) {
     mtar_t* tar = &archive->tar;
     File* out_file = storage_file_alloc(archive->storage);
     uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
 
     bool success = true;
-    uint8_t n_tries = FILE_OPEN_NTRIES;
     do {
-        while(n_tries-- > 0) {
-            if(storage_file_open(out_file, dst_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
-                break;
-            }
-            FURI_LOG_W(TAG, "Failed to open '%s', reties: %d", dst_path, n_tries);
-            storage_file_close(out_file);
-            furi_delay_ms(FILE_OPEN_RETRY_DELAY);
-        }
-
-        if(!storage_file_is_open(out_file)) {
+        if(!archive_open_extracted_file(out_file, dst_path)) {
             success = false;
             break;
         }
@@ -205,6 +254,26 @@ static bool archive_extract_current_file(TarArchive* archive, const char* dst_pa
     return success;
 }
 
+static bool archive_extract_compressed_file(
+    TarArchive* archive,
+    uint32_t data_size,
+    const char* dst_path) {
+    File* out_file = storage_file_alloc(archive->storage);
+    uint8_t* readbuf = malloc(FILE_BLOCK_SIZE);
+
+    bool success = archive_open_extracted_file(out_file, dst_path);
+    while(success && data_size) {
+        size_t readcnt = tar_hs_stream_read(archive->hs, readbuf, MIN(data_size, FILE_BLOCK_SIZE));
+        success = readcnt && (storage_file_write(out_file, readbuf, readcnt) == readcnt);
+        data_size -= readcnt;
+    }
+
+    storage_file_free(out_file);
+    free(readbuf);
+
+    return success;
+}
+
 static int archive_extract_foreach_cb(mtar_t* tar, const mtar_header_t* header, void* param) {
     UNUSED(tar);
     TarArchiveDirectoryOpParams* op_params = param;
@@ -379,6 +448,13 @@ bool tar_archive_unpack_file(
     furi_assert(archive);
     furi_assert(archive_fname);
     furi_assert(destination);
+    if(archive->hs) {
+        // Entry is located by archive index, only blocks holding its data are unpacked
+        uint32_t data_size = 0;
+        return tar_hs_stream_find(archive->hs, archive_fname, &data_size) &&
+               archive_extract_compressed_file(archive, data_size, destination);
+    }
+
     if(mtar_find(&archive->tar, archive_fname) != MTAR_ESUCCESS) {
         return false;
     }
@@ -8,13 +8,16 @@
 extern "C" {
 #endif
 
+#define TAR_HEATSHRINK_EXTENSION ".tar.hs"
+
 typedef struct TarArchive TarArchive;
 
 typedef struct Storage Storage;
 
 typedef enum {
-    TAR_OPEN_MODE_READ = 'r',
+    TAR_OPEN_MODE_READ = 'r', /* plain or heatshrink compressed, detected automatically */
     TAR_OPEN_MODE_WRITE = 'w',
+    TAR_OPEN_MODE_WRITE_HEATSHRINK = 'h', /* compressed on a separate thread, indexed */
     TAR_OPEN_MODE_STDOUT = 's' /* to be implemented */
 } TarOpenMode;
 
@@ -22,6 +25,9 @@ TarArchive* tar_archive_alloc(Storage* storage);
 
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode);
 
+/* Compressed write mode for paths ending with TAR_HEATSHRINK_EXTENSION, plain otherwise */
+TarOpenMode tar_archive_get_write_mode_for_path(const char* path);
+
 void tar_archive_free(TarArchive* archive);
 
 /* High-level API  - assumes archive is open */
@@ -0,0 +1,507 @@
+#include "tar_archive_hs.h"
+
+#include <furi.h>
+#include <toolbox/compress.h>
+
+#define TAG "TarHs"
+
+#define TAR_HS_MAGIC (0x53485254) /* "TRHS" */
+#define TAR_HS_VERSION (1)
+
+#define TAR_HS_BLOCK_SIZE (4096)
+/* Heatshrink expands incompressible data by 1/8 in the worst case */
+#define TAR_HS_PACKED_SIZE (TAR_HS_BLOCK_SIZE + TAR_HS_BLOCK_SIZE / 4)
+/* One block is being filled while another one is compressed */
+#define TAR_HS_BUFFERS_COUNT (2)
+#define TAR_HS_ENTRIES_MIN_CAPACITY (512)
+#define TAR_HS_BLOCKS_MIN_CAPACITY (64)
+
+#define TAR_HS_WORKER_STACK_SIZE (1024)
+
+/* Size of tar entry header record */
+#define TAR_HS_RECORD_SIZE (512)
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t block_size;
+} __attribute__((packed)) TarHsHeader;
+
+typedef struct {
+    uint16_t packed_size;
+    uint16_t raw_size;
+} __attribute__((packed)) TarHsBlockHeader;
+
+typedef struct {
+    uint32_t offset; /* Entry header offset in tar stream */
+    uint32_t size;
+    uint8_t type;
+    uint8_t name_size;
+} __attribute__((packed)) TarHsEntry;
+
+typedef struct {
+    uint32_t blocks_offset;
+    uint32_t blocks_count;
+    uint32_t entries_offset;
+    uint32_t entries_count;
+    uint32_t magic;
+} __attribute__((packed)) TarHsFooter;
+
+typedef struct {
+    uint8_t data[TAR_HS_BLOCK_SIZE];
+    uint16_t size;
+} TarHsBuffer;
+
+struct TarHsStream {
+    File* file;
+    Compress* compress;
+    uint8_t* packed;
+    uint32_t pos; /* Position in uncompressed tar stream */
+
+    uint32_t* blocks; /* Block offsets in file */
+    uint32_t blocks_count;
+    uint32_t entries_count;
+
+    /* Reader */
+    uint8_t* block_data;
+    uint32_t block_index;
+    uint16_t block_size;
+    uint32_t entries_offset;
+
+    /* Writer */
+    FuriThread* thread;
+    FuriMessageQueue* free_queue;
+    FuriMessageQueue* full_queue;
+    TarHsBuffer* buffers;
+    TarHsBuffer* buffer;
+    uint32_t blocks_capacity;
+    uint8_t* entries;
+    size_t entries_size;
+    size_t entries_capacity;
+    volatile bool failed;
+};
+
+/* Writer */
+
+static bool tar_hs_stream_write_block(TarHsStream* stream, TarHsBuffer* buffer) {
+    size_t packed_size = 0;
+    if(!compress_encode(
+           stream->compress,
+           buffer->data,
+           buffer->size,
+           stream->packed,
+           TAR_HS_PACKED_SIZE,
+           &packed_size)) {
+        return false;
+    }
+
+    if(stream->blocks_count == stream->blocks_capacity) {
+        stream->blocks_capacity = MAX(stream->blocks_capacity * 2, TAR_HS_BLOCKS_MIN_CAPACITY);
+        stream->blocks = realloc(stream->blocks, stream->blocks_capacity * sizeof(uint32_t));
+    }
+    stream->blocks[stream->blocks_count++] = storage_file_tell(stream->file);
+
+    TarHsBlockHeader header = {
+        .packed_size = packed_size,
+        .raw_size = buffer->size,
+    };
+    return (storage_file_write(stream->file, &header, sizeof(header)) == sizeof(header)) &&
+           (storage_file_write(stream->file, stream->packed, packed_size) == packed_size);
+}
+
+static int32_t tar_hs_stream_worker(void* context) {
+    TarHsStream* stream = context;
+    TarHsBuffer* buffer = NULL;
+
+    while(true) {
+        furi_check(
+            furi_message_queue_get(stream->full_queue, &buffer, FuriWaitForever) ==
+            FuriStatusOk);
+        if(!buffer) break;
+
+        // Keep draining after failure, so writer never blocks on free buffers
+        if(!stream->failed && !tar_hs_stream_write_block(stream, buffer)) {
+            FURI_LOG_E(TAG, "Block %lu write failed", stream->blocks_count);
+            stream->failed = true;
+        }
+
+        furi_check(
+            furi_message_queue_put(stream->free_queue, &buffer, FuriWaitForever) ==
+            FuriStatusOk);
+    }
+
+    return 0;
+}
+
+static void tar_hs_stream_submit(TarHsStream* stream) {
+    furi_check(
+        furi_message_queue_put(stream->full_queue, &stream->buffer, FuriWaitForever) ==
+        FuriStatusOk);
+    furi_check(
+        furi_message_queue_get(stream->free_queue, &stream->buffer, FuriWaitForever) ==
+        FuriStatusOk);
+    stream->buffer->size = 0;
+}
+
+static void tar_hs_stream_stop_worker(TarHsStream* stream) {
+    TarHsBuffer* stop = NULL;
+    furi_check(
+        furi_message_queue_put(stream->full_queue, &stop, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(stream->thread);
+    furi_thread_free(stream->thread);
+    stream->thread = NULL;
+}
+
+TarHsStream* tar_hs_stream_alloc_writer(File* file) {
+    furi_assert(file);
+
+    TarHsHeader header = {
+        .magic = TAR_HS_MAGIC,
+        .version = TAR_HS_VERSION,
+        .block_size = TAR_HS_BLOCK_SIZE,
+    };
+    if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) {
+        return NULL;
+    }
+
+    TarHsStream* stream = malloc(sizeof(TarHsStream));
+    stream->file = file;
+    stream->compress = compress_alloc(TAR_HS_BLOCK_SIZE);
+    stream->packed = malloc(TAR_HS_PACKED_SIZE);
+
+    stream->buffers = malloc(sizeof(TarHsBuffer) * TAR_HS_BUFFERS_COUNT);
+    stream->free_queue = furi_message_queue_alloc(TAR_HS_BUFFERS_COUNT, sizeof(TarHsBuffer*));
+    // Extra slot for stop request
+    stream->full_queue =
+        furi_message_queue_alloc(TAR_HS_BUFFERS_COUNT + 1, sizeof(TarHsBuffer*));
+    stream->buffer = &stream->buffers[0];
+    for(size_t i = 1; i < TAR_HS_BUFFERS_COUNT; i++) {
+        TarHsBuffer* buffer = &stream->buffers[i];
+        furi_check(furi_message_queue_put(stream->free_queue, &buffer, 0) == FuriStatusOk);
+    }
+
+    stream->entries_capacity = TAR_HS_ENTRIES_MIN_CAPACITY;
+    stream->entries = malloc(stream->entries_capacity);
+
+    stream->thread = furi_thread_alloc_ex(
+        "TarHsWorker", TAR_HS_WORKER_STACK_SIZE, tar_hs_stream_worker, stream);
+    furi_thread_start(stream->thread);
+
+    return stream;
+}
+
+void tar_hs_stream_add_entry(TarHsStream* stream, const char* name, uint32_t size, char type) {
+    furi_assert(stream);
+    furi_assert(stream->thread);
+    furi_assert(name);
+
+    TarHsEntry entry = {
+        .offset = stream->pos,
+        .size = size,
+        .type = type,
+        .name_size = MIN(strlen(name), UINT8_MAX),
+    };
+
+    size_t entry_size = sizeof(entry) + entry.name_size;
+    if(stream->entries_size + entry_size > stream->entries_capacity) {
+        stream->entries_capacity =
+            MAX(stream->entries_capacity * 2, stream->entries_size + entry_size);
+        stream->entries = realloc(stream->entries, stream->entries_capacity);
+    }
+
+    memcpy(&stream->entries[stream->entries_size], &entry, sizeof(entry));
+    memcpy(&stream->entries[stream->entries_size + sizeof(entry)], name, entry.name_size);
+    stream->entries_size += entry_size;
+    stream->entries_count++;
+}
+
+static int tar_hs_stream_ops_write(void* context, const void* data, unsigned size) {
+    TarHsStream* stream = context;
+    furi_assert(stream->thread);
+
+    const uint8_t* src = data;
+    unsigned left = size;
+    while(left) {
+        if(stream->failed) {
+            return MTAR_EWRITEFAIL;
+        }
+
+        TarHsBuffer* buffer = stream->buffer;
+        size_t chunk = MIN(left, TAR_HS_BLOCK_SIZE - buffer->size);
+        memcpy(&buffer->data[buffer->size], src, chunk);
+        buffer->size += chunk;
+        src += chunk;
+        left -= chunk;
+
+        // Full block goes to compression thread, next one is filled meanwhile
+        if(buffer->size == TAR_HS_BLOCK_SIZE) {
+            tar_hs_stream_submit(stream);
+        }
+    }
+
+    stream->pos += size;
+    return size;
+}
+
+bool tar_hs_stream_finish(TarHsStream* stream) {
+    furi_assert(stream);
+    furi_assert(stream->thread);
+
+    if(stream->buffer->size) {
+        tar_hs_stream_submit(stream);
+    }
+    tar_hs_stream_stop_worker(stream);
+
+    File* file = stream->file;
+    TarHsFooter footer = {
+        .blocks_count = stream->blocks_count,
+        .entries_count = stream->entries_count,
+        .magic = TAR_HS_MAGIC,
+    };
+    size_t blocks_size = stream->blocks_count * sizeof(uint32_t);
+
+    bool success = false;
+    do {
+        if(stream->failed) break;
+
+        footer.blocks_offset = storage_file_tell(file);
+        if(storage_file_write(file, stream->blocks, blocks_size) != blocks_size) break;
+
+        footer.entries_offset = storage_file_tell(file);
+        if(storage_file_write(file, stream->entries, stream->entries_size) !=
+           stream->entries_size)
+            break;
+
+        if(storage_file_write(file, &footer, sizeof(footer)) != sizeof(footer)) break;
+
+        FURI_LOG_I(
+            TAG,
+            "%lu bytes packed to %lu, %lu entries",
+            stream->pos,
+            (uint32_t)storage_file_tell(file),
+            stream->entries_count);
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+/* Reader */
+
+bool tar_hs_stream_detect(File* file) {
+    furi_assert(file);
+
+    TarHsHeader header;
+    bool detected = (storage_file_read(file, &header, sizeof(header)) == sizeof(header)) &&
+                    (header.magic == TAR_HS_MAGIC);
+    storage_file_seek(file, 0, true);
+
+    return detected;
+}
+
+TarHsStream* tar_hs_stream_alloc_reader(File* file) {
+    furi_assert(file);
+
+    TarHsHeader header;
+    TarHsFooter footer;
+    uint64_t file_size = storage_file_size(file);
+    uint32_t* blocks = NULL;
+
+    bool success = false;
+    do {
+        if(file_size < sizeof(header) + sizeof(footer)) break;
+        if(!storage_file_seek(file, 0, true)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if((header.magic != TAR_HS_MAGIC) || (header.version != TAR_HS_VERSION) ||
+           (header.block_size != TAR_HS_BLOCK_SIZE))
+            break;
+
+        if(!storage_file_seek(file, file_size - sizeof(footer), true)) break;
+        if(storage_file_read(file, &footer, sizeof(footer)) != sizeof(footer)) break;
+        if((footer.magic != TAR_HS_MAGIC) || (footer.blocks_count == 0) ||
+           (footer.entries_offset > file_size - sizeof(footer)) ||
+           (footer.blocks_offset > footer.entries_offset) ||
+           (footer.blocks_count > (footer.entries_offset - footer.blocks_offset) / 4))
+            break;
+
+        size_t blocks_size = footer.blocks_count * sizeof(uint32_t);
+        blocks = malloc(blocks_size);
+        if(!storage_file_seek(file, footer.blocks_offset, true)) break;
+        if(storage_file_read(file, blocks, blocks_size) != blocks_size) break;
+
+        success = true;
+    } while(false);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Damaged archive");
+        free(blocks);
+        return NULL;
+    }
+
+    TarHsStream* stream = malloc(sizeof(TarHsStream));
+    stream->file = file;
+    stream->compress = compress_alloc(TAR_HS_BLOCK_SIZE);
+    stream->packed = malloc(TAR_HS_PACKED_SIZE);
+    // compress_decode copies one extra byte of uncompressed blocks
+    stream->block_data = malloc(TAR_HS_BLOCK_SIZE + 1);
+    stream->block_index = UINT32_MAX;
+    stream->blocks = blocks;
+    stream->blocks_count = footer.blocks_count;
+    stream->entries_count = footer.entries_count;
+    stream->entries_offset = footer.entries_offset;
+
+    return stream;
+}
+
+static bool tar_hs_stream_load_block(TarHsStream* stream, uint32_t index) {
+    if(index == stream->block_index) {
+        return true;
+    }
+
+    stream->block_index = UINT32_MAX;
+    stream->block_size = 0;
+    if(index >= stream->blocks_count) {
+        return false;
+    }
+
+    File* file = stream->file;
+    TarHsBlockHeader header;
+    size_t raw_size = 0;
+
+    bool success = false;
+    do {
+        if(!storage_file_seek(file, stream->blocks[index], true)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if((header.packed_size == 0) || (header.packed_size > TAR_HS_PACKED_SIZE) ||
+           (header.raw_size > TAR_HS_BLOCK_SIZE))
+            break;
+        if(storage_file_read(file, stream->packed, header.packed_size) != header.packed_size)
+            break;
+        if(!compress_decode(
+               stream->compress,
+               stream->packed,
+               header.packed_size,
+               stream->block_data,
+               TAR_HS_BLOCK_SIZE,
+               &raw_size))
+            break;
+        if(raw_size != header.raw_size) break;
+
+        stream->block_index = index;
+        stream->block_size = raw_size;
+        success = true;
+    } while(false);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Block %lu is damaged", index);
+    }
+
+    return success;
+}
+
+size_t tar_hs_stream_read(TarHsStream* stream, void* data, size_t size) {
+    furi_assert(stream);
+    furi_assert(stream->block_data);
+
+    uint8_t* dst = data;
+    size_t done = 0;
+    while(done < size) {
+        uint32_t index = stream->pos / TAR_HS_BLOCK_SIZE;
+        uint32_t offset = stream->pos % TAR_HS_BLOCK_SIZE;
+        if(!tar_hs_stream_load_block(stream, index) || (offset >= stream->block_size)) {
+            break;
+        }
+
+        size_t chunk = MIN(size - done, (size_t)(stream->block_size - offset));
+        memcpy(&dst[done], &stream->block_data[offset], chunk);
+        done += chunk;
+        stream->pos += chunk;
+    }
+
+    return done;
+}
+
+int32_t tar_hs_stream_get_entries_count(TarHsStream* stream) {
+    furi_assert(stream);
+    return stream->entries_count;
+}
+
+bool tar_hs_stream_find(TarHsStream* stream, const char* name, uint32_t* size) {
+    furi_assert(stream);
+    furi_assert(stream->block_data);
+    furi_assert(name);
+    furi_assert(size);
+
+    File* file = stream->file;
+    size_t name_size = strlen(name);
+    char* entry_name = malloc(UINT8_MAX);
+    TarHsEntry entry;
+
+    bool found = false;
+    if(storage_file_seek(file, stream->entries_offset, true)) {
+        for(uint32_t i = 0; i < stream->entries_count; i++) {
+            if(storage_file_read(file, &entry, sizeof(entry)) != sizeof(entry)) break;
+            if(storage_file_read(file, entry_name, entry.name_size) != entry.name_size) break;
+
+            if((entry.type == MTAR_TREG) && (entry.name_size == name_size) &&
+               (memcmp(entry_name, name, name_size) == 0)) {
+                stream->pos = entry.offset + TAR_HS_RECORD_SIZE;
+                *size = entry.size;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    free(entry_name);
+    return found;
+}
+
+/* microtar glue */
+
+static int tar_hs_stream_ops_read(void* context, void* data, unsigned size) {
+    return (tar_hs_stream_read(context, data, size) == size) ? (int)size : MTAR_EREADFAIL;
+}
+
+static int tar_hs_stream_ops_seek(void* context, unsigned offset) {
+    TarHsStream* stream = context;
+    // Blocks are located on read, seeking over file data costs nothing
+    stream->pos = offset;
+    return MTAR_ESUCCESS;
+}
+
+static int tar_hs_stream_ops_close(void* context) {
+    TarHsStream* stream = context;
+    if(!stream) {
+        return MTAR_ESUCCESS;
+    }
+
+    if(stream->thread) {
+        tar_hs_stream_stop_worker(stream);
+    }
+    if(stream->buffers) {
+        furi_message_queue_free(stream->free_queue);
+        furi_message_queue_free(stream->full_queue);
+        free(stream->buffers);
+    }
+
+    compress_free(stream->compress);
+    free(stream->packed);
+    free(stream->block_data);
+    free(stream->blocks);
+    free(stream->entries);
+
+    storage_file_close(stream->file);
+    storage_file_free(stream->file);
+    free(stream);
+
+    return MTAR_ESUCCESS;
+}
+
+const struct mtar_ops tar_hs_ops = {
+    .read = tar_hs_stream_ops_read,
+    .write = tar_hs_stream_ops_write,
+    .seek = tar_hs_stream_ops_seek,
+    .close = tar_hs_stream_ops_close,
+};
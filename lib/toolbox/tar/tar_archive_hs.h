@@ -0,0 +1,91 @@
+/**
+ * @file tar_archive_hs.h
+ * Heatshrink compressed tar stream, private to tar_archive
+ *
+ * Tar stream is split into fixed size blocks, every block is compressed independently.
+ * Archive ends with an index of block offsets and archive entries, so any entry can be
+ * extracted by decompressing only the blocks it occupies.
+ */
+#pragma once
+
+#include <microtar.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct TarHsStream TarHsStream;
+
+/** Stream operations for microtar, stream argument is TarHsStream */
+extern const struct mtar_ops tar_hs_ops;
+
+/** Check if opened file is a compressed tar stream
+ * File is rewound to the beginning.
+ *
+ * @param file opened file
+ * @return true if file starts with compressed stream header
+ */
+bool tar_hs_stream_detect(File* file);
+
+/** Allocate compressed stream reader
+ * Loads archive index, takes ownership of the file on success.
+ *
+ * @param file file opened for reading
+ * @return TarHsStream instance or NULL if archive is damaged
+ */
+TarHsStream* tar_hs_stream_alloc_reader(File* file);
+
+/** Allocate compressed stream writer
+ * Starts compression thread, takes ownership of the file.
+ *
+ * @param file file opened for writing
+ * @return TarHsStream instance
+ */
+TarHsStream* tar_hs_stream_alloc_writer(File* file);
+
+/** Register archive entry in the index
+ * Must be called before entry header is written to the stream.
+ *
+ * @param stream TarHsStream writer
+ * @param name entry name
+ * @param size entry data size
+ * @param type entry type, MTAR_TREG or MTAR_TDIR
+ */
+void tar_hs_stream_add_entry(TarHsStream* stream, const char* name, uint32_t size, char type);
+
+/** Flush compressed blocks and write archive index
+ *
+ * @param stream TarHsStream writer
+ * @return true on success
+ */
+bool tar_hs_stream_finish(TarHsStream* stream);
+
+/** Get number of archive entries from index
+ *
+ * @param stream TarHsStream reader
+ * @return entries count
+ */
+int32_t tar_hs_stream_get_entries_count(TarHsStream* stream);
+
+/** Find regular file in archive index and seek to its data
+ *
+ * @param stream TarHsStream reader
+ * @param name entry name
+ * @param size entry data size
+ * @return true if entry was found
+ */
+bool tar_hs_stream_find(TarHsStream* stream, const char* name, uint32_t* size);
+
+/** Read decompressed data from current position
+ *
+ * @param stream TarHsStream reader
+ * @param data output buffer
+ * @param size bytes to read
+ * @return bytes read, less than size on end of stream or error
+ */
+size_t tar_hs_stream_read(TarHsStream* stream, void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
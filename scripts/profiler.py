@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+import struct
+import subprocess
+from collections import Counter, defaultdict
+
+from flipper.app import App
+
+# Layout must match cli_command_top.c
+HEADER_FORMAT = "<IHHIIII"
+SAMPLE_FORMAT = "<II"
+THREAD_FORMAT = "<I16s"
+FILE_MAGIC = 0x53505A46
+FILE_VERSION = 1
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("samples", help="Samples file from `top record`")
+        self.parser.add_argument(
+            "elf", help="Firmware elf, i.e. build/latest/firmware.elf"
+        )
+        self.parser.add_argument(
+            "-n", "--count", type=int, default=30, help="Functions to show"
+        )
+        self.parser.add_argument(
+            "-t", "--threads", action="store_true", help="Split profile by thread"
+        )
+        self.parser.add_argument(
+            "--addr2line", default="arm-none-eabi-addr2line", help="addr2line binary"
+        )
+        self.parser.set_defaults(func=self.process)
+
+    def _load(self):
+        with open(self.args.samples, "rb") as file:
+            data = file.read()
+
+        header_size = struct.calcsize(HEADER_FORMAT)
+        (
+            magic,
+            version,
+            tick_frequency,
+            period,
+            samples_count,
+            dropped,
+            threads_count,
+        ) = struct.unpack_from(HEADER_FORMAT, data)
+        if magic != FILE_MAGIC or version != FILE_VERSION:
+            raise Exception(f"Unsupported samples file: {magic:#x} v{version}")
+
+        sample_size = struct.calcsize(SAMPLE_FORMAT)
+        samples = list(
+            struct.iter_unpack(
+                SAMPLE_FORMAT,
+                data[header_size : header_size + samples_count * sample_size],
+            )
+        )
+
+        threads = {}
+        offset = header_size + samples_count * sample_size
+        for _ in range(threads_count):
+            thread_id, name = struct.unpack_from(THREAD_FORMAT, data, offset)
+            threads[thread_id] = name.split(b"\0")[0].decode("utf-8", "replace")
+            offset += struct.calcsize(THREAD_FORMAT)
+
+        self.logger.info(
+            f"{samples_count} samples every {period} of {tick_frequency}Hz ticks, "
+            f"{dropped} dropped"
+        )
+        return samples, threads
+
+    def _symbolize(self, addresses):
+        output = subprocess.check_output(
+            [self.args.addr2line, "-f", "-C", "-e", self.args.elf]
+            + [f"{address:#x}" for address in addresses],
+            text=True,
+        ).splitlines()
+        # Two lines per address: function, then file:line
+        return {address: output[index * 2] for index, address in enumerate(addresses)}
+
+    def _print(self, title, functions):
+        total = sum(functions.values())
+        print(f"\n{title}: {total} samples")
+        for function, count in functions.most_common(self.args.count):
+            print(f"{count * 100 / total:6.2f}% {count:>8} {function}")
+
+    def process(self):
+        samples, threads = self._load()
+        if not samples:
+            self.logger.error("No samples")
+            return 1
+
+        symbols = self._symbolize(sorted(set(pc for pc, _ in samples)))
+
+        profile = Counter()
+        thread_profiles = defaultdict(Counter)
+        for pc, thread_id in samples:
+            profile[symbols[pc]] += 1
+            thread_profiles[thread_id][symbols[pc]] += 1
+
+        self._print("All threads", profile)
+        if self.args.threads:
+            for thread_id, functions in sorted(
+                thread_profiles.items(), key=lambda item: -sum(item[1].values())
+            ):
+                name = threads.get(thread_id, "exited")
+                self._print(f"{name} ({thread_id:#010x})", functions)
+
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()